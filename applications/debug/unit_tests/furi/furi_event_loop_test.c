@@ -0,0 +1,165 @@
+#include "../minunit.h"
+#include <furi.h>
+
+#define TAG "TestFuriEventLoop"
+
+#define EVENT_LOOP_EVENT_COUNT (256u)
+#define EVENT_LOOP_FLAG_DONE (1u << 0)
+
+typedef struct {
+    FuriMessageQueue* mq;
+    FuriStreamBuffer* stream;
+
+    uint32_t queue_received;
+    uint32_t stream_received;
+    uint32_t timer_fired;
+    uint32_t flags_received;
+
+    FuriEventLoop* event_loop;
+    FuriEventLoopTimer* timer;
+} TestFuriEventLoopData;
+
+static int32_t test_furi_event_loop_producer(void* p) {
+    TestFuriEventLoopData* data = p;
+
+    for(uint32_t i = 0; i < EVENT_LOOP_EVENT_COUNT; i++) {
+        furi_check(furi_message_queue_put(data->mq, &i, FuriWaitForever) == FuriStatusOk);
+        uint8_t byte = i;
+        furi_check(furi_stream_buffer_send(data->stream, &byte, 1, FuriWaitForever) == 1);
+        if(i % 16 == 0) furi_delay_tick(1);
+    }
+
+    return 0;
+}
+
+static void test_furi_event_loop_queue_callback(FuriMessageQueue* queue, void* context) {
+    TestFuriEventLoopData* data = context;
+    uint32_t value;
+    furi_check(furi_message_queue_get(queue, &value, 0) == FuriStatusOk);
+    furi_check(value == data->queue_received);
+    data->queue_received++;
+}
+
+static void test_furi_event_loop_stream_callback(FuriStreamBuffer* stream, void* context) {
+    TestFuriEventLoopData* data = context;
+    uint8_t byte;
+    while(furi_stream_buffer_receive(stream, &byte, 1, 0) == 1) {
+        furi_check(byte == (uint8_t)data->stream_received);
+        data->stream_received++;
+    }
+}
+
+static void test_furi_event_loop_timer_callback(void* context) {
+    TestFuriEventLoopData* data = context;
+    data->timer_fired++;
+
+    if(data->queue_received == EVENT_LOOP_EVENT_COUNT &&
+       data->stream_received == EVENT_LOOP_EVENT_COUNT) {
+        furi_thread_flags_set(furi_thread_get_current_id(), EVENT_LOOP_FLAG_DONE);
+    }
+}
+
+static void test_furi_event_loop_flags_callback(uint32_t flags, void* context) {
+    TestFuriEventLoopData* data = context;
+    data->flags_received |= flags;
+    furi_event_loop_stop(data->event_loop);
+}
+
+void test_furi_event_loop() {
+    TestFuriEventLoopData data = {0};
+
+    data.mq = furi_message_queue_alloc(16, sizeof(uint32_t));
+    data.stream = furi_stream_buffer_alloc(16, 1);
+    data.event_loop = furi_event_loop_alloc();
+
+    furi_event_loop_message_queue_subscribe(
+        data.event_loop,
+        data.mq,
+        FuriEventLoopEventIn,
+        test_furi_event_loop_queue_callback,
+        &data);
+    furi_event_loop_stream_buffer_subscribe(
+        data.event_loop,
+        data.stream,
+        FuriEventLoopEventIn,
+        test_furi_event_loop_stream_callback,
+        &data);
+    furi_event_loop_thread_flags_subscribe(
+        data.event_loop, EVENT_LOOP_FLAG_DONE, test_furi_event_loop_flags_callback, &data);
+
+    data.timer = furi_event_loop_timer_alloc(
+        data.event_loop,
+        test_furi_event_loop_timer_callback,
+        FuriEventLoopTimerTypePeriodic,
+        &data);
+    furi_event_loop_timer_start(data.timer, 10);
+
+    FuriThread* producer =
+        furi_thread_alloc_ex("Producer", 1024, test_furi_event_loop_producer, &data);
+    furi_thread_start(producer);
+
+    furi_event_loop_run(data.event_loop);
+
+    furi_thread_join(producer);
+    furi_thread_free(producer);
+
+    mu_assert_int_eq(EVENT_LOOP_EVENT_COUNT, data.queue_received);
+    mu_assert_int_eq(EVENT_LOOP_EVENT_COUNT, data.stream_received);
+    mu_assert_int_eq(EVENT_LOOP_FLAG_DONE, data.flags_received);
+    mu_check(data.timer_fired > 0);
+
+    furi_event_loop_timer_stop(data.timer);
+    furi_event_loop_timer_free(data.timer);
+    furi_event_loop_thread_flags_unsubscribe(data.event_loop);
+    furi_event_loop_stream_buffer_unsubscribe(data.event_loop, data.stream, FuriEventLoopEventIn);
+    furi_event_loop_message_queue_unsubscribe(data.event_loop, data.mq, FuriEventLoopEventIn);
+    furi_event_loop_free(data.event_loop);
+
+    furi_stream_buffer_free(data.stream);
+    furi_message_queue_free(data.mq);
+}
+
+typedef struct {
+    FuriEventLoop* event_loop;
+    FuriEventLoopTimer* victim;
+    uint32_t victim_fired;
+} TestFuriEventLoopTimerFreeData;
+
+static void test_furi_event_loop_timer_free_callback(void* context) {
+    TestFuriEventLoopTimerFreeData* data = context;
+    // Victim is due too and comes next in the timer list
+    furi_event_loop_timer_free(data->victim);
+    data->victim = NULL;
+    furi_event_loop_stop(data->event_loop);
+}
+
+static void test_furi_event_loop_timer_victim_callback(void* context) {
+    TestFuriEventLoopTimerFreeData* data = context;
+    data->victim_fired++;
+}
+
+void test_furi_event_loop_timer_free() {
+    TestFuriEventLoopTimerFreeData data = {0};
+    data.event_loop = furi_event_loop_alloc();
+
+    data.victim = furi_event_loop_timer_alloc(
+        data.event_loop,
+        test_furi_event_loop_timer_victim_callback,
+        FuriEventLoopTimerTypeOnce,
+        &data);
+    FuriEventLoopTimer* timer = furi_event_loop_timer_alloc(
+        data.event_loop,
+        test_furi_event_loop_timer_free_callback,
+        FuriEventLoopTimerTypeOnce,
+        &data);
+    furi_event_loop_timer_start(data.victim, 0);
+    furi_event_loop_timer_start(timer, 0);
+
+    furi_event_loop_run(data.event_loop);
+
+    mu_check(data.victim == NULL);
+    mu_assert_int_eq(0, data.victim_fired);
+
+    furi_event_loop_timer_free(timer);
+    furi_event_loop_free(data.event_loop);
+}
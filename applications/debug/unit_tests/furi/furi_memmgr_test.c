@@ -2,6 +2,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdbool.h>
+#include <furi.h>
 
 void test_furi_memmgr() {
     void* ptr;
@@ -36,3 +37,83 @@ void test_furi_memmgr() {
     }
     free(ptr);
 }
+
+void test_furi_memmgr_pool() {
+    MemmgrHeapPoolStats stats_before, stats_after;
+    size_t index = 0;
+
+    // find class for 32 byte blocks
+    for(; index < memmgr_heap_get_pool_count(); index++) {
+        memmgr_heap_get_pool_stats(index, &stats_before);
+        if(stats_before.block_size == 32) break;
+    }
+    mu_check(index < memmgr_heap_get_pool_count());
+
+    // freed small block is cached and served to the next allocation of the same class
+    uint8_t* ptr = malloc(30);
+    memset(ptr, 0xAA, 30);
+    free(ptr);
+    ptr = malloc(25);
+    // and it is zero-initialized again
+    for(int i = 0; i < 25; i++) {
+        mu_assert_int_eq(0, ptr[i]);
+    }
+    free(ptr);
+
+    memmgr_heap_get_pool_stats(index, &stats_after);
+    mu_check(stats_after.hits > stats_before.hits);
+}
+
+void test_furi_memmgr_realloc() {
+    // shrink is done in place
+    uint8_t* ptr = malloc(1024);
+    memset(ptr, 0x55, 1024);
+    uint8_t* ptr2 = realloc(ptr, 512);
+    mu_check(ptr2 == ptr);
+    for(int i = 0; i < 512; i++) {
+        mu_assert_int_eq(0x55, ptr2[i]);
+    }
+
+    // grow into the tail released by shrink is done in place
+    ptr = realloc(ptr2, 768);
+    mu_check(ptr == ptr2);
+    for(int i = 0; i < 512; i++) {
+        mu_assert_int_eq(0x55, ptr[i]);
+    }
+    for(int i = 512; i < 768; i++) {
+        mu_assert_int_eq(0, ptr[i]);
+    }
+
+    // realloc of NULL is malloc
+    ptr2 = realloc(NULL, 64);
+    mu_check(ptr2 != NULL);
+    free(ptr2);
+
+    // realloc to zero is free
+    mu_check(realloc(ptr, 0) == NULL);
+}
+
+static int32_t test_furi_memmgr_trace_thread(void* context) {
+    void** leak = context;
+    // one block is left allocated, other is released
+    *leak = malloc(100);
+    free(malloc(200));
+    return 0;
+}
+
+void test_furi_memmgr_trace() {
+    void* leak = NULL;
+    FuriThread* thread =
+        furi_thread_alloc_ex("MemmgrTrace", 1024, test_furi_memmgr_trace_thread, &leak);
+    furi_thread_enable_heap_trace(thread);
+    furi_thread_start(thread);
+    furi_thread_join(thread);
+
+    // only the leaked block with its header is accounted
+    size_t heap_size = furi_thread_get_heap_size(thread);
+    mu_check(heap_size >= 100);
+    mu_check(heap_size < 200);
+
+    furi_thread_free(thread);
+    free(leak);
+}
@@ -9,6 +9,11 @@ void test_furi_concurrent_access();
 void test_furi_pubsub();
 
 void test_furi_memmgr();
+void test_furi_memmgr_pool();
+void test_furi_memmgr_realloc();
+void test_furi_memmgr_trace();
+void test_furi_event_loop();
+void test_furi_event_loop_timer_free();
 
 static int foo = 0;
 
@@ -39,6 +44,26 @@ MU_TEST(mu_test_furi_memmgr) {
     test_furi_memmgr();
 }
 
+MU_TEST(mu_test_furi_memmgr_pool) {
+    test_furi_memmgr_pool();
+}
+
+MU_TEST(mu_test_furi_memmgr_realloc) {
+    test_furi_memmgr_realloc();
+}
+
+MU_TEST(mu_test_furi_memmgr_trace) {
+    test_furi_memmgr_trace();
+}
+
+MU_TEST(mu_test_furi_event_loop) {
+    test_furi_event_loop();
+}
+
+MU_TEST(mu_test_furi_event_loop_timer_free) {
+    test_furi_event_loop_timer_free();
+}
+
 MU_TEST_SUITE(test_suite) {
     MU_SUITE_CONFIGURE(&test_setup, &test_teardown);
 
@@ -48,6 +73,11 @@ MU_TEST_SUITE(test_suite) {
     MU_RUN_TEST(mu_test_furi_create_open);
     MU_RUN_TEST(mu_test_furi_pubsub);
     MU_RUN_TEST(mu_test_furi_memmgr);
+    MU_RUN_TEST(mu_test_furi_memmgr_pool);
+    MU_RUN_TEST(mu_test_furi_memmgr_realloc);
+    MU_RUN_TEST(mu_test_furi_memmgr_trace);
+    MU_RUN_TEST(mu_test_furi_event_loop);
+    MU_RUN_TEST(mu_test_furi_event_loop_timer_free);
 }
 
 int run_minunit_test_furi() {
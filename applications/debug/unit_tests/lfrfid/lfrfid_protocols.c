@@ -3,6 +3,8 @@
 #include <toolbox/protocols/protocol_dict.h>
 #include <lfrfid/protocols/lfrfid_protocols.h>
 #include <toolbox/pulse_protocols/pulse_glue.h>
+#include <lfrfid/lfrfid_read_decoder.h>
+#include <lfrfid/lfrfid_read_filter.h>
 
 #define LF_RFID_READ_TIMING_MULTIPLIER 8
 
@@ -445,6 +447,124 @@ MU_TEST(test_lfrfid_protocol_inadala26_emulate_simple) {
     protocol_dict_free(dict);
 }
 
+static LFRFIDReadDecoderEvent test_lfrfid_read_decoder_feed_em(
+    LFRFIDReadDecoder* decoder,
+    size_t repeats,
+    ProtocolId* protocol) {
+    LFRFIDReadDecoderEvent event = LFRFIDReadDecoderEventNone;
+    PulseGlue* pulse_glue = pulse_glue_alloc();
+
+    for(size_t i = 0; i < EM_TEST_EMULATION_TIMINGS_COUNT * repeats; i++) {
+        bool pulse_pop = pulse_glue_push(
+            pulse_glue,
+            em_test_timings[i % EM_TEST_EMULATION_TIMINGS_COUNT] >= 0,
+            abs(em_test_timings[i % EM_TEST_EMULATION_TIMINGS_COUNT]) *
+                LF_RFID_READ_TIMING_MULTIPLIER);
+
+        if(pulse_pop) {
+            uint32_t length, period;
+            pulse_glue_pop(pulse_glue, &length, &period);
+
+            event = lfrfid_read_decoder_feed(decoder, period, length, protocol);
+            if(event == LFRFIDReadDecoderEventSettled) break;
+        }
+    }
+
+    pulse_glue_free(pulse_glue);
+    return event;
+}
+
+MU_TEST(test_lfrfid_read_decoder_concurrent) {
+    ProtocolDict* dict = protocol_dict_alloc(lfrfid_protocols, LFRFIDProtocolMax);
+    LFRFIDReadDecoder* decoder =
+        lfrfid_read_decoder_alloc(dict, LFRFIDFeatureASK | LFRFIDFeaturePSK);
+
+    const uint8_t data[EM_TEST_DATA_SIZE] = EM_TEST_DATA;
+    ProtocolId protocol = PROTOCOL_NO;
+
+    mu_assert_int_eq(
+        LFRFIDReadDecoderEventSettled, test_lfrfid_read_decoder_feed_em(decoder, 20, &protocol));
+    mu_assert_int_eq(LFRFIDProtocolEM4100, protocol);
+    mu_assert_int_eq(
+        LFRFIDProtocolEM4100,
+        lfrfid_read_decoder_get_protocol(decoder, LFRFIDReadDecoderFamilyASK));
+    mu_assert_int_eq(100, lfrfid_read_decoder_get_confidence(decoder, LFRFIDReadDecoderFamilyASK));
+    mu_assert_int_eq(
+        PROTOCOL_NO, lfrfid_read_decoder_get_protocol(decoder, LFRFIDReadDecoderFamilyPSK));
+    mu_assert_int_eq(0, lfrfid_read_decoder_get_confidence(decoder, LFRFIDReadDecoderFamilyPSK));
+
+    uint8_t received_data[EM_TEST_DATA_SIZE] = {0};
+    protocol_dict_get_data(dict, protocol, received_data, EM_TEST_DATA_SIZE);
+    mu_assert_mem_eq(data, received_data, EM_TEST_DATA_SIZE);
+
+    memset(received_data, 0, EM_TEST_DATA_SIZE);
+    lfrfid_read_decoder_get_data(decoder, received_data, EM_TEST_DATA_SIZE);
+    mu_assert_mem_eq(data, received_data, EM_TEST_DATA_SIZE);
+
+    lfrfid_read_decoder_reset(decoder);
+    mu_assert_int_eq(
+        PROTOCOL_NO, lfrfid_read_decoder_get_protocol(decoder, LFRFIDReadDecoderFamilyASK));
+    mu_assert_int_eq(0, lfrfid_read_decoder_get_confidence(decoder, LFRFIDReadDecoderFamilyASK));
+
+    lfrfid_read_decoder_free(decoder);
+    protocol_dict_free(dict);
+}
+
+MU_TEST(test_lfrfid_read_decoder_family) {
+    ProtocolDict* dict = protocol_dict_alloc(lfrfid_protocols, LFRFIDProtocolMax);
+    LFRFIDReadDecoder* decoder = lfrfid_read_decoder_alloc(dict, LFRFIDFeaturePSK);
+    ProtocolId protocol = PROTOCOL_NO;
+
+    // EM4100 has both features, PSK family decodes it when it runs alone
+    mu_assert_int_eq(
+        LFRFIDReadDecoderEventSettled, test_lfrfid_read_decoder_feed_em(decoder, 20, &protocol));
+    mu_assert_int_eq(LFRFIDProtocolEM4100, protocol);
+    mu_assert_int_eq(
+        LFRFIDProtocolEM4100,
+        lfrfid_read_decoder_get_protocol(decoder, LFRFIDReadDecoderFamilyPSK));
+    mu_assert_int_eq(
+        PROTOCOL_NO, lfrfid_read_decoder_get_protocol(decoder, LFRFIDReadDecoderFamilyASK));
+
+    lfrfid_read_decoder_free(decoder);
+    protocol_dict_free(dict);
+}
+
+MU_TEST(test_lfrfid_read_filter) {
+    LFRFIDReadFilter* filter = lfrfid_read_filter_alloc(LFRFID_READ_FILTER_MIN_TIME_US);
+    uint32_t pulse = 0;
+    uint32_t duration = 0;
+
+    mu_check(!lfrfid_read_filter_feed(filter, true, 100, &pulse, &duration));
+    mu_check(lfrfid_read_filter_feed(filter, false, 250, &pulse, &duration));
+    mu_assert_int_eq(100, pulse);
+    mu_assert_int_eq(250, duration);
+
+    // high spike drops the edge after it
+    mu_check(!lfrfid_read_filter_feed(filter, true, 10, &pulse, &duration));
+    mu_check(!lfrfid_read_filter_feed(filter, false, 250, &pulse, &duration));
+
+    // low spike drops the pair being built
+    mu_check(!lfrfid_read_filter_feed(filter, true, 100, &pulse, &duration));
+    mu_check(!lfrfid_read_filter_feed(filter, false, 10, &pulse, &duration));
+    mu_check(!lfrfid_read_filter_feed(filter, false, 250, &pulse, &duration));
+
+    // two pulses in a row drop the pair
+    mu_check(!lfrfid_read_filter_feed(filter, true, 100, &pulse, &duration));
+    mu_check(!lfrfid_read_filter_feed(filter, true, 120, &pulse, &duration));
+    mu_check(!lfrfid_read_filter_feed(filter, false, 250, &pulse, &duration));
+
+    mu_check(!lfrfid_read_filter_feed(filter, true, 130, &pulse, &duration));
+    lfrfid_read_filter_reset(filter);
+    mu_check(!lfrfid_read_filter_feed(filter, false, 250, &pulse, &duration));
+
+    mu_check(!lfrfid_read_filter_feed(filter, true, 140, &pulse, &duration));
+    mu_check(lfrfid_read_filter_feed(filter, false, 260, &pulse, &duration));
+    mu_assert_int_eq(140, pulse);
+    mu_assert_int_eq(260, duration);
+
+    lfrfid_read_filter_free(filter);
+}
+
 MU_TEST_SUITE(test_lfrfid_protocols_suite) {
     MU_RUN_TEST(test_lfrfid_protocol_em_read_simple);
     MU_RUN_TEST(test_lfrfid_protocol_em_emulate_simple);
@@ -456,6 +576,10 @@ MU_TEST_SUITE(test_lfrfid_protocols_suite) {
     MU_RUN_TEST(test_lfrfid_protocol_ioprox_xsf_emulate_simple);
 
     MU_RUN_TEST(test_lfrfid_protocol_inadala26_emulate_simple);
+
+    MU_RUN_TEST(test_lfrfid_read_decoder_concurrent);
+    MU_RUN_TEST(test_lfrfid_read_decoder_family);
+    MU_RUN_TEST(test_lfrfid_read_filter);
 }
 
 int run_minunit_test_lfrfid_protocols() {
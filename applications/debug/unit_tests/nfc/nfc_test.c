@@ -4,23 +4,77 @@
 
 #include <nfc/nfc_device.h>
 #include <nfc/helpers/nfc_data_generator.h>
+#include <nfc/helpers/nfc_util.h>
 #include <nfc/nfc_poller.h>
 #include <nfc/nfc_listener.h>
 #include <nfc/protocols/iso14443_3a/iso14443_3a.h>
 #include <nfc/protocols/iso14443_3a/iso14443_3a_poller_sync.h>
+#include <nfc/protocols/iso14443_4a/iso14443_4a_poller.h>
 #include <nfc/protocols/mf_ultralight/mf_ultralight.h>
 #include <nfc/protocols/mf_ultralight/mf_ultralight_poller_sync.h>
 #include <nfc/protocols/mf_classic/mf_classic_poller_sync.h>
+#include <nfc/protocols/mf_classic/mf_classic_poller.h>
+#include <nfc/protocols/mf_classic/mf_classic_key_scheduler.h>
+#include <nfc/protocols/mf_desfire/mf_desfire_poller.h>
 
+#include <toolbox/crc32_calc.h>
 #include <toolbox/keys_dict.h>
+#include <toolbox/stream/file_stream.h>
+#include <toolbox/stream/string_stream.h>
 #include <nfc/nfc.h>
+#include <nfc/helpers/iso14443_crc.h>
+#include <nfc/helpers/nfc_dump.h>
+#include <signal_reader/parsers/iso15693/iso15693_decoder.h>
 
+#include "nfc_transport.h"
 #include "../minunit.h"
 
+#include <inttypes.h>
+
 #define TAG "NfcTest"
 
 #define NFC_TEST_NFC_DEV_PATH EXT_PATH("unit_tests/nfc/nfc_device_test.nfc")
+#define NFC_TEST_NFC_DEV_BINARY_PATH EXT_PATH("unit_tests/nfc/nfc_device_test.nfcb")
+#define NFC_TEST_NFC_DEV_LOAD_ROUNDS (16U)
 #define NFC_APP_MF_CLASSIC_DICT_UNIT_TEST_PATH EXT_PATH("unit_tests/mf_dict.nfc")
+#define NFC_TEST_MF_CLASSIC_DICT_PATH EXT_PATH("unit_tests/nfc/mf_classic_dict_test.nfc")
+#define NFC_TEST_MF_CLASSIC_USER_DICT_PATH EXT_PATH("unit_tests/nfc/mf_classic_user_dict_test.nfc")
+#define NFC_TEST_MF_CLASSIC_KEY_STATS_PATH EXT_PATH("unit_tests/nfc/mf_classic_key_stats_test.nfc")
+#define NFC_TEST_TRACE_PATH EXT_PATH("unit_tests/nfc/nfc_trace_test.bin")
+#define NFC_TEST_TRACE_SIZE (8 * 1024U)
+// Record area size field of the trace file header
+#define NFC_TEST_TRACE_HEADER_SIZE_OFFSET (16)
+
+// Fields of the binary container header and section table
+#define NFC_TEST_DUMP_SECTION_COUNT_OFFSET (8)
+#define NFC_TEST_DUMP_TABLE_OFFSET_OFFSET (12)
+#define NFC_TEST_DUMP_TEXT_SIZE_OFFSET (16)
+#define NFC_TEST_DUMP_TABLE_CRC_OFFSET (20)
+#define NFC_TEST_DUMP_SECTION_SIZE (16)
+#define NFC_TEST_DUMP_SECTION_OFFSET_OFFSET (0)
+#define NFC_TEST_DUMP_SECTION_SIZE_OFFSET (4)
+
+#define NFC_TEST_ISO14443_4_POLLER_DONE_EVENT (1UL << 0)
+#define NFC_TEST_ISO14443_4_BUF_SIZE (256U)
+// Card chains responses longer than this
+#define NFC_TEST_ISO14443_4_CARD_CHUNK_SIZE (64U)
+
+#define NFC_TEST_MF_DESFIRE_POLLER_DONE_EVENT (1UL << 0)
+// Frame data size of real cards, frame with status byte fits into their FSC of 64 bytes
+#define NFC_TEST_MF_DESFIRE_FRAME_SIZE (59U)
+// Takes more than one ReadData command
+#define NFC_TEST_MF_DESFIRE_BIG_FILE_SIZE (600U)
+// Record file bigger than the poller result buffer
+#define NFC_TEST_MF_DESFIRE_BIG_RECORD_SIZE (40U)
+#define NFC_TEST_MF_DESFIRE_BIG_RECORD_COUNT (16U)
+
+#define NFC_TEST_MF_CLASSIC_DICT_ATTACK_DONE_EVENT (1UL << 0)
+#define NFC_TEST_MF_CLASSIC_DECOY_KEY_NUM (8U)
+#define NFC_TEST_MF_CLASSIC_CORPUS_SIZE (3U)
+// Size of the key stats table
+#define NFC_TEST_MF_CLASSIC_STALE_KEY_NUM (64U)
+// Weight of a key found on one card decays to zero within this many cards
+#define NFC_TEST_MF_CLASSIC_DECAY_CARD_NUM (128U)
 
 typedef struct {
     Storage* storage;
@@ -58,6 +112,24 @@ static void nfc_test_save_and_load(NfcDevice* nfc_device_ref) {
         storage_simply_remove(nfc_test->storage, NFC_TEST_NFC_DEV_PATH),
         "storage_simply_remove() failed\r\n");
 
+    nfc_device_clear(nfc_device_dut);
+
+    mu_assert(
+        nfc_device_save_binary(nfc_device_ref, NFC_TEST_NFC_DEV_BINARY_PATH),
+        "nfc_device_save_binary() failed\r\n");
+
+    mu_assert(
+        nfc_device_load(nfc_device_dut, NFC_TEST_NFC_DEV_BINARY_PATH),
+        "nfc_device_load() of binary file failed\r\n");
+
+    mu_assert(
+        nfc_device_is_equal(nfc_device_ref, nfc_device_dut),
+        "nfc_device_data_dut != nfc_device_data_ref after binary load\r\n");
+
+    mu_assert(
+        storage_simply_remove(nfc_test->storage, NFC_TEST_NFC_DEV_BINARY_PATH),
+        "storage_simply_remove() failed\r\n");
+
     nfc_device_free(nfc_device_dut);
 }
 
@@ -166,6 +238,280 @@ MU_TEST(mf_classic_4k_7b_file_test) {
     nfc_file_test_with_generator(NfcDataGeneratorTypeMfClassic4k_7b);
 }
 
+// One load is below the 1 ms tick resolution, time a batch and divide
+static bool nfc_test_load_timed(NfcDevice* nfc_device, const char* path, uint32_t* time_us) {
+    bool success = true;
+    const uint32_t start = furi_get_tick();
+    for(size_t i = 0; (i < NFC_TEST_NFC_DEV_LOAD_ROUNDS) && success; i++) {
+        success = nfc_device_load(nfc_device, path);
+    }
+    *time_us = (furi_get_tick() - start) * 1000U / NFC_TEST_NFC_DEV_LOAD_ROUNDS;
+    return success;
+}
+
+MU_TEST(nfc_dump_conversion_test) {
+    NfcDevice* nfc_device_ref = nfc_device_alloc();
+    NfcDevice* nfc_device_dut = nfc_device_alloc();
+    nfc_data_generator_fill_data(NfcDataGeneratorTypeMfClassic4k_7b, nfc_device_ref);
+
+    mu_assert(
+        nfc_device_save(nfc_device_ref, NFC_TEST_NFC_DEV_PATH), "nfc_device_save() failed\r\n");
+    mu_assert(
+        nfc_device_save_binary(nfc_device_ref, NFC_TEST_NFC_DEV_BINARY_PATH),
+        "nfc_device_save_binary() failed\r\n");
+
+    // Text -> binary -> text must give the same bytes
+    Stream* text_ref = string_stream_alloc();
+    Stream* text_dut = string_stream_alloc();
+    Stream* dump = string_stream_alloc();
+    Stream* file = file_stream_alloc(nfc_test->storage);
+
+    mu_assert(
+        file_stream_open(file, NFC_TEST_NFC_DEV_PATH, FSAM_READ, FSOM_OPEN_EXISTING),
+        "file_stream_open() failed\r\n");
+    mu_assert(stream_copy_full(file, text_ref) == stream_size(file), "Text copy failed\r\n");
+    file_stream_close(file);
+
+    mu_assert(nfc_dump_from_text(text_ref, dump), "nfc_dump_from_text() failed\r\n");
+    mu_assert(nfc_dump_check(dump), "nfc_dump_check() failed\r\n");
+    mu_assert(nfc_dump_to_text(dump, text_dut), "nfc_dump_to_text() failed\r\n");
+
+    const size_t text_size = stream_size(text_ref);
+    const size_t dump_size = stream_size(dump);
+    mu_assert(stream_size(text_dut) == text_size, "Text size not matches\r\n");
+
+    FuriString* buf_ref = furi_string_alloc();
+    FuriString* buf_dut = furi_string_alloc();
+    stream_rewind(text_ref);
+    stream_rewind(text_dut);
+    while(stream_read_line(text_ref, buf_ref)) {
+        mu_assert(stream_read_line(text_dut, buf_dut), "Text is truncated\r\n");
+        mu_assert(furi_string_equal(buf_ref, buf_dut), "Text not matches\r\n");
+    }
+
+    // Each section must be readable on its own
+    NfcDump* nfc_dump = nfc_dump_alloc();
+    mu_assert(nfc_dump_open(nfc_dump, dump), "nfc_dump_open() failed\r\n");
+    mu_assert(nfc_dump_get_text_size(nfc_dump) == text_size, "Wrong text size\r\n");
+    size_t sections_size = 0;
+    for(size_t i = nfc_dump_get_section_count(nfc_dump); i > 0; i--) {
+        mu_assert(nfc_dump_read_section(nfc_dump, i - 1, buf_dut), "Section read failed\r\n");
+        sections_size += furi_string_size(buf_dut);
+    }
+    mu_assert(sections_size == text_size, "Sections size not matches\r\n");
+    nfc_dump_free(nfc_dump);
+
+    // Damaged container must be rejected
+    uint8_t byte = 0;
+    stream_seek(dump, dump_size / 2, StreamOffsetFromStart);
+    stream_read(dump, &byte, sizeof(byte));
+    byte ^= 0xFF;
+    stream_seek(dump, dump_size / 2, StreamOffsetFromStart);
+    stream_write(dump, &byte, sizeof(byte));
+    mu_assert(!nfc_dump_to_text(dump, text_dut), "Damaged container accepted\r\n");
+
+    furi_string_free(buf_dut);
+    furi_string_free(buf_ref);
+    stream_free(file);
+    stream_free(dump);
+    stream_free(text_dut);
+    stream_free(text_ref);
+
+    // Load time
+    uint32_t text_time = 0;
+    mu_assert(
+        nfc_test_load_timed(nfc_device_dut, NFC_TEST_NFC_DEV_PATH, &text_time),
+        "nfc_device_load() failed\r\n");
+    mu_assert(nfc_device_is_equal(nfc_device_ref, nfc_device_dut), "Text load mismatch\r\n");
+    nfc_device_clear(nfc_device_dut);
+    uint32_t binary_time = 0;
+    mu_assert(
+        nfc_test_load_timed(nfc_device_dut, NFC_TEST_NFC_DEV_BINARY_PATH, &binary_time),
+        "nfc_device_load() of binary file failed\r\n");
+    mu_assert(nfc_device_is_equal(nfc_device_ref, nfc_device_dut), "Binary load mismatch\r\n");
+
+    FURI_LOG_I(
+        TAG,
+        "MfClassic 4K: text %zu bytes in %" PRIu32 " us, binary %zu bytes in %" PRIu32 " us",
+        text_size,
+        text_time,
+        dump_size,
+        binary_time);
+    mu_assert(dump_size < text_size, "Binary file is not smaller\r\n");
+
+    storage_simply_remove(nfc_test->storage, NFC_TEST_NFC_DEV_BINARY_PATH);
+    storage_simply_remove(nfc_test->storage, NFC_TEST_NFC_DEV_PATH);
+    nfc_device_free(nfc_device_dut);
+    nfc_device_free(nfc_device_ref);
+}
+
+// Every line type, numbers that must stay text, odd line endings and no trailing newline
+static const char* nfc_test_dump_text = "Filetype: Flipper NFC device\n"
+                                        "Version: 4\n"
+                                        "# Key: value in a comment\n"
+                                        "Pages total: 0135\n"
+                                        "Counter: 4294967296\n"
+                                        "Block 0: 04 ?? FF 00 ?? ?? ?? ?? 11\n"
+                                        "Block 1: 00 01 02\r\n"
+                                        "Block 2: 0\n"
+                                        "\n"
+                                        "Block 16: 01\n"
+                                        "Data: \n"
+                                        "Last: 4294967295";
+
+static uint32_t nfc_test_dump_get_u32(Stream* dump, size_t offset) {
+    uint32_t value = 0;
+    stream_seek(dump, offset, StreamOffsetFromStart);
+    stream_read(dump, (uint8_t*)&value, sizeof(value));
+    return value;
+}
+
+static void nfc_test_dump_set_u32(Stream* dump, size_t offset, uint32_t value) {
+    stream_seek(dump, offset, StreamOffsetFromStart);
+    stream_write(dump, (const uint8_t*)&value, sizeof(value));
+}
+
+// Damaged tables must fail on their own checks, not on the CRC
+static void nfc_test_dump_update_table_crc(Stream* dump) {
+    const size_t table_offset = nfc_test_dump_get_u32(dump, NFC_TEST_DUMP_TABLE_OFFSET_OFFSET);
+    const size_t table_size = stream_size(dump) - table_offset;
+    uint8_t* table = malloc(table_size);
+
+    stream_seek(dump, table_offset, StreamOffsetFromStart);
+    stream_read(dump, table, table_size);
+    nfc_test_dump_set_u32(
+        dump, NFC_TEST_DUMP_TABLE_CRC_OFFSET, crc32_calc_buffer(0, table, table_size));
+
+    free(table);
+}
+
+static bool nfc_test_dump_open_copy(Stream* dump_ref, Stream* dump) {
+    stream_clean(dump);
+    stream_rewind(dump_ref);
+    stream_copy_full(dump_ref, dump);
+
+    NfcDump* nfc_dump = nfc_dump_alloc();
+    const bool opened = nfc_dump_open(nfc_dump, dump);
+    nfc_dump_free(nfc_dump);
+
+    return opened;
+}
+
+MU_TEST(nfc_dump_round_trip_test) {
+    Stream* text_ref = string_stream_alloc();
+    Stream* text_dut = string_stream_alloc();
+    Stream* dump_ref = string_stream_alloc();
+    Stream* dump_dut = string_stream_alloc();
+    const size_t text_size = strlen(nfc_test_dump_text);
+
+    stream_write_cstring(text_ref, nfc_test_dump_text);
+    mu_assert(nfc_dump_from_text(text_ref, dump_ref), "nfc_dump_from_text() failed\r\n");
+    mu_assert(nfc_dump_to_text(dump_ref, text_dut), "nfc_dump_to_text() failed\r\n");
+    mu_assert(stream_size(text_dut) == text_size, "Text size not matches\r\n");
+
+    char* text = malloc(text_size);
+    stream_rewind(text_dut);
+    stream_read(text_dut, (uint8_t*)text, text_size);
+    mu_assert(memcmp(text, nfc_test_dump_text, text_size) == 0, "Text not matches\r\n");
+    free(text);
+
+    // Lines split across writes must be encoded the same
+    Stream* writer = nfc_dump_text_writer_alloc(dump_dut);
+    for(size_t i = 0; i < text_size; i++) {
+        mu_assert(
+            stream_write(writer, (const uint8_t*)&nfc_test_dump_text[i], 1) == 1,
+            "Text writer failed\r\n");
+    }
+    mu_assert(nfc_dump_text_writer_finish(writer), "nfc_dump_text_writer_finish() failed\r\n");
+    stream_free(writer);
+
+    const size_t dump_size = stream_size(dump_ref);
+    mu_assert(stream_size(dump_dut) == dump_size, "Dump size not matches\r\n");
+    for(size_t i = 0; i < dump_size; i += sizeof(uint32_t)) {
+        mu_assert(
+            nfc_test_dump_get_u32(dump_ref, i) == nfc_test_dump_get_u32(dump_dut, i),
+            "Dump not matches\r\n");
+    }
+
+    // Zero bytes cannot be stored
+    writer = nfc_dump_text_writer_alloc(dump_dut);
+    mu_assert(stream_write(writer, (const uint8_t*)"Key: \0\n", 7) == 0, "Zero accepted\r\n");
+    mu_assert(!nfc_dump_text_writer_finish(writer), "Zero accepted\r\n");
+    stream_free(writer);
+
+    stream_free(dump_dut);
+    stream_free(dump_ref);
+    stream_free(text_dut);
+    stream_free(text_ref);
+}
+
+MU_TEST(nfc_dump_malformed_test) {
+    Stream* text = string_stream_alloc();
+    Stream* dump_ref = string_stream_alloc();
+    Stream* dump = string_stream_alloc();
+
+    stream_write_cstring(text, nfc_test_dump_text);
+    mu_assert(nfc_dump_from_text(text, dump_ref), "nfc_dump_from_text() failed\r\n");
+    mu_assert(nfc_test_dump_open_copy(dump_ref, dump), "nfc_dump_open() failed\r\n");
+
+    const uint32_t table_offset =
+        nfc_test_dump_get_u32(dump_ref, NFC_TEST_DUMP_TABLE_OFFSET_OFFSET);
+
+    // Section count whose table size overflows 32 bits
+    nfc_test_dump_open_copy(dump_ref, dump);
+    nfc_test_dump_set_u32(dump, NFC_TEST_DUMP_SECTION_COUNT_OFFSET, 0x10000001UL);
+    NfcDump* nfc_dump = nfc_dump_alloc();
+    mu_assert(!nfc_dump_open(nfc_dump, dump), "Huge section count accepted\r\n");
+    mu_assert(nfc_dump_get_section_count(nfc_dump) == 0, "Section count kept\r\n");
+    nfc_dump_free(nfc_dump);
+
+    // Section running into the table
+    nfc_test_dump_open_copy(dump_ref, dump);
+    nfc_test_dump_set_u32(
+        dump,
+        table_offset + NFC_TEST_DUMP_SECTION_SIZE_OFFSET,
+        table_offset - sizeof(uint32_t));
+    nfc_test_dump_update_table_crc(dump);
+    nfc_dump = nfc_dump_alloc();
+    mu_assert(!nfc_dump_open(nfc_dump, dump), "Section past the table accepted\r\n");
+    nfc_dump_free(nfc_dump);
+
+    // Section size that wraps around with the offset
+    nfc_test_dump_open_copy(dump_ref, dump);
+    nfc_test_dump_set_u32(dump, table_offset + NFC_TEST_DUMP_SECTION_SIZE_OFFSET, UINT32_MAX);
+    nfc_test_dump_update_table_crc(dump);
+    nfc_dump = nfc_dump_alloc();
+    mu_assert(!nfc_dump_open(nfc_dump, dump), "Huge section accepted\r\n");
+    nfc_dump_free(nfc_dump);
+
+    // Section inside the header
+    nfc_test_dump_open_copy(dump_ref, dump);
+    nfc_test_dump_set_u32(dump, table_offset + NFC_TEST_DUMP_SECTION_OFFSET_OFFSET, 0);
+    nfc_test_dump_update_table_crc(dump);
+    nfc_dump = nfc_dump_alloc();
+    mu_assert(!nfc_dump_open(nfc_dump, dump), "Section in the header accepted\r\n");
+    nfc_dump_free(nfc_dump);
+
+    // Text size the sections do not add up to
+    nfc_test_dump_open_copy(dump_ref, dump);
+    nfc_test_dump_set_u32(dump, NFC_TEST_DUMP_TEXT_SIZE_OFFSET, UINT32_MAX);
+    nfc_dump = nfc_dump_alloc();
+    mu_assert(!nfc_dump_open(nfc_dump, dump), "Wrong text size accepted\r\n");
+    nfc_dump_free(nfc_dump);
+
+    // Truncated table
+    nfc_test_dump_open_copy(dump_ref, dump);
+    stream_seek(dump, -1, StreamOffsetFromEnd);
+    stream_delete(dump, 1);
+    nfc_dump = nfc_dump_alloc();
+    mu_assert(!nfc_dump_open(nfc_dump, dump), "Truncated table accepted\r\n");
+    nfc_dump_free(nfc_dump);
+
+    stream_free(dump);
+    stream_free(dump_ref);
+    stream_free(text);
+}
+
 MU_TEST(iso14443_3a_reader) {
     Nfc* poller = nfc_alloc();
     Nfc* listener = nfc_alloc();
@@ -221,8 +567,18 @@ static void mf_ultralight_reader_test(const char* path) {
     nfc_listener_start(mfu_listener, NULL, NULL);
 
     MfUltralightData* mfu_data = mf_ultralight_alloc();
+    nfc_transport_reset_frame_count();
+    uint32_t read_start = furi_get_tick();
     MfUltralightError error = mf_ultralight_poller_sync_read_card(poller, mfu_data);
+    uint32_t read_time = furi_get_tick() - read_start;
+    uint32_t frames = nfc_transport_get_frame_count();
     mu_assert(error == MfUltralightErrorNone, "mf_ultralight_poller_sync_read_card() failed");
+    FURI_LOG_I(
+        TAG,
+        "Read %u pages: %" PRIu32 " frames, %" PRIu32 " ms",
+        data->pages_total,
+        frames,
+        read_time);
 
     nfc_listener_stop(mfu_listener);
     nfc_listener_free(mfu_listener);
@@ -231,6 +587,12 @@ static void mf_ultralight_reader_test(const char* path) {
         mf_ultralight_is_equal(mfu_data, nfc_device_get_data(nfc_device, NfcProtocolMfUltralight)),
         "Data not matches");
 
+    // READ alone takes a frame per 4 pages, bulk read must do the whole dump in fewer frames
+    if(mf_ultralight_support_feature(features, MfUltralightFeatureSupportFastRead) &&
+       (data->pages_total > 128)) {
+        mu_assert(frames < data->pages_total / 4U, "Pages are not read with FAST_READ");
+    }
+
     mf_ultralight_free(mfu_data);
     nfc_device_free(nfc_device);
     nfc_free(listener);
@@ -318,7 +680,7 @@ static void mf_ultralight_write() {
     // Write random data
     for(size_t i = 5; i < 15; i++) {
         MfUltralightPage page = {};
-        FURI_LOG_D(TAG, "Writing page %d", i);
+        FURI_LOG_D(TAG, "Writing page %zu", i);
         furi_hal_random_fill_buf(page.data, sizeof(MfUltralightPage));
         mfu_data->page[i] = page;
         error = mf_ultralight_poller_sync_write_page(poller, i, &page);
@@ -435,6 +797,318 @@ static void mf_classic_value_block() {
     nfc_free(poller);
 }
 
+typedef struct {
+    NfcPoller* poller;
+    const MfClassicData* data;
+    KeysDict* dict;
+    MfClassicKeyScheduler* key_scheduler;
+    FuriThreadId thread_id;
+    bool success;
+} NfcTestMfClassicDictAttack;
+
+// Keys shared by all cards of the corpus, placed after the decoys in the dictionary
+static const MfClassicKey nfc_test_mf_classic_card_keys[] = {
+    {.data = {0xA0, 0xA1, 0xA2, 0xA3, 0xA4, 0xA5}},
+    {.data = {0xB0, 0xB1, 0xB2, 0xB3, 0xB4, 0xB5}},
+    {.data = {0xC0, 0xC1, 0xC2, 0xC3, 0xC4, 0xC5}},
+};
+
+static MfClassicKey nfc_test_mf_classic_decoy_key(size_t index) {
+    MfClassicKey key = {.data = {0xD0, 0xD1, 0xD2, 0xD3, 0xD4, (uint8_t)index}};
+    return key;
+}
+
+static NfcCommand nfc_test_mf_classic_dict_attack_callback(NfcGenericEvent event, void* context) {
+    NfcTestMfClassicDictAttack* attack = context;
+    MfClassicPollerEvent* mfc_event = event.event_data;
+    NfcCommand command = NfcCommandContinue;
+
+    if(mfc_event->type == MfClassicPollerEventTypeRequestMode) {
+        mfc_event->data->poller_mode.mode = MfClassicPollerModeDictAttack;
+        mfc_event->data->poller_mode.data = attack->data;
+        if(attack->key_scheduler) {
+            mf_classic_key_scheduler_start_sector(attack->key_scheduler, attack->data);
+        } else {
+            keys_dict_rewind(attack->dict);
+        }
+    } else if(mfc_event->type == MfClassicPollerEventTypeRequestKey) {
+        MfClassicPollerEventDataKeyRequest* key_request = &mfc_event->data->key_request_data;
+        if(attack->key_scheduler) {
+            key_request->key_provided =
+                mf_classic_key_scheduler_get_next_key(attack->key_scheduler, &key_request->key);
+        } else {
+            key_request->key_provided = keys_dict_get_next_key(
+                attack->dict, key_request->key.data, sizeof(MfClassicKey));
+        }
+    } else if(
+        mfc_event->type == MfClassicPollerEventTypeNextSector ||
+        mfc_event->type == MfClassicPollerEventTypeKeyAttackStop) {
+        if(attack->key_scheduler) {
+            mf_classic_key_scheduler_start_sector(
+                attack->key_scheduler, nfc_poller_get_data(attack->poller));
+        } else {
+            keys_dict_rewind(attack->dict);
+        }
+    } else if(
+        mfc_event->type == MfClassicPollerEventTypeSuccess ||
+        mfc_event->type == MfClassicPollerEventTypeFail) {
+        attack->success = (mfc_event->type == MfClassicPollerEventTypeSuccess);
+        furi_thread_flags_set(attack->thread_id, NFC_TEST_MF_CLASSIC_DICT_ATTACK_DONE_EVENT);
+        command = NfcCommandStop;
+    }
+
+    return command;
+}
+
+static bool nfc_test_mf_classic_dict_attack(
+    const MfClassicData* card,
+    KeysDict* dict,
+    MfClassicKeyScheduler* key_scheduler,
+    MfClassicData* result,
+    uint32_t* auth_count) {
+    Nfc* poller = nfc_alloc();
+    Nfc* listener = nfc_alloc();
+
+    NfcListener* mfc_listener = nfc_listener_alloc(listener, NfcProtocolMfClassic, card);
+    nfc_listener_start(mfc_listener, NULL, NULL);
+
+    MfClassicData* data = mf_classic_alloc();
+    data->type = card->type;
+
+    NfcTestMfClassicDictAttack attack = {
+        .poller = nfc_poller_alloc(poller, NfcProtocolMfClassic),
+        .data = data,
+        .dict = dict,
+        .key_scheduler = key_scheduler,
+        .thread_id = furi_thread_get_current_id(),
+    };
+    nfc_transport_reset_mf_classic_auth_count();
+    nfc_poller_start(attack.poller, nfc_test_mf_classic_dict_attack_callback, &attack);
+    furi_thread_flags_wait(
+        NFC_TEST_MF_CLASSIC_DICT_ATTACK_DONE_EVENT, FuriFlagWaitAny, FuriWaitForever);
+    furi_thread_flags_clear(NFC_TEST_MF_CLASSIC_DICT_ATTACK_DONE_EVENT);
+    *auth_count += nfc_transport_get_mf_classic_auth_count();
+    mf_classic_copy(result, nfc_poller_get_data(attack.poller));
+    nfc_poller_stop(attack.poller);
+    nfc_poller_free(attack.poller);
+
+    nfc_listener_stop(mfc_listener);
+    nfc_listener_free(mfc_listener);
+
+    mf_classic_free(data);
+    nfc_free(listener);
+    nfc_free(poller);
+
+    // Attack succeeds only with all keys found
+    uint8_t sectors_read = 0;
+    uint8_t keys_found = 0;
+    mf_classic_get_read_sectors_and_keys(result, &sectors_read, &keys_found);
+    return attack.success && (keys_found == mf_classic_get_total_sectors_num(card->type) * 2);
+}
+
+static const uint8_t nfc_test_mf_classic_uid[] = {0x04, 0x51, 0x5C, 0xFA, 0x6F, 0x73, 0x81};
+
+static KeysDict* nfc_test_mf_classic_dict_alloc(const char* path) {
+    storage_simply_remove(nfc_test->storage, path);
+    return keys_dict_alloc(path, KeysDictModeOpenAlways, sizeof(MfClassicKey));
+}
+
+// Card with the key pair in every sector, both keys marked found
+static void nfc_test_mf_classic_fill_keys(MfClassicData* card, uint64_t key_a, uint64_t key_b) {
+    mf_classic_reset(card);
+    card->type = MfClassicTypeMini;
+    const uint8_t sectors_total = mf_classic_get_total_sectors_num(card->type);
+    for(uint8_t i = 0; i < sectors_total; i++) {
+        mf_classic_set_key_found(card, i, MfClassicKeyTypeA, key_a);
+        mf_classic_set_key_found(card, i, MfClassicKeyTypeB, key_b);
+    }
+}
+
+// Checks that the key is among the ranked keys given out first on an empty card
+static bool nfc_test_mf_classic_key_is_ranked(MfClassicKeyScheduler* key_scheduler, uint64_t key) {
+    MfClassicData* empty = mf_classic_alloc();
+    empty->type = MfClassicTypeMini;
+    mf_classic_key_scheduler_start_sector(key_scheduler, empty);
+    mf_classic_free(empty);
+
+    MfClassicKey ranked_key = {};
+    bool key_found = false;
+    while(!key_found && mf_classic_key_scheduler_get_next_key(key_scheduler, &ranked_key)) {
+        key_found = nfc_util_bytes2num(ranked_key.data, sizeof(MfClassicKey)) == key;
+    }
+
+    return key_found;
+}
+
+MU_TEST(mf_classic_key_scheduler_test) {
+    // Decoys first, so that keys in dictionary order are found last
+    KeysDict* dict = nfc_test_mf_classic_dict_alloc(NFC_TEST_MF_CLASSIC_DICT_PATH);
+    mu_assert(dict != NULL, "keys_dict_alloc() failed");
+    for(size_t i = 0; i < NFC_TEST_MF_CLASSIC_DECOY_KEY_NUM; i++) {
+        MfClassicKey key = nfc_test_mf_classic_decoy_key(i);
+        mu_assert(keys_dict_add_key(dict, key.data, sizeof(MfClassicKey)), "add key failed");
+    }
+    for(size_t i = 0; i < COUNT_OF(nfc_test_mf_classic_card_keys); i++) {
+        const MfClassicKey* key = &nfc_test_mf_classic_card_keys[i];
+        mu_assert(keys_dict_add_key(dict, key->data, sizeof(MfClassicKey)), "add key failed");
+    }
+
+    storage_simply_remove(nfc_test->storage, NFC_TEST_MF_CLASSIC_KEY_STATS_PATH);
+    MfClassicKeyScheduler* key_scheduler = mf_classic_key_scheduler_alloc();
+    mu_assert(
+        !mf_classic_key_scheduler_load_stats(key_scheduler, NFC_TEST_MF_CLASSIC_KEY_STATS_PATH),
+        "Stats loaded from missing file");
+    mf_classic_key_scheduler_set_dict(key_scheduler, dict);
+
+    // Synthetic corpus: a few keys reused across sectors and cards
+    NfcDevice* nfc_device = nfc_device_alloc();
+    MfClassicData* card = mf_classic_alloc();
+    MfClassicData* result = mf_classic_alloc();
+    uint32_t auth_dict_order = 0;
+    uint32_t auth_scheduled = 0;
+
+    for(size_t i = 0; i < NFC_TEST_MF_CLASSIC_CORPUS_SIZE; i++) {
+        nfc_data_generator_fill_data(NfcDataGeneratorTypeMfClassicMini, nfc_device);
+        mf_classic_copy(card, nfc_device_get_data(nfc_device, NfcProtocolMfClassic));
+        // Test transport emulates 7 byte UIDs only
+        mf_classic_set_uid(card, nfc_test_mf_classic_uid, sizeof(nfc_test_mf_classic_uid));
+        const uint8_t sectors_total = mf_classic_get_total_sectors_num(card->type);
+        for(uint8_t j = 0; j < sectors_total; j++) {
+            MfClassicSectorTrailer* sec_tr = mf_classic_get_sector_trailer_by_sector(card, j);
+            sec_tr->key_a = nfc_test_mf_classic_card_keys[(i + j) % 2];
+            sec_tr->key_b = nfc_test_mf_classic_card_keys[2];
+        }
+
+        mu_assert(
+            nfc_test_mf_classic_dict_attack(card, dict, NULL, result, &auth_dict_order),
+            "Dictionary attack failed");
+        mu_assert(
+            nfc_test_mf_classic_dict_attack(card, dict, key_scheduler, result, &auth_scheduled),
+            "Scheduled dictionary attack failed");
+        mf_classic_key_scheduler_add_card(key_scheduler, result);
+    }
+
+    FURI_LOG_I(
+        TAG,
+        "Auth attempts per card: %" PRIu32 " in dictionary order, %" PRIu32 " scheduled",
+        auth_dict_order / NFC_TEST_MF_CLASSIC_CORPUS_SIZE,
+        auth_scheduled / NFC_TEST_MF_CLASSIC_CORPUS_SIZE);
+    mu_assert(auth_scheduled < auth_dict_order, "Scheduler made more auth attempts");
+
+    // Ranked keys survive save and load
+    mu_assert(
+        mf_classic_key_scheduler_save_stats(key_scheduler, NFC_TEST_MF_CLASSIC_KEY_STATS_PATH),
+        "mf_classic_key_scheduler_save_stats() failed");
+    MfClassicKeyScheduler* key_scheduler_loaded = mf_classic_key_scheduler_alloc();
+    mu_assert(
+        mf_classic_key_scheduler_load_stats(
+            key_scheduler_loaded, NFC_TEST_MF_CLASSIC_KEY_STATS_PATH),
+        "mf_classic_key_scheduler_load_stats() failed");
+
+    // Ranked keys come first with the user dictionary
+    KeysDict* user_dict = nfc_test_mf_classic_dict_alloc(NFC_TEST_MF_CLASSIC_USER_DICT_PATH);
+    mu_assert(user_dict != NULL, "keys_dict_alloc() failed");
+    MfClassicKey decoy_key = nfc_test_mf_classic_decoy_key(0);
+    mu_assert(keys_dict_add_key(user_dict, decoy_key.data, sizeof(MfClassicKey)), "add failed");
+    mf_classic_key_scheduler_set_dict(key_scheduler_loaded, user_dict);
+
+    MfClassicData* empty = mf_classic_alloc();
+    empty->type = MfClassicTypeMini;
+    mf_classic_key_scheduler_start_sector(key_scheduler, empty);
+    mf_classic_key_scheduler_start_sector(key_scheduler_loaded, empty);
+
+    MfClassicKey key_ref = {};
+    MfClassicKey key_dut = {};
+    mu_assert(mf_classic_key_scheduler_get_next_key(key_scheduler, &key_ref), "No ranked keys");
+    mu_assert(
+        mf_classic_key_scheduler_get_next_key(key_scheduler_loaded, &key_dut),
+        "No ranked keys loaded");
+    mu_assert(memcmp(&key_ref, &key_dut, sizeof(MfClassicKey)) == 0, "Wrong key rank");
+
+    // Skipped dictionary was not tried on every sector, its keys are given out again
+    mf_classic_key_scheduler_set_dict(key_scheduler_loaded, dict);
+    mf_classic_key_scheduler_start_sector(key_scheduler_loaded, empty);
+    bool decoy_given = false;
+    while(!decoy_given && mf_classic_key_scheduler_get_next_key(key_scheduler_loaded, &key_dut)) {
+        decoy_given = memcmp(&key_dut, &decoy_key, sizeof(MfClassicKey)) == 0;
+    }
+    mu_assert(decoy_given, "Key of skipped dictionary not given");
+
+    // Keys of a finished dictionary and ranked keys tried with it are not given out again
+    mf_classic_key_scheduler_set_dict(key_scheduler_loaded, user_dict);
+    mf_classic_key_scheduler_finish_dict(key_scheduler_loaded);
+    mf_classic_key_scheduler_set_dict(key_scheduler_loaded, dict);
+    mf_classic_key_scheduler_start_sector(key_scheduler_loaded, empty);
+    size_t key_count = 0;
+    while(mf_classic_key_scheduler_get_next_key(key_scheduler_loaded, &key_dut)) {
+        mu_assert(memcmp(&key_dut, &decoy_key, sizeof(MfClassicKey)) != 0, "Seen key given");
+        for(size_t i = 0; i < COUNT_OF(nfc_test_mf_classic_card_keys); i++) {
+            mu_assert(
+                memcmp(&key_dut, &nfc_test_mf_classic_card_keys[i], sizeof(MfClassicKey)) != 0,
+                "Ranked key given again");
+        }
+        key_count++;
+    }
+    mu_assert(
+        key_count ==
+            keys_dict_get_total_keys(dict) - 1 - COUNT_OF(nfc_test_mf_classic_card_keys),
+        "Duplicate or missing keys given out");
+    mu_assert(
+        mf_classic_key_scheduler_get_dict_keys_read(key_scheduler_loaded) ==
+            keys_dict_get_total_keys(dict),
+        "Wrong dictionary position");
+
+    mf_classic_free(empty);
+    mf_classic_key_scheduler_free(key_scheduler_loaded);
+    mf_classic_key_scheduler_free(key_scheduler);
+    keys_dict_free(user_dict);
+    keys_dict_free(dict);
+    mf_classic_free(result);
+    mf_classic_free(card);
+    nfc_device_free(nfc_device);
+
+    storage_simply_remove(nfc_test->storage, NFC_TEST_MF_CLASSIC_KEY_STATS_PATH);
+    storage_simply_remove(nfc_test->storage, NFC_TEST_MF_CLASSIC_USER_DICT_PATH);
+    storage_simply_remove(nfc_test->storage, NFC_TEST_MF_CLASSIC_DICT_PATH);
+}
+
+MU_TEST(mf_classic_key_scheduler_eviction_test) {
+    MfClassicKeyScheduler* key_scheduler = mf_classic_key_scheduler_alloc();
+    MfClassicData* card = mf_classic_alloc();
+
+    // Fill the stats table with keys seen on two cards each
+    for(uint64_t i = 0; i < NFC_TEST_MF_CLASSIC_STALE_KEY_NUM; i += 2) {
+        nfc_test_mf_classic_fill_keys(card, i + 1, i + 2);
+        mf_classic_key_scheduler_add_card(key_scheduler, card);
+        mf_classic_key_scheduler_add_card(key_scheduler, card);
+    }
+    mu_assert(
+        nfc_test_mf_classic_key_is_ranked(key_scheduler, NFC_TEST_MF_CLASSIC_STALE_KEY_NUM),
+        "Recent key not ranked");
+
+    // New keys take the slots of stale ones instead of evicting each other
+    const uint64_t new_key_a = 0xA0A1A2A3A4A5;
+    const uint64_t new_key_b = 0xB0B1B2B3B4B5;
+    nfc_test_mf_classic_fill_keys(card, new_key_a, new_key_a);
+    mf_classic_key_scheduler_add_card(key_scheduler, card);
+    nfc_test_mf_classic_fill_keys(card, new_key_b, new_key_b);
+    mf_classic_key_scheduler_add_card(key_scheduler, card);
+    mu_assert(nfc_test_mf_classic_key_is_ranked(key_scheduler, new_key_a), "New key evicted");
+    mu_assert(nfc_test_mf_classic_key_is_ranked(key_scheduler, new_key_b), "New key not ranked");
+    mu_assert(!nfc_test_mf_classic_key_is_ranked(key_scheduler, 1), "Stale key not evicted");
+
+    // Keys decayed to zero weight are dropped, not ranked last
+    for(size_t i = 0; i < NFC_TEST_MF_CLASSIC_DECAY_CARD_NUM; i++) {
+        mf_classic_key_scheduler_add_card(key_scheduler, card);
+    }
+    mu_assert(
+        !nfc_test_mf_classic_key_is_ranked(key_scheduler, new_key_a), "Zero weight key ranked");
+    mu_assert(nfc_test_mf_classic_key_is_ranked(key_scheduler, new_key_b), "Recent key dropped");
+
+    mf_classic_free(card);
+    mf_classic_key_scheduler_free(key_scheduler);
+}
+
 MU_TEST(mf_classic_dict_test) {
     Storage* storage = furi_record_open(RECORD_STORAGE);
     if(storage_common_stat(storage, NFC_APP_MF_CLASSIC_DICT_UNIT_TEST_PATH, NULL) == FSE_OK) {
@@ -504,6 +1178,1181 @@ MU_TEST(mf_classic_dict_test) {
         "Remove test dict failed");
 }
 
+typedef enum {
+    NfcTestIso14443_4FaultNone,
+    NfcTestIso14443_4FaultCorruptResponse, /**< First response block has wrong CRC */
+    NfcTestIso14443_4FaultDropCommand, /**< First command block is not answered */
+    NfcTestIso14443_4FaultWtx, /**< Card requests waiting time extension */
+} NfcTestIso14443_4Fault;
+
+typedef struct {
+    uint32_t command_blocks;
+    uint32_t response_blocks;
+    uint8_t wtxm;
+    uint8_t pps1;
+    Iso14443_4aError pps_error; /**< PPS result on poller side */
+} NfcTestIso14443_4CardStats;
+
+// Builds the response to a complete command, the response is fixed otherwise
+typedef void (*NfcTestIso14443_4CardHandler)(
+    const BitBuffer* command,
+    BitBuffer* response,
+    void* context);
+
+// Scripted ISO14443-4 card that follows PICC rules of ISO14443-4 7.5.4.3
+typedef struct {
+    Nfc* nfc;
+    NfcTestIso14443_4Fault fault;
+    bool fault_done;
+    uint8_t block_number;
+    BitBuffer* command;
+    BitBuffer* response;
+    size_t response_offset;
+    size_t response_chunk_size;
+    BitBuffer* last_block;
+    BitBuffer* tx_buffer;
+    NfcTestIso14443_4CardHandler handler;
+    void* handler_context;
+    const uint8_t* ats; // nfc_test_iso14443_4_ats if NULL
+    size_t ats_size;
+    NfcTestIso14443_4CardStats stats;
+} NfcTestIso14443_4Card;
+
+typedef struct {
+    FuriThreadId thread_id;
+    const BitBuffer* command;
+    BitBuffer* response;
+    Iso14443_4aPollerBitRate bit_rate;
+    Iso14443_4aError pps_error;
+    Iso14443_4aError error;
+} NfcTestIso14443_4Poller;
+
+// FSCI 2 (32 bytes), all bit rates, FWI 8
+static const uint8_t nfc_test_iso14443_4_ats[] = {0x05, 0x72, 0x77, 0x81, 0x00};
+// DESFire EV1: FSCI 5 (64 bytes), all bit rates, FWI 8
+static const uint8_t nfc_test_mf_desfire_ats[] = {0x06, 0x75, 0x77, 0x81, 0x02, 0x80};
+
+static bool nfc_test_iso14443_4_card_take_fault(
+    NfcTestIso14443_4Card* card,
+    NfcTestIso14443_4Fault fault) {
+    const bool take = (card->fault == fault) && !card->fault_done;
+    if(take) card->fault_done = true;
+    return take;
+}
+
+static void nfc_test_iso14443_4_card_send(NfcTestIso14443_4Card* card, bool corrupt) {
+    bit_buffer_copy(card->tx_buffer, card->last_block);
+    iso14443_crc_append(Iso14443CrcTypeA, card->tx_buffer);
+    if(corrupt) {
+        const size_t crc_index = bit_buffer_get_size_bytes(card->tx_buffer) - 1;
+        bit_buffer_set_byte(
+            card->tx_buffer, crc_index, bit_buffer_get_byte(card->tx_buffer, crc_index) ^ 0xFF);
+    }
+    nfc_listener_tx(card->nfc, card->tx_buffer);
+}
+
+static void nfc_test_iso14443_4_card_send_r_ack(NfcTestIso14443_4Card* card) {
+    bit_buffer_reset(card->last_block);
+    bit_buffer_append_byte(card->last_block, 0xA2 | card->block_number);
+    nfc_test_iso14443_4_card_send(card, false);
+}
+
+static void nfc_test_iso14443_4_card_send_response(NfcTestIso14443_4Card* card) {
+    const size_t response_size = bit_buffer_get_size_bytes(card->response);
+    card->response_chunk_size =
+        MIN(response_size - card->response_offset, NFC_TEST_ISO14443_4_CARD_CHUNK_SIZE);
+    const bool chaining = card->response_offset + card->response_chunk_size < response_size;
+
+    bit_buffer_reset(card->last_block);
+    bit_buffer_append_byte(card->last_block, 0x02 | card->block_number | (chaining ? 0x10 : 0));
+    bit_buffer_append_bytes(
+        card->last_block,
+        bit_buffer_get_data(card->response) + card->response_offset,
+        card->response_chunk_size);
+    card->stats.response_blocks++;
+
+    nfc_test_iso14443_4_card_send(
+        card,
+        nfc_test_iso14443_4_card_take_fault(card, NfcTestIso14443_4FaultCorruptResponse));
+}
+
+static void nfc_test_iso14443_4_card_handle_command(NfcTestIso14443_4Card* card) {
+    if(card->handler) {
+        bit_buffer_reset(card->response);
+        card->handler(card->command, card->response, card->handler_context);
+        bit_buffer_reset(card->command);
+    }
+}
+
+static NfcCommand nfc_test_iso14443_4_card_callback(NfcEvent event, void* context) {
+    NfcTestIso14443_4Card* card = context;
+
+    if(event.type != NfcEventTypeRxEnd) return NfcCommandContinue;
+
+    BitBuffer* rx_buffer = event.data.buffer;
+    if(!iso14443_crc_check(Iso14443CrcTypeA, rx_buffer)) return NfcCommandContinue;
+    iso14443_crc_trim(rx_buffer);
+
+    const uint8_t pcb = bit_buffer_get_byte(rx_buffer, 0);
+    const uint8_t bn = pcb & 0x01;
+
+    if(pcb == 0xE0) {
+        // RATS
+        card->block_number = 1;
+        if(card->ats) {
+            bit_buffer_copy_bytes(card->last_block, card->ats, card->ats_size);
+        } else {
+            bit_buffer_copy_bytes(
+                card->last_block, nfc_test_iso14443_4_ats, sizeof(nfc_test_iso14443_4_ats));
+        }
+        nfc_test_iso14443_4_card_send(card, false);
+    } else if(pcb == 0xD0) {
+        // PPS
+        card->stats.pps1 = bit_buffer_get_byte(rx_buffer, 2);
+        bit_buffer_reset(card->last_block);
+        bit_buffer_append_byte(card->last_block, 0xD0);
+        nfc_test_iso14443_4_card_send(card, false);
+    } else if((pcb & 0xE2) == 0x02) {
+        // I-block
+        if(nfc_test_iso14443_4_card_take_fault(card, NfcTestIso14443_4FaultDropCommand)) {
+            return NfcCommandContinue;
+        }
+        card->block_number ^= 1;
+        card->stats.command_blocks++;
+        bit_buffer_append_right(card->command, rx_buffer, 1);
+
+        if(pcb & 0x10) {
+            nfc_test_iso14443_4_card_send_r_ack(card);
+        } else {
+            nfc_test_iso14443_4_card_handle_command(card);
+
+            if(nfc_test_iso14443_4_card_take_fault(card, NfcTestIso14443_4FaultWtx)) {
+                bit_buffer_reset(card->last_block);
+                bit_buffer_append_byte(card->last_block, 0xF2);
+                bit_buffer_append_byte(card->last_block, 0x02);
+                nfc_test_iso14443_4_card_send(card, false);
+            } else {
+                card->response_offset = 0;
+                nfc_test_iso14443_4_card_send_response(card);
+            }
+        }
+    } else if((pcb & 0xE6) == 0xA2) {
+        // R-block
+        if(bn == card->block_number) {
+            nfc_test_iso14443_4_card_send(card, false);
+        } else if(pcb & 0x10) {
+            nfc_test_iso14443_4_card_send_r_ack(card);
+        } else {
+            card->block_number ^= 1;
+            card->response_offset += card->response_chunk_size;
+            nfc_test_iso14443_4_card_send_response(card);
+        }
+    } else if(pcb == 0xF2) {
+        // S(WTX) response
+        card->stats.wtxm = bit_buffer_get_byte(rx_buffer, 1);
+        card->response_offset = 0;
+        nfc_test_iso14443_4_card_send_response(card);
+    }
+
+    return NfcCommandContinue;
+}
+
+static NfcCommand nfc_test_iso14443_4_poller_callback(NfcGenericEvent event, void* context) {
+    NfcTestIso14443_4Poller* poller_context = context;
+    const Iso14443_4aPollerEvent* iso14443_4a_event = event.event_data;
+
+    if(iso14443_4a_event->type == Iso14443_4aPollerEventTypeReady) {
+        Iso14443_4aPoller* poller = event.instance;
+        poller_context->error = Iso14443_4aErrorNone;
+
+        if(poller_context->bit_rate != Iso14443_4aPollerBitRate106Kbit) {
+            poller_context->pps_error = iso14443_4a_poller_send_pps(
+                poller, poller_context->bit_rate, poller_context->bit_rate);
+        }
+        // PPS is optional, a refused bit rate leaves the exchange at 106 kbps
+        poller_context->error = iso14443_4a_poller_send_block(
+            poller, poller_context->command, poller_context->response);
+    } else {
+        poller_context->error = iso14443_4a_event->data->error;
+    }
+
+    furi_thread_flags_set(poller_context->thread_id, NFC_TEST_ISO14443_4_POLLER_DONE_EVENT);
+    return NfcCommandStop;
+}
+
+static void iso14443_4a_exchange_test(
+    NfcTestIso14443_4Fault fault,
+    size_t command_size,
+    size_t response_size,
+    Iso14443_4aPollerBitRate bit_rate,
+    NfcTestIso14443_4CardStats* stats) {
+    Nfc* poller = nfc_alloc();
+    Nfc* listener = nfc_alloc();
+
+    NfcTestIso14443_4Card card = {
+        .nfc = listener,
+        .fault = fault,
+        .command = bit_buffer_alloc(NFC_TEST_ISO14443_4_BUF_SIZE),
+        .response = bit_buffer_alloc(NFC_TEST_ISO14443_4_BUF_SIZE),
+        .last_block = bit_buffer_alloc(NFC_TEST_ISO14443_4_BUF_SIZE),
+        .tx_buffer = bit_buffer_alloc(NFC_TEST_ISO14443_4_BUF_SIZE),
+    };
+    BitBuffer* command = bit_buffer_alloc(NFC_TEST_ISO14443_4_BUF_SIZE);
+    for(size_t i = 0; i < command_size; i++) {
+        bit_buffer_append_byte(command, i);
+    }
+    for(size_t i = 0; i < response_size; i++) {
+        bit_buffer_append_byte(card.response, 0xA5 ^ i);
+    }
+
+    uint8_t uid[] = {0x04, 0x51, 0x5C, 0xFA, 0x6F, 0x73, 0x81};
+    uint8_t atqa[] = {0x44, 0x00};
+    nfc_config(listener, NfcModeListener, NfcTechIso14443a);
+    nfc_iso14443a_listener_set_col_res_data(listener, uid, sizeof(uid), atqa, 0x20);
+    nfc_start(listener, nfc_test_iso14443_4_card_callback, &card);
+
+    NfcTestIso14443_4Poller poller_context = {
+        .thread_id = furi_thread_get_current_id(),
+        .command = command,
+        .response = bit_buffer_alloc(NFC_TEST_ISO14443_4_BUF_SIZE),
+        .bit_rate = bit_rate,
+        .pps_error = Iso14443_4aErrorNone,
+        .error = Iso14443_4aErrorProtocol,
+    };
+    NfcPoller* iso4_poller = nfc_poller_alloc(poller, NfcProtocolIso14443_4a);
+    nfc_poller_start(iso4_poller, nfc_test_iso14443_4_poller_callback, &poller_context);
+    furi_thread_flags_wait(
+        NFC_TEST_ISO14443_4_POLLER_DONE_EVENT, FuriFlagWaitAny, FuriWaitForever);
+    furi_thread_flags_clear(NFC_TEST_ISO14443_4_POLLER_DONE_EVENT);
+    nfc_poller_stop(iso4_poller);
+    nfc_poller_free(iso4_poller);
+
+    nfc_stop(listener);
+
+    mu_assert(poller_context.error == Iso14443_4aErrorNone, "iso14443_4a exchange failed");
+    mu_assert(bit_buffer_get_size_bytes(card.command) == command_size, "Wrong command size");
+    mu_assert(
+        memcmp(bit_buffer_get_data(card.command), bit_buffer_get_data(command), command_size) ==
+            0,
+        "Command not matches");
+    mu_assert(
+        bit_buffer_get_size_bytes(poller_context.response) == response_size,
+        "Wrong response size");
+    mu_assert(
+        memcmp(
+            bit_buffer_get_data(poller_context.response),
+            bit_buffer_get_data(card.response),
+            response_size) == 0,
+        "Response not matches");
+    mu_assert(fault == NfcTestIso14443_4FaultNone || card.fault_done, "Fault not injected");
+    *stats = card.stats;
+    stats->pps_error = poller_context.pps_error;
+
+    bit_buffer_free(poller_context.response);
+    bit_buffer_free(command);
+    bit_buffer_free(card.tx_buffer);
+    bit_buffer_free(card.last_block);
+    bit_buffer_free(card.response);
+    bit_buffer_free(card.command);
+    nfc_free(listener);
+    nfc_free(poller);
+}
+
+MU_TEST(iso14443_4a_chaining_test) {
+    NfcTestIso14443_4CardStats stats = {};
+    iso14443_4a_exchange_test(
+        NfcTestIso14443_4FaultNone, 100, 200, Iso14443_4aPollerBitRate106Kbit, &stats);
+
+    // 29 bytes per command block with FSC 32
+    mu_assert(stats.command_blocks == 4, "Command was not chained");
+    mu_assert(stats.response_blocks == 4, "Response was not chained");
+}
+
+MU_TEST(iso14443_4a_wtx_test) {
+    NfcTestIso14443_4CardStats stats = {};
+    iso14443_4a_exchange_test(
+        NfcTestIso14443_4FaultWtx, 16, 16, Iso14443_4aPollerBitRate106Kbit, &stats);
+
+    mu_assert(stats.wtxm == 0x02, "WTXM not echoed");
+}
+
+MU_TEST(iso14443_4a_corrupted_response_test) {
+    NfcTestIso14443_4CardStats stats = {};
+    iso14443_4a_exchange_test(
+        NfcTestIso14443_4FaultCorruptResponse, 16, 100, Iso14443_4aPollerBitRate106Kbit, &stats);
+
+    mu_assert(stats.command_blocks == 1, "Command was retransmitted");
+}
+
+MU_TEST(iso14443_4a_lost_command_test) {
+    NfcTestIso14443_4CardStats stats = {};
+    iso14443_4a_exchange_test(
+        NfcTestIso14443_4FaultDropCommand, 100, 16, Iso14443_4aPollerBitRate106Kbit, &stats);
+
+    mu_assert(stats.command_blocks == 4, "Wrong command block count");
+}
+
+MU_TEST(iso14443_4a_pps_test) {
+    NfcTestIso14443_4CardStats stats = {};
+    iso14443_4a_exchange_test(
+        NfcTestIso14443_4FaultNone, 16, 16, Iso14443_4aPollerBitRate424Kbit, &stats);
+
+    NfcIso14443aBitRate tx_bit_rate = NfcIso14443aBitRate106Kbit;
+    NfcIso14443aBitRate rx_bit_rate = NfcIso14443aBitRate106Kbit;
+    nfc_transport_get_bit_rate(&tx_bit_rate, &rx_bit_rate);
+
+    // DSI and DRI for 424 kbps
+    mu_assert(stats.pps_error == Iso14443_4aErrorNone, "PPS failed");
+    mu_assert(stats.pps1 == 0x0A, "Wrong PPS1");
+    mu_assert(tx_bit_rate == NfcIso14443aBitRate424Kbit, "Wrong poller tx bit rate");
+    mu_assert(rx_bit_rate == NfcIso14443aBitRate424Kbit, "Wrong poller rx bit rate");
+}
+
+MU_TEST(iso14443_4a_pps_not_supported_test) {
+    NfcTestIso14443_4CardStats stats = {};
+    // Same as the device receiver, tuned for 106 kbps only
+    nfc_transport_set_bit_rate_max(NfcIso14443aBitRate106Kbit);
+    iso14443_4a_exchange_test(
+        NfcTestIso14443_4FaultNone, 16, 16, Iso14443_4aPollerBitRate424Kbit, &stats);
+    nfc_transport_set_bit_rate_max(NfcIso14443aBitRate848Kbit);
+
+    NfcIso14443aBitRate tx_bit_rate = NfcIso14443aBitRate848Kbit;
+    NfcIso14443aBitRate rx_bit_rate = NfcIso14443aBitRate848Kbit;
+    nfc_transport_get_bit_rate(&tx_bit_rate, &rx_bit_rate);
+
+    mu_assert(stats.pps_error == Iso14443_4aErrorProtocol, "PPS not refused");
+    mu_assert(stats.pps1 == 0, "PPS sent to card");
+    mu_assert(tx_bit_rate == NfcIso14443aBitRate106Kbit, "Wrong poller tx bit rate");
+    mu_assert(rx_bit_rate == NfcIso14443aBitRate106Kbit, "Wrong poller rx bit rate");
+}
+
+typedef struct {
+    MfDesfireFileId id;
+    MfDesfireFileType type;
+    MfDesfireFileAccessRights access_rights;
+    uint32_t size; // Data size or record size
+    uint32_t record_count;
+} NfcTestMfDesfireFile;
+
+typedef struct {
+    MfDesfireApplicationId id;
+    const NfcTestMfDesfireFile* files;
+    size_t file_count;
+} NfcTestMfDesfireApp;
+
+// Native DESFire card on top of the scripted ISO14443-4 card
+typedef struct {
+    const NfcTestMfDesfireApp* apps;
+    size_t app_count;
+    const NfcTestMfDesfireApp* selected_app;
+    BitBuffer* answer;
+    size_t answer_offset;
+    uint32_t frames;
+    uint32_t read_commands;
+    uint32_t denied_reads;
+    bool empty_frames; // AF requests are answered with no status byte
+} NfcTestMfDesfireCard;
+
+typedef struct {
+    FuriThreadId thread_id;
+    bool success;
+} NfcTestMfDesfirePoller;
+
+// Read key 1, write key free: only GetValue is allowed without authentication
+#define NFC_TEST_MF_DESFIRE_WRITE_FREE (0x1E11)
+#define NFC_TEST_MF_DESFIRE_ALL_FREE (0xEEEE)
+#define NFC_TEST_MF_DESFIRE_ALL_KEY_0 (0x0000)
+
+static const NfcTestMfDesfireFile nfc_test_mf_desfire_app_1_files[] = {
+    {0, MfDesfireFileTypeStandard, NFC_TEST_MF_DESFIRE_ALL_FREE, 32, 0},
+    {1,
+     MfDesfireFileTypeBackup,
+     NFC_TEST_MF_DESFIRE_ALL_FREE,
+     NFC_TEST_MF_DESFIRE_BIG_FILE_SIZE,
+     0},
+    {2, MfDesfireFileTypeStandard, NFC_TEST_MF_DESFIRE_ALL_KEY_0, 64, 0},
+    {3, MfDesfireFileTypeValue, NFC_TEST_MF_DESFIRE_WRITE_FREE, MF_DESFIRE_VALUE_SIZE, 0},
+    {4, MfDesfireFileTypeLinearRecord, NFC_TEST_MF_DESFIRE_ALL_FREE, 16, 3},
+    {5, MfDesfireFileTypeCyclicRecord, NFC_TEST_MF_DESFIRE_ALL_FREE, 8, 0},
+};
+
+static const NfcTestMfDesfireFile nfc_test_mf_desfire_app_2_files[] = {
+    {1, MfDesfireFileTypeStandard, NFC_TEST_MF_DESFIRE_WRITE_FREE, 48, 0},
+    {7, MfDesfireFileTypeStandard, NFC_TEST_MF_DESFIRE_ALL_FREE, 100, 0},
+    {8,
+     MfDesfireFileTypeCyclicRecord,
+     NFC_TEST_MF_DESFIRE_ALL_FREE,
+     NFC_TEST_MF_DESFIRE_BIG_RECORD_SIZE,
+     NFC_TEST_MF_DESFIRE_BIG_RECORD_COUNT},
+};
+
+static const NfcTestMfDesfireApp nfc_test_mf_desfire_apps[] = {
+    {
+        .id = {{0x01, 0x00, 0x00}},
+        .files = nfc_test_mf_desfire_app_1_files,
+        .file_count = COUNT_OF(nfc_test_mf_desfire_app_1_files),
+    },
+    {
+        .id = {{0x02, 0x00, 0x00}},
+        .files = nfc_test_mf_desfire_app_2_files,
+        .file_count = COUNT_OF(nfc_test_mf_desfire_app_2_files),
+    },
+};
+
+static uint8_t nfc_test_mf_desfire_file_byte(const NfcTestMfDesfireFile* file, size_t index) {
+    return (file->id * 31 + index) & 0xFF;
+}
+
+static size_t nfc_test_mf_desfire_file_data_size(const NfcTestMfDesfireFile* file) {
+    const bool is_record = file->type == MfDesfireFileTypeLinearRecord ||
+                           file->type == MfDesfireFileTypeCyclicRecord;
+    return is_record ? file->size * file->record_count : file->size;
+}
+
+static bool nfc_test_mf_desfire_file_is_readable(const NfcTestMfDesfireFile* file) {
+    const uint8_t read_key = file->access_rights >> 12 & 0x0F;
+    const uint8_t write_key = file->access_rights >> 8 & 0x0F;
+    const uint8_t read_write_key = file->access_rights >> 4 & 0x0F;
+
+    return read_key == MF_DESFIRE_ACCESS_FREE || read_write_key == MF_DESFIRE_ACCESS_FREE ||
+           (file->type == MfDesfireFileTypeValue && write_key == MF_DESFIRE_ACCESS_FREE);
+}
+
+static const NfcTestMfDesfireFile*
+    nfc_test_mf_desfire_card_get_file(NfcTestMfDesfireCard* card, MfDesfireFileId id) {
+    const NfcTestMfDesfireFile* file = NULL;
+
+    if(card->selected_app) {
+        for(size_t i = 0; i < card->selected_app->file_count; i++) {
+            if(card->selected_app->files[i].id == id) {
+                file = &card->selected_app->files[i];
+                break;
+            }
+        }
+    }
+
+    return file;
+}
+
+static void nfc_test_mf_desfire_card_next_frame(NfcTestMfDesfireCard* card, BitBuffer* response) {
+    const size_t answer_size = bit_buffer_get_size_bytes(card->answer);
+    const size_t frame_size =
+        MIN(answer_size - card->answer_offset, NFC_TEST_MF_DESFIRE_FRAME_SIZE);
+    const bool has_next = card->answer_offset + frame_size < answer_size;
+
+    bit_buffer_append_byte(response, has_next ? MF_DESFIRE_FLAG_HAS_NEXT : 0x00);
+    bit_buffer_append_bytes(
+        response, bit_buffer_get_data(card->answer) + card->answer_offset, frame_size);
+    card->answer_offset += frame_size;
+}
+
+static void nfc_test_mf_desfire_card_append_file_data(
+    NfcTestMfDesfireCard* card,
+    const NfcTestMfDesfireFile* file,
+    size_t offset,
+    size_t size) {
+    for(size_t i = 0; i < size; i++) {
+        bit_buffer_append_byte(card->answer, nfc_test_mf_desfire_file_byte(file, offset + i));
+    }
+}
+
+static void nfc_test_mf_desfire_card_append_file_settings(
+    NfcTestMfDesfireCard* card,
+    const NfcTestMfDesfireFile* file) {
+    bit_buffer_append_byte(card->answer, file->type);
+    bit_buffer_append_byte(card->answer, MfDesfireFileCommunicationSettingsPlaintext);
+    bit_buffer_append_bytes(card->answer, (const uint8_t*)&file->access_rights, 2);
+
+    if(file->type == MfDesfireFileTypeValue) {
+        const uint32_t value_settings[] = {0, 1000, 0};
+        bit_buffer_append_bytes(
+            card->answer, (const uint8_t*)value_settings, sizeof(value_settings));
+        bit_buffer_append_byte(card->answer, 0);
+    } else {
+        bit_buffer_append_bytes(card->answer, (const uint8_t*)&file->size, 3);
+    }
+
+    if(file->type == MfDesfireFileTypeLinearRecord ||
+       file->type == MfDesfireFileTypeCyclicRecord) {
+        bit_buffer_append_bytes(card->answer, (const uint8_t*)&file->record_count, 3);
+        bit_buffer_append_bytes(card->answer, (const uint8_t*)&file->record_count, 3);
+    }
+}
+
+static void nfc_test_mf_desfire_card_handler(
+    const BitBuffer* command,
+    BitBuffer* response,
+    void* context) {
+    NfcTestMfDesfireCard* card = context;
+    card->frames++;
+
+    const uint8_t cmd = bit_buffer_get_byte(command, 0);
+    const size_t command_size = bit_buffer_get_size_bytes(command);
+
+    if(cmd == MF_DESFIRE_FLAG_HAS_NEXT) {
+        if(!card->empty_frames) nfc_test_mf_desfire_card_next_frame(card, response);
+        return;
+    }
+
+    uint8_t status = 0x00;
+    bit_buffer_reset(card->answer);
+    card->answer_offset = 0;
+
+    const NfcTestMfDesfireFile* file = NULL;
+    if(command_size > 1) {
+        file = nfc_test_mf_desfire_card_get_file(card, bit_buffer_get_byte(command, 1));
+    }
+
+    uint32_t offset = 0;
+    uint32_t length = 0;
+    if(command_size == 8) {
+        bit_buffer_write_bytes_mid(command, &offset, 2, 3);
+        bit_buffer_write_bytes_mid(command, &length, 5, 3);
+    }
+
+    if(cmd == MF_DESFIRE_CMD_GET_VERSION) {
+        MfDesfireVersion version = {
+            .hw_vendor = 0x04,
+            .hw_type = 0x01,
+            .hw_major = 0x01,
+            .hw_storage = 0x18,
+            .hw_proto = 0x05,
+            .sw_vendor = 0x04,
+            .sw_type = 0x01,
+            .sw_major = 0x01,
+            .sw_storage = 0x18,
+            .sw_proto = 0x05,
+            .uid = {0x04, 0x51, 0x5C, 0xFA, 0x6F, 0x73, 0x81},
+        };
+        // Hardware info goes in its own frame like on real cards
+        bit_buffer_append_bytes(card->answer, (const uint8_t*)&version, sizeof(version));
+        bit_buffer_append_byte(response, MF_DESFIRE_FLAG_HAS_NEXT);
+        bit_buffer_append_bytes(response, (const uint8_t*)&version, 7);
+        card->answer_offset = 7;
+        return;
+    } else if(cmd == MF_DESFIRE_CMD_GET_FREE_MEMORY) {
+        const uint8_t free_memory[] = {0x00, 0x10, 0x00};
+        bit_buffer_append_bytes(card->answer, free_memory, sizeof(free_memory));
+    } else if(cmd == MF_DESFIRE_CMD_GET_KEY_SETTINGS) {
+        const uint8_t key_settings[] = {0x0F, 0x01};
+        bit_buffer_append_bytes(card->answer, key_settings, sizeof(key_settings));
+    } else if(cmd == MF_DESFIRE_CMD_GET_KEY_VERSION) {
+        bit_buffer_append_byte(card->answer, 0x00);
+    } else if(cmd == MF_DESFIRE_CMD_GET_APPLICATION_IDS) {
+        for(size_t i = 0; i < card->app_count; i++) {
+            bit_buffer_append_bytes(
+                card->answer, card->apps[i].id.data, sizeof(MfDesfireApplicationId));
+        }
+    } else if(cmd == MF_DESFIRE_CMD_SELECT_APPLICATION) {
+        card->selected_app = NULL;
+        for(size_t i = 0; i < card->app_count; i++) {
+            if(memcmp(
+                   bit_buffer_get_data(command) + 1,
+                   card->apps[i].id.data,
+                   sizeof(MfDesfireApplicationId)) == 0) {
+                card->selected_app = &card->apps[i];
+            }
+        }
+        if(!card->selected_app) status = 0xA0;
+    } else if(cmd == MF_DESFIRE_CMD_GET_FILE_IDS && card->selected_app) {
+        for(size_t i = 0; i < card->selected_app->file_count; i++) {
+            bit_buffer_append_byte(card->answer, card->selected_app->files[i].id);
+        }
+    } else if(cmd == MF_DESFIRE_CMD_GET_FILE_SETTINGS && file) {
+        nfc_test_mf_desfire_card_append_file_settings(card, file);
+    } else if(
+        (cmd == MF_DESFIRE_CMD_READ_DATA || cmd == MF_DESFIRE_CMD_GET_VALUE ||
+         cmd == MF_DESFIRE_CMD_READ_RECORDS) &&
+        file) {
+        card->read_commands++;
+        if(!nfc_test_mf_desfire_file_is_readable(file)) {
+            card->denied_reads++;
+            status = 0x9D;
+        } else if(cmd == MF_DESFIRE_CMD_GET_VALUE) {
+            nfc_test_mf_desfire_card_append_file_data(card, file, 0, MF_DESFIRE_VALUE_SIZE);
+        } else if(cmd == MF_DESFIRE_CMD_READ_RECORDS) {
+            // Offset counts back from the newest record, records are sent oldest first
+            if(length == 0 || offset + length > file->record_count) {
+                status = 0xBE;
+            } else {
+                const size_t first_record = file->record_count - offset - length;
+                nfc_test_mf_desfire_card_append_file_data(
+                    card, file, first_record * file->size, length * file->size);
+            }
+        } else if(length == 0 || offset + length > file->size) {
+            status = 0xBE;
+        } else {
+            nfc_test_mf_desfire_card_append_file_data(card, file, offset, length);
+        }
+    } else {
+        status = 0x1C;
+    }
+
+    if(status == 0x00) {
+        nfc_test_mf_desfire_card_next_frame(card, response);
+    } else {
+        bit_buffer_append_byte(response, status);
+    }
+}
+
+static NfcCommand nfc_test_mf_desfire_poller_callback(NfcGenericEvent event, void* context) {
+    NfcTestMfDesfirePoller* poller_context = context;
+    const MfDesfirePollerEvent* mf_desfire_event = event.event_data;
+
+    poller_context->success = (mf_desfire_event->type == MfDesfirePollerEventTypeReadSuccess);
+    furi_thread_flags_set(poller_context->thread_id, NFC_TEST_MF_DESFIRE_POLLER_DONE_EVENT);
+
+    return NfcCommandStop;
+}
+
+static void nfc_test_mf_desfire_check_data(const MfDesfireData* data) {
+    mu_assert(
+        simple_array_get_count(data->applications) == COUNT_OF(nfc_test_mf_desfire_apps),
+        "Wrong application count");
+
+    for(size_t i = 0; i < COUNT_OF(nfc_test_mf_desfire_apps); i++) {
+        const NfcTestMfDesfireApp* test_app = &nfc_test_mf_desfire_apps[i];
+        const MfDesfireApplication* app = mf_desfire_get_application(data, &test_app->id);
+        mu_assert(app, "Application not read");
+
+        for(size_t j = 0; j < test_app->file_count; j++) {
+            const NfcTestMfDesfireFile* test_file = &test_app->files[j];
+            const MfDesfireFileData* file_data = mf_desfire_get_file_data(app, &test_file->id);
+            mu_assert(file_data, "File not read");
+
+            const size_t expected_size = nfc_test_mf_desfire_file_is_readable(test_file) ?
+                                             nfc_test_mf_desfire_file_data_size(test_file) :
+                                             0;
+            mu_assert(
+                simple_array_get_count(file_data->data) == expected_size, "Wrong file data size");
+
+            for(size_t k = 0; k < expected_size; k++) {
+                const uint8_t* byte = simple_array_cget(file_data->data, k);
+                mu_assert(*byte == nfc_test_mf_desfire_file_byte(test_file, k), "Wrong file data");
+            }
+        }
+    }
+}
+
+static bool nfc_test_mf_desfire_read(NfcTestMfDesfireCard* desfire_card, MfDesfireData* data) {
+    Nfc* poller = nfc_alloc();
+    Nfc* listener = nfc_alloc();
+
+    NfcTestIso14443_4Card card = {
+        .nfc = listener,
+        .command = bit_buffer_alloc(NFC_TEST_ISO14443_4_BUF_SIZE),
+        .response = bit_buffer_alloc(NFC_TEST_ISO14443_4_BUF_SIZE),
+        .last_block = bit_buffer_alloc(NFC_TEST_ISO14443_4_BUF_SIZE),
+        .tx_buffer = bit_buffer_alloc(NFC_TEST_ISO14443_4_BUF_SIZE),
+        .handler = nfc_test_mf_desfire_card_handler,
+        .handler_context = desfire_card,
+        .ats = nfc_test_mf_desfire_ats,
+        .ats_size = sizeof(nfc_test_mf_desfire_ats),
+    };
+
+    uint8_t uid[] = {0x04, 0x51, 0x5C, 0xFA, 0x6F, 0x73, 0x81};
+    uint8_t atqa[] = {0x44, 0x03};
+    nfc_config(listener, NfcModeListener, NfcTechIso14443a);
+    nfc_iso14443a_listener_set_col_res_data(listener, uid, sizeof(uid), atqa, 0x20);
+    nfc_start(listener, nfc_test_iso14443_4_card_callback, &card);
+
+    NfcTestMfDesfirePoller poller_context = {
+        .thread_id = furi_thread_get_current_id(),
+    };
+    nfc_transport_reset_frame_count();
+
+    NfcPoller* mf_desfire_poller = nfc_poller_alloc(poller, NfcProtocolMfDesfire);
+    nfc_poller_start(mf_desfire_poller, nfc_test_mf_desfire_poller_callback, &poller_context);
+    furi_thread_flags_wait(
+        NFC_TEST_MF_DESFIRE_POLLER_DONE_EVENT, FuriFlagWaitAny, FuriWaitForever);
+    furi_thread_flags_clear(NFC_TEST_MF_DESFIRE_POLLER_DONE_EVENT);
+    nfc_poller_stop(mf_desfire_poller);
+
+    const uint32_t round_trips = nfc_transport_get_frame_count();
+    const uint32_t bytes = nfc_transport_get_byte_count();
+    FURI_LOG_I(
+        TAG,
+        "DESFire read: %" PRIu32 " round trips, %" PRIu32 " bytes, %" PRIu32 " DESFire frames",
+        round_trips,
+        bytes,
+        desfire_card->frames);
+
+    mf_desfire_copy(data, nfc_poller_get_data(mf_desfire_poller));
+    nfc_poller_free(mf_desfire_poller);
+    nfc_stop(listener);
+
+    bit_buffer_free(card.tx_buffer);
+    bit_buffer_free(card.last_block);
+    bit_buffer_free(card.response);
+    bit_buffer_free(card.command);
+    nfc_free(listener);
+    nfc_free(poller);
+
+    return poller_context.success;
+}
+
+MU_TEST(mf_desfire_read_plan_test) {
+    NfcTestMfDesfireCard desfire_card = {
+        .apps = nfc_test_mf_desfire_apps,
+        .app_count = COUNT_OF(nfc_test_mf_desfire_apps),
+        .answer = bit_buffer_alloc(NFC_TEST_MF_DESFIRE_BIG_FILE_SIZE),
+    };
+    MfDesfireData* data = mf_desfire_alloc();
+
+    mu_assert(nfc_test_mf_desfire_read(&desfire_card, data), "DESFire read failed");
+    nfc_test_mf_desfire_check_data(data);
+
+    // Denied and empty files are not read, the 600 byte file takes two ReadData commands
+    // and the 640 byte record file two ReadRecords commands
+    mu_assert(desfire_card.denied_reads == 0, "Files denying access were read");
+    mu_assert(desfire_card.read_commands == 8, "Wrong read command count");
+
+    // Version 2, PICC level 4, applications 10 and 7, file reads 1 + 11 + 1 + 1 + 2 + 12
+    mu_assert(desfire_card.frames == 51, "Wrong DESFire frame count");
+
+    mf_desfire_free(data);
+    bit_buffer_free(desfire_card.answer);
+}
+
+MU_TEST(mf_desfire_empty_frame_test) {
+    NfcTestMfDesfireCard desfire_card = {
+        .apps = nfc_test_mf_desfire_apps,
+        .app_count = COUNT_OF(nfc_test_mf_desfire_apps),
+        .answer = bit_buffer_alloc(NFC_TEST_MF_DESFIRE_BIG_FILE_SIZE),
+        .empty_frames = true,
+    };
+    MfDesfireData* data = mf_desfire_alloc();
+
+    // Second GetVersion frame comes without status byte
+    mu_assert(!nfc_test_mf_desfire_read(&desfire_card, data), "Empty frame accepted");
+    mu_assert(desfire_card.frames == 2, "Read went on after empty frame");
+
+    mf_desfire_free(data);
+    bit_buffer_free(desfire_card.answer);
+}
+
+static size_t nfc_test_trace_count_poller_frames(const NfcTrace* trace) {
+    size_t count = 0;
+    size_t position = 0;
+    NfcTraceRecord record = {};
+
+    while(nfc_trace_get_record(trace, &position, &record)) {
+        if(record.type == NfcTraceRecordTypePollerTx) count++;
+    }
+
+    return count;
+}
+
+// Replayed round trips cover the trace from the first poller frame to the last record
+static uint32_t nfc_test_trace_get_poller_span_us(const NfcTrace* trace) {
+    bool started = false;
+    uint32_t start_us = 0;
+    size_t position = 0;
+    NfcTraceRecord record = {};
+
+    while(nfc_trace_get_record(trace, &position, &record)) {
+        if(!started && (record.type == NfcTraceRecordTypePollerTx)) {
+            started = true;
+            start_us = record.timestamp_us;
+        }
+    }
+
+    return started ? record.timestamp_us - start_us : 0;
+}
+
+MU_TEST(nfc_trace_short_frame_test) {
+    NfcTrace* trace = nfc_trace_alloc(NFC_TEST_TRACE_SIZE);
+
+    for(size_t i = 0; i < 2; i++) {
+        mu_assert(
+            nfc_trace_add_short_frame(trace, NfcTraceRecordTypePollerTx, 0x26, 7),
+            "nfc_trace_add_short_frame() failed");
+    }
+
+    size_t position = 0;
+    NfcTraceRecord record = {};
+    for(size_t i = 0; i < 2; i++) {
+        mu_assert(nfc_trace_get_record(trace, &position, &record), "Record not found");
+        mu_assert(record.type == NfcTraceRecordTypePollerTx, "Wrong record type");
+        mu_assert(record.size_bits == 7, "Wrong frame size");
+        mu_assert(record.data[0] == 0x26, "Wrong frame data");
+        mu_assert(record.parity == NULL, "Unexpected parity");
+    }
+    mu_assert(!nfc_trace_get_record(trace, &position, &record), "Unexpected record");
+
+    nfc_trace_free(trace);
+}
+
+MU_TEST(nfc_trace_load_size_test) {
+    NfcTrace* trace = nfc_trace_alloc(NFC_TEST_TRACE_SIZE);
+    mu_assert(
+        nfc_trace_add_short_frame(trace, NfcTraceRecordTypePollerTx, 0x26, 7),
+        "nfc_trace_add_short_frame() failed");
+
+    Stream* stream = file_stream_alloc(nfc_test->storage);
+    mu_assert(
+        file_stream_open(stream, NFC_TEST_TRACE_PATH, FSAM_WRITE, FSOM_CREATE_ALWAYS),
+        "file_stream_open() failed");
+    mu_assert(nfc_trace_save(trace, stream), "nfc_trace_save() failed");
+    file_stream_close(stream);
+
+    // Record area size in the header claims more than the file holds
+    const uint32_t size = UINT32_MAX - 1;
+    mu_assert(
+        file_stream_open(stream, NFC_TEST_TRACE_PATH, FSAM_READ_WRITE, FSOM_OPEN_EXISTING),
+        "file_stream_open() failed");
+    mu_assert(
+        stream_seek(stream, NFC_TEST_TRACE_HEADER_SIZE_OFFSET, StreamOffsetFromStart),
+        "stream_seek() failed");
+    mu_assert(
+        stream_write(stream, (const uint8_t*)&size, sizeof(size)) == sizeof(size),
+        "stream_write() failed");
+    mu_assert(stream_rewind(stream), "stream_rewind() failed");
+    mu_assert(!nfc_trace_load(trace, stream), "Oversized trace loaded");
+    file_stream_close(stream);
+    stream_free(stream);
+    storage_simply_remove(nfc_test->storage, NFC_TEST_TRACE_PATH);
+
+    mu_assert(nfc_trace_get_record_count(trace) == 1, "Trace changed by failed load");
+
+    nfc_trace_free(trace);
+}
+
+MU_TEST(nfc_trace_replay_test) {
+    Nfc* poller = nfc_alloc();
+    Nfc* listener = nfc_alloc();
+
+    NfcDevice* nfc_device = nfc_device_alloc();
+    nfc_data_generator_fill_data(NfcDataGeneratorTypeNTAG215, nfc_device);
+    NfcListener* mfu_listener = nfc_listener_alloc(
+        listener,
+        NfcProtocolMfUltralight,
+        nfc_device_get_data(nfc_device, NfcProtocolMfUltralight));
+    nfc_listener_start(mfu_listener, NULL, NULL);
+
+    // Record
+    NfcTrace* trace = nfc_trace_alloc(NFC_TEST_TRACE_SIZE);
+    MfUltralightData* mfu_data_ref = mf_ultralight_alloc();
+    nfc_set_trace(poller, trace);
+    MfUltralightError error = mf_ultralight_poller_sync_read_card(poller, mfu_data_ref);
+    nfc_set_trace(poller, NULL);
+    mu_assert(error == MfUltralightErrorNone, "mf_ultralight_poller_sync_read_card() failed");
+
+    nfc_listener_stop(mfu_listener);
+    nfc_listener_free(mfu_listener);
+
+    mu_assert(nfc_trace_get_dropped_count(trace) == 0, "Trace is too small");
+    size_t poller_frames = nfc_test_trace_count_poller_frames(trace);
+    mu_assert(poller_frames > 0, "No poller frames recorded");
+
+    // Save and load
+    NfcTrace* trace_loaded = nfc_trace_alloc(1);
+    Stream* stream = file_stream_alloc(nfc_test->storage);
+    mu_assert(
+        file_stream_open(stream, NFC_TEST_TRACE_PATH, FSAM_WRITE, FSOM_CREATE_ALWAYS),
+        "file_stream_open() failed");
+    mu_assert(nfc_trace_save(trace, stream), "nfc_trace_save() failed");
+    file_stream_close(stream);
+    mu_assert(
+        file_stream_open(stream, NFC_TEST_TRACE_PATH, FSAM_READ, FSOM_OPEN_EXISTING),
+        "file_stream_open() failed");
+    mu_assert(nfc_trace_load(trace_loaded, stream), "nfc_trace_load() failed");
+    file_stream_close(stream);
+    stream_free(stream);
+    storage_simply_remove(nfc_test->storage, NFC_TEST_TRACE_PATH);
+
+    mu_assert(
+        nfc_trace_get_record_count(trace_loaded) == nfc_trace_get_record_count(trace),
+        "Record count not matches");
+    mu_assert(nfc_test_trace_count_poller_frames(trace_loaded) == poller_frames, "Records lost");
+
+    // Replay without listener
+    NfcTransportReplayStats stats = {};
+    MfUltralightData* mfu_data = mf_ultralight_alloc();
+    nfc_transport_replay_start(trace_loaded);
+    error = mf_ultralight_poller_sync_read_card(poller, mfu_data);
+    nfc_transport_replay_stop(&stats);
+    mu_assert(error == MfUltralightErrorNone, "Replayed read failed");
+
+    for(size_t i = 0; i < stats.state_num; i++) {
+        FURI_LOG_I(
+            TAG,
+            "Command %02X: %" PRIu32 " round trips, recorded %" PRIu32 " us, replayed %" PRIu32
+            " us",
+            stats.state[i].command,
+            stats.state[i].round_trips,
+            stats.state[i].recorded_us,
+            stats.state[i].replay_us);
+    }
+
+    mu_assert(mf_ultralight_is_equal(mfu_data, mfu_data_ref), "Data not matches");
+    mu_assert(stats.round_trips == poller_frames, "Round trip count not matches");
+    mu_assert(stats.mismatches == 0, "Poller frames differ from trace");
+    mu_assert(stats.overruns == 0, "Poller sent more frames than recorded");
+
+    uint32_t recorded_us = 0;
+    for(size_t i = 0; i < stats.state_num; i++) {
+        recorded_us += stats.state[i].recorded_us;
+    }
+    mu_assert(
+        recorded_us == nfc_test_trace_get_poller_span_us(trace_loaded), "Round trip time lost");
+
+    mf_ultralight_free(mfu_data);
+    mf_ultralight_free(mfu_data_ref);
+    nfc_trace_free(trace_loaded);
+    nfc_trace_free(trace);
+    nfc_device_free(nfc_device);
+    nfc_free(listener);
+    nfc_free(poller);
+}
+
+#define ISO15693_TEST_FRAME_SIZE_MAX (64U)
+#define ISO15693_TEST_1_OUT_OF_256_SYMBOL_SIZE (64U)
+#define ISO15693_TEST_SAMPLES_SIZE_MAX \
+    (ISO15693_TEST_FRAME_SIZE_MAX * ISO15693_TEST_1_OUT_OF_256_SYMBOL_SIZE + 2)
+#define ISO15693_TEST_SAMPLE_RATE (64000000U / 603U)
+
+// Inventory request 26 01 00 F6 0A in 1 out of 4 coding, as sampled by signal reader
+static const uint8_t iso15693_test_inventory_samples[] = {
+    0x21, 0x20, 0x08, 0x20, 0x02, 0x08, 0x02, 0x02, 0x02, 0x02, 0x02,
+    0x02, 0x02, 0x20, 0x08, 0x80, 0x80, 0x20, 0x20, 0x02, 0x02, 0x04,
+};
+
+static const uint8_t iso15693_test_inventory[] = {0x26, 0x01, 0x00, 0xF6, 0x0A};
+
+static size_t
+    iso15693_test_encode_1_out_of_4(const uint8_t* data, size_t data_size, uint8_t* samples) {
+    size_t size = 0;
+
+    samples[size++] = 0x21;
+    for(size_t i = 0; i < data_size; i++) {
+        for(size_t j = 0; j < 4; j++) {
+            const uint8_t slot = (data[i] >> (j * 2)) & 0x03;
+            samples[size++] = 1 << (slot * 2 + 1);
+        }
+    }
+    samples[size++] = 0x04;
+
+    return size;
+}
+
+static size_t
+    iso15693_test_encode_1_out_of_256(const uint8_t* data, size_t data_size, uint8_t* samples) {
+    size_t size = 0;
+
+    samples[size++] = 0x81;
+    for(size_t i = 0; i < data_size; i++) {
+        memset(&samples[size], 0, ISO15693_TEST_1_OUT_OF_256_SYMBOL_SIZE);
+        samples[size + data[i] / 4] = 1 << ((data[i] % 4) * 2 + 1);
+        size += ISO15693_TEST_1_OUT_OF_256_SYMBOL_SIZE;
+    }
+    samples[size++] = 0x04;
+
+    return size;
+}
+
+static Iso15693DecoderStatus iso15693_test_feed(
+    Iso15693Decoder* decoder,
+    const uint8_t* samples,
+    size_t size,
+    size_t chunk_size) {
+    Iso15693DecoderStatus status = Iso15693DecoderStatusWait;
+
+    for(size_t i = 0; (i < size) && (status == Iso15693DecoderStatusWait); i += chunk_size) {
+        status = iso15693_decoder_feed(decoder, &samples[i], MIN(chunk_size, size - i));
+    }
+
+    return status;
+}
+
+static bool iso15693_test_frame_is_equal(
+    const Iso15693Decoder* decoder,
+    const uint8_t* data,
+    size_t data_size) {
+    const BitBuffer* frame = iso15693_decoder_get_frame(decoder);
+
+    return (bit_buffer_get_size_bytes(frame) == data_size) &&
+           (memcmp(bit_buffer_get_data(frame), data, data_size) == 0);
+}
+
+MU_TEST(iso15693_decoder_test) {
+    Iso15693Decoder* decoder = iso15693_decoder_alloc(ISO15693_TEST_FRAME_SIZE_MAX);
+    uint8_t* samples = malloc(ISO15693_TEST_SAMPLES_SIZE_MAX);
+    Iso15693DecoderStats stats = {};
+
+    // Whole frame, signal reader half-buffers and odd pieces
+    const size_t chunk_sizes[] = {sizeof(iso15693_test_inventory_samples), 1, 3, 7};
+    for(size_t i = 0; i < COUNT_OF(chunk_sizes); i++) {
+        iso15693_decoder_reset(decoder);
+        Iso15693DecoderStatus status = iso15693_test_feed(
+            decoder,
+            iso15693_test_inventory_samples,
+            sizeof(iso15693_test_inventory_samples),
+            chunk_sizes[i]);
+        mu_assert(status == Iso15693DecoderStatusFrame, "1 out of 4 frame not decoded");
+        mu_assert(
+            iso15693_test_frame_is_equal(
+                decoder, iso15693_test_inventory, sizeof(iso15693_test_inventory)),
+            "1 out of 4 frame data not matches");
+    }
+
+    size_t size = iso15693_test_encode_1_out_of_256(
+        iso15693_test_inventory, sizeof(iso15693_test_inventory), samples);
+    for(size_t i = 0; i < COUNT_OF(chunk_sizes); i++) {
+        iso15693_decoder_reset(decoder);
+        const size_t chunk_size = (i == 0) ? size : chunk_sizes[i];
+        Iso15693DecoderStatus status = iso15693_test_feed(decoder, samples, size, chunk_size);
+        mu_assert(status == Iso15693DecoderStatusFrame, "1 out of 256 frame not decoded");
+        mu_assert(
+            iso15693_test_frame_is_equal(
+                decoder, iso15693_test_inventory, sizeof(iso15693_test_inventory)),
+            "1 out of 256 frame data not matches");
+    }
+
+    // Samples after EOF are not processed
+    iso15693_decoder_get_stats(decoder, &stats);
+    const uint32_t samples_processed = stats.samples;
+    mu_assert(
+        iso15693_decoder_feed(decoder, iso15693_test_inventory_samples, 4) ==
+            Iso15693DecoderStatusFrame,
+        "Frame lost after EOF");
+    iso15693_decoder_get_stats(decoder, &stats);
+    mu_assert(stats.samples == samples_processed, "Samples after EOF processed");
+    mu_assert(stats.frames == COUNT_OF(chunk_sizes) * 2, "Wrong frame count");
+    mu_assert(
+        stats.bytes == COUNT_OF(chunk_sizes) * 2 * sizeof(iso15693_test_inventory),
+        "Wrong byte count");
+
+    // EOF without data
+    const uint8_t eof_single = 0x01;
+    iso15693_decoder_reset(decoder);
+    mu_assert(
+        iso15693_decoder_feed(decoder, &eof_single, 1) == Iso15693DecoderStatusFrame,
+        "EOF only frame not decoded");
+    mu_assert(
+        bit_buffer_get_size_bytes(iso15693_decoder_get_frame(decoder)) == 0,
+        "EOF only frame is not empty");
+
+    iso15693_decoder_reset_stats(decoder);
+
+    const uint8_t invalid_sof = 0x55;
+    iso15693_decoder_reset(decoder);
+    mu_assert(
+        iso15693_decoder_feed(decoder, &invalid_sof, 1) == Iso15693DecoderStatusFail,
+        "Invalid SOF accepted");
+
+    // Pulse outside of slot, decoder stays failed until reset
+    memcpy(samples, iso15693_test_inventory_samples, sizeof(iso15693_test_inventory_samples));
+    samples[5] = 0x03;
+    iso15693_decoder_reset(decoder);
+    mu_assert(
+        iso15693_test_feed(decoder, samples, sizeof(iso15693_test_inventory_samples), 1) ==
+            Iso15693DecoderStatusFail,
+        "Invalid pulse accepted");
+    mu_assert(
+        iso15693_decoder_feed(decoder, iso15693_test_inventory_samples, 1) ==
+            Iso15693DecoderStatusFail,
+        "Failed decoder restarted without reset");
+
+    // EOF in the middle of byte
+    memcpy(samples, iso15693_test_inventory_samples, sizeof(iso15693_test_inventory_samples));
+    samples[2] = 0x04;
+    iso15693_decoder_reset(decoder);
+    mu_assert(
+        iso15693_test_feed(decoder, samples, sizeof(iso15693_test_inventory_samples), 1) ==
+            Iso15693DecoderStatusFail,
+        "Incomplete byte accepted");
+
+    // 1 out of 256 symbol without pulse and with two pulses
+    size = iso15693_test_encode_1_out_of_256(
+        iso15693_test_inventory, sizeof(iso15693_test_inventory), samples);
+    samples[1 + iso15693_test_inventory[0] / 4] = 0;
+    iso15693_decoder_reset(decoder);
+    mu_assert(
+        iso15693_test_feed(decoder, samples, size, 1) == Iso15693DecoderStatusFail,
+        "Symbol without pulse accepted");
+
+    size = iso15693_test_encode_1_out_of_256(
+        iso15693_test_inventory, sizeof(iso15693_test_inventory), samples);
+    samples[1 + ISO15693_TEST_1_OUT_OF_256_SYMBOL_SIZE - 1] = 0x80;
+    iso15693_decoder_reset(decoder);
+    mu_assert(
+        iso15693_test_feed(decoder, samples, size, size) == Iso15693DecoderStatusFail,
+        "Symbol with two pulses accepted");
+
+    iso15693_decoder_get_stats(decoder, &stats);
+    mu_assert(stats.frames == 0, "Wrong frame count");
+    mu_assert(stats.sof_errors == 1, "Wrong SOF error count");
+    mu_assert(stats.symbol_errors == 4, "Wrong symbol error count");
+    mu_assert(stats.overflows == 0, "Wrong overflow count");
+    iso15693_decoder_free(decoder);
+
+    // Frame longer than decoder buffer
+    decoder = iso15693_decoder_alloc(sizeof(iso15693_test_inventory) - 1);
+    mu_assert(
+        iso15693_decoder_feed(
+            decoder,
+            iso15693_test_inventory_samples,
+            sizeof(iso15693_test_inventory_samples)) == Iso15693DecoderStatusFail,
+        "Frame overflow not detected");
+    iso15693_decoder_get_stats(decoder, &stats);
+    mu_assert(stats.overflows == 1, "Wrong overflow count");
+
+    free(samples);
+    iso15693_decoder_free(decoder);
+}
+
+static uint32_t iso15693_test_decode_rate(
+    Iso15693Decoder* decoder,
+    const uint8_t* samples,
+    size_t size,
+    size_t iterations) {
+    bool decoded = true;
+    const uint32_t start = furi_get_tick();
+    for(size_t i = 0; i < iterations; i++) {
+        iso15693_decoder_reset(decoder);
+        // One call per signal reader half-buffer, as on device
+        decoded &= (iso15693_test_feed(decoder, samples, size, 1) == Iso15693DecoderStatusFrame);
+    }
+    const uint32_t time_ms = MAX(furi_get_tick() - start, 1UL);
+
+    return decoded ? (uint64_t)size * 8 * iterations * 1000 / time_ms : 0;
+}
+
+MU_TEST(iso15693_decoder_benchmark) {
+    Iso15693Decoder* decoder = iso15693_decoder_alloc(ISO15693_TEST_FRAME_SIZE_MAX);
+    uint8_t* samples = malloc(ISO15693_TEST_SAMPLES_SIZE_MAX);
+    uint8_t data[ISO15693_TEST_FRAME_SIZE_MAX];
+
+    for(size_t i = 0; i < sizeof(data); i++) {
+        data[i] = i * 37;
+    }
+
+    size_t size = iso15693_test_encode_1_out_of_4(data, sizeof(data), samples);
+    const uint32_t rate_1_out_of_4 = iso15693_test_decode_rate(decoder, samples, size, 500);
+    mu_assert(iso15693_test_frame_is_equal(decoder, data, sizeof(data)), "Data not matches");
+
+    size = iso15693_test_encode_1_out_of_256(data, sizeof(data), samples);
+    const uint32_t rate_1_out_of_256 = iso15693_test_decode_rate(decoder, samples, size, 50);
+    mu_assert(iso15693_test_frame_is_equal(decoder, data, sizeof(data)), "Data not matches");
+
+    FURI_LOG_I(
+        TAG,
+        "ISO15693 decoder: 1 out of 4 %" PRIu32 " samples/s, 1 out of 256 %" PRIu32
+        " samples/s, signal %u",
+        rate_1_out_of_4,
+        rate_1_out_of_256,
+        ISO15693_TEST_SAMPLE_RATE);
+
+    // Decoder runs in signal reader interrupt, it must take a small share of CPU time
+    mu_assert(rate_1_out_of_4 >= ISO15693_TEST_SAMPLE_RATE * 10, "1 out of 4 decoding too slow");
+    mu_assert(
+        rate_1_out_of_256 >= ISO15693_TEST_SAMPLE_RATE * 10, "1 out of 256 decoding too slow");
+
+    free(samples);
+    iso15693_decoder_free(decoder);
+}
+
 MU_TEST_SUITE(nfc) {
     nfc_test_alloc();
 
@@ -538,12 +2387,33 @@ MU_TEST_SUITE(nfc) {
     MU_RUN_TEST(mf_classic_1k_7b_file_test);
     MU_RUN_TEST(mf_classic_4k_4b_file_test);
     MU_RUN_TEST(mf_classic_4k_7b_file_test);
+    MU_RUN_TEST(nfc_dump_conversion_test);
+    MU_RUN_TEST(nfc_dump_round_trip_test);
+    MU_RUN_TEST(nfc_dump_malformed_test);
     MU_RUN_TEST(mf_classic_reader);
 
     MU_RUN_TEST(mf_classic_write);
     MU_RUN_TEST(mf_classic_value_block);
 
     MU_RUN_TEST(mf_classic_dict_test);
+    MU_RUN_TEST(mf_classic_key_scheduler_test);
+    MU_RUN_TEST(mf_classic_key_scheduler_eviction_test);
+
+    MU_RUN_TEST(iso14443_4a_chaining_test);
+    MU_RUN_TEST(iso14443_4a_wtx_test);
+    MU_RUN_TEST(iso14443_4a_corrupted_response_test);
+    MU_RUN_TEST(iso14443_4a_lost_command_test);
+    MU_RUN_TEST(iso14443_4a_pps_test);
+    MU_RUN_TEST(iso14443_4a_pps_not_supported_test);
+    MU_RUN_TEST(mf_desfire_read_plan_test);
+    MU_RUN_TEST(mf_desfire_empty_frame_test);
+
+    MU_RUN_TEST(nfc_trace_short_frame_test);
+    MU_RUN_TEST(nfc_trace_load_size_test);
+    MU_RUN_TEST(nfc_trace_replay_test);
+
+    MU_RUN_TEST(iso15693_decoder_test);
+    MU_RUN_TEST(iso15693_decoder_benchmark);
 
     nfc_test_free();
 }
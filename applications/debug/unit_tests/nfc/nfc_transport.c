@@ -5,6 +5,10 @@
 #include <lib/nfc/protocols/iso14443_3a/iso14443_3a.h>
 
 #include <furi/furi.h>
+#include <furi_hal.h>
+#include <toolbox/profiler.h>
+
+#include "nfc_transport.h"
 
 #define NFC_MAX_BUFFER_SIZE (256)
 
@@ -15,6 +19,27 @@ typedef enum {
 
 FuriMessageQueue* poller_queue = NULL;
 FuriMessageQueue* listener_queue = NULL;
+static volatile uint32_t poller_frame_count = 0;
+static volatile uint32_t poller_byte_count = 0;
+static volatile uint32_t poller_mf_classic_auth_count = 0;
+static NfcIso14443aBitRate poller_bit_rate_tx = NfcIso14443aBitRate106Kbit;
+static NfcIso14443aBitRate poller_bit_rate_rx = NfcIso14443aBitRate106Kbit;
+static NfcIso14443aBitRate poller_bit_rate_max = NfcIso14443aBitRate848Kbit;
+
+typedef struct {
+    const NfcTrace* trace;
+    size_t position;
+    NfcTraceRecord record;
+    BitBuffer* frame;
+    NfcTransportReplayStats stats;
+
+    // Round trip in progress, closed by the next poller frame
+    NfcTransportReplayState* state;
+    uint32_t state_recorded_us;
+    uint32_t state_cycles;
+} NfcTransportReplay;
+
+static NfcTransportReplay* replay = NULL;
 
 typedef enum {
     NfcMessageTypeTx,
@@ -60,6 +85,8 @@ struct Nfc {
     void* context;
 
     NfcMode mode;
+    ProfilerProbeStart rx_probe;
+    NfcTrace* trace;
 
     FuriThread* worker_thread;
 };
@@ -159,6 +186,13 @@ void nfc_set_guard_time_us(Nfc* instance, uint32_t guard_time_us) {
     UNUSED(guard_time_us);
 }
 
+void nfc_set_trace(Nfc* instance, NfcTrace* trace) {
+    furi_check(instance);
+    furi_check(instance->worker_thread == NULL);
+
+    instance->trace = trace;
+}
+
 NfcError nfc_iso14443a_listener_set_col_res_data(
     Nfc* instance,
     uint8_t* uid,
@@ -238,6 +272,9 @@ static void nfc_worker_listener_pass_col_res(Nfc* instance, uint8_t* rx_data, ui
             iso14443_crc_append(Iso14443CrcTypeA, tx_buffer);
             nfc_listener_tx(instance, tx_buffer);
             instance->col_res_status = Iso14443_3aColResStatusDone;
+            if(instance->trace) {
+                nfc_trace_add_event(instance->trace, NfcTraceEventListenerActivated);
+            }
             NfcEvent event = {.type = NfcEventTypeListenerActivated};
             instance->callback(event, instance->context);
 
@@ -280,8 +317,15 @@ static int32_t nfc_worker_listener(void* context) {
                     instance, message.data.data, message.data.data_bits);
             } else {
                 instance->state = NfcStateReady;
+                instance->rx_probe = profiler_probe_begin();
+                if(instance->trace) {
+                    nfc_trace_add_frame(
+                        instance->trace, NfcTraceRecordTypeListenerRx, event_data.buffer, false);
+                }
                 nfc_event.type = NfcEventTypeRxEnd;
                 instance->callback(nfc_event, instance->context);
+                // Frames without response must not be accounted to the next one
+                instance->rx_probe = (ProfilerProbeStart){0};
             }
         }
     }
@@ -304,8 +348,8 @@ void nfc_start(Nfc* instance, NfcEventCallback callback, void* context) {
         furi_check(poller_queue == NULL);
     } else {
         furi_check(poller_queue == NULL);
-        // Check that poller is started after listener
-        furi_check(listener_queue);
+        // Check that poller is started after listener or replays a trace
+        furi_check(listener_queue || replay);
     }
 
     instance->callback = callback;
@@ -358,6 +402,164 @@ void nfc_stop(Nfc* instance) {
     }
 }
 
+void nfc_transport_reset_frame_count(void) {
+    poller_frame_count = 0;
+    poller_byte_count = 0;
+}
+
+uint32_t nfc_transport_get_frame_count(void) {
+    return poller_frame_count;
+}
+
+uint32_t nfc_transport_get_byte_count(void) {
+    return poller_byte_count;
+}
+
+void nfc_transport_reset_mf_classic_auth_count(void) {
+    poller_mf_classic_auth_count = 0;
+}
+
+uint32_t nfc_transport_get_mf_classic_auth_count(void) {
+    return poller_mf_classic_auth_count;
+}
+
+void nfc_transport_get_bit_rate(
+    NfcIso14443aBitRate* tx_bit_rate,
+    NfcIso14443aBitRate* rx_bit_rate) {
+    *tx_bit_rate = poller_bit_rate_tx;
+    *rx_bit_rate = poller_bit_rate_rx;
+}
+
+void nfc_transport_set_bit_rate_max(NfcIso14443aBitRate bit_rate) {
+    poller_bit_rate_max = bit_rate;
+}
+
+static NfcTransportReplayState* nfc_transport_replay_get_state(uint8_t command) {
+    NfcTransportReplayStats* stats = &replay->stats;
+
+    for(size_t i = 0; i < stats->state_num; i++) {
+        if(stats->state[i].command == command) return &stats->state[i];
+    }
+
+    furi_check(stats->state_num < NFC_TRANSPORT_REPLAY_STATE_NUM);
+    NfcTransportReplayState* state = &stats->state[stats->state_num++];
+    state->command = command;
+
+    return state;
+}
+
+static bool nfc_transport_replay_next_poller_record(void) {
+    while(nfc_trace_get_record(replay->trace, &replay->position, &replay->record)) {
+        if(replay->record.type == NfcTraceRecordTypePollerTx) return true;
+        if(replay->record.type == NfcTraceRecordTypePollerRx) return true;
+        if(replay->record.type != NfcTraceRecordTypeEvent) continue;
+        if(replay->record.event == NfcTraceEventPollerTimeout) return true;
+        if(replay->record.event == NfcTraceEventPollerError) return true;
+    }
+
+    return false;
+}
+
+static uint32_t nfc_transport_replay_get_cycles(void) {
+    // Start of a zero timeout timer is the current cycle counter value
+    return furi_hal_cortex_timer_get(0).start;
+}
+
+// Round trip ends with the next poller frame or with the trace
+static void nfc_transport_replay_close_state(uint32_t timestamp_us, uint32_t cycles) {
+    if(!replay->state) return;
+
+    replay->state->recorded_us += timestamp_us - replay->state_recorded_us;
+    replay->state->replay_us +=
+        (cycles - replay->state_cycles) / furi_hal_cortex_instructions_per_microsecond();
+    replay->state = NULL;
+}
+
+static NfcError nfc_transport_replay_trx(const BitBuffer* tx_buffer, BitBuffer* rx_buffer) {
+    NfcTransportReplayStats* stats = &replay->stats;
+    const uint32_t cycles = nfc_transport_replay_get_cycles();
+    NfcError error = NfcErrorTimeout;
+
+    do {
+        bool found = false;
+        while(nfc_transport_replay_next_poller_record()) {
+            found = (replay->record.type == NfcTraceRecordTypePollerTx);
+            if(found) break;
+        }
+        if(!found) {
+            // Record holds the last one of the trace
+            nfc_transport_replay_close_state(replay->record.timestamp_us, cycles);
+            stats->overruns++;
+            break;
+        }
+
+        // Previous round trip ends here: response plus poller processing until this frame
+        nfc_transport_replay_close_state(replay->record.timestamp_us, cycles);
+
+        nfc_trace_record_get_frame(&replay->record, replay->frame);
+        if((bit_buffer_get_size(replay->frame) != bit_buffer_get_size(tx_buffer)) ||
+           (memcmp(
+                bit_buffer_get_data(replay->frame),
+                bit_buffer_get_data(tx_buffer),
+                bit_buffer_get_size_bytes(tx_buffer)) != 0)) {
+            stats->mismatches++;
+        }
+
+        uint8_t command = bit_buffer_get_size(tx_buffer) ? bit_buffer_get_byte(tx_buffer, 0) : 0;
+        replay->state = nfc_transport_replay_get_state(command);
+        replay->state->round_trips++;
+        replay->state_recorded_us = replay->record.timestamp_us;
+        replay->state_cycles = cycles;
+        stats->round_trips++;
+
+        // Frame without recorded response is answered with timeout and stays for the next trx
+        size_t position = replay->position;
+        NfcTraceRecord record = replay->record;
+        if(!nfc_transport_replay_next_poller_record()) break;
+        if(replay->record.type == NfcTraceRecordTypePollerTx) {
+            replay->position = position;
+            replay->record = record;
+            break;
+        }
+
+        if(replay->record.type == NfcTraceRecordTypePollerRx) {
+            nfc_trace_record_get_frame(&replay->record, rx_buffer);
+            error = NfcErrorNone;
+        } else if(replay->record.event == NfcTraceEventPollerError) {
+            error = NfcErrorDataFormat;
+        }
+    } while(false);
+
+    return error;
+}
+
+void nfc_transport_replay_start(const NfcTrace* trace) {
+    furi_check(trace);
+    furi_check(replay == NULL);
+    furi_check(poller_queue == NULL);
+
+    replay = malloc(sizeof(NfcTransportReplay));
+    replay->trace = trace;
+    replay->frame = bit_buffer_alloc(NFC_MAX_BUFFER_SIZE);
+}
+
+void nfc_transport_replay_stop(NfcTransportReplayStats* stats) {
+    furi_check(replay);
+    furi_check(stats);
+
+    // Last round trip lasts until the end of the trace
+    const uint32_t cycles = nfc_transport_replay_get_cycles();
+    while(nfc_trace_get_record(replay->trace, &replay->position, &replay->record)) {
+    }
+    nfc_transport_replay_close_state(replay->record.timestamp_us, cycles);
+
+    *stats = replay->stats;
+
+    bit_buffer_free(replay->frame);
+    free(replay);
+    replay = NULL;
+}
+
 // Called from worker thread
 
 NfcError nfc_listener_tx(Nfc* instance, const BitBuffer* tx_buffer) {
@@ -366,6 +568,13 @@ NfcError nfc_listener_tx(Nfc* instance, const BitBuffer* tx_buffer) {
     furi_check(listener_queue);
     furi_check(tx_buffer);
 
+    // Same as on target: response latency excludes the transfer itself
+    profiler_probe_end(ProfilerProbeNfcListenerResponse, instance->rx_probe);
+    instance->rx_probe = (ProfilerProbeStart){0};
+    if(instance->trace) {
+        nfc_trace_add_frame(instance->trace, NfcTraceRecordTypeListenerTx, tx_buffer, false);
+    }
+
     NfcMessage message = {};
     message.type = NfcMessageTypeTx;
     message.data.data_bits = bit_buffer_get_size(tx_buffer);
@@ -380,17 +589,10 @@ NfcError nfc_iso14443a_listener_tx_custom_parity(Nfc* instance, const BitBuffer*
     return nfc_listener_tx(instance, tx_buffer);
 }
 
-NfcError
-    nfc_poller_trx(Nfc* instance, const BitBuffer* tx_buffer, BitBuffer* rx_buffer, uint32_t fwt) {
-    furi_check(instance);
-    furi_check(tx_buffer);
-    furi_check(rx_buffer);
-    furi_check(poller_queue);
+static NfcError nfc_transport_trx(const BitBuffer* tx_buffer, BitBuffer* rx_buffer) {
     furi_check(listener_queue);
-    UNUSED(fwt);
 
     NfcError error = NfcErrorNone;
-
     NfcMessage message = {};
     message.type = NfcMessageTypeTx;
     message.data.data_bits = bit_buffer_get_size(tx_buffer);
@@ -413,11 +615,53 @@ NfcError
     return error;
 }
 
+NfcError
+    nfc_poller_trx(Nfc* instance, const BitBuffer* tx_buffer, BitBuffer* rx_buffer, uint32_t fwt) {
+    furi_check(instance);
+    furi_check(tx_buffer);
+    furi_check(rx_buffer);
+    furi_check(poller_queue);
+    UNUSED(fwt);
+
+    NfcError error = NfcErrorNone;
+    poller_frame_count++;
+
+    if(instance->trace) {
+        nfc_trace_add_frame(instance->trace, NfcTraceRecordTypePollerTx, tx_buffer, false);
+    }
+
+    if(replay) {
+        error = nfc_transport_replay_trx(tx_buffer, rx_buffer);
+    } else {
+        error = nfc_transport_trx(tx_buffer, rx_buffer);
+    }
+
+    poller_byte_count += bit_buffer_get_size_bytes(tx_buffer);
+    if(error == NfcErrorNone) {
+        poller_byte_count += bit_buffer_get_size_bytes(rx_buffer);
+    }
+
+    if(instance->trace) {
+        if(error == NfcErrorNone) {
+            nfc_trace_add_frame(instance->trace, NfcTraceRecordTypePollerRx, rx_buffer, false);
+        } else {
+            nfc_trace_add_event(instance->trace, NfcTraceEventPollerTimeout);
+        }
+    }
+
+    return error;
+}
+
 NfcError nfc_iso14443a_poller_trx_custom_parity(
     Nfc* instance,
     const BitBuffer* tx_buffer,
     BitBuffer* rx_buffer,
     uint32_t fwt) {
+    // Encrypted reader nonce and answer
+    if(bit_buffer_get_size_bytes(tx_buffer) == 8) {
+        poller_mf_classic_auth_count++;
+    }
+
     return nfc_poller_trx(instance, tx_buffer, rx_buffer, fwt);
 }
 
@@ -449,6 +693,29 @@ NfcError nfc_iso14443a_poller_trx_sdd_frame(
     return nfc_poller_trx(instance, tx_buffer, rx_buffer, fwt);
 }
 
+bool nfc_iso14443a_poller_is_bit_rate_supported(
+    Nfc* instance,
+    NfcIso14443aBitRate tx_bit_rate,
+    NfcIso14443aBitRate rx_bit_rate) {
+    furi_check(instance);
+
+    return (tx_bit_rate <= poller_bit_rate_max) && (rx_bit_rate <= poller_bit_rate_max);
+}
+
+NfcError nfc_iso14443a_poller_set_bit_rate(
+    Nfc* instance,
+    NfcIso14443aBitRate tx_bit_rate,
+    NfcIso14443aBitRate rx_bit_rate) {
+    furi_check(instance);
+    furi_check(nfc_iso14443a_poller_is_bit_rate_supported(instance, tx_bit_rate, rx_bit_rate));
+
+    // Message queues have no bit rate, remember it for the checks
+    poller_bit_rate_tx = tx_bit_rate;
+    poller_bit_rate_rx = rx_bit_rate;
+
+    return NfcErrorNone;
+}
+
 NfcError nfc_iso15693_listener_tx_sof(Nfc* instance) {
     UNUSED(instance);
 
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <lib/nfc/nfc.h>
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define NFC_TRANSPORT_REPLAY_STATE_NUM (16U)
+
+/** Poller round trips of one poller state, identified by the command byte it sends */
+typedef struct {
+    uint8_t command; /**< first byte of poller frames */
+    uint32_t round_trips; /**< number of round trips */
+    uint32_t recorded_us; /**< time from poller frame to the next one in the trace */
+    uint32_t replay_us; /**< same time measured during replay */
+} NfcTransportReplayState;
+
+typedef struct {
+    uint32_t round_trips; /**< poller frames answered from the trace */
+    uint32_t mismatches; /**< poller frames that differ from the recorded ones */
+    uint32_t overruns; /**< poller frames sent after the end of the trace */
+    size_t state_num;
+    NfcTransportReplayState state[NFC_TRANSPORT_REPLAY_STATE_NUM];
+} NfcTransportReplayStats;
+
+/** Reset poller frame and byte counters of test transport */
+void nfc_transport_reset_frame_count(void);
+
+/** Get number of frames exchanged by poller since last reset
+ *
+ * @return     frame count
+ */
+uint32_t nfc_transport_get_frame_count(void);
+
+/** Get number of bytes sent and received by poller since last reset
+ *
+ * @return     byte count
+ */
+uint32_t nfc_transport_get_byte_count(void);
+
+/** Reset MfClassic authentication counter of test transport */
+void nfc_transport_reset_mf_classic_auth_count(void);
+
+/** Get number of MfClassic authentications attempted by poller since last reset
+ *
+ * Counts encrypted reader nonces, the only 8 byte frames sent with custom parity.
+ *
+ * @return     authentication count
+ */
+uint32_t nfc_transport_get_mf_classic_auth_count(void);
+
+/** Get bit rates last set by poller
+ *
+ * @param[out] tx_bit_rate  poller to card bit rate
+ * @param[out] rx_bit_rate  card to poller bit rate
+ */
+void nfc_transport_get_bit_rate(
+    NfcIso14443aBitRate* tx_bit_rate,
+    NfcIso14443aBitRate* rx_bit_rate);
+
+/** Set highest bit rate supported by poller, 848 kbps by default
+ *
+ * @param      bit_rate  highest bit rate in both directions
+ */
+void nfc_transport_set_bit_rate_max(NfcIso14443aBitRate bit_rate);
+
+/** Answer poller frames with responses recorded in trace instead of listener
+ *
+ * Must be called before the poller is started, no listener is needed. Every
+ * poller frame consumes the next recorded poller frame and its response or
+ * timeout.
+ *
+ * @param      trace  The trace recorded with nfc_set_trace on poller side
+ */
+void nfc_transport_replay_start(const NfcTrace* trace);
+
+/** Stop replay and get its statistics
+ *
+ * @param[out] stats  The statistics
+ */
+void nfc_transport_replay_stop(NfcTransportReplayStats* stats);
+
+#ifdef __cplusplus
+}
+#endif
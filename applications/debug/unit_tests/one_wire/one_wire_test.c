@@ -0,0 +1,133 @@
+#include <furi.h>
+#include <one_wire/maxim_crc.h>
+#include <one_wire/one_wire_host.h>
+
+#include "../minunit.h"
+
+#define TEST_BUS_CALLS_MAX 8
+
+typedef struct {
+    bool overdrive;
+    bool is_reset;
+    size_t bit_count; /**< For touch */
+    uint8_t tx[4]; /**< First bytes written by touch */
+} TestBusCall;
+
+/* Records bus calls, answers reset at speeds it supports, reads 0xA5 */
+typedef struct {
+    bool presence;
+    bool presence_overdrive;
+    TestBusCall calls[TEST_BUS_CALLS_MAX];
+    size_t call_count;
+} TestBus;
+
+static void test_bus_start(void* context) {
+    UNUSED(context);
+}
+
+static void test_bus_stop(void* context) {
+    UNUSED(context);
+}
+
+static bool test_bus_reset(void* context, bool overdrive) {
+    TestBus* bus = context;
+    furi_check(bus->call_count < TEST_BUS_CALLS_MAX);
+    bus->calls[bus->call_count++] = (TestBusCall){.overdrive = overdrive, .is_reset = true};
+    return overdrive ? bus->presence_overdrive : bus->presence;
+}
+
+static void test_bus_touch(
+    void* context,
+    bool overdrive,
+    const uint8_t* tx,
+    uint8_t* rx,
+    size_t bit_count) {
+    TestBus* bus = context;
+    furi_check(bus->call_count < TEST_BUS_CALLS_MAX);
+
+    TestBusCall* call = &bus->calls[bus->call_count++];
+    *call = (TestBusCall){.overdrive = overdrive, .bit_count = bit_count};
+    if(tx) memcpy(call->tx, tx, MIN(sizeof(call->tx), (bit_count + 7) / 8));
+    if(rx) memset(rx, 0xA5, (bit_count + 7) / 8);
+}
+
+static const OneWireHostBus test_bus = {
+    .start = test_bus_start,
+    .stop = test_bus_stop,
+    .reset = test_bus_reset,
+    .touch = test_bus_touch,
+};
+
+MU_TEST(test_maxim_crc) {
+    // ROM example of Maxim application note 27
+    const uint8_t rom[] = {0x02, 0x1C, 0xB8, 0x01, 0x00, 0x00, 0x00, 0xA2};
+    mu_assert_int_eq(0xA2, maxim_crc8(rom, sizeof(rom) - 1, MAXIM_CRC8_INIT));
+    mu_assert_int_eq(0x00, maxim_crc8(rom, sizeof(rom), MAXIM_CRC8_INIT));
+
+    const uint8_t check[] = "123456789";
+    mu_assert_int_eq(0xBB3D, maxim_crc16(check, sizeof(check) - 1, MAXIM_CRC16_INIT));
+    mu_assert_int_eq(
+        0xBB3D, maxim_crc16(&check[4], 5, maxim_crc16(check, 4, MAXIM_CRC16_INIT)));
+    mu_assert_int_eq(MAXIM_CRC16_INIT, maxim_crc16(check, 0, MAXIM_CRC16_INIT));
+}
+
+MU_TEST(test_one_wire_host_transfer) {
+    TestBus bus = {.presence = true};
+    OneWireHost* host = onewire_host_alloc_ex(&test_bus, &bus);
+
+    const uint8_t tx[] = {0xCC, 0xF0, 0x00, 0x00};
+    uint8_t rx[16] = {0};
+    mu_check(onewire_host_transfer(host, tx, sizeof(tx), rx, sizeof(rx)));
+
+    // reset, command with parameters and the answer in one call each
+    mu_assert_int_eq(3, bus.call_count);
+    mu_check(bus.calls[0].is_reset);
+    mu_assert_int_eq(sizeof(tx) * 8, bus.calls[1].bit_count);
+    mu_assert_mem_eq(tx, bus.calls[1].tx, sizeof(tx));
+    mu_assert_int_eq(sizeof(rx) * 8, bus.calls[2].bit_count);
+    mu_assert_int_eq(0xA5, rx[0]);
+    mu_assert_int_eq(0xA5, rx[sizeof(rx) - 1]);
+
+    bus.presence = false;
+    bus.call_count = 0;
+    mu_check(!onewire_host_transfer(host, tx, sizeof(tx), rx, sizeof(rx)));
+    mu_assert_int_eq(1, bus.call_count);
+
+    onewire_host_free(host);
+}
+
+MU_TEST(test_one_wire_host_overdrive) {
+    TestBus bus = {.presence = true, .presence_overdrive = true};
+    OneWireHost* host = onewire_host_alloc_ex(&test_bus, &bus);
+
+    mu_check(onewire_host_overdrive_skip_rom(host));
+    onewire_host_read(host);
+    mu_assert_int_eq(5, bus.call_count);
+    mu_check(!bus.calls[0].overdrive);
+    mu_assert_int_eq(0x3C, bus.calls[1].tx[0]);
+    mu_check(bus.calls[2].is_reset && bus.calls[2].overdrive);
+    mu_assert_int_eq(0xCC, bus.calls[3].tx[0]);
+    mu_check(bus.calls[3].overdrive && bus.calls[4].overdrive);
+
+    // device without overdrive: host falls back to standard speed
+    bus.presence_overdrive = false;
+    bus.call_count = 0;
+    mu_check(!onewire_host_overdrive_skip_rom(host));
+    mu_check(onewire_host_reset(host));
+    mu_assert_int_eq(4, bus.call_count);
+    mu_check(bus.calls[2].is_reset && bus.calls[2].overdrive);
+    mu_check(bus.calls[3].is_reset && !bus.calls[3].overdrive);
+
+    onewire_host_free(host);
+}
+
+MU_TEST_SUITE(test_one_wire_suite) {
+    MU_RUN_TEST(test_maxim_crc);
+    MU_RUN_TEST(test_one_wire_host_transfer);
+    MU_RUN_TEST(test_one_wire_host_overdrive);
+}
+
+int run_minunit_test_one_wire() {
+    MU_RUN_SUITE(test_one_wire_suite);
+    return MU_EXIT_CODE;
+}
@@ -0,0 +1,65 @@
+#include <furi.h>
+#include <toolbox/profiler.h>
+
+#include "../minunit.h"
+
+#define PROFILER_TEST_PROBE ProfilerProbeGuiRedraw
+#define PROFILER_TEST_SAMPLES (8U)
+#define PROFILER_TEST_DELAY_US (100U)
+
+static uint32_t profiler_test_histogram_sum(const ProfilerProbeStats* stats) {
+    uint32_t sum = 0;
+    for(size_t i = 0; i < PROFILER_PROBE_HISTOGRAM_SIZE; i++) {
+        sum += stats->histogram[i];
+    }
+    return sum;
+}
+
+MU_TEST(profiler_probe_disabled_test) {
+    ProfilerProbeStats stats;
+    profiler_probe_enable(false);
+    profiler_probe_reset();
+
+    ProfilerProbeStart probe = profiler_probe_begin();
+    mu_check(!probe.valid);
+    profiler_probe_end(PROFILER_TEST_PROBE, probe);
+
+    profiler_probe_get_stats(PROFILER_TEST_PROBE, &stats);
+    mu_assert_int_eq(0, stats.count);
+}
+
+MU_TEST(profiler_probe_sample_test) {
+    ProfilerProbeStats stats;
+    const bool was_enabled = profiler_probe_is_enabled();
+    profiler_probe_enable(true);
+
+    for(size_t i = 0; i < PROFILER_TEST_SAMPLES; i++) {
+        ProfilerProbeStart probe = profiler_probe_begin();
+        mu_check(probe.valid);
+        furi_delay_us(PROFILER_TEST_DELAY_US);
+        profiler_probe_end(PROFILER_TEST_PROBE, probe);
+    }
+
+    profiler_probe_get_stats(PROFILER_TEST_PROBE, &stats);
+    profiler_probe_enable(was_enabled);
+
+    // Other threads may hit the same probe, so counts are lower bounds
+    const uint32_t ticks_per_us = profiler_probe_get_ticks_per_us();
+    mu_check(ticks_per_us > 0);
+    mu_check(stats.count >= PROFILER_TEST_SAMPLES);
+    mu_check(stats.min <= stats.max);
+    mu_check(stats.max >= PROFILER_TEST_DELAY_US * ticks_per_us);
+    mu_check(stats.total >= (uint64_t)stats.count * stats.min);
+    mu_assert_int_eq(stats.count, profiler_test_histogram_sum(&stats));
+    mu_check(profiler_probe_get_name(PROFILER_TEST_PROBE) != NULL);
+}
+
+MU_TEST_SUITE(test_profiler) {
+    MU_RUN_TEST(profiler_probe_disabled_test);
+    MU_RUN_TEST(profiler_probe_sample_test);
+}
+
+int run_minunit_test_profiler() {
+    MU_RUN_SUITE(test_profiler);
+    return MU_EXIT_CODE;
+}
@@ -99,6 +99,53 @@ static LevelDuration protocol_1_encoder_yield(Protocol1Data* data) {
     return level_duration_make(!(data->encoder_counter % 2), 100);
 }
 
+/*********************** PROTOCOL 2 START ***********************/
+
+typedef struct {
+    uint32_t data;
+    bool in_sync;
+} Protocol2Data;
+
+static const uint32_t protocol_2_decoder_result = 0xCAFEF00D;
+static size_t protocol_2_feed_counter = 0;
+
+static void* protocol_2_alloc() {
+    void* data = malloc(sizeof(Protocol2Data));
+    return data;
+}
+
+static void protocol_2_free(Protocol2Data* data) {
+    free(data);
+}
+
+static uint8_t* protocol_2_get_data(Protocol2Data* data) {
+    return (uint8_t*)&data->data;
+}
+
+static void protocol_2_decoder_start(Protocol2Data* data) {
+    data->data = 0;
+    data->in_sync = false;
+}
+
+static bool protocol_2_decoder_feed(Protocol2Data* data, bool level, uint32_t duration) {
+    protocol_2_feed_counter++;
+
+    if(duration >= 300 && duration <= 400) {
+        data->in_sync = true;
+    } else if(data->in_sync && level && duration == 777) {
+        data->data = protocol_2_decoder_result;
+        return true;
+    } else {
+        data->in_sync = false;
+    }
+
+    return false;
+}
+
+static ProtocolDecoderState protocol_2_decoder_get_state(Protocol2Data* data) {
+    return data->in_sync ? ProtocolDecoderStateLocked : ProtocolDecoderStateIdle;
+}
+
 /*********************** PROTOCOLS DESCRIPTION ***********************/
 static const ProtocolBase protocol_0 = {
     .name = "Protocol 0",
@@ -138,11 +185,36 @@ static const ProtocolBase protocol_1 = {
         },
 };
 
+static const ProtocolBase protocol_2 = {
+    .name = "Protocol 2",
+    .manufacturer = "Manufacturer 2",
+    .data_size = 4,
+    .alloc = (ProtocolAlloc)protocol_2_alloc,
+    .free = (ProtocolFree)protocol_2_free,
+    .get_data = (ProtocolGetData)protocol_2_get_data,
+    .decoder =
+        {
+            .start = (ProtocolDecoderStart)protocol_2_decoder_start,
+            .feed = (ProtocolDecoderFeed)protocol_2_decoder_feed,
+        },
+    .decoder_activity =
+        {
+            .get_state = (ProtocolDecoderGetState)protocol_2_decoder_get_state,
+            .min_duration = 300,
+            .max_duration = 400,
+        },
+};
+
 static const ProtocolBase* test_protocols_base[] = {
     [TestDictProtocol0] = &protocol_0,
     [TestDictProtocol1] = &protocol_1,
 };
 
+static const ProtocolBase* test_activity_protocols_base[] = {
+    &protocol_0,
+    &protocol_2,
+};
+
 MU_TEST(test_protocol_dict) {
     ProtocolDict* dict = protocol_dict_alloc(test_protocols_base, TestDictProtocolMax);
     size_t max_data_size = protocol_dict_get_max_data_size(dict);
@@ -212,8 +284,47 @@ MU_TEST(test_protocol_dict) {
     free(data);
 }
 
+MU_TEST(test_protocol_dict_activity) {
+    ProtocolDict* dict = protocol_dict_alloc(test_activity_protocols_base, 2);
+    uint32_t data = 0;
+    protocol_dict_decoders_start(dict);
+    protocol_2_feed_counter = 0;
+
+    // idle decoder doesn't get edges out of sync window
+    for(size_t i = 0; i < 10; i++) {
+        mu_assert_int_eq(PROTOCOL_NO, protocol_dict_decoders_feed(dict, i % 2, 100));
+    }
+    mu_assert_int_eq(0, protocol_2_feed_counter);
+    mu_assert_int_eq(ProtocolDecoderStateIdle, protocol_dict_decoders_get_state(dict, 1));
+    mu_assert_int_eq(ProtocolDecoderStateCandidate, protocol_dict_decoders_get_state(dict, 0));
+
+    // decoder without activity report gets every edge
+    mu_assert_int_eq(PROTOCOL_NO, protocol_dict_decoders_feed(dict, true, 777));
+    mu_assert_int_eq(0, protocol_dict_decoders_feed(dict, true, 666));
+    mu_assert_int_eq(0, protocol_2_feed_counter);
+
+    // sync edge re-arms decoder, locked decoder gets every edge
+    mu_assert_int_eq(PROTOCOL_NO, protocol_dict_decoders_feed(dict, false, 350));
+    mu_assert_int_eq(ProtocolDecoderStateLocked, protocol_dict_decoders_get_state(dict, 1));
+    mu_assert_int_eq(1, protocol_dict_decoders_feed(dict, true, 777));
+    mu_assert_int_eq(2, protocol_2_feed_counter);
+    protocol_dict_get_data(dict, 1, (uint8_t*)&data, sizeof(data));
+    mu_assert_int_eq(protocol_2_decoder_result, data);
+
+    // feed by id follows the same rules
+    mu_assert_int_eq(PROTOCOL_NO, protocol_dict_decoders_feed_by_id(dict, 1, true, 100));
+    mu_assert_int_eq(PROTOCOL_NO, protocol_dict_decoders_feed_by_id(dict, 1, true, 777));
+    mu_assert_int_eq(3, protocol_2_feed_counter);
+    mu_assert_int_eq(ProtocolDecoderStateIdle, protocol_dict_decoders_get_state(dict, 1));
+    mu_assert_int_eq(PROTOCOL_NO, protocol_dict_decoders_feed_by_id(dict, 1, false, 300));
+    mu_assert_int_eq(4, protocol_2_feed_counter);
+
+    protocol_dict_free(dict);
+}
+
 MU_TEST_SUITE(test_protocol_dict_suite) {
     MU_RUN_TEST(test_protocol_dict);
+    MU_RUN_TEST(test_protocol_dict_activity);
 }
 
 int run_minunit_test_protocol_dict() {
@@ -5,6 +5,7 @@
 #include <lib/subghz/transmitter.h>
 #include <lib/subghz/subghz_keystore.h>
 #include <lib/subghz/subghz_file_encoder_worker.h>
+#include <lib/subghz/subghz_setting.h>
 #include <lib/subghz/protocols/protocol_items.h>
 #include <flipper_format/flipper_format_i.h>
 #include <lib/subghz/devices/devices.h>
@@ -17,6 +18,8 @@
 #define ALUTECH_AT_4N_DIR_NAME EXT_PATH("subghz/assets/alutech_at_4n")
 #define TEST_RANDOM_DIR_NAME EXT_PATH("unit_tests/subghz/test_random_raw.sub")
 #define TEST_RANDOM_COUNT_PARSE 329
+#define TEST_SETTING_PATH EXT_PATH("unit_tests/subghz/test_setting_user")
+#define TEST_SETTING_CACHE_PATH TEST_SETTING_PATH ".cache"
 #define TEST_TIMEOUT 10000
 
 static SubGhzEnvironment* environment_handler;
@@ -825,6 +828,117 @@ MU_TEST(subghz_random_test) {
     mu_assert(subghz_decode_random_test(TEST_RANDOM_DIR_NAME), "Random test error\r\n");
 }
 
+static const char* subghz_test_setting_data =
+    "Filetype: Flipper SubGhz Setting File\n"
+    "Version: 1\n"
+    "Add_standard_frequencies: true\n"
+    "Default_frequency: 433420000\n"
+    "Frequency: 433420000\n"
+    "Frequency: 433820000\n"
+    "Hopper_frequency: 433820000\n"
+    "Custom_preset_name: Test_preset\n"
+    "Custom_preset_module: CC1101\n"
+    "Custom_preset_data: 02 0D 03 07 08 32 0B 06 00 00 00 00 C0 00 00 00 00 00 00 00\n";
+
+static bool subghz_test_setting_write(const char* data, bool append) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* file = storage_file_alloc(storage);
+    bool result = storage_file_open(
+                      file,
+                      TEST_SETTING_PATH,
+                      FSAM_WRITE,
+                      append ? FSOM_OPEN_APPEND : FSOM_CREATE_ALWAYS) &&
+                  storage_file_write(file, data, strlen(data)) == strlen(data);
+    storage_file_close(file);
+    storage_file_free(file);
+    furi_record_close(RECORD_STORAGE);
+    return result;
+}
+
+static void subghz_test_setting_equal(SubGhzSetting* expected, SubGhzSetting* setting) {
+    mu_assert_int_eq(
+        subghz_setting_get_default_frequency(expected),
+        subghz_setting_get_default_frequency(setting));
+
+    const size_t frequency_count = subghz_setting_get_frequency_count(expected);
+    mu_assert_int_eq(frequency_count, subghz_setting_get_frequency_count(setting));
+    for(size_t i = 0; i < frequency_count; i++) {
+        mu_assert_int_eq(
+            subghz_setting_get_frequency(expected, i), subghz_setting_get_frequency(setting, i));
+    }
+
+    const size_t hopper_count = subghz_setting_get_hopper_frequency_count(expected);
+    mu_assert_int_eq(hopper_count, subghz_setting_get_hopper_frequency_count(setting));
+    for(size_t i = 0; i < hopper_count; i++) {
+        mu_assert_int_eq(
+            subghz_setting_get_hopper_frequency(expected, i),
+            subghz_setting_get_hopper_frequency(setting, i));
+    }
+
+    const size_t preset_count = subghz_setting_get_preset_count(expected);
+    mu_assert_int_eq(preset_count, subghz_setting_get_preset_count(setting));
+    for(size_t i = 0; i < preset_count; i++) {
+        mu_assert_string_eq(
+            subghz_setting_get_preset_name(expected, i),
+            subghz_setting_get_preset_name(setting, i));
+        const size_t size = subghz_setting_get_preset_data_size(expected, i);
+        mu_assert_int_eq(size, subghz_setting_get_preset_data_size(setting, i));
+        mu_assert_mem_eq(
+            subghz_setting_get_preset_data(expected, i),
+            subghz_setting_get_preset_data(setting, i),
+            size);
+    }
+}
+
+MU_TEST(subghz_setting_cache_test) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    storage_simply_remove(storage, TEST_SETTING_CACHE_PATH);
+    mu_assert(subghz_test_setting_write(subghz_test_setting_data, false), "Write setting error");
+
+    // First load parses the file and writes cache, second one loads from it
+    SubGhzSetting* text = subghz_setting_alloc();
+    subghz_setting_load(text, TEST_SETTING_PATH);
+    mu_assert(storage_file_exists(storage, TEST_SETTING_CACHE_PATH), "Cache is not written");
+    mu_assert_int_eq(433420000, subghz_setting_get_default_frequency(text));
+
+    SubGhzSetting* setting = subghz_setting_alloc();
+    subghz_setting_load(setting, TEST_SETTING_PATH);
+    subghz_test_setting_equal(text, setting);
+    subghz_setting_free(setting);
+
+    // Changed file must not be served from the old cache
+    mu_assert(subghz_test_setting_write("Frequency: 433920000\n", true), "Append setting error");
+    setting = subghz_setting_alloc();
+    subghz_setting_load(setting, TEST_SETTING_PATH);
+    mu_assert_int_eq(
+        subghz_setting_get_frequency_count(text) + 1,
+        subghz_setting_get_frequency_count(setting));
+    subghz_setting_free(setting);
+
+    // Broken cache falls back to the file
+    SubGhzSetting* appended = subghz_setting_alloc();
+    subghz_setting_load(appended, TEST_SETTING_PATH);
+    File* file = storage_file_alloc(storage);
+    mu_assert(
+        storage_file_open(file, TEST_SETTING_CACHE_PATH, FSAM_READ_WRITE, FSOM_OPEN_EXISTING),
+        "Open cache error");
+    mu_assert(storage_file_seek(file, storage_file_size(file) - 1, true), "Seek cache error");
+    mu_assert_int_eq(1, storage_file_write(file, "\xFF", 1));
+    storage_file_close(file);
+    storage_file_free(file);
+
+    setting = subghz_setting_alloc();
+    subghz_setting_load(setting, TEST_SETTING_PATH);
+    subghz_test_setting_equal(appended, setting);
+    subghz_setting_free(setting);
+
+    subghz_setting_free(appended);
+    subghz_setting_free(text);
+    storage_simply_remove(storage, TEST_SETTING_CACHE_PATH);
+    storage_simply_remove(storage, TEST_SETTING_PATH);
+    furi_record_close(RECORD_STORAGE);
+}
+
 MU_TEST_SUITE(subghz) {
     subghz_test_init();
     MU_RUN_TEST(subghz_keystore_test);
@@ -901,6 +1015,7 @@ MU_TEST_SUITE(subghz) {
     MU_RUN_TEST(subghz_encoder_mastercode_test);
 
     MU_RUN_TEST(subghz_random_test);
+    MU_RUN_TEST(subghz_setting_cache_test);
     subghz_test_deinit();
 }
 
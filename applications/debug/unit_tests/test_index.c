@@ -24,10 +24,12 @@ int run_minunit_test_dirwalk();
 int run_minunit_test_power();
 int run_minunit_test_protocol_dict();
 int run_minunit_test_lfrfid_protocols();
+int run_minunit_test_one_wire();
 int run_minunit_test_nfc();
 int run_minunit_test_bit_lib();
 int run_minunit_test_float_tools();
 int run_minunit_test_bt();
+int run_minunit_test_profiler();
 int run_minunit_test_dialogs_file_browser_options();
 
 typedef int (*UnitTestEntry)();
@@ -55,9 +57,11 @@ const UnitTest unit_tests[] = {
     {.name = "power", .entry = run_minunit_test_power},
     {.name = "protocol_dict", .entry = run_minunit_test_protocol_dict},
     {.name = "lfrfid", .entry = run_minunit_test_lfrfid_protocols},
+    {.name = "one_wire", .entry = run_minunit_test_one_wire},
     {.name = "bit_lib", .entry = run_minunit_test_bit_lib},
     {.name = "float_tools", .entry = run_minunit_test_float_tools},
     {.name = "bt", .entry = run_minunit_test_bt},
+    {.name = "profiler", .entry = run_minunit_test_profiler},
     {.name = "dialogs_file_browser_options",
      .entry = run_minunit_test_dialogs_file_browser_options},
 };
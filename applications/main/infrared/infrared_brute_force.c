@@ -1,8 +1,10 @@
 #include "infrared_brute_force.h"
 
 #include <stdlib.h>
+#include <m-array.h>
 #include <m-dict.h>
 #include <flipper_format/flipper_format.h>
+#include <flipper_format/flipper_format_i.h>
 
 #include "infrared_signal.h"
 
@@ -18,12 +20,23 @@ DICT_DEF2(
     InfraredBruteForceRecord,
     M_POD_OPLIST);
 
+// Signal of a record in the database file, offset is right after the signal name
+typedef struct {
+    uint32_t index;
+    uint32_t offset;
+} InfraredBruteForceSignal;
+
+ARRAY_DEF(InfraredBruteForceSignalArray, InfraredBruteForceSignal, M_POD_OPLIST);
+
 struct InfraredBruteForce {
     FlipperFormat* ff;
     const char* db_filename;
     FuriString* current_record_name;
     InfraredSignal* current_signal;
     InfraredBruteForceRecordDict_t records;
+    InfraredBruteForceSignalArray_t signals;
+    uint32_t current_record_index;
+    size_t current_signal_index;
     bool is_started;
 };
 
@@ -35,12 +48,14 @@ InfraredBruteForce* infrared_brute_force_alloc() {
     brute_force->is_started = false;
     brute_force->current_record_name = furi_string_alloc();
     InfraredBruteForceRecordDict_init(brute_force->records);
+    InfraredBruteForceSignalArray_init(brute_force->signals);
     return brute_force;
 }
 
 void infrared_brute_force_free(InfraredBruteForce* brute_force) {
     furi_assert(!brute_force->is_started);
     InfraredBruteForceRecordDict_clear(brute_force->records);
+    InfraredBruteForceSignalArray_clear(brute_force->signals);
     furi_string_free(brute_force->current_record_name);
     free(brute_force);
 }
@@ -60,6 +75,7 @@ bool infrared_brute_force_calculate_messages(InfraredBruteForce* brute_force) {
 
     success = flipper_format_buffered_file_open_existing(ff, brute_force->db_filename);
     if(success) {
+        Stream* stream = flipper_format_get_raw_stream(ff);
         FuriString* signal_name;
         signal_name = furi_string_alloc();
         while(flipper_format_read_string(ff, "name", signal_name)) {
@@ -67,6 +83,12 @@ bool infrared_brute_force_calculate_messages(InfraredBruteForce* brute_force) {
                 InfraredBruteForceRecordDict_get(brute_force->records, signal_name);
             if(record) { //-V547
                 ++(record->count);
+                // Remember where the signal is, so that sending it does not scan the file
+                const InfraredBruteForceSignal signal = {
+                    .index = record->index,
+                    .offset = stream_tell(stream),
+                };
+                InfraredBruteForceSignalArray_push_back(brute_force->signals, signal);
             }
         }
         furi_string_free(signal_name);
@@ -94,6 +116,8 @@ bool infrared_brute_force_start(
             *record_count = record->value.count;
             if(*record_count) {
                 furi_string_set(brute_force->current_record_name, record->key);
+                brute_force->current_record_index = index;
+                brute_force->current_signal_index = 0;
             }
             break;
         }
@@ -128,10 +152,22 @@ void infrared_brute_force_stop(InfraredBruteForce* brute_force) {
 
 bool infrared_brute_force_send_next(InfraredBruteForce* brute_force) {
     furi_assert(brute_force->is_started);
-    const bool success = infrared_signal_search_by_name_and_read(
-        brute_force->current_signal,
-        brute_force->ff,
-        furi_string_get_cstr(brute_force->current_record_name));
+
+    const size_t signal_count = InfraredBruteForceSignalArray_size(brute_force->signals);
+    const InfraredBruteForceSignal* signal = NULL;
+
+    while(brute_force->current_signal_index < signal_count) {
+        signal = InfraredBruteForceSignalArray_cget(
+            brute_force->signals, brute_force->current_signal_index++);
+        if(signal->index == brute_force->current_record_index) break;
+        signal = NULL;
+    }
+
+    if(!signal) return false;
+
+    Stream* stream = flipper_format_get_raw_stream(brute_force->ff);
+    const bool success = stream_seek(stream, signal->offset, StreamOffsetFromStart) &&
+                         infrared_signal_read_body(brute_force->current_signal, brute_force->ff);
     if(success) {
         infrared_signal_transmit(brute_force->current_signal);
     }
@@ -152,4 +188,5 @@ void infrared_brute_force_add_record(
 void infrared_brute_force_reset(InfraredBruteForce* brute_force) {
     furi_assert(!brute_force->is_started);
     InfraredBruteForceRecordDict_reset(brute_force->records);
+    InfraredBruteForceSignalArray_reset(brute_force->signals);
 }
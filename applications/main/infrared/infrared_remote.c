@@ -5,41 +5,40 @@
 #include <toolbox/m_cstr_dup.h>
 #include <toolbox/path.h>
 #include <storage/storage.h>
+#include <flipper_format/flipper_format_i.h>
 
 #define TAG "InfraredRemote"
 
 #define INFRARED_FILE_HEADER "IR signals file"
 #define INFRARED_FILE_VERSION (1)
 
+#define INFRARED_LINE_HEAD_SIZE (16U)
+
 ARRAY_DEF(StringArray, const char*, M_CSTR_DUP_OPLIST); //-V575
 
+/*
+ * Signal record spans from its name line, or the comment line right before it,
+ * up to the next record or the end of file.
+ */
+typedef struct {
+    uint32_t name_hash;
+    uint32_t offset;
+    uint32_t length;
+} InfraredSignalRecord;
+
+ARRAY_DEF(InfraredSignalTable, InfraredSignalRecord, M_POD_OPLIST);
+
 struct InfraredRemote {
     StringArray_t signal_names;
+    InfraredSignalTable_t signal_table;
     FuriString* name;
     FuriString* path;
 };
 
-typedef struct {
-    InfraredRemote* remote;
-    FlipperFormat* ff_in;
-    FlipperFormat* ff_out;
-    FuriString* signal_name;
-    InfraredSignal* signal;
-    size_t signal_index;
-} InfraredBatch;
-
-typedef struct {
-    size_t signal_index;
-    const char* signal_name;
-    const InfraredSignal* signal;
-} InfraredBatchTarget;
-
-typedef bool (
-    *InfraredBatchCallback)(const InfraredBatch* batch, const InfraredBatchTarget* target);
-
 InfraredRemote* infrared_remote_alloc() {
     InfraredRemote* remote = malloc(sizeof(InfraredRemote));
     StringArray_init(remote->signal_names);
+    InfraredSignalTable_init(remote->signal_table);
     remote->name = furi_string_alloc();
     remote->path = furi_string_alloc();
     return remote;
@@ -47,6 +46,7 @@ InfraredRemote* infrared_remote_alloc() {
 
 void infrared_remote_free(InfraredRemote* remote) {
     StringArray_clear(remote->signal_names);
+    InfraredSignalTable_clear(remote->signal_table);
     furi_string_free(remote->path);
     furi_string_free(remote->name);
     free(remote);
@@ -54,6 +54,7 @@ void infrared_remote_free(InfraredRemote* remote) {
 
 void infrared_remote_reset(InfraredRemote* remote) {
     StringArray_reset(remote->signal_names);
+    InfraredSignalTable_reset(remote->signal_table);
     furi_string_reset(remote->name);
     furi_string_reset(remote->path);
 }
@@ -71,6 +72,39 @@ const char* infrared_remote_get_path(const InfraredRemote* remote) {
     return furi_string_get_cstr(remote->path);
 }
 
+static uint32_t infrared_remote_hash_name(const char* name) {
+    uint32_t hash = 0x811C9DC5UL; //FNV-1a
+    for(; *name; ++name) {
+        hash = (hash ^ (uint8_t)*name) * 0x01000193UL;
+    }
+    return hash;
+}
+
+static void infrared_remote_insert_record(
+    InfraredRemote* remote,
+    size_t index,
+    const char* name,
+    size_t offset,
+    size_t length) {
+    const InfraredSignalRecord record = {
+        .name_hash = infrared_remote_hash_name(name),
+        .offset = offset,
+        .length = length,
+    };
+
+    StringArray_push_at(remote->signal_names, index, name);
+    InfraredSignalTable_push_at(remote->signal_table, index, record);
+}
+
+// Records after a changed one keep their contents, only their place in the file moves
+static void infrared_remote_shift_records(InfraredRemote* remote, size_t index, int32_t delta) {
+    const size_t signal_count = infrared_remote_get_signal_count(remote);
+
+    for(size_t i = index; i < signal_count; ++i) {
+        InfraredSignalTable_get(remote->signal_table, i)->offset += delta;
+    }
+}
+
 size_t infrared_remote_get_signal_count(const InfraredRemote* remote) {
     return StringArray_size(remote->signal_names);
 }
@@ -88,14 +122,18 @@ bool infrared_remote_load_signal(
 
     Storage* storage = furi_record_open(RECORD_STORAGE);
     FlipperFormat* ff = flipper_format_buffered_file_alloc(storage);
+    FuriString* tmp = furi_string_alloc();
 
+    const InfraredSignalRecord* record = InfraredSignalTable_cget(remote->signal_table, index);
     bool success = false;
 
     do {
         const char* path = furi_string_get_cstr(remote->path);
         if(!flipper_format_buffered_file_open_existing(ff, path)) break;
 
-        if(!infrared_signal_search_by_index_and_read(signal, ff, index)) {
+        Stream* stream = flipper_format_get_raw_stream(ff);
+        if(!stream_seek(stream, record->offset, StreamOffsetFromStart) ||
+           !infrared_signal_read(signal, ff, tmp)) {
             const char* signal_name = infrared_remote_get_signal_name(remote, index);
             FURI_LOG_E(TAG, "Failed to load signal '%s' from file '%s'", signal_name, path);
             break;
@@ -104,6 +142,7 @@ bool infrared_remote_load_signal(
         success = true;
     } while(false);
 
+    furi_string_free(tmp);
     flipper_format_free(ff);
     furi_record_close(RECORD_STORAGE);
 
@@ -114,12 +153,12 @@ bool infrared_remote_get_signal_index(
     const InfraredRemote* remote,
     const char* name,
     size_t* index) {
-    uint32_t i = 0;
-    StringArray_it_t it;
+    const uint32_t name_hash = infrared_remote_hash_name(name);
+    const size_t signal_count = infrared_remote_get_signal_count(remote);
 
-    for(StringArray_it(it, remote->signal_names); !StringArray_end_p(it);
-        StringArray_next(it), ++i) {
-        if(strcmp(*StringArray_cref(it), name) == 0) {
+    for(size_t i = 0; i < signal_count; ++i) {
+        if(InfraredSignalTable_cget(remote->signal_table, i)->name_hash != name_hash) continue;
+        if(strcmp(infrared_remote_get_signal_name(remote, i), name) == 0) {
             *index = i;
             return true;
         }
@@ -140,9 +179,20 @@ bool infrared_remote_append_signal(
 
     do {
         if(!flipper_format_file_open_append(ff, path)) break;
+
+        Stream* stream = flipper_format_get_raw_stream(ff);
+        const size_t offset = stream_tell(stream);
         if(!infrared_signal_save(signal, ff, name)) break;
 
-        StringArray_push_back(remote->signal_names, name);
+        const size_t signal_count = infrared_remote_get_signal_count(remote);
+        if(signal_count) {
+            // Previous last record also owns the line end added by open_append
+            InfraredSignalRecord* last = InfraredSignalTable_back(remote->signal_table);
+            last->length = offset - last->offset;
+        }
+
+        infrared_remote_insert_record(
+            remote, signal_count, name, offset, stream_tell(stream) - offset);
         success = true;
     } while(false);
 
@@ -152,21 +202,22 @@ bool infrared_remote_append_signal(
     return success;
 }
 
-static bool infrared_remote_batch_start(
+/*
+ * Replace length bytes at offset with a signal, or just remove them if signal is NULL.
+ * The rest of the file is copied as is, untouched signals are not parsed.
+ */
+static bool infrared_remote_splice(
     InfraredRemote* remote,
-    InfraredBatchCallback batch_callback,
-    const InfraredBatchTarget* target) {
+    size_t offset,
+    size_t length,
+    const InfraredSignal* signal,
+    const char* name,
+    size_t* written) {
     FuriString* tmp = furi_string_alloc();
     Storage* storage = furi_record_open(RECORD_STORAGE);
 
-    InfraredBatch batch_context = {
-        .remote = remote,
-        .ff_in = flipper_format_buffered_file_alloc(storage),
-        .ff_out = flipper_format_buffered_file_alloc(storage),
-        .signal_name = furi_string_alloc(),
-        .signal = infrared_signal_alloc(),
-        .signal_index = 0,
-    };
+    FlipperFormat* ff_in = flipper_format_buffered_file_alloc(storage);
+    FlipperFormat* ff_out = flipper_format_buffered_file_alloc(storage);
 
     const char* path_in = furi_string_get_cstr(remote->path);
     const char* path_out;
@@ -180,36 +231,38 @@ static bool infrared_remote_batch_start(
     } while(status == FSE_OK || status == FSE_EXIST);
 
     bool success = false;
+    *written = 0;
 
     do {
-        if(!flipper_format_buffered_file_open_existing(batch_context.ff_in, path_in)) break;
-        if(!flipper_format_buffered_file_open_always(batch_context.ff_out, path_out)) break;
-        if(!flipper_format_write_header_cstr(
-               batch_context.ff_out, INFRARED_FILE_HEADER, INFRARED_FILE_VERSION))
-            break;
+        if(!flipper_format_buffered_file_open_existing(ff_in, path_in)) break;
+        if(!flipper_format_buffered_file_open_always(ff_out, path_out)) break;
 
-        const size_t signal_count = infrared_remote_get_signal_count(remote);
+        Stream* stream_in = flipper_format_get_raw_stream(ff_in);
+        Stream* stream_out = flipper_format_get_raw_stream(ff_out);
 
-        for(; batch_context.signal_index < signal_count; ++batch_context.signal_index) {
-            if(!infrared_signal_read(
-                   batch_context.signal, batch_context.ff_in, batch_context.signal_name))
-                break;
-            if(!batch_callback(&batch_context, target)) break;
+        const size_t size_in = stream_size(stream_in);
+        if(offset + length > size_in) break;
+
+        if(stream_copy(stream_in, stream_out, offset) != offset) break;
+
+        if(signal) {
+            if(!infrared_signal_save(signal, ff_out, name)) break;
+            *written = stream_tell(stream_out) - offset;
         }
 
-        if(batch_context.signal_index != signal_count) break;
+        const size_t tail = size_in - offset - length;
+        if(!stream_seek(stream_in, offset + length, StreamOffsetFromStart)) break;
+        if(stream_copy(stream_in, stream_out, tail) != tail) break;
 
-        if(!flipper_format_buffered_file_close(batch_context.ff_out)) break;
-        if(!flipper_format_buffered_file_close(batch_context.ff_in)) break;
+        if(!flipper_format_buffered_file_close(ff_out)) break;
+        if(!flipper_format_buffered_file_close(ff_in)) break;
 
         const FS_Error status = storage_common_rename(storage, path_out, path_in);
         success = (status == FSE_OK || status == FSE_EXIST);
     } while(false);
 
-    infrared_signal_free(batch_context.signal);
-    furi_string_free(batch_context.signal_name);
-    flipper_format_free(batch_context.ff_out);
-    flipper_format_free(batch_context.ff_in);
+    flipper_format_free(ff_out);
+    flipper_format_free(ff_in);
     furi_string_free(tmp);
 
     furi_record_close(RECORD_STORAGE);
@@ -217,21 +270,6 @@ static bool infrared_remote_batch_start(
     return success;
 }
 
-static bool infrared_remote_insert_signal_callback(
-    const InfraredBatch* batch,
-    const InfraredBatchTarget* target) {
-    // Insert a signal under the specified index
-    if(batch->signal_index == target->signal_index) {
-        if(!infrared_signal_save(target->signal, batch->ff_out, target->signal_name)) return false;
-        StringArray_push_at(
-            batch->remote->signal_names, target->signal_index, target->signal_name);
-    }
-
-    // Write the rest normally
-    return infrared_signal_save(
-        batch->signal, batch->ff_out, furi_string_get_cstr(batch->signal_name));
-}
-
 bool infrared_remote_insert_signal(
     InfraredRemote* remote,
     const InfraredSignal* signal,
@@ -241,73 +279,65 @@ bool infrared_remote_insert_signal(
         return infrared_remote_append_signal(remote, signal, name);
     }
 
-    const InfraredBatchTarget insert_target = {
-        .signal_index = index,
-        .signal_name = name,
-        .signal = signal,
-    };
+    // New signal takes the place of the one currently under the index
+    const size_t offset = InfraredSignalTable_cget(remote->signal_table, index)->offset;
+    size_t written;
 
-    return infrared_remote_batch_start(
-        remote, infrared_remote_insert_signal_callback, &insert_target);
-}
+    if(!infrared_remote_splice(remote, offset, 0, signal, name, &written)) return false;
 
-static bool infrared_remote_rename_signal_callback(
-    const InfraredBatch* batch,
-    const InfraredBatchTarget* target) {
-    const char* signal_name;
-
-    if(batch->signal_index == target->signal_index) {
-        // Rename the signal at requested index
-        signal_name = target->signal_name;
-        StringArray_set_at(batch->remote->signal_names, batch->signal_index, signal_name);
-    } else {
-        // Use the original name otherwise
-        signal_name = furi_string_get_cstr(batch->signal_name);
-    }
+    infrared_remote_shift_records(remote, index, written);
+    infrared_remote_insert_record(remote, index, name, offset, written);
 
-    return infrared_signal_save(batch->signal, batch->ff_out, signal_name);
+    return true;
 }
 
 bool infrared_remote_rename_signal(InfraredRemote* remote, size_t index, const char* new_name) {
     furi_assert(index < infrared_remote_get_signal_count(remote));
 
-    const InfraredBatchTarget rename_target = {
-        .signal_index = index,
-        .signal_name = new_name,
-        .signal = NULL,
-    };
+    InfraredSignal* signal = infrared_signal_alloc();
+    char* name = strdup(new_name);
 
-    return infrared_remote_batch_start(
-        remote, infrared_remote_rename_signal_callback, &rename_target);
-}
+    bool success = false;
 
-static bool infrared_remote_delete_signal_callback(
-    const InfraredBatch* batch,
-    const InfraredBatchTarget* target) {
-    if(batch->signal_index == target->signal_index) {
-        // Do not save the signal to be deleted, remove it from the signal name list instead
-        StringArray_remove_v(
-            batch->remote->signal_names, batch->signal_index, batch->signal_index + 1);
-    } else {
-        // Pass other signals through
-        return infrared_signal_save(
-            batch->signal, batch->ff_out, furi_string_get_cstr(batch->signal_name));
-    }
+    do {
+        if(!infrared_remote_load_signal(remote, signal, index)) break;
 
-    return true;
+        InfraredSignalRecord* record = InfraredSignalTable_get(remote->signal_table, index);
+        size_t written;
+
+        if(!infrared_remote_splice(remote, record->offset, record->length, signal, name, &written))
+            break;
+
+        infrared_remote_shift_records(
+            remote, index + 1, (int32_t)written - (int32_t)record->length);
+        record->length = written;
+        record->name_hash = infrared_remote_hash_name(name);
+        StringArray_set_at(remote->signal_names, index, name);
+
+        success = true;
+    } while(false);
+
+    free(name);
+    infrared_signal_free(signal);
+
+    return success;
 }
 
 bool infrared_remote_delete_signal(InfraredRemote* remote, size_t index) {
     furi_assert(index < infrared_remote_get_signal_count(remote));
 
-    const InfraredBatchTarget delete_target = {
-        .signal_index = index,
-        .signal_name = NULL,
-        .signal = NULL,
-    };
+    const InfraredSignalRecord record = *InfraredSignalTable_cget(remote->signal_table, index);
+    size_t written;
+
+    if(!infrared_remote_splice(remote, record.offset, record.length, NULL, NULL, &written))
+        return false;
 
-    return infrared_remote_batch_start(
-        remote, infrared_remote_delete_signal_callback, &delete_target);
+    // Remove the signal from the name list and the table, move the following ones in its place
+    StringArray_remove_v(remote->signal_names, index, index + 1);
+    InfraredSignalTable_remove_v(remote->signal_table, index, index + 1);
+    infrared_remote_shift_records(remote, index, -(int32_t)record.length);
+
+    return true;
 }
 
 bool infrared_remote_move_signal(InfraredRemote* remote, size_t index, size_t new_index) {
@@ -361,6 +391,86 @@ bool infrared_remote_create(InfraredRemote* remote, const char* path) {
     return success;
 }
 
+/* Read the beginning of the line at current position and move to the next line */
+static bool infrared_remote_read_line_head(Stream* stream, char* head) {
+    const size_t was_read = stream_read(stream, (uint8_t*)head, INFRARED_LINE_HEAD_SIZE - 1);
+    if(was_read == 0) return false;
+
+    size_t length = 0;
+    while((length < was_read) && (head[length] != '\n')) ++length;
+    head[length] = '\0';
+
+    if(length < was_read) {
+        return stream_seek(stream, (int32_t)(length + 1) - was_read, StreamOffsetFromCurrent);
+    }
+
+    // Long line, e.g. raw signal data: skip the rest of it
+    uint8_t buffer[INFRARED_LINE_HEAD_SIZE];
+
+    while(true) {
+        const size_t ret = stream_read(stream, buffer, sizeof(buffer));
+        for(size_t i = 0; i < ret; ++i) {
+            if(buffer[i] == '\n') {
+                return stream_seek(stream, (int32_t)(i + 1) - ret, StreamOffsetFromCurrent);
+            }
+        }
+        if(ret != sizeof(buffer)) break;
+    }
+
+    return true;
+}
+
+/*
+ * Fill the signal table in one pass over the file: names are parsed,
+ * the rest of the signals are only skipped line by line.
+ */
+static void infrared_remote_load_table(InfraredRemote* remote, FlipperFormat* ff) {
+    Stream* stream = flipper_format_get_raw_stream(ff);
+    FuriString* tmp = furi_string_alloc();
+    char head[INFRARED_LINE_HEAD_SIZE];
+
+    size_t comment_offset = SIZE_MAX;
+
+    while(true) {
+        const size_t offset = stream_tell(stream);
+        if(!infrared_remote_read_line_head(stream, head)) break;
+
+        if(head[0] == '#') {
+            comment_offset = offset;
+            continue;
+        }
+
+        const size_t signal_count = infrared_remote_get_signal_count(remote);
+
+        if(strncmp(head, "name:", strlen("name:")) == 0) {
+            const size_t record_offset = (comment_offset != SIZE_MAX) ? comment_offset : offset;
+
+            // Same as reading names one by one: listing stops at a broken one
+            if(!stream_seek(stream, offset, StreamOffsetFromStart) ||
+               !infrared_signal_read_name(ff, tmp)) {
+                break;
+            }
+
+            if(signal_count) {
+                InfraredSignalRecord* last = InfraredSignalTable_back(remote->signal_table);
+                last->length = record_offset - last->offset;
+            }
+
+            infrared_remote_insert_record(
+                remote, signal_count, furi_string_get_cstr(tmp), record_offset, 0);
+        }
+
+        comment_offset = SIZE_MAX;
+    }
+
+    if(infrared_remote_get_signal_count(remote)) {
+        InfraredSignalRecord* last = InfraredSignalTable_back(remote->signal_table);
+        last->length = stream_size(stream) - last->offset;
+    }
+
+    furi_string_free(tmp);
+}
+
 bool infrared_remote_load(InfraredRemote* remote, const char* path) {
     FURI_LOG_I(TAG, "Loading file: '%s'", path);
 
@@ -381,11 +491,9 @@ bool infrared_remote_load(InfraredRemote* remote, const char* path) {
 
         infrared_remote_set_path(remote, path);
         StringArray_reset(remote->signal_names);
+        InfraredSignalTable_reset(remote->signal_table);
 
-        while(infrared_signal_read_name(ff, tmp)) {
-            StringArray_push_back(remote->signal_names, furi_string_get_cstr(tmp));
-        }
-
+        infrared_remote_load_table(remote, ff);
         success = true;
     } while(false);
 
@@ -8,6 +8,10 @@
  * The current implementation does load only the names into the memory,
  * while the signals themselves are loaded on-demand one by one. In theory,
  * this should allow for quite large remotes with relatively bulky signals.
+ *
+ * Along with the names, a table of signal locations in the file is built in one
+ * pass on load, so that any signal is loaded with a single seek and read. Editing
+ * functions keep the table valid and copy the untouched signals as they are.
  */
 #pragma once
 
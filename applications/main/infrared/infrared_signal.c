@@ -5,6 +5,7 @@
 #include <core/check.h>
 #include <infrared_worker.h>
 #include <infrared_transmit.h>
+#include <inttypes.h>
 
 #define TAG "InfraredSignal"
 
@@ -38,7 +39,7 @@ static bool infrared_signal_is_message_valid(const InfraredMessage* message) {
     if(message->address != (message->address & address_mask)) {
         FURI_LOG_E(
             TAG,
-            "Address is out of range (mask 0x%08lX): 0x%lX\r\n",
+            "Address is out of range (mask 0x%08" PRIX32 "): 0x%" PRIX32 "\r\n",
             address_mask,
             message->address);
         return false;
@@ -50,7 +51,7 @@ static bool infrared_signal_is_message_valid(const InfraredMessage* message) {
     if(message->command != (message->command & command_mask)) {
         FURI_LOG_E(
             TAG,
-            "Command is out of range (mask 0x%08lX): 0x%lX\r\n",
+            "Command is out of range (mask 0x%08" PRIX32 "): 0x%" PRIX32 "\r\n",
             command_mask,
             message->command);
         return false;
@@ -63,7 +64,7 @@ static bool infrared_signal_is_raw_valid(const InfraredRawSignal* raw) {
     if((raw->frequency > INFRARED_MAX_FREQUENCY) || (raw->frequency < INFRARED_MIN_FREQUENCY)) {
         FURI_LOG_E(
             TAG,
-            "Frequency is out of range (%X - %X): %lX",
+            "Frequency is out of range (%X - %X): %" PRIX32,
             INFRARED_MIN_FREQUENCY,
             INFRARED_MAX_FREQUENCY,
             raw->frequency);
@@ -149,7 +150,7 @@ static inline bool infrared_signal_read_raw(InfraredSignal* signal, FlipperForma
     return success;
 }
 
-static bool infrared_signal_read_body(InfraredSignal* signal, FlipperFormat* ff) {
+bool infrared_signal_read_body(InfraredSignal* signal, FlipperFormat* ff) {
     FuriString* tmp = furi_string_alloc();
 
     bool success = false;
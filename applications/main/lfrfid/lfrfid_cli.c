@@ -25,7 +25,7 @@ void lfrfid_on_system_start() {
 
 static void lfrfid_cli_print_usage() {
     printf("Usage:\r\n");
-    printf("rfid read <optional: normal | indala>\r\n");
+    printf("rfid read <optional: normal | indala | both>\r\n");
     printf("rfid <write | emulate> <key_type> <key_data>\r\n");
     printf("rfid raw_read <ask | psk> <filename>\r\n");
     printf("rfid raw_emulate <filename>\r\n");
@@ -61,6 +61,9 @@ static void lfrfid_cli_read(Cli* cli, FuriString* args) {
             furi_string_cmp_str(type_string, "psk") == 0) {
             // psk
             type = LFRFIDWorkerReadTypePSKOnly;
+        } else if(furi_string_cmp_str(type_string, "both") == 0) {
+            // ask and psk on the same capture
+            type = LFRFIDWorkerReadTypeConcurrent;
         } else {
             lfrfid_cli_print_usage();
             furi_string_free(type_string);
@@ -4,6 +4,7 @@
 typedef enum {
     SubmenuIndexASK,
     SubmenuIndexPSK,
+    SubmenuIndexConcurrent,
     SubmenuIndexRAW,
 } SubmenuIndex;
 
@@ -29,6 +30,12 @@ void lfrfid_scene_extra_actions_on_enter(void* context) {
         SubmenuIndexPSK,
         lfrfid_scene_extra_actions_submenu_callback,
         app);
+    submenu_add_item(
+        submenu,
+        "Read ASK and PSK at Once",
+        SubmenuIndexConcurrent,
+        lfrfid_scene_extra_actions_submenu_callback,
+        app);
 
     if(furi_hal_rtc_is_flag_set(FuriHalRtcFlagDebug)) {
         submenu_add_item(
@@ -65,6 +72,11 @@ bool lfrfid_scene_extra_actions_on_event(void* context, SceneManagerEvent event)
             scene_manager_next_scene(app->scene_manager, LfRfidSceneRead);
             dolphin_deed(DolphinDeedRfidRead);
             consumed = true;
+        } else if(event.event == SubmenuIndexConcurrent) {
+            app->read_type = LFRFIDWorkerReadTypeConcurrent;
+            scene_manager_next_scene(app->scene_manager, LfRfidSceneRead);
+            dolphin_deed(DolphinDeedRfidRead);
+            consumed = true;
         } else if(event.event == SubmenuIndexRAW) {
             scene_manager_next_scene(app->scene_manager, LfRfidSceneRawName);
             consumed = true;
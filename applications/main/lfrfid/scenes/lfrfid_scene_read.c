@@ -84,12 +84,14 @@ bool lfrfid_scene_read_on_event(void* context, SceneManagerEvent event) {
             dolphin_deed(DolphinDeedRfidReadSuccess);
             consumed = true;
         } else if(event.event == LfRfidEventReadStartPSK) {
-            if(app->read_type == LFRFIDWorkerReadTypeAuto) {
+            if(app->read_type == LFRFIDWorkerReadTypeAuto ||
+               app->read_type == LFRFIDWorkerReadTypeConcurrent) {
                 lfrfid_view_read_set_read_mode(app->read_view, LfRfidReadPsk);
             }
             consumed = true;
         } else if(event.event == LfRfidEventReadStartASK) {
-            if(app->read_type == LFRFIDWorkerReadTypeAuto) {
+            if(app->read_type == LFRFIDWorkerReadTypeAuto ||
+               app->read_type == LFRFIDWorkerReadTypeConcurrent) {
                 lfrfid_view_read_set_read_mode(app->read_view, LfRfidReadAsk);
             }
             consumed = true;
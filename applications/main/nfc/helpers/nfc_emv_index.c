@@ -0,0 +1,273 @@
+#include "nfc_emv_index.h"
+
+#include <furi.h>
+#include <toolbox/crc32_calc.h>
+
+#define TAG "NfcEmvIndex"
+
+#define NFC_EMV_INDEX_MAGIC (0x49564D45UL) // "EMVI"
+#define NFC_EMV_INDEX_VERSION (2U)
+
+#define NFC_EMV_INDEX_PAGE_SIZE (256U)
+#define NFC_EMV_INDEX_PAGE_NUM (4U)
+
+#define NFC_EMV_INDEX_NAME_OFFSET_SIZE (sizeof(uint32_t))
+
+typedef struct FURI_PACKED {
+    uint32_t magic;
+    uint8_t version;
+    uint8_t key_size;
+    uint16_t reserved;
+    uint32_t record_count;
+    uint32_t source_size;
+    uint32_t source_crc;
+} NfcEmvIndexHeader;
+
+typedef struct {
+    bool valid;
+    uint32_t offset;
+    uint32_t size;
+    uint32_t last_used;
+    uint8_t data[NFC_EMV_INDEX_PAGE_SIZE];
+} NfcEmvIndexPage;
+
+struct NfcEmvIndex {
+    Storage* storage;
+    File* file;
+    bool is_open;
+
+    uint32_t file_size;
+    uint8_t key_size;
+    uint32_t record_count;
+    uint32_t record_size;
+    uint32_t names_offset;
+
+    uint32_t page_clock;
+    NfcEmvIndexPage page[NFC_EMV_INDEX_PAGE_NUM];
+};
+
+NfcEmvIndex* nfc_emv_index_alloc(Storage* storage) {
+    furi_assert(storage);
+
+    NfcEmvIndex* instance = malloc(sizeof(NfcEmvIndex));
+    instance->storage = storage;
+    instance->file = storage_file_alloc(storage);
+
+    return instance;
+}
+
+void nfc_emv_index_free(NfcEmvIndex* instance) {
+    furi_assert(instance);
+
+    nfc_emv_index_close(instance);
+    storage_file_free(instance->file);
+    free(instance);
+}
+
+static const NfcEmvIndexPage* nfc_emv_index_get_page(NfcEmvIndex* instance, uint32_t offset) {
+    const uint32_t page_offset = offset - offset % NFC_EMV_INDEX_PAGE_SIZE;
+    NfcEmvIndexPage* victim = &instance->page[0];
+
+    for(size_t i = 0; i < NFC_EMV_INDEX_PAGE_NUM; i++) {
+        NfcEmvIndexPage* page = &instance->page[i];
+        if(page->valid && page->offset == page_offset) {
+            page->last_used = ++instance->page_clock;
+            return page;
+        }
+        // Free pages first, then the least recently used one
+        if(!page->valid || (victim->valid && page->last_used < victim->last_used)) {
+            victim = page;
+        }
+    }
+
+    victim->valid = false;
+    if(!storage_file_seek(instance->file, page_offset, true)) return NULL;
+    const size_t size_expected = MIN(NFC_EMV_INDEX_PAGE_SIZE, instance->file_size - page_offset);
+    victim->size = storage_file_read(instance->file, victim->data, size_expected);
+    if(victim->size != size_expected) return NULL;
+
+    victim->valid = true;
+    victim->offset = page_offset;
+    victim->last_used = ++instance->page_clock;
+
+    return victim;
+}
+
+static bool
+    nfc_emv_index_read(NfcEmvIndex* instance, uint32_t offset, void* data, size_t size) {
+    if(offset + size > instance->file_size) return false;
+
+    uint8_t* dest = data;
+    while(size) {
+        const NfcEmvIndexPage* page = nfc_emv_index_get_page(instance, offset);
+        if(!page) return false;
+
+        const uint32_t page_pos = offset - page->offset;
+        const size_t chunk = MIN(size, page->size - page_pos);
+        memcpy(dest, &page->data[page_pos], chunk);
+
+        dest += chunk;
+        offset += chunk;
+        size -= chunk;
+    }
+
+    return true;
+}
+
+static bool nfc_emv_index_source_matches(
+    NfcEmvIndex* instance,
+    const char* source_path,
+    const NfcEmvIndexHeader* header) {
+    File* file = storage_file_alloc(instance->storage);
+
+    bool matches = false;
+    if(storage_file_open(file, source_path, FSAM_READ, FSOM_OPEN_EXISTING)) {
+        matches = storage_file_size(file) == header->source_size &&
+                  crc32_calc_file(file, NULL, NULL) == header->source_crc;
+        storage_file_close(file);
+    }
+
+    storage_file_free(file);
+    return matches;
+}
+
+bool nfc_emv_index_open(NfcEmvIndex* instance, const char* index_path, const char* source_path) {
+    furi_assert(instance);
+    furi_assert(index_path);
+    furi_assert(source_path);
+
+    nfc_emv_index_close(instance);
+
+    bool success = false;
+    do {
+        if(!storage_file_open(instance->file, index_path, FSAM_READ, FSOM_OPEN_EXISTING)) break;
+        instance->is_open = true;
+        instance->file_size = storage_file_size(instance->file);
+
+        NfcEmvIndexHeader header = {};
+        if(!nfc_emv_index_read(instance, 0, &header, sizeof(header))) break;
+        if(header.magic != NFC_EMV_INDEX_MAGIC) break;
+        if(header.version != NFC_EMV_INDEX_VERSION) break;
+        if(header.key_size == 0) break;
+        if(!nfc_emv_index_source_matches(instance, source_path, &header)) {
+            FURI_LOG_D(TAG, "%s is outdated", index_path);
+            break;
+        }
+
+        instance->key_size = header.key_size;
+        instance->record_count = header.record_count;
+        instance->record_size = 1 + header.key_size + NFC_EMV_INDEX_NAME_OFFSET_SIZE;
+        instance->names_offset = sizeof(header) + header.record_count * instance->record_size;
+        if(instance->names_offset > instance->file_size) break;
+
+        success = true;
+    } while(false);
+
+    if(!success) nfc_emv_index_close(instance);
+
+    return success;
+}
+
+void nfc_emv_index_close(NfcEmvIndex* instance) {
+    furi_assert(instance);
+
+    if(instance->is_open) {
+        storage_file_close(instance->file);
+        instance->is_open = false;
+    }
+
+    for(size_t i = 0; i < NFC_EMV_INDEX_PAGE_NUM; i++) {
+        instance->page[i].valid = false;
+    }
+    instance->file_size = 0;
+    instance->record_count = 0;
+}
+
+size_t nfc_emv_index_get_record_count(const NfcEmvIndex* instance) {
+    furi_assert(instance);
+    return instance->record_count;
+}
+
+static bool
+    nfc_emv_index_read_name(NfcEmvIndex* instance, uint32_t name_offset, FuriString* name) {
+    const uint32_t offset = instance->names_offset + name_offset;
+
+    uint8_t name_len = 0;
+    if(!nfc_emv_index_read(instance, offset, &name_len, sizeof(name_len))) return false;
+
+    char buf[UINT8_MAX + 1];
+    if(!nfc_emv_index_read(instance, offset + sizeof(name_len), buf, name_len)) return false;
+    buf[name_len] = '\0';
+    furi_string_set_str(name, buf);
+
+    return true;
+}
+
+bool nfc_emv_index_get_record(
+    NfcEmvIndex* instance,
+    size_t index,
+    uint8_t* key,
+    size_t* key_len,
+    FuriString* name) {
+    furi_assert(instance);
+    furi_assert(key);
+    furi_assert(key_len);
+    furi_assert(name);
+
+    if(index >= instance->record_count) return false;
+
+    uint8_t record[1 + UINT8_MAX + NFC_EMV_INDEX_NAME_OFFSET_SIZE];
+    const uint32_t offset = sizeof(NfcEmvIndexHeader) + index * instance->record_size;
+    if(!nfc_emv_index_read(instance, offset, record, instance->record_size)) return false;
+
+    *key_len = MIN(record[0], instance->key_size);
+    memcpy(key, &record[1], *key_len);
+
+    uint32_t name_offset = 0;
+    memcpy(&name_offset, &record[1 + instance->key_size], sizeof(name_offset));
+
+    return nfc_emv_index_read_name(instance, name_offset, name);
+}
+
+bool nfc_emv_index_find(
+    NfcEmvIndex* instance,
+    const uint8_t* key,
+    size_t key_len,
+    FuriString* name) {
+    furi_assert(instance);
+    furi_assert(key);
+    furi_assert(name);
+
+    if(key_len > instance->key_size) return false;
+
+    // Records are sorted by the length byte followed by the zero padded key
+    uint8_t needle[1 + UINT8_MAX] = {};
+    needle[0] = key_len;
+    memcpy(&needle[1], key, key_len);
+    const size_t compare_size = 1 + instance->key_size;
+
+    uint8_t record[1 + UINT8_MAX + NFC_EMV_INDEX_NAME_OFFSET_SIZE];
+    size_t low = 0;
+    size_t high = instance->record_count;
+    bool found = false;
+
+    while(low < high) {
+        const size_t mid = low + (high - low) / 2;
+        const uint32_t offset = sizeof(NfcEmvIndexHeader) + mid * instance->record_size;
+        if(!nfc_emv_index_read(instance, offset, record, instance->record_size)) break;
+
+        const int cmp = memcmp(record, needle, compare_size);
+        if(cmp < 0) {
+            low = mid + 1;
+        } else if(cmp > 0) {
+            high = mid;
+        } else {
+            uint32_t name_offset = 0;
+            memcpy(&name_offset, &record[compare_size], sizeof(name_offset));
+            found = nfc_emv_index_read_name(instance, name_offset, name);
+            break;
+        }
+    }
+
+    return found;
+}
@@ -0,0 +1,107 @@
+/**
+ * @file nfc_emv_index.h
+ * @brief Binary index of EMV resource files.
+ *
+ * The index is compiled from a "Flipper EMV resources" file by scripts/emv_index.py
+ * and holds the same key-value pairs in a searchable form:
+ * - header: magic, version, key size, record count, size and CRC32 of the source
+ *   file;
+ * - records: key length, key bytes padded to the key size and name offset,
+ *   sorted by key length and key bytes;
+ * - names: each name is its length byte followed by the name bytes.
+ *
+ * Lookups use binary search over the records. The file is read through a small
+ * page cache, so a lookup touches only a few pages of the index.
+ */
+#pragma once
+
+#include <storage/storage.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief NfcEmvIndex opaque type definition.
+ */
+typedef struct NfcEmvIndex NfcEmvIndex;
+
+/**
+ * @brief Allocate an NfcEmvIndex instance.
+ *
+ * @param[in] storage pointer to the Storage instance.
+ * @return pointer to the allocated instance.
+ */
+NfcEmvIndex* nfc_emv_index_alloc(Storage* storage);
+
+/**
+ * @brief Delete an NfcEmvIndex instance, closing the index if it is open.
+ *
+ * @param[in,out] instance pointer to the instance to be deleted.
+ */
+void nfc_emv_index_free(NfcEmvIndex* instance);
+
+/**
+ * @brief Open an index file.
+ *
+ * The index is rejected if it is damaged or if size or CRC32 of the source file
+ * differ from the ones it was built from. The source file is read once to check
+ * it, keep the index open between lookups.
+ *
+ * @param[in,out] instance pointer to the instance.
+ * @param[in] index_path path to the index file.
+ * @param[in] source_path path to the resource file the index was built from.
+ * @return true if the index was opened, false otherwise.
+ */
+bool nfc_emv_index_open(NfcEmvIndex* instance, const char* index_path, const char* source_path);
+
+/**
+ * @brief Close the index file and drop the cached pages.
+ *
+ * @param[in,out] instance pointer to the instance.
+ */
+void nfc_emv_index_close(NfcEmvIndex* instance);
+
+/**
+ * @brief Get the number of records in the open index.
+ *
+ * @param[in] instance pointer to the instance.
+ * @return number of records.
+ */
+size_t nfc_emv_index_get_record_count(const NfcEmvIndex* instance);
+
+/**
+ * @brief Read a record of the open index by its position.
+ *
+ * @param[in,out] instance pointer to the instance.
+ * @param[in] index record position, less than the record count.
+ * @param[out] key pointer to the buffer for the key, at least 255 bytes long.
+ * @param[out] key_len pointer to the key length.
+ * @param[out] name pointer to the string for the name.
+ * @return true if the record was read, false otherwise.
+ */
+bool nfc_emv_index_get_record(
+    NfcEmvIndex* instance,
+    size_t index,
+    uint8_t* key,
+    size_t* key_len,
+    FuriString* name);
+
+/**
+ * @brief Find the name by key in the open index.
+ *
+ * @param[in,out] instance pointer to the instance.
+ * @param[in] key pointer to the key bytes.
+ * @param[in] key_len key length.
+ * @param[out] name pointer to the string for the name.
+ * @return true if the key was found, false otherwise.
+ */
+bool nfc_emv_index_find(
+    NfcEmvIndex* instance,
+    const uint8_t* key,
+    size_t key_len,
+    FuriString* name);
+
+#ifdef __cplusplus
+}
+#endif
@@ -1,6 +1,11 @@
 #include "nfc_emv_parser.h"
+#include "nfc_emv_index.h"
 #include <flipper_format/flipper_format.h>
 
+#define NFC_EMV_PARSER_AID_PATH EXT_PATH("nfc/assets/aid")
+#define NFC_EMV_PARSER_COUNTRY_CODE_PATH EXT_PATH("nfc/assets/country_code")
+#define NFC_EMV_PARSER_CURRENCY_CODE_PATH EXT_PATH("nfc/assets/currency_code")
+
 static const char* nfc_resources_header = "Flipper EMV resources";
 static const uint32_t nfc_resources_file_version = 1;
 
@@ -32,51 +37,124 @@ static bool nfc_emv_parser_search_data(
     return parsed;
 }
 
-bool nfc_emv_parser_get_aid_name(
-    Storage* storage,
-    uint8_t* aid,
-    uint8_t aid_len,
-    FuriString* aid_name) {
+typedef enum {
+    NfcEmvParserResourceAid,
+    NfcEmvParserResourceCountryCode,
+    NfcEmvParserResourceCurrencyCode,
+
+    NfcEmvParserResourceNum,
+} NfcEmvParserResource;
+
+typedef enum {
+    NfcEmvParserIndexStateUnknown,
+    NfcEmvParserIndexStateOpen,
+    NfcEmvParserIndexStateInvalid,
+} NfcEmvParserIndexState;
+
+static const char* const nfc_emv_parser_resource_paths[NfcEmvParserResourceNum] = {
+    [NfcEmvParserResourceAid] = NFC_EMV_PARSER_AID_PATH,
+    [NfcEmvParserResourceCountryCode] = NFC_EMV_PARSER_COUNTRY_CODE_PATH,
+    [NfcEmvParserResourceCurrencyCode] = NFC_EMV_PARSER_CURRENCY_CODE_PATH,
+};
+
+struct NfcEmvParser {
+    Storage* storage;
+    NfcEmvIndex* index[NfcEmvParserResourceNum];
+    NfcEmvParserIndexState index_state[NfcEmvParserResourceNum];
+};
+
+NfcEmvParser* nfc_emv_parser_alloc(Storage* storage) {
     furi_assert(storage);
-    bool parsed = false;
-    FuriString* key;
-    key = furi_string_alloc();
-    for(uint8_t i = 0; i < aid_len; i++) {
-        furi_string_cat_printf(key, "%02X", aid[i]);
+
+    NfcEmvParser* instance = malloc(sizeof(NfcEmvParser));
+    instance->storage = storage;
+    for(size_t i = 0; i < NfcEmvParserResourceNum; i++) {
+        instance->index[i] = nfc_emv_index_alloc(storage);
     }
-    if(nfc_emv_parser_search_data(storage, EXT_PATH("nfc/assets/aid.nfc"), key, aid_name)) {
-        parsed = true;
+
+    return instance;
+}
+
+void nfc_emv_parser_free(NfcEmvParser* instance) {
+    furi_assert(instance);
+
+    for(size_t i = 0; i < NfcEmvParserResourceNum; i++) {
+        nfc_emv_index_free(instance->index[i]);
     }
-    furi_string_free(key);
+    free(instance);
+}
+
+static bool nfc_emv_parser_open_index(NfcEmvParser* instance, NfcEmvParserResource resource) {
+    // Opening checks the source file CRC, so it is done once per parser
+    if(instance->index_state[resource] == NfcEmvParserIndexStateUnknown) {
+        const char* file_name = nfc_emv_parser_resource_paths[resource];
+        FuriString* index_path = furi_string_alloc_printf("%s.idx", file_name);
+        FuriString* source_path = furi_string_alloc_printf("%s.nfc", file_name);
+
+        const bool opened = nfc_emv_index_open(
+            instance->index[resource],
+            furi_string_get_cstr(index_path),
+            furi_string_get_cstr(source_path));
+        instance->index_state[resource] = opened ? NfcEmvParserIndexStateOpen :
+                                                   NfcEmvParserIndexStateInvalid;
+
+        furi_string_free(source_path);
+        furi_string_free(index_path);
+    }
+
+    return instance->index_state[resource] == NfcEmvParserIndexStateOpen;
+}
+
+static bool nfc_emv_parser_search(
+    NfcEmvParser* instance,
+    NfcEmvParserResource resource,
+    const uint8_t* key,
+    size_t key_len,
+    FuriString* data) {
+    // Index lookup is a binary search, text file is scanned from the start
+    if(nfc_emv_parser_open_index(instance, resource)) {
+        return nfc_emv_index_find(instance->index[resource], key, key_len, data);
+    }
+
+    FuriString* key_str = furi_string_alloc();
+    for(size_t i = 0; i < key_len; i++) {
+        furi_string_cat_printf(key_str, "%02X", key[i]);
+    }
+    FuriString* source_path =
+        furi_string_alloc_printf("%s.nfc", nfc_emv_parser_resource_paths[resource]);
+    const bool parsed = nfc_emv_parser_search_data(
+        instance->storage, furi_string_get_cstr(source_path), key_str, data);
+    furi_string_free(source_path);
+    furi_string_free(key_str);
+
     return parsed;
 }
 
+bool nfc_emv_parser_get_aid_name(
+    NfcEmvParser* instance,
+    const uint8_t* aid,
+    uint8_t aid_len,
+    FuriString* aid_name) {
+    furi_assert(instance);
+    return nfc_emv_parser_search(instance, NfcEmvParserResourceAid, aid, aid_len, aid_name);
+}
+
 bool nfc_emv_parser_get_country_name(
-    Storage* storage,
+    NfcEmvParser* instance,
     uint16_t country_code,
     FuriString* country_name) {
-    bool parsed = false;
-    FuriString* key;
-    key = furi_string_alloc_printf("%04X", country_code);
-    if(nfc_emv_parser_search_data(
-           storage, EXT_PATH("nfc/assets/country_code.nfc"), key, country_name)) {
-        parsed = true;
-    }
-    furi_string_free(key);
-    return parsed;
+    furi_assert(instance);
+    const uint8_t key[] = {country_code >> 8, country_code & 0xFF};
+    return nfc_emv_parser_search(
+        instance, NfcEmvParserResourceCountryCode, key, sizeof(key), country_name);
 }
 
 bool nfc_emv_parser_get_currency_name(
-    Storage* storage,
+    NfcEmvParser* instance,
     uint16_t currency_code,
     FuriString* currency_name) {
-    bool parsed = false;
-    FuriString* key;
-    key = furi_string_alloc_printf("%04X", currency_code);
-    if(nfc_emv_parser_search_data(
-           storage, EXT_PATH("nfc/assets/currency_code.nfc"), key, currency_name)) {
-        parsed = true;
-    }
-    furi_string_free(key);
-    return parsed;
+    furi_assert(instance);
+    const uint8_t key[] = {currency_code >> 8, currency_code & 0xFF};
+    return nfc_emv_parser_search(
+        instance, NfcEmvParserResourceCurrencyCode, key, sizeof(key), currency_name);
 }
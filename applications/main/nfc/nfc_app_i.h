@@ -52,6 +52,7 @@
 
 #include <nfc/nfc_device.h>
 #include <nfc/helpers/nfc_data_generator.h>
+#include <nfc/protocols/mf_classic/mf_classic_key_scheduler.h>
 #include <toolbox/keys_dict.h>
 
 #include <gui/modules/validators.h>
@@ -73,6 +74,8 @@
 
 #define NFC_APP_MF_CLASSIC_DICT_USER_PATH (NFC_APP_FOLDER "/assets/mf_classic_dict_user.nfc")
 #define NFC_APP_MF_CLASSIC_DICT_SYSTEM_PATH (NFC_APP_FOLDER "/assets/mf_classic_dict.nfc")
+#define NFC_APP_MF_CLASSIC_KEY_STATS_FOLDER (NFC_APP_FOLDER "/.cache")
+#define NFC_APP_MF_CLASSIC_KEY_STATS_PATH (NFC_APP_FOLDER "/.cache/mf_classic_key_stats.nfc")
 
 typedef enum {
     NfcRpcStateIdle,
@@ -81,6 +84,7 @@ typedef enum {
 
 typedef struct {
     KeysDict* dict;
+    MfClassicKeyScheduler* key_scheduler;
     uint8_t sectors_total;
     uint8_t sectors_read;
     uint8_t current_sector;
@@ -0,0 +1,121 @@
+#include <furi.h>
+#include <furi_hal_cortex.h>
+#include <storage/storage.h>
+#include <dialogs/dialogs.h>
+#include <flipper_format/flipper_format.h>
+
+#include "helpers/nfc_emv_parser.h"
+#include "helpers/nfc_emv_index.h"
+
+#define TAG "NfcEmvBench"
+
+#define NFC_EMV_BENCH_AID_INDEX_PATH EXT_PATH("nfc/assets/aid.idx")
+#define NFC_EMV_BENCH_AID_PATH EXT_PATH("nfc/assets/aid.nfc")
+
+typedef struct {
+    size_t lookups;
+    size_t mismatches;
+    uint64_t index_cycles;
+    uint64_t text_cycles;
+} NfcEmvBenchResult;
+
+// Index lookups take well under the 1 ms system tick, so they are timed with the CPU cycle
+// counter. It wraps in about a minute, far longer than a single lookup.
+static uint32_t nfc_emv_bench_get_cycles(void) {
+    return furi_hal_cortex_timer_get(0).start;
+}
+
+static uint32_t nfc_emv_bench_cycles_to_us(uint64_t cycles, size_t lookups) {
+    return cycles / furi_hal_cortex_instructions_per_microsecond() / MAX(lookups, 1U);
+}
+
+// Compares lookup of every AID through the parser and by a text file scan
+static bool nfc_emv_bench_run(Storage* storage, NfcEmvBenchResult* result) {
+    NfcEmvIndex* index = nfc_emv_index_alloc(storage);
+    NfcEmvParser* parser = nfc_emv_parser_alloc(storage);
+    FlipperFormat* file = flipper_format_file_alloc(storage);
+    FuriString* key_str = furi_string_alloc();
+    FuriString* index_name = furi_string_alloc();
+    FuriString* text_name = furi_string_alloc();
+
+    bool success = false;
+    do {
+        if(!nfc_emv_index_open(index, NFC_EMV_BENCH_AID_INDEX_PATH, NFC_EMV_BENCH_AID_PATH)) {
+            FURI_LOG_E(TAG, "AID index is missing or outdated");
+            break;
+        }
+
+        const size_t record_count = nfc_emv_index_get_record_count(index);
+        for(size_t i = 0; i < record_count; i++) {
+            uint8_t key[UINT8_MAX];
+            size_t key_len = 0;
+            if(!nfc_emv_index_get_record(index, i, key, &key_len, index_name)) break;
+
+            uint32_t start = nfc_emv_bench_get_cycles();
+            bool index_found = nfc_emv_parser_get_aid_name(parser, key, key_len, index_name);
+            result->index_cycles += nfc_emv_bench_get_cycles() - start;
+
+            // Text path as it was before the index: full open and key scan per lookup
+            furi_string_reset(key_str);
+            for(size_t j = 0; j < key_len; j++) {
+                furi_string_cat_printf(key_str, "%02X", key[j]);
+            }
+            start = nfc_emv_bench_get_cycles();
+            bool text_found =
+                flipper_format_file_open_existing(file, NFC_EMV_BENCH_AID_PATH) &&
+                flipper_format_read_string(file, furi_string_get_cstr(key_str), text_name);
+            flipper_format_file_close(file);
+            result->text_cycles += nfc_emv_bench_get_cycles() - start;
+
+            if(!index_found || !text_found || furi_string_cmp(index_name, text_name)) {
+                FURI_LOG_E(TAG, "Mismatch: %s", furi_string_get_cstr(key_str));
+                result->mismatches++;
+            }
+            result->lookups++;
+        }
+
+        success = true;
+    } while(false);
+
+    furi_string_free(text_name);
+    furi_string_free(index_name);
+    furi_string_free(key_str);
+    flipper_format_free(file);
+    nfc_emv_parser_free(parser);
+    nfc_emv_index_free(index);
+
+    return success;
+}
+
+int32_t nfc_emv_bench_app(void* p) {
+    UNUSED(p);
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    DialogsApp* dialogs = furi_record_open(RECORD_DIALOGS);
+    DialogMessage* message = dialog_message_alloc();
+    FuriString* text = furi_string_alloc();
+
+    NfcEmvBenchResult result = {};
+    if(nfc_emv_bench_run(storage, &result)) {
+        furi_string_printf(
+            text,
+            "Lookups: %zu\nMismatches: %zu\nIndex: %lu us\nText: %lu us",
+            result.lookups,
+            result.mismatches,
+            nfc_emv_bench_cycles_to_us(result.index_cycles, result.lookups),
+            nfc_emv_bench_cycles_to_us(result.text_cycles, result.lookups));
+    } else {
+        furi_string_set(text, "AID index is\nmissing or outdated");
+    }
+    FURI_LOG_I(TAG, "%s", furi_string_get_cstr(text));
+
+    dialog_message_set_header(message, "EMV AID lookup", 64, 0, AlignCenter, AlignTop);
+    dialog_message_set_text(message, furi_string_get_cstr(text), 64, 12, AlignCenter, AlignTop);
+    dialog_message_show(dialogs, message);
+
+    furi_string_free(text);
+    dialog_message_free(message);
+    furi_record_close(RECORD_DIALOGS);
+    furi_record_close(RECORD_STORAGE);
+
+    return 0;
+}
@@ -1,6 +1,7 @@
 #include "nfc_supported_card_plugin.h"
 
 #include <flipper_application/flipper_application.h>
+#include <inttypes.h>
 #include <nfc/protocols/mf_ultralight/mf_ultralight.h>
 
 #define TAG "AllInOne"
@@ -78,7 +79,7 @@ static bool all_in_one_parse(const NfcDevice* device, FuriString* parsed_data) {
 
         // Format string for rides count
         furi_string_printf(
-            parsed_data, "\e#All-In-One\nNumber: %lu\nRides left: %u", serial, ride_count);
+            parsed_data, "\e#All-In-One\nNumber: %" PRIu32 "\nRides left: %u", serial, ride_count);
 
         parsed = true;
     } while(false);
@@ -1,6 +1,7 @@
 #include "nfc_supported_card_plugin.h"
 
 #include <flipper_application/flipper_application.h>
+#include <inttypes.h>
 
 #include <nfc/nfc_device.h>
 #include <nfc/helpers/nfc_util.h>
@@ -95,7 +96,7 @@ static uint64_t get_pacs_bits(const uint8_t* block, uint8_t bitLength) {
     uint64_t swapped = 0;
     memcpy(&swapped, block, sizeof(uint64_t));
     swapped = __builtin_bswap64(swapped ^ sentinel);
-    FURI_LOG_D(TAG, "PACS: (%d) %016llx", bitLength, swapped);
+    FURI_LOG_D(TAG, "PACS: (%d) %016" PRIx64, bitLength, swapped);
     return swapped;
 }
 
@@ -123,7 +124,7 @@ static bool hid_parse(const NfcDevice* device, FuriString* parsed_data) {
         uint64_t credential = get_pacs_bits(credential_block, bitLength);
         if(credential == 0) break;
 
-        furi_string_printf(parsed_data, "\e#HID Card\n%dbit\n%llx", bitLength, credential);
+        furi_string_printf(parsed_data, "\e#HID Card\n%dbit\n%" PRIx64, bitLength, credential);
 
         parsed = true;
 
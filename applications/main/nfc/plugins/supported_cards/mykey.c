@@ -1,6 +1,7 @@
 #include "nfc_supported_card_plugin.h"
 
 #include <flipper_application/flipper_application.h>
+#include <inttypes.h>
 #include <machine/endian.h>
 #include <nfc/protocols/st25tb/st25tb.h>
 
@@ -84,7 +85,8 @@ static bool mykey_parse(const NfcDevice* device, FuriString* parsed_data) {
     }
 
     bool is_blank = mykey_is_blank(data);
-    furi_string_cat_printf(parsed_data, "Serial#: %08lX\n", (uint32_t)__bswap32(data->blocks[7]));
+    furi_string_cat_printf(
+        parsed_data, "Serial#: %08" PRIX32 "\n", (uint32_t)__bswap32(data->blocks[7]));
     furi_string_cat_printf(parsed_data, "Blank: %s\n", is_blank ? "yes" : "no");
     furi_string_cat_printf(parsed_data, "LockID: %s\n", mykey_has_lockid(data) ? "maybe" : "no");
 
@@ -7,6 +7,7 @@
 #include "nfc_supported_card_plugin.h"
 
 #include <flipper_application/flipper_application.h>
+#include <inttypes.h>
 #include <lib/nfc/protocols/mf_desfire/mf_desfire.h>
 
 static const MfDesfireApplicationId myki_app_id = {.data = {0x00, 0x11, 0xf2}};
@@ -77,7 +78,7 @@ static bool myki_parse(const NfcDevice* device, FuriString* parsed_data) {
 
         // Stylise card number according to the physical card
         char card_string[20];
-        snprintf(card_string, sizeof(card_string), "%llu", card_number);
+        snprintf(card_string, sizeof(card_string), PRIu64, card_number);
 
         // Digit count in each space-separated group
         static const uint8_t digit_count[] = {1, 5, 4, 4, 1};
@@ -31,6 +31,7 @@
 #include "nfc_supported_card_plugin.h"
 
 #include <flipper_application/flipper_application.h>
+#include <inttypes.h>
 #include <applications/services/locale/locale.h>
 #include <furi_hal_rtc.h>
 
@@ -170,7 +171,7 @@ static bool opal_parse(const NfcDevice* device, FuriString* parsed_data) {
 
         furi_string_printf(
             parsed_data,
-            "\e#Opal: $%s%ld.%02hu\n3085 22%02hhu %04hu %03hu%01hhu\n%s, %s\n",
+            "\e#Opal: $%s%" PRId32 ".%02hu\n3085 22%02hhu %04hu %03hu%01hhu\n%s, %s\n",
             sign,
             balance_dollars,
             balance_cents,
@@ -1,6 +1,7 @@
 #include "nfc_supported_card_plugin.h"
 
 #include <flipper_application/flipper_application.h>
+#include <inttypes.h>
 
 #include <nfc/nfc_device.h>
 #include <nfc/helpers/nfc_util.h>
@@ -84,7 +85,7 @@ static bool plantain_verify_type(Nfc* nfc, MfClassicType type) {
         if(!plantain_get_card_config(&cfg, type)) break;
 
         const uint8_t block_num = mf_classic_get_first_block_num_of_sector(cfg.data_sector);
-        FURI_LOG_D(TAG, "Verifying sector %lu", cfg.data_sector);
+        FURI_LOG_D(TAG, "Verifying sector %" PRIu32, cfg.data_sector);
 
         MfClassicKey key = {0};
         nfc_util_num2bytes(cfg.keys[cfg.data_sector].a, COUNT_OF(key.data), key.data);
@@ -191,7 +192,10 @@ static bool plantain_parse(const NfcDevice* device, FuriString* parsed_data) {
         }
 
         furi_string_printf(
-            parsed_data, "\e#Plantain\nN:%llu-\nBalance:%lu\n", card_number, balance);
+            parsed_data,
+            "\e#Plantain\nN:%" PRIu64 "-\nBalance:%" PRIu32 "\n",
+            card_number,
+            balance);
         parsed = true;
     } while(false);
 
@@ -1,6 +1,7 @@
 #include "nfc_supported_card_plugin.h"
 
 #include <flipper_application/flipper_application.h>
+#include <inttypes.h>
 
 #include <nfc/nfc_device.h>
 #include <nfc/helpers/nfc_util.h>
@@ -84,7 +85,7 @@ static bool troika_verify_type(Nfc* nfc, MfClassicType type) {
         if(!troika_get_card_config(&cfg, type)) break;
 
         const uint8_t block_num = mf_classic_get_first_block_num_of_sector(cfg.data_sector);
-        FURI_LOG_D(TAG, "Verifying sector %lu", cfg.data_sector);
+        FURI_LOG_D(TAG, "Verifying sector %" PRIu32, cfg.data_sector);
 
         MfClassicKey key = {0};
         nfc_util_num2bytes(cfg.keys[cfg.data_sector].a, COUNT_OF(key.data), key.data);
@@ -186,7 +187,8 @@ static bool troika_parse(const NfcDevice* device, FuriString* parsed_data) {
         number >>= 4;
         number |= (temp_ptr[0] & 0xf) << 28;
 
-        furi_string_printf(parsed_data, "\e#Troika\nNum: %lu\nBalance: %u RUR", number, balance);
+        furi_string_printf(
+            parsed_data, "\e#Troika\nNum: %" PRIu32 "\nBalance: %u RUR", number, balance);
         parsed = true;
     } while(false);
 
@@ -1,6 +1,7 @@
 #include "nfc_supported_card_plugin.h"
 
 #include <flipper_application/flipper_application.h>
+#include <inttypes.h>
 
 #include <nfc/nfc_device.h>
 #include <nfc/helpers/nfc_util.h>
@@ -156,7 +157,8 @@ static bool two_cities_parse(const NfcDevice* device, FuriString* parsed_data) {
 
         furi_string_printf(
             parsed_data,
-            "\e#Troika+Plantain\nPN: %llu-\nPB: %lu rur.\nTN: %lu\nTB: %u rur.\n",
+            "\e#Troika+Plantain\nPN: %" PRIu64 "-\nPB: %" PRIu32 " rur.\nTN: %" PRIu32
+            "\nTB: %u rur.\n",
             card_number,
             balance,
             troika_number,
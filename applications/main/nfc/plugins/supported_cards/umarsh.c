@@ -28,6 +28,7 @@
 
 #include "protocols/mf_classic/mf_classic.h"
 #include <flipper_application/flipper_application.h>
+#include <inttypes.h>
 
 #include <nfc/nfc_device.h>
 #include <nfc/helpers/nfc_util.h>
@@ -97,7 +98,8 @@ static bool umarsh_parse(const NfcDevice* device, FuriString* parsed_data) {
 
         furi_string_cat_printf(
             parsed_data,
-            "\e#Umarsh\nCard number: %lu\nRegion: %02u\nTerminal number: %lu\nRefill counter: %u\nBalance: %u.%02u RUR",
+            "\e#Umarsh\nCard number: %" PRIu32 "\nRegion: %02u\nTerminal number: %" PRIu32
+            "\nRefill counter: %u\nBalance: %u.%02u RUR",
             card_number,
             region_number,
             terminal_number,
@@ -22,6 +22,7 @@
 
 #include "protocols/mf_classic/mf_classic.h"
 #include <flipper_application/flipper_application.h>
+#include <inttypes.h>
 
 #include <nfc/nfc_device.h>
 #include <nfc/helpers/nfc_util.h>
@@ -161,8 +162,8 @@ static bool washcity_parse(const NfcDevice* device, FuriString* parsed_data) {
 
         furi_string_printf(
             parsed_data,
-            "\e#WashCity\nCard number: %0*llX\nBalance: %lu.%02u EUR",
-            uid_len * 2,
+            "\e#WashCity\nCard number: %0*" PRIX64 "\nBalance: %" PRIu32 ".%02u EUR",
+            (int)(uid_len * 2),
             card_number,
             balance_eur,
             balance_cents);
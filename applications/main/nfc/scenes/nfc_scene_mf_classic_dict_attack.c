@@ -37,16 +37,19 @@ NfcCommand nfc_dict_attack_worker_callback(NfcGenericEvent event, void* context)
             mfc_data,
             &instance->nfc_dict_context.sectors_read,
             &instance->nfc_dict_context.keys_found);
+        mf_classic_key_scheduler_start_sector(instance->nfc_dict_context.key_scheduler, mfc_data);
         view_dispatcher_send_custom_event(
             instance->view_dispatcher, NfcCustomEventDictAttackDataUpdate);
     } else if(mfc_event->type == MfClassicPollerEventTypeRequestKey) {
         MfClassicKey key = {};
-        if(keys_dict_get_next_key(
-               instance->nfc_dict_context.dict, key.data, sizeof(MfClassicKey))) {
+        MfClassicKeyScheduler* key_scheduler = instance->nfc_dict_context.key_scheduler;
+        if(mf_classic_key_scheduler_get_next_key(key_scheduler, &key)) {
             mfc_event->data->key_request_data.key = key;
             mfc_event->data->key_request_data.key_provided = true;
-            instance->nfc_dict_context.dict_keys_current++;
-            if(instance->nfc_dict_context.dict_keys_current % 10 == 0) {
+            size_t dict_keys_prev = instance->nfc_dict_context.dict_keys_current;
+            instance->nfc_dict_context.dict_keys_current =
+                mf_classic_key_scheduler_get_dict_keys_read(key_scheduler);
+            if(instance->nfc_dict_context.dict_keys_current / 10 != dict_keys_prev / 10) {
                 view_dispatcher_send_custom_event(
                     instance->view_dispatcher, NfcCustomEventDictAttackDataUpdate);
             }
@@ -61,7 +64,8 @@ NfcCommand nfc_dict_attack_worker_callback(NfcGenericEvent event, void* context)
         view_dispatcher_send_custom_event(
             instance->view_dispatcher, NfcCustomEventDictAttackDataUpdate);
     } else if(mfc_event->type == MfClassicPollerEventTypeNextSector) {
-        keys_dict_rewind(instance->nfc_dict_context.dict);
+        mf_classic_key_scheduler_start_sector(
+            instance->nfc_dict_context.key_scheduler, nfc_poller_get_data(instance->poller));
         instance->nfc_dict_context.dict_keys_current = 0;
         instance->nfc_dict_context.current_sector =
             mfc_event->data->next_sector_data.current_sector;
@@ -80,7 +84,8 @@ NfcCommand nfc_dict_attack_worker_callback(NfcGenericEvent event, void* context)
         view_dispatcher_send_custom_event(
             instance->view_dispatcher, NfcCustomEventDictAttackDataUpdate);
     } else if(mfc_event->type == MfClassicPollerEventTypeKeyAttackStop) {
-        keys_dict_rewind(instance->nfc_dict_context.dict);
+        mf_classic_key_scheduler_start_sector(
+            instance->nfc_dict_context.key_scheduler, nfc_poller_get_data(instance->poller));
         instance->nfc_dict_context.is_key_attack = false;
         instance->nfc_dict_context.dict_keys_current = 0;
         view_dispatcher_send_custom_event(
@@ -123,6 +128,7 @@ static void nfc_scene_mf_classic_dict_attack_update_view(NfcApp* instance) {
 static void nfc_scene_mf_classic_dict_attack_prepare_view(NfcApp* instance) {
     uint32_t state =
         scene_manager_get_scene_state(instance->scene_manager, NfcSceneMfClassicDictAttack);
+    KeysDict* dict = NULL;
     if(state == DictAttackStateUserDictInProgress) {
         do {
             if(!keys_dict_check_presence(NFC_APP_MF_CLASSIC_DICT_USER_PATH)) {
@@ -130,10 +136,10 @@ static void nfc_scene_mf_classic_dict_attack_prepare_view(NfcApp* instance) {
                 break;
             }
 
-            instance->nfc_dict_context.dict = keys_dict_alloc(
+            dict = keys_dict_alloc(
                 NFC_APP_MF_CLASSIC_DICT_USER_PATH, KeysDictModeOpenAlways, sizeof(MfClassicKey));
-            if(keys_dict_get_total_keys(instance->nfc_dict_context.dict) == 0) {
-                keys_dict_free(instance->nfc_dict_context.dict);
+            if(keys_dict_get_total_keys(dict) == 0) {
+                keys_dict_free(dict);
                 state = DictAttackStateSystemDictInProgress;
                 break;
             }
@@ -142,11 +148,17 @@ static void nfc_scene_mf_classic_dict_attack_prepare_view(NfcApp* instance) {
         } while(false);
     }
     if(state == DictAttackStateSystemDictInProgress) {
-        instance->nfc_dict_context.dict = keys_dict_alloc(
+        dict = keys_dict_alloc(
             NFC_APP_MF_CLASSIC_DICT_SYSTEM_PATH, KeysDictModeOpenExisting, sizeof(MfClassicKey));
         dict_attack_set_header(instance->dict_attack, "MF Classic System Dictionary");
     }
 
+    mf_classic_key_scheduler_set_dict(instance->nfc_dict_context.key_scheduler, dict);
+    if(instance->nfc_dict_context.dict) {
+        keys_dict_free(instance->nfc_dict_context.dict);
+    }
+    instance->nfc_dict_context.dict = dict;
+
     instance->nfc_dict_context.dict_keys_total =
         keys_dict_get_total_keys(instance->nfc_dict_context.dict);
     dict_attack_set_total_dict_keys(
@@ -165,6 +177,9 @@ void nfc_scene_mf_classic_dict_attack_on_enter(void* context) {
 
     scene_manager_set_scene_state(
         instance->scene_manager, NfcSceneMfClassicDictAttack, DictAttackStateUserDictInProgress);
+    instance->nfc_dict_context.key_scheduler = mf_classic_key_scheduler_alloc();
+    mf_classic_key_scheduler_load_stats(
+        instance->nfc_dict_context.key_scheduler, NFC_APP_MF_CLASSIC_KEY_STATS_PATH);
     nfc_scene_mf_classic_dict_attack_prepare_view(instance);
     dict_attack_set_card_state(instance->dict_attack, true);
     view_dispatcher_switch_to_view(instance->view_dispatcher, NfcViewDictAttack);
@@ -175,8 +190,33 @@ void nfc_scene_mf_classic_dict_attack_on_enter(void* context) {
     nfc_poller_start(instance->poller, nfc_dict_attack_worker_callback, instance);
 }
 
-static void nfc_scene_mf_classic_dict_attack_notify_read(NfcApp* instance) {
+// Poller thread updates the card data and takes keys from the scheduler until it is stopped
+static void nfc_scene_mf_classic_dict_attack_stop_poller(NfcApp* instance) {
+    nfc_poller_stop(instance->poller);
     const MfClassicData* mfc_data = nfc_poller_get_data(instance->poller);
+    nfc_device_set_data(instance->nfc_device, NfcProtocolMfClassic, mfc_data);
+    nfc_poller_free(instance->poller);
+    instance->poller = NULL;
+}
+
+static void nfc_scene_mf_classic_dict_attack_start_system_dict(NfcApp* instance) {
+    scene_manager_set_scene_state(
+        instance->scene_manager, NfcSceneMfClassicDictAttack, DictAttackStateSystemDictInProgress);
+    nfc_scene_mf_classic_dict_attack_prepare_view(instance);
+    instance->poller = nfc_poller_alloc(instance->nfc, NfcProtocolMfClassic);
+    nfc_poller_start(instance->poller, nfc_dict_attack_worker_callback, instance);
+}
+
+static void nfc_scene_mf_classic_dict_attack_notify_read(NfcApp* instance) {
+    const MfClassicData* mfc_data =
+        nfc_device_get_data(instance->nfc_device, NfcProtocolMfClassic);
+
+    MfClassicKeyScheduler* key_scheduler = instance->nfc_dict_context.key_scheduler;
+    mf_classic_key_scheduler_add_card(key_scheduler, mfc_data);
+    if(storage_simply_mkdir(instance->storage, NFC_APP_MF_CLASSIC_KEY_STATS_FOLDER)) {
+        mf_classic_key_scheduler_save_stats(key_scheduler, NFC_APP_MF_CLASSIC_KEY_STATS_PATH);
+    }
+
     bool is_card_fully_read = mf_classic_is_card_read(mfc_data);
     if(is_card_fully_read) {
         notification_message(instance->notifications, &sequence_success);
@@ -193,24 +233,17 @@ bool nfc_scene_mf_classic_dict_attack_on_event(void* context, SceneManagerEvent
         scene_manager_get_scene_state(instance->scene_manager, NfcSceneMfClassicDictAttack);
     if(event.type == SceneManagerEventTypeCustom) {
         if(event.event == NfcCustomEventDictAttackComplete) {
+            nfc_scene_mf_classic_dict_attack_stop_poller(instance);
             if(state == DictAttackStateUserDictInProgress) {
-                nfc_poller_stop(instance->poller);
-                nfc_poller_free(instance->poller);
-                keys_dict_free(instance->nfc_dict_context.dict);
-                scene_manager_set_scene_state(
-                    instance->scene_manager,
-                    NfcSceneMfClassicDictAttack,
-                    DictAttackStateSystemDictInProgress);
-                nfc_scene_mf_classic_dict_attack_prepare_view(instance);
-                instance->poller = nfc_poller_alloc(instance->nfc, NfcProtocolMfClassic);
-                nfc_poller_start(instance->poller, nfc_dict_attack_worker_callback, instance);
-                consumed = true;
+                // Whole user dictionary was tried, its keys are not tried again
+                mf_classic_key_scheduler_finish_dict(instance->nfc_dict_context.key_scheduler);
+                nfc_scene_mf_classic_dict_attack_start_system_dict(instance);
             } else {
                 nfc_scene_mf_classic_dict_attack_notify_read(instance);
                 scene_manager_next_scene(instance->scene_manager, NfcSceneReadSuccess);
                 dolphin_deed(DolphinDeedNfcReadSuccess);
-                consumed = true;
             }
+            consumed = true;
         } else if(event.event == NfcCustomEventCardDetected) {
             dict_attack_set_card_state(instance->dict_attack, true);
             consumed = true;
@@ -220,32 +253,17 @@ bool nfc_scene_mf_classic_dict_attack_on_event(void* context, SceneManagerEvent
         } else if(event.event == NfcCustomEventDictAttackDataUpdate) {
             nfc_scene_mf_classic_dict_attack_update_view(instance);
         } else if(event.event == NfcCustomEventDictAttackSkip) {
-            const MfClassicData* mfc_data = nfc_poller_get_data(instance->poller);
-            nfc_device_set_data(instance->nfc_device, NfcProtocolMfClassic, mfc_data);
-            if(state == DictAttackStateUserDictInProgress) {
-                if(instance->nfc_dict_context.is_card_present) {
-                    nfc_poller_stop(instance->poller);
-                    nfc_poller_free(instance->poller);
-                    keys_dict_free(instance->nfc_dict_context.dict);
-                    scene_manager_set_scene_state(
-                        instance->scene_manager,
-                        NfcSceneMfClassicDictAttack,
-                        DictAttackStateSystemDictInProgress);
-                    nfc_scene_mf_classic_dict_attack_prepare_view(instance);
-                    instance->poller = nfc_poller_alloc(instance->nfc, NfcProtocolMfClassic);
-                    nfc_poller_start(instance->poller, nfc_dict_attack_worker_callback, instance);
-                } else {
-                    nfc_scene_mf_classic_dict_attack_notify_read(instance);
-                    scene_manager_next_scene(instance->scene_manager, NfcSceneReadSuccess);
-                    dolphin_deed(DolphinDeedNfcReadSuccess);
-                }
-                consumed = true;
-            } else if(state == DictAttackStateSystemDictInProgress) {
+            nfc_scene_mf_classic_dict_attack_stop_poller(instance);
+            if(state == DictAttackStateUserDictInProgress &&
+               instance->nfc_dict_context.is_card_present) {
+                // Skipped keys were not tried on every sector, the system dictionary tries them
+                nfc_scene_mf_classic_dict_attack_start_system_dict(instance);
+            } else {
                 nfc_scene_mf_classic_dict_attack_notify_read(instance);
                 scene_manager_next_scene(instance->scene_manager, NfcSceneReadSuccess);
                 dolphin_deed(DolphinDeedNfcReadSuccess);
-                consumed = true;
             }
+            consumed = true;
         }
     } else if(event.type == SceneManagerEventTypeBack) {
         scene_manager_next_scene(instance->scene_manager, NfcSceneExitConfirm);
@@ -257,14 +275,20 @@ bool nfc_scene_mf_classic_dict_attack_on_event(void* context, SceneManagerEvent
 void nfc_scene_mf_classic_dict_attack_on_exit(void* context) {
     NfcApp* instance = context;
 
-    nfc_poller_stop(instance->poller);
-    nfc_poller_free(instance->poller);
+    if(instance->poller) {
+        nfc_poller_stop(instance->poller);
+        nfc_poller_free(instance->poller);
+        instance->poller = NULL;
+    }
 
     dict_attack_reset(instance->dict_attack);
     scene_manager_set_scene_state(
         instance->scene_manager, NfcSceneMfClassicDictAttack, DictAttackStateUserDictInProgress);
 
     keys_dict_free(instance->nfc_dict_context.dict);
+    instance->nfc_dict_context.dict = NULL;
+    mf_classic_key_scheduler_free(instance->nfc_dict_context.key_scheduler);
+    instance->nfc_dict_context.key_scheduler = NULL;
 
     instance->nfc_dict_context.current_sector = 0;
     instance->nfc_dict_context.sectors_total = 0;
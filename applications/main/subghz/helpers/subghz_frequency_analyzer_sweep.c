@@ -0,0 +1,311 @@
+#include "subghz_frequency_analyzer_sweep.h"
+
+#include <inttypes.h>
+
+#define TAG "SubGhzFrequencyAnalyzerSweep"
+
+#define SUBGHZ_FREQUENCY_ANALYZER_SWEEP_RSSI_NONE (-127.0f)
+// Time for RSSI to settle after Rx start
+#define SUBGHZ_FREQUENCY_ANALYZER_SWEEP_DWELL_MS (2)
+// Extra samples on frequencies that may carry an OOK signal caught in a gap
+#define SUBGHZ_FREQUENCY_ANALYZER_SWEEP_EXTRA_DWELL_MS (1)
+#define SUBGHZ_FREQUENCY_ANALYZER_SWEEP_EXTRA_SAMPLES (2)
+#define SUBGHZ_FREQUENCY_ANALYZER_SWEEP_NEAR_MARGIN (6.0f)
+// Signal this far above threshold ends coarse scan of hot frequencies out of its filter band
+#define SUBGHZ_FREQUENCY_ANALYZER_SWEEP_STRONG_MARGIN (10.0f)
+#define SUBGHZ_FREQUENCY_ANALYZER_SWEEP_NEIGHBOR_SPAN (650000)
+// A hit keeps frequency hot for HEAT_HIT / HEAT_DECAY passes
+#define SUBGHZ_FREQUENCY_ANALYZER_SWEEP_HEAT_HIT (64)
+#define SUBGHZ_FREQUENCY_ANALYZER_SWEEP_HEAT_DECAY (1)
+// Fine scan: medium filter steps over the coarse filter band, then narrow filter steps
+// around the best one. Narrow filter alone would need 30 steps.
+#define SUBGHZ_FREQUENCY_ANALYZER_SWEEP_MEDIUM_SPAN (300000)
+#define SUBGHZ_FREQUENCY_ANALYZER_SWEEP_MEDIUM_STEP (150000)
+#define SUBGHZ_FREQUENCY_ANALYZER_SWEEP_FINE_SPAN (80000)
+#define SUBGHZ_FREQUENCY_ANALYZER_SWEEP_FINE_STEP (20000)
+// Around fine frequency of the previous pass
+#define SUBGHZ_FREQUENCY_ANALYZER_SWEEP_NARROW_SPAN (40000)
+#define SUBGHZ_FREQUENCY_ANALYZER_SWEEP_NARROW_STEP (20000)
+
+struct SubGhzFrequencyAnalyzerSweep {
+    const SubGhzFrequencyAnalyzerRadio* radio;
+    void* context;
+
+    SubGhzFrequencyAnalyzerSweepStats* stats;
+    uint16_t* order;
+    size_t count;
+};
+
+SubGhzFrequencyAnalyzerSweep* subghz_frequency_analyzer_sweep_alloc(
+    const SubGhzFrequencyAnalyzerRadio* radio,
+    void* context,
+    const uint32_t* frequencies,
+    size_t count) {
+    furi_assert(radio);
+    furi_assert(count <= UINT16_MAX);
+    SubGhzFrequencyAnalyzerSweep* instance = malloc(sizeof(SubGhzFrequencyAnalyzerSweep));
+    instance->radio = radio;
+    instance->context = context;
+    instance->stats = malloc(sizeof(SubGhzFrequencyAnalyzerSweepStats) * MAX(count, 1U));
+    instance->order = malloc(sizeof(uint16_t) * MAX(count, 1U));
+    instance->count = 0;
+
+    for(size_t i = 0; i < count; i++) {
+        if(radio->is_frequency_valid(context, frequencies[i])) {
+            instance->stats[instance->count++].frequency = frequencies[i];
+        }
+    }
+    subghz_frequency_analyzer_sweep_reset(instance);
+
+    return instance;
+}
+
+void subghz_frequency_analyzer_sweep_free(SubGhzFrequencyAnalyzerSweep* instance) {
+    furi_assert(instance);
+    free(instance->order);
+    free(instance->stats);
+    free(instance);
+}
+
+void subghz_frequency_analyzer_sweep_reset(SubGhzFrequencyAnalyzerSweep* instance) {
+    furi_assert(instance);
+    for(size_t i = 0; i < instance->count; i++) {
+        SubGhzFrequencyAnalyzerSweepStats* stats = &instance->stats[i];
+        stats->frequency_fine = 0;
+        stats->rssi_last = SUBGHZ_FREQUENCY_ANALYZER_SWEEP_RSSI_NONE;
+        stats->rssi_max = SUBGHZ_FREQUENCY_ANALYZER_SWEEP_RSSI_NONE;
+        stats->hits = 0;
+        stats->heat = 0;
+        instance->order[i] = i;
+    }
+}
+
+static float subghz_frequency_analyzer_sweep_sample(
+    SubGhzFrequencyAnalyzerSweep* instance,
+    uint32_t frequency,
+    uint32_t* real_frequency,
+    bool hot) {
+    const SubGhzFrequencyAnalyzerRadio* radio = instance->radio;
+
+    *real_frequency = radio->tune(instance->context, frequency);
+    radio->delay_ms(instance->context, SUBGHZ_FREQUENCY_ANALYZER_SWEEP_DWELL_MS);
+    float rssi = radio->get_rssi(instance->context);
+
+    // Quiet frequencies are left after one sample, the rest are given a chance to be seen
+    if(hot ||
+       rssi > SUBGHZ_FREQUENCY_ANALYZER_THRESHOLD - SUBGHZ_FREQUENCY_ANALYZER_SWEEP_NEAR_MARGIN) {
+        for(size_t i = 0; (i < SUBGHZ_FREQUENCY_ANALYZER_SWEEP_EXTRA_SAMPLES) &&
+                          (rssi <= SUBGHZ_FREQUENCY_ANALYZER_THRESHOLD);
+            i++) {
+            radio->delay_ms(instance->context, SUBGHZ_FREQUENCY_ANALYZER_SWEEP_EXTRA_DWELL_MS);
+            float sample = radio->get_rssi(instance->context);
+            if(sample > rssi) rssi = sample;
+        }
+    }
+
+    return rssi;
+}
+
+static bool subghz_frequency_analyzer_sweep_is_hotter(
+    const SubGhzFrequencyAnalyzerSweepStats* a,
+    const SubGhzFrequencyAnalyzerSweepStats* b) {
+    return (a->heat > b->heat) || ((a->heat == b->heat) && (a->hits > b->hits));
+}
+
+// Hot frequencies first, the rest keep setting order. Order barely changes between
+// passes, so insertion sort is close to linear.
+static void subghz_frequency_analyzer_sweep_sort(SubGhzFrequencyAnalyzerSweep* instance) {
+    for(size_t i = 1; i < instance->count; i++) {
+        uint16_t index = instance->order[i];
+        uint8_t heat = instance->stats[index].heat;
+        size_t j = i;
+        while(j > 0) {
+            uint16_t prev = instance->order[j - 1];
+            uint8_t prev_heat = instance->stats[prev].heat;
+            if((prev_heat > heat) || ((prev_heat == heat) && (prev < index))) break;
+            instance->order[j] = prev;
+            j--;
+        }
+        instance->order[j] = index;
+    }
+}
+
+// Scan center - span ... center + span, returns requested frequency with the best RSSI
+static uint32_t subghz_frequency_analyzer_sweep_scan(
+    SubGhzFrequencyAnalyzerSweep* instance,
+    uint32_t center,
+    uint32_t span,
+    uint32_t step,
+    float* rssi_best,
+    uint32_t* frequency_best) {
+    uint32_t best = center;
+    uint32_t real_frequency = 0;
+
+    for(uint32_t frequency = center - span; frequency <= center + span; frequency += step) {
+        if(!instance->radio->is_frequency_valid(instance->context, frequency)) continue;
+
+        float rssi =
+            subghz_frequency_analyzer_sweep_sample(instance, frequency, &real_frequency, true);
+        FURI_LOG_T(TAG, "#:%" PRIu32 ":%f", real_frequency, (double)rssi);
+
+        if(*rssi_best < rssi) {
+            *rssi_best = rssi;
+            *frequency_best = real_frequency;
+            best = frequency;
+        }
+    }
+
+    return best;
+}
+
+void subghz_frequency_analyzer_sweep_run(
+    SubGhzFrequencyAnalyzerSweep* instance,
+    FrequencyRSSI* result) {
+    furi_assert(instance);
+    furi_assert(result);
+
+    result->frequency_coarse = 0;
+    result->rssi_coarse = SUBGHZ_FREQUENCY_ANALYZER_SWEEP_RSSI_NONE;
+    result->frequency_fine = 0;
+    result->rssi_fine = SUBGHZ_FREQUENCY_ANALYZER_SWEEP_RSSI_NONE;
+    if(!instance->count) return;
+
+    for(size_t i = 0; i < instance->count; i++) {
+        SubGhzFrequencyAnalyzerSweepStats* stats = &instance->stats[i];
+        stats->heat = stats->heat > SUBGHZ_FREQUENCY_ANALYZER_SWEEP_HEAT_DECAY ?
+                          stats->heat - SUBGHZ_FREQUENCY_ANALYZER_SWEEP_HEAT_DECAY :
+                          0;
+    }
+    subghz_frequency_analyzer_sweep_sort(instance);
+
+    // First stage: coarse scan
+    instance->radio->set_filter(instance->context, SubGhzFrequencyAnalyzerFilterWide);
+    SubGhzFrequencyAnalyzerSweepStats* best = NULL;
+    bool strong = false;
+    uint32_t frequency = 0;
+    size_t visited = 0;
+    for(size_t i = 0; i < instance->count; i++) {
+        SubGhzFrequencyAnalyzerSweepStats* stats = &instance->stats[instance->order[i]];
+        // Hot frequencies out of a strong signal filter band are left for the next pass.
+        // Cold ones are always scanned, a new transmitter may show up on any of them.
+        const bool hot = stats->heat > 0;
+        if(hot && strong &&
+           (stats->frequency > best->frequency ? stats->frequency - best->frequency :
+                                                 best->frequency - stats->frequency) >
+               SUBGHZ_FREQUENCY_ANALYZER_SWEEP_NEIGHBOR_SPAN) {
+            continue;
+        }
+
+        float rssi =
+            subghz_frequency_analyzer_sweep_sample(instance, stats->frequency, &frequency, hot);
+        visited++;
+
+        stats->rssi_last = rssi;
+        if(stats->rssi_max < rssi) stats->rssi_max = rssi;
+        if(rssi > SUBGHZ_FREQUENCY_ANALYZER_THRESHOLD) {
+            if(stats->hits < UINT16_MAX) stats->hits++;
+            stats->heat = MIN(stats->heat + SUBGHZ_FREQUENCY_ANALYZER_SWEEP_HEAT_HIT, UINT8_MAX);
+        }
+
+        if(result->rssi_coarse < rssi) {
+            result->rssi_coarse = rssi;
+            result->frequency_coarse = frequency;
+            best = stats;
+            strong = rssi > SUBGHZ_FREQUENCY_ANALYZER_THRESHOLD +
+                                SUBGHZ_FREQUENCY_ANALYZER_SWEEP_STRONG_MARGIN;
+        }
+    }
+
+    FURI_LOG_T(
+        TAG,
+        "RSSI: max %f at %" PRIu32 ", %zu of %zu visited",
+        (double)result->rssi_coarse,
+        result->frequency_coarse,
+        visited,
+        instance->count);
+
+    // Second stage: fine scan
+    if(result->rssi_coarse > SUBGHZ_FREQUENCY_ANALYZER_THRESHOLD) {
+        // Transmitters rarely move, look where the signal was last time first
+        if(best->frequency_fine) {
+            instance->radio->set_filter(instance->context, SubGhzFrequencyAnalyzerFilterNarrow);
+            subghz_frequency_analyzer_sweep_scan(
+                instance,
+                best->frequency_fine,
+                SUBGHZ_FREQUENCY_ANALYZER_SWEEP_NARROW_SPAN,
+                SUBGHZ_FREQUENCY_ANALYZER_SWEEP_NARROW_STEP,
+                &result->rssi_fine,
+                &result->frequency_fine);
+        }
+
+        // Medium filter finds the part of coarse band with the signal, narrow one its peak
+        if(result->rssi_fine <= SUBGHZ_FREQUENCY_ANALYZER_THRESHOLD) {
+            float rssi = SUBGHZ_FREQUENCY_ANALYZER_SWEEP_RSSI_NONE;
+            instance->radio->set_filter(instance->context, SubGhzFrequencyAnalyzerFilterMedium);
+            uint32_t center = subghz_frequency_analyzer_sweep_scan(
+                instance,
+                best->frequency,
+                SUBGHZ_FREQUENCY_ANALYZER_SWEEP_MEDIUM_SPAN,
+                SUBGHZ_FREQUENCY_ANALYZER_SWEEP_MEDIUM_STEP,
+                &rssi,
+                &frequency);
+
+            instance->radio->set_filter(instance->context, SubGhzFrequencyAnalyzerFilterNarrow);
+            subghz_frequency_analyzer_sweep_scan(
+                instance,
+                center,
+                SUBGHZ_FREQUENCY_ANALYZER_SWEEP_FINE_SPAN,
+                SUBGHZ_FREQUENCY_ANALYZER_SWEEP_FINE_STEP,
+                &result->rssi_fine,
+                &result->frequency_fine);
+        }
+
+        best->frequency_fine =
+            result->rssi_fine > SUBGHZ_FREQUENCY_ANALYZER_THRESHOLD ? result->frequency_fine : 0;
+    }
+}
+
+size_t subghz_frequency_analyzer_sweep_get_count(SubGhzFrequencyAnalyzerSweep* instance) {
+    furi_assert(instance);
+    return instance->count;
+}
+
+const SubGhzFrequencyAnalyzerSweepStats* subghz_frequency_analyzer_sweep_get_stats(
+    SubGhzFrequencyAnalyzerSweep* instance,
+    size_t index) {
+    furi_assert(instance);
+    furi_check(index < instance->count);
+    return &instance->stats[index];
+}
+
+size_t subghz_frequency_analyzer_sweep_get_hot(
+    SubGhzFrequencyAnalyzerSweep* instance,
+    SubGhzFrequencyAnalyzerSweepStats* stats,
+    size_t count) {
+    furi_assert(instance);
+    furi_assert(stats);
+    size_t copied = 0;
+    if(!count) return 0;
+
+    for(size_t i = 0; i < instance->count; i++) {
+        const SubGhzFrequencyAnalyzerSweepStats* item = &instance->stats[i];
+        if(!item->hits) continue;
+
+        size_t j = copied;
+        if(copied < count) {
+            copied++;
+        } else if(subghz_frequency_analyzer_sweep_is_hotter(item, &stats[count - 1])) {
+            j = count - 1;
+        } else {
+            continue;
+        }
+
+        while(j > 0 && subghz_frequency_analyzer_sweep_is_hotter(item, &stats[j - 1])) {
+            stats[j] = stats[j - 1];
+            j--;
+        }
+        stats[j] = *item;
+    }
+
+    return copied;
+}
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <furi.h>
+
+#define SUBGHZ_FREQUENCY_ANALYZER_THRESHOLD -93.0f
+
+typedef struct {
+    uint32_t frequency_coarse;
+    float rssi_coarse;
+    uint32_t frequency_fine;
+    float rssi_fine;
+} FrequencyRSSI;
+
+typedef enum {
+    SubGhzFrequencyAnalyzerFilterWide, /**< 650 kHz Rx filter, coarse pass */
+    SubGhzFrequencyAnalyzerFilterMedium, /**< 203 kHz Rx filter, locates signal for fine pass */
+    SubGhzFrequencyAnalyzerFilterNarrow, /**< 58 kHz Rx filter, fine pass */
+} SubGhzFrequencyAnalyzerFilter;
+
+/** Radio used by the sweep, real CC1101 on device or a simulated RSSI source on host */
+typedef struct {
+    /** Select Rx filter, radio may be left idle */
+    void (*set_filter)(void* context, SubGhzFrequencyAnalyzerFilter filter);
+    /** Tune to frequency and start Rx, returns real frequency */
+    uint32_t (*tune)(void* context, uint32_t frequency);
+    /** Check that radio can tune to frequency */
+    bool (*is_frequency_valid)(void* context, uint32_t frequency);
+    /** Current RSSI in dBm */
+    float (*get_rssi)(void* context);
+    /** Wait for RSSI to settle */
+    void (*delay_ms)(void* context, uint32_t ms);
+} SubGhzFrequencyAnalyzerRadio;
+
+/** Statistics of one coarse frequency */
+typedef struct {
+    uint32_t frequency; /**< Coarse frequency */
+    uint32_t frequency_fine; /**< Last fine frequency found around it, 0 if none */
+    float rssi_last; /**< RSSI of the last visit */
+    float rssi_max; /**< Highest RSSI seen */
+    uint16_t hits; /**< Visits above threshold */
+    uint8_t heat; /**< Recent activity, hot frequencies are visited first */
+} SubGhzFrequencyAnalyzerSweepStats;
+
+typedef struct SubGhzFrequencyAnalyzerSweep SubGhzFrequencyAnalyzerSweep;
+
+/** Allocate SubGhzFrequencyAnalyzerSweep
+ *
+ * @param radio Radio interface, must outlive the sweep
+ * @param context Radio context
+ * @param frequencies Coarse frequencies, invalid ones are skipped
+ * @param count Number of frequencies
+ * @return SubGhzFrequencyAnalyzerSweep*
+ */
+SubGhzFrequencyAnalyzerSweep* subghz_frequency_analyzer_sweep_alloc(
+    const SubGhzFrequencyAnalyzerRadio* radio,
+    void* context,
+    const uint32_t* frequencies,
+    size_t count);
+
+/** Free SubGhzFrequencyAnalyzerSweep
+ *
+ * @param instance Pointer to a SubGhzFrequencyAnalyzerSweep
+ */
+void subghz_frequency_analyzer_sweep_free(SubGhzFrequencyAnalyzerSweep* instance);
+
+/** Forget collected statistics
+ *
+ * @param instance Pointer to a SubGhzFrequencyAnalyzerSweep
+ */
+void subghz_frequency_analyzer_sweep_reset(SubGhzFrequencyAnalyzerSweep* instance);
+
+/** Run one pass: coarse scan, hot frequencies first, then fine scan around the best one
+ *
+ * After a strong signal coarse scan skips recently active frequencies out of its filter
+ * band, the rest are always scanned. Frequencies close to threshold or recently active
+ * get extra RSSI samples to catch gaps of OOK signals. Fine scan starts where the signal
+ * was found last time.
+ *
+ * @param instance Pointer to a SubGhzFrequencyAnalyzerSweep
+ * @param result Best coarse and fine frequency of the pass, RSSI is -127 if not scanned
+ */
+void subghz_frequency_analyzer_sweep_run(
+    SubGhzFrequencyAnalyzerSweep* instance,
+    FrequencyRSSI* result);
+
+/** Get number of coarse frequencies
+ *
+ * @param instance Pointer to a SubGhzFrequencyAnalyzerSweep
+ * @return size_t
+ */
+size_t subghz_frequency_analyzer_sweep_get_count(SubGhzFrequencyAnalyzerSweep* instance);
+
+/** Get statistics of coarse frequency
+ *
+ * @param instance Pointer to a SubGhzFrequencyAnalyzerSweep
+ * @param index Index of coarse frequency
+ * @return const SubGhzFrequencyAnalyzerSweepStats*
+ */
+const SubGhzFrequencyAnalyzerSweepStats* subghz_frequency_analyzer_sweep_get_stats(
+    SubGhzFrequencyAnalyzerSweep* instance,
+    size_t index);
+
+/** Copy statistics of the most active frequencies, hottest first
+ *
+ * @param instance Pointer to a SubGhzFrequencyAnalyzerSweep
+ * @param stats Destination
+ * @param count Destination size
+ * @return size_t Number of frequencies copied, only ones that had hits
+ */
+size_t subghz_frequency_analyzer_sweep_get_hot(
+    SubGhzFrequencyAnalyzerSweep* instance,
+    SubGhzFrequencyAnalyzerSweepStats* stats,
+    size_t count);
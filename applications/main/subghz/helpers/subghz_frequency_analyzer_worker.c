@@ -12,6 +12,12 @@ static const uint8_t subghz_preset_ook_58khz[][2] = {
     {0, 0},
 };
 
+static const uint8_t subghz_preset_ook_203khz[][2] = {
+    {CC1101_MDMCFG4, 0b10000111}, // Rx BW filter is 203.125kHz
+    /* End  */
+    {0, 0},
+};
+
 static const uint8_t subghz_preset_ook_650khz[][2] = {
     {CC1101_MDMCFG4, 0b00010111}, // Rx BW filter is 650.000kHz
     /* End  */
@@ -25,6 +31,11 @@ struct SubGhzFrequencyAnalyzerWorker {
     uint8_t sample_hold_counter;
     FrequencyRSSI frequency_rssi_buf;
     SubGhzSetting* setting;
+    SubGhzFrequencyAnalyzerSweep* sweep;
+
+    FuriMutex* hot_mutex;
+    SubGhzFrequencyAnalyzerSweepStats hot[SUBGHZ_FREQUENCY_ANALYZER_WORKER_HOT_MAX];
+    size_t hot_count;
 
     float filVal;
 
@@ -58,6 +69,60 @@ static uint32_t subghz_frequency_analyzer_worker_expRunningAverageAdaptive(
     return (uint32_t)instance->filVal;
 }
 
+static void subghz_frequency_analyzer_worker_set_filter(
+    void* context,
+    SubGhzFrequencyAnalyzerFilter filter) {
+    UNUSED(context);
+    furi_hal_subghz_idle();
+    if(filter == SubGhzFrequencyAnalyzerFilterWide) {
+        subghz_frequency_analyzer_worker_load_registers(subghz_preset_ook_650khz);
+    } else if(filter == SubGhzFrequencyAnalyzerFilterMedium) {
+        subghz_frequency_analyzer_worker_load_registers(subghz_preset_ook_203khz);
+    } else {
+        subghz_frequency_analyzer_worker_load_registers(subghz_preset_ook_58khz);
+    }
+}
+
+static uint32_t subghz_frequency_analyzer_worker_tune(void* context, uint32_t frequency) {
+    UNUSED(context);
+    furi_hal_spi_acquire(&furi_hal_spi_bus_handle_subghz);
+    cc1101_switch_to_idle(&furi_hal_spi_bus_handle_subghz);
+    frequency = cc1101_set_frequency(&furi_hal_spi_bus_handle_subghz, frequency);
+
+    cc1101_calibrate(&furi_hal_spi_bus_handle_subghz);
+
+    furi_check(
+        cc1101_wait_status_state(&furi_hal_spi_bus_handle_subghz, CC1101StateIDLE, 10000));
+
+    cc1101_switch_to_rx(&furi_hal_spi_bus_handle_subghz);
+    furi_hal_spi_release(&furi_hal_spi_bus_handle_subghz);
+    return frequency;
+}
+
+static bool
+    subghz_frequency_analyzer_worker_is_frequency_valid(void* context, uint32_t frequency) {
+    UNUSED(context);
+    return furi_hal_subghz_is_frequency_valid(frequency);
+}
+
+static float subghz_frequency_analyzer_worker_get_rssi(void* context) {
+    UNUSED(context);
+    return furi_hal_subghz_get_rssi();
+}
+
+static void subghz_frequency_analyzer_worker_delay_ms(void* context, uint32_t ms) {
+    UNUSED(context);
+    furi_delay_ms(ms);
+}
+
+static const SubGhzFrequencyAnalyzerRadio subghz_frequency_analyzer_worker_radio = {
+    .set_filter = subghz_frequency_analyzer_worker_set_filter,
+    .tune = subghz_frequency_analyzer_worker_tune,
+    .is_frequency_valid = subghz_frequency_analyzer_worker_is_frequency_valid,
+    .get_rssi = subghz_frequency_analyzer_worker_get_rssi,
+    .delay_ms = subghz_frequency_analyzer_worker_delay_ms,
+};
+
 /** Worker thread
  * 
  * @param context 
@@ -68,8 +133,6 @@ static int32_t subghz_frequency_analyzer_worker_thread(void* context) {
 
     FrequencyRSSI frequency_rssi = {
         .frequency_coarse = 0, .rssi_coarse = 0, .frequency_fine = 0, .rssi_fine = 0};
-    float rssi = 0;
-    uint32_t frequency = 0;
     float rssi_temp = -127.0f;
     uint32_t frequency_temp = 0;
 
@@ -102,91 +165,12 @@ static int32_t subghz_frequency_analyzer_worker_thread(void* context) {
     while(instance->worker_running) {
         furi_delay_ms(10);
 
-        float rssi_min = 26.0f;
-        float rssi_avg = 0;
-        size_t rssi_avg_samples = 0;
-
-        frequency_rssi.rssi_coarse = -127.0f;
-        frequency_rssi.rssi_fine = -127.0f;
-        furi_hal_subghz_idle();
-        subghz_frequency_analyzer_worker_load_registers(subghz_preset_ook_650khz);
-
-        // First stage: coarse scan
-        for(size_t i = 0; i < subghz_setting_get_frequency_count(instance->setting); i++) {
-            if(furi_hal_subghz_is_frequency_valid(
-                   subghz_setting_get_frequency(instance->setting, i))) {
-                furi_hal_spi_acquire(&furi_hal_spi_bus_handle_subghz);
-                cc1101_switch_to_idle(&furi_hal_spi_bus_handle_subghz);
-                frequency = cc1101_set_frequency(
-                    &furi_hal_spi_bus_handle_subghz,
-                    subghz_setting_get_frequency(instance->setting, i));
-
-                cc1101_calibrate(&furi_hal_spi_bus_handle_subghz);
-
-                furi_check(cc1101_wait_status_state(
-                    &furi_hal_spi_bus_handle_subghz, CC1101StateIDLE, 10000));
+        subghz_frequency_analyzer_sweep_run(instance->sweep, &frequency_rssi);
 
-                cc1101_switch_to_rx(&furi_hal_spi_bus_handle_subghz);
-                furi_hal_spi_release(&furi_hal_spi_bus_handle_subghz);
-
-                furi_delay_ms(2);
-
-                rssi = furi_hal_subghz_get_rssi();
-
-                rssi_avg += rssi;
-                rssi_avg_samples++;
-
-                if(rssi < rssi_min) rssi_min = rssi;
-
-                if(frequency_rssi.rssi_coarse < rssi) {
-                    frequency_rssi.rssi_coarse = rssi;
-                    frequency_rssi.frequency_coarse = frequency;
-                }
-            }
-        }
-
-        FURI_LOG_T(
-            TAG,
-            "RSSI: avg %f, max %f at %lu, min %f",
-            (double)(rssi_avg / rssi_avg_samples),
-            (double)frequency_rssi.rssi_coarse,
-            frequency_rssi.frequency_coarse,
-            (double)rssi_min);
-
-        // Second stage: fine scan
-        if(frequency_rssi.rssi_coarse > SUBGHZ_FREQUENCY_ANALYZER_THRESHOLD) {
-            furi_hal_subghz_idle();
-            subghz_frequency_analyzer_worker_load_registers(subghz_preset_ook_58khz);
-            //for example -0.3 ... 433.92 ... +0.3 step 20KHz
-            for(uint32_t i = frequency_rssi.frequency_coarse - 300000;
-                i < frequency_rssi.frequency_coarse + 300000;
-                i += 20000) {
-                if(furi_hal_subghz_is_frequency_valid(i)) {
-                    furi_hal_spi_acquire(&furi_hal_spi_bus_handle_subghz);
-                    cc1101_switch_to_idle(&furi_hal_spi_bus_handle_subghz);
-                    frequency = cc1101_set_frequency(&furi_hal_spi_bus_handle_subghz, i);
-
-                    cc1101_calibrate(&furi_hal_spi_bus_handle_subghz);
-
-                    furi_check(cc1101_wait_status_state(
-                        &furi_hal_spi_bus_handle_subghz, CC1101StateIDLE, 10000));
-
-                    cc1101_switch_to_rx(&furi_hal_spi_bus_handle_subghz);
-                    furi_hal_spi_release(&furi_hal_spi_bus_handle_subghz);
-
-                    furi_delay_ms(2);
-
-                    rssi = furi_hal_subghz_get_rssi();
-
-                    FURI_LOG_T(TAG, "#:%lu:%f", frequency, (double)rssi);
-
-                    if(frequency_rssi.rssi_fine < rssi) {
-                        frequency_rssi.rssi_fine = rssi;
-                        frequency_rssi.frequency_fine = frequency;
-                    }
-                }
-            }
-        }
+        furi_mutex_acquire(instance->hot_mutex, FuriWaitForever);
+        instance->hot_count = subghz_frequency_analyzer_sweep_get_hot(
+            instance->sweep, instance->hot, SUBGHZ_FREQUENCY_ANALYZER_WORKER_HOT_MAX);
+        furi_mutex_release(instance->hot_mutex);
 
         // Deliver results fine
         if(frequency_rssi.rssi_fine > SUBGHZ_FREQUENCY_ANALYZER_THRESHOLD) {
@@ -261,6 +245,17 @@ SubGhzFrequencyAnalyzerWorker* subghz_frequency_analyzer_worker_alloc(void* cont
         "SubGhzFAWorker", 2048, subghz_frequency_analyzer_worker_thread, instance);
     SubGhz* subghz = context;
     instance->setting = subghz_txrx_get_setting(subghz->txrx);
+
+    size_t count = subghz_setting_get_frequency_count(instance->setting);
+    uint32_t* frequencies = malloc(sizeof(uint32_t) * MAX(count, 1U));
+    for(size_t i = 0; i < count; i++) {
+        frequencies[i] = subghz_setting_get_frequency(instance->setting, i);
+    }
+    instance->sweep = subghz_frequency_analyzer_sweep_alloc(
+        &subghz_frequency_analyzer_worker_radio, instance, frequencies, count);
+    free(frequencies);
+
+    instance->hot_mutex = furi_mutex_alloc(FuriMutexTypeNormal);
     return instance;
 }
 
@@ -268,6 +263,8 @@ void subghz_frequency_analyzer_worker_free(SubGhzFrequencyAnalyzerWorker* instan
     furi_assert(instance);
 
     furi_thread_free(instance->thread);
+    subghz_frequency_analyzer_sweep_free(instance->sweep);
+    furi_mutex_free(instance->hot_mutex);
     free(instance);
 }
 
@@ -303,3 +300,18 @@ bool subghz_frequency_analyzer_worker_is_running(SubGhzFrequencyAnalyzerWorker*
     furi_assert(instance);
     return instance->worker_running;
 }
+
+size_t subghz_frequency_analyzer_worker_get_hot(
+    SubGhzFrequencyAnalyzerWorker* instance,
+    SubGhzFrequencyAnalyzerSweepStats* stats,
+    size_t count) {
+    furi_assert(instance);
+    furi_assert(stats);
+
+    furi_mutex_acquire(instance->hot_mutex, FuriWaitForever);
+    count = MIN(count, instance->hot_count);
+    memcpy(stats, instance->hot, sizeof(SubGhzFrequencyAnalyzerSweepStats) * count);
+    furi_mutex_release(instance->hot_mutex);
+
+    return count;
+}
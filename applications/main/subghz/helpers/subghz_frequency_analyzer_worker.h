@@ -2,8 +2,9 @@
 
 #include <furi_hal.h>
 #include "../subghz_i.h"
+#include "subghz_frequency_analyzer_sweep.h"
 
-#define SUBGHZ_FREQUENCY_ANALYZER_THRESHOLD -93.0f
+#define SUBGHZ_FREQUENCY_ANALYZER_WORKER_HOT_MAX 3
 
 typedef struct SubGhzFrequencyAnalyzerWorker SubGhzFrequencyAnalyzerWorker;
 
@@ -13,13 +14,6 @@ typedef void (*SubGhzFrequencyAnalyzerWorkerPairCallback)(
     float rssi,
     bool signal);
 
-typedef struct {
-    uint32_t frequency_coarse;
-    float rssi_coarse;
-    uint32_t frequency_fine;
-    float rssi_fine;
-} FrequencyRSSI;
-
 /** Allocate SubGhzFrequencyAnalyzerWorker
  * 
  * @param context SubGhz* context
@@ -61,3 +55,15 @@ void subghz_frequency_analyzer_worker_stop(SubGhzFrequencyAnalyzerWorker* instan
  * @return bool - true if running
  */
 bool subghz_frequency_analyzer_worker_is_running(SubGhzFrequencyAnalyzerWorker* instance);
+
+/** Get statistics of the most active frequencies of the last pass
+ * 
+ * @param instance SubGhzFrequencyAnalyzerWorker instance
+ * @param stats Destination, hottest first
+ * @param count Destination size, up to SUBGHZ_FREQUENCY_ANALYZER_WORKER_HOT_MAX is kept
+ * @return size_t Number of frequencies copied
+ */
+size_t subghz_frequency_analyzer_worker_get_hot(
+    SubGhzFrequencyAnalyzerWorker* instance,
+    SubGhzFrequencyAnalyzerSweepStats* stats,
+    size_t count);
@@ -116,10 +116,15 @@ bool subghz_scene_save_name_on_event(void* context, SceneManagerEvent event) {
                             SubGhzSceneSetType,
                             SubGhzCustomEventManagerNoSet);
                     } else {
-                        subghz_save_protocol_to_file(
-                            subghz,
-                            subghz_history_get_raw_data(subghz->history, subghz->idx_menu_chosen),
-                            furi_string_get_cstr(subghz->file_path));
+                        FlipperFormat* raw_data = subghz_history_get_raw_data(
+                            subghz->history, subghz->idx_menu_chosen);
+                        if(raw_data) {
+                            subghz_save_protocol_to_file(
+                                subghz, raw_data, furi_string_get_cstr(subghz->file_path));
+                        } else {
+                            dialog_message_show_storage_error(
+                                subghz->dialogs, "Cannot read\nhistory");
+                        }
                     }
                 }
 
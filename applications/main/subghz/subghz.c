@@ -137,6 +137,7 @@ SubGhz* subghz_alloc() {
     subghz_unlock(subghz);
     subghz_rx_key_state_set(subghz, SubGhzRxKeyStateIDLE);
     subghz->history = subghz_history_alloc();
+    subghz_view_receiver_set_history(subghz->subghz_receiver, subghz->history);
     subghz->filter = SubGhzProtocolFlag_Decodable;
 
     //init TxRx & History & KeyBoard
@@ -1,18 +1,40 @@
 #include "subghz_history.h"
 #include <lib/subghz/receiver.h>
 #include <lib/subghz/protocols/came.h>
+#include <flipper_format/flipper_format_i.h>
+#include <toolbox/stream/file_stream.h>
+#include <toolbox/stream/string_stream.h>
+#include <storage/storage.h>
 
 #include <furi.h>
+#include <inttypes.h>
 
-#define SUBGHZ_HISTORY_MAX 50
+#define SUBGHZ_HISTORY_MAX 500
 #define SUBGHZ_HISTORY_FREE_HEAP 20480
+// Longest protocol name or "KL "/"SL " with manufacture, the rest of it is cut
+#define SUBGHZ_HISTORY_NAME_SIZE 24
+// Name, space and up to 64 bit key in hex
+#define SUBGHZ_HISTORY_TEXT_SIZE (SUBGHZ_HISTORY_NAME_SIZE + 1 + 16 + 1)
+#define SUBGHZ_HISTORY_QUEUE_SIZE 8
+#define SUBGHZ_HISTORY_HITS_MAX UINT16_MAX
+#define SUBGHZ_HISTORY_INDEX_NONE UINT16_MAX
+#define SUBGHZ_HISTORY_LOG_PATH EXT_PATH("subghz/.history")
+#define SUBGHZ_HISTORY_HASH_SEED (0x811C9DC5UL)
+#define SUBGHZ_HISTORY_HASH_PRIME (0x01000193UL)
 #define TAG "SubGhzHistory"
 
+/* Decodes are kept in RAM as fixed size records, full serialized data goes to the log:
+ * u32 size followed by FlipperFormat string, record keeps its offset.
+ */
 typedef struct {
-    FuriString* item_str;
-    FlipperFormat* flipper_string;
+    uint32_t hash; // Protocol name and key
+    uint32_t offset; // Serialized data in log
+    uint32_t frequency;
+    const char* protocol_name; // Owned by protocol registry
+    uint16_t hits;
     uint8_t type;
-    SubGhzRadioPreset* preset;
+    uint8_t preset;
+    char text[SUBGHZ_HISTORY_TEXT_SIZE];
 } SubGhzHistoryItem;
 
 ARRAY_DEF(SubGhzHistoryItemArray, SubGhzHistoryItem, M_POD_OPLIST)
@@ -20,193 +42,297 @@ ARRAY_DEF(SubGhzHistoryItemArray, SubGhzHistoryItem, M_POD_OPLIST)
 #define M_OPL_SubGhzHistoryItemArray_t() ARRAY_OPLIST(SubGhzHistoryItemArray, M_POD_OPLIST)
 
 typedef struct {
-    SubGhzHistoryItemArray_t data;
-} SubGhzHistoryStruct;
+    FuriString* name;
+    uint8_t* data;
+    size_t data_size;
+} SubGhzHistoryPreset;
+
+ARRAY_DEF(SubGhzHistoryPresetArray, SubGhzHistoryPreset, M_POD_OPLIST)
+
+#define M_OPL_SubGhzHistoryPresetArray_t() ARRAY_OPLIST(SubGhzHistoryPresetArray, M_POD_OPLIST)
+
+// Decode serialized in the rx callback, stored into history on the app thread
+typedef struct {
+    FlipperFormat* data;
+    const SubGhzProtocol* protocol;
+    FuriString* preset_name;
+    uint8_t* preset_data;
+    size_t preset_data_size;
+    uint32_t frequency;
+} SubGhzHistoryQueueItem;
 
 struct SubGhzHistory {
     uint32_t last_update_timestamp;
-    uint16_t last_index_write;
     uint8_t code_last_hash_data;
+    uint16_t loaded_index;
     FuriString* tmp_string;
-    SubGhzHistoryStruct* history;
+    SubGhzHistoryItemArray_t items;
+    SubGhzHistoryPresetArray_t presets;
+    SubGhzRadioPreset radio_preset;
+    SubGhzHistoryQueueItem queue[SUBGHZ_HISTORY_QUEUE_SIZE];
+    uint8_t queue_head;
+    uint8_t queue_count;
+    FuriMutex* mutex; // Guards queue positions and items, which the view reads while drawing
+    Storage* storage;
+    Stream* log;
+    FlipperFormat* load_string; // Entry loaded from log, returned by get_raw_data
 };
 
 SubGhzHistory* subghz_history_alloc(void) {
     SubGhzHistory* instance = malloc(sizeof(SubGhzHistory));
     instance->tmp_string = furi_string_alloc();
-    instance->history = malloc(sizeof(SubGhzHistoryStruct));
-    SubGhzHistoryItemArray_init(instance->history->data);
+    SubGhzHistoryItemArray_init(instance->items);
+    SubGhzHistoryPresetArray_init(instance->presets);
+    instance->loaded_index = SUBGHZ_HISTORY_INDEX_NONE;
+    instance->mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+    instance->load_string = flipper_format_string_alloc();
+    for(size_t i = 0; i < SUBGHZ_HISTORY_QUEUE_SIZE; i++) {
+        instance->queue[i].data = flipper_format_string_alloc();
+        instance->queue[i].preset_name = furi_string_alloc();
+    }
+
+    instance->storage = furi_record_open(RECORD_STORAGE);
+    instance->log = file_stream_alloc(instance->storage);
+    storage_simply_mkdir(instance->storage, SUBGHZ_RAW_FOLDER);
+    if(!file_stream_open(
+           instance->log, SUBGHZ_HISTORY_LOG_PATH, FSAM_READ_WRITE, FSOM_CREATE_ALWAYS)) {
+        FURI_LOG_W(TAG, "Log is not available, keeping history in RAM");
+        file_stream_close(instance->log);
+        stream_free(instance->log);
+        furi_record_close(RECORD_STORAGE);
+        instance->storage = NULL;
+        instance->log = string_stream_alloc();
+    }
+
     return instance;
 }
 
+static void subghz_history_clear_presets(SubGhzHistory* instance) {
+    for
+        M_EACH(preset, instance->presets, SubGhzHistoryPresetArray_t) {
+            furi_string_free(preset->name);
+        }
+    SubGhzHistoryPresetArray_reset(instance->presets);
+}
+
 void subghz_history_free(SubGhzHistory* instance) {
     furi_assert(instance);
+    stream_free(instance->log);
+    if(instance->storage) {
+        storage_simply_remove(instance->storage, SUBGHZ_HISTORY_LOG_PATH);
+        furi_record_close(RECORD_STORAGE);
+    }
+    for(size_t i = 0; i < SUBGHZ_HISTORY_QUEUE_SIZE; i++) {
+        flipper_format_free(instance->queue[i].data);
+        furi_string_free(instance->queue[i].preset_name);
+    }
+    flipper_format_free(instance->load_string);
+    furi_mutex_free(instance->mutex);
+    subghz_history_clear_presets(instance);
+    SubGhzHistoryPresetArray_clear(instance->presets);
+    SubGhzHistoryItemArray_clear(instance->items);
     furi_string_free(instance->tmp_string);
-    for
-        M_EACH(item, instance->history->data, SubGhzHistoryItemArray_t) {
-            furi_string_free(item->item_str);
-            furi_string_free(item->preset->name);
-            free(item->preset);
-            flipper_format_free(item->flipper_string);
-            item->type = 0;
-        }
-    SubGhzHistoryItemArray_clear(instance->history->data);
-    free(instance->history);
     free(instance);
 }
 
 uint32_t subghz_history_get_frequency(SubGhzHistory* instance, uint16_t idx) {
     furi_assert(instance);
-    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
-    return item->preset->frequency;
+    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->items, idx);
+    return item->frequency;
 }
 
 SubGhzRadioPreset* subghz_history_get_radio_preset(SubGhzHistory* instance, uint16_t idx) {
     furi_assert(instance);
-    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
-    return item->preset;
+    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->items, idx);
+    SubGhzHistoryPreset* preset = SubGhzHistoryPresetArray_get(instance->presets, item->preset);
+    instance->radio_preset.name = preset->name;
+    instance->radio_preset.frequency = item->frequency;
+    instance->radio_preset.data = preset->data;
+    instance->radio_preset.data_size = preset->data_size;
+    return &instance->radio_preset;
 }
 
 const char* subghz_history_get_preset(SubGhzHistory* instance, uint16_t idx) {
     furi_assert(instance);
-    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
-    return furi_string_get_cstr(item->preset->name);
+    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->items, idx);
+    SubGhzHistoryPreset* preset = SubGhzHistoryPresetArray_get(instance->presets, item->preset);
+    return furi_string_get_cstr(preset->name);
 }
 
 void subghz_history_reset(SubGhzHistory* instance) {
     furi_assert(instance);
+    furi_mutex_acquire(instance->mutex, FuriWaitForever);
     furi_string_reset(instance->tmp_string);
-    for
-        M_EACH(item, instance->history->data, SubGhzHistoryItemArray_t) {
-            furi_string_free(item->item_str);
-            furi_string_free(item->preset->name);
-            free(item->preset);
-            flipper_format_free(item->flipper_string);
-            item->type = 0;
-        }
-    SubGhzHistoryItemArray_reset(instance->history->data);
-    instance->last_index_write = 0;
+    SubGhzHistoryItemArray_reset(instance->items);
+    subghz_history_clear_presets(instance);
+    stream_clean(instance->log);
+    instance->queue_head = 0;
+    instance->queue_count = 0;
+    instance->loaded_index = SUBGHZ_HISTORY_INDEX_NONE;
     instance->code_last_hash_data = 0;
+    furi_mutex_release(instance->mutex);
 }
 
 uint16_t subghz_history_get_item(SubGhzHistory* instance) {
     furi_assert(instance);
-    return instance->last_index_write;
+    return SubGhzHistoryItemArray_size(instance->items);
 }
 
 uint8_t subghz_history_get_type_protocol(SubGhzHistory* instance, uint16_t idx) {
     furi_assert(instance);
-    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
-    return item->type;
+    furi_mutex_acquire(instance->mutex, FuriWaitForever);
+    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->items, idx);
+    uint8_t type = item->type;
+    furi_mutex_release(instance->mutex);
+    return type;
 }
 
 const char* subghz_history_get_protocol_name(SubGhzHistory* instance, uint16_t idx) {
     furi_assert(instance);
-    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
-    flipper_format_rewind(item->flipper_string);
-    if(!flipper_format_read_string(item->flipper_string, "Protocol", instance->tmp_string)) {
-        FURI_LOG_E(TAG, "Missing Protocol");
-        furi_string_reset(instance->tmp_string);
-    }
-    return furi_string_get_cstr(instance->tmp_string);
+    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->items, idx);
+    return item->protocol_name;
+}
+
+uint16_t subghz_history_get_hits(SubGhzHistory* instance, uint16_t idx) {
+    furi_assert(instance);
+    furi_mutex_acquire(instance->mutex, FuriWaitForever);
+    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->items, idx);
+    uint16_t hits = item->hits;
+    furi_mutex_release(instance->mutex);
+    return hits;
 }
 
 FlipperFormat* subghz_history_get_raw_data(SubGhzHistory* instance, uint16_t idx) {
     furi_assert(instance);
-    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
-    if(item->flipper_string) {
-        return item->flipper_string;
-    } else {
+    if(idx == instance->loaded_index) {
+        flipper_format_rewind(instance->load_string);
+        return instance->load_string;
+    }
+
+    furi_mutex_acquire(instance->mutex, FuriWaitForever);
+    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->items, idx);
+    Stream* stream = flipper_format_get_raw_stream(instance->load_string);
+    bool loaded = false;
+
+    do {
+        uint32_t size = 0;
+        if(!stream_seek(instance->log, item->offset, StreamOffsetFromStart)) break;
+        if(stream_read(instance->log, (uint8_t*)&size, sizeof(size)) != sizeof(size)) break;
+        stream_clean(stream);
+        if(stream_copy(instance->log, stream, size) != size) break;
+        loaded = flipper_format_rewind(instance->load_string);
+    } while(false);
+
+    instance->loaded_index = loaded ? idx : SUBGHZ_HISTORY_INDEX_NONE;
+    furi_mutex_release(instance->mutex);
+
+    if(!loaded) {
+        FURI_LOG_E(TAG, "Failed to load entry %u", idx);
         return NULL;
     }
+    return instance->load_string;
 }
+
 bool subghz_history_get_text_space_left(SubGhzHistory* instance, FuriString* output) {
     furi_assert(instance);
     if(memmgr_get_free_heap() < SUBGHZ_HISTORY_FREE_HEAP) {
         if(output != NULL) furi_string_printf(output, "    Free heap LOW");
         return true;
     }
-    if(instance->last_index_write == SUBGHZ_HISTORY_MAX) {
+    uint16_t count = subghz_history_get_item(instance);
+    if(count == SUBGHZ_HISTORY_MAX) {
         if(output != NULL) furi_string_printf(output, "   Memory is FULL");
         return true;
     }
-    if(output != NULL)
-        furi_string_printf(output, "%02u/%02u", instance->last_index_write, SUBGHZ_HISTORY_MAX);
+    if(output != NULL) furi_string_printf(output, "%02u/%02u", count, SUBGHZ_HISTORY_MAX);
     return false;
 }
 
 void subghz_history_get_text_item_menu(SubGhzHistory* instance, FuriString* output, uint16_t idx) {
-    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
-    furi_string_set(output, item->item_str);
-}
-
-bool subghz_history_add_to_history(
-    SubGhzHistory* instance,
-    void* context,
-    SubGhzRadioPreset* preset) {
     furi_assert(instance);
-    furi_assert(context);
-
-    if(memmgr_get_free_heap() < SUBGHZ_HISTORY_FREE_HEAP) return false;
-    if(instance->last_index_write >= SUBGHZ_HISTORY_MAX) return false;
+    furi_mutex_acquire(instance->mutex, FuriWaitForever);
+    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->items, idx);
+    furi_string_set(output, item->text);
+    furi_mutex_release(instance->mutex);
+}
 
-    SubGhzProtocolDecoderBase* decoder_base = context;
-    if((instance->code_last_hash_data ==
-        subghz_protocol_decoder_base_get_hash_data(decoder_base)) &&
-       ((furi_get_tick() - instance->last_update_timestamp) < 500)) {
-        instance->last_update_timestamp = furi_get_tick();
-        return false;
+static uint32_t subghz_history_hash(uint32_t hash, const void* data, size_t size) {
+    const uint8_t* bytes = data;
+    for(size_t i = 0; i < size; i++) {
+        hash = (hash ^ bytes[i]) * SUBGHZ_HISTORY_HASH_PRIME;
     }
+    return hash;
+}
 
-    instance->code_last_hash_data = subghz_protocol_decoder_base_get_hash_data(decoder_base);
-    instance->last_update_timestamp = furi_get_tick();
+static uint8_t
+    subghz_history_get_preset_index(SubGhzHistory* instance, SubGhzHistoryQueueItem* queued) {
+    uint8_t index = 0;
+    for
+        M_EACH(item, instance->presets, SubGhzHistoryPresetArray_t) {
+            if(item->data == queued->preset_data &&
+               furi_string_equal(item->name, queued->preset_name)) {
+                return index;
+            }
+            index++;
+        }
 
-    FuriString* text;
-    text = furi_string_alloc();
-    SubGhzHistoryItem* item = SubGhzHistoryItemArray_push_raw(instance->history->data);
-    item->preset = malloc(sizeof(SubGhzRadioPreset));
-    item->type = decoder_base->protocol->type;
-    item->preset->frequency = preset->frequency;
-    item->preset->name = furi_string_alloc();
-    furi_string_set(item->preset->name, preset->name);
-    item->preset->data = preset->data;
-    item->preset->data_size = preset->data_size;
-
-    item->item_str = furi_string_alloc();
-    item->flipper_string = flipper_format_string_alloc();
-    subghz_protocol_decoder_base_serialize(decoder_base, item->flipper_string, preset);
+    // Only a handful of presets exist, sharing them keeps history items fixed size
+    furi_check(index < UINT8_MAX);
+    SubGhzHistoryPreset* item = SubGhzHistoryPresetArray_push_raw(instance->presets);
+    item->name = furi_string_alloc_set(queued->preset_name);
+    item->data = queued->preset_data;
+    item->data_size = queued->preset_data_size;
+    return index;
+}
+
+// Fill menu text and return hash of protocol name and key, whole data for protocols without key
+static uint32_t subghz_history_parse(
+    SubGhzHistory* instance,
+    FlipperFormat* flipper_string,
+    const char* protocol,
+    char* text) {
+    uint32_t hash = subghz_history_hash(SUBGHZ_HISTORY_HASH_SEED, protocol, strlen(protocol));
+    FuriString* manufacture = furi_string_alloc();
+    text[0] = '\0';
 
     do {
-        if(!flipper_format_rewind(item->flipper_string)) {
-            FURI_LOG_E(TAG, "Rewind error");
-            break;
+        const char* prefix = NULL;
+        if(!strcmp(protocol, "KeeLoq")) {
+            prefix = "KL ";
+        } else if(!strcmp(protocol, "Star Line")) {
+            prefix = "SL ";
         }
-        if(!flipper_format_read_string(item->flipper_string, "Protocol", instance->tmp_string)) {
-            FURI_LOG_E(TAG, "Missing Protocol");
-            break;
-        }
-        if(!strcmp(furi_string_get_cstr(instance->tmp_string), "KeeLoq")) {
-            furi_string_set(instance->tmp_string, "KL ");
-            if(!flipper_format_read_string(item->flipper_string, "Manufacture", text)) {
-                FURI_LOG_E(TAG, "Missing Protocol");
-                break;
-            }
-            furi_string_cat(instance->tmp_string, text);
-        } else if(!strcmp(furi_string_get_cstr(instance->tmp_string), "Star Line")) {
-            furi_string_set(instance->tmp_string, "SL ");
-            if(!flipper_format_read_string(item->flipper_string, "Manufacture", text)) {
-                FURI_LOG_E(TAG, "Missing Protocol");
-                break;
+        furi_string_set(instance->tmp_string, protocol);
+        furi_string_left(instance->tmp_string, SUBGHZ_HISTORY_NAME_SIZE);
+        if(prefix) {
+            flipper_format_rewind(flipper_string);
+            if(flipper_format_read_string(flipper_string, "Manufacture", manufacture)) {
+                furi_string_printf(
+                    instance->tmp_string,
+                    "%s%.*s",
+                    prefix,
+                    (int)(SUBGHZ_HISTORY_NAME_SIZE - strlen(prefix)),
+                    furi_string_get_cstr(manufacture));
+            } else {
+                FURI_LOG_E(TAG, "Missing Manufacture");
             }
-            furi_string_cat(instance->tmp_string, text);
         }
-        if(!flipper_format_rewind(item->flipper_string)) {
+        if(!flipper_format_rewind(flipper_string)) {
             FURI_LOG_E(TAG, "Rewind error");
             break;
         }
         uint8_t key_data[sizeof(uint64_t)] = {0};
-        if(!flipper_format_read_hex(item->flipper_string, "Key", key_data, sizeof(uint64_t))) {
+        if(!flipper_format_read_hex(flipper_string, "Key", key_data, sizeof(uint64_t))) {
             FURI_LOG_D(TAG, "No Key");
+            Stream* stream = flipper_format_get_raw_stream(flipper_string);
+            uint8_t buffer[32];
+            size_t size = 0;
+            stream_rewind(stream);
+            while((size = stream_read(stream, buffer, sizeof(buffer))) > 0) {
+                hash = subghz_history_hash(hash, buffer, size);
+            }
+        } else {
+            hash = subghz_history_hash(hash, key_data, sizeof(key_data));
         }
         uint64_t data = 0;
         for(uint8_t i = 0; i < sizeof(uint64_t); i++) {
@@ -214,26 +340,161 @@ bool subghz_history_add_to_history(
         }
         if(data != 0) {
             if(!(uint32_t)(data >> 32)) {
-                furi_string_printf(
-                    item->item_str,
-                    "%s %lX",
+                snprintf(
+                    text,
+                    SUBGHZ_HISTORY_TEXT_SIZE,
+                    "%s %" PRIX32,
                     furi_string_get_cstr(instance->tmp_string),
                     (uint32_t)(data & 0xFFFFFFFF));
             } else {
-                furi_string_printf(
-                    item->item_str,
-                    "%s %lX%08lX",
+                snprintf(
+                    text,
+                    SUBGHZ_HISTORY_TEXT_SIZE,
+                    "%s %" PRIX32 "%08" PRIX32,
                     furi_string_get_cstr(instance->tmp_string),
                     (uint32_t)(data >> 32),
                     (uint32_t)(data & 0xFFFFFFFF));
             }
         } else {
-            furi_string_printf(item->item_str, "%s", furi_string_get_cstr(instance->tmp_string));
+            snprintf(
+                text, SUBGHZ_HISTORY_TEXT_SIZE, "%s", furi_string_get_cstr(instance->tmp_string));
         }
+    } while(false);
+
+    furi_string_free(manufacture);
+    return hash;
+}
 
+static bool
+    subghz_history_append(SubGhzHistory* instance, FlipperFormat* data, uint32_t* offset) {
+    Stream* stream = flipper_format_get_raw_stream(data);
+    uint32_t size = stream_size(stream);
+    bool appended = false;
+
+    do {
+        if(!stream_seek(instance->log, 0, StreamOffsetFromEnd)) break;
+        *offset = stream_tell(instance->log);
+        if(stream_write(instance->log, (uint8_t*)&size, sizeof(size)) != sizeof(size)) break;
+        if(!stream_rewind(stream)) break;
+        if(stream_copy(stream, instance->log, size) != size) break;
+        appended = true;
     } while(false);
 
-    furi_string_free(text);
-    instance->last_index_write++;
+    return appended;
+}
+
+bool subghz_history_add_to_history(
+    SubGhzHistory* instance,
+    void* context,
+    SubGhzRadioPreset* preset) {
+    furi_assert(instance);
+    furi_assert(context);
+
+    if(memmgr_get_free_heap() < SUBGHZ_HISTORY_FREE_HEAP) return false;
+
+    SubGhzProtocolDecoderBase* decoder_base = context;
+    if((instance->code_last_hash_data ==
+        subghz_protocol_decoder_base_get_hash_data(decoder_base)) &&
+       ((furi_get_tick() - instance->last_update_timestamp) < 500)) {
+        instance->last_update_timestamp = furi_get_tick();
+        return false;
+    }
+
+    instance->code_last_hash_data = subghz_protocol_decoder_base_get_hash_data(decoder_base);
+    instance->last_update_timestamp = furi_get_tick();
+
+    // Only the rx callback adds to the queue, so the free slot stays free after unlock
+    furi_mutex_acquire(instance->mutex, FuriWaitForever);
+    const uint8_t queue_count = instance->queue_count;
+    const uint8_t slot = (instance->queue_head + queue_count) % SUBGHZ_HISTORY_QUEUE_SIZE;
+    furi_mutex_release(instance->mutex);
+
+    if(queue_count == SUBGHZ_HISTORY_QUEUE_SIZE) {
+        FURI_LOG_W(TAG, "Queue is full");
+        return false;
+    }
+
+    SubGhzHistoryQueueItem* queued = &instance->queue[slot];
+    stream_clean(flipper_format_get_raw_stream(queued->data));
+    subghz_protocol_decoder_base_serialize(decoder_base, queued->data, preset);
+    queued->protocol = decoder_base->protocol;
+    furi_string_set(queued->preset_name, preset->name);
+    queued->preset_data = preset->data;
+    queued->preset_data_size = preset->data_size;
+    queued->frequency = preset->frequency;
+
+    furi_mutex_acquire(instance->mutex, FuriWaitForever);
+    instance->queue_count++;
+    furi_mutex_release(instance->mutex);
+
+    return true;
+}
+
+// Merge a queued decode into history, log write and repeat lookup happen here
+static bool subghz_history_store(SubGhzHistory* instance, SubGhzHistoryQueueItem* queued) {
+    const char* protocol_name = queued->protocol->name;
+    char text[SUBGHZ_HISTORY_TEXT_SIZE];
+    uint32_t hash = subghz_history_parse(instance, queued->data, protocol_name, text);
+
+    // Repeated key only counts, recent items are the most likely to repeat
+    size_t count = SubGhzHistoryItemArray_size(instance->items);
+    for(size_t i = count; i > 0; i--) {
+        SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->items, i - 1);
+        if(item->hash == hash && !strcmp(item->protocol_name, protocol_name)) {
+            furi_mutex_acquire(instance->mutex, FuriWaitForever);
+            if(item->hits < SUBGHZ_HISTORY_HITS_MAX) item->hits++;
+            furi_mutex_release(instance->mutex);
+            return true;
+        }
+    }
+
+    if(count >= SUBGHZ_HISTORY_MAX) return false;
+    if(memmgr_get_free_heap() < SUBGHZ_HISTORY_FREE_HEAP) return false;
+
+    uint32_t offset = 0;
+    if(!subghz_history_append(instance, queued->data, &offset)) {
+        FURI_LOG_E(TAG, "Log write error");
+        return false;
+    }
+
+    SubGhzHistoryItem new_item = {
+        .hash = hash,
+        .offset = offset,
+        .frequency = queued->frequency,
+        .protocol_name = protocol_name,
+        .hits = 1,
+        .type = queued->protocol->type,
+        .preset = subghz_history_get_preset_index(instance, queued),
+    };
+    memcpy(new_item.text, text, SUBGHZ_HISTORY_TEXT_SIZE);
+
+    furi_mutex_acquire(instance->mutex, FuriWaitForever);
+    SubGhzHistoryItemArray_push_back(instance->items, new_item);
+    furi_mutex_release(instance->mutex);
+
     return true;
 }
+
+bool subghz_history_process_queue(SubGhzHistory* instance) {
+    furi_assert(instance);
+    bool updated = false;
+
+    while(true) {
+        furi_mutex_acquire(instance->mutex, FuriWaitForever);
+        const uint8_t queue_count = instance->queue_count;
+        SubGhzHistoryQueueItem* queued = &instance->queue[instance->queue_head];
+        furi_mutex_release(instance->mutex);
+
+        if(queue_count == 0) break;
+
+        // The slot is released only after it is stored, so the rx callback can't reuse it
+        if(subghz_history_store(instance, queued)) updated = true;
+
+        furi_mutex_acquire(instance->mutex, FuriWaitForever);
+        instance->queue_head = (instance->queue_head + 1) % SUBGHZ_HISTORY_QUEUE_SIZE;
+        instance->queue_count--;
+        furi_mutex_release(instance->mutex);
+    }
+
+    return updated;
+}
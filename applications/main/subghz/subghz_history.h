@@ -68,6 +68,14 @@ uint8_t subghz_history_get_type_protocol(SubGhzHistory* instance, uint16_t idx);
  */
 const char* subghz_history_get_protocol_name(SubGhzHistory* instance, uint16_t idx);
 
+/** Get number of times history[idx] was received
+ * 
+ * @param instance  - SubGhzHistory instance
+ * @param idx       - record index  
+ * @return hits      - receive count, repeats of the same protocol and key are merged
+ */
+uint16_t subghz_history_get_hits(SubGhzHistory* instance, uint16_t idx);
+
 /** Get string item menu to history[idx]
  * 
  * @param instance  - SubGhzHistory instance
@@ -84,22 +92,35 @@ void subghz_history_get_text_item_menu(SubGhzHistory* instance, FuriString* outp
  */
 bool subghz_history_get_text_space_left(SubGhzHistory* instance, FuriString* output);
 
-/** Add protocol to history
+/** Queue protocol for history, made for the receiver rx callback
+ * 
+ * Only serializes the decode, subghz_history_process_queue stores it
  * 
  * @param instance  - SubGhzHistory instance
  * @param context    - SubGhzProtocolCommon context
  * @param preset    - SubGhzRadioPreset preset
- * @return bool;
+ * @return bool - decode is queued
  */
 bool subghz_history_add_to_history(
     SubGhzHistory* instance,
     void* context,
     SubGhzRadioPreset* preset);
 
+/** Store queued protocols in history, call from the app thread
+ * 
+ * Writes the log and merges repeats of the same protocol and key into one item
+ * 
+ * @param instance  - SubGhzHistory instance
+ * @return bool - an item was added or got a new hit
+ */
+bool subghz_history_process_queue(SubGhzHistory* instance);
+
 /** Get SubGhzProtocolCommonLoad to load into the protocol decoder bin data
+ * 
+ * Data is read back from history log, returned instance is reused by the next call
  * 
  * @param instance  - SubGhzHistory instance
  * @param idx       - record index
- * @return SubGhzProtocolCommonLoad*
+ * @return SubGhzProtocolCommonLoad*, NULL on log read error
  */
 FlipperFormat* subghz_history_get_raw_data(SubGhzHistory* instance, uint16_t idx);
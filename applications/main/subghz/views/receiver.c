@@ -5,7 +5,6 @@
 #include <input/input.h>
 #include <gui/elements.h>
 #include <assets_icons.h>
-#include <m-array.h>
 
 #define FRAME_HEIGHT 12
 #define MAX_LEN_PX 111
@@ -14,22 +13,6 @@
 
 #define SUBGHZ_RAW_THRESHOLD_MIN -90.0f
 
-typedef struct {
-    FuriString* item_str;
-    uint8_t type;
-} SubGhzReceiverMenuItem;
-
-ARRAY_DEF(SubGhzReceiverMenuItemArray, SubGhzReceiverMenuItem, M_POD_OPLIST)
-
-#define M_OPL_SubGhzReceiverMenuItemArray_t() \
-    ARRAY_OPLIST(SubGhzReceiverMenuItemArray, M_POD_OPLIST)
-
-struct SubGhzReceiverHistory {
-    SubGhzReceiverMenuItemArray_t data;
-};
-
-typedef struct SubGhzReceiverHistory SubGhzReceiverHistory;
-
 static const Icon* ReceiverItemIcons[] = {
     [SubGhzProtocolTypeUnknown] = &I_Quest_7x8,
     [SubGhzProtocolTypeStatic] = &I_Unlock_7x8,
@@ -56,7 +39,7 @@ typedef struct {
     FuriString* frequency_str;
     FuriString* preset_str;
     FuriString* history_stat_str;
-    SubGhzReceiverHistory* history;
+    SubGhzHistory* history; // Menu items are drawn straight from history
     uint16_t idx;
     uint16_t list_offset;
     uint16_t history_item;
@@ -133,24 +116,31 @@ static void subghz_view_receiver_update_offset(SubGhzViewReceiver* subghz_receiv
         true);
 }
 
-void subghz_view_receiver_add_item_to_menu(
+void subghz_view_receiver_set_history(
     SubGhzViewReceiver* subghz_receiver,
-    const char* name,
-    uint8_t type) {
+    SubGhzHistory* history) {
+    furi_assert(subghz_receiver);
+    with_view_model(
+        subghz_receiver->view,
+        SubGhzViewReceiverModel * model,
+        { model->history = history; },
+        false);
+}
+
+void subghz_view_receiver_update_menu(SubGhzViewReceiver* subghz_receiver) {
     furi_assert(subghz_receiver);
     with_view_model(
         subghz_receiver->view,
         SubGhzViewReceiverModel * model,
         {
-            SubGhzReceiverMenuItem* item_menu =
-                SubGhzReceiverMenuItemArray_push_raw(model->history->data);
-            item_menu->item_str = furi_string_alloc_set(name);
-            item_menu->type = type;
-            if((model->idx == model->history_item - 1)) {
-                model->history_item++;
-                model->idx++;
-            } else {
-                model->history_item++;
+            const uint16_t history_item = subghz_history_get_item(model->history);
+            while(model->history_item < history_item) {
+                if((model->idx == model->history_item - 1)) {
+                    model->history_item++;
+                    model->idx++;
+                } else {
+                    model->history_item++;
+                }
             }
         },
         true);
@@ -219,22 +209,43 @@ void subghz_view_receiver_draw(Canvas* canvas, SubGhzViewReceiverModel* model) {
     bool scrollbar = model->history_item > 4;
     FuriString* str_buff;
     str_buff = furi_string_alloc();
-
-    SubGhzReceiverMenuItem* item_menu;
-
-    for(size_t i = 0; i < MIN(model->history_item, MENU_ITEMS); ++i) {
-        size_t idx = CLAMP((uint16_t)(i + model->list_offset), model->history_item, 0);
-        item_menu = SubGhzReceiverMenuItemArray_get(model->history->data, idx);
-        furi_string_set(str_buff, item_menu->item_str);
-        elements_string_fit_width(canvas, str_buff, scrollbar ? MAX_LEN_PX - 7 : MAX_LEN_PX);
+    char hits_str[8];
+
+    // History is reset before the menu, never draw past its end
+    const uint16_t history_item =
+        MIN(model->history_item, subghz_history_get_item(model->history));
+
+    for(size_t i = 0; i < MIN(history_item, MENU_ITEMS); ++i) {
+        size_t idx = CLAMP((uint16_t)(i + model->list_offset), history_item - 1, 0);
+        subghz_history_get_text_item_menu(model->history, str_buff, idx);
+        const uint16_t hits = subghz_history_get_hits(model->history, idx);
+        uint16_t hits_width = 0;
+        if(hits > 1) {
+            snprintf(hits_str, sizeof(hits_str), "x%u", hits);
+            hits_width = canvas_string_width(canvas, hits_str) + 2;
+        }
+        elements_string_fit_width(
+            canvas, str_buff, (scrollbar ? MAX_LEN_PX - 7 : MAX_LEN_PX) - hits_width);
         if(model->idx == idx) {
             subghz_view_receiver_draw_frame(canvas, i, scrollbar);
         } else {
             canvas_set_color(canvas, ColorBlack);
         }
-        canvas_draw_icon(canvas, 4, 2 + i * FRAME_HEIGHT, ReceiverItemIcons[item_menu->type]);
+        canvas_draw_icon(
+            canvas,
+            4,
+            2 + i * FRAME_HEIGHT,
+            ReceiverItemIcons[subghz_history_get_type_protocol(model->history, idx)]);
         canvas_draw_str(canvas, 15, 9 + i * FRAME_HEIGHT, furi_string_get_cstr(str_buff));
-        furi_string_reset(str_buff);
+        if(hits > 1) {
+            canvas_draw_str_aligned(
+                canvas,
+                scrollbar ? 120 : 125,
+                9 + i * FRAME_HEIGHT,
+                AlignRight,
+                AlignBottom,
+                hits_str);
+        }
     }
     if(scrollbar) {
         elements_scrollbar_pos(canvas, 128, 0, 49, model->idx, model->history_item);
@@ -393,15 +404,9 @@ void subghz_view_receiver_exit(void* context) {
             furi_string_reset(model->frequency_str);
             furi_string_reset(model->preset_str);
             furi_string_reset(model->history_stat_str);
-                for
-                    M_EACH(item_menu, model->history->data, SubGhzReceiverMenuItemArray_t) {
-                        furi_string_free(item_menu->item_str);
-                        item_menu->type = 0;
-                    }
-                SubGhzReceiverMenuItemArray_reset(model->history->data);
-                model->idx = 0;
-                model->list_offset = 0;
-                model->history_item = 0;
+            model->idx = 0;
+            model->list_offset = 0;
+            model->history_item = 0;
         },
         false);
     furi_timer_stop(subghz_receiver->timer);
@@ -431,8 +436,6 @@ SubGhzViewReceiver* subghz_view_receiver_alloc() {
             model->preset_str = furi_string_alloc();
             model->history_stat_str = furi_string_alloc();
             model->bar_show = SubGhzViewReceiverBarShowDefault;
-            model->history = malloc(sizeof(SubGhzReceiverHistory));
-            SubGhzReceiverMenuItemArray_init(model->history->data);
         },
         true);
     subghz_receiver->timer =
@@ -450,13 +453,6 @@ void subghz_view_receiver_free(SubGhzViewReceiver* subghz_receiver) {
             furi_string_free(model->frequency_str);
             furi_string_free(model->preset_str);
             furi_string_free(model->history_stat_str);
-                for
-                    M_EACH(item_menu, model->history->data, SubGhzReceiverMenuItemArray_t) {
-                        furi_string_free(item_menu->item_str);
-                        item_menu->type = 0;
-                    }
-                SubGhzReceiverMenuItemArray_clear(model->history->data);
-                free(model->history);
         },
         false);
     furi_timer_free(subghz_receiver->timer);
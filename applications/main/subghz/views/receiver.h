@@ -3,6 +3,7 @@
 #include <gui/view.h>
 #include "../helpers/subghz_types.h"
 #include "../helpers/subghz_custom_event.h"
+#include "../subghz_history.h"
 
 typedef struct SubGhzViewReceiver SubGhzViewReceiver;
 
@@ -33,10 +34,9 @@ void subghz_view_receiver_set_radio_device_type(
     SubGhzViewReceiver* subghz_receiver,
     SubGhzRadioDeviceType device_type);
 
-void subghz_view_receiver_add_item_to_menu(
-    SubGhzViewReceiver* subghz_receiver,
-    const char* name,
-    uint8_t type);
+void subghz_view_receiver_set_history(SubGhzViewReceiver* subghz_receiver, SubGhzHistory* history);
+
+void subghz_view_receiver_update_menu(SubGhzViewReceiver* subghz_receiver);
 
 uint16_t subghz_view_receiver_get_idx_menu(SubGhzViewReceiver* subghz_receiver);
 
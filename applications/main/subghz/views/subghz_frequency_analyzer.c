@@ -25,6 +25,7 @@ typedef enum {
 typedef enum {
     SubGhzFrequencyAnalyzerFragmentBottomTypeMain,
     SubGhzFrequencyAnalyzerFragmentBottomTypeLog,
+    SubGhzFrequencyAnalyzerFragmentBottomTypeHot,
 } SubGhzFrequencyAnalyzerFragmentBottomType;
 
 struct SubGhzFrequencyAnalyzer {
@@ -45,6 +46,8 @@ typedef struct {
     SubGhzFrequencyAnalyzerFragmentBottomType fragment_bottom_type;
     SubGhzFrequencyAnalyzerLogOrderBy log_frequency_order_by;
     uint8_t log_frequency_scroll_offset;
+    SubGhzFrequencyAnalyzerSweepStats hot_frequency[SUBGHZ_FREQUENCY_ANALYZER_WORKER_HOT_MAX];
+    uint8_t hot_frequency_count;
 } SubGhzFrequencyAnalyzerModel;
 
 static inline uint8_t rssi_sanitize(float rssi) {
@@ -136,6 +139,40 @@ static void subghz_frequency_analyzer_log_frequency_draw(
     canvas_set_font(canvas, FontSecondary);
 }
 
+static void subghz_frequency_analyzer_hot_frequency_draw(
+    Canvas* canvas,
+    SubGhzFrequencyAnalyzerModel* model) {
+    char buffer[64];
+    const uint8_t offset_x = 0;
+    const uint8_t offset_y = 43;
+    canvas_set_font(canvas, FontKeyboard);
+
+    if(model->hot_frequency_count == 0) {
+        canvas_draw_rframe(canvas, offset_x + 27, offset_y - 3, 73, 16, 5);
+        canvas_draw_str_aligned(
+            canvas, offset_x + 64, offset_y + 8, AlignCenter, AlignBottom, "No records");
+        return;
+    }
+
+    for(uint8_t i = 0; i < model->hot_frequency_count; ++i) {
+        const SubGhzFrequencyAnalyzerSweepStats* stats = &model->hot_frequency[i];
+        // Frequency, where the signal was found by fine scan if it was
+        uint32_t frequency = stats->frequency_fine ? stats->frequency_fine : stats->frequency;
+        SNPRINTF_FREQUENCY(buffer, frequency)
+        canvas_draw_str(canvas, offset_x, offset_y + i * 10, buffer);
+
+        // Hits
+        snprintf(buffer, sizeof(buffer), "%3d", MIN(stats->hits, 999));
+        canvas_draw_str(canvas, offset_x + 48, offset_y + i * 10, buffer);
+
+        // Max RSSI
+        subghz_frequency_analyzer_draw_log_rssi(
+            canvas, rssi_sanitize(stats->rssi_max), offset_x + 69, (offset_y + i * 10));
+    }
+
+    canvas_set_font(canvas, FontSecondary);
+}
+
 static void subghz_frequency_analyzer_history_frequency_draw(
     Canvas* canvas,
     SubGhzFrequencyAnalyzerModel* model) {
@@ -176,6 +213,9 @@ void subghz_frequency_analyzer_draw(Canvas* canvas, SubGhzFrequencyAnalyzerModel
             canvas_draw_str(canvas, 2, 8, buffer);
         }
         subghz_frequency_analyzer_log_frequency_draw(canvas, model);
+    } else if(model->fragment_bottom_type == SubGhzFrequencyAnalyzerFragmentBottomTypeHot) {
+        canvas_draw_str_aligned(canvas, 64, 8, AlignCenter, AlignBottom, "Hot Frequencies");
+        subghz_frequency_analyzer_hot_frequency_draw(canvas, model);
     } else {
         canvas_draw_str(canvas, 0, 8, "Frequency Analyzer");
         canvas_draw_icon(canvas, 109, 0, &I_Internal_ant_1_9x11);
@@ -219,13 +259,13 @@ bool subghz_frequency_analyzer_input(InputEvent* event, void* context) {
             {
                 if(event->key == InputKeyLeft) {
                     if(model->fragment_bottom_type == 0) {
-                        model->fragment_bottom_type = SubGhzFrequencyAnalyzerFragmentBottomTypeLog;
+                        model->fragment_bottom_type = SubGhzFrequencyAnalyzerFragmentBottomTypeHot;
                     } else {
                         --model->fragment_bottom_type;
                     }
                 } else if(event->key == InputKeyRight) {
                     if(model->fragment_bottom_type ==
-                       SubGhzFrequencyAnalyzerFragmentBottomTypeLog) {
+                       SubGhzFrequencyAnalyzerFragmentBottomTypeHot) {
                         model->fragment_bottom_type = 0;
                     } else {
                         ++model->fragment_bottom_type;
@@ -361,6 +401,9 @@ void subghz_frequency_analyzer_pair_callback(
     }
 
     instance->locked = !float_is_equal(rssi, 0.f);
+    SubGhzFrequencyAnalyzerSweepStats hot_frequency[SUBGHZ_FREQUENCY_ANALYZER_WORKER_HOT_MAX];
+    size_t hot_frequency_count = subghz_frequency_analyzer_worker_get_hot(
+        instance->worker, hot_frequency, SUBGHZ_FREQUENCY_ANALYZER_WORKER_HOT_MAX);
     with_view_model(
         instance->view,
         SubGhzFrequencyAnalyzerModel * model,
@@ -368,6 +411,8 @@ void subghz_frequency_analyzer_pair_callback(
             model->rssi = rssi_sanitize(rssi);
             model->frequency = frequency;
             model->signal = signal;
+            memcpy(model->hot_frequency, hot_frequency, sizeof(hot_frequency));
+            model->hot_frequency_count = hot_frequency_count;
             if(frequency) {
                 subghz_frequency_analyzer_log_frequency_update(
                     model, frequency != instance->last_frequency);
@@ -402,6 +447,7 @@ void subghz_frequency_analyzer_enter(void* context) {
             model->log_frequency_scroll_offset = 0;
             model->history_frequency[0] = model->history_frequency[1] =
                 model->history_frequency[2] = 0;
+            model->hot_frequency_count = 0;
             SubGhzFrequencyAnalyzerLogItemArray_init(model->log_frequency);
         },
         true);
@@ -428,6 +474,7 @@ void subghz_frequency_analyzer_exit(void* context) {
             model->log_frequency_scroll_offset = 0;
             model->history_frequency[0] = model->history_frequency[1] =
                 model->history_frequency[2] = 0;
+            model->hot_frequency_count = 0;
             SubGhzFrequencyAnalyzerLogItemArray_clear(model->log_frequency);
         },
         true);
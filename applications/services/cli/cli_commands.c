@@ -8,6 +8,7 @@
 #include <notification/notification_messages.h>
 #include <loader/loader.h>
 #include <lib/toolbox/args.h>
+#include <lib/toolbox/profiler.h>
 
 // Close to ISO, `date +'%Y-%m-%d %H:%M:%S %u'`
 #define CLI_DATE_FORMAT "%.4d-%.2d-%.2d %.2d:%.2d:%.2d %d"
@@ -423,6 +424,18 @@ void cli_command_free(Cli* cli, FuriString* args, void* context) {
 
     printf("Pool free: %zu\r\n", memmgr_pool_get_free());
     printf("Maximum pool block: %zu\r\n", memmgr_pool_get_max_block());
+
+    printf("\r\n%-8s %-8s %-10s %s\r\n", "Class", "Cached", "Hits", "Misses");
+    for(size_t i = 0; i < memmgr_heap_get_pool_count(); i++) {
+        MemmgrHeapPoolStats stats;
+        memmgr_heap_get_pool_stats(i, &stats);
+        printf(
+            "%-8zu %-8zu %-10zu %zu\r\n",
+            stats.block_size,
+            stats.cached,
+            stats.hits,
+            stats.misses);
+    }
 }
 
 void cli_command_free_blocks(Cli* cli, FuriString* args, void* context) {
@@ -433,6 +446,72 @@ void cli_command_free_blocks(Cli* cli, FuriString* args, void* context) {
     memmgr_heap_printf_free_blocks();
 }
 
+void cli_command_heap_profile(Cli* cli, FuriString* args, void* context) {
+    UNUSED(cli);
+    UNUSED(context);
+    FuriString* cmd;
+    cmd = furi_string_alloc();
+
+    do {
+        if(!args_read_string_and_trim(args, cmd)) {
+            memmgr_heap_printf_profile();
+            break;
+        }
+
+        if(furi_string_cmp_str(cmd, "start") == 0) {
+            int period = 0;
+            if(!args_read_int_and_trim(args, &period) || period <= 0) {
+                period = 1;
+            }
+            memmgr_heap_profiler_start(period);
+            printf("Sampling every %d allocation(s)\r\n", period);
+            break;
+        }
+
+        if(furi_string_cmp_str(cmd, "stop") == 0) {
+            memmgr_heap_profiler_stop();
+            break;
+        }
+
+        cli_print_usage("heap_profile", "<start [period]|stop>", furi_string_get_cstr(cmd));
+    } while(false);
+
+    furi_string_free(cmd);
+}
+
+void cli_command_probe(Cli* cli, FuriString* args, void* context) {
+    UNUSED(cli);
+    UNUSED(context);
+    FuriString* cmd;
+    cmd = furi_string_alloc();
+
+    do {
+        if(!args_read_string_and_trim(args, cmd)) {
+            profiler_probe_dump();
+            break;
+        }
+
+        if(furi_string_cmp_str(cmd, "start") == 0) {
+            profiler_probe_enable(true);
+            break;
+        }
+
+        if(furi_string_cmp_str(cmd, "stop") == 0) {
+            profiler_probe_enable(false);
+            break;
+        }
+
+        if(furi_string_cmp_str(cmd, "reset") == 0) {
+            profiler_probe_reset();
+            break;
+        }
+
+        cli_print_usage("probe", "<start|stop|reset>", furi_string_get_cstr(cmd));
+    } while(false);
+
+    furi_string_free(cmd);
+}
+
 void cli_command_i2c(Cli* cli, FuriString* args, void* context) {
     UNUSED(cli);
     UNUSED(args);
@@ -471,6 +550,9 @@ void cli_commands_init(Cli* cli) {
     cli_add_command(cli, "ps", CliCommandFlagParallelSafe, cli_command_ps, NULL);
     cli_add_command(cli, "free", CliCommandFlagParallelSafe, cli_command_free, NULL);
     cli_add_command(cli, "free_blocks", CliCommandFlagParallelSafe, cli_command_free_blocks, NULL);
+    cli_add_command(
+        cli, "heap_profile", CliCommandFlagParallelSafe, cli_command_heap_profile, NULL);
+    cli_add_command(cli, "probe", CliCommandFlagParallelSafe, cli_command_probe, NULL);
 
     cli_add_command(cli, "vibro", CliCommandFlagDefault, cli_command_vibro, NULL);
     cli_add_command(cli, "led", CliCommandFlagDefault, cli_command_led, NULL);
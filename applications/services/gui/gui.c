@@ -1,5 +1,6 @@
 #include "gui_i.h"
 #include <assets_icons.h>
+#include <toolbox/profiler.h>
 
 #define TAG "GuiSrv"
 
@@ -243,6 +244,7 @@ static bool gui_redraw_desktop(Gui* gui) {
 static void gui_redraw(Gui* gui) {
     furi_assert(gui);
     gui_lock(gui);
+    ProfilerProbeStart probe = profiler_probe_begin();
 
     do {
         if(gui->direct_draw) break;
@@ -275,6 +277,7 @@ static void gui_redraw(Gui* gui) {
             }
     } while(false);
 
+    profiler_probe_end(ProfilerProbeGuiRedraw, probe);
     gui_unlock(gui);
 }
 
@@ -1,6 +1,7 @@
 #include "storage_processing.h"
 #include <m-list.h>
 #include <m-dict.h>
+#include <toolbox/profiler.h>
 
 #define STORAGE_PATH_PREFIX_LEN 4u
 _Static_assert(
@@ -726,5 +727,7 @@ void storage_process_message_internal(Storage* app, StorageMessage* message) {
 }
 
 void storage_process_message(Storage* app, StorageMessage* message) {
+    ProfilerProbeStart probe = profiler_probe_begin();
     storage_process_message_internal(app, message);
+    profiler_probe_end(ProfilerProbeStorageProcessMessage, probe);
 }
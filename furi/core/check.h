@@ -14,6 +14,7 @@
 #pragma once
 
 #include <m-core.h>
+#include <stdint.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -33,6 +34,7 @@ FURI_NORETURN void __furi_crash_implementation();
 /** Halt system */
 FURI_NORETURN void __furi_halt_implementation();
 
+#if defined(__arm__)
 /** Crash system with message. Show message after reboot. */
 #define __furi_crash(message)                                 \
     do {                                                      \
@@ -40,6 +42,17 @@ FURI_NORETURN void __furi_halt_implementation();
         asm volatile("sukima%=:" : : "r"(r12));               \
         __furi_crash_implementation();                        \
     } while(0)
+#else
+/** Crash message storage, passed in r12 on target */
+extern const char* __furi_check_message;
+
+/** Crash system with message. */
+#define __furi_crash(message)                                     \
+    do {                                                          \
+        __furi_check_message = (const char*)(uintptr_t)(message); \
+        __furi_crash_implementation();                            \
+    } while(0)
+#endif
 
 /** Crash system
  *
@@ -47,6 +60,7 @@ FURI_NORETURN void __furi_halt_implementation();
  */
 #define furi_crash(...) M_APPLY(__furi_crash, M_IF_EMPTY(__VA_ARGS__)((NULL), (__VA_ARGS__)))
 
+#if defined(__arm__)
 /** Halt system with message. */
 #define __furi_halt(message)                                  \
     do {                                                      \
@@ -54,6 +68,14 @@ FURI_NORETURN void __furi_halt_implementation();
         asm volatile("sukima%=:" : : "r"(r12));               \
         __furi_halt_implementation();                         \
     } while(0)
+#else
+/** Halt system with message. */
+#define __furi_halt(message)                                      \
+    do {                                                          \
+        __furi_check_message = (const char*)(uintptr_t)(message); \
+        __furi_halt_implementation();                             \
+    } while(0)
+#endif
 
 /** Halt system
  *
@@ -0,0 +1,570 @@
+#include "event_loop.h"
+#include "event_loop_link_i.h"
+
+#include "check.h"
+#include "common_defines.h"
+#include "kernel.h"
+#include "memmgr.h"
+#include "thread.h"
+
+#include <FreeRTOS.h>
+#include <task.h>
+
+#define TAG "FuriEventLoop"
+
+extern const FuriEventLoopContract furi_message_queue_event_loop_contract;
+extern const FuriEventLoopContract furi_stream_buffer_event_loop_contract;
+
+typedef void (*FuriEventLoopItemCallback)(void* object, void* context);
+
+struct FuriEventLoopItem {
+    FuriEventLoop* owner;
+
+    const FuriEventLoopContract* contract;
+    void* object;
+    FuriEventLoopEvent event;
+
+    FuriEventLoopItemCallback callback;
+    void* context;
+
+    // Pending list, protected by critical section
+    FuriEventLoopItem* next;
+    bool pending;
+    // Unsubscribed from inside of own callback, release after it returns
+    bool released;
+};
+
+struct FuriEventLoopTimer {
+    FuriEventLoop* owner;
+    FuriEventLoopTimer* next;
+
+    FuriEventLoopTimerCallback callback;
+    void* context;
+    FuriEventLoopTimerType type;
+
+    uint32_t interval;
+    uint32_t start_time;
+    bool running;
+    bool pending; /**< Was due when timers processing started */
+};
+
+struct FuriEventLoop {
+    FuriThreadId thread_id;
+
+    // Items with pending events, protected by critical section
+    FuriEventLoopItem* pending_head;
+    FuriEventLoopItem* pending_tail;
+    size_t pending_count;
+
+    // Item which callback is in progress
+    FuriEventLoopItem* current_item;
+    size_t item_count;
+
+    FuriEventLoopTimer* timer_head;
+
+    uint32_t thread_flags;
+    FuriEventLoopThreadFlagsCallback thread_flags_callback;
+    void* thread_flags_context;
+    FuriEventLoop* thread_flags_next;
+};
+
+// Loops subscribed to thread flags, protected by critical section
+static FuriEventLoop* furi_event_loop_thread_flags_head = NULL;
+
+FuriEventLoop* furi_event_loop_alloc(void) {
+    FuriEventLoop* instance = malloc(sizeof(FuriEventLoop));
+
+    instance->thread_id = furi_thread_get_current_id();
+    furi_check(instance->thread_id);
+
+    // Drop notifications left from previous event loop in this thread
+    (void)xTaskNotifyStateClearIndexed(NULL, FURI_EVENT_LOOP_NOTIFY_INDEX);
+    (void)ulTaskNotifyValueClearIndexed(NULL, FURI_EVENT_LOOP_NOTIFY_INDEX, 0xFFFFFFFF);
+
+    return instance;
+}
+
+void furi_event_loop_free(FuriEventLoop* instance) {
+    furi_check(instance);
+    furi_check(instance->thread_id == furi_thread_get_current_id());
+    furi_check(instance->item_count == 0);
+    furi_check(instance->timer_head == NULL);
+    furi_check(instance->thread_flags_callback == NULL);
+
+    free(instance);
+}
+
+static void furi_event_loop_notify(FuriEventLoop* instance, FuriEventLoopFlag flag) {
+    if(FURI_IS_IRQ_MODE()) {
+        BaseType_t yield = pdFALSE;
+        (void)xTaskNotifyIndexedFromISR(
+            instance->thread_id, FURI_EVENT_LOOP_NOTIFY_INDEX, flag, eSetBits, &yield);
+        portYIELD_FROM_ISR(yield);
+    } else {
+        (void)xTaskNotifyIndexed(
+            instance->thread_id, FURI_EVENT_LOOP_NOTIFY_INDEX, flag, eSetBits);
+    }
+}
+
+/* Pending list operations, must be called in critical section */
+
+static bool furi_event_loop_item_set_pending(FuriEventLoopItem* item) {
+    if(item->pending) return false;
+
+    FuriEventLoop* instance = item->owner;
+    item->pending = true;
+    item->next = NULL;
+    if(instance->pending_tail) {
+        instance->pending_tail->next = item;
+    } else {
+        instance->pending_head = item;
+    }
+    instance->pending_tail = item;
+    instance->pending_count++;
+
+    return true;
+}
+
+static FuriEventLoopItem* furi_event_loop_pop_pending(FuriEventLoop* instance) {
+    FuriEventLoopItem* item = instance->pending_head;
+
+    if(item) {
+        instance->pending_head = item->next;
+        if(instance->pending_head == NULL) {
+            instance->pending_tail = NULL;
+        }
+        instance->pending_count--;
+        item->next = NULL;
+        item->pending = false;
+    }
+
+    return item;
+}
+
+static void furi_event_loop_remove_pending(FuriEventLoopItem* item) {
+    if(!item->pending) return;
+
+    FuriEventLoop* instance = item->owner;
+    FuriEventLoopItem* previous = NULL;
+    for(FuriEventLoopItem* it = instance->pending_head; it; it = it->next) {
+        if(it == item) {
+            if(previous) {
+                previous->next = item->next;
+            } else {
+                instance->pending_head = item->next;
+            }
+            if(instance->pending_tail == item) {
+                instance->pending_tail = previous;
+            }
+            instance->pending_count--;
+            break;
+        }
+        previous = it;
+    }
+
+    item->next = NULL;
+    item->pending = false;
+}
+
+/* Link glue */
+
+static FuriEventLoopItem** furi_event_loop_link_get_slot(
+    FuriEventLoopLink* link,
+    FuriEventLoopEvent event) {
+    return (event == FuriEventLoopEventIn) ? &link->item_in : &link->item_out;
+}
+
+void furi_event_loop_link_notify(FuriEventLoopLink* link, FuriEventLoopEvent event) {
+    furi_assert(link);
+
+    // Fast path for primitives nobody is subscribed to. Subscriber checks level
+    // on subscription, so event racing with it is not lost.
+    if(*furi_event_loop_link_get_slot(link, event) == NULL) return;
+
+    FuriEventLoop* owner = NULL;
+
+    FURI_CRITICAL_ENTER();
+    FuriEventLoopItem* item = *furi_event_loop_link_get_slot(link, event);
+    // Already pending items are processed anyway, no need to wake loop again
+    if(item && furi_event_loop_item_set_pending(item)) {
+        owner = item->owner;
+    }
+    FURI_CRITICAL_EXIT();
+
+    if(owner) {
+        furi_event_loop_notify(owner, FuriEventLoopFlagEvent);
+    }
+}
+
+void furi_event_loop_link_check_unused(FuriEventLoopLink* link) {
+    furi_check(link->item_in == NULL);
+    furi_check(link->item_out == NULL);
+}
+
+void furi_event_loop_thread_flags_notify(FuriThreadId thread_id) {
+    // Only threads running a loop with thread flags subscription are woken up
+    bool subscribed = false;
+    FURI_CRITICAL_ENTER();
+    for(FuriEventLoop* instance = furi_event_loop_thread_flags_head; instance;
+        instance = instance->thread_flags_next) {
+        if(instance->thread_id == thread_id) {
+            subscribed = true;
+            break;
+        }
+    }
+    FURI_CRITICAL_EXIT();
+
+    if(!subscribed) return;
+
+    if(FURI_IS_IRQ_MODE()) {
+        BaseType_t yield = pdFALSE;
+        (void)xTaskNotifyIndexedFromISR(
+            thread_id,
+            FURI_EVENT_LOOP_NOTIFY_INDEX,
+            FuriEventLoopFlagThreadFlags,
+            eSetBits,
+            &yield);
+        portYIELD_FROM_ISR(yield);
+    } else {
+        (void)xTaskNotifyIndexed(
+            thread_id, FURI_EVENT_LOOP_NOTIFY_INDEX, FuriEventLoopFlagThreadFlags, eSetBits);
+    }
+}
+
+/* Subscriptions */
+
+static void furi_event_loop_subscribe(
+    FuriEventLoop* instance,
+    const FuriEventLoopContract* contract,
+    void* object,
+    FuriEventLoopEvent event,
+    FuriEventLoopItemCallback callback,
+    void* context) {
+    furi_check(instance);
+    furi_check(instance->thread_id == furi_thread_get_current_id());
+    furi_check(object);
+    furi_check(callback);
+    furi_check(event == FuriEventLoopEventIn || event == FuriEventLoopEventOut);
+
+    FuriEventLoopItem* item = malloc(sizeof(FuriEventLoopItem));
+    item->owner = instance;
+    item->contract = contract;
+    item->object = object;
+    item->event = event;
+    item->callback = callback;
+    item->context = context;
+
+    FuriEventLoopLink* link = contract->get_link(object);
+
+    FURI_CRITICAL_ENTER();
+    FuriEventLoopItem** slot = furi_event_loop_link_get_slot(link, event);
+    furi_check(*slot == NULL);
+    *slot = item;
+    FURI_CRITICAL_EXIT();
+
+    instance->item_count++;
+
+    // Condition may hold already, nobody will notify us about it
+    if(contract->get_level(object, event)) {
+        furi_event_loop_link_notify(link, event);
+    }
+}
+
+static void furi_event_loop_unsubscribe(
+    FuriEventLoop* instance,
+    const FuriEventLoopContract* contract,
+    void* object,
+    FuriEventLoopEvent event) {
+    furi_check(instance);
+    furi_check(instance->thread_id == furi_thread_get_current_id());
+    furi_check(object);
+
+    FuriEventLoopLink* link = contract->get_link(object);
+
+    FURI_CRITICAL_ENTER();
+    FuriEventLoopItem** slot = furi_event_loop_link_get_slot(link, event);
+    FuriEventLoopItem* item = *slot;
+    furi_check(item && item->owner == instance);
+    *slot = NULL;
+    furi_event_loop_remove_pending(item);
+    FURI_CRITICAL_EXIT();
+
+    instance->item_count--;
+
+    if(item == instance->current_item) {
+        item->released = true;
+    } else {
+        free(item);
+    }
+}
+
+void furi_event_loop_message_queue_subscribe(
+    FuriEventLoop* instance,
+    FuriMessageQueue* message_queue,
+    FuriEventLoopEvent event,
+    FuriEventLoopMessageQueueCallback callback,
+    void* context) {
+    furi_event_loop_subscribe(
+        instance,
+        &furi_message_queue_event_loop_contract,
+        message_queue,
+        event,
+        (FuriEventLoopItemCallback)callback,
+        context);
+}
+
+void furi_event_loop_message_queue_unsubscribe(
+    FuriEventLoop* instance,
+    FuriMessageQueue* message_queue,
+    FuriEventLoopEvent event) {
+    furi_event_loop_unsubscribe(
+        instance, &furi_message_queue_event_loop_contract, message_queue, event);
+}
+
+void furi_event_loop_stream_buffer_subscribe(
+    FuriEventLoop* instance,
+    FuriStreamBuffer* stream_buffer,
+    FuriEventLoopEvent event,
+    FuriEventLoopStreamBufferCallback callback,
+    void* context) {
+    furi_event_loop_subscribe(
+        instance,
+        &furi_stream_buffer_event_loop_contract,
+        stream_buffer,
+        event,
+        (FuriEventLoopItemCallback)callback,
+        context);
+}
+
+void furi_event_loop_stream_buffer_unsubscribe(
+    FuriEventLoop* instance,
+    FuriStreamBuffer* stream_buffer,
+    FuriEventLoopEvent event) {
+    furi_event_loop_unsubscribe(
+        instance, &furi_stream_buffer_event_loop_contract, stream_buffer, event);
+}
+
+void furi_event_loop_thread_flags_subscribe(
+    FuriEventLoop* instance,
+    uint32_t flags,
+    FuriEventLoopThreadFlagsCallback callback,
+    void* context) {
+    furi_check(instance);
+    furi_check(instance->thread_id == furi_thread_get_current_id());
+    furi_check(instance->thread_flags_callback == NULL);
+    furi_check(flags);
+    furi_check(callback);
+
+    instance->thread_flags = flags;
+    instance->thread_flags_callback = callback;
+    instance->thread_flags_context = context;
+
+    FURI_CRITICAL_ENTER();
+    instance->thread_flags_next = furi_event_loop_thread_flags_head;
+    furi_event_loop_thread_flags_head = instance;
+    FURI_CRITICAL_EXIT();
+
+    // Flags may be set already, check them on the next iteration
+    furi_event_loop_thread_flags_notify(instance->thread_id);
+}
+
+void furi_event_loop_thread_flags_unsubscribe(FuriEventLoop* instance) {
+    furi_check(instance);
+    furi_check(instance->thread_id == furi_thread_get_current_id());
+    if(!instance->thread_flags_callback) return;
+
+    FURI_CRITICAL_ENTER();
+    FuriEventLoop** it = &furi_event_loop_thread_flags_head;
+    while(*it != instance) {
+        furi_check(*it);
+        it = &(*it)->thread_flags_next;
+    }
+    *it = instance->thread_flags_next;
+    instance->thread_flags_next = NULL;
+    FURI_CRITICAL_EXIT();
+
+    instance->thread_flags = 0;
+    instance->thread_flags_callback = NULL;
+    instance->thread_flags_context = NULL;
+}
+
+/* Timers */
+
+FuriEventLoopTimer* furi_event_loop_timer_alloc(
+    FuriEventLoop* instance,
+    FuriEventLoopTimerCallback callback,
+    FuriEventLoopTimerType type,
+    void* context) {
+    furi_check(instance);
+    furi_check(instance->thread_id == furi_thread_get_current_id());
+    furi_check(callback);
+
+    FuriEventLoopTimer* timer = malloc(sizeof(FuriEventLoopTimer));
+    timer->owner = instance;
+    timer->callback = callback;
+    timer->type = type;
+    timer->context = context;
+
+    timer->next = instance->timer_head;
+    instance->timer_head = timer;
+
+    return timer;
+}
+
+void furi_event_loop_timer_free(FuriEventLoopTimer* timer) {
+    furi_check(timer);
+    FuriEventLoop* instance = timer->owner;
+    furi_check(instance->thread_id == furi_thread_get_current_id());
+
+    FuriEventLoopTimer** it = &instance->timer_head;
+    while(*it != timer) {
+        furi_check(*it);
+        it = &(*it)->next;
+    }
+    *it = timer->next;
+
+    free(timer);
+}
+
+void furi_event_loop_timer_start(FuriEventLoopTimer* timer, uint32_t interval) {
+    furi_check(timer);
+    furi_check(timer->owner->thread_id == furi_thread_get_current_id());
+
+    timer->interval = interval;
+    timer->start_time = furi_get_tick();
+    timer->running = true;
+}
+
+void furi_event_loop_timer_stop(FuriEventLoopTimer* timer) {
+    furi_check(timer);
+    furi_check(timer->owner->thread_id == furi_thread_get_current_id());
+
+    timer->running = false;
+}
+
+bool furi_event_loop_timer_is_running(FuriEventLoopTimer* timer) {
+    furi_check(timer);
+    return timer->running;
+}
+
+static uint32_t furi_event_loop_timers_get_timeout(FuriEventLoop* instance) {
+    uint32_t timeout = FuriWaitForever;
+    const uint32_t now = furi_get_tick();
+
+    for(FuriEventLoopTimer* timer = instance->timer_head; timer; timer = timer->next) {
+        if(!timer->running) continue;
+
+        const uint32_t elapsed = now - timer->start_time;
+        const uint32_t remaining = (elapsed < timer->interval) ? timer->interval - elapsed : 0;
+        timeout = MIN(timeout, remaining);
+    }
+
+    return timeout;
+}
+
+static bool furi_event_loop_timer_is_due(FuriEventLoopTimer* timer) {
+    return timer->running && (furi_get_tick() - timer->start_time) >= timer->interval;
+}
+
+static void furi_event_loop_timers_process(FuriEventLoop* instance) {
+    for(FuriEventLoopTimer* timer = instance->timer_head; timer; timer = timer->next) {
+        timer->pending = furi_event_loop_timer_is_due(timer);
+    }
+
+    // Callback may free any timer, so the walk starts over from the head after
+    // each callback. Fired timers are not pending anymore, freed ones are gone.
+    FuriEventLoopTimer* timer = instance->timer_head;
+    while(timer) {
+        if(!timer->pending) {
+            timer = timer->next;
+            continue;
+        }
+
+        timer->pending = false;
+        // Stopped or restarted by a callback of another timer
+        if(furi_event_loop_timer_is_due(timer)) {
+            if(timer->type == FuriEventLoopTimerTypePeriodic) {
+                // Keep period stable, even if callback was delayed
+                timer->start_time += timer->interval;
+            } else {
+                timer->running = false;
+            }
+            timer->callback(timer->context);
+        }
+
+        timer = instance->timer_head;
+    }
+}
+
+/* Run loop */
+
+static void furi_event_loop_process_pending(FuriEventLoop* instance) {
+    // Items which are still ready after callback go to the end of the list,
+    // process only those that were pending on entry to not starve others
+    FURI_CRITICAL_ENTER();
+    size_t count = instance->pending_count;
+    FURI_CRITICAL_EXIT();
+
+    while(count--) {
+        FURI_CRITICAL_ENTER();
+        FuriEventLoopItem* item = furi_event_loop_pop_pending(instance);
+        FURI_CRITICAL_EXIT();
+
+        if(!item) break;
+
+        instance->current_item = item;
+        item->callback(item->object, item->context);
+        instance->current_item = NULL;
+
+        if(item->released) {
+            free(item);
+        } else if(item->contract->get_level(item->object, item->event)) {
+            // Level triggered: condition still holds
+            FURI_CRITICAL_ENTER();
+            furi_event_loop_item_set_pending(item);
+            FURI_CRITICAL_EXIT();
+        }
+    }
+}
+
+static void furi_event_loop_process_thread_flags(FuriEventLoop* instance) {
+    if(!instance->thread_flags_callback) return;
+
+    uint32_t flags = furi_thread_flags_wait(instance->thread_flags, FuriFlagWaitAny, 0);
+    if((flags & FuriFlagError) == 0) {
+        instance->thread_flags_callback(flags, instance->thread_flags_context);
+    }
+}
+
+void furi_event_loop_run(FuriEventLoop* instance) {
+    furi_check(instance);
+    furi_check(instance->thread_id == furi_thread_get_current_id());
+
+    while(true) {
+        uint32_t timeout =
+            instance->pending_count ? 0 : furi_event_loop_timers_get_timeout(instance);
+
+        uint32_t flags = 0;
+        BaseType_t ret = xTaskNotifyWaitIndexed(
+            FURI_EVENT_LOOP_NOTIFY_INDEX, 0, FuriEventLoopFlagAll, &flags, timeout);
+
+        if(ret == pdTRUE) {
+            if(flags & FuriEventLoopFlagStop) {
+                break;
+            }
+
+            if(flags & FuriEventLoopFlagThreadFlags) {
+                furi_event_loop_process_thread_flags(instance);
+            }
+        }
+
+        furi_event_loop_process_pending(instance);
+        furi_event_loop_timers_process(instance);
+    }
+}
+
+void furi_event_loop_stop(FuriEventLoop* instance) {
+    furi_check(instance);
+
+    furi_event_loop_notify(instance, FuriEventLoopFlagStop);
+}
@@ -0,0 +1,226 @@
+/**
+ * @file event_loop.h
+ * @brief      Furi Event Loop
+ *
+ *             This module is designed to handle application event loop in fully
+ *             asynchronous, reactive nature. Event loop dispatches callbacks for
+ *             message queues, stream buffers, thread flags and its own timers
+ *             from a single thread, so there is no need for polling threads
+ *             waiting on every primitive with timeouts.
+ *
+ *             Event loop instance is bound to the thread it was allocated in:
+ *             all subscriptions, timers and run must be done from that thread.
+ *             Stop can be requested from any thread or interrupt.
+ */
+#pragma once
+
+#include "base.h"
+#include "message_queue.h"
+#include "stream_buffer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Event loop events */
+typedef enum {
+    FuriEventLoopEventIn, /**< Subscribe to In events: object has data to read */
+    FuriEventLoopEventOut, /**< Subscribe to Out events: object has space to write */
+} FuriEventLoopEvent;
+
+/** Anonymous message queue callback type
+ *
+ * @param      queue    The queue that triggered the event
+ * @param      context  The context that was provided on subscribe
+ */
+typedef void (*FuriEventLoopMessageQueueCallback)(FuriMessageQueue* queue, void* context);
+
+/** Anonymous stream buffer callback type
+ *
+ * @param      stream_buffer  The stream buffer that triggered the event
+ * @param      context        The context that was provided on subscribe
+ */
+typedef void (*FuriEventLoopStreamBufferCallback)(
+    FuriStreamBuffer* stream_buffer,
+    void* context);
+
+/** Anonymous thread flags callback type
+ *
+ * @param      flags    Subscribed thread flags that were set, already cleared
+ * @param      context  The context that was provided on subscribe
+ */
+typedef void (*FuriEventLoopThreadFlagsCallback)(uint32_t flags, void* context);
+
+/** Anonymous timer callback type
+ *
+ * @param      context  The context that was provided on timer allocation
+ */
+typedef void (*FuriEventLoopTimerCallback)(void* context);
+
+/** Event loop timer types */
+typedef enum {
+    FuriEventLoopTimerTypeOnce, /**< One-shot timer */
+    FuriEventLoopTimerTypePeriodic, /**< Repeating timer */
+} FuriEventLoopTimerType;
+
+typedef struct FuriEventLoop FuriEventLoop;
+
+typedef struct FuriEventLoopTimer FuriEventLoopTimer;
+
+/** Allocate event loop instance, bound to the current thread
+ *
+ * @return     The Event Loop instance
+ */
+FuriEventLoop* furi_event_loop_alloc(void);
+
+/** Free event loop instance
+ *
+ * @warning    all subscriptions and timers must be released before
+ *
+ * @param      instance  The Event Loop instance
+ */
+void furi_event_loop_free(FuriEventLoop* instance);
+
+/** Run event loop
+ *
+ * Dispatches events until furi_event_loop_stop is called
+ *
+ * @param      instance  The Event Loop instance
+ */
+void furi_event_loop_run(FuriEventLoop* instance);
+
+/** Stop event loop
+ *
+ * Can be called from any thread or interrupt, loop will return from
+ * furi_event_loop_run after the current callback
+ *
+ * @param      instance  The Event Loop instance
+ */
+void furi_event_loop_stop(FuriEventLoop* instance);
+
+/** Subscribe to message queue events
+ *
+ * Events are level triggered: callback is called while condition holds, so
+ * callback must read (for In) or write (for Out) the queue.
+ *
+ * @param      instance       The Event Loop instance
+ * @param      message_queue  The message queue to watch
+ * @param[in]  event          The event to subscribe to
+ * @param[in]  callback       The callback to call on event
+ * @param      context        The context for callback
+ */
+void furi_event_loop_message_queue_subscribe(
+    FuriEventLoop* instance,
+    FuriMessageQueue* message_queue,
+    FuriEventLoopEvent event,
+    FuriEventLoopMessageQueueCallback callback,
+    void* context);
+
+/** Unsubscribe from message queue events
+ *
+ * @param      instance       The Event Loop instance
+ * @param      message_queue  The message queue
+ * @param[in]  event          The event to unsubscribe from
+ */
+void furi_event_loop_message_queue_unsubscribe(
+    FuriEventLoop* instance,
+    FuriMessageQueue* message_queue,
+    FuriEventLoopEvent event);
+
+/** Subscribe to stream buffer events
+ *
+ * Events are level triggered: callback is called while condition holds, so
+ * callback must receive (for In) or send (for Out) data.
+ *
+ * @param      instance       The Event Loop instance
+ * @param      stream_buffer  The stream buffer to watch
+ * @param[in]  event          The event to subscribe to
+ * @param[in]  callback       The callback to call on event
+ * @param      context        The context for callback
+ */
+void furi_event_loop_stream_buffer_subscribe(
+    FuriEventLoop* instance,
+    FuriStreamBuffer* stream_buffer,
+    FuriEventLoopEvent event,
+    FuriEventLoopStreamBufferCallback callback,
+    void* context);
+
+/** Unsubscribe from stream buffer events
+ *
+ * @param      instance       The Event Loop instance
+ * @param      stream_buffer  The stream buffer
+ * @param[in]  event          The event to unsubscribe from
+ */
+void furi_event_loop_stream_buffer_unsubscribe(
+    FuriEventLoop* instance,
+    FuriStreamBuffer* stream_buffer,
+    FuriEventLoopEvent event);
+
+/** Subscribe to flags of the event loop thread
+ *
+ * Subscribed flags are cleared before callback is called
+ *
+ * @param      instance  The Event Loop instance
+ * @param[in]  flags     The flags to watch
+ * @param[in]  callback  The callback to call when any of the flags is set
+ * @param      context   The context for callback
+ */
+void furi_event_loop_thread_flags_subscribe(
+    FuriEventLoop* instance,
+    uint32_t flags,
+    FuriEventLoopThreadFlagsCallback callback,
+    void* context);
+
+/** Unsubscribe from thread flags
+ *
+ * @param      instance  The Event Loop instance
+ */
+void furi_event_loop_thread_flags_unsubscribe(FuriEventLoop* instance);
+
+/** Allocate event loop timer
+ *
+ * Timer callback is called from the event loop thread
+ *
+ * @param      instance  The Event Loop instance
+ * @param[in]  callback  The callback to call on timer expiration
+ * @param[in]  type      The timer type
+ * @param      context   The context for callback
+ *
+ * @return     The Event Loop Timer instance
+ */
+FuriEventLoopTimer* furi_event_loop_timer_alloc(
+    FuriEventLoop* instance,
+    FuriEventLoopTimerCallback callback,
+    FuriEventLoopTimerType type,
+    void* context);
+
+/** Free event loop timer
+ *
+ * @param      timer  The Event Loop Timer instance
+ */
+void furi_event_loop_timer_free(FuriEventLoopTimer* timer);
+
+/** Start event loop timer, restart if it is already running
+ *
+ * @param      timer     The Event Loop Timer instance
+ * @param[in]  interval  The interval in ticks
+ */
+void furi_event_loop_timer_start(FuriEventLoopTimer* timer, uint32_t interval);
+
+/** Stop event loop timer
+ *
+ * @param      timer  The Event Loop Timer instance
+ */
+void furi_event_loop_timer_stop(FuriEventLoopTimer* timer);
+
+/** Check if event loop timer is running
+ *
+ * @param      timer  The Event Loop Timer instance
+ *
+ * @return     true if timer is running
+ */
+bool furi_event_loop_timer_is_running(FuriEventLoopTimer* timer);
+
+#ifdef __cplusplus
+}
+#endif
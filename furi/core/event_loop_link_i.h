@@ -0,0 +1,70 @@
+/**
+ * @file event_loop_link_i.h
+ * Furi Event Loop: internal glue for primitives that can be subscribed to
+ */
+#pragma once
+
+#include "event_loop.h"
+#include "thread.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Notification index reserved for event loop, 0 is used by stream buffers and
+ * 1 by thread flags */
+#define FURI_EVENT_LOOP_NOTIFY_INDEX (2)
+
+/** Event loop notification bits */
+typedef enum {
+    FuriEventLoopFlagEvent = (1 << 0),
+    FuriEventLoopFlagStop = (1 << 1),
+    FuriEventLoopFlagThreadFlags = (1 << 2),
+} FuriEventLoopFlag;
+
+#define FuriEventLoopFlagAll \
+    (FuriEventLoopFlagEvent | FuriEventLoopFlagStop | FuriEventLoopFlagThreadFlags)
+
+typedef struct FuriEventLoopItem FuriEventLoopItem;
+
+/** Subscription storage, must be embedded into the primitive and zeroed */
+typedef struct {
+    FuriEventLoopItem* item_in;
+    FuriEventLoopItem* item_out;
+} FuriEventLoopLink;
+
+/** Get event loop link of the primitive */
+typedef FuriEventLoopLink* (*FuriEventLoopContractGetLink)(void* object);
+
+/** Get level of the primitive for the event: non zero if event condition holds */
+typedef uint32_t (*FuriEventLoopContractGetLevel)(void* object, FuriEventLoopEvent event);
+
+/** Description of primitive that can be subscribed to */
+typedef struct {
+    const FuriEventLoopContractGetLink get_link;
+    const FuriEventLoopContractGetLevel get_level;
+} FuriEventLoopContract;
+
+/** Notify subscribed event loop about the event, can be used from ISR
+ *
+ * @param      link   The primitive event loop link
+ * @param[in]  event  The event that happened
+ */
+void furi_event_loop_link_notify(FuriEventLoopLink* link, FuriEventLoopEvent event);
+
+/** Check that nothing is subscribed to the primitive, must be called on free
+ *
+ * @param      link   The primitive event loop link
+ */
+void furi_event_loop_link_check_unused(FuriEventLoopLink* link);
+
+/** Notify event loop, if any, running in the thread that thread flags changed,
+ * can be used from ISR
+ *
+ * @param      thread_id  The thread which flags were set
+ */
+void furi_event_loop_thread_flags_notify(FuriThreadId thread_id);
+
+#ifdef __cplusplus
+}
+#endif
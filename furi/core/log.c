@@ -3,6 +3,7 @@
 #include "mutex.h"
 #include <furi_hal.h>
 #include <m-list.h>
+#include <inttypes.h>
 
 LIST_DEF(FuriLogHandlersList, FuriLogHandler, M_POD_OPLIST)
 
@@ -142,7 +143,12 @@ void furi_log_print_format(FuriLogLevel level, const char* tag, const char* form
 
         // Timestamp
         furi_string_printf(
-            string, "%lu %s[%s][%s] " _FURI_LOG_CLR_RESET, furi_get_tick(), color, log_letter, tag);
+            string,
+            "%" PRIu32 " %s[%s][%s] " _FURI_LOG_CLR_RESET,
+            furi_get_tick(),
+            color,
+            log_letter,
+            tag);
         furi_log_puts(furi_string_get_cstr(string));
         furi_string_reset(string);
 
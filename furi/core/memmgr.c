@@ -5,11 +5,14 @@
 
 extern void* pvPortMalloc(size_t xSize);
 extern void vPortFree(void* pv);
+extern void* pvPortRealloc(void* pv, size_t xSize);
+extern void memmgr_heap_profiler_sample(const void* pc, size_t size);
 extern size_t xPortGetFreeHeapSize(void);
 extern size_t xPortGetTotalHeapSize(void);
 extern size_t xPortGetMinimumEverFreeHeapSize(void);
 
 void* malloc(size_t size) {
+    memmgr_heap_profiler_sample(__builtin_return_address(0), size);
     return pvPortMalloc(size);
 }
 
@@ -18,21 +21,12 @@ void free(void* ptr) {
 }
 
 void* realloc(void* ptr, size_t size) {
-    if(size == 0) {
-        vPortFree(ptr);
-        return NULL;
-    }
-
-    void* p = pvPortMalloc(size);
-    if(ptr != NULL) {
-        memcpy(p, ptr, size);
-        vPortFree(ptr);
-    }
-
-    return p;
+    memmgr_heap_profiler_sample(__builtin_return_address(0), size);
+    return pvPortRealloc(ptr, size);
 }
 
 void* calloc(size_t count, size_t size) {
+    memmgr_heap_profiler_sample(__builtin_return_address(0), count * size);
     return pvPortMalloc(count * size);
 }
 
@@ -41,6 +35,7 @@ char* strdup(const char* s) {
     furi_check(((uint32_t)s << 2) != 0);
 
     size_t siz = strlen(s) + 1;
+    memmgr_heap_profiler_sample(__builtin_return_address(0), siz);
     char* y = pvPortMalloc(siz);
     memcpy(y, s, siz);
 
@@ -61,6 +56,7 @@ size_t memmgr_get_minimum_free_heap(void) {
 
 void* __wrap__malloc_r(struct _reent* r, size_t size) {
     UNUSED(r);
+    memmgr_heap_profiler_sample(__builtin_return_address(0), size);
     return pvPortMalloc(size);
 }
 
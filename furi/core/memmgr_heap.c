@@ -38,6 +38,7 @@
 #include "check.h"
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 #include <stm32wbxx.h>
 #include <core/log.h>
 #include <core/common_defines.h>
@@ -74,7 +75,10 @@ uint8_t* ucHeap = (uint8_t*)&__heap_start__;
 /* Define the linked list structure.  This is used to link free blocks in order
 of their memory address. */
 typedef struct A_BLOCK_LINK {
-    struct A_BLOCK_LINK* pxNextFreeBlock; /*<< The next free block in the list. */
+    union {
+        struct A_BLOCK_LINK* pxNextFreeBlock; /*<< The next free block in the list. */
+        size_t xOwnerTag; /*<< Trace tag of the owner, if block is allocated. */
+    };
     size_t xBlockSize; /*<< The size of the free block. */
 } BlockLink_t;
 
@@ -116,114 +120,387 @@ space. */
 static size_t xBlockAllocatedBit = 0;
 
 /* Furi heap extension */
-#include <m-dict.h>
 
-/* Allocation tracking types */
-DICT_DEF2(MemmgrHeapAllocDict, uint32_t, uint32_t) //-V1048
+/* Thread allocation tracing storage.
+Every traced thread gets a slot with allocation counters. Allocated blocks
+carry the tag of the owning slot in their header instead of the free list
+link, so tracing does not allocate anything by itself. Tag includes slot
+generation: thread ids are reused once the traced thread is gone and blocks
+it left behind must not be accounted to the new one. Every tag, including the
+one of untraced blocks, carries a magic byte that free checks to catch double
+free and corrupted headers. */
+#define MEMMGR_HEAP_TRACE_SLOTS (32U)
+#define MEMMGR_HEAP_TRACE_TAG_SLOT_MASK (0xFFU)
+#define MEMMGR_HEAP_TRACE_TAG_MAGIC (0xA5U)
+#define MEMMGR_HEAP_TRACE_TAG_MAGIC_SHIFT (8U)
+#define MEMMGR_HEAP_TRACE_TAG_GENERATION_SHIFT (16U)
+#define MEMMGR_HEAP_TRACE_TAG_UNTRACED \
+    ((size_t)MEMMGR_HEAP_TRACE_TAG_MAGIC << MEMMGR_HEAP_TRACE_TAG_MAGIC_SHIFT)
+
+typedef struct {
+    FuriThreadId thread_id;
+    size_t tag;
+    size_t bytes;
+    size_t count;
+} MemmgrHeapTraceSlot;
+
+static MemmgrHeapTraceSlot memmgr_heap_trace_slot[MEMMGR_HEAP_TRACE_SLOTS] = {0};
+static size_t memmgr_heap_trace_generation = 0;
+static size_t memmgr_heap_trace_active = 0;
+static size_t memmgr_heap_trace_last = 0;
+
+/* Size class free lists in front of the general heap.
+Blocks of the class sizes are not returned to the heap on free, but kept in
+per class lists and handed out again without walking the heap. Cached blocks
+are accounted as free memory and are released back to the heap when a
+general allocation can not be satisfied. */
+#define MEMMGR_HEAP_POOL_COUNT (10U)
+
+/* Usable size of class blocks, must be multiple of portBYTE_ALIGNMENT */
+static const size_t memmgr_heap_pool_size[MEMMGR_HEAP_POOL_COUNT] = {
+    8,
+    16,
+    24,
+    32,
+    48,
+    64,
+    96,
+    128,
+    192,
+    256,
+};
+
+/* Maximum count of blocks cached per class */
+static const size_t memmgr_heap_pool_limit[MEMMGR_HEAP_POOL_COUNT] = {
+    16,
+    16,
+    16,
+    16,
+    8,
+    8,
+    8,
+    8,
+    4,
+    4,
+};
+
+typedef struct {
+    BlockLink_t* head;
+    size_t cached;
+    size_t hits;
+    size_t misses;
+} MemmgrHeapPool;
+
+static MemmgrHeapPool memmgr_heap_pool[MEMMGR_HEAP_POOL_COUNT] = {0};
+
+/* Terminates class lists, so cached blocks never have NULL link and can not be
+confused with allocated ones */
+static BlockLink_t memmgr_heap_pool_end = {0};
+
+/* Initialize class lists on start */
+void memmgr_heap_init() {
+    for(size_t i = 0; i < MEMMGR_HEAP_POOL_COUNT; i++) {
+        memmgr_heap_pool[i].head = &memmgr_heap_pool_end;
+    }
+}
 
-DICT_DEF2( //-V1048
-    MemmgrHeapThreadDict,
-    uint32_t,
-    M_DEFAULT_OPLIST,
-    MemmgrHeapAllocDict_t,
-    DICT_OPLIST(MemmgrHeapAllocDict))
+/* Get class for a block of given size: first class that fits when `exact` is
+false, class of exactly the same size otherwise */
+static size_t memmgr_heap_pool_get_index(size_t block_size, bool exact) {
+    size_t index = 0;
+    for(; index < MEMMGR_HEAP_POOL_COUNT; index++) {
+        const size_t pool_block_size = memmgr_heap_pool_size[index] + xHeapStructSize;
+        if(pool_block_size >= block_size) {
+            if(exact && pool_block_size != block_size) {
+                index = MEMMGR_HEAP_POOL_COUNT;
+            }
+            break;
+        }
+    }
+    return index;
+}
 
-/* Thread allocation tracing storage */
-static MemmgrHeapThreadDict_t memmgr_heap_thread_dict = {0};
-static volatile uint32_t memmgr_heap_thread_trace_depth = 0;
+/* Take block from class list, must be called with suspended scheduler */
+static BlockLink_t* memmgr_heap_pool_pop(size_t index) {
+    MemmgrHeapPool* pool = &memmgr_heap_pool[index];
+    BlockLink_t* pxBlock = NULL;
 
-/* Initialize tracing storage on start */
-void memmgr_heap_init() {
-    MemmgrHeapThreadDict_init(memmgr_heap_thread_dict);
+    if(pool->head != &memmgr_heap_pool_end) {
+        pxBlock = pool->head;
+        pool->head = pxBlock->pxNextFreeBlock;
+        pool->cached--;
+        pool->hits++;
+    } else {
+        pool->misses++;
+    }
+
+    return pxBlock;
+}
+
+/* Put free block into class list, must be called with suspended scheduler */
+static bool memmgr_heap_pool_push(BlockLink_t* pxBlock) {
+    const size_t index = memmgr_heap_pool_get_index(pxBlock->xBlockSize, true);
+    if(index == MEMMGR_HEAP_POOL_COUNT) return false;
+
+    MemmgrHeapPool* pool = &memmgr_heap_pool[index];
+    if(pool->cached >= memmgr_heap_pool_limit[index]) return false;
+
+    pxBlock->pxNextFreeBlock = pool->head;
+    pool->head = pxBlock;
+    pool->cached++;
+
+    return true;
+}
+
+/* Return all cached blocks to the heap, must be called with suspended scheduler */
+static bool memmgr_heap_pool_release() {
+    bool released = false;
+
+    for(size_t i = 0; i < MEMMGR_HEAP_POOL_COUNT; i++) {
+        MemmgrHeapPool* pool = &memmgr_heap_pool[i];
+        while(pool->head != &memmgr_heap_pool_end) {
+            BlockLink_t* pxBlock = pool->head;
+            pool->head = pxBlock->pxNextFreeBlock;
+            prvInsertBlockIntoFreeList(pxBlock);
+            released = true;
+        }
+        pool->cached = 0;
+    }
+
+    return released;
+}
+
+size_t memmgr_heap_get_pool_count() {
+    return MEMMGR_HEAP_POOL_COUNT;
+}
+
+void memmgr_heap_get_pool_stats(size_t index, MemmgrHeapPoolStats* stats) {
+    furi_check(index < MEMMGR_HEAP_POOL_COUNT);
+    furi_check(stats);
+
+    vTaskSuspendAll();
+    {
+        stats->block_size = memmgr_heap_pool_size[index];
+        stats->cached = memmgr_heap_pool[index].cached;
+        stats->hits = memmgr_heap_pool[index].hits;
+        stats->misses = memmgr_heap_pool[index].misses;
+    }
+    (void)xTaskResumeAll();
+}
+
+/* Find trace slot of the thread, must be called with suspended scheduler */
+static MemmgrHeapTraceSlot* memmgr_heap_trace_find(FuriThreadId thread_id) {
+    if(memmgr_heap_trace_slot[memmgr_heap_trace_last].thread_id == thread_id) {
+        return &memmgr_heap_trace_slot[memmgr_heap_trace_last];
+    }
+
+    for(size_t i = 0; i < MEMMGR_HEAP_TRACE_SLOTS; i++) {
+        if(memmgr_heap_trace_slot[i].thread_id == thread_id) {
+            memmgr_heap_trace_last = i;
+            return &memmgr_heap_trace_slot[i];
+        }
+    }
+
+    return NULL;
 }
 
 void memmgr_heap_enable_thread_trace(FuriThreadId thread_id) {
+    furi_check(thread_id);
+
     vTaskSuspendAll();
     {
-        memmgr_heap_thread_trace_depth++;
-        furi_check(MemmgrHeapThreadDict_get(memmgr_heap_thread_dict, (uint32_t)thread_id) == NULL);
-        MemmgrHeapAllocDict_t alloc_dict;
-        MemmgrHeapAllocDict_init(alloc_dict);
-        MemmgrHeapThreadDict_set_at(memmgr_heap_thread_dict, (uint32_t)thread_id, alloc_dict);
-        MemmgrHeapAllocDict_clear(alloc_dict);
-        memmgr_heap_thread_trace_depth--;
+        furi_check(memmgr_heap_trace_find(thread_id) == NULL);
+        // Out of slots: thread stays untraced and reports unknown usage
+        MemmgrHeapTraceSlot* slot = memmgr_heap_trace_find(NULL);
+        if(slot) {
+            memmgr_heap_trace_generation++;
+            slot->thread_id = thread_id;
+            slot->tag = (memmgr_heap_trace_generation << MEMMGR_HEAP_TRACE_TAG_GENERATION_SHIFT) |
+                        MEMMGR_HEAP_TRACE_TAG_UNTRACED |
+                        ((size_t)(slot - memmgr_heap_trace_slot) + 1);
+            slot->bytes = 0;
+            slot->count = 0;
+            memmgr_heap_trace_active++;
+        }
     }
     (void)xTaskResumeAll();
 }
 
 void memmgr_heap_disable_thread_trace(FuriThreadId thread_id) {
+    furi_check(thread_id);
+
     vTaskSuspendAll();
     {
-        memmgr_heap_thread_trace_depth++;
-        furi_check(MemmgrHeapThreadDict_erase(memmgr_heap_thread_dict, (uint32_t)thread_id));
-        memmgr_heap_thread_trace_depth--;
+        MemmgrHeapTraceSlot* slot = memmgr_heap_trace_find(thread_id);
+        if(slot) {
+            slot->thread_id = NULL;
+            slot->tag = 0;
+            memmgr_heap_trace_active--;
+        }
     }
     (void)xTaskResumeAll();
 }
 
 size_t memmgr_heap_get_thread_memory(FuriThreadId thread_id) {
     size_t leftovers = MEMMGR_HEAP_UNKNOWN;
+    furi_check(thread_id);
+
     vTaskSuspendAll();
     {
-        memmgr_heap_thread_trace_depth++;
-        MemmgrHeapAllocDict_t* alloc_dict =
-            MemmgrHeapThreadDict_get(memmgr_heap_thread_dict, (uint32_t)thread_id);
-        if(alloc_dict) {
-            leftovers = 0;
-            MemmgrHeapAllocDict_it_t alloc_dict_it;
-            for(MemmgrHeapAllocDict_it(alloc_dict_it, *alloc_dict);
-                !MemmgrHeapAllocDict_end_p(alloc_dict_it);
-                MemmgrHeapAllocDict_next(alloc_dict_it)) {
-                MemmgrHeapAllocDict_itref_t* data = MemmgrHeapAllocDict_ref(alloc_dict_it);
-                if(data->key != 0) {
-                    uint8_t* puc = (uint8_t*)data->key;
-                    puc -= xHeapStructSize;
-                    BlockLink_t* pxLink = (void*)puc;
-
-                    if((pxLink->xBlockSize & xBlockAllocatedBit) != 0 &&
-                       pxLink->pxNextFreeBlock == NULL) {
-                        leftovers += data->value;
-                    }
-                }
-            }
+        MemmgrHeapTraceSlot* slot = memmgr_heap_trace_find(thread_id);
+        if(slot) {
+            leftovers = slot->bytes;
         }
-        memmgr_heap_thread_trace_depth--;
     }
     (void)xTaskResumeAll();
     return leftovers;
 }
 
+size_t memmgr_heap_get_thread_allocations(FuriThreadId thread_id) {
+    size_t count = MEMMGR_HEAP_UNKNOWN;
+    furi_check(thread_id);
+
+    vTaskSuspendAll();
+    {
+        MemmgrHeapTraceSlot* slot = memmgr_heap_trace_find(thread_id);
+        if(slot) {
+            count = slot->count;
+        }
+    }
+    (void)xTaskResumeAll();
+    return count;
+}
+
+/* Tag allocated block with the current thread, must be called with suspended scheduler */
 #undef traceMALLOC
-static inline void traceMALLOC(void* pointer, size_t size) {
-    FuriThreadId thread_id = furi_thread_get_current_id();
-    if(thread_id && memmgr_heap_thread_trace_depth == 0) {
-        memmgr_heap_thread_trace_depth++;
-        MemmgrHeapAllocDict_t* alloc_dict =
-            MemmgrHeapThreadDict_get(memmgr_heap_thread_dict, (uint32_t)thread_id);
-        if(alloc_dict) {
-            MemmgrHeapAllocDict_set_at(*alloc_dict, (uint32_t)pointer, (uint32_t)size);
+static inline void traceMALLOC(void* pointer) {
+    if(pointer == NULL) return;
+
+    BlockLink_t* pxLink = (void*)((uint8_t*)pointer - xHeapStructSize);
+    pxLink->xOwnerTag = MEMMGR_HEAP_TRACE_TAG_UNTRACED;
+
+    if(memmgr_heap_trace_active) {
+        FuriThreadId thread_id = furi_thread_get_current_id();
+        MemmgrHeapTraceSlot* slot = thread_id ? memmgr_heap_trace_find(thread_id) : NULL;
+        if(slot) {
+            pxLink->xOwnerTag = slot->tag;
+            slot->bytes += pxLink->xBlockSize & ~xBlockAllocatedBit;
+            slot->count++;
         }
-        memmgr_heap_thread_trace_depth--;
     }
 }
 
+/* Header of allocated block holds a tag set by traceMALLOC */
+static inline bool memmgr_heap_trace_tag_is_valid(size_t tag) {
+    return ((tag >> MEMMGR_HEAP_TRACE_TAG_MAGIC_SHIFT) & 0xFFU) == MEMMGR_HEAP_TRACE_TAG_MAGIC &&
+           (tag & MEMMGR_HEAP_TRACE_TAG_SLOT_MASK) <= MEMMGR_HEAP_TRACE_SLOTS;
+}
+
+/* Account released block to its owner, must be called with suspended scheduler */
 #undef traceFREE
-static inline void traceFREE(void* pointer, size_t size) {
-    UNUSED(size);
-    FuriThreadId thread_id = furi_thread_get_current_id();
-    if(thread_id && memmgr_heap_thread_trace_depth == 0) {
-        memmgr_heap_thread_trace_depth++;
-        MemmgrHeapAllocDict_t* alloc_dict =
-            MemmgrHeapThreadDict_get(memmgr_heap_thread_dict, (uint32_t)thread_id);
-        if(alloc_dict) {
-            // In some cases thread may want to release memory that was not allocated by it
-            const bool res = MemmgrHeapAllocDict_erase(*alloc_dict, (uint32_t)pointer);
-            UNUSED(res);
+static inline void traceFREE(void* pointer) {
+    BlockLink_t* pxLink = (void*)((uint8_t*)pointer - xHeapStructSize);
+    const size_t tag = pxLink->xOwnerTag;
+
+    if(tag & MEMMGR_HEAP_TRACE_TAG_SLOT_MASK) {
+        // Owner may be gone already, in that case slot tag is different
+        MemmgrHeapTraceSlot* slot =
+            &memmgr_heap_trace_slot[(tag & MEMMGR_HEAP_TRACE_TAG_SLOT_MASK) - 1];
+        if(slot->tag == tag) {
+            slot->bytes -= pxLink->xBlockSize & ~xBlockAllocatedBit;
+            slot->count--;
         }
-        memmgr_heap_thread_trace_depth--;
     }
 }
 
+/* Sampling allocation profiler: every Nth allocation is accounted to the
+address it was requested from */
+#define MEMMGR_HEAP_PROFILER_BUCKETS (32U)
+
+typedef struct {
+    const void* pc;
+    size_t samples;
+    size_t bytes;
+} MemmgrHeapProfilerBucket;
+
+static MemmgrHeapProfilerBucket memmgr_heap_profiler_bucket[MEMMGR_HEAP_PROFILER_BUCKETS] = {0};
+static volatile uint32_t memmgr_heap_profiler_period = 0;
+static uint32_t memmgr_heap_profiler_countdown = 0;
+static size_t memmgr_heap_profiler_dropped = 0;
+
+void memmgr_heap_profiler_sample(const void* pc, size_t size) {
+    if(memmgr_heap_profiler_period == 0) return;
+
+    vTaskSuspendAll();
+    if(memmgr_heap_profiler_countdown > 0) {
+        memmgr_heap_profiler_countdown--;
+    } else if(memmgr_heap_profiler_period > 0) {
+        memmgr_heap_profiler_countdown = memmgr_heap_profiler_period - 1;
+
+        // Open addressing by call site address, Thumb bit carries no information
+        size_t index = ((size_t)pc >> 1) % MEMMGR_HEAP_PROFILER_BUCKETS;
+        MemmgrHeapProfilerBucket* bucket = NULL;
+        for(size_t i = 0; i < MEMMGR_HEAP_PROFILER_BUCKETS; i++) {
+            MemmgrHeapProfilerBucket* candidate = &memmgr_heap_profiler_bucket[index];
+            if(candidate->pc == pc || candidate->pc == NULL) {
+                bucket = candidate;
+                break;
+            }
+            index = (index + 1) % MEMMGR_HEAP_PROFILER_BUCKETS;
+        }
+
+        if(bucket) {
+            bucket->pc = pc;
+            bucket->samples++;
+            bucket->bytes += size;
+        } else {
+            memmgr_heap_profiler_dropped++;
+        }
+    }
+    (void)xTaskResumeAll();
+}
+
+void memmgr_heap_profiler_start(uint32_t sample_period) {
+    furi_check(sample_period > 0);
+
+    vTaskSuspendAll();
+    {
+        memset(memmgr_heap_profiler_bucket, 0, sizeof(memmgr_heap_profiler_bucket));
+        memmgr_heap_profiler_dropped = 0;
+        memmgr_heap_profiler_countdown = 0;
+        memmgr_heap_profiler_period = sample_period;
+    }
+    (void)xTaskResumeAll();
+}
+
+void memmgr_heap_profiler_stop() {
+    memmgr_heap_profiler_period = 0;
+}
+
+void memmgr_heap_printf_profile() {
+    MemmgrHeapProfilerBucket* buckets = malloc(sizeof(memmgr_heap_profiler_bucket));
+    uint32_t period;
+    size_t dropped;
+
+    // Take snapshot: printing with suspended scheduler is not possible
+    vTaskSuspendAll();
+    {
+        memcpy(buckets, memmgr_heap_profiler_bucket, sizeof(memmgr_heap_profiler_bucket));
+        period = memmgr_heap_profiler_period;
+        dropped = memmgr_heap_profiler_dropped;
+    }
+    (void)xTaskResumeAll();
+
+    printf("Sample period: %lu, dropped samples: %zu\r\n", period, dropped);
+    for(size_t i = 0; i < MEMMGR_HEAP_PROFILER_BUCKETS; i++) {
+        if(buckets[i].pc == NULL) continue;
+        printf(
+            "PC %p S %zu B %zu\r\n", (void*)buckets[i].pc, buckets[i].samples, buckets[i].bytes);
+    }
+
+    free(buckets);
+}
+
 size_t memmgr_heap_get_max_free_block() {
     size_t max_free_size = 0;
     BlockLink_t* pxBlock;
@@ -341,8 +618,55 @@ static void print_heap_free(void* ptr) {
 #endif
 /*-----------------------------------------------------------*/
 
-void* pvPortMalloc(size_t xWantedSize) {
+static BlockLink_t* prvAllocateBlock(size_t xWantedSize) {
     BlockLink_t *pxBlock, *pxPreviousBlock, *pxNewBlockLink;
+
+    /* Traverse the list from the start (lowest address) block until
+    one of adequate size is found. */
+    pxPreviousBlock = &xStart;
+    pxBlock = xStart.pxNextFreeBlock;
+    while((pxBlock->xBlockSize < xWantedSize) && (pxBlock->pxNextFreeBlock != NULL)) {
+        pxPreviousBlock = pxBlock;
+        pxBlock = pxBlock->pxNextFreeBlock;
+    }
+
+    /* If the end marker was reached then a block of adequate size
+    was not found. */
+    if(pxBlock == pxEnd) {
+        return NULL;
+    }
+
+    /* This block is being returned for use so must be taken out
+    of the list of free blocks. */
+    pxPreviousBlock->pxNextFreeBlock = pxBlock->pxNextFreeBlock;
+
+    /* If the block is larger than required it can be split into
+    two. */
+    if((pxBlock->xBlockSize - xWantedSize) > heapMINIMUM_BLOCK_SIZE) {
+        /* This block is to be split into two.  Create a new
+        block following the number of bytes requested. The void
+        cast is used to prevent byte alignment warnings from the
+        compiler. */
+        pxNewBlockLink = (void*)(((uint8_t*)pxBlock) + xWantedSize);
+        configASSERT((((size_t)pxNewBlockLink) & portBYTE_ALIGNMENT_MASK) == 0);
+
+        /* Calculate the sizes of two blocks split from the
+        single block. */
+        pxNewBlockLink->xBlockSize = pxBlock->xBlockSize - xWantedSize;
+        pxBlock->xBlockSize = xWantedSize;
+
+        /* Insert the new block into the list of free blocks. */
+        prvInsertBlockIntoFreeList(pxNewBlockLink);
+    } else {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return pxBlock;
+}
+/*-----------------------------------------------------------*/
+
+void* pvPortMalloc(size_t xWantedSize) {
+    BlockLink_t* pxBlock;
     void* pvReturn = NULL;
     size_t to_wipe = xWantedSize;
 
@@ -397,47 +721,29 @@ void* pvPortMalloc(size_t xWantedSize) {
             }
 
             if((xWantedSize > 0) && (xWantedSize <= xFreeBytesRemaining)) {
-                /* Traverse the list from the start (lowest address) block until
-                one of adequate size is found. */
-                pxPreviousBlock = &xStart;
-                pxBlock = xStart.pxNextFreeBlock;
-                while((pxBlock->xBlockSize < xWantedSize) && (pxBlock->pxNextFreeBlock != NULL)) {
-                    pxPreviousBlock = pxBlock;
-                    pxBlock = pxBlock->pxNextFreeBlock;
+                /* Small blocks are served from class lists first, rounding the
+                size up to the class size so the block can be cached on free. */
+                pxBlock = NULL;
+                const size_t pool_index = memmgr_heap_pool_get_index(xWantedSize, false);
+                if(pool_index < MEMMGR_HEAP_POOL_COUNT) {
+                    xWantedSize = memmgr_heap_pool_size[pool_index] + xHeapStructSize;
+                    pxBlock = memmgr_heap_pool_pop(pool_index);
+                }
+
+                if(pxBlock == NULL) {
+                    pxBlock = prvAllocateBlock(xWantedSize);
+                }
+
+                /* Cached blocks may be the ones fragmenting the heap, give
+                them back and try once more. */
+                if(pxBlock == NULL && memmgr_heap_pool_release()) {
+                    pxBlock = prvAllocateBlock(xWantedSize);
                 }
 
-                /* If the end marker was reached then a block of adequate size
-                was not found. */
-                if(pxBlock != pxEnd) {
+                if(pxBlock != NULL) {
                     /* Return the memory space pointed to - jumping over the
                     BlockLink_t structure at its start. */
-                    pvReturn =
-                        (void*)(((uint8_t*)pxPreviousBlock->pxNextFreeBlock) + xHeapStructSize);
-
-                    /* This block is being returned for use so must be taken out
-                    of the list of free blocks. */
-                    pxPreviousBlock->pxNextFreeBlock = pxBlock->pxNextFreeBlock;
-
-                    /* If the block is larger than required it can be split into
-                    two. */
-                    if((pxBlock->xBlockSize - xWantedSize) > heapMINIMUM_BLOCK_SIZE) {
-                        /* This block is to be split into two.  Create a new
-                        block following the number of bytes requested. The void
-                        cast is used to prevent byte alignment warnings from the
-                        compiler. */
-                        pxNewBlockLink = (void*)(((uint8_t*)pxBlock) + xWantedSize);
-                        configASSERT((((size_t)pxNewBlockLink) & portBYTE_ALIGNMENT_MASK) == 0);
-
-                        /* Calculate the sizes of two blocks split from the
-                        single block. */
-                        pxNewBlockLink->xBlockSize = pxBlock->xBlockSize - xWantedSize;
-                        pxBlock->xBlockSize = xWantedSize;
-
-                        /* Insert the new block into the list of free blocks. */
-                        prvInsertBlockIntoFreeList(pxNewBlockLink);
-                    } else {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
+                    pvReturn = (void*)(((uint8_t*)pxBlock) + xHeapStructSize);
 
                     xFreeBytesRemaining -= pxBlock->xBlockSize;
 
@@ -465,7 +771,7 @@ void* pvPortMalloc(size_t xWantedSize) {
             mtCOVERAGE_TEST_MARKER();
         }
 
-        traceMALLOC(pvReturn, xWantedSize);
+        traceMALLOC(pvReturn);
     }
     (void)xTaskResumeAll();
 
@@ -508,40 +814,38 @@ void vPortFree(void* pv) {
         /* This casting is to keep the compiler from issuing warnings. */
         pxLink = (void*)puc;
 
-        /* Check the block is actually allocated. */
-        configASSERT((pxLink->xBlockSize & xBlockAllocatedBit) != 0);
-        configASSERT(pxLink->pxNextFreeBlock == NULL);
+        /* Check the block is actually allocated. Header of allocated blocks
+        holds owner tag instead of the free list link: freed block has no
+        allocated bit, free list link or garbage fails the tag check. */
+        furi_check(
+            (pxLink->xBlockSize & xBlockAllocatedBit) != 0 &&
+                memmgr_heap_trace_tag_is_valid(pxLink->xOwnerTag),
+            "Double free or corrupted heap block");
 
-        if((pxLink->xBlockSize & xBlockAllocatedBit) != 0) {
-            if(pxLink->pxNextFreeBlock == NULL) {
-                /* The block is being returned to the heap - it is no longer
-                allocated. */
-                pxLink->xBlockSize &= ~xBlockAllocatedBit;
+        /* The block is being returned to the heap - it is no longer
+        allocated. */
+        pxLink->xBlockSize &= ~xBlockAllocatedBit;
 
 #ifdef HEAP_PRINT_DEBUG
-                print_heap_free(pxLink);
+        print_heap_free(pxLink);
 #endif
 
-                vTaskSuspendAll();
-                {
-                    furi_assert((size_t)pv >= SRAM_BASE);
-                    furi_assert((size_t)pv < SRAM_BASE + 1024 * 256);
-                    furi_assert(pxLink->xBlockSize >= xHeapStructSize);
-                    furi_assert((pxLink->xBlockSize - xHeapStructSize) < 1024 * 256);
-
-                    /* Add this block to the list of free blocks. */
-                    xFreeBytesRemaining += pxLink->xBlockSize;
-                    traceFREE(pv, pxLink->xBlockSize);
-                    memset(pv, 0, pxLink->xBlockSize - xHeapStructSize);
-                    prvInsertBlockIntoFreeList(((BlockLink_t*)pxLink));
-                }
-                (void)xTaskResumeAll();
-            } else {
-                mtCOVERAGE_TEST_MARKER();
+        vTaskSuspendAll();
+        {
+            furi_assert((size_t)pv >= SRAM_BASE);
+            furi_assert((size_t)pv < SRAM_BASE + 1024 * 256);
+            furi_assert(pxLink->xBlockSize >= xHeapStructSize);
+            furi_assert((pxLink->xBlockSize - xHeapStructSize) < 1024 * 256);
+
+            /* Add this block to the list of free blocks. */
+            xFreeBytesRemaining += pxLink->xBlockSize;
+            traceFREE(pv);
+            memset(pv, 0, pxLink->xBlockSize - xHeapStructSize);
+            if(!memmgr_heap_pool_push(pxLink)) {
+                prvInsertBlockIntoFreeList(((BlockLink_t*)pxLink));
             }
-        } else {
-            mtCOVERAGE_TEST_MARKER();
         }
+        (void)xTaskResumeAll();
     } else {
 #ifdef HEAP_PRINT_DEBUG
         print_heap_free(pv);
@@ -550,6 +854,116 @@ void vPortFree(void* pv) {
 }
 /*-----------------------------------------------------------*/
 
+void* pvPortRealloc(void* pv, size_t xWantedSize) {
+    uint8_t* puc = (uint8_t*)pv;
+    BlockLink_t *pxLink, *pxIterator, *pxNewBlockLink;
+    void* pvReturn = NULL;
+    size_t xBlockSize, xCurrentSize, xNewBlockSize;
+
+    if(FURI_IS_IRQ_MODE()) {
+        furi_crash("memmgt in ISR");
+    }
+
+    if(pv == NULL) {
+        return pvPortMalloc(xWantedSize);
+    }
+
+    if(xWantedSize == 0) {
+        vPortFree(pv);
+        return NULL;
+    }
+
+    furi_check((xWantedSize & xBlockAllocatedBit) == 0);
+
+    /* The memory being resized will have an BlockLink_t structure immediately
+    before it. */
+    puc -= xHeapStructSize;
+    pxLink = (void*)puc;
+
+    /* Size of the block that will hold requested amount of bytes */
+    xNewBlockSize = xWantedSize + xHeapStructSize;
+    if((xNewBlockSize & portBYTE_ALIGNMENT_MASK) != 0x00) {
+        xNewBlockSize += (portBYTE_ALIGNMENT - (xNewBlockSize & portBYTE_ALIGNMENT_MASK));
+    }
+
+    vTaskSuspendAll();
+    {
+        furi_check(
+            (pxLink->xBlockSize & xBlockAllocatedBit) != 0 &&
+                memmgr_heap_trace_tag_is_valid(pxLink->xOwnerTag),
+            "Realloc of free or corrupted heap block");
+
+        xBlockSize = pxLink->xBlockSize & ~xBlockAllocatedBit;
+        xCurrentSize = xBlockSize - xHeapStructSize;
+
+        if(xNewBlockSize <= xBlockSize) {
+            /* Shrinking or growing within the block slack */
+            pvReturn = pv;
+        } else {
+            /* Growing: check if the next block in memory is free and big
+            enough to be merged into this one. */
+            BlockLink_t* pxNextBlock = (void*)(puc + xBlockSize);
+            for(pxIterator = &xStart; pxIterator->pxNextFreeBlock < pxNextBlock;
+                pxIterator = pxIterator->pxNextFreeBlock) {
+                /* Nothing to do here, just iterate to the right position. */
+            }
+
+            if(pxIterator->pxNextFreeBlock == pxNextBlock && pxNextBlock != pxEnd &&
+               (xBlockSize + pxNextBlock->xBlockSize) >= xNewBlockSize) {
+                pxIterator->pxNextFreeBlock = pxNextBlock->pxNextFreeBlock;
+                xFreeBytesRemaining -= pxNextBlock->xBlockSize;
+                xBlockSize += pxNextBlock->xBlockSize;
+
+                if(xFreeBytesRemaining < xMinimumEverFreeBytesRemaining) {
+                    xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+                }
+
+                pvReturn = pv;
+            }
+        }
+
+        if(pvReturn) {
+            /* Block changes its size and owner */
+            traceFREE(pv);
+
+            /* Give the unused tail back to the heap */
+            if((xBlockSize - xNewBlockSize) > heapMINIMUM_BLOCK_SIZE) {
+                pxNewBlockLink = (void*)(puc + xNewBlockSize);
+                configASSERT((((size_t)pxNewBlockLink) & portBYTE_ALIGNMENT_MASK) == 0);
+                pxNewBlockLink->xBlockSize = xBlockSize - xNewBlockSize;
+                xBlockSize = xNewBlockSize;
+
+                xFreeBytesRemaining += pxNewBlockLink->xBlockSize;
+                memset(
+                    ((uint8_t*)pxNewBlockLink) + xHeapStructSize,
+                    0,
+                    pxNewBlockLink->xBlockSize - xHeapStructSize);
+                prvInsertBlockIntoFreeList(pxNewBlockLink);
+            }
+
+            pxLink->xBlockSize = xBlockSize | xBlockAllocatedBit;
+
+            /* Keep malloc semantic: newly available bytes are zeroed */
+            if(xWantedSize > xCurrentSize) {
+                memset((uint8_t*)pv + xCurrentSize, 0, xWantedSize - xCurrentSize);
+            }
+
+            traceMALLOC(pv);
+        }
+    }
+    (void)xTaskResumeAll();
+
+    if(pvReturn == NULL) {
+        /* No room around the block, fall back to allocate and copy */
+        pvReturn = pvPortMalloc(xWantedSize);
+        memcpy(pvReturn, pv, MIN(xCurrentSize, xWantedSize));
+        vPortFree(pv);
+    }
+
+    return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
 size_t xPortGetTotalHeapSize(void) {
     return (size_t)&__heap_end__ - (size_t)&__heap_start__;
 }
@@ -14,6 +14,14 @@ extern "C" {
 
 #define MEMMGR_HEAP_UNKNOWN 0xFFFFFFFF
 
+/** Memmgr heap size class statistics */
+typedef struct {
+    size_t block_size; /**< usable size of blocks in the class */
+    size_t cached; /**< blocks currently kept in the class free list */
+    size_t hits; /**< allocations served from the class free list */
+    size_t misses; /**< allocations that went to the general heap */
+} MemmgrHeapPoolStats;
+
 /** Memmgr heap enable thread allocation tracking
  *
  * @param      thread_id  - thread id to track
@@ -34,6 +42,14 @@ void memmgr_heap_disable_thread_trace(FuriThreadId taks_handle);
  */
 size_t memmgr_heap_get_thread_memory(FuriThreadId taks_handle);
 
+/** Memmgr heap get amount of thread allocations
+ *
+ * @param      thread_id  - thread id to track
+ *
+ * @return     blocks allocated right now
+ */
+size_t memmgr_heap_get_thread_allocations(FuriThreadId thread_id);
+
 /** Memmgr heap get the max contiguous block size on the heap
  *
  * @return     size_t max contiguous block size
@@ -44,6 +60,36 @@ size_t memmgr_heap_get_max_free_block();
  */
 void memmgr_heap_printf_free_blocks();
 
+/** Memmgr heap get amount of size classes
+ *
+ * @return     size classes count
+ */
+size_t memmgr_heap_get_pool_count();
+
+/** Memmgr heap get size class statistics
+ *
+ * @param      index  - size class index, less than memmgr_heap_get_pool_count()
+ * @param      stats  - pointer to MemmgrHeapPoolStats to fill
+ */
+void memmgr_heap_get_pool_stats(size_t index, MemmgrHeapPoolStats* stats);
+
+/** Memmgr heap start sampling allocation profiler
+ *
+ * Clears collected samples and starts accounting every Nth allocation to the
+ * address it was made from
+ *
+ * @param      sample_period  - sample every Nth allocation, must be non zero
+ */
+void memmgr_heap_profiler_start(uint32_t sample_period);
+
+/** Memmgr heap stop sampling allocation profiler, samples are kept
+ */
+void memmgr_heap_profiler_stop();
+
+/** Print collected allocation profiler samples to stdout
+ */
+void memmgr_heap_printf_profile();
+
 #ifdef __cplusplus
 }
 #endif
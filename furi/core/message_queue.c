@@ -1,29 +1,40 @@
 #include "kernel.h"
 #include "message_queue.h"
 #include "check.h"
+#include "memmgr.h"
+#include "event_loop_link_i.h"
 
 #include <FreeRTOS.h>
 #include <queue.h>
 
+struct FuriMessageQueue {
+    QueueHandle_t handle;
+    FuriEventLoopLink event_loop_link;
+};
+
 FuriMessageQueue* furi_message_queue_alloc(uint32_t msg_count, uint32_t msg_size) {
     furi_assert((furi_kernel_is_irq_or_masked() == 0U) && (msg_count > 0U) && (msg_size > 0U));
 
-    QueueHandle_t handle = xQueueCreate(msg_count, msg_size);
-    furi_check(handle);
+    FuriMessageQueue* instance = malloc(sizeof(FuriMessageQueue));
+    instance->handle = xQueueCreate(msg_count, msg_size);
+    furi_check(instance->handle);
 
-    return ((FuriMessageQueue*)handle);
+    return instance;
 }
 
 void furi_message_queue_free(FuriMessageQueue* instance) {
     furi_assert(furi_kernel_is_irq_or_masked() == 0U);
     furi_assert(instance);
 
-    vQueueDelete((QueueHandle_t)instance);
+    furi_event_loop_link_check_unused(&instance->event_loop_link);
+
+    vQueueDelete(instance->handle);
+    free(instance);
 }
 
 FuriStatus
     furi_message_queue_put(FuriMessageQueue* instance, const void* msg_ptr, uint32_t timeout) {
-    QueueHandle_t hQueue = (QueueHandle_t)instance;
+    QueueHandle_t hQueue = instance ? instance->handle : NULL;
     FuriStatus stat;
     BaseType_t yield;
 
@@ -55,12 +66,16 @@ FuriStatus
         }
     }
 
+    if(stat == FuriStatusOk) {
+        furi_event_loop_link_notify(&instance->event_loop_link, FuriEventLoopEventIn);
+    }
+
     /* Return execution status */
     return (stat);
 }
 
 FuriStatus furi_message_queue_get(FuriMessageQueue* instance, void* msg_ptr, uint32_t timeout) {
-    QueueHandle_t hQueue = (QueueHandle_t)instance;
+    QueueHandle_t hQueue = instance ? instance->handle : NULL;
     FuriStatus stat;
     BaseType_t yield;
 
@@ -92,12 +107,16 @@ FuriStatus furi_message_queue_get(FuriMessageQueue* instance, void* msg_ptr, uin
         }
     }
 
+    if(stat == FuriStatusOk) {
+        furi_event_loop_link_notify(&instance->event_loop_link, FuriEventLoopEventOut);
+    }
+
     /* Return execution status */
     return (stat);
 }
 
 uint32_t furi_message_queue_get_capacity(FuriMessageQueue* instance) {
-    StaticQueue_t* mq = (StaticQueue_t*)instance;
+    StaticQueue_t* mq = instance ? (StaticQueue_t*)instance->handle : NULL;
     uint32_t capacity;
 
     if(mq == NULL) {
@@ -112,7 +131,7 @@ uint32_t furi_message_queue_get_capacity(FuriMessageQueue* instance) {
 }
 
 uint32_t furi_message_queue_get_message_size(FuriMessageQueue* instance) {
-    StaticQueue_t* mq = (StaticQueue_t*)instance;
+    StaticQueue_t* mq = instance ? (StaticQueue_t*)instance->handle : NULL;
     uint32_t size;
 
     if(mq == NULL) {
@@ -127,7 +146,7 @@ uint32_t furi_message_queue_get_message_size(FuriMessageQueue* instance) {
 }
 
 uint32_t furi_message_queue_get_count(FuriMessageQueue* instance) {
-    QueueHandle_t hQueue = (QueueHandle_t)instance;
+    QueueHandle_t hQueue = instance ? instance->handle : NULL;
     UBaseType_t count;
 
     if(hQueue == NULL) {
@@ -143,7 +162,7 @@ uint32_t furi_message_queue_get_count(FuriMessageQueue* instance) {
 }
 
 uint32_t furi_message_queue_get_space(FuriMessageQueue* instance) {
-    StaticQueue_t* mq = (StaticQueue_t*)instance;
+    StaticQueue_t* mq = instance ? (StaticQueue_t*)instance->handle : NULL;
     uint32_t space;
     uint32_t isrm;
 
@@ -165,7 +184,7 @@ uint32_t furi_message_queue_get_space(FuriMessageQueue* instance) {
 }
 
 FuriStatus furi_message_queue_reset(FuriMessageQueue* instance) {
-    QueueHandle_t hQueue = (QueueHandle_t)instance;
+    QueueHandle_t hQueue = instance ? instance->handle : NULL;
     FuriStatus stat;
 
     if(furi_kernel_is_irq_or_masked() != 0U) {
@@ -177,6 +196,32 @@ FuriStatus furi_message_queue_reset(FuriMessageQueue* instance) {
         (void)xQueueReset(hQueue);
     }
 
+    if(stat == FuriStatusOk) {
+        furi_event_loop_link_notify(&instance->event_loop_link, FuriEventLoopEventOut);
+    }
+
     /* Return execution status */
     return (stat);
 }
+
+static FuriEventLoopLink* furi_message_queue_event_loop_get_link(void* object) {
+    FuriMessageQueue* instance = object;
+    furi_assert(instance);
+    return &instance->event_loop_link;
+}
+
+static uint32_t furi_message_queue_event_loop_get_level(void* object, FuriEventLoopEvent event) {
+    FuriMessageQueue* instance = object;
+    furi_assert(instance);
+
+    if(event == FuriEventLoopEventIn) {
+        return furi_message_queue_get_count(instance);
+    } else {
+        return furi_message_queue_get_space(instance);
+    }
+}
+
+const FuriEventLoopContract furi_message_queue_event_loop_contract = {
+    .get_link = furi_message_queue_event_loop_get_link,
+    .get_level = furi_message_queue_event_loop_get_level,
+};
@@ -2,27 +2,39 @@
 #include "check.h"
 #include "stream_buffer.h"
 #include "common_defines.h"
+#include "memmgr.h"
+#include "event_loop_link_i.h"
 
 #include <FreeRTOS.h>
 #include <FreeRTOS-Kernel/include/stream_buffer.h>
 
+struct FuriStreamBuffer {
+    StreamBufferHandle_t handle;
+    FuriEventLoopLink event_loop_link;
+};
+
 FuriStreamBuffer* furi_stream_buffer_alloc(size_t size, size_t trigger_level) {
     furi_assert(size != 0);
 
-    StreamBufferHandle_t handle = xStreamBufferCreate(size, trigger_level);
-    furi_check(handle);
+    FuriStreamBuffer* stream_buffer = malloc(sizeof(FuriStreamBuffer));
+    stream_buffer->handle = xStreamBufferCreate(size, trigger_level);
+    furi_check(stream_buffer->handle);
 
-    return handle;
+    return stream_buffer;
 };
 
 void furi_stream_buffer_free(FuriStreamBuffer* stream_buffer) {
     furi_assert(stream_buffer);
-    vStreamBufferDelete(stream_buffer);
+
+    furi_event_loop_link_check_unused(&stream_buffer->event_loop_link);
+
+    vStreamBufferDelete(stream_buffer->handle);
+    free(stream_buffer);
 };
 
 bool furi_stream_set_trigger_level(FuriStreamBuffer* stream_buffer, size_t trigger_level) {
     furi_assert(stream_buffer);
-    return xStreamBufferSetTriggerLevel(stream_buffer, trigger_level) == pdTRUE;
+    return xStreamBufferSetTriggerLevel(stream_buffer->handle, trigger_level) == pdTRUE;
 };
 
 size_t furi_stream_buffer_send(
@@ -34,10 +46,14 @@ size_t furi_stream_buffer_send(
 
     if(FURI_IS_IRQ_MODE()) {
         BaseType_t yield;
-        ret = xStreamBufferSendFromISR(stream_buffer, data, length, &yield);
+        ret = xStreamBufferSendFromISR(stream_buffer->handle, data, length, &yield);
         portYIELD_FROM_ISR(yield);
     } else {
-        ret = xStreamBufferSend(stream_buffer, data, length, timeout);
+        ret = xStreamBufferSend(stream_buffer->handle, data, length, timeout);
+    }
+
+    if(ret > 0) {
+        furi_event_loop_link_notify(&stream_buffer->event_loop_link, FuriEventLoopEventIn);
     }
 
     return ret;
@@ -52,35 +68,62 @@ size_t furi_stream_buffer_receive(
 
     if(FURI_IS_IRQ_MODE()) {
         BaseType_t yield;
-        ret = xStreamBufferReceiveFromISR(stream_buffer, data, length, &yield);
+        ret = xStreamBufferReceiveFromISR(stream_buffer->handle, data, length, &yield);
         portYIELD_FROM_ISR(yield);
     } else {
-        ret = xStreamBufferReceive(stream_buffer, data, length, timeout);
+        ret = xStreamBufferReceive(stream_buffer->handle, data, length, timeout);
+    }
+
+    if(ret > 0) {
+        furi_event_loop_link_notify(&stream_buffer->event_loop_link, FuriEventLoopEventOut);
     }
 
     return ret;
 }
 
 size_t furi_stream_buffer_bytes_available(FuriStreamBuffer* stream_buffer) {
-    return xStreamBufferBytesAvailable(stream_buffer);
+    return xStreamBufferBytesAvailable(stream_buffer->handle);
 };
 
 size_t furi_stream_buffer_spaces_available(FuriStreamBuffer* stream_buffer) {
-    return xStreamBufferSpacesAvailable(stream_buffer);
+    return xStreamBufferSpacesAvailable(stream_buffer->handle);
 };
 
 bool furi_stream_buffer_is_full(FuriStreamBuffer* stream_buffer) {
-    return xStreamBufferIsFull(stream_buffer) == pdTRUE;
+    return xStreamBufferIsFull(stream_buffer->handle) == pdTRUE;
 };
 
 bool furi_stream_buffer_is_empty(FuriStreamBuffer* stream_buffer) {
-    return (xStreamBufferIsEmpty(stream_buffer) == pdTRUE);
+    return (xStreamBufferIsEmpty(stream_buffer->handle) == pdTRUE);
 };
 
 FuriStatus furi_stream_buffer_reset(FuriStreamBuffer* stream_buffer) {
-    if(xStreamBufferReset(stream_buffer) == pdPASS) {
+    if(xStreamBufferReset(stream_buffer->handle) == pdPASS) {
+        furi_event_loop_link_notify(&stream_buffer->event_loop_link, FuriEventLoopEventOut);
         return FuriStatusOk;
     } else {
         return FuriStatusError;
     }
-}
\ No newline at end of file
+}
+
+static FuriEventLoopLink* furi_stream_buffer_event_loop_get_link(void* object) {
+    FuriStreamBuffer* stream_buffer = object;
+    furi_assert(stream_buffer);
+    return &stream_buffer->event_loop_link;
+}
+
+static uint32_t furi_stream_buffer_event_loop_get_level(void* object, FuriEventLoopEvent event) {
+    FuriStreamBuffer* stream_buffer = object;
+    furi_assert(stream_buffer);
+
+    if(event == FuriEventLoopEventIn) {
+        return furi_stream_buffer_bytes_available(stream_buffer);
+    } else {
+        return furi_stream_buffer_spaces_available(stream_buffer);
+    }
+}
+
+const FuriEventLoopContract furi_stream_buffer_event_loop_contract = {
+    .get_link = furi_stream_buffer_event_loop_get_link,
+    .get_level = furi_stream_buffer_event_loop_get_level,
+};
@@ -6,6 +6,7 @@
 #include "common_defines.h"
 #include "mutex.h"
 #include "string.h"
+#include "event_loop_link_i.h"
 
 #include "log.h"
 #include <furi_hal_rtc.h>
@@ -375,6 +376,9 @@ uint32_t furi_thread_flags_set(FuriThreadId thread_id, uint32_t flags) {
             (void)xTaskNotifyIndexed(hTask, THREAD_NOTIFY_INDEX, flags, eSetBits);
             (void)xTaskNotifyAndQueryIndexed(hTask, THREAD_NOTIFY_INDEX, 0, eNoAction, &rflags);
         }
+
+        /* Wake up event loop, if thread is running one */
+        furi_event_loop_thread_flags_notify(thread_id);
     }
     /* Return flags after setting */
     return (rflags);
@@ -21,6 +21,14 @@ Stream* flipper_format_get_raw_stream(FlipperFormat* flipper_format) {
     return flipper_format->stream;
 }
 
+FlipperFormat* flipper_format_stream_based_alloc(Stream* stream) {
+    furi_assert(stream);
+    FlipperFormat* flipper_format = malloc(sizeof(FlipperFormat));
+    flipper_format->stream = stream;
+    flipper_format->strict_mode = false;
+    return flipper_format;
+}
+
 /********************************** Public **********************************/
 
 FlipperFormat* flipper_format_string_alloc() {
@@ -14,6 +14,14 @@ extern "C" {
  */
 Stream* flipper_format_get_raw_stream(FlipperFormat* flipper_format);
 
+/**
+ * Allocate FlipperFormat on top of an existing stream.
+ * The stream is owned by FlipperFormat and is freed by flipper_format_free.
+ * @param stream 
+ * @return FlipperFormat* 
+ */
+FlipperFormat* flipper_format_stream_based_alloc(Stream* stream);
+
 #ifdef __cplusplus
 }
 #endif
@@ -303,7 +303,10 @@ bool flipper_format_stream_write_value_line(Stream* stream, FlipperStreamWriteDa
                 case FlipperStreamValueHexUint64: {
                     const uint64_t* data = write_data->data;
                     furi_string_printf(
-                        value, "%08lX%08lX", (uint32_t)(data[i] >> 32), (uint32_t)data[i]);
+                        value,
+                        "%08" PRIX32 "%08" PRIX32,
+                        (uint32_t)(data[i] >> 32),
+                        (uint32_t)data[i]);
                 }; break;
                 case FlipperStreamValueBool: {
                     const bool* data = write_data->data;
@@ -35,15 +35,37 @@ bool dallas_common_read_rom(OneWireHost* host, DallasCommonRomData* rom_data) {
     return dallas_common_is_valid_crc(rom_data);
 }
 
+bool dallas_common_read_key(
+    OneWireHost* host,
+    DallasCommonRomData* rom_data,
+    uint8_t* mem_data,
+    size_t mem_size,
+    bool overdrive) {
+    if(!onewire_host_reset(host)) return false;
+    if(!dallas_common_read_rom(host, rom_data)) return false;
+    if(mem_size == 0) return true;
+
+    // Read ROM leaves the key selected, overdrive needs selecting it again
+    if(overdrive && !onewire_host_overdrive_skip_rom(host)) {
+        if(!onewire_host_reset(host)) return false;
+        if(!dallas_common_skip_rom(host)) return false;
+    }
+
+    const bool success = dallas_common_read_mem(host, 0, mem_data, mem_size);
+    onewire_host_set_overdrive(host, false);
+
+    return success;
+}
+
 bool dallas_common_write_scratchpad(
     OneWireHost* host,
     uint16_t address,
     const uint8_t* data,
     size_t data_size) {
-    onewire_host_write(host, DALLAS_COMMON_CMD_WRITE_SCRATCH);
-    onewire_host_write(host, (uint8_t)address);
-    onewire_host_write(host, (uint8_t)(address >> BITS_IN_BYTE));
+    const uint8_t cmd[] = {
+        DALLAS_COMMON_CMD_WRITE_SCRATCH, (uint8_t)address, (uint8_t)(address >> BITS_IN_BYTE)};
 
+    onewire_host_write_bytes(host, cmd, sizeof(cmd));
     onewire_host_write_bytes(host, data, data_size);
 
     return true;
@@ -82,11 +104,10 @@ bool dallas_common_copy_scratchpad(
 }
 
 bool dallas_common_read_mem(OneWireHost* host, uint16_t address, uint8_t* data, size_t data_size) {
-    onewire_host_write(host, DALLAS_COMMON_CMD_READ_MEM);
-
-    onewire_host_write(host, (uint8_t)address);
-    onewire_host_write(host, (uint8_t)(address >> BITS_IN_BYTE));
+    const uint8_t cmd[] = {
+        DALLAS_COMMON_CMD_READ_MEM, (uint8_t)address, (uint8_t)(address >> BITS_IN_BYTE)};
 
+    onewire_host_write_bytes(host, cmd, sizeof(cmd));
     onewire_host_read_bytes(host, data, (uint16_t)data_size);
 
     return true;
@@ -71,6 +71,13 @@ bool dallas_common_copy_scratchpad(
 bool dallas_common_read_mem(OneWireHost* host, uint16_t address, uint8_t* data, size_t data_size);
 
 /* Combined operations */
+bool dallas_common_read_key(
+    OneWireHost* host,
+    DallasCommonRomData* rom_data,
+    uint8_t* mem_data,
+    size_t mem_size,
+    bool overdrive);
+
 bool dallas_common_write_mem(
     OneWireHost* host,
     uint32_t timeout_us,
@@ -252,9 +252,9 @@ void dallas_ds1971_apply_edits(iButtonProtocolData* protocol_data) {
 }
 
 bool dallas_ds1971_read_mem(OneWireHost* host, uint8_t address, uint8_t* data, size_t data_size) {
-    onewire_host_write(host, DALLAS_COMMON_CMD_READ_MEM);
+    const uint8_t cmd[] = {DALLAS_COMMON_CMD_READ_MEM, address};
 
-    onewire_host_write(host, address);
+    onewire_host_write_bytes(host, cmd, sizeof(cmd));
     onewire_host_read_bytes(host, data, (uint8_t)data_size);
 
     return true;
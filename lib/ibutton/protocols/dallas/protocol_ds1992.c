@@ -67,8 +67,8 @@ const iButtonProtocolDallasBase ibutton_protocol_ds1992 = {
 
 bool dallas_ds1992_read(OneWireHost* host, iButtonProtocolData* protocol_data) {
     DS1992ProtocolData* data = protocol_data;
-    return onewire_host_reset(host) && dallas_common_read_rom(host, &data->rom_data) &&
-           dallas_common_read_mem(host, 0, data->sram_data, DS1992_SRAM_DATA_SIZE);
+    return dallas_common_read_key(
+        host, &data->rom_data, data->sram_data, DS1992_SRAM_DATA_SIZE, false);
 }
 
 bool dallas_ds1992_write_blank(OneWireHost* host, iButtonProtocolData* protocol_data) {
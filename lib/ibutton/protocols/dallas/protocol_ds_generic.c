@@ -53,7 +53,7 @@ const iButtonProtocolDallasBase ibutton_protocol_ds_generic = {
 
 bool ds_generic_read(OneWireHost* host, iButtonProtocolData* protocol_data) {
     DallasGenericProtocolData* data = protocol_data;
-    return onewire_host_reset(host) && dallas_common_read_rom(host, &data->rom_data);
+    return dallas_common_read_key(host, &data->rom_data, NULL, 0, false);
 }
 
 bool ds_generic_write_blank(OneWireHost* host, iButtonProtocolData* protocol_data) {
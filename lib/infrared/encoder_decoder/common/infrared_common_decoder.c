@@ -314,3 +314,11 @@ void infrared_common_decoder_reset(InfraredCommonDecoder* decoder) {
     infrared_common_decoder_reset_state(decoder);
     decoder->timings_cnt = 0;
 }
+
+/* Idle decoder keeps nothing of the signal, it only looks for preamble mark */
+bool infrared_common_decoder_is_idle(InfraredCommonDecoder* decoder) {
+    furi_assert(decoder);
+
+    return (decoder->state == InfraredCommonDecoderStateWaitPreamble) &&
+           (decoder->timings_cnt == 0) && (decoder->databit_cnt == 0);
+}
@@ -13,12 +13,22 @@
 #include "kaseikyo/infrared_protocol_kaseikyo.h"
 #include "rca/infrared_protocol_rca.h"
 
+#include "nec/infrared_protocol_nec_i.h"
+#include "samsung/infrared_protocol_samsung_i.h"
+#include "rc5/infrared_protocol_rc5_i.h"
+#include "rc6/infrared_protocol_rc6_i.h"
+#include "sirc/infrared_protocol_sirc_i.h"
+#include "kaseikyo/infrared_protocol_kaseikyo_i.h"
+#include "rca/infrared_protocol_rca_i.h"
+
 typedef struct {
     InfraredAlloc alloc;
     InfraredDecode decode;
     InfraredDecoderReset reset;
     InfraredFree free;
     InfraredDecoderCheckReady check_ready;
+    InfraredDecoderIsIdle is_idle;
+    const InfraredTimings* timings;
 } InfraredDecoders;
 
 typedef struct {
@@ -30,6 +40,9 @@ typedef struct {
 
 struct InfraredDecoderHandler {
     void** ctx;
+    uint32_t active; /**< Decoders in contention, only they get every edge */
+    uint32_t reset_pending; /**< Idle decoders to reset before they get next edge */
+    bool level; /**< Level of the last edge */
 };
 
 struct InfraredEncoderHandler {
@@ -50,7 +63,9 @@ static const InfraredEncoderDecoder infrared_encoder_decoder[] = {
              .decode = infrared_decoder_nec_decode,
              .reset = infrared_decoder_nec_reset,
              .check_ready = infrared_decoder_nec_check_ready,
-             .free = infrared_decoder_nec_free},
+             .free = infrared_decoder_nec_free,
+             .is_idle = infrared_decoder_nec_is_idle,
+             .timings = &infrared_protocol_nec.timings},
         .encoder =
             {.alloc = infrared_encoder_nec_alloc,
              .encode = infrared_encoder_nec_encode,
@@ -64,7 +79,9 @@ static const InfraredEncoderDecoder infrared_encoder_decoder[] = {
              .decode = infrared_decoder_samsung32_decode,
              .reset = infrared_decoder_samsung32_reset,
              .check_ready = infrared_decoder_samsung32_check_ready,
-             .free = infrared_decoder_samsung32_free},
+             .free = infrared_decoder_samsung32_free,
+             .is_idle = infrared_decoder_samsung32_is_idle,
+             .timings = &infrared_protocol_samsung32.timings},
         .encoder =
             {.alloc = infrared_encoder_samsung32_alloc,
              .encode = infrared_encoder_samsung32_encode,
@@ -78,7 +95,9 @@ static const InfraredEncoderDecoder infrared_encoder_decoder[] = {
              .decode = infrared_decoder_rc5_decode,
              .reset = infrared_decoder_rc5_reset,
              .check_ready = infrared_decoder_rc5_check_ready,
-             .free = infrared_decoder_rc5_free},
+             .free = infrared_decoder_rc5_free,
+             .is_idle = infrared_decoder_rc5_is_idle,
+             .timings = &infrared_protocol_rc5.timings},
         .encoder =
             {.alloc = infrared_encoder_rc5_alloc,
              .encode = infrared_encoder_rc5_encode,
@@ -92,7 +111,9 @@ static const InfraredEncoderDecoder infrared_encoder_decoder[] = {
              .decode = infrared_decoder_rc6_decode,
              .reset = infrared_decoder_rc6_reset,
              .check_ready = infrared_decoder_rc6_check_ready,
-             .free = infrared_decoder_rc6_free},
+             .free = infrared_decoder_rc6_free,
+             .is_idle = infrared_decoder_rc6_is_idle,
+             .timings = &infrared_protocol_rc6.timings},
         .encoder =
             {.alloc = infrared_encoder_rc6_alloc,
              .encode = infrared_encoder_rc6_encode,
@@ -106,7 +127,9 @@ static const InfraredEncoderDecoder infrared_encoder_decoder[] = {
              .decode = infrared_decoder_sirc_decode,
              .reset = infrared_decoder_sirc_reset,
              .check_ready = infrared_decoder_sirc_check_ready,
-             .free = infrared_decoder_sirc_free},
+             .free = infrared_decoder_sirc_free,
+             .is_idle = infrared_decoder_sirc_is_idle,
+             .timings = &infrared_protocol_sirc.timings},
         .encoder =
             {.alloc = infrared_encoder_sirc_alloc,
              .encode = infrared_encoder_sirc_encode,
@@ -120,7 +143,9 @@ static const InfraredEncoderDecoder infrared_encoder_decoder[] = {
              .decode = infrared_decoder_kaseikyo_decode,
              .reset = infrared_decoder_kaseikyo_reset,
              .check_ready = infrared_decoder_kaseikyo_check_ready,
-             .free = infrared_decoder_kaseikyo_free},
+             .free = infrared_decoder_kaseikyo_free,
+             .is_idle = infrared_decoder_kaseikyo_is_idle,
+             .timings = &infrared_protocol_kaseikyo.timings},
         .encoder =
             {.alloc = infrared_encoder_kaseikyo_alloc,
              .encode = infrared_encoder_kaseikyo_encode,
@@ -134,7 +159,9 @@ static const InfraredEncoderDecoder infrared_encoder_decoder[] = {
              .decode = infrared_decoder_rca_decode,
              .reset = infrared_decoder_rca_reset,
              .check_ready = infrared_decoder_rca_check_ready,
-             .free = infrared_decoder_rca_free},
+             .free = infrared_decoder_rca_free,
+             .is_idle = infrared_decoder_rca_is_idle,
+             .timings = &infrared_protocol_rca.timings},
         .encoder =
             {.alloc = infrared_encoder_rca_alloc,
              .encode = infrared_encoder_rca_encode,
@@ -147,6 +174,21 @@ static const InfraredEncoderDecoder infrared_encoder_decoder[] = {
 static int infrared_find_index_by_protocol(InfraredProtocol protocol);
 static const InfraredProtocolVariant* infrared_get_variant_by_protocol(InfraredProtocol protocol);
 
+_Static_assert(
+    COUNT_OF(infrared_encoder_decoder) <= 32,
+    "InfraredDecoderHandler bitmaps can't hold all decoders");
+
+#define INFRARED_DECODERS_ALL ((1UL << COUNT_OF(infrared_encoder_decoder)) - 1)
+
+/* Idle decoder only has to see the mark that can start its preamble */
+static bool infrared_decoder_is_woken_up(
+    const InfraredDecoders* decoder,
+    bool level,
+    uint32_t duration) {
+    const InfraredTimings* timings = decoder->timings;
+    return level && MATCH_TIMING(duration, timings->preamble_mark, timings->preamble_tolerance);
+}
+
 const InfraredMessage*
     infrared_decode(InfraredDecoderHandler* handler, bool level, uint32_t duration) {
     furi_assert(handler);
@@ -154,12 +196,36 @@ const InfraredMessage*
     InfraredMessage* message = NULL;
     InfraredMessage* result = NULL;
 
+    /* Repeated level resets every decoder, idle ones get it when they wake up */
+    if(handler->level == level) {
+        handler->reset_pending |= ~handler->active & INFRARED_DECODERS_ALL;
+    }
+    handler->level = level;
+
     for(size_t i = 0; i < COUNT_OF(infrared_encoder_decoder); ++i) {
-        if(infrared_encoder_decoder[i].decoder.decode) {
-            message = infrared_encoder_decoder[i].decoder.decode(handler->ctx[i], level, duration);
-            if(!result && message) {
-                result = message;
+        const InfraredDecoders* decoder = &infrared_encoder_decoder[i].decoder;
+        const uint32_t mask = 1UL << i;
+
+        if(!decoder->decode) continue;
+
+        if(!(handler->active & mask)) {
+            if(!infrared_decoder_is_woken_up(decoder, level, duration)) continue;
+            if(handler->reset_pending & mask) {
+                decoder->reset(handler->ctx[i]);
+                handler->reset_pending &= ~mask;
             }
+            handler->active |= mask;
+        }
+
+        message = decoder->decode(handler->ctx[i], level, duration);
+        if(!result && message) {
+            result = message;
+        }
+
+        /* Idle after space: skipped marks and spaces can't change its state from now on.
+         * Protocols without preamble mark have to see every edge. */
+        if(!level && decoder->timings->preamble_mark && decoder->is_idle(handler->ctx[i])) {
+            handler->active &= ~mask;
         }
     }
 
@@ -175,6 +241,9 @@ InfraredDecoderHandler* infrared_alloc_decoder(void) {
         if(infrared_encoder_decoder[i].decoder.alloc)
             handler->ctx[i] = infrared_encoder_decoder[i].decoder.alloc();
     }
+    handler->active = INFRARED_DECODERS_ALL;
+    handler->reset_pending = 0;
+    handler->level = true;
 
     infrared_reset_decoder(handler);
     return handler;
@@ -194,10 +263,14 @@ void infrared_free_decoder(InfraredDecoderHandler* handler) {
 }
 
 void infrared_reset_decoder(InfraredDecoderHandler* handler) {
+    furi_assert(handler);
+
     for(size_t i = 0; i < COUNT_OF(infrared_encoder_decoder); ++i) {
+        if(!(handler->active & (1UL << i))) continue;
         if(infrared_encoder_decoder[i].decoder.reset)
             infrared_encoder_decoder[i].decoder.reset(handler->ctx[i]);
     }
+    handler->reset_pending |= ~handler->active & INFRARED_DECODERS_ALL;
 }
 
 const InfraredMessage* infrared_check_decoder_ready(InfraredDecoderHandler* handler) {
@@ -206,7 +279,9 @@ const InfraredMessage* infrared_check_decoder_ready(InfraredDecoderHandler* hand
     InfraredMessage* message = NULL;
     InfraredMessage* result = NULL;
 
+    /* Idle decoders have nothing to check */
     for(size_t i = 0; i < COUNT_OF(infrared_encoder_decoder); ++i) {
+        if(!(handler->active & (1UL << i))) continue;
         if(infrared_encoder_decoder[i].decoder.check_ready) {
             message = infrared_encoder_decoder[i].decoder.check_ready(handler->ctx[i]);
             if(!result && message) {
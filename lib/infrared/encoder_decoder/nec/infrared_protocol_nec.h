@@ -18,6 +18,7 @@
 
 void* infrared_decoder_nec_alloc(void);
 void infrared_decoder_nec_reset(void* decoder);
+bool infrared_decoder_nec_is_idle(void* decoder);
 void infrared_decoder_nec_free(void* decoder);
 InfraredMessage* infrared_decoder_nec_check_ready(void* decoder);
 InfraredMessage* infrared_decoder_nec_decode(void* decoder, bool level, uint32_t duration);
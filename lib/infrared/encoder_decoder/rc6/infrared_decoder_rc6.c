@@ -110,3 +110,8 @@ void infrared_decoder_rc6_reset(void* decoder) {
     InfraredRc6Decoder* decoder_rc6 = decoder;
     infrared_common_decoder_reset(decoder_rc6->common_decoder);
 }
+
+bool infrared_decoder_rc6_is_idle(void* decoder) {
+    InfraredRc6Decoder* decoder_rc6 = decoder;
+    return infrared_common_decoder_is_idle(decoder_rc6->common_decoder);
+}
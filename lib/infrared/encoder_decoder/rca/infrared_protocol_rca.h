@@ -18,6 +18,7 @@
 
 void* infrared_decoder_rca_alloc(void);
 void infrared_decoder_rca_reset(void* decoder);
+bool infrared_decoder_rca_is_idle(void* decoder);
 void infrared_decoder_rca_free(void* decoder);
 InfraredMessage* infrared_decoder_rca_check_ready(void* decoder);
 InfraredMessage* infrared_decoder_rca_decode(void* decoder, bool level, uint32_t duration);
@@ -25,6 +25,7 @@
 
 void* infrared_decoder_sirc_alloc(void);
 void infrared_decoder_sirc_reset(void* decoder);
+bool infrared_decoder_sirc_is_idle(void* decoder);
 InfraredMessage* infrared_decoder_sirc_check_ready(void* decoder);
 void infrared_decoder_sirc_free(void* decoder);
 InfraredMessage* infrared_decoder_sirc_decode(void* decoder, bool level, uint32_t duration);
@@ -63,9 +63,11 @@ bool lfrfid_raw_file_write_header(
 }
 
 bool lfrfid_raw_file_write_buffer(LFRFIDRawFile* file, uint8_t* buffer_data, size_t buffer_size) {
+    // size field is 32 bit, as size_t on device, so files are the same on any host
+    uint32_t buffer_size_field = buffer_size;
     size_t size;
-    size = stream_write(file->stream, (uint8_t*)&buffer_size, sizeof(size_t));
-    if(size != sizeof(size_t)) return false;
+    size = stream_write(file->stream, (uint8_t*)&buffer_size_field, sizeof(uint32_t));
+    if(size != sizeof(uint32_t)) return false;
 
     size = stream_write(file->stream, buffer_data, buffer_size);
     if(size != buffer_size) return false;
@@ -106,8 +108,8 @@ bool lfrfid_raw_file_read_pair(
             if(pass_end) *pass_end = true;
         }
 
-        length = stream_read(file->stream, (uint8_t*)&file->buffer_size, sizeof(size_t));
-        if(length != sizeof(size_t)) {
+        length = stream_read(file->stream, (uint8_t*)&file->buffer_size, sizeof(uint32_t));
+        if(length != sizeof(uint32_t)) {
             FURI_LOG_E(TAG, "read pair: failed to read size");
             return false;
         }
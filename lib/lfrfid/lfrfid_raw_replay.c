@@ -0,0 +1,170 @@
+#include "lfrfid_raw_replay.h"
+#include "lfrfid_raw_file.h"
+#include "lfrfid_read_filter.h"
+
+#define TAG "LfRfidRawReplay"
+
+#define LFRFID_RAW_REPLAY_PAIRS_MIN 1024
+
+typedef struct {
+    uint32_t pulse;
+    uint32_t duration;
+    uint32_t time; /**< Capture time at the end of the pair */
+} LFRFIDRawReplayPair;
+
+struct LFRFIDRawReplay {
+    LFRFIDRawReplayPair* pairs;
+    size_t count;
+    size_t capacity;
+    size_t raw_count;
+    uint32_t time;
+    float frequency;
+    float duty_cycle;
+};
+
+LFRFIDRawReplay* lfrfid_raw_replay_alloc(void) {
+    LFRFIDRawReplay* replay = malloc(sizeof(LFRFIDRawReplay));
+    replay->pairs = NULL;
+    replay->count = 0;
+    replay->capacity = 0;
+    replay->raw_count = 0;
+    replay->time = 0;
+    replay->frequency = 0;
+    replay->duty_cycle = 0;
+    return replay;
+}
+
+void lfrfid_raw_replay_free(LFRFIDRawReplay* replay) {
+    free(replay->pairs);
+    free(replay);
+}
+
+static void lfrfid_raw_replay_push(
+    LFRFIDRawReplay* replay,
+    uint32_t pulse,
+    uint32_t duration,
+    uint32_t time) {
+    if(replay->count == replay->capacity) {
+        replay->capacity = MAX(replay->capacity * 2, (size_t)LFRFID_RAW_REPLAY_PAIRS_MIN);
+        replay->pairs = realloc(replay->pairs, replay->capacity * sizeof(LFRFIDRawReplayPair));
+    }
+
+    LFRFIDRawReplayPair* pair = &replay->pairs[replay->count++];
+    pair->pulse = pulse;
+    pair->duration = duration;
+    pair->time = time;
+}
+
+bool lfrfid_raw_replay_load(LFRFIDRawReplay* replay, Storage* storage, const char* path) {
+    furi_assert(replay);
+    furi_assert(path);
+
+    replay->count = 0;
+    replay->raw_count = 0;
+    replay->time = 0;
+
+    LFRFIDRawFile* file = lfrfid_raw_file_alloc(storage);
+    LFRFIDReadFilter* filter = lfrfid_read_filter_alloc(LFRFID_READ_FILTER_MIN_TIME_US);
+    bool success = false;
+
+    do {
+        if(!lfrfid_raw_file_open_read(file, path)) break;
+        if(!lfrfid_raw_file_read_header(file, &replay->frequency, &replay->duty_cycle)) break;
+
+        // raw file read wraps around at the end, stop there
+        bool pass_end = false;
+        while(true) {
+            uint32_t raw_pulse = 0;
+            uint32_t raw_duration = 0;
+            if(!lfrfid_raw_file_read_pair(file, &raw_duration, &raw_pulse, &pass_end)) break;
+            if(pass_end) {
+                success = true;
+                break;
+            }
+
+            replay->raw_count++;
+            replay->time += raw_duration;
+
+            // raw worker stores edges as they come, worker read filters them
+            uint32_t pulse;
+            uint32_t duration;
+            lfrfid_read_filter_feed(filter, true, raw_pulse, &pulse, &duration);
+            if(lfrfid_read_filter_feed(filter, false, raw_duration, &pulse, &duration)) {
+                lfrfid_raw_replay_push(replay, pulse, duration, replay->time);
+            }
+        }
+    } while(false);
+
+    if(!success) {
+        FURI_LOG_E(TAG, "Can't load %s", path);
+        replay->count = 0;
+    }
+
+    lfrfid_read_filter_free(filter);
+    lfrfid_raw_file_free(file);
+    return success;
+}
+
+float lfrfid_raw_replay_get_frequency(LFRFIDRawReplay* replay) {
+    return replay->frequency;
+}
+
+float lfrfid_raw_replay_get_duty_cycle(LFRFIDRawReplay* replay) {
+    return replay->duty_cycle;
+}
+
+size_t lfrfid_raw_replay_get_raw_count(LFRFIDRawReplay* replay) {
+    return replay->raw_count;
+}
+
+size_t lfrfid_raw_replay_get_count(LFRFIDRawReplay* replay) {
+    return replay->count;
+}
+
+uint32_t lfrfid_raw_replay_get_time(LFRFIDRawReplay* replay) {
+    return replay->time;
+}
+
+void lfrfid_raw_replay_get_pair(
+    LFRFIDRawReplay* replay,
+    size_t index,
+    uint32_t* pulse,
+    uint32_t* duration) {
+    furi_check(index < replay->count);
+    *pulse = replay->pairs[index].pulse;
+    *duration = replay->pairs[index].duration;
+}
+
+size_t lfrfid_raw_replay_run(
+    LFRFIDRawReplay* replay,
+    LFRFIDReadDecoder* decoder,
+    LFRFIDRawReplayCallback callback,
+    void* context) {
+    furi_assert(replay);
+    furi_assert(decoder);
+
+    size_t settled = 0;
+    lfrfid_read_decoder_reset(decoder);
+
+    for(size_t i = 0; i < replay->count; i++) {
+        LFRFIDRawReplayPair* pair = &replay->pairs[i];
+        LFRFIDRawReplayDecode decode = {
+            .index = i,
+            .time = pair->time,
+            .protocol = PROTOCOL_NO,
+        };
+
+        decode.event =
+            lfrfid_read_decoder_feed(decoder, pair->pulse, pair->duration, &decode.protocol);
+        if(decode.event == LFRFIDReadDecoderEventNone) continue;
+
+        if(callback) callback(&decode, context);
+
+        if(decode.event == LFRFIDReadDecoderEventSettled) {
+            settled++;
+            lfrfid_read_decoder_reset(decoder);
+        }
+    }
+
+    return settled;
+}
@@ -0,0 +1,133 @@
+/**
+ * @file lfrfid_raw_replay.h
+ *
+ * LF-RFID raw replay: loads a capture written by lfrfid raw worker, filters it
+ * as lfrfid worker read does and feeds it to the read decoder
+ */
+
+#pragma once
+#include <storage/storage.h>
+#include "lfrfid_read_decoder.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct LFRFIDRawReplay LFRFIDRawReplay;
+
+typedef struct {
+    size_t index; /**< Filtered pair that completed the decode */
+    uint32_t time; /**< Capture time at the end of the pair, us */
+    LFRFIDReadDecoderEvent event;
+    ProtocolId protocol;
+} LFRFIDRawReplayDecode;
+
+/**
+ * @brief Called for every decode of the replay
+ *
+ * Read decoder is not reset yet, lfrfid_read_decoder_get_data returns decoded data.
+ */
+typedef void (*LFRFIDRawReplayCallback)(const LFRFIDRawReplayDecode* decode, void* context);
+
+/**
+ * @brief Allocate raw replay
+ *
+ * @return LFRFIDRawReplay*
+ */
+LFRFIDRawReplay* lfrfid_raw_replay_alloc(void);
+
+/**
+ * @brief Free raw replay
+ *
+ * @param replay
+ */
+void lfrfid_raw_replay_free(LFRFIDRawReplay* replay);
+
+/**
+ * @brief Load capture
+ *
+ * Every pair of the file is read once and split to pulse and period edges,
+ * edges go through lfrfid read filter with worker noise spike length.
+ *
+ * @param replay
+ * @param storage
+ * @param path raw file
+ * @return bool false if file can't be opened or is broken
+ */
+bool lfrfid_raw_replay_load(LFRFIDRawReplay* replay, Storage* storage, const char* path);
+
+/**
+ * @brief Get carrier frequency of loaded capture
+ *
+ * @param replay
+ * @return float Hz
+ */
+float lfrfid_raw_replay_get_frequency(LFRFIDRawReplay* replay);
+
+/**
+ * @brief Get carrier duty cycle of loaded capture
+ *
+ * @param replay
+ * @return float
+ */
+float lfrfid_raw_replay_get_duty_cycle(LFRFIDRawReplay* replay);
+
+/**
+ * @brief Get count of pairs stored in the file
+ *
+ * @param replay
+ * @return size_t
+ */
+size_t lfrfid_raw_replay_get_raw_count(LFRFIDRawReplay* replay);
+
+/**
+ * @brief Get count of pairs left by the filter
+ *
+ * @param replay
+ * @return size_t
+ */
+size_t lfrfid_raw_replay_get_count(LFRFIDRawReplay* replay);
+
+/**
+ * @brief Get capture length
+ *
+ * @param replay
+ * @return uint32_t us
+ */
+uint32_t lfrfid_raw_replay_get_time(LFRFIDRawReplay* replay);
+
+/**
+ * @brief Get filtered pair
+ *
+ * @param replay
+ * @param index pair index, less than lfrfid_raw_replay_get_count
+ * @param pulse high level duration, us
+ * @param duration pulse period, us
+ */
+void lfrfid_raw_replay_get_pair(
+    LFRFIDRawReplay* replay,
+    size_t index,
+    uint32_t* pulse,
+    uint32_t* duration);
+
+/**
+ * @brief Feed filtered pairs to read decoder
+ *
+ * Decoder is reset before the replay and after every settled read, as worker
+ * starts a new read, so a capture of a tag settles repeatedly.
+ *
+ * @param replay
+ * @param decoder
+ * @param callback called for every decode, can be NULL
+ * @param context
+ * @return size_t settled read count
+ */
+size_t lfrfid_raw_replay_run(
+    LFRFIDRawReplay* replay,
+    LFRFIDReadDecoder* decoder,
+    LFRFIDRawReplayCallback callback,
+    void* context);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,211 @@
+#include "lfrfid_read_decoder.h"
+#include <furi.h>
+
+_Static_assert(LFRFIDProtocolMax <= 32, "protocol mask is too small");
+
+typedef struct {
+    uint32_t protocols; /**< Mask of protocols decoded by family */
+    ProtocolId protocol;
+    uint8_t* data;
+    size_t read_count;
+} LFRFIDReadDecoderFamilyState;
+
+struct LFRFIDReadDecoder {
+    ProtocolDict* dict;
+    LFRFIDReadDecoderFamilyState family[LFRFIDReadDecoderFamilyCount];
+    uint8_t* protocol_data;
+    size_t data_size;
+    LFRFIDReadDecoderFamily result_family; /**< Family of the last feed result */
+};
+
+static const uint32_t lfrfid_read_decoder_family_feature[LFRFIDReadDecoderFamilyCount] = {
+    [LFRFIDReadDecoderFamilyASK] = LFRFIDFeatureASK,
+    [LFRFIDReadDecoderFamilyPSK] = LFRFIDFeaturePSK,
+};
+
+LFRFIDReadDecoder* lfrfid_read_decoder_alloc(ProtocolDict* dict, LFRFIDFeature features) {
+    furi_assert(dict);
+    furi_check(features & (LFRFIDFeatureASK | LFRFIDFeaturePSK));
+
+    LFRFIDReadDecoder* decoder = malloc(sizeof(LFRFIDReadDecoder));
+    decoder->dict = dict;
+    decoder->data_size = protocol_dict_get_max_data_size(dict);
+    decoder->protocol_data = malloc(decoder->data_size);
+    decoder->result_family = LFRFIDReadDecoderFamilyASK;
+
+    // Protocol that has both features is decoded once, by the first family that runs
+    uint32_t assigned = 0;
+    for(size_t i = 0; i < LFRFIDReadDecoderFamilyCount; i++) {
+        LFRFIDReadDecoderFamilyState* family = &decoder->family[i];
+        family->protocols = 0;
+        family->data = malloc(decoder->data_size);
+
+        uint32_t feature = lfrfid_read_decoder_family_feature[i] & features;
+        for(size_t id = 0; feature && id < LFRFIDProtocolMax; id++) {
+            if((protocol_dict_get_features(dict, id) & feature) && !(assigned & (1UL << id))) {
+                family->protocols |= 1UL << id;
+            }
+        }
+        assigned |= family->protocols;
+    }
+
+    lfrfid_read_decoder_reset(decoder);
+    return decoder;
+}
+
+void lfrfid_read_decoder_free(LFRFIDReadDecoder* decoder) {
+    for(size_t i = 0; i < LFRFIDReadDecoderFamilyCount; i++) {
+        free(decoder->family[i].data);
+    }
+    free(decoder->protocol_data);
+    free(decoder);
+}
+
+static void lfrfid_read_decoder_family_start(
+    LFRFIDReadDecoder* decoder,
+    LFRFIDReadDecoderFamilyState* family) {
+    for(size_t id = 0; id < LFRFIDProtocolMax; id++) {
+        if(family->protocols & (1UL << id)) {
+            protocol_dict_decoders_start_by_id(decoder->dict, id);
+        }
+    }
+}
+
+static ProtocolId lfrfid_read_decoder_family_feed(
+    LFRFIDReadDecoder* decoder,
+    LFRFIDReadDecoderFamilyState* family,
+    bool level,
+    uint32_t duration) {
+    ProtocolId ready = PROTOCOL_NO;
+
+    // every decoder gets the pulse, first ready one wins
+    for(size_t id = 0; id < LFRFIDProtocolMax; id++) {
+        if(family->protocols & (1UL << id)) {
+            ProtocolId protocol =
+                protocol_dict_decoders_feed_by_id(decoder->dict, id, level, duration);
+            if(ready == PROTOCOL_NO) ready = protocol;
+        }
+    }
+
+    return ready;
+}
+
+void lfrfid_read_decoder_reset(LFRFIDReadDecoder* decoder) {
+    for(size_t i = 0; i < LFRFIDReadDecoderFamilyCount; i++) {
+        LFRFIDReadDecoderFamilyState* family = &decoder->family[i];
+        family->protocol = PROTOCOL_NO;
+        family->read_count = 0;
+        lfrfid_read_decoder_family_start(decoder, family);
+    }
+}
+
+// Score is read count against count needed to settle, compared as fractions
+static bool lfrfid_read_decoder_is_ahead(
+    LFRFIDReadDecoder* decoder,
+    LFRFIDReadDecoderFamilyState* family,
+    LFRFIDReadDecoderFamilyState* other) {
+    if(other->protocol == PROTOCOL_NO) return true;
+
+    size_t validate = protocol_dict_get_validate_count(decoder->dict, family->protocol);
+    size_t other_validate = protocol_dict_get_validate_count(decoder->dict, other->protocol);
+
+    return (family->read_count + 1) * (other_validate + 1) >=
+           (other->read_count + 1) * (validate + 1);
+}
+
+static LFRFIDReadDecoderEvent lfrfid_read_decoder_feed_family(
+    LFRFIDReadDecoder* decoder,
+    LFRFIDReadDecoderFamily index,
+    uint32_t pulse,
+    uint32_t duration,
+    ProtocolId* protocol) {
+    LFRFIDReadDecoderFamilyState* family = &decoder->family[index];
+
+    ProtocolId decoded = lfrfid_read_decoder_family_feed(decoder, family, true, pulse);
+    if(decoded == PROTOCOL_NO) {
+        decoded = lfrfid_read_decoder_family_feed(decoder, family, false, duration - pulse);
+    }
+    if(decoded == PROTOCOL_NO) return LFRFIDReadDecoderEventNone;
+
+    LFRFIDReadDecoderEvent event = LFRFIDReadDecoderEventDecoded;
+    size_t data_size = protocol_dict_get_data_size(decoder->dict, decoded);
+    protocol_dict_get_data(decoder->dict, decoded, decoder->protocol_data, data_size);
+
+    if(decoded == family->protocol &&
+       memcmp(family->data, decoder->protocol_data, data_size) == 0) {
+        family->read_count++;
+
+        LFRFIDReadDecoderFamilyState* other =
+            &decoder->family[(index + 1) % LFRFIDReadDecoderFamilyCount];
+        if(family->read_count >= protocol_dict_get_validate_count(decoder->dict, decoded) &&
+           lfrfid_read_decoder_is_ahead(decoder, family, other)) {
+            event = LFRFIDReadDecoderEventSettled;
+        }
+    } else {
+        family->protocol = decoded;
+        memcpy(family->data, decoder->protocol_data, data_size);
+        family->read_count = 0;
+    }
+
+    // keep settled data in dict, other family keeps decoding, only restart this one
+    if(event != LFRFIDReadDecoderEventSettled) {
+        lfrfid_read_decoder_family_start(decoder, family);
+    }
+
+    *protocol = decoded;
+    return event;
+}
+
+LFRFIDReadDecoderEvent lfrfid_read_decoder_feed(
+    LFRFIDReadDecoder* decoder,
+    uint32_t pulse,
+    uint32_t duration,
+    ProtocolId* protocol) {
+    furi_assert(decoder);
+    furi_assert(protocol);
+
+    LFRFIDReadDecoderEvent result = LFRFIDReadDecoderEventNone;
+    *protocol = PROTOCOL_NO;
+
+    for(size_t i = 0; i < LFRFIDReadDecoderFamilyCount; i++) {
+        if(!decoder->family[i].protocols) continue;
+
+        ProtocolId decoded = PROTOCOL_NO;
+        LFRFIDReadDecoderEvent event =
+            lfrfid_read_decoder_feed_family(decoder, i, pulse, duration, &decoded);
+
+        if(event > result) {
+            result = event;
+            *protocol = decoded;
+            decoder->result_family = i;
+        }
+        if(result == LFRFIDReadDecoderEventSettled) break;
+    }
+
+    return result;
+}
+
+void lfrfid_read_decoder_get_data(LFRFIDReadDecoder* decoder, uint8_t* data, size_t data_size) {
+    furi_assert(decoder);
+    furi_check(data_size <= decoder->data_size);
+    // family data is what it decoded last, feed result is the last decode
+    memcpy(data, decoder->family[decoder->result_family].data, data_size);
+}
+
+ProtocolId
+    lfrfid_read_decoder_get_protocol(LFRFIDReadDecoder* decoder, LFRFIDReadDecoderFamily family) {
+    furi_assert(family < LFRFIDReadDecoderFamilyCount);
+    return decoder->family[family].protocol;
+}
+
+uint8_t lfrfid_read_decoder_get_confidence(
+    LFRFIDReadDecoder* decoder,
+    LFRFIDReadDecoderFamily family) {
+    furi_assert(family < LFRFIDReadDecoderFamilyCount);
+    LFRFIDReadDecoderFamilyState* state = &decoder->family[family];
+    if(state->protocol == PROTOCOL_NO) return 0;
+
+    size_t validate = protocol_dict_get_validate_count(decoder->dict, state->protocol);
+    size_t confidence = (state->read_count + 1) * 100 / (validate + 1);
+    return MIN(confidence, 100U);
+}
@@ -0,0 +1,107 @@
+/**
+ * @file lfrfid_read_decoder.h
+ *
+ * LF-RFID read decoder: runs ASK and PSK decoder families on the same pulse
+ * stream, validates reads of every family and settles the result
+ */
+
+#pragma once
+#include <toolbox/protocols/protocol_dict.h>
+#include "protocols/lfrfid_protocols.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    LFRFIDReadDecoderFamilyASK,
+    LFRFIDReadDecoderFamilyPSK,
+    LFRFIDReadDecoderFamilyCount,
+} LFRFIDReadDecoderFamily;
+
+typedef enum {
+    LFRFIDReadDecoderEventNone, /**< Nothing decoded */
+    LFRFIDReadDecoderEventDecoded, /**< Protocol decoded, read is not settled yet */
+    LFRFIDReadDecoderEventSettled, /**< Read is settled */
+} LFRFIDReadDecoderEvent;
+
+typedef struct LFRFIDReadDecoder LFRFIDReadDecoder;
+
+/**
+ * @brief Allocate read decoder
+ *
+ * @param dict protocols to decode, must outlive the decoder
+ * @param features families to run, LFRFIDFeatureASK and/or LFRFIDFeaturePSK
+ * @return LFRFIDReadDecoder*
+ */
+LFRFIDReadDecoder* lfrfid_read_decoder_alloc(ProtocolDict* dict, LFRFIDFeature features);
+
+/**
+ * @brief Free read decoder
+ *
+ * @param decoder
+ */
+void lfrfid_read_decoder_free(LFRFIDReadDecoder* decoder);
+
+/**
+ * @brief Restart decoders and forget reads of all families
+ *
+ * @param decoder
+ */
+void lfrfid_read_decoder_reset(LFRFIDReadDecoder* decoder);
+
+/**
+ * @brief Feed one captured pulse to every family
+ *
+ * A family counts a read when it decodes the same protocol and data as last time.
+ * Read is settled when a family has enough reads for the protocol validate count
+ * and is at least as confident as the other family, so a family that matches by
+ * chance does not win over the one that keeps reading the tag.
+ *
+ * @param decoder
+ * @param pulse high level duration, us
+ * @param duration pulse period, us
+ * @param protocol decoded or settled protocol, PROTOCOL_NO if nothing was decoded
+ * @return LFRFIDReadDecoderEvent
+ */
+LFRFIDReadDecoderEvent lfrfid_read_decoder_feed(
+    LFRFIDReadDecoder* decoder,
+    uint32_t pulse,
+    uint32_t duration,
+    ProtocolId* protocol);
+
+/**
+ * @brief Get data of protocol returned by the last feed that decoded something
+ *
+ * Feed restarts decoders of a family that did not settle, so the dict holds
+ * data of settled protocol only.
+ *
+ * @param decoder
+ * @param data output buffer
+ * @param data_size protocol data size
+ */
+void lfrfid_read_decoder_get_data(LFRFIDReadDecoder* decoder, uint8_t* data, size_t data_size);
+
+/**
+ * @brief Get last protocol decoded by family
+ *
+ * @param decoder
+ * @param family
+ * @return ProtocolId PROTOCOL_NO if family decoded nothing yet
+ */
+ProtocolId
+    lfrfid_read_decoder_get_protocol(LFRFIDReadDecoder* decoder, LFRFIDReadDecoderFamily family);
+
+/**
+ * @brief Get family confidence: reads of the same data against reads needed to settle
+ *
+ * @param decoder
+ * @param family
+ * @return uint8_t percent, 100 when family has enough reads
+ */
+uint8_t
+    lfrfid_read_decoder_get_confidence(LFRFIDReadDecoder* decoder, LFRFIDReadDecoderFamily family);
+
+#ifdef __cplusplus
+}
+#endif
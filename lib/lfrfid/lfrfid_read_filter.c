@@ -0,0 +1,62 @@
+#include "lfrfid_read_filter.h"
+#include <furi.h>
+
+struct LFRFIDReadFilter {
+    uint32_t min_time;
+    uint32_t pulse;
+    bool has_pulse;
+    bool ignore_next;
+};
+
+LFRFIDReadFilter* lfrfid_read_filter_alloc(uint32_t min_time) {
+    LFRFIDReadFilter* filter = malloc(sizeof(LFRFIDReadFilter));
+    filter->min_time = min_time;
+    lfrfid_read_filter_reset(filter);
+    return filter;
+}
+
+void lfrfid_read_filter_free(LFRFIDReadFilter* filter) {
+    free(filter);
+}
+
+void lfrfid_read_filter_reset(LFRFIDReadFilter* filter) {
+    filter->pulse = 0;
+    filter->has_pulse = false;
+    filter->ignore_next = false;
+}
+
+bool lfrfid_read_filter_feed(
+    LFRFIDReadFilter* filter,
+    bool level,
+    uint32_t time,
+    uint32_t* pulse,
+    uint32_t* duration) {
+    // ignore edge if last pulse was noise
+    if(filter->ignore_next) {
+        filter->ignore_next = false;
+        return false;
+    }
+
+    // ignore noise spikes
+    if(time <= filter->min_time) {
+        if(level) {
+            filter->ignore_next = true;
+        }
+        filter->has_pulse = false;
+        return false;
+    }
+
+    if(level) {
+        // second pulse in a row breaks the pair
+        filter->pulse = time;
+        filter->has_pulse = !filter->has_pulse;
+        return false;
+    }
+
+    if(!filter->has_pulse) return false;
+
+    filter->has_pulse = false;
+    *pulse = filter->pulse;
+    *duration = time;
+    return true;
+}
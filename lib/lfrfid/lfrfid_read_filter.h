@@ -0,0 +1,66 @@
+/**
+ * @file lfrfid_read_filter.h
+ *
+ * LF-RFID read filter: drops comparator noise spikes and pairs captured edges
+ * into pulse and period, the way lfrfid worker does before decoding
+ */
+
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Noise spike length used by lfrfid worker read, us */
+#define LFRFID_READ_FILTER_MIN_TIME_US 16
+
+typedef struct LFRFIDReadFilter LFRFIDReadFilter;
+
+/**
+ * @brief Allocate read filter
+ *
+ * @param min_time edges not longer than this are noise, us
+ * @return LFRFIDReadFilter*
+ */
+LFRFIDReadFilter* lfrfid_read_filter_alloc(uint32_t min_time);
+
+/**
+ * @brief Free read filter
+ *
+ * @param filter
+ */
+void lfrfid_read_filter_free(LFRFIDReadFilter* filter);
+
+/**
+ * @brief Forget pair being built and pending noise
+ *
+ * @param filter
+ */
+void lfrfid_read_filter_reset(LFRFIDReadFilter* filter);
+
+/**
+ * @brief Feed one captured edge, safe to call from ISR
+ *
+ * Noise spike drops the pair being built, spike of high level also drops the
+ * edge after it. Pulse that comes while the pair is waiting for its period
+ * drops the pair too.
+ *
+ * @param filter
+ * @param level true for pulse, false for period
+ * @param time pulse or period duration, us
+ * @param pulse high level duration of completed pair, us
+ * @param duration period of completed pair, us
+ * @return bool pair is complete
+ */
+bool lfrfid_read_filter_feed(
+    LFRFIDReadFilter* filter,
+    bool level,
+    uint32_t time,
+    uint32_t* pulse,
+    uint32_t* duration);
+
+#ifdef __cplusplus
+}
+#endif
@@ -23,6 +23,7 @@ typedef enum {
     LFRFIDWorkerReadTypeAuto,
     LFRFIDWorkerReadTypeASKOnly,
     LFRFIDWorkerReadTypePSKOnly,
+    LFRFIDWorkerReadTypeConcurrent, /**< ASK and PSK decoders on the same capture */
 } LFRFIDWorkerReadType;
 
 typedef enum {
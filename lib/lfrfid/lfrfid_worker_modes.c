@@ -1,6 +1,8 @@
 #include <furi.h>
 #include <furi_hal.h>
 #include "lfrfid_worker_i.h"
+#include "lfrfid_read_decoder.h"
+#include "lfrfid_read_filter.h"
 #include "tools/t5577.h"
 #include <toolbox/pulse_protocols/pulse_glue.h>
 #include <toolbox/buffer_stream.h>
@@ -22,7 +24,6 @@
 #endif
 
 #define LFRFID_WORKER_READ_AVERAGE_COUNT 64
-#define LFRFID_WORKER_READ_MIN_TIME_US 16
 
 #define LFRFID_WORKER_READ_DROP_TIME_MS 50
 #define LFRFID_WORKER_READ_STABILIZE_TIME_MS 450
@@ -55,33 +56,21 @@ void lfrfid_worker_delay(LFRFIDWorker* worker, uint32_t milliseconds) {
 typedef struct {
     BufferStream* stream;
     VarintPair* pair;
-    bool ignore_next_pulse;
+    LFRFIDReadFilter* filter;
 } LFRFIDWorkerReadContext;
 
 static void lfrfid_worker_read_capture(bool level, uint32_t duration, void* context) {
     LFRFIDWorkerReadContext* ctx = context;
 
-    // ignore pulse if last pulse was noise
-    if(ctx->ignore_next_pulse) {
-        ctx->ignore_next_pulse = false;
-        return;
-    }
-
-    // ignore noise spikes
-    if(duration <= LFRFID_WORKER_READ_MIN_TIME_US) {
-        if(level) {
-            ctx->ignore_next_pulse = true;
-        }
-        varint_pair_reset(ctx->pair);
-        return;
-    }
-
 #ifdef LFRFID_WORKER_READ_DEBUG_GPIO
     furi_hal_gpio_write(LFRFID_WORKER_READ_DEBUG_GPIO_VALUE, level);
 #endif
 
-    bool need_to_send = varint_pair_pack(ctx->pair, level, duration);
-    if(need_to_send) {
+    uint32_t pair_pulse;
+    uint32_t pair_duration;
+    if(lfrfid_read_filter_feed(ctx->filter, level, duration, &pair_pulse, &pair_duration)) {
+        varint_pair_pack(ctx->pair, true, pair_pulse);
+        varint_pair_pack(ctx->pair, false, pair_duration);
         buffer_stream_send_from_isr(
             ctx->stream, varint_pair_get_data(ctx->pair), varint_pair_get_size(ctx->pair));
         varint_pair_reset(ctx->pair);
@@ -96,12 +85,13 @@ typedef enum {
 
 static LFRFIDWorkerReadState lfrfid_worker_read_internal(
     LFRFIDWorker* worker,
-    LFRFIDFeature feature,
+    LFRFIDFeature carrier,
+    LFRFIDFeature features,
     uint32_t timeout,
     ProtocolId* result_protocol) {
     LFRFIDWorkerReadState state = LFRFIDWorkerReadTimeout;
 
-    if(feature & LFRFIDFeatureASK) {
+    if(carrier == LFRFIDFeatureASK) {
         furi_hal_rfid_tim_read_start(125000, 0.5);
         FURI_LOG_D(TAG, "Start ASK");
         if(worker->read_cb) {
@@ -118,7 +108,7 @@ static LFRFIDWorkerReadState lfrfid_worker_read_internal(
     // stabilize detector
     lfrfid_worker_delay(worker, LFRFID_WORKER_READ_STABILIZE_TIME_MS);
 
-    protocol_dict_decoders_start(worker->protocols);
+    LFRFIDReadDecoder* decoder = lfrfid_read_decoder_alloc(worker->protocols, features);
 
 #ifdef LFRFID_WORKER_READ_DEBUG_GPIO
     furi_hal_gpio_init_simple(LFRFID_WORKER_READ_DEBUG_GPIO_VALUE, GpioModeOutputPushPull);
@@ -129,6 +119,7 @@ static LFRFIDWorkerReadState lfrfid_worker_read_internal(
 
     LFRFIDWorkerReadContext ctx;
     ctx.pair = varint_pair_alloc();
+    ctx.filter = lfrfid_read_filter_alloc(LFRFID_READ_FILTER_MIN_TIME_US);
     ctx.stream =
         buffer_stream_alloc(LFRFID_WORKER_READ_BUFFER_SIZE, LFRFID_WORKER_READ_BUFFER_COUNT);
 
@@ -136,10 +127,8 @@ static LFRFIDWorkerReadState lfrfid_worker_read_internal(
 
     *result_protocol = PROTOCOL_NO;
     ProtocolId last_protocol = PROTOCOL_NO;
-    size_t last_size = protocol_dict_get_max_data_size(worker->protocols);
-    uint8_t* last_data = malloc(last_size);
-    uint8_t* protocol_data = malloc(last_size);
-    size_t last_read_count = 0;
+    size_t protocol_data_size = protocol_dict_get_max_data_size(worker->protocols);
+    uint8_t* protocol_data = malloc(protocol_data_size);
 
     uint32_t switch_os_tick_last = furi_get_tick();
 
@@ -219,48 +208,27 @@ static LFRFIDWorkerReadState lfrfid_worker_read_internal(
                 }
 
                 ProtocolId protocol = PROTOCOL_NO;
+                LFRFIDReadDecoderEvent event =
+                    lfrfid_read_decoder_feed(decoder, pulse, duration, &protocol);
 
-                protocol = protocol_dict_decoders_feed_by_feature(
-                    worker->protocols, feature, true, pulse);
-                if(protocol == PROTOCOL_NO) {
-                    protocol = protocol_dict_decoders_feed_by_feature(
-                        worker->protocols, feature, false, duration - pulse);
-                }
-
-                if(protocol != PROTOCOL_NO) {
+                if(event == LFRFIDReadDecoderEventSettled) {
+                    state = LFRFIDWorkerReadOK;
+                    *result_protocol = protocol;
+                    break;
+                } else if(event == LFRFIDReadDecoderEventDecoded) {
                     // reset switch timer
                     switch_os_tick_last = furi_get_tick();
 
-                    size_t protocol_data_size =
-                        protocol_dict_get_data_size(worker->protocols, protocol);
-                    protocol_dict_get_data(
-                        worker->protocols, protocol, protocol_data, protocol_data_size);
-
-                    // validate protocol
-                    if(protocol == last_protocol &&
-                       memcmp(last_data, protocol_data, protocol_data_size) == 0) {
-                        last_read_count = last_read_count + 1;
-
-                        size_t validation_count =
-                            protocol_dict_get_validate_count(worker->protocols, protocol);
-
-                        if(last_read_count >= validation_count) {
-                            state = LFRFIDWorkerReadOK;
-                            *result_protocol = protocol;
-                            break;
-                        }
-                    } else {
-                        if(last_protocol == PROTOCOL_NO && worker->read_cb) {
-                            worker->read_cb(
-                                LFRFIDWorkerReadSenseCardStart, protocol, worker->cb_ctx);
-                        }
-
-                        last_protocol = protocol;
-                        memcpy(last_data, protocol_data, protocol_data_size);
-                        last_read_count = 0;
+                    if(last_protocol == PROTOCOL_NO && worker->read_cb) {
+                        worker->read_cb(LFRFIDWorkerReadSenseCardStart, protocol, worker->cb_ctx);
                     }
+                    last_protocol = protocol;
 
                     if(furi_log_get_level() >= FuriLogLevelDebug) {
+                        protocol_data_size =
+                            protocol_dict_get_data_size(worker->protocols, protocol);
+                        lfrfid_read_decoder_get_data(decoder, protocol_data, protocol_data_size);
+
                         FuriString* string_info;
                         string_info = furi_string_alloc();
                         for(uint8_t i = 0; i < protocol_data_size; i++) {
@@ -273,14 +241,15 @@ static LFRFIDWorkerReadState lfrfid_worker_read_internal(
 
                         FURI_LOG_D(
                             TAG,
-                            "%s, %zu, [%s]",
+                            "%s, ASK %u%%, PSK %u%%, [%s]",
                             protocol_dict_get_name(worker->protocols, protocol),
-                            last_read_count,
+                            lfrfid_read_decoder_get_confidence(
+                                decoder, LFRFIDReadDecoderFamilyASK),
+                            lfrfid_read_decoder_get_confidence(
+                                decoder, LFRFIDReadDecoderFamilyPSK),
                             furi_string_get_cstr(string_info));
                         furi_string_free(string_info);
                     }
-
-                    protocol_dict_decoders_start(worker->protocols);
                 }
             }
         }
@@ -316,10 +285,11 @@ static LFRFIDWorkerReadState lfrfid_worker_read_internal(
     furi_hal_rfid_pins_reset();
 
     varint_pair_free(ctx.pair);
+    lfrfid_read_filter_free(ctx.filter);
     buffer_stream_free(ctx.stream);
 
+    lfrfid_read_decoder_free(decoder);
     free(protocol_data);
-    free(last_data);
 
 #ifdef LFRFID_WORKER_READ_DEBUG_GPIO
     furi_hal_gpio_write(LFRFID_WORKER_READ_DEBUG_GPIO_VALUE, false);
@@ -335,6 +305,7 @@ static void lfrfid_worker_mode_read_process(LFRFIDWorker* worker) {
     ProtocolId read_result = PROTOCOL_NO;
     LFRFIDWorkerReadState state;
     LFRFIDFeature feature;
+    LFRFIDFeature features;
 
     if(worker->read_type == LFRFIDWorkerReadTypePSKOnly) {
         feature = LFRFIDFeaturePSK;
@@ -342,11 +313,19 @@ static void lfrfid_worker_mode_read_process(LFRFIDWorker* worker) {
         feature = LFRFIDFeatureASK;
     }
 
-    if(worker->read_type == LFRFIDWorkerReadTypeAuto) {
+    if(worker->read_type == LFRFIDWorkerReadTypeAuto ||
+       worker->read_type == LFRFIDWorkerReadTypeConcurrent) {
         while(1) {
+            // concurrent read runs both families on the same capture
+            if(worker->read_type == LFRFIDWorkerReadTypeConcurrent) {
+                features = LFRFIDFeatureASK | LFRFIDFeaturePSK;
+            } else {
+                features = feature;
+            }
+
             // read for a while
             state = lfrfid_worker_read_internal(
-                worker, feature, LFRFID_WORKER_READ_SWITCH_TIME_MS, &read_result);
+                worker, feature, features, LFRFID_WORKER_READ_SWITCH_TIME_MS, &read_result);
 
             if(state == LFRFIDWorkerReadOK || state == LFRFIDWorkerReadExit) {
                 break;
@@ -364,10 +343,11 @@ static void lfrfid_worker_mode_read_process(LFRFIDWorker* worker) {
     } else {
         while(1) {
             if(worker->read_type == LFRFIDWorkerReadTypeASKOnly) {
-                state = lfrfid_worker_read_internal(worker, feature, UINT32_MAX, &read_result);
+                state = lfrfid_worker_read_internal(
+                    worker, feature, feature, UINT32_MAX, &read_result);
             } else {
                 state = lfrfid_worker_read_internal(
-                    worker, feature, LFRFID_WORKER_READ_SWITCH_TIME_MS, &read_result);
+                    worker, feature, feature, LFRFID_WORKER_READ_SWITCH_TIME_MS, &read_result);
             }
 
             if(state == LFRFIDWorkerReadOK || state == LFRFIDWorkerReadExit) {
@@ -518,9 +498,11 @@ static void lfrfid_worker_mode_write_process(LFRFIDWorker* worker) {
             t5577_write(&request->t5577);
 
             ProtocolId read_result = PROTOCOL_NO;
+            LFRFIDFeature features = protocol_dict_get_features(worker->protocols, protocol);
             LFRFIDWorkerReadState state = lfrfid_worker_read_internal(
                 worker,
-                protocol_dict_get_features(worker->protocols, protocol),
+                (features & LFRFIDFeatureASK) ? LFRFIDFeatureASK : LFRFIDFeaturePSK,
+                features,
                 LFRFID_WORKER_WRITE_VERIFY_TIME_MS,
                 &read_result);
 
@@ -114,6 +114,10 @@ bool protocol_awid_decoder_feed(ProtocolAwid* protocol, bool level, uint32_t dur
     return result;
 };
 
+ProtocolDecoderState protocol_awid_decoder_get_state(ProtocolAwid* protocol) {
+    return fsk_demod_get_state(protocol->decoder.fsk_demod);
+};
+
 static void protocol_awid_encode(const uint8_t* decoded_data, uint8_t* encoded_data) {
     memset(encoded_data, 0, AWID_ENCODED_DATA_SIZE);
 
@@ -252,4 +256,10 @@ const ProtocolBase protocol_awid = {
     .render_data = (ProtocolRenderData)protocol_awid_render_data,
     .render_brief_data = (ProtocolRenderData)protocol_awid_render_brief_data,
     .write_data = (ProtocolWriteData)protocol_awid_write_data,
+    .decoder_activity =
+        {
+            .get_state = (ProtocolDecoderGetState)protocol_awid_decoder_get_state,
+            .min_duration = 0,
+            .max_duration = MAX_TIME - 1,
+        },
 };
\ No newline at end of file
@@ -181,6 +181,12 @@ bool protocol_em4100_decoder_feed(ProtocolEM4100* proto, bool level, uint32_t du
     return result;
 };
 
+ProtocolDecoderState protocol_em4100_decoder_get_state(ProtocolEM4100* proto) {
+    // edges out of short and long windows are ignored
+    UNUSED(proto);
+    return ProtocolDecoderStateIdle;
+};
+
 static void em4100_write_nibble(bool low_nibble, uint8_t data, EM4100DecodedData* encoded_data) {
     uint8_t parity_sum = 0;
     uint8_t start = 0;
@@ -298,4 +304,10 @@ const ProtocolBase protocol_em4100 = {
     .render_data = (ProtocolRenderData)protocol_em4100_render_data,
     .render_brief_data = (ProtocolRenderData)protocol_em4100_render_data,
     .write_data = (ProtocolWriteData)protocol_em4100_write_data,
+    .decoder_activity =
+        {
+            .get_state = (ProtocolDecoderGetState)protocol_em4100_decoder_get_state,
+            .min_duration = EM_READ_SHORT_TIME_LOW + 1,
+            .max_duration = EM_READ_LONG_TIME_HIGH - 1,
+        },
 };
\ No newline at end of file
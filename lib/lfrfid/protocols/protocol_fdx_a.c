@@ -126,6 +126,10 @@ bool protocol_fdx_a_decoder_feed(ProtocolFDXA* protocol, bool level, uint32_t du
     return result;
 };
 
+ProtocolDecoderState protocol_fdx_a_decoder_get_state(ProtocolFDXA* protocol) {
+    return fsk_demod_get_state(protocol->decoder.fsk_demod);
+};
+
 static void protocol_fdx_a_encode(ProtocolFDXA* protocol) {
     protocol->encoded_data[0] = FDXA_PREAMBLE_0;
     protocol->encoded_data[1] = FDXA_PREAMBLE_1;
@@ -249,4 +253,10 @@ const ProtocolBase protocol_fdx_a = {
     .render_data = (ProtocolRenderData)protocol_fdx_a_render_data,
     .render_brief_data = (ProtocolRenderData)protocol_fdx_a_render_data,
     .write_data = (ProtocolWriteData)protocol_fdx_a_write_data,
+    .decoder_activity =
+        {
+            .get_state = (ProtocolDecoderGetState)protocol_fdx_a_decoder_get_state,
+            .min_duration = 0,
+            .max_duration = MAX_TIME - 1,
+        },
 };
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include <lfrfid/tools/bit_lib.h>
 #include "lfrfid_protocols.h"
 #include <furi_hal_rtc.h>
+#include <inttypes.h>
 
 #define FDX_B_ENCODED_BIT_SIZE (128)
 #define FDX_B_ENCODED_BYTE_SIZE (((FDX_B_ENCODED_BIT_SIZE) / 8))
@@ -181,6 +182,11 @@ bool protocol_fdx_b_decoder_feed(ProtocolFDXB* protocol, bool level, uint32_t du
     return result;
 };
 
+ProtocolDecoderState protocol_fdx_b_decoder_get_state(ProtocolFDXB* protocol) {
+    // edges out of short and long windows only reset the short edge flag
+    return protocol->last_short ? ProtocolDecoderStateCandidate : ProtocolDecoderStateIdle;
+};
+
 bool protocol_fdx_b_encoder_start(ProtocolFDXB* protocol) {
     memset(protocol->encoded_data, 0, FDX_B_ENCODED_BYTE_FULL_SIZE);
     bit_lib_set_bit(protocol->encoded_data, 0, 1);
@@ -288,7 +294,7 @@ void protocol_fdx_b_render_data(ProtocolFDXB* protocol, FuriString* result) {
     uint8_t replacement_number = bit_lib_get_bits(protocol->data, 60, 3);
     bool animal_flag = bit_lib_get_bit(protocol->data, 63);
 
-    furi_string_printf(result, "ID: %03u-%012llu\r\n", country_code, national_code);
+    furi_string_printf(result, "ID: %03u-%012" PRIu64 "\r\n", country_code, national_code);
     furi_string_cat_printf(result, "Animal: %s, ", animal_flag ? "Yes" : "No");
 
     float temperature;
@@ -319,7 +325,7 @@ void protocol_fdx_b_render_brief_data(ProtocolFDXB* protocol, FuriString* result
 
     bool animal_flag = bit_lib_get_bit(protocol->data, 63);
 
-    furi_string_printf(result, "ID: %03u-%012llu\r\n", country_code, national_code);
+    furi_string_printf(result, "ID: %03u-%012" PRIu64 "\r\n", country_code, national_code);
     furi_string_cat_printf(result, "Animal: %s, ", animal_flag ? "Yes" : "No");
 
     float temperature;
@@ -380,4 +386,10 @@ const ProtocolBase protocol_fdx_b = {
     .render_data = (ProtocolRenderData)protocol_fdx_b_render_data,
     .render_brief_data = (ProtocolRenderData)protocol_fdx_b_render_brief_data,
     .write_data = (ProtocolWriteData)protocol_fdx_b_write_data,
+    .decoder_activity =
+        {
+            .get_state = (ProtocolDecoderGetState)protocol_fdx_b_decoder_get_state,
+            .min_duration = FDX_B_SHORT_TIME_LOW,
+            .max_duration = FDX_B_LONG_TIME_HIGH,
+        },
 };
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include <toolbox/manchester_decoder.h>
 #include <lfrfid/tools/bit_lib.h>
 #include "lfrfid_protocols.h"
+#include <inttypes.h>
 
 #define GALLAGHER_CLOCK_PER_BIT (32)
 
@@ -191,6 +192,12 @@ bool protocol_gallagher_decoder_feed(ProtocolGallagher* protocol, bool level, ui
     return result;
 };
 
+ProtocolDecoderState protocol_gallagher_decoder_get_state(ProtocolGallagher* protocol) {
+    // edges out of short and long windows are ignored
+    UNUSED(protocol);
+    return ProtocolDecoderStateIdle;
+};
+
 bool protocol_gallagher_encoder_start(ProtocolGallagher* protocol) {
     // Preamble
     bit_lib_set_bits(protocol->encoded_data, 0, 0b01111111, 8);
@@ -276,7 +283,7 @@ void protocol_gallagher_render_data(ProtocolGallagher* protocol, FuriString* res
     uint32_t card_id = bit_lib_get_bits_32(protocol->data, 32, 32);
 
     furi_string_cat_printf(result, "Region: %u, Issue Level: %u\r\n", rc, il);
-    furi_string_cat_printf(result, "FC: %lu, C: %lu\r\n", fc, card_id);
+    furi_string_cat_printf(result, "FC: %" PRIu32 ", C: %" PRIu32 "\r\n", fc, card_id);
 };
 
 const ProtocolBase protocol_gallagher = {
@@ -301,4 +308,10 @@ const ProtocolBase protocol_gallagher = {
     .render_data = (ProtocolRenderData)protocol_gallagher_render_data,
     .render_brief_data = (ProtocolRenderData)protocol_gallagher_render_data,
     .write_data = (ProtocolWriteData)protocol_gallagher_write_data,
+    .decoder_activity =
+        {
+            .get_state = (ProtocolDecoderGetState)protocol_gallagher_decoder_get_state,
+            .min_duration = GALLAGHER_READ_SHORT_TIME_LOW + 1,
+            .max_duration = GALLAGHER_READ_LONG_TIME_HIGH - 1,
+        },
 };
\ No newline at end of file
@@ -207,6 +207,10 @@ bool protocol_h10301_decoder_feed(ProtocolH10301* protocol, bool level, uint32_t
     return result;
 };
 
+ProtocolDecoderState protocol_h10301_decoder_get_state(ProtocolH10301* protocol) {
+    return fsk_demod_get_state(protocol->decoder.fsk_demod);
+};
+
 static void protocol_h10301_write_raw_bit(bool bit, uint8_t position, uint32_t* card_data) {
     if(bit) {
         card_data[position / H10301_BIT_SIZE] |=
@@ -387,4 +391,10 @@ const ProtocolBase protocol_h10301 = {
     .render_data = (ProtocolRenderData)protocol_h10301_render_data,
     .render_brief_data = (ProtocolRenderData)protocol_h10301_render_data,
     .write_data = (ProtocolWriteData)protocol_h10301_write_data,
+    .decoder_activity =
+        {
+            .get_state = (ProtocolDecoderGetState)protocol_h10301_decoder_get_state,
+            .min_duration = 0,
+            .max_duration = MAX_TIME - 1,
+        },
 };
\ No newline at end of file
@@ -112,6 +112,10 @@ bool protocol_hid_ex_generic_decoder_feed(ProtocolHIDEx* protocol, bool level, u
     return result;
 };
 
+ProtocolDecoderState protocol_hid_ex_generic_decoder_get_state(ProtocolHIDEx* protocol) {
+    return fsk_demod_get_state(protocol->decoder.fsk_demod);
+};
+
 static void protocol_hid_ex_generic_encode(ProtocolHIDEx* protocol) {
     protocol->encoded_data[0] = HID_PREAMBLE;
 
@@ -220,4 +224,10 @@ const ProtocolBase protocol_hid_ex_generic = {
     .render_data = (ProtocolRenderData)protocol_hid_ex_generic_render_data,
     .render_brief_data = (ProtocolRenderData)protocol_hid_ex_generic_render_data,
     .write_data = (ProtocolWriteData)protocol_hid_ex_generic_write_data,
+    .decoder_activity =
+        {
+            .get_state = (ProtocolDecoderGetState)protocol_hid_ex_generic_decoder_get_state,
+            .min_duration = 0,
+            .max_duration = MAX_TIME - 1,
+        },
 };
\ No newline at end of file
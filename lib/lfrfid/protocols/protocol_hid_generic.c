@@ -144,6 +144,10 @@ bool protocol_hid_generic_decoder_feed(ProtocolHID* protocol, bool level, uint32
     return result;
 };
 
+ProtocolDecoderState protocol_hid_generic_decoder_get_state(ProtocolHID* protocol) {
+    return fsk_demod_get_state(protocol->decoder.fsk_demod);
+};
+
 static void protocol_hid_generic_encode(ProtocolHID* protocol) {
     protocol->encoded_data[0] = HID_PREAMBLE;
 
@@ -285,4 +289,10 @@ const ProtocolBase protocol_hid_generic = {
     .render_data = (ProtocolRenderData)protocol_hid_generic_render_data,
     .render_brief_data = (ProtocolRenderData)protocol_hid_generic_render_data,
     .write_data = (ProtocolWriteData)protocol_hid_generic_write_data,
+    .decoder_activity =
+        {
+            .get_state = (ProtocolDecoderGetState)protocol_hid_generic_decoder_get_state,
+            .min_duration = 0,
+            .max_duration = MAX_TIME - 1,
+        },
 };
@@ -2,6 +2,7 @@
 #include <toolbox/protocols/protocol.h>
 #include <lfrfid/tools/bit_lib.h>
 #include "lfrfid_protocols.h"
+#include <inttypes.h>
 
 // Example: 4944544B 351FBE4B
 // 01001001 01000100 01010100 01001011       00110101 00011111 10111110 01001011
@@ -146,6 +147,13 @@ bool protocol_idteck_decoder_feed(ProtocolIdteck* protocol, bool level, uint32_t
     return result;
 };
 
+ProtocolDecoderState protocol_idteck_decoder_get_state(ProtocolIdteck* protocol) {
+    // edges up to a quarter of bit are ignored, longer ones up to half a bit only feed
+    // the wrong phase decoders
+    UNUSED(protocol);
+    return ProtocolDecoderStateIdle;
+};
+
 bool protocol_idteck_encoder_start(ProtocolIdteck* protocol) {
     memset(protocol->encoded_data, 0, IDTECK_ENCODED_DATA_SIZE);
     *(uint32_t*)&protocol->encoded_data[0] = 0b01001011010101000100010001001001;
@@ -210,12 +218,12 @@ void protocol_idteck_render_data_internal(ProtocolIdteck* protocol, FuriString*
     const uint32_t card = get_card(protocol->data);
 
     if(brief) {
-        furi_string_printf(result, "FC: %08lX\r\nCard: %08lX", fc, card);
+        furi_string_printf(result, "FC: %08" PRIX32 "\r\nCard: %08" PRIX32, fc, card);
     } else {
         furi_string_printf(
             result,
-            "FC: %08lX\r\n"
-            "Card: %08lX\r\n",
+            "FC: %08" PRIX32 "\r\n"
+            "Card: %08" PRIX32 "\r\n",
             fc,
             card);
     }
@@ -266,4 +274,10 @@ const ProtocolBase protocol_idteck = {
     .render_data = (ProtocolRenderData)protocol_idteck_render_data,
     .render_brief_data = (ProtocolRenderData)protocol_idteck_render_brief_data,
     .write_data = (ProtocolWriteData)protocol_idteck_write_data,
+    .decoder_activity =
+        {
+            .get_state = (ProtocolDecoderGetState)protocol_idteck_decoder_get_state,
+            .min_duration = (IDTECK_US_PER_BIT / 4) + 1,
+            .max_duration = UINT32_MAX,
+        },
 };
\ No newline at end of file
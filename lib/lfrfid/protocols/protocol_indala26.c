@@ -148,6 +148,13 @@ bool protocol_indala26_decoder_feed(ProtocolIndala* protocol, bool level, uint32
     return result;
 };
 
+ProtocolDecoderState protocol_indala26_decoder_get_state(ProtocolIndala* protocol) {
+    // edges up to a quarter of bit are ignored, longer ones up to half a bit only feed
+    // the wrong phase decoders
+    UNUSED(protocol);
+    return ProtocolDecoderStateIdle;
+};
+
 bool protocol_indala26_encoder_start(ProtocolIndala* protocol) {
     memset(protocol->encoded_data, 0, INDALA26_ENCODED_DATA_SIZE);
     *(uint32_t*)&protocol->encoded_data[0] = 0b00000000000000000000000010100000;
@@ -353,4 +360,10 @@ const ProtocolBase protocol_indala26 = {
     .render_data = (ProtocolRenderData)protocol_indala26_render_data,
     .render_brief_data = (ProtocolRenderData)protocol_indala26_render_brief_data,
     .write_data = (ProtocolWriteData)protocol_indala26_write_data,
+    .decoder_activity =
+        {
+            .get_state = (ProtocolDecoderGetState)protocol_indala26_decoder_get_state,
+            .min_duration = (INDALA26_US_PER_BIT / 4) + 1,
+            .max_duration = UINT32_MAX,
+        },
 };
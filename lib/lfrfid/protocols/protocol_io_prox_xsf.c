@@ -174,6 +174,10 @@ bool protocol_io_prox_xsf_decoder_feed(ProtocolIOProxXSF* protocol, bool level,
     return result;
 };
 
+ProtocolDecoderState protocol_io_prox_xsf_decoder_get_state(ProtocolIOProxXSF* protocol) {
+    return fsk_demod_get_state(protocol->decoder.fsk_demod);
+};
+
 static void protocol_io_prox_xsf_encode(const uint8_t* decoded_data, uint8_t* encoded_data) {
     // Packet to transmit:
     //
@@ -298,4 +302,10 @@ const ProtocolBase protocol_io_prox_xsf = {
     .render_data = (ProtocolRenderData)protocol_io_prox_xsf_render_data,
     .render_brief_data = (ProtocolRenderData)protocol_io_prox_xsf_render_brief_data,
     .write_data = (ProtocolWriteData)protocol_io_prox_xsf_write_data,
+    .decoder_activity =
+        {
+            .get_state = (ProtocolDecoderGetState)protocol_io_prox_xsf_decoder_get_state,
+            .min_duration = 0,
+            .max_duration = MAX_TIME - 1,
+        },
 };
\ No newline at end of file
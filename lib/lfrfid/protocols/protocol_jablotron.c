@@ -4,6 +4,7 @@
 #include <toolbox/manchester_decoder.h>
 #include <lfrfid/tools/bit_lib.h>
 #include "lfrfid_protocols.h"
+#include <inttypes.h>
 
 #define JABLOTRON_ENCODED_BIT_SIZE (64)
 #define JABLOTRON_ENCODED_BYTE_SIZE (((JABLOTRON_ENCODED_BIT_SIZE) / 8))
@@ -117,6 +118,11 @@ bool protocol_jablotron_decoder_feed(ProtocolJablotron* protocol, bool level, ui
     return false;
 };
 
+ProtocolDecoderState protocol_jablotron_decoder_get_state(ProtocolJablotron* protocol) {
+    // edges out of short and long windows only reset the short edge flag
+    return protocol->last_short ? ProtocolDecoderStateCandidate : ProtocolDecoderStateIdle;
+};
+
 bool protocol_jablotron_encoder_start(ProtocolJablotron* protocol) {
     // preamble
     bit_lib_set_bits(protocol->encoded_data, 0, 0b11111111, 8);
@@ -162,7 +168,7 @@ LevelDuration protocol_jablotron_encoder_yield(ProtocolJablotron* protocol) {
 
 void protocol_jablotron_render_data(ProtocolJablotron* protocol, FuriString* result) {
     uint64_t id = protocol_jablotron_card_id(protocol->data);
-    furi_string_printf(result, "ID: %llX\r\n", id);
+    furi_string_printf(result, "ID: %" PRIX64 "\r\n", id);
 };
 
 bool protocol_jablotron_write_data(ProtocolJablotron* protocol, void* data) {
@@ -208,4 +214,10 @@ const ProtocolBase protocol_jablotron = {
     .render_data = (ProtocolRenderData)protocol_jablotron_render_data,
     .render_brief_data = (ProtocolRenderData)protocol_jablotron_render_data,
     .write_data = (ProtocolWriteData)protocol_jablotron_write_data,
+    .decoder_activity =
+        {
+            .get_state = (ProtocolDecoderGetState)protocol_jablotron_decoder_get_state,
+            .min_duration = JABLOTRON_SHORT_TIME_LOW,
+            .max_duration = JABLOTRON_LONG_TIME_HIGH,
+        },
 };
\ No newline at end of file
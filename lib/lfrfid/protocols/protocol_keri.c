@@ -2,6 +2,7 @@
 #include <toolbox/protocols/protocol.h>
 #include <lfrfid/tools/bit_lib.h>
 #include "lfrfid_protocols.h"
+#include <inttypes.h>
 
 #define KERI_PREAMBLE_BIT_SIZE (33)
 #define KERI_PREAMBLE_DATA_SIZE (5)
@@ -166,6 +167,13 @@ bool protocol_keri_decoder_feed(ProtocolKeri* protocol, bool level, uint32_t dur
     return result;
 };
 
+ProtocolDecoderState protocol_keri_decoder_get_state(ProtocolKeri* protocol) {
+    // edges up to a quarter of bit are ignored, longer ones up to half a bit only feed
+    // the wrong phase decoders
+    UNUSED(protocol);
+    return ProtocolDecoderStateIdle;
+};
+
 bool protocol_keri_encoder_start(ProtocolKeri* protocol) {
     memset(protocol->encoded_data, 0, KERI_ENCODED_DATA_SIZE);
     *(uint32_t*)&protocol->encoded_data[0] = 0b00000000000000000000000011100000;
@@ -218,7 +226,12 @@ void protocol_keri_render_data(ProtocolKeri* protocol, FuriString* result) {
     uint32_t fc = 0;
     uint32_t cn = 0;
     protocol_keri_descramble(&fc, &cn, &data);
-    furi_string_printf(result, "Internal ID: %lu\r\nFC: %lu, Card: %lu\r\n", internal_id, fc, cn);
+    furi_string_printf(
+        result,
+        "Internal ID: %" PRIu32 "\r\nFC: %" PRIu32 ", Card: %" PRIu32 "\r\n",
+        internal_id,
+        fc,
+        cn);
 }
 
 bool protocol_keri_write_data(ProtocolKeri* protocol, void* data) {
@@ -264,4 +277,10 @@ const ProtocolBase protocol_keri = {
     .render_data = (ProtocolRenderData)protocol_keri_render_data,
     .render_brief_data = (ProtocolRenderData)protocol_keri_render_data,
     .write_data = (ProtocolWriteData)protocol_keri_write_data,
+    .decoder_activity =
+        {
+            .get_state = (ProtocolDecoderGetState)protocol_keri_decoder_get_state,
+            .min_duration = (KERI_US_PER_BIT / 4) + 1,
+            .max_duration = UINT32_MAX,
+        },
 };
\ No newline at end of file
@@ -2,6 +2,7 @@
 #include <toolbox/protocols/protocol.h>
 #include <lfrfid/tools/bit_lib.h>
 #include "lfrfid_protocols.h"
+#include <inttypes.h>
 
 #define NEXWATCH_PREAMBLE_BIT_SIZE (8)
 #define NEXWATCH_PREAMBLE_DATA_SIZE (1)
@@ -217,6 +218,13 @@ bool protocol_nexwatch_decoder_feed(ProtocolNexwatch* protocol, bool level, uint
     return result;
 };
 
+ProtocolDecoderState protocol_nexwatch_decoder_get_state(ProtocolNexwatch* protocol) {
+    // edges up to a quarter of bit are ignored, longer ones up to half a bit only feed
+    // the wrong phase decoders
+    UNUSED(protocol);
+    return ProtocolDecoderStateIdle;
+};
+
 bool protocol_nexwatch_encoder_start(ProtocolNexwatch* protocol) {
     memset(protocol->encoded_data, 0, NEXWATCH_ENCODED_DATA_SIZE);
     *(uint32_t*)&protocol->encoded_data[0] = 0b00000000000000000000000001010110;
@@ -278,7 +286,8 @@ void protocol_nexwatch_render_data(ProtocolNexwatch* protocol, FuriString* resul
             break;
         }
     }
-    furi_string_printf(result, "ID: %lu, M:%u\r\nType: %s\r\n", id, mode, magic_items[m_idx].desc);
+    furi_string_printf(
+        result, "ID: %" PRIu32 ", M:%u\r\nType: %s\r\n", id, mode, magic_items[m_idx].desc);
 }
 
 bool protocol_nexwatch_write_data(ProtocolNexwatch* protocol, void* data) {
@@ -320,4 +329,10 @@ const ProtocolBase protocol_nexwatch = {
     .render_data = (ProtocolRenderData)protocol_nexwatch_render_data,
     .render_brief_data = (ProtocolRenderData)protocol_nexwatch_render_data,
     .write_data = (ProtocolWriteData)protocol_nexwatch_write_data,
+    .decoder_activity =
+        {
+            .get_state = (ProtocolDecoderGetState)protocol_nexwatch_decoder_get_state,
+            .min_duration = (NEXWATCH_US_PER_BIT / 4) + 1,
+            .max_duration = UINT32_MAX,
+        },
 };
@@ -127,6 +127,12 @@ bool protocol_pac_stanley_decoder_feed(ProtocolPACStanley* protocol, bool level,
     return false;
 }
 
+ProtocolDecoderState protocol_pac_stanley_decoder_get_state(ProtocolPACStanley* protocol) {
+    // edges that are too short or too long are ignored
+    UNUSED(protocol);
+    return ProtocolDecoderStateIdle;
+}
+
 bool protocol_pac_stanley_encoder_start(ProtocolPACStanley* protocol) {
     memset(protocol->encoded_data, 0, sizeof(protocol->encoded_data));
 
@@ -228,4 +234,10 @@ const ProtocolBase protocol_pac_stanley = {
     .render_data = (ProtocolRenderData)protocol_pac_stanley_render_data,
     .render_brief_data = (ProtocolRenderData)protocol_pac_stanley_render_data,
     .write_data = (ProtocolWriteData)protocol_pac_stanley_write_data,
+    .decoder_activity =
+        {
+            .get_state = (ProtocolDecoderGetState)protocol_pac_stanley_decoder_get_state,
+            .min_duration = PAC_STANLEY_MIN_TIME + 1,
+            .max_duration = PAC_STANLEY_MAX_TIME,
+        },
 };
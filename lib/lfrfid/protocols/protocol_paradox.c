@@ -103,6 +103,10 @@ bool protocol_paradox_decoder_feed(ProtocolParadox* protocol, bool level, uint32
     return false;
 };
 
+ProtocolDecoderState protocol_paradox_decoder_get_state(ProtocolParadox* protocol) {
+    return fsk_demod_get_state(protocol->decoder.fsk_demod);
+};
+
 static void protocol_paradox_encode(const uint8_t* decoded_data, uint8_t* encoded_data) {
     // preamble
     bit_lib_set_bits(encoded_data, 0, 0b00001111, 8);
@@ -237,4 +241,10 @@ const ProtocolBase protocol_paradox = {
     .render_data = (ProtocolRenderData)protocol_paradox_render_data,
     .render_brief_data = (ProtocolRenderData)protocol_paradox_render_brief_data,
     .write_data = (ProtocolWriteData)protocol_paradox_write_data,
+    .decoder_activity =
+        {
+            .get_state = (ProtocolDecoderGetState)protocol_paradox_decoder_get_state,
+            .min_duration = 0,
+            .max_duration = MAX_TIME - 1,
+        },
 };
\ No newline at end of file
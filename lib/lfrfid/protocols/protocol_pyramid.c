@@ -124,6 +124,10 @@ bool protocol_pyramid_decoder_feed(ProtocolPyramid* protocol, bool level, uint32
     return result;
 };
 
+ProtocolDecoderState protocol_pyramid_decoder_get_state(ProtocolPyramid* protocol) {
+    return fsk_demod_get_state(protocol->decoder.fsk_demod);
+};
+
 bool protocol_pyramid_get_parity(const uint8_t* bits, uint8_t type, int length) {
     int x;
     for(x = 0; length > 0; --length) x += bit_lib_get_bit(bits, length - 1);
@@ -279,4 +283,10 @@ const ProtocolBase protocol_pyramid = {
     .render_data = (ProtocolRenderData)protocol_pyramid_render_data,
     .render_brief_data = (ProtocolRenderData)protocol_pyramid_render_data,
     .write_data = (ProtocolWriteData)protocol_pyramid_write_data,
+    .decoder_activity =
+        {
+            .get_state = (ProtocolDecoderGetState)protocol_pyramid_decoder_get_state,
+            .min_duration = 0,
+            .max_duration = MAX_TIME - 1,
+        },
 };
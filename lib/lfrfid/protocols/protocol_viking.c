@@ -3,6 +3,7 @@
 #include <toolbox/manchester_decoder.h>
 #include <lfrfid/tools/bit_lib.h>
 #include "lfrfid_protocols.h"
+#include <inttypes.h>
 
 #define VIKING_CLOCK_PER_BIT (32)
 
@@ -119,6 +120,12 @@ bool protocol_viking_decoder_feed(ProtocolViking* protocol, bool level, uint32_t
     return result;
 };
 
+ProtocolDecoderState protocol_viking_decoder_get_state(ProtocolViking* protocol) {
+    // edges out of short and long windows are ignored
+    UNUSED(protocol);
+    return ProtocolDecoderStateIdle;
+};
+
 bool protocol_viking_encoder_start(ProtocolViking* protocol) {
     // Preamble
     bit_lib_set_bits(protocol->encoded_data, 0, 0b11110010, 8);
@@ -177,7 +184,7 @@ bool protocol_viking_write_data(ProtocolViking* protocol, void* data) {
 
 void protocol_viking_render_data(ProtocolViking* protocol, FuriString* result) {
     uint32_t id = bit_lib_get_bits_32(protocol->data, 0, 32);
-    furi_string_printf(result, "ID: %08lX\r\n", id);
+    furi_string_printf(result, "ID: %08" PRIX32 "\r\n", id);
 };
 
 const ProtocolBase protocol_viking = {
@@ -202,4 +209,10 @@ const ProtocolBase protocol_viking = {
     .render_data = (ProtocolRenderData)protocol_viking_render_data,
     .render_brief_data = (ProtocolRenderData)protocol_viking_render_data,
     .write_data = (ProtocolWriteData)protocol_viking_write_data,
+    .decoder_activity =
+        {
+            .get_state = (ProtocolDecoderGetState)protocol_viking_decoder_get_state,
+            .min_duration = VIKING_READ_SHORT_TIME_LOW + 1,
+            .max_duration = VIKING_READ_LONG_TIME_HIGH - 1,
+        },
 };
\ No newline at end of file
@@ -91,3 +91,13 @@ void fsk_demod_feed(FSKDemod* demod, bool polarity, uint32_t time, bool* value,
         }
     }
 }
+
+ProtocolDecoderState fsk_demod_get_state(FSKDemod* demod) {
+    if(demod->count > 0) {
+        return ProtocolDecoderStateLocked;
+    } else if(demod->time >= demod->hi_time) {
+        return ProtocolDecoderStateIdle;
+    } else {
+        return ProtocolDecoderStateCandidate;
+    }
+}
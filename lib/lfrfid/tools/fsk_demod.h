@@ -1,6 +1,7 @@
 #pragma once
 #include <stdint.h>
 #include <stdbool.h>
+#include <toolbox/protocols/protocol.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -39,6 +40,16 @@ void fsk_demod_free(FSKDemod* fsk_demod);
  */
 void fsk_demod_feed(FSKDemod* demod, bool polarity, uint32_t time, bool* value, uint32_t* count);
 
+/**
+ * @brief Get demodulator state
+ * Demodulator is idle when last period was too long and no valid periods are counted:
+ * samples not shorter than hi_time keep it idle and never yield data
+ * 
+ * @param demod FSKDemod instance
+ * @return ProtocolDecoderState 
+ */
+ProtocolDecoderState fsk_demod_get_state(FSKDemod* demod);
+
 #ifdef __cplusplus
 }
 #endif
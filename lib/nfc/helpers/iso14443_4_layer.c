@@ -7,9 +7,45 @@
 #define ISO14443_4_BLOCK_PCB_R (5U << 5)
 #define ISO14443_4_BLOCK_PCB_S (3U << 6)
 
+#define ISO14443_4_BLOCK_PCB_BN (1U << 0)
+#define ISO14443_4_BLOCK_PCB_NAD (1U << 2)
+#define ISO14443_4_BLOCK_PCB_CID (1U << 3)
+#define ISO14443_4_BLOCK_PCB_I_CHAINING (1U << 4)
+#define ISO14443_4_BLOCK_PCB_R_NAK (1U << 4)
+#define ISO14443_4_BLOCK_PCB_S_WTX (3U << 4)
+
+#define ISO14443_4_BLOCK_PCB_I_MASK (0xE2U)
+#define ISO14443_4_BLOCK_PCB_R_MASK (0xE6U)
+#define ISO14443_4_BLOCK_PCB_S_MASK (0xC6U)
+
+#define ISO14443_4_BLOCK_IS_I(pcb) \
+    (((pcb) & ISO14443_4_BLOCK_PCB_I_MASK) == (ISO14443_4_BLOCK_PCB_I | ISO14443_4_BLOCK_PCB))
+#define ISO14443_4_BLOCK_IS_R(pcb) \
+    (((pcb) & ISO14443_4_BLOCK_PCB_R_MASK) == (ISO14443_4_BLOCK_PCB_R | ISO14443_4_BLOCK_PCB))
+#define ISO14443_4_BLOCK_IS_S(pcb) \
+    (((pcb) & ISO14443_4_BLOCK_PCB_S_MASK) == (ISO14443_4_BLOCK_PCB_S | ISO14443_4_BLOCK_PCB))
+
+#define ISO14443_4_BLOCK_WTXM_MASK (0x3FU)
+#define ISO14443_4_BLOCK_WTXM_MAX (59U)
+
+// PCB and CRC
+#define ISO14443_4_LAYER_FRAME_OVERHEAD (3U)
+#define ISO14443_4_LAYER_FRAME_SIZE_DEFAULT (32U)
+#define ISO14443_4_LAYER_FRAME_SIZE_MAX (256U)
+#define ISO14443_4_LAYER_RETRY_MAX (2U)
+
 struct Iso14443_4Layer {
     uint8_t pcb;
     uint8_t pcb_prev;
+
+    // Block protocol state, see ISO14443-4 7.5.4
+    uint16_t frame_size;
+    const BitBuffer* tx_data;
+    size_t tx_offset;
+    size_t tx_chunk_size;
+    bool rx_chaining;
+    uint8_t retries;
+    uint8_t wtxm;
 };
 
 static inline void iso14443_4_layer_update_pcb(Iso14443_4Layer* instance) {
@@ -32,6 +68,21 @@ void iso14443_4_layer_free(Iso14443_4Layer* instance) {
 void iso14443_4_layer_reset(Iso14443_4Layer* instance) {
     furi_assert(instance);
     instance->pcb = ISO14443_4_BLOCK_PCB_I | ISO14443_4_BLOCK_PCB;
+    instance->frame_size = ISO14443_4_LAYER_FRAME_SIZE_DEFAULT;
+    instance->tx_data = NULL;
+    instance->rx_chaining = false;
+    instance->wtxm = 1;
+}
+
+void iso14443_4_layer_set_frame_size_max(Iso14443_4Layer* instance, uint16_t frame_size) {
+    furi_assert(instance);
+
+    if(frame_size == 0 || frame_size > ISO14443_4_LAYER_FRAME_SIZE_MAX) {
+        frame_size = ISO14443_4_LAYER_FRAME_SIZE_MAX;
+    }
+    furi_check(frame_size > ISO14443_4_LAYER_FRAME_OVERHEAD);
+
+    instance->frame_size = frame_size;
 }
 
 void iso14443_4_layer_encode_block(
@@ -62,3 +113,205 @@ bool iso14443_4_layer_decode_block(
 
     return ret;
 }
+
+static inline bool iso14443_4_layer_is_tx_chaining(const Iso14443_4Layer* instance) {
+    return instance->tx_offset + instance->tx_chunk_size <
+           bit_buffer_get_size_bytes(instance->tx_data);
+}
+
+static void iso14443_4_layer_encode_i_block(Iso14443_4Layer* instance, BitBuffer* block_data) {
+    const size_t tx_size = bit_buffer_get_size_bytes(instance->tx_data);
+    const size_t chunk_size_max = instance->frame_size - ISO14443_4_LAYER_FRAME_OVERHEAD;
+
+    instance->tx_chunk_size = MIN(tx_size - instance->tx_offset, chunk_size_max);
+    const bool chaining = iso14443_4_layer_is_tx_chaining(instance);
+
+    bit_buffer_reset(block_data);
+    bit_buffer_append_byte(
+        block_data, instance->pcb | (chaining ? ISO14443_4_BLOCK_PCB_I_CHAINING : 0));
+    bit_buffer_append_bytes(
+        block_data,
+        bit_buffer_get_data(instance->tx_data) + instance->tx_offset,
+        instance->tx_chunk_size);
+}
+
+static void iso14443_4_layer_encode_r_block(
+    Iso14443_4Layer* instance,
+    BitBuffer* block_data,
+    bool nak) {
+    const uint8_t bn = instance->pcb & ISO14443_4_BLOCK_PCB_BN;
+
+    bit_buffer_reset(block_data);
+    bit_buffer_append_byte(
+        block_data,
+        ISO14443_4_BLOCK_PCB_R | ISO14443_4_BLOCK_PCB | (nak ? ISO14443_4_BLOCK_PCB_R_NAK : 0) |
+            bn);
+}
+
+void iso14443_4_layer_encode_command(
+    Iso14443_4Layer* instance,
+    const BitBuffer* input_data,
+    BitBuffer* block_data) {
+    furi_assert(instance);
+    furi_assert(input_data);
+    furi_assert(block_data);
+
+    instance->tx_data = input_data;
+    instance->tx_offset = 0;
+    instance->rx_chaining = false;
+    instance->retries = 0;
+    instance->wtxm = 1;
+
+    iso14443_4_layer_encode_i_block(instance, block_data);
+}
+
+static Iso14443_4LayerResult iso14443_4_layer_retransmit_i_block(
+    Iso14443_4Layer* instance,
+    BitBuffer* next_block) {
+    if(instance->retries >= ISO14443_4_LAYER_RETRY_MAX) return Iso14443_4LayerResultError;
+    instance->retries++;
+
+    iso14443_4_layer_encode_i_block(instance, next_block);
+    return Iso14443_4LayerResultSend;
+}
+
+static Iso14443_4LayerResult iso14443_4_layer_decode_i_block(
+    Iso14443_4Layer* instance,
+    BitBuffer* output_data,
+    const BitBuffer* block_data,
+    BitBuffer* next_block) {
+    const uint8_t pcb = bit_buffer_get_byte(block_data, 0);
+    const size_t data_size = bit_buffer_get_size_bytes(block_data) - 1;
+
+    // Card must acknowledge every chained command block before responding
+    if(iso14443_4_layer_is_tx_chaining(instance) ||
+       (pcb & ISO14443_4_BLOCK_PCB_BN) != (instance->pcb & ISO14443_4_BLOCK_PCB_BN)) {
+        return iso14443_4_layer_encode_error(instance, next_block);
+    }
+    if(bit_buffer_get_size_bytes(output_data) + data_size >
+       bit_buffer_get_capacity_bytes(output_data)) {
+        return Iso14443_4LayerResultError;
+    }
+
+    bit_buffer_append_right(output_data, block_data, 1);
+    iso14443_4_layer_update_pcb(instance);
+    instance->retries = 0;
+
+    if(pcb & ISO14443_4_BLOCK_PCB_I_CHAINING) {
+        instance->rx_chaining = true;
+        iso14443_4_layer_encode_r_block(instance, next_block, false);
+        return Iso14443_4LayerResultSend;
+    }
+
+    instance->rx_chaining = false;
+    return Iso14443_4LayerResultData;
+}
+
+static Iso14443_4LayerResult iso14443_4_layer_decode_r_block(
+    Iso14443_4Layer* instance,
+    const BitBuffer* block_data,
+    BitBuffer* next_block) {
+    const uint8_t pcb = bit_buffer_get_byte(block_data, 0);
+
+    // Card never sends R(NAK) and only acknowledges chained command blocks
+    if((pcb & ISO14443_4_BLOCK_PCB_R_NAK) || instance->rx_chaining ||
+       bit_buffer_get_size_bytes(block_data) != 1) {
+        return iso14443_4_layer_encode_error(instance, next_block);
+    }
+
+    if((pcb & ISO14443_4_BLOCK_PCB_BN) != (instance->pcb & ISO14443_4_BLOCK_PCB_BN)) {
+        // Card did not receive the last I-block
+        return iso14443_4_layer_retransmit_i_block(instance, next_block);
+    }
+    if(!iso14443_4_layer_is_tx_chaining(instance)) {
+        return iso14443_4_layer_encode_error(instance, next_block);
+    }
+
+    instance->tx_offset += instance->tx_chunk_size;
+    iso14443_4_layer_update_pcb(instance);
+    instance->retries = 0;
+
+    iso14443_4_layer_encode_i_block(instance, next_block);
+    return Iso14443_4LayerResultSend;
+}
+
+static Iso14443_4LayerResult iso14443_4_layer_decode_s_block(
+    Iso14443_4Layer* instance,
+    const BitBuffer* block_data,
+    BitBuffer* next_block) {
+    const uint8_t pcb = bit_buffer_get_byte(block_data, 0);
+
+    // Only S(WTX) request is expected from the card
+    if(pcb != (ISO14443_4_BLOCK_PCB_S | ISO14443_4_BLOCK_PCB_S_WTX | ISO14443_4_BLOCK_PCB) ||
+       bit_buffer_get_size_bytes(block_data) != 2) {
+        return iso14443_4_layer_encode_error(instance, next_block);
+    }
+
+    const uint8_t wtxm = bit_buffer_get_byte(block_data, 1) & ISO14443_4_BLOCK_WTXM_MASK;
+    if(wtxm == 0 || wtxm > ISO14443_4_BLOCK_WTXM_MAX) {
+        return iso14443_4_layer_encode_error(instance, next_block);
+    }
+
+    // Echo WTXM in S(WTX) response, extension applies to the next response only
+    bit_buffer_reset(next_block);
+    bit_buffer_append_byte(next_block, pcb);
+    bit_buffer_append_byte(next_block, wtxm);
+    instance->wtxm = wtxm;
+
+    return Iso14443_4LayerResultSend;
+}
+
+Iso14443_4LayerResult iso14443_4_layer_decode_response(
+    Iso14443_4Layer* instance,
+    BitBuffer* output_data,
+    const BitBuffer* block_data,
+    BitBuffer* next_block) {
+    furi_assert(instance);
+    furi_assert(instance->tx_data);
+    furi_assert(output_data);
+    furi_assert(block_data);
+    furi_assert(next_block);
+
+    instance->wtxm = 1;
+
+    if(bit_buffer_get_size_bytes(block_data) == 0) {
+        return iso14443_4_layer_encode_error(instance, next_block);
+    }
+
+    const uint8_t pcb = bit_buffer_get_byte(block_data, 0);
+
+    // Neither CID nor NAD is used by the poller
+    if(pcb & (ISO14443_4_BLOCK_PCB_CID | ISO14443_4_BLOCK_PCB_NAD)) {
+        return iso14443_4_layer_encode_error(instance, next_block);
+    } else if(ISO14443_4_BLOCK_IS_I(pcb)) {
+        return iso14443_4_layer_decode_i_block(instance, output_data, block_data, next_block);
+    } else if(ISO14443_4_BLOCK_IS_R(pcb)) {
+        return iso14443_4_layer_decode_r_block(instance, block_data, next_block);
+    } else if(ISO14443_4_BLOCK_IS_S(pcb)) {
+        return iso14443_4_layer_decode_s_block(instance, block_data, next_block);
+    } else {
+        return iso14443_4_layer_encode_error(instance, next_block);
+    }
+}
+
+Iso14443_4LayerResult
+    iso14443_4_layer_encode_error(Iso14443_4Layer* instance, BitBuffer* next_block) {
+    furi_assert(instance);
+    furi_assert(instance->tx_data);
+    furi_assert(next_block);
+
+    if(instance->retries >= ISO14443_4_LAYER_RETRY_MAX) return Iso14443_4LayerResultError;
+    instance->retries++;
+    instance->wtxm = 1;
+
+    // Card that is chaining its response expects R(ACK) to resend the lost block
+    iso14443_4_layer_encode_r_block(instance, next_block, !instance->rx_chaining);
+
+    return Iso14443_4LayerResultSend;
+}
+
+uint8_t iso14443_4_layer_get_fwt_multiplier(Iso14443_4Layer* instance) {
+    furi_assert(instance);
+
+    return instance->wtxm;
+}
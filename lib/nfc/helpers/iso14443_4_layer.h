@@ -8,12 +8,27 @@ extern "C" {
 
 typedef struct Iso14443_4Layer Iso14443_4Layer;
 
+typedef enum {
+    Iso14443_4LayerResultSend, /**< Next block is ready to be sent to the card. */
+    Iso14443_4LayerResultData, /**< Exchange is complete, card response is ready. */
+    Iso14443_4LayerResultError, /**< Exchange failed, retransmission limit was reached. */
+} Iso14443_4LayerResult;
+
 Iso14443_4Layer* iso14443_4_layer_alloc();
 
 void iso14443_4_layer_free(Iso14443_4Layer* instance);
 
 void iso14443_4_layer_reset(Iso14443_4Layer* instance);
 
+/** Set maximum frame size accepted by the card (FSC), including PCB and CRC
+ *
+ * Commands that do not fit into one frame are sent with chaining
+ *
+ * @param      instance    Iso14443_4Layer instance
+ * @param      frame_size  FSC in bytes, 0 for the largest supported size
+ */
+void iso14443_4_layer_set_frame_size_max(Iso14443_4Layer* instance, uint16_t frame_size);
+
 void iso14443_4_layer_encode_block(
     Iso14443_4Layer* instance,
     const BitBuffer* input_data,
@@ -24,6 +39,55 @@ bool iso14443_4_layer_decode_block(
     BitBuffer* output_data,
     const BitBuffer* block_data);
 
+/** Start command exchange with the card and encode the first block
+ *
+ * The exchange is driven by iso14443_4_layer_decode_response() and
+ * iso14443_4_layer_encode_error() until they return anything but Send.
+ *
+ * @param      instance    Iso14443_4Layer instance
+ * @param      input_data  Command, must stay valid until the exchange is complete
+ * @param      block_data  Buffer to be filled with the first block
+ */
+void iso14443_4_layer_encode_command(
+    Iso14443_4Layer* instance,
+    const BitBuffer* input_data,
+    BitBuffer* block_data);
+
+/** Process block received from the card
+ *
+ * Handles command and response chaining, S(WTX) requests and R(ACK) retransmission requests.
+ *
+ * @param      instance     Iso14443_4Layer instance
+ * @param      output_data  Buffer the response is appended to, must be empty on exchange start
+ * @param      block_data   Received block without CRC
+ * @param      next_block   Buffer to be filled with the next block on Send
+ *
+ * @return     Iso14443_4LayerResult
+ */
+Iso14443_4LayerResult iso14443_4_layer_decode_response(
+    Iso14443_4Layer* instance,
+    BitBuffer* output_data,
+    const BitBuffer* block_data,
+    BitBuffer* next_block);
+
+/** Process transmission error: response timeout or corrupted frame
+ *
+ * @param      instance    Iso14443_4Layer instance
+ * @param      next_block  Buffer to be filled with R(NAK), or R(ACK) during response chaining
+ *
+ * @return     Send, or Error if retransmission limit was reached
+ */
+Iso14443_4LayerResult
+    iso14443_4_layer_encode_error(Iso14443_4Layer* instance, BitBuffer* next_block);
+
+/** Get frame waiting time multiplier for the next response
+ *
+ * @param      instance  Iso14443_4Layer instance
+ *
+ * @return     WTXM requested by the card, 1 if no extension was requested
+ */
+uint8_t iso14443_4_layer_get_fwt_multiplier(Iso14443_4Layer* instance);
+
 #ifdef __cplusplus
 }
 #endif
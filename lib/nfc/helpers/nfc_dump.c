@@ -0,0 +1,976 @@
+#include "nfc_dump.h"
+
+#include <furi.h>
+#include <ctype.h>
+#include <m-array.h>
+#include <toolbox/crc32_calc.h>
+#include <toolbox/stream/stream_i.h>
+#include <inttypes.h>
+
+#define NFC_DUMP_MAGIC (0x4443464EUL) // "NFCD"
+#define NFC_DUMP_VERSION (2U)
+
+#define NFC_DUMP_FLAG_NO_TRAILING_NEWLINE (1U << 0)
+
+#define NFC_DUMP_LINE_RAW (0U)
+#define NFC_DUMP_LINE_TEXT (1U)
+#define NFC_DUMP_LINE_HEX (2U)
+#define NFC_DUMP_LINE_HEX_MASKED (3U)
+#define NFC_DUMP_LINE_UINT (4U)
+#define NFC_DUMP_LINE_TYPE_MASK (0x07U)
+#define NFC_DUMP_LINE_FLAG_KEY_NEXT (0x08U)
+
+#define NFC_DUMP_SECTION_KEYS (16U)
+#define NFC_DUMP_SECTION_SIZE_MAX (1024U)
+// Hard limits, a single line may push a section past the size above.
+// Fit the biggest MfDesfire file data line an 8K card can have.
+#define NFC_DUMP_SECTION_SIZE_LIMIT (32U * 1024U)
+#define NFC_DUMP_SECTION_TEXT_SIZE_LIMIT (4U * NFC_DUMP_SECTION_SIZE_LIMIT)
+#define NFC_DUMP_TEXT_SIZE_LIMIT (INT32_MAX)
+
+#define NFC_DUMP_KEY_SEPARATOR ": "
+#define NFC_DUMP_KEY_SEPARATOR_LEN (2U)
+#define NFC_DUMP_KEY_NUMBER_DIGITS_MAX (9U)
+#define NFC_DUMP_UINT_DIGITS_MAX (10U)
+
+#define NFC_DUMP_READ_CHUNK_SIZE (64U)
+
+typedef struct FURI_PACKED {
+    uint32_t magic;
+    uint8_t version;
+    uint8_t flags;
+    uint16_t reserved;
+    uint32_t section_count;
+    uint32_t table_offset;
+    uint32_t text_size;
+    uint32_t table_crc;
+} NfcDumpHeader;
+
+typedef struct FURI_PACKED {
+    uint32_t offset;
+    uint32_t size;
+    uint32_t text_size;
+    uint32_t crc;
+} NfcDumpSection;
+
+ARRAY_DEF(NfcDumpSectionArray, NfcDumpSection, M_POD_OPLIST);
+
+struct NfcDump {
+    Stream* stream;
+    NfcDumpHeader header;
+    NfcDumpSection* sections;
+    uint8_t* payload;
+    size_t payload_capacity;
+};
+
+// Numbered key of the previous line, sections are decoded independently so it is reset for each
+typedef struct {
+    FuriString* prefix;
+    uint32_t number;
+    bool valid;
+} NfcDumpKeyState;
+
+// Encodes text written to it line by line, only the line and the section in work are in memory
+typedef struct {
+    Stream stream_base;
+    Stream* dump;
+    NfcDumpHeader header;
+    NfcDumpSectionArray_t sections;
+    NfcDumpSection section;
+    uint8_t* payload;
+    size_t payload_capacity;
+    size_t line_count;
+    NfcDumpKeyState key_state;
+    FuriString* line;
+    size_t position;
+    bool error;
+} NfcDumpTextWriter;
+
+typedef struct {
+    const uint8_t* data;
+    size_t size;
+    size_t position;
+} NfcDumpReader;
+
+typedef struct {
+    Stream stream_base;
+    NfcDump* dump;
+    size_t position;
+    size_t section;
+    size_t* section_start;
+    FuriString* text;
+} NfcDumpTextStream;
+
+static const char nfc_dump_hex_chars[] = "0123456789ABCDEF";
+
+/******************************* Keys *******************************/
+
+static bool nfc_dump_key_split(
+    const char* key,
+    size_t key_len,
+    size_t* prefix_len,
+    uint32_t* number) {
+    size_t digits = 0;
+    while(digits < key_len && isdigit((unsigned char)key[key_len - digits - 1])) {
+        digits++;
+    }
+
+    // Leading zeros would not survive the round trip
+    if(digits == 0 || digits == key_len || digits > NFC_DUMP_KEY_NUMBER_DIGITS_MAX) return false;
+    if(digits > 1 && key[key_len - digits] == '0') return false;
+
+    *prefix_len = key_len - digits;
+    *number = 0;
+    for(size_t i = *prefix_len; i < key_len; i++) {
+        *number = *number * 10 + (key[i] - '0');
+    }
+
+    return true;
+}
+
+static bool nfc_dump_key_state_is_next(
+    const NfcDumpKeyState* state,
+    const char* key,
+    size_t key_len) {
+    size_t prefix_len = 0;
+    uint32_t number = 0;
+
+    return state->valid && nfc_dump_key_split(key, key_len, &prefix_len, &number) &&
+           (number == state->number + 1) && (prefix_len == furi_string_size(state->prefix)) &&
+           (memcmp(key, furi_string_get_cstr(state->prefix), prefix_len) == 0);
+}
+
+static void nfc_dump_key_state_update(NfcDumpKeyState* state, const char* key, size_t key_len) {
+    size_t prefix_len = 0;
+    state->valid = nfc_dump_key_split(key, key_len, &prefix_len, &state->number);
+    if(state->valid) {
+        furi_string_set_strn(state->prefix, key, prefix_len);
+    }
+}
+
+/******************************* Encoder *******************************/
+
+static void nfc_dump_writer_put(NfcDumpTextWriter* writer, const void* data, size_t size) {
+    if(size > NFC_DUMP_SECTION_SIZE_LIMIT - writer->section.size) {
+        writer->error = true;
+        return;
+    }
+
+    const size_t required = writer->section.size + size;
+    if(required > writer->payload_capacity) {
+        writer->payload_capacity = MIN(
+            MAX(required, writer->payload_capacity * 2), (size_t)NFC_DUMP_SECTION_SIZE_LIMIT);
+        writer->payload = realloc(writer->payload, writer->payload_capacity);
+    }
+
+    memcpy(&writer->payload[writer->section.size], data, size);
+    writer->section.size += size;
+}
+
+static void nfc_dump_writer_put_leb128(NfcDumpTextWriter* writer, uint32_t value) {
+    do {
+        uint8_t byte = value & 0x7FU;
+        value >>= 7;
+        byte |= value ? 0x80U : 0x00U;
+        nfc_dump_writer_put(writer, &byte, sizeof(byte));
+    } while(value);
+}
+
+static void nfc_dump_writer_put_string(NfcDumpTextWriter* writer, const char* data, size_t size) {
+    nfc_dump_writer_put_leb128(writer, size);
+    nfc_dump_writer_put(writer, data, size);
+}
+
+static int8_t nfc_dump_hex_char_to_nibble(char c) {
+    if(c >= '0' && c <= '9') return c - '0';
+    if(c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+// Value is "XX XX ..", upper case, single spaces, "??" for unknown bytes
+static bool nfc_dump_value_is_hex(const char* value, size_t value_len, bool* has_unknown) {
+    if(value_len < 2 || (value_len + 1) % 3) return false;
+
+    *has_unknown = false;
+    for(size_t i = 0; i < value_len; i += 3) {
+        if(i + 2 < value_len && value[i + 2] != ' ') return false;
+        if(value[i] == '?' && value[i + 1] == '?') {
+            *has_unknown = true;
+        } else if(
+            nfc_dump_hex_char_to_nibble(value[i]) < 0 ||
+            nfc_dump_hex_char_to_nibble(value[i + 1]) < 0) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// Value is a decimal number without leading zeros that fits uint32_t
+static bool nfc_dump_value_is_uint(const char* value, size_t value_len, uint32_t* number) {
+    if(value_len == 0 || value_len > NFC_DUMP_UINT_DIGITS_MAX) return false;
+    if(value_len > 1 && value[0] == '0') return false;
+
+    uint64_t result = 0;
+    for(size_t i = 0; i < value_len; i++) {
+        if(!isdigit((unsigned char)value[i])) return false;
+        result = result * 10 + (value[i] - '0');
+    }
+    if(result > UINT32_MAX) return false;
+
+    *number = result;
+    return true;
+}
+
+static void nfc_dump_writer_put_hex(
+    NfcDumpTextWriter* writer,
+    const char* value,
+    size_t value_len,
+    bool has_unknown) {
+    const size_t count = (value_len + 1) / 3;
+    nfc_dump_writer_put_leb128(writer, count);
+
+    for(size_t i = 0; i < count; i++) {
+        const char* hex = &value[i * 3];
+        uint8_t byte = 0;
+        if(hex[0] != '?') {
+            byte = (nfc_dump_hex_char_to_nibble(hex[0]) << 4) |
+                   nfc_dump_hex_char_to_nibble(hex[1]);
+        }
+        nfc_dump_writer_put(writer, &byte, sizeof(byte));
+    }
+
+    if(has_unknown) {
+        uint8_t mask = 0;
+        for(size_t i = 0; i < count; i++) {
+            if(value[i * 3] == '?') mask |= 1U << (i % 8);
+            if(i % 8 == 7 || i == count - 1) {
+                nfc_dump_writer_put(writer, &mask, sizeof(mask));
+                mask = 0;
+            }
+        }
+    }
+}
+
+static void
+    nfc_dump_writer_put_line(NfcDumpTextWriter* writer, const char* line, size_t line_len) {
+    const char* separator = strstr(line, NFC_DUMP_KEY_SEPARATOR);
+
+    if(!separator || separator == line) {
+        const uint8_t type = NFC_DUMP_LINE_RAW;
+        nfc_dump_writer_put(writer, &type, sizeof(type));
+        nfc_dump_writer_put_string(writer, line, line_len);
+
+    } else {
+        const char* key = line;
+        const size_t key_len = separator - line;
+        const char* value = separator + NFC_DUMP_KEY_SEPARATOR_LEN;
+        const size_t value_len = line_len - key_len - NFC_DUMP_KEY_SEPARATOR_LEN;
+
+        bool has_unknown = false;
+        uint32_t number = 0;
+        uint8_t type = NFC_DUMP_LINE_TEXT;
+        if(nfc_dump_value_is_hex(value, value_len, &has_unknown)) {
+            type = has_unknown ? NFC_DUMP_LINE_HEX_MASKED : NFC_DUMP_LINE_HEX;
+        } else if(nfc_dump_value_is_uint(value, value_len, &number)) {
+            type = NFC_DUMP_LINE_UINT;
+        }
+
+        const bool is_next = nfc_dump_key_state_is_next(&writer->key_state, key, key_len);
+        if(is_next) type |= NFC_DUMP_LINE_FLAG_KEY_NEXT;
+        nfc_dump_writer_put(writer, &type, sizeof(type));
+
+        if(!is_next) nfc_dump_writer_put_string(writer, key, key_len);
+        nfc_dump_key_state_update(&writer->key_state, key, key_len);
+
+        type &= NFC_DUMP_LINE_TYPE_MASK;
+        if(type == NFC_DUMP_LINE_TEXT) {
+            nfc_dump_writer_put_string(writer, value, value_len);
+        } else if(type == NFC_DUMP_LINE_UINT) {
+            nfc_dump_writer_put_leb128(writer, number);
+        } else {
+            nfc_dump_writer_put_hex(writer, value, value_len, has_unknown);
+        }
+    }
+
+    writer->section.text_size += line_len + 1;
+    writer->line_count++;
+}
+
+static bool nfc_dump_line_starts_section(const char* line) {
+    const char* separator = strstr(line, NFC_DUMP_KEY_SEPARATOR);
+    size_t prefix_len = 0;
+    uint32_t number = 0;
+
+    return separator && nfc_dump_key_split(line, separator - line, &prefix_len, &number) &&
+           (number % NFC_DUMP_SECTION_KEYS == 0);
+}
+
+static void nfc_dump_writer_flush_section(NfcDumpTextWriter* writer) {
+    if(writer->line_count == 0) return;
+
+    NfcDumpSection* section = &writer->section;
+    section->offset = stream_tell(writer->dump);
+    section->crc = crc32_calc_buffer(0, writer->payload, section->size);
+    if(stream_write(writer->dump, writer->payload, section->size) != section->size) {
+        writer->error = true;
+    }
+    NfcDumpSectionArray_push_back(writer->sections, *section);
+
+    section->size = 0;
+    section->text_size = 0;
+    writer->line_count = 0;
+    writer->key_state.valid = false;
+}
+
+static void nfc_dump_writer_add_line(NfcDumpTextWriter* writer, bool has_newline) {
+    const char* line = furi_string_get_cstr(writer->line);
+    const size_t line_len = furi_string_size(writer->line);
+
+    if(writer->line_count && (nfc_dump_line_starts_section(line) ||
+                              writer->section.size >= NFC_DUMP_SECTION_SIZE_MAX)) {
+        nfc_dump_writer_flush_section(writer);
+    }
+
+    const size_t text_size = line_len + (has_newline ? 1 : 0);
+    if(text_size > NFC_DUMP_SECTION_TEXT_SIZE_LIMIT - writer->section.text_size ||
+       text_size > NFC_DUMP_TEXT_SIZE_LIMIT - writer->header.text_size) {
+        writer->error = true;
+        return;
+    }
+
+    nfc_dump_writer_put_line(writer, line, line_len);
+    if(!has_newline) {
+        writer->section.text_size--;
+        writer->header.flags |= NFC_DUMP_FLAG_NO_TRAILING_NEWLINE;
+    }
+    writer->header.text_size += text_size;
+    furi_string_reset(writer->line);
+}
+
+static void nfc_dump_text_writer_free(NfcDumpTextWriter* stream);
+static bool nfc_dump_text_writer_eof(NfcDumpTextWriter* stream);
+static void nfc_dump_text_writer_clean(NfcDumpTextWriter* stream);
+static bool
+    nfc_dump_text_writer_seek(NfcDumpTextWriter* stream, int32_t offset, StreamOffset offset_type);
+static size_t nfc_dump_text_writer_tell(NfcDumpTextWriter* stream);
+static size_t nfc_dump_text_writer_size(NfcDumpTextWriter* stream);
+static size_t nfc_dump_text_writer_write(NfcDumpTextWriter* stream, const char* data, size_t size);
+static size_t nfc_dump_text_writer_read(NfcDumpTextWriter* stream, char* data, size_t size);
+static bool nfc_dump_text_writer_delete_and_insert(
+    NfcDumpTextWriter* stream,
+    size_t delete_size,
+    StreamWriteCB write_callback,
+    const void* ctx);
+
+static const StreamVTable nfc_dump_text_writer_vtable = {
+    .free = (StreamFreeFn)nfc_dump_text_writer_free,
+    .eof = (StreamEOFFn)nfc_dump_text_writer_eof,
+    .clean = (StreamCleanFn)nfc_dump_text_writer_clean,
+    .seek = (StreamSeekFn)nfc_dump_text_writer_seek,
+    .tell = (StreamTellFn)nfc_dump_text_writer_tell,
+    .size = (StreamSizeFn)nfc_dump_text_writer_size,
+    .write = (StreamWriteFn)nfc_dump_text_writer_write,
+    .read = (StreamReadFn)nfc_dump_text_writer_read,
+    .delete_and_insert = (StreamDeleteAndInsertFn)nfc_dump_text_writer_delete_and_insert,
+};
+
+Stream* nfc_dump_text_writer_alloc(Stream* dump) {
+    furi_check(dump);
+
+    NfcDumpTextWriter* writer = malloc(sizeof(NfcDumpTextWriter));
+    writer->stream_base.vtable = &nfc_dump_text_writer_vtable;
+    writer->dump = dump;
+    writer->key_state.prefix = furi_string_alloc();
+    writer->line = furi_string_alloc();
+    NfcDumpSectionArray_init(writer->sections);
+
+    // Header is written by nfc_dump_text_writer_finish(), unfinished container is not valid
+    stream_clean(dump);
+    const NfcDumpHeader header = {};
+    if(stream_write(dump, (const uint8_t*)&header, sizeof(header)) != sizeof(header)) {
+        writer->error = true;
+    }
+
+    return (Stream*)writer;
+}
+
+bool nfc_dump_text_writer_finish(Stream* stream) {
+    furi_check(stream);
+    furi_check(stream->vtable == &nfc_dump_text_writer_vtable);
+
+    NfcDumpTextWriter* writer = (NfcDumpTextWriter*)stream;
+    NfcDumpHeader* header = &writer->header;
+
+    if(!writer->error && furi_string_size(writer->line)) {
+        nfc_dump_writer_add_line(writer, false);
+    }
+    if(!writer->error) nfc_dump_writer_flush_section(writer);
+    if(writer->error) return false;
+
+    header->magic = NFC_DUMP_MAGIC;
+    header->version = NFC_DUMP_VERSION;
+    header->section_count = NfcDumpSectionArray_size(writer->sections);
+    const size_t table_size = header->section_count * sizeof(NfcDumpSection);
+    const uint8_t* table = header->section_count ?
+                               (const uint8_t*)NfcDumpSectionArray_cget(writer->sections, 0) :
+                               NULL;
+    header->table_offset = stream_tell(writer->dump);
+    header->table_crc = crc32_calc_buffer(0, table, table_size);
+
+    bool success = false;
+    do {
+        if(table_size && stream_write(writer->dump, table, table_size) != table_size) break;
+        if(!stream_rewind(writer->dump)) break;
+        if(stream_write(writer->dump, (const uint8_t*)header, sizeof(NfcDumpHeader)) !=
+           sizeof(NfcDumpHeader))
+            break;
+
+        success = true;
+    } while(false);
+
+    return success;
+}
+
+static void nfc_dump_text_writer_free(NfcDumpTextWriter* stream) {
+    NfcDumpSectionArray_clear(stream->sections);
+    furi_string_free(stream->line);
+    furi_string_free(stream->key_state.prefix);
+    free(stream->payload);
+    free(stream);
+}
+
+static bool nfc_dump_text_writer_eof(NfcDumpTextWriter* stream) {
+    UNUSED(stream);
+    return true;
+}
+
+static void nfc_dump_text_writer_clean(NfcDumpTextWriter* stream) {
+    // Write only, lines already encoded cannot be taken back
+    UNUSED(stream);
+}
+
+static bool nfc_dump_text_writer_seek(
+    NfcDumpTextWriter* stream,
+    int32_t offset,
+    StreamOffset offset_type) {
+    // Only seeks that stay at the end are possible
+    return (offset == 0) ||
+           (offset_type == StreamOffsetFromStart && (size_t)offset == stream->position);
+}
+
+static size_t nfc_dump_text_writer_tell(NfcDumpTextWriter* stream) {
+    return stream->position;
+}
+
+static size_t nfc_dump_text_writer_size(NfcDumpTextWriter* stream) {
+    return stream->position;
+}
+
+static size_t
+    nfc_dump_text_writer_write(NfcDumpTextWriter* stream, const char* data, size_t size) {
+    size_t position = 0;
+
+    while(!stream->error && position < size) {
+        const char* chunk = &data[position];
+        const char* newline = memchr(chunk, '\n', size - position);
+        const size_t chunk_size = newline ? (size_t)(newline - chunk) : size - position;
+
+        // Zero bytes would cut the stored strings short
+        if(memchr(chunk, '\0', chunk_size) ||
+           chunk_size > NFC_DUMP_SECTION_TEXT_SIZE_LIMIT - furi_string_size(stream->line)) {
+            stream->error = true;
+            break;
+        }
+        furi_string_cat_printf(stream->line, "%.*s", (int)chunk_size, chunk);
+        position += chunk_size;
+
+        if(newline) {
+            nfc_dump_writer_add_line(stream, true);
+            position++;
+        }
+    }
+
+    if(stream->error) return 0;
+    stream->position += size;
+    return size;
+}
+
+static size_t nfc_dump_text_writer_read(NfcDumpTextWriter* stream, char* data, size_t size) {
+    UNUSED(stream);
+    UNUSED(data);
+    UNUSED(size);
+    return 0;
+}
+
+static bool nfc_dump_text_writer_delete_and_insert(
+    NfcDumpTextWriter* stream,
+    size_t delete_size,
+    StreamWriteCB write_callback,
+    const void* ctx) {
+    UNUSED(stream);
+    UNUSED(delete_size);
+    UNUSED(write_callback);
+    UNUSED(ctx);
+    return false;
+}
+
+bool nfc_dump_from_text(Stream* text, Stream* dump) {
+    furi_check(text);
+    furi_check(dump);
+
+    Stream* writer = nfc_dump_text_writer_alloc(dump);
+    uint8_t buffer[NFC_DUMP_READ_CHUNK_SIZE];
+
+    bool success = stream_rewind(text);
+    while(success) {
+        const size_t was_read = stream_read(text, buffer, sizeof(buffer));
+        if(was_read == 0) break;
+        success = (stream_write(writer, buffer, was_read) == was_read);
+    }
+    success = success && nfc_dump_text_writer_finish(writer);
+
+    stream_free(writer);
+
+    return success;
+}
+
+/******************************* Decoder *******************************/
+
+NfcDump* nfc_dump_alloc(void) {
+    NfcDump* instance = malloc(sizeof(NfcDump));
+    return instance;
+}
+
+void nfc_dump_free(NfcDump* instance) {
+    furi_check(instance);
+
+    free(instance->sections);
+    free(instance->payload);
+    free(instance);
+}
+
+static bool nfc_dump_read_header(Stream* stream, NfcDumpHeader* header) {
+    return stream_rewind(stream) &&
+           (stream_read(stream, (uint8_t*)header, sizeof(NfcDumpHeader)) ==
+            sizeof(NfcDumpHeader)) &&
+           (header->magic == NFC_DUMP_MAGIC);
+}
+
+bool nfc_dump_check(Stream* stream) {
+    furi_check(stream);
+
+    const size_t position = stream_tell(stream);
+    NfcDumpHeader header = {};
+    const bool is_dump = nfc_dump_read_header(stream, &header);
+    stream_seek(stream, position, StreamOffsetFromStart);
+
+    return is_dump;
+}
+
+// Sections must lie between the header and the table and add up to the header text size
+static bool nfc_dump_sections_valid(const NfcDumpHeader* header, const NfcDumpSection* sections) {
+    size_t text_size = 0;
+
+    for(size_t i = 0; i < header->section_count; i++) {
+        const NfcDumpSection* section = &sections[i];
+        if(section->size == 0 || section->offset < sizeof(NfcDumpHeader)) return false;
+        if(section->offset > header->table_offset) return false;
+        if(section->size > header->table_offset - section->offset) return false;
+        if(section->size > NFC_DUMP_SECTION_SIZE_LIMIT) return false;
+        if(section->text_size > NFC_DUMP_SECTION_TEXT_SIZE_LIMIT) return false;
+        if(section->text_size > header->text_size - text_size) return false;
+        text_size += section->text_size;
+    }
+
+    return text_size == header->text_size;
+}
+
+bool nfc_dump_open(NfcDump* instance, Stream* stream) {
+    furi_check(instance);
+    furi_check(stream);
+
+    free(instance->sections);
+    instance->sections = NULL;
+    instance->stream = stream;
+
+    bool success = false;
+    do {
+        NfcDumpHeader* header = &instance->header;
+        if(!nfc_dump_read_header(stream, header)) break;
+        if(header->version != NFC_DUMP_VERSION) break;
+        if(header->text_size > NFC_DUMP_TEXT_SIZE_LIMIT) break;
+
+        // Count is capped by the file size first, so the table size cannot overflow
+        const size_t size = stream_size(stream);
+        if(header->section_count > (size - sizeof(NfcDumpHeader)) / sizeof(NfcDumpSection))
+            break;
+        const size_t table_size = header->section_count * sizeof(NfcDumpSection);
+        if(header->table_offset != size - table_size) break;
+        if(!stream_seek(stream, header->table_offset, StreamOffsetFromStart)) break;
+
+        instance->sections = malloc(MAX(table_size, 1U));
+        if(stream_read(stream, (uint8_t*)instance->sections, table_size) != table_size) break;
+        if(crc32_calc_buffer(0, instance->sections, table_size) != header->table_crc) break;
+        if(!nfc_dump_sections_valid(header, instance->sections)) break;
+
+        success = true;
+    } while(false);
+
+    if(!success) {
+        memset(&instance->header, 0, sizeof(NfcDumpHeader));
+    }
+
+    return success;
+}
+
+size_t nfc_dump_get_section_count(const NfcDump* instance) {
+    furi_check(instance);
+    return instance->header.section_count;
+}
+
+size_t nfc_dump_get_text_size(const NfcDump* instance) {
+    furi_check(instance);
+    return instance->header.text_size;
+}
+
+static bool nfc_dump_reader_get_leb128(NfcDumpReader* reader, uint32_t* value) {
+    *value = 0;
+
+    for(size_t shift = 0; shift < 32; shift += 7) {
+        if(reader->position >= reader->size) break;
+        const uint8_t byte = reader->data[reader->position++];
+        // Fifth byte holds the top 4 bits only
+        if(shift == 28 && (byte & 0xF0U)) break;
+        *value |= (uint32_t)(byte & 0x7FU) << shift;
+        if(!(byte & 0x80U)) return true;
+    }
+
+    return false;
+}
+
+static const uint8_t* nfc_dump_reader_get_data(NfcDumpReader* reader, size_t size) {
+    if(size > reader->size - reader->position) return NULL;
+
+    const uint8_t* data = &reader->data[reader->position];
+    reader->position += size;
+
+    return data;
+}
+
+static bool nfc_dump_reader_cat_string(NfcDumpReader* reader, FuriString* text) {
+    uint32_t size = 0;
+    if(!nfc_dump_reader_get_leb128(reader, &size)) return false;
+
+    const char* data = (const char*)nfc_dump_reader_get_data(reader, size);
+    // Size fits int as it is within the section, zero bytes are never written
+    if(!data || memchr(data, '\0', size)) return false;
+    furi_string_cat_printf(text, "%.*s", (int)size, data);
+
+    return true;
+}
+
+static bool nfc_dump_reader_cat_uint(NfcDumpReader* reader, FuriString* text) {
+    uint32_t number = 0;
+    if(!nfc_dump_reader_get_leb128(reader, &number)) return false;
+
+    furi_string_cat_printf(text, "%" PRIu32, number);
+
+    return true;
+}
+
+static bool nfc_dump_reader_cat_hex(NfcDumpReader* reader, FuriString* text, bool has_unknown) {
+    uint32_t count = 0;
+    if(!nfc_dump_reader_get_leb128(reader, &count) || count == 0) return false;
+
+    const uint8_t* bytes = nfc_dump_reader_get_data(reader, count);
+    const uint8_t* mask = has_unknown ? nfc_dump_reader_get_data(reader, (count + 7) / 8) : NULL;
+    if(!bytes || (has_unknown && !mask)) return false;
+
+    for(size_t i = 0; i < count; i++) {
+        if(i) furi_string_push_back(text, ' ');
+        if(mask && (mask[i / 8] & (1U << (i % 8)))) {
+            furi_string_cat_str(text, "??");
+        } else {
+            furi_string_push_back(text, nfc_dump_hex_chars[bytes[i] >> 4]);
+            furi_string_push_back(text, nfc_dump_hex_chars[bytes[i] & 0x0F]);
+        }
+    }
+
+    return true;
+}
+
+static bool nfc_dump_reader_cat_line(
+    NfcDumpReader* reader,
+    FuriString* text,
+    NfcDumpKeyState* key_state) {
+    const uint8_t* type_byte = nfc_dump_reader_get_data(reader, 1);
+    if(!type_byte) return false;
+    if(*type_byte & ~(NFC_DUMP_LINE_TYPE_MASK | NFC_DUMP_LINE_FLAG_KEY_NEXT)) return false;
+    const uint8_t type = *type_byte & NFC_DUMP_LINE_TYPE_MASK;
+    if(type > NFC_DUMP_LINE_UINT) return false;
+
+    if(type == NFC_DUMP_LINE_RAW) {
+        return !(*type_byte & NFC_DUMP_LINE_FLAG_KEY_NEXT) &&
+               nfc_dump_reader_cat_string(reader, text);
+    }
+
+    const size_t key_start = furi_string_size(text);
+    if(*type_byte & NFC_DUMP_LINE_FLAG_KEY_NEXT) {
+        if(!key_state->valid) return false;
+        furi_string_cat_printf(
+            text, "%s%" PRIu32, furi_string_get_cstr(key_state->prefix), key_state->number + 1);
+    } else if(!nfc_dump_reader_cat_string(reader, text)) {
+        return false;
+    }
+    nfc_dump_key_state_update(
+        key_state,
+        &furi_string_get_cstr(text)[key_start],
+        furi_string_size(text) - key_start);
+    furi_string_cat_str(text, NFC_DUMP_KEY_SEPARATOR);
+
+    if(type == NFC_DUMP_LINE_TEXT) {
+        return nfc_dump_reader_cat_string(reader, text);
+    } else if(type == NFC_DUMP_LINE_UINT) {
+        return nfc_dump_reader_cat_uint(reader, text);
+    } else {
+        return nfc_dump_reader_cat_hex(reader, text, type == NFC_DUMP_LINE_HEX_MASKED);
+    }
+}
+
+bool nfc_dump_read_section(NfcDump* instance, size_t index, FuriString* text) {
+    furi_check(instance);
+    furi_check(instance->stream);
+    furi_check(index < instance->header.section_count);
+    furi_check(text);
+
+    const NfcDumpSection* section = &instance->sections[index];
+    furi_string_reset(text);
+
+    // Size is bounded by nfc_dump_open()
+    if(section->size > instance->payload_capacity) {
+        free(instance->payload);
+        instance->payload = malloc(section->size);
+        instance->payload_capacity = section->size;
+    }
+
+    NfcDumpKeyState key_state = {
+        .prefix = furi_string_alloc(),
+    };
+
+    bool success = false;
+    do {
+        if(!stream_seek(instance->stream, section->offset, StreamOffsetFromStart)) break;
+        if(stream_read(instance->stream, instance->payload, section->size) != section->size)
+            break;
+        if(crc32_calc_buffer(0, instance->payload, section->size) != section->crc) break;
+
+        NfcDumpReader reader = {
+            .data = instance->payload,
+            .size = section->size,
+        };
+
+        // Keys repeated by the next key flag may expand a small payload a lot, stop early
+        bool line_valid = true;
+        while(line_valid && reader.position < reader.size) {
+            line_valid = nfc_dump_reader_cat_line(&reader, text, &key_state) &&
+                         (furi_string_size(text) <= section->text_size);
+            furi_string_push_back(text, '\n');
+        }
+        if(!line_valid) break;
+
+        const bool is_last = (index == instance->header.section_count - 1);
+        if(is_last && (instance->header.flags & NFC_DUMP_FLAG_NO_TRAILING_NEWLINE)) {
+            furi_string_left(text, furi_string_size(text) - 1);
+        }
+        if(furi_string_size(text) != section->text_size) break;
+
+        success = true;
+    } while(false);
+
+    furi_string_free(key_state.prefix);
+
+    return success;
+}
+
+bool nfc_dump_to_text(Stream* dump, Stream* text) {
+    furi_check(dump);
+    furi_check(text);
+
+    NfcDump* instance = nfc_dump_alloc();
+    FuriString* section_text = furi_string_alloc();
+
+    bool success = false;
+    do {
+        if(!nfc_dump_open(instance, dump)) break;
+        stream_clean(text);
+
+        const size_t section_count = nfc_dump_get_section_count(instance);
+        size_t i = 0;
+        for(; i < section_count; i++) {
+            if(!nfc_dump_read_section(instance, i, section_text)) break;
+            if(stream_write_string(text, section_text) != furi_string_size(section_text)) break;
+        }
+
+        success = (i == section_count);
+    } while(false);
+
+    furi_string_free(section_text);
+    nfc_dump_free(instance);
+
+    return success;
+}
+
+/******************************* Text stream *******************************/
+
+static void nfc_dump_text_stream_free(NfcDumpTextStream* stream);
+static bool nfc_dump_text_stream_eof(NfcDumpTextStream* stream);
+static void nfc_dump_text_stream_clean(NfcDumpTextStream* stream);
+static bool
+    nfc_dump_text_stream_seek(NfcDumpTextStream* stream, int32_t offset, StreamOffset offset_type);
+static size_t nfc_dump_text_stream_tell(NfcDumpTextStream* stream);
+static size_t nfc_dump_text_stream_size(NfcDumpTextStream* stream);
+static size_t nfc_dump_text_stream_write(NfcDumpTextStream* stream, const char* data, size_t size);
+static size_t nfc_dump_text_stream_read(NfcDumpTextStream* stream, char* data, size_t size);
+static bool nfc_dump_text_stream_delete_and_insert(
+    NfcDumpTextStream* stream,
+    size_t delete_size,
+    StreamWriteCB write_callback,
+    const void* ctx);
+
+static const StreamVTable nfc_dump_text_stream_vtable = {
+    .free = (StreamFreeFn)nfc_dump_text_stream_free,
+    .eof = (StreamEOFFn)nfc_dump_text_stream_eof,
+    .clean = (StreamCleanFn)nfc_dump_text_stream_clean,
+    .seek = (StreamSeekFn)nfc_dump_text_stream_seek,
+    .tell = (StreamTellFn)nfc_dump_text_stream_tell,
+    .size = (StreamSizeFn)nfc_dump_text_stream_size,
+    .write = (StreamWriteFn)nfc_dump_text_stream_write,
+    .read = (StreamReadFn)nfc_dump_text_stream_read,
+    .delete_and_insert = (StreamDeleteAndInsertFn)nfc_dump_text_stream_delete_and_insert,
+};
+
+Stream* nfc_dump_text_stream_alloc(NfcDump* instance) {
+    furi_check(instance);
+
+    NfcDumpTextStream* stream = malloc(sizeof(NfcDumpTextStream));
+    stream->stream_base.vtable = &nfc_dump_text_stream_vtable;
+    stream->dump = instance;
+    stream->section = SIZE_MAX;
+    stream->text = furi_string_alloc();
+
+    // Section count and text sizes are bounded by nfc_dump_open(), nothing here overflows
+    const size_t section_count = instance->header.section_count;
+    stream->section_start = malloc((section_count + 1) * sizeof(size_t));
+    stream->section_start[0] = 0;
+    for(size_t i = 0; i < section_count; i++) {
+        stream->section_start[i + 1] = stream->section_start[i] + instance->sections[i].text_size;
+    }
+
+    return (Stream*)stream;
+}
+
+static void nfc_dump_text_stream_free(NfcDumpTextStream* stream) {
+    furi_string_free(stream->text);
+    free(stream->section_start);
+    free(stream);
+}
+
+static bool nfc_dump_text_stream_eof(NfcDumpTextStream* stream) {
+    return stream->position >= nfc_dump_text_stream_size(stream);
+}
+
+static void nfc_dump_text_stream_clean(NfcDumpTextStream* stream) {
+    // Read only
+    UNUSED(stream);
+}
+
+static bool nfc_dump_text_stream_seek(
+    NfcDumpTextStream* stream,
+    int32_t offset,
+    StreamOffset offset_type) {
+    const int32_t size = nfc_dump_text_stream_size(stream);
+    int32_t position = offset;
+    if(offset_type == StreamOffsetFromCurrent) {
+        position += stream->position;
+    } else if(offset_type == StreamOffsetFromEnd) {
+        position += size;
+    }
+
+    stream->position = CLAMP(position, size, 0);
+    return position == (int32_t)stream->position;
+}
+
+static size_t nfc_dump_text_stream_tell(NfcDumpTextStream* stream) {
+    return stream->position;
+}
+
+static size_t nfc_dump_text_stream_size(NfcDumpTextStream* stream) {
+    return stream->section_start[stream->dump->header.section_count];
+}
+
+static size_t
+    nfc_dump_text_stream_write(NfcDumpTextStream* stream, const char* data, size_t size) {
+    UNUSED(stream);
+    UNUSED(data);
+    UNUSED(size);
+    return 0;
+}
+
+static bool nfc_dump_text_stream_load(NfcDumpTextStream* stream) {
+    const size_t section_count = stream->dump->header.section_count;
+
+    // Sequential reads stay in the same or the next section
+    if(stream->section < section_count &&
+       stream->position >= stream->section_start[stream->section] &&
+       stream->position < stream->section_start[stream->section + 1]) {
+        return true;
+    }
+
+    size_t low = 0;
+    size_t high = section_count;
+    while(high - low > 1) {
+        const size_t mid = low + (high - low) / 2;
+        if(stream->section_start[mid] <= stream->position) {
+            low = mid;
+        } else {
+            high = mid;
+        }
+    }
+
+    stream->section = SIZE_MAX;
+    if(!nfc_dump_read_section(stream->dump, low, stream->text)) return false;
+    stream->section = low;
+
+    return true;
+}
+
+static size_t nfc_dump_text_stream_read(NfcDumpTextStream* stream, char* data, size_t size) {
+    size_t was_read = 0;
+
+    while(was_read < size && !nfc_dump_text_stream_eof(stream)) {
+        if(!nfc_dump_text_stream_load(stream)) break;
+
+        const size_t section_position = stream->position - stream->section_start[stream->section];
+        const size_t chunk =
+            MIN(size - was_read, furi_string_size(stream->text) - section_position);
+        memcpy(&data[was_read], &furi_string_get_cstr(stream->text)[section_position], chunk);
+
+        was_read += chunk;
+        stream->position += chunk;
+    }
+
+    return was_read;
+}
+
+static bool nfc_dump_text_stream_delete_and_insert(
+    NfcDumpTextStream* stream,
+    size_t delete_size,
+    StreamWriteCB write_callback,
+    const void* ctx) {
+    UNUSED(stream);
+    UNUSED(delete_size);
+    UNUSED(write_callback);
+    UNUSED(ctx);
+    return false;
+}
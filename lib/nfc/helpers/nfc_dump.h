@@ -0,0 +1,149 @@
+/**
+ * @file nfc_dump.h
+ * @brief Compact binary container for NFC device files.
+ *
+ * The container holds the lines of a text NFC device file in a compact form,
+ * so any protocol that can be saved as text can be saved in it too, and the
+ * text is restored byte for byte:
+ * - "Key: AA BB ??" lines store the key and the bytes, unknown bytes as a bit mask;
+ * - "Key: 123" lines store the key and the number;
+ * - numbered keys that follow each other ("Block 4", "Block 5") store no key at all;
+ * - other lines are stored as is.
+ *
+ * Lines are grouped into sections which can be read independently, each one
+ * protected by its own CRC. A new section starts every 16 numbered keys, which
+ * puts every Mifare Classic sector into one section, or when a section grows
+ * too big. Section table is at the end of the file and is read on open,
+ * sections are read only when needed.
+ *
+ * Files are written through a stream that encodes the text line by line, so
+ * the whole text is never held in memory on save either.
+ */
+#pragma once
+
+#include <toolbox/stream/stream.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief NfcDump opaque type definition.
+ */
+typedef struct NfcDump NfcDump;
+
+/**
+ * @brief Allocate an NfcDump instance.
+ *
+ * @returns pointer to the allocated instance.
+ */
+NfcDump* nfc_dump_alloc(void);
+
+/**
+ * @brief Delete an NfcDump instance.
+ *
+ * @param[in,out] instance pointer to the instance to be deleted.
+ */
+void nfc_dump_free(NfcDump* instance);
+
+/**
+ * @brief Open a container by reading its header and section table.
+ *
+ * The stream must stay valid while the instance is used.
+ *
+ * @param[in,out] instance pointer to the instance.
+ * @param[in] stream pointer to the stream holding the container.
+ * @returns true if the stream holds a valid container, false otherwise.
+ */
+bool nfc_dump_open(NfcDump* instance, Stream* stream);
+
+/**
+ * @brief Get the number of sections in the open container.
+ *
+ * @param[in] instance pointer to the instance.
+ * @returns number of sections.
+ */
+size_t nfc_dump_get_section_count(const NfcDump* instance);
+
+/**
+ * @brief Get the size of the text stored in the open container.
+ *
+ * @param[in] instance pointer to the instance.
+ * @returns text size in bytes.
+ */
+size_t nfc_dump_get_text_size(const NfcDump* instance);
+
+/**
+ * @brief Read one section and restore its text.
+ *
+ * @param[in,out] instance pointer to the instance.
+ * @param[in] index section index.
+ * @param[out] text pointer to the string to hold the section text.
+ * @returns true on success, false if the section is damaged.
+ */
+bool nfc_dump_read_section(NfcDump* instance, size_t index, FuriString* text);
+
+/**
+ * @brief Allocate a read only stream with the text of the open container.
+ *
+ * Sections are read as the stream position reaches them, only one section
+ * is kept in memory. The stream must be freed before the instance.
+ *
+ * @param[in] instance pointer to the instance.
+ * @returns pointer to the allocated stream.
+ */
+Stream* nfc_dump_text_stream_alloc(NfcDump* instance);
+
+/**
+ * @brief Check if a stream starts with a container header.
+ *
+ * Stream position is restored.
+ *
+ * @param[in] stream pointer to the stream to be checked.
+ * @returns true if the stream starts with a container header.
+ */
+bool nfc_dump_check(Stream* stream);
+
+/**
+ * @brief Allocate a write only stream that encodes the text written to it into a container.
+ *
+ * Contents of the dump stream are replaced. Only the current line and section
+ * are kept in memory, finished sections go to the dump stream as they fill up.
+ * The dump stream must stay valid while the stream is used.
+ *
+ * @param[in,out] dump pointer to the stream for the container.
+ * @returns pointer to the allocated stream.
+ */
+Stream* nfc_dump_text_writer_alloc(Stream* dump);
+
+/**
+ * @brief Write the last section, the section table and the header.
+ *
+ * Must be called once, after all the text is written and before the stream is freed.
+ *
+ * @param[in,out] stream pointer to the stream allocated by nfc_dump_text_writer_alloc().
+ * @returns true on success, false if the text could not be encoded or written.
+ */
+bool nfc_dump_text_writer_finish(Stream* stream);
+
+/**
+ * @brief Convert text NFC device file to a container.
+ *
+ * @param[in,out] text pointer to the stream with the text, read from the start.
+ * @param[in,out] dump pointer to the stream for the container, its contents are replaced.
+ * @returns true on success, false otherwise.
+ */
+bool nfc_dump_from_text(Stream* text, Stream* dump);
+
+/**
+ * @brief Convert a container to text NFC device file.
+ *
+ * @param[in,out] dump pointer to the stream with the container.
+ * @param[in,out] text pointer to the stream for the text, its contents are replaced.
+ * @returns true on success, false if the container is damaged.
+ */
+bool nfc_dump_to_text(Stream* dump, Stream* text);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,339 @@
+#include "nfc_trace.h"
+
+#include <furi.h>
+#include <furi_hal.h>
+
+#define NFC_TRACE_MAGIC (0x5443464EUL) // "NFCT"
+#define NFC_TRACE_VERSION (1U)
+
+// Type, time delta and frame size, LEB128 of uint32_t takes up to 5 bytes
+#define NFC_TRACE_RECORD_HEADER_SIZE_MAX (1U + 5U + 5U)
+
+#define NFC_TRACE_TYPE_MASK (0x0FU)
+#define NFC_TRACE_FLAG_PARITY (0x10U)
+
+typedef struct FURI_PACKED {
+    uint32_t magic;
+    uint8_t version;
+    uint8_t reserved[3];
+    uint32_t record_count;
+    uint32_t dropped_count;
+    uint32_t size;
+} NfcTraceFileHeader;
+
+struct NfcTrace {
+    uint8_t* buffer;
+    size_t capacity;
+    size_t size;
+    size_t record_count;
+    size_t dropped_count;
+    BitBuffer* short_frame;
+
+    // Cycle counter wraps in a minute, so time is accumulated from deltas
+    bool clock_started;
+    uint32_t clock_cycles;
+    uint32_t clock_ticks;
+    uint32_t clock_us;
+    uint32_t last_record_us;
+};
+
+NfcTrace* nfc_trace_alloc(size_t capacity) {
+    furi_check(capacity);
+
+    NfcTrace* instance = malloc(sizeof(NfcTrace));
+    instance->buffer = malloc(capacity);
+    instance->capacity = capacity;
+    instance->short_frame = bit_buffer_alloc(1);
+
+    return instance;
+}
+
+void nfc_trace_free(NfcTrace* instance) {
+    furi_check(instance);
+
+    bit_buffer_free(instance->short_frame);
+    free(instance->buffer);
+    free(instance);
+}
+
+void nfc_trace_reset(NfcTrace* instance) {
+    furi_check(instance);
+
+    instance->size = 0;
+    instance->record_count = 0;
+    instance->dropped_count = 0;
+    instance->clock_started = false;
+    instance->clock_us = 0;
+    instance->last_record_us = 0;
+}
+
+static uint32_t nfc_trace_get_time_us(NfcTrace* instance) {
+    const uint32_t cycles_per_us = furi_hal_cortex_instructions_per_microsecond();
+    // Start of a zero timeout timer is the current cycle counter value
+    const uint32_t cycles = furi_hal_cortex_timer_get(0).start;
+
+    const uint32_t ticks = furi_get_tick();
+
+    if(!instance->clock_started) {
+        instance->clock_started = true;
+        instance->clock_cycles = cycles;
+        instance->clock_ticks = ticks;
+    }
+
+    // Counter may wrap more than once between records, ticks tell how many times
+    uint64_t elapsed_cycles = (uint32_t)(cycles - instance->clock_cycles);
+    const uint64_t wrap_us = (1ULL << 32) / cycles_per_us;
+    const uint64_t counted_us = elapsed_cycles / cycles_per_us;
+    const uint64_t ticks_us = (uint64_t)(ticks - instance->clock_ticks) * 1000000ULL /
+                              furi_kernel_get_tick_frequency();
+    if(ticks_us > counted_us + wrap_us / 2) {
+        elapsed_cycles += ((ticks_us - counted_us + wrap_us / 2) / wrap_us) << 32;
+    }
+
+    // Remainder stays in clock_cycles, so rounding does not accumulate
+    const uint32_t elapsed_us = elapsed_cycles / cycles_per_us;
+    instance->clock_cycles += elapsed_us * cycles_per_us;
+    instance->clock_ticks = ticks;
+    instance->clock_us += elapsed_us;
+
+    return instance->clock_us;
+}
+
+static size_t nfc_trace_put_leb128(uint8_t* dest, uint32_t value) {
+    size_t size = 0;
+
+    do {
+        uint8_t byte = value & 0x7FU;
+        value >>= 7;
+        dest[size++] = byte | (value ? 0x80U : 0x00U);
+    } while(value);
+
+    return size;
+}
+
+static bool nfc_trace_get_leb128(
+    const NfcTrace* instance,
+    size_t* position,
+    uint32_t* value) {
+    *value = 0;
+
+    for(size_t shift = 0; shift < 32; shift += 7) {
+        if(*position >= instance->size) break;
+        uint8_t byte = instance->buffer[(*position)++];
+        *value |= (uint32_t)(byte & 0x7FU) << shift;
+        if(!(byte & 0x80U)) return true;
+    }
+
+    return false;
+}
+
+static size_t nfc_trace_put_header(NfcTrace* instance, uint8_t type, uint8_t* dest) {
+    uint32_t timestamp_us = nfc_trace_get_time_us(instance);
+
+    dest[0] = type;
+    size_t size = 1;
+    size += nfc_trace_put_leb128(&dest[size], timestamp_us - instance->last_record_us);
+    instance->last_record_us = timestamp_us;
+
+    return size;
+}
+
+bool nfc_trace_add_frame(
+    NfcTrace* instance,
+    NfcTraceRecordType type,
+    const BitBuffer* frame,
+    bool with_parity) {
+    furi_check(instance);
+    furi_check(type < NfcTraceRecordTypeEvent);
+    furi_check(frame);
+
+    const size_t size_bits = bit_buffer_get_size(frame);
+    const size_t data_size = bit_buffer_get_size_bytes(frame);
+    const size_t parity_size = with_parity ? (data_size + 7) / 8 : 0;
+    const size_t record_size_max = NFC_TRACE_RECORD_HEADER_SIZE_MAX + data_size + parity_size;
+
+    if(instance->size + record_size_max > instance->capacity) {
+        instance->dropped_count++;
+        return false;
+    }
+
+    uint8_t* dest = &instance->buffer[instance->size];
+    uint8_t type_byte = type | (with_parity ? NFC_TRACE_FLAG_PARITY : 0);
+    size_t size = nfc_trace_put_header(instance, type_byte, dest);
+    size += nfc_trace_put_leb128(&dest[size], size_bits);
+    memcpy(&dest[size], bit_buffer_get_data(frame), data_size);
+    size += data_size;
+    if(with_parity) {
+        memcpy(&dest[size], bit_buffer_get_parity(frame), parity_size);
+        size += parity_size;
+    }
+
+    instance->size += size;
+    instance->record_count++;
+
+    return true;
+}
+
+bool nfc_trace_add_short_frame(
+    NfcTrace* instance,
+    NfcTraceRecordType type,
+    uint8_t data,
+    size_t size_bits) {
+    furi_check(instance);
+    furi_check(size_bits > 0 && size_bits < 8);
+
+    bit_buffer_set_size(instance->short_frame, size_bits);
+    bit_buffer_set_byte(instance->short_frame, 0, data);
+
+    return nfc_trace_add_frame(instance, type, instance->short_frame, false);
+}
+
+bool nfc_trace_add_event(NfcTrace* instance, NfcTraceEvent event) {
+    furi_check(instance);
+
+    if(instance->size + NFC_TRACE_RECORD_HEADER_SIZE_MAX + 1 > instance->capacity) {
+        instance->dropped_count++;
+        return false;
+    }
+
+    uint8_t* dest = &instance->buffer[instance->size];
+    size_t size = nfc_trace_put_header(instance, NfcTraceRecordTypeEvent, dest);
+    dest[size++] = event;
+
+    instance->size += size;
+    instance->record_count++;
+
+    return true;
+}
+
+size_t nfc_trace_get_record_count(const NfcTrace* instance) {
+    furi_check(instance);
+    return instance->record_count;
+}
+
+size_t nfc_trace_get_dropped_count(const NfcTrace* instance) {
+    furi_check(instance);
+    return instance->dropped_count;
+}
+
+bool nfc_trace_get_record(const NfcTrace* instance, size_t* position, NfcTraceRecord* record) {
+    furi_check(instance);
+    furi_check(position);
+    furi_check(record);
+
+    bool success = false;
+    size_t pos = *position;
+
+    do {
+        if(pos >= instance->size) break;
+
+        // Absolute time is sum of deltas, so it is carried over in the record
+        const uint32_t timestamp_us = (pos == 0) ? 0 : record->timestamp_us;
+        const uint8_t type_byte = instance->buffer[pos++];
+        const NfcTraceRecordType type = type_byte & NFC_TRACE_TYPE_MASK;
+        if(type >= NfcTraceRecordTypeNum) break;
+
+        uint32_t delta_us = 0;
+        if(!nfc_trace_get_leb128(instance, &pos, &delta_us)) break;
+
+        record->type = type;
+        record->timestamp_us = timestamp_us + delta_us;
+        record->size_bits = 0;
+        record->data = NULL;
+        record->parity = NULL;
+
+        if(type == NfcTraceRecordTypeEvent) {
+            if(pos + 1 > instance->size) break;
+            record->event = instance->buffer[pos++];
+        } else {
+            uint32_t size_bits = 0;
+            if(!nfc_trace_get_leb128(instance, &pos, &size_bits)) break;
+            const size_t data_size = (size_bits + 7) / 8;
+            const bool with_parity = type_byte & NFC_TRACE_FLAG_PARITY;
+            const size_t parity_size = with_parity ? (data_size + 7) / 8 : 0;
+            if(pos + data_size + parity_size > instance->size) break;
+
+            record->size_bits = size_bits;
+            record->data = &instance->buffer[pos];
+            pos += data_size;
+            if(with_parity) {
+                record->parity = &instance->buffer[pos];
+                pos += parity_size;
+            }
+        }
+
+        *position = pos;
+        success = true;
+    } while(false);
+
+    return success;
+}
+
+void nfc_trace_record_get_frame(const NfcTraceRecord* record, BitBuffer* frame) {
+    furi_check(record);
+    furi_check(record->type < NfcTraceRecordTypeEvent);
+    furi_check(frame);
+
+    bit_buffer_copy_bits(frame, record->data, record->size_bits);
+    if(record->parity) {
+        for(size_t i = 0; i < bit_buffer_get_size_bytes(frame); i++) {
+            bit_buffer_set_byte_with_parity(
+                frame, i, record->data[i], FURI_BIT(record->parity[i / 8], i % 8));
+        }
+    }
+}
+
+bool nfc_trace_save(const NfcTrace* instance, Stream* stream) {
+    furi_check(instance);
+    furi_check(stream);
+
+    NfcTraceFileHeader header = {
+        .magic = NFC_TRACE_MAGIC,
+        .version = NFC_TRACE_VERSION,
+        .record_count = instance->record_count,
+        .dropped_count = instance->dropped_count,
+        .size = instance->size,
+    };
+
+    bool success = false;
+    do {
+        if(stream_write(stream, (const uint8_t*)&header, sizeof(header)) != sizeof(header)) break;
+        if(stream_write(stream, instance->buffer, instance->size) != instance->size) break;
+        success = true;
+    } while(false);
+
+    return success;
+}
+
+bool nfc_trace_load(NfcTrace* instance, Stream* stream) {
+    furi_check(instance);
+    furi_check(stream);
+
+    NfcTraceFileHeader header = {};
+
+    bool success = false;
+    do {
+        if(stream_read(stream, (uint8_t*)&header, sizeof(header)) != sizeof(header)) break;
+        if(header.magic != NFC_TRACE_MAGIC) break;
+        if(header.version != NFC_TRACE_VERSION) break;
+
+        // Size comes from the file, it must not exceed what is left in the stream
+        const size_t stream_left = stream_size(stream) - stream_tell(stream);
+        if(header.size > stream_left) break;
+
+        nfc_trace_reset(instance);
+        if(header.size > instance->capacity) {
+            free(instance->buffer);
+            instance->buffer = malloc(header.size);
+            instance->capacity = header.size;
+        }
+        if(stream_read(stream, instance->buffer, header.size) != header.size) break;
+
+        instance->size = header.size;
+        instance->record_count = header.record_count;
+        instance->dropped_count = header.dropped_count;
+        success = true;
+    } while(false);
+
+    return success;
+}
@@ -0,0 +1,192 @@
+/**
+ * @file nfc_trace.h
+ * @brief Compact binary trace of frames and events exchanged by the Nfc layer.
+ *
+ * A trace is a preallocated buffer of variable length records. Every record
+ * starts with a type byte, record type in the low nibble and custom parity
+ * flag in bit 4, and the time elapsed since the previous record in
+ * microseconds, LEB128 encoded, followed by the record payload:
+ * - frames: frame size in bits (LEB128), data bytes and, for frames with
+ *   custom parity, one parity bit per data byte packed LSB first;
+ * - events: one byte with the event code.
+ *
+ * A saved trace is the file header (magic, version, record area size)
+ * followed by the record area as is, so it can be loaded without parsing.
+ */
+#pragma once
+
+#include <toolbox/bit_buffer.h>
+#include <toolbox/stream/stream.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief NfcTrace opaque type definition.
+ */
+typedef struct NfcTrace NfcTrace;
+
+/**
+ * @brief Enumeration of trace record types.
+ */
+typedef enum {
+    NfcTraceRecordTypePollerTx, /**< Frame sent by the poller. */
+    NfcTraceRecordTypePollerRx, /**< Frame received by the poller. */
+    NfcTraceRecordTypeListenerRx, /**< Frame received by the listener. */
+    NfcTraceRecordTypeListenerTx, /**< Frame sent by the listener. */
+    NfcTraceRecordTypeEvent, /**< Nfc layer event, see NfcTraceEvent. */
+
+    NfcTraceRecordTypeNum,
+} NfcTraceRecordType;
+
+/**
+ * @brief Enumeration of traced events.
+ */
+typedef enum {
+    NfcTraceEventFieldOn, /**< Reader's field was detected by the listener. */
+    NfcTraceEventFieldOff, /**< Reader's field was lost. */
+    NfcTraceEventListenerActivated, /**< The listener has been activated by the reader. */
+    NfcTraceEventPollerTimeout, /**< No response to the previous poller frame. */
+    NfcTraceEventPollerError, /**< Response to the previous poller frame was corrupted. */
+} NfcTraceEvent;
+
+/**
+ * @brief Decoded trace record, frame data points into the trace buffer.
+ */
+typedef struct {
+    NfcTraceRecordType type; /**< Record type. */
+    uint32_t timestamp_us; /**< Time since the first record, in microseconds, wraps in 71 minutes. */
+    NfcTraceEvent event; /**< Event code, valid for event records only. */
+    size_t size_bits; /**< Frame size in bits, 0 for event records. */
+    const uint8_t* data; /**< Frame data, NULL for event records. */
+    const uint8_t* parity; /**< Frame parity bits, NULL if the frame has no custom parity. */
+} NfcTraceRecord;
+
+/**
+ * @brief Allocate an NfcTrace instance.
+ *
+ * @param[in] capacity size of the record area, in bytes.
+ * @returns pointer to the allocated instance.
+ */
+NfcTrace* nfc_trace_alloc(size_t capacity);
+
+/**
+ * @brief Delete an NfcTrace instance.
+ *
+ * @param[in,out] instance pointer to the instance to be deleted.
+ */
+void nfc_trace_free(NfcTrace* instance);
+
+/**
+ * @brief Remove all records and restart the trace clock.
+ *
+ * @param[in,out] instance pointer to the instance to be reset.
+ */
+void nfc_trace_reset(NfcTrace* instance);
+
+/**
+ * @brief Append a frame record.
+ *
+ * Records that do not fit into the remaining space are dropped and counted.
+ *
+ * @param[in,out] instance pointer to the instance to be modified.
+ * @param[in] type frame record type, must not be NfcTraceRecordTypeEvent.
+ * @param[in] frame pointer to the frame to be recorded.
+ * @param[in] with_parity true to record parity bits of the frame.
+ * @returns true if the record was stored, false if it was dropped.
+ */
+bool nfc_trace_add_frame(
+    NfcTrace* instance,
+    NfcTraceRecordType type,
+    const BitBuffer* frame,
+    bool with_parity);
+
+/**
+ * @brief Append a record of a frame shorter than a byte.
+ *
+ * Uses a buffer preallocated in the instance, so it can be called per frame
+ * without allocations.
+ *
+ * @param[in,out] instance pointer to the instance to be modified.
+ * @param[in] type frame record type, must not be NfcTraceRecordTypeEvent.
+ * @param[in] data frame bits, least significant bit first.
+ * @param[in] size_bits frame size in bits, 1 to 7.
+ * @returns true if the record was stored, false if it was dropped.
+ */
+bool nfc_trace_add_short_frame(
+    NfcTrace* instance,
+    NfcTraceRecordType type,
+    uint8_t data,
+    size_t size_bits);
+
+/**
+ * @brief Append an event record.
+ *
+ * @param[in,out] instance pointer to the instance to be modified.
+ * @param[in] event event to be recorded.
+ * @returns true if the record was stored, false if it was dropped.
+ */
+bool nfc_trace_add_event(NfcTrace* instance, NfcTraceEvent event);
+
+/**
+ * @brief Get the number of stored records.
+ *
+ * @param[in] instance pointer to the instance to be queried.
+ * @returns number of records.
+ */
+size_t nfc_trace_get_record_count(const NfcTrace* instance);
+
+/**
+ * @brief Get the number of records dropped because the trace was full.
+ *
+ * @param[in] instance pointer to the instance to be queried.
+ * @returns number of dropped records.
+ */
+size_t nfc_trace_get_dropped_count(const NfcTrace* instance);
+
+/**
+ * @brief Decode the record at the given position and advance the position.
+ *
+ * Start with position 0 and call until false is returned to iterate over all records.
+ * Timestamps are stored as deltas, so the same record must be passed to every call.
+ *
+ * @param[in] instance pointer to the instance to be read.
+ * @param[in,out] position pointer to the position in the record area.
+ * @param[in,out] record pointer to the record filled by the previous call.
+ * @returns true if a record was decoded, false at the end of the trace.
+ */
+bool nfc_trace_get_record(const NfcTrace* instance, size_t* position, NfcTraceRecord* record);
+
+/**
+ * @brief Copy frame of a decoded record to a buffer, together with parity bits if present.
+ *
+ * @param[in] record pointer to the frame record.
+ * @param[out] frame pointer to the buffer to be filled.
+ */
+void nfc_trace_record_get_frame(const NfcTraceRecord* record, BitBuffer* frame);
+
+/**
+ * @brief Write the trace to a stream.
+ *
+ * @param[in] instance pointer to the instance to be saved.
+ * @param[in,out] stream pointer to the stream to be written at its current position.
+ * @returns true on success, false otherwise.
+ */
+bool nfc_trace_save(const NfcTrace* instance, Stream* stream);
+
+/**
+ * @brief Replace the trace contents with a trace read from a stream.
+ *
+ * The record area grows if the saved trace does not fit into it. Record area
+ * size is checked against the stream size before anything is allocated.
+ *
+ * @param[in,out] instance pointer to the instance to be loaded.
+ * @param[in,out] stream pointer to the stream to be read from its current position.
+ * @returns true on success, false if the stream does not contain a valid trace.
+ */
+bool nfc_trace_load(NfcTrace* instance, Stream* stream);
+
+#ifdef __cplusplus
+}
+#endif
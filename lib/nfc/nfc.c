@@ -4,6 +4,7 @@
 
 #include <furi_hal_nfc.h>
 #include <furi/furi.h>
+#include <toolbox/profiler.h>
 
 #define TAG "Nfc"
 
@@ -57,6 +58,8 @@ struct Nfc {
     size_t tx_bits;
     uint8_t rx_buffer[NFC_MAX_BUFFER_SIZE];
     size_t rx_bits;
+    ProfilerProbeStart rx_probe;
+    NfcTrace* trace;
 
     FuriThread* worker_thread;
 };
@@ -101,6 +104,40 @@ static NfcError nfc_process_hal_error(FuriHalNfcError error) {
     return ret;
 }
 
+static void nfc_trace_event(Nfc* instance, NfcTraceEvent event) {
+    if(instance->trace) nfc_trace_add_event(instance->trace, event);
+}
+
+static void nfc_trace_frame(
+    Nfc* instance,
+    NfcTraceRecordType type,
+    const BitBuffer* frame,
+    bool with_parity) {
+    if(instance->trace) nfc_trace_add_frame(instance->trace, type, frame, with_parity);
+}
+
+static void nfc_trace_poller_rx(
+    Nfc* instance,
+    NfcError error,
+    const BitBuffer* rx_buffer,
+    bool with_parity) {
+    if(error == NfcErrorNone) {
+        nfc_trace_frame(instance, NfcTraceRecordTypePollerRx, rx_buffer, with_parity);
+    } else if(error == NfcErrorTimeout) {
+        nfc_trace_event(instance, NfcTraceEventPollerTimeout);
+    } else {
+        nfc_trace_event(instance, NfcTraceEventPollerError);
+    }
+}
+
+static void nfc_trace_short_frame(Nfc* instance, NfcIso14443aShortFrame frame) {
+    if(!instance->trace) return;
+
+    // Short frames are sent by HAL, so the frame is rebuilt for the trace
+    const uint8_t data = (frame == NfcIso14443aShortFrameAllReqa) ? 0x52 : 0x26;
+    nfc_trace_add_short_frame(instance->trace, NfcTraceRecordTypePollerTx, data, 7);
+}
+
 static int32_t nfc_worker_listener(void* context) {
     furi_assert(context);
 
@@ -125,26 +162,34 @@ static int32_t nfc_worker_listener(void* context) {
             break;
         }
         if(event & FuriHalNfcEventFieldOn) {
+            nfc_trace_event(instance, NfcTraceEventFieldOn);
             nfc_event.type = NfcEventTypeFieldOn;
             instance->callback(nfc_event, instance->context);
         }
         if(event & FuriHalNfcEventFieldOff) {
+            nfc_trace_event(instance, NfcTraceEventFieldOff);
             nfc_event.type = NfcEventTypeFieldOff;
             instance->callback(nfc_event, instance->context);
             furi_hal_nfc_listener_idle();
         }
         if(event & FuriHalNfcEventListenerActive) {
+            nfc_trace_event(instance, NfcTraceEventListenerActivated);
             nfc_event.type = NfcEventTypeListenerActivated;
             instance->callback(nfc_event, instance->context);
         }
         if(event & FuriHalNfcEventRxEnd) {
+            instance->rx_probe = profiler_probe_begin();
             furi_hal_nfc_timer_block_tx_start(instance->fdt_listen_fc);
 
             nfc_event.type = NfcEventTypeRxEnd;
             furi_hal_nfc_listener_rx(
                 instance->rx_buffer, sizeof(instance->rx_buffer), &instance->rx_bits);
             bit_buffer_copy_bits(event_data.buffer, instance->rx_buffer, instance->rx_bits);
+            nfc_trace_frame(instance, NfcTraceRecordTypeListenerRx, event_data.buffer, false);
+            ProfilerProbeStart probe = profiler_probe_begin();
             command = instance->callback(nfc_event, instance->context);
+            profiler_probe_end(ProfilerProbeNfcListenerHandler, probe);
+            instance->rx_probe = (ProfilerProbeStart){0};
             if(command == NfcCommandStop) {
                 break;
             } else if(command == NfcCommandReset) {
@@ -179,7 +224,9 @@ bool nfc_worker_poller_ready_handler(Nfc* instance) {
     NfcCommand command = NfcCommandContinue;
 
     NfcEvent event = {.type = NfcEventTypePollerReady};
+    ProfilerProbeStart probe = profiler_probe_begin();
     command = instance->callback(event, instance->context);
+    profiler_probe_end(ProfilerProbeNfcPollerHandler, probe);
     if(command == NfcCommandReset) {
         instance->poller_state = NfcPollerStateReset;
     } else if(command == NfcCommandStop) {
@@ -306,6 +353,13 @@ void nfc_set_mask_receive_time_fc(Nfc* instance, uint32_t mask_rx_time_fc) {
     instance->mask_rx_time_fc = mask_rx_time_fc;
 }
 
+void nfc_set_trace(Nfc* instance, NfcTrace* trace) {
+    furi_check(instance);
+    furi_check(instance->state == NfcStateIdle);
+
+    instance->trace = trace;
+}
+
 void nfc_start(Nfc* instance, NfcEventCallback callback, void* context) {
     furi_assert(instance);
     furi_assert(instance->worker_thread);
@@ -341,6 +395,10 @@ NfcError nfc_listener_tx(Nfc* instance, const BitBuffer* tx_buffer) {
 
     NfcError ret = NfcErrorNone;
 
+    profiler_probe_end(ProfilerProbeNfcListenerResponse, instance->rx_probe);
+    instance->rx_probe = (ProfilerProbeStart){0};
+    nfc_trace_frame(instance, NfcTraceRecordTypeListenerTx, tx_buffer, false);
+
     while(furi_hal_nfc_timer_block_tx_is_running()) {
     }
 
@@ -424,6 +482,7 @@ NfcError nfc_iso14443a_poller_trx_custom_parity(
                 furi_hal_nfc_poller_wait_event(FURI_HAL_NFC_EVENT_WAIT_FOREVER);
             if(event & FuriHalNfcEventTimerBlockTxExpired) break;
         }
+        nfc_trace_frame(instance, NfcTraceRecordTypePollerTx, tx_buffer, true);
         bit_buffer_write_bytes_with_parity(
             tx_buffer, instance->tx_buffer, sizeof(instance->tx_buffer), &instance->tx_bits);
         error =
@@ -457,6 +516,8 @@ NfcError nfc_iso14443a_poller_trx_custom_parity(
         bit_buffer_copy_bytes_with_parity(rx_buffer, instance->rx_buffer, instance->rx_bits);
     } while(false);
 
+    nfc_trace_poller_rx(instance, ret, rx_buffer, true);
+
     return ret;
 }
 
@@ -477,6 +538,7 @@ NfcError
                 furi_hal_nfc_poller_wait_event(FURI_HAL_NFC_EVENT_WAIT_FOREVER);
             if(event & FuriHalNfcEventTimerBlockTxExpired) break;
         }
+        nfc_trace_frame(instance, NfcTraceRecordTypePollerTx, tx_buffer, false);
         error =
             furi_hal_nfc_poller_tx(bit_buffer_get_data(tx_buffer), bit_buffer_get_size(tx_buffer));
         if(error != FuriHalNfcErrorNone) {
@@ -502,6 +564,8 @@ NfcError
         bit_buffer_copy_bits(rx_buffer, instance->rx_buffer, instance->rx_bits);
     } while(false);
 
+    nfc_trace_poller_rx(instance, ret, rx_buffer, false);
+
     return ret;
 }
 
@@ -542,6 +606,7 @@ NfcError nfc_iso14443a_poller_trx_short_frame(
                 furi_hal_nfc_poller_wait_event(FURI_HAL_NFC_EVENT_WAIT_FOREVER);
             if(event & FuriHalNfcEventTimerBlockTxExpired) break;
         }
+        nfc_trace_short_frame(instance, frame);
         error = furi_hal_nfc_iso14443a_poller_trx_short_frame(short_frame);
         if(error != FuriHalNfcErrorNone) {
             FURI_LOG_D(TAG, "Failed in poller TX");
@@ -566,6 +631,8 @@ NfcError nfc_iso14443a_poller_trx_short_frame(
         bit_buffer_copy_bits(rx_buffer, instance->rx_buffer, instance->rx_bits);
     } while(false);
 
+    nfc_trace_poller_rx(instance, ret, rx_buffer, false);
+
     return ret;
 }
 
@@ -589,6 +656,7 @@ NfcError nfc_iso14443a_poller_trx_sdd_frame(
                 furi_hal_nfc_poller_wait_event(FURI_HAL_NFC_EVENT_WAIT_FOREVER);
             if(event & FuriHalNfcEventTimerBlockTxExpired) break;
         }
+        nfc_trace_frame(instance, NfcTraceRecordTypePollerTx, tx_buffer, false);
         error = furi_hal_nfc_iso14443a_tx_sdd_frame(
             bit_buffer_get_data(tx_buffer), bit_buffer_get_size(tx_buffer));
         if(error != FuriHalNfcErrorNone) {
@@ -614,9 +682,36 @@ NfcError nfc_iso14443a_poller_trx_sdd_frame(
         bit_buffer_copy_bits(rx_buffer, instance->rx_buffer, instance->rx_bits);
     } while(false);
 
+    nfc_trace_poller_rx(instance, ret, rx_buffer, false);
+
     return ret;
 }
 
+bool nfc_iso14443a_poller_is_bit_rate_supported(
+    Nfc* instance,
+    NfcIso14443aBitRate tx_bit_rate,
+    NfcIso14443aBitRate rx_bit_rate) {
+    furi_assert(instance);
+    UNUSED(instance);
+
+    return furi_hal_nfc_iso14443a_poller_is_bit_rate_supported(
+        (FuriHalNfcaBitRate)tx_bit_rate, (FuriHalNfcaBitRate)rx_bit_rate);
+}
+
+NfcError nfc_iso14443a_poller_set_bit_rate(
+    Nfc* instance,
+    NfcIso14443aBitRate tx_bit_rate,
+    NfcIso14443aBitRate rx_bit_rate) {
+    furi_assert(instance);
+    furi_assert(instance->mode == NfcModePoller);
+
+    // Enumerations share the order of bit rates
+    FuriHalNfcError error = furi_hal_nfc_iso14443a_poller_set_bit_rate(
+        (FuriHalNfcaBitRate)tx_bit_rate, (FuriHalNfcaBitRate)rx_bit_rate);
+
+    return nfc_process_hal_error(error);
+}
+
 NfcError nfc_iso14443a_listener_tx_custom_parity(Nfc* instance, const BitBuffer* tx_buffer) {
     furi_assert(instance);
     furi_assert(tx_buffer);
@@ -628,6 +723,10 @@ NfcError nfc_iso14443a_listener_tx_custom_parity(Nfc* instance, const BitBuffer*
     const uint8_t* tx_parity = bit_buffer_get_parity(tx_buffer);
     size_t tx_bits = bit_buffer_get_size(tx_buffer);
 
+    profiler_probe_end(ProfilerProbeNfcListenerResponse, instance->rx_probe);
+    instance->rx_probe = (ProfilerProbeStart){0};
+    nfc_trace_frame(instance, NfcTraceRecordTypeListenerTx, tx_buffer, true);
+
     error = furi_hal_nfc_iso14443a_listener_tx_custom_parity(tx_data, tx_parity, tx_bits);
     ret = nfc_process_hal_error(error);
 
@@ -18,6 +18,7 @@
 #pragma once
 
 #include <toolbox/bit_buffer.h>
+#include <nfc/helpers/nfc_trace.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -192,6 +193,17 @@ void nfc_set_fdt_poll_poll_us(Nfc* instance, uint32_t fdt_poll_poll_us);
  */
 void nfc_set_guard_time_us(Nfc* instance, uint32_t guard_time_us);
 
+/**
+ * @brief Record frames and events of the instance to a trace.
+ *
+ * Recording can be turned on and off at runtime, but only while the instance is stopped.
+ * Frames are appended as they are exchanged, so records that do not fit are dropped.
+ *
+ * @param[in,out] instance pointer to the instance to be modified.
+ * @param[in] trace pointer to the trace to record to, NULL to stop recording.
+ */
+void nfc_set_trace(Nfc* instance, NfcTrace* trace);
+
 /**
  * @brief Start the Nfc instance.
  *
@@ -320,6 +332,48 @@ NfcError nfc_iso14443a_poller_trx_custom_parity(
     BitBuffer* rx_buffer,
     uint32_t fwt);
 
+/**
+ * @brief Enumeration of possible ISO14443-3A bit rates.
+ */
+typedef enum {
+    NfcIso14443aBitRate106Kbit,
+    NfcIso14443aBitRate212Kbit,
+    NfcIso14443aBitRate424Kbit,
+    NfcIso14443aBitRate848Kbit,
+} NfcIso14443aBitRate;
+
+/**
+ * @brief Check if ISO14443-3A bit rates are supported in poller mode.
+ *
+ * Must be checked before a higher bit rate is negotiated with the card.
+ *
+ * @param[in] instance pointer to the instance to be checked.
+ * @param[in] tx_bit_rate poller to card bit rate.
+ * @param[in] rx_bit_rate card to poller bit rate.
+ * @returns true if both bit rates can be set, false otherwise.
+ */
+bool nfc_iso14443a_poller_is_bit_rate_supported(
+    Nfc* instance,
+    NfcIso14443aBitRate tx_bit_rate,
+    NfcIso14443aBitRate rx_bit_rate);
+
+/**
+ * @brief Set ISO14443-3A bit rate in poller mode.
+ *
+ * Used after a higher bit rate was negotiated with the card, e.g. with ISO14443-4 PPS.
+ * The bit rate is reset to 106 kbps when the poller is stopped. Bit rates must be
+ * supported, see nfc_iso14443a_poller_is_bit_rate_supported().
+ *
+ * @param[in,out] instance pointer to the instance to be configured.
+ * @param[in] tx_bit_rate poller to card bit rate.
+ * @param[in] rx_bit_rate card to poller bit rate.
+ * @returns NfcErrorNone on success, any other error code on failure.
+ */
+NfcError nfc_iso14443a_poller_set_bit_rate(
+    Nfc* instance,
+    NfcIso14443aBitRate tx_bit_rate,
+    NfcIso14443aBitRate rx_bit_rate);
+
 /**
  * @brief Transmit an ISO14443-3A frame with custom parity bits in listener mode.
  *
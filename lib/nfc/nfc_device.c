@@ -2,6 +2,11 @@
 
 #include <storage/storage.h>
 #include <flipper_format/flipper_format.h>
+#include <flipper_format/flipper_format_i.h>
+#include <toolbox/stream/buffered_file_stream.h>
+#include <toolbox/stream/file_stream.h>
+
+#include "helpers/nfc_dump.h"
 
 #include "nfc_common.h"
 #include "protocols/nfc_device_defs.h"
@@ -147,24 +152,11 @@ void nfc_device_set_loading_callback(
     instance->loading_callback_context = context;
 }
 
-bool nfc_device_save(NfcDevice* instance, const char* path) {
-    furi_assert(instance);
-    furi_assert(instance->protocol < NfcProtocolNum);
-    furi_assert(path);
-
+static bool nfc_device_save_ff(NfcDevice* instance, FlipperFormat* ff) {
     bool saved = false;
-    Storage* storage = furi_record_open(RECORD_STORAGE);
-    FlipperFormat* ff = flipper_format_buffered_file_alloc(storage);
     FuriString* temp_str = furi_string_alloc();
 
-    if(instance->loading_callback) {
-        instance->loading_callback(instance->loading_callback_context, true);
-    }
-
     do {
-        // Open file
-        if(!flipper_format_buffered_file_open_always(ff, path)) break;
-
         // Write header
         if(!flipper_format_write_header_cstr(ff, NFC_FILE_HEADER, NFC_CURRENT_FORMAT_VERSION))
             break;
@@ -199,17 +191,74 @@ bool nfc_device_save(NfcDevice* instance, const char* path) {
         saved = true;
     } while(false);
 
+    furi_string_free(temp_str);
+
+    return saved;
+}
+
+bool nfc_device_save(NfcDevice* instance, const char* path) {
+    furi_assert(instance);
+    furi_assert(instance->protocol < NfcProtocolNum);
+    furi_assert(path);
+
+    bool saved = false;
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FlipperFormat* ff = flipper_format_buffered_file_alloc(storage);
+
+    if(instance->loading_callback) {
+        instance->loading_callback(instance->loading_callback_context, true);
+    }
+
+    if(flipper_format_buffered_file_open_always(ff, path)) {
+        saved = nfc_device_save_ff(instance, ff);
+    }
+
     if(instance->loading_callback) {
         instance->loading_callback(instance->loading_callback_context, false);
     }
 
-    furi_string_free(temp_str);
     flipper_format_free(ff);
     furi_record_close(RECORD_STORAGE);
 
     return saved;
 }
 
+bool nfc_device_save_binary(NfcDevice* instance, const char* path) {
+    furi_assert(instance);
+    furi_assert(instance->protocol < NfcProtocolNum);
+    furi_assert(path);
+
+    bool saved = false;
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    Stream* file = file_stream_alloc(storage);
+    FlipperFormat* ff = NULL;
+
+    if(instance->loading_callback) {
+        instance->loading_callback(instance->loading_callback_context, true);
+    }
+
+    do {
+        if(!file_stream_open(file, path, FSAM_READ_WRITE, FSOM_CREATE_ALWAYS)) break;
+
+        // Lines are encoded as they are written, sections go to the file as they fill up
+        ff = flipper_format_stream_based_alloc(nfc_dump_text_writer_alloc(file));
+        if(!nfc_device_save_ff(instance, ff)) break;
+        if(!nfc_dump_text_writer_finish(flipper_format_get_raw_stream(ff))) break;
+
+        saved = true;
+    } while(false);
+
+    if(instance->loading_callback) {
+        instance->loading_callback(instance->loading_callback_context, false);
+    }
+
+    if(ff) flipper_format_free(ff);
+    stream_free(file);
+    furi_record_close(RECORD_STORAGE);
+
+    return saved;
+}
+
 static bool nfc_device_load_uid(
     FlipperFormat* ff,
     uint8_t* uid,
@@ -312,24 +361,11 @@ static bool nfc_device_load_legacy(NfcDevice* instance, FlipperFormat* ff, uint3
     return loaded;
 }
 
-bool nfc_device_load(NfcDevice* instance, const char* path) {
-    furi_assert(instance);
-    furi_assert(path);
-
+static bool nfc_device_load_ff(NfcDevice* instance, FlipperFormat* ff) {
     bool loaded = false;
-    Storage* storage = furi_record_open(RECORD_STORAGE);
-    FlipperFormat* ff = flipper_format_buffered_file_alloc(storage);
-
-    FuriString* temp_str;
-    temp_str = furi_string_alloc();
-
-    if(instance->loading_callback) {
-        instance->loading_callback(instance->loading_callback_context, true);
-    }
+    FuriString* temp_str = furi_string_alloc();
 
     do {
-        if(!flipper_format_buffered_file_open_existing(ff, path)) break;
-
         // Read and verify file header
         uint32_t version = 0;
         if(!flipper_format_read_header(ff, temp_str, &version)) break;
@@ -344,12 +380,48 @@ bool nfc_device_load(NfcDevice* instance, const char* path) {
 
     } while(false);
 
+    furi_string_free(temp_str);
+
+    return loaded;
+}
+
+bool nfc_device_load(NfcDevice* instance, const char* path) {
+    furi_assert(instance);
+    furi_assert(path);
+
+    bool loaded = false;
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    Stream* file = buffered_file_stream_alloc(storage);
+    NfcDump* dump = NULL;
+
+    if(instance->loading_callback) {
+        instance->loading_callback(instance->loading_callback_context, true);
+    }
+
+    do {
+        if(!buffered_file_stream_open(file, path, FSAM_READ, FSOM_OPEN_EXISTING)) break;
+
+        FlipperFormat* ff = NULL;
+        if(nfc_dump_check(file)) {
+            // Sections of binary dump are restored to text as the parser reaches them
+            dump = nfc_dump_alloc();
+            if(!nfc_dump_open(dump, file)) break;
+            ff = flipper_format_stream_based_alloc(nfc_dump_text_stream_alloc(dump));
+        } else {
+            ff = flipper_format_stream_based_alloc(file);
+            file = NULL;
+        }
+
+        loaded = nfc_device_load_ff(instance, ff);
+        flipper_format_free(ff);
+    } while(false);
+
     if(instance->loading_callback) {
         instance->loading_callback(instance->loading_callback_context, false);
     }
 
-    furi_string_free(temp_str);
-    flipper_format_free(ff);
+    if(dump) nfc_dump_free(dump);
+    if(file) stream_free(file);
     furi_record_close(RECORD_STORAGE);
 
     return loaded;
@@ -252,9 +252,25 @@ void nfc_device_set_loading_callback(
  */
 bool nfc_device_save(NfcDevice* instance, const char* path);
 
+/**
+ * @brief Save NFC device data form an NfcDevice instance to a binary file.
+ *
+ * Binary file holds the same data as the text one in less space and is
+ * loaded with nfc_device_load() as well.
+ *
+ * @see nfc_dump.h for the file format.
+ *
+ * @param[in] instance pointer to the instance to be saved.
+ * @param[in] path pointer to a character string with a full file path.
+ * @returns true if the data was successfully saved, false otherwise.
+ */
+bool nfc_device_save_binary(NfcDevice* instance, const char* path);
+
 /**
  * @brief Load NFC device data to an NfcDevice instance from a file.
  *
+ * Both text and binary files are accepted.
+ *
  * @param[in,out] instance pointer to the instance to be loaded into.
  * @param[in] path pointer to a character string with a full file path.
  * @returns true if the data was successfully loaded, false otherwise.
@@ -113,6 +113,10 @@ Iso14443_3aError
         instance->state = Iso14443_3aPollerStateIdle;
     }
 
+    // Card drops bit rate negotiated by upper layers when halted or reactivated
+    nfc_iso14443a_poller_set_bit_rate(
+        instance->nfc, NfcIso14443aBitRate106Kbit, NfcIso14443aBitRate106Kbit);
+
     NfcError error = NfcErrorNone;
     Iso14443_3aError ret = Iso14443_3aErrorNone;
 
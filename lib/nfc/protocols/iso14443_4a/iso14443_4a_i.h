@@ -3,6 +3,12 @@
 #include "iso14443_4a.h"
 
 #define ISO14443_4A_CMD_READ_ATS (0xE0)
+#define ISO14443_4A_CMD_PPS (0xD0)
+
+// PPS bit definitions
+#define ISO14443_4A_PPS0_PPS1 (0x11U)
+#define ISO14443_4A_PPS1_DSI_SHIFT (2U)
+#define ISO14443_4A_PPS1_DRI_SHIFT (0U)
 
 // ATS bit definitions
 #define ISO14443_4A_ATS_T0_TA1 (1U << 4)
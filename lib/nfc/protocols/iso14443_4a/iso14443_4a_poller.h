@@ -38,6 +38,18 @@ typedef struct {
     Iso14443_4aPollerEventData* data; /**< Pointer to event specific data. */
 } Iso14443_4aPollerEvent;
 
+/**
+ * @brief Enumeration of Iso14443_4a poller bit rates.
+ */
+typedef enum {
+    Iso14443_4aPollerBitRate106Kbit,
+    Iso14443_4aPollerBitRate212Kbit,
+    Iso14443_4aPollerBitRate424Kbit,
+    Iso14443_4aPollerBitRate848Kbit,
+
+    Iso14443_4aPollerBitRateNum,
+} Iso14443_4aPollerBitRate;
+
 /**
  * @brief Transmit and receive Iso14443_4a blocks in poller mode.
  *
@@ -46,6 +58,11 @@ typedef struct {
  * The rx_buffer will be filled with any data received as a response to data
  * sent from tx_buffer. The fwt parameter is calculated during activation procedure.
  *
+ * Data that does not fit into the frame size reported by the card is sent with
+ * chaining, chained responses are reassembled. Frame waiting time extensions
+ * requested by the card are granted, lost or corrupted blocks are recovered
+ * with R(NAK) and R(ACK) blocks.
+ *
  * @param[in, out] instance pointer to the instance to be used in the transaction.
  * @param[in] tx_buffer pointer to the buffer containing the data to be transmitted.
  * @param[out] rx_buffer pointer to the buffer to be filled with received data.
@@ -82,6 +99,26 @@ Iso14443_4aError iso14443_4a_poller_halt(Iso14443_4aPoller* instance);
 Iso14443_4aError
     iso14443_4a_poller_read_ats(Iso14443_4aPoller* instance, Iso14443_4aAtsData* data);
 
+/**
+ * @brief Negotiate bit rate with the card using Protocol and Parameter Selection (PPS).
+ *
+ * Must ONLY be used inside the callback function, right after the card was activated.
+ *
+ * Requested bit rates must be supported by the card according to its ATS and
+ * by the reader, otherwise no PPS is sent and the card stays at 106 kbps.
+ * On success the poller switches to the new bit rate, 106 kbps is restored
+ * on the next card activation.
+ *
+ * @param[in, out] instance pointer to the instance to be used in the transaction.
+ * @param[in] pcd_to_picc poller to card bit rate.
+ * @param[in] picc_to_pcd card to poller bit rate.
+ * @return Iso14443_4aErrorNone on success, an error code on failure.
+ */
+Iso14443_4aError iso14443_4a_poller_send_pps(
+    Iso14443_4aPoller* instance,
+    Iso14443_4aPollerBitRate pcd_to_picc,
+    Iso14443_4aPollerBitRate picc_to_pcd);
+
 #ifdef __cplusplus
 }
 #endif
@@ -56,24 +56,127 @@ Iso14443_4aError iso14443_4a_poller_send_block(
     BitBuffer* rx_buffer) {
     furi_assert(instance);
 
-    bit_buffer_reset(instance->tx_buffer);
-    iso14443_4_layer_encode_block(instance->iso14443_4_layer, tx_buffer, instance->tx_buffer);
+    Iso14443_4Layer* layer = instance->iso14443_4_layer;
+
+    bit_buffer_reset(rx_buffer);
+    iso14443_4_layer_encode_command(layer, tx_buffer, instance->tx_buffer);
+
+    Iso14443_3aError iso14443_3a_error = Iso14443_3aErrorNone;
+    Iso14443_4LayerResult result = Iso14443_4LayerResultSend;
+
+    while(result == Iso14443_4LayerResultSend) {
+        const uint32_t fwt = iso14443_4a_get_fwt_fc_max(instance->data) *
+                             iso14443_4_layer_get_fwt_multiplier(layer);
+
+        iso14443_3a_error = iso14443_3a_poller_send_standard_frame(
+            instance->iso14443_3a_poller, instance->tx_buffer, instance->rx_buffer, fwt);
+
+        if(iso14443_3a_error == Iso14443_3aErrorNone) {
+            result = iso14443_4_layer_decode_response(
+                layer, rx_buffer, instance->rx_buffer, instance->tx_buffer);
+        } else {
+            FURI_LOG_D(TAG, "Block exchange failed: %d", iso14443_3a_error);
+            result = iso14443_4_layer_encode_error(layer, instance->tx_buffer);
+        }
+    }
+
+    Iso14443_4aError error = Iso14443_4aErrorNone;
+    if(result != Iso14443_4LayerResultData) {
+        // Report the last transmission error, or protocol error if the card misbehaved
+        error = iso14443_4a_process_error(iso14443_3a_error);
+        if(error == Iso14443_4aErrorNone) error = Iso14443_4aErrorProtocol;
+    }
+
+    return error;
+}
+
+static bool iso14443_4a_poller_is_bit_rate_supported(
+    const Iso14443_4aAtsData* ats_data,
+    Iso14443_4aPollerBitRate pcd_to_picc,
+    Iso14443_4aPollerBitRate picc_to_pcd) {
+    if(pcd_to_picc == Iso14443_4aPollerBitRate106Kbit &&
+       picc_to_pcd == Iso14443_4aPollerBitRate106Kbit) {
+        return true;
+    }
+    if(!(ats_data->tl > 1) || !(ats_data->t0 & ISO14443_4A_ATS_T0_TA1)) return false;
+
+    const uint8_t ta_1 = ats_data->ta_1;
+    if((ta_1 & ISO14443_4A_ATS_TA1_BOTH_SAME_COMPULSORY) && (pcd_to_picc != picc_to_pcd)) {
+        return false;
+    }
+
+    // TA1 bits for 212, 424 and 848 kbps follow each other
+    if(pcd_to_picc != Iso14443_4aPollerBitRate106Kbit &&
+       !(ta_1 & (ISO14443_4A_ATS_TA1_PCD_TO_PICC_212KBIT << (pcd_to_picc - 1)))) {
+        return false;
+    }
+    if(picc_to_pcd != Iso14443_4aPollerBitRate106Kbit &&
+       !(ta_1 & (ISO14443_4A_ATS_TA1_PICC_TO_PCD_212KBIT << (picc_to_pcd - 1)))) {
+        return false;
+    }
+
+    return true;
+}
+
+Iso14443_4aError iso14443_4a_poller_send_pps(
+    Iso14443_4aPoller* instance,
+    Iso14443_4aPollerBitRate pcd_to_picc,
+    Iso14443_4aPollerBitRate picc_to_pcd) {
+    furi_assert(instance);
+    furi_check(pcd_to_picc < Iso14443_4aPollerBitRateNum);
+    furi_check(picc_to_pcd < Iso14443_4aPollerBitRateNum);
 
     Iso14443_4aError error = Iso14443_4aErrorNone;
 
     do {
-        Iso14443_3aError iso14443_3a_error = iso14443_3a_poller_send_standard_frame(
+        if(!iso14443_4a_poller_is_bit_rate_supported(
+               &instance->data->ats_data, pcd_to_picc, picc_to_pcd)) {
+            FURI_LOG_D(TAG, "Bit rate not supported by card");
+            error = Iso14443_4aErrorProtocol;
+            break;
+        }
+
+        // Poller bit rate enumeration follows NFC one
+        if(!nfc_iso14443a_poller_is_bit_rate_supported(
+               instance->iso14443_3a_poller->nfc,
+               (NfcIso14443aBitRate)pcd_to_picc,
+               (NfcIso14443aBitRate)picc_to_pcd)) {
+            FURI_LOG_D(TAG, "Bit rate not supported by reader");
+            error = Iso14443_4aErrorProtocol;
+            break;
+        }
+
+        bit_buffer_reset(instance->tx_buffer);
+        bit_buffer_append_byte(instance->tx_buffer, ISO14443_4A_CMD_PPS);
+        bit_buffer_append_byte(instance->tx_buffer, ISO14443_4A_PPS0_PPS1);
+        bit_buffer_append_byte(
+            instance->tx_buffer,
+            (picc_to_pcd << ISO14443_4A_PPS1_DSI_SHIFT) |
+                (pcd_to_picc << ISO14443_4A_PPS1_DRI_SHIFT));
+
+        const Iso14443_3aError iso14443_3a_error = iso14443_3a_poller_send_standard_frame(
             instance->iso14443_3a_poller,
             instance->tx_buffer,
             instance->rx_buffer,
             iso14443_4a_get_fwt_fc_max(instance->data));
 
         if(iso14443_3a_error != Iso14443_3aErrorNone) {
+            FURI_LOG_E(TAG, "PPS request failed");
             error = iso14443_4a_process_error(iso14443_3a_error);
             break;
+        } else if(
+            bit_buffer_get_size_bytes(instance->rx_buffer) != 1 ||
+            !bit_buffer_starts_with_byte(instance->rx_buffer, ISO14443_4A_CMD_PPS)) {
+            FURI_LOG_E(TAG, "Wrong PPS response");
+            error = Iso14443_4aErrorProtocol;
+            break;
+        }
 
-        } else if(!iso14443_4_layer_decode_block(
-                      instance->iso14443_4_layer, rx_buffer, instance->rx_buffer)) {
+        const NfcError nfc_error = nfc_iso14443a_poller_set_bit_rate(
+            instance->iso14443_3a_poller->nfc,
+            (NfcIso14443aBitRate)pcd_to_picc,
+            (NfcIso14443aBitRate)picc_to_pcd);
+        if(nfc_error != NfcErrorNone) {
             error = Iso14443_4aErrorProtocol;
             break;
         }
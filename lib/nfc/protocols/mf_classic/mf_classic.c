@@ -183,7 +183,7 @@ bool mf_classic_load(MfClassicData* data, FlipperFormat* ff, uint32_t version) {
         FuriString* block_str = furi_string_alloc();
         uint16_t blocks_total = mf_classic_get_total_block_num(data->type);
         for(size_t i = 0; i < blocks_total; i++) {
-            furi_string_printf(temp_str, "Block %d", i);
+            furi_string_printf(temp_str, "Block %zu", i);
             if(!flipper_format_read_string(ff, furi_string_get_cstr(temp_str), block_str)) {
                 block_read = false;
                 break;
@@ -276,7 +276,7 @@ bool mf_classic_save(const MfClassicData* data, FlipperFormat* ff) {
         FuriString* block_str = furi_string_alloc();
         bool block_saved = true;
         for(size_t i = 0; i < blocks_total; i++) {
-            furi_string_printf(temp_str, "Block %d", i);
+            furi_string_printf(temp_str, "Block %zu", i);
             mf_classic_set_block_str(block_str, data, i);
             if(!flipper_format_write_string(ff, furi_string_get_cstr(temp_str), block_str)) {
                 block_saved = false;
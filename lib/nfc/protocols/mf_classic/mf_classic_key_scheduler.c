@@ -0,0 +1,406 @@
+#include "mf_classic_key_scheduler.h"
+
+#include <furi.h>
+#include <nfc/helpers/nfc_util.h>
+#include <flipper_format/flipper_format.h>
+#include <storage/storage.h>
+
+#define TAG "MfClassicKeyScheduler"
+
+#define MF_CLASSIC_KEY_SCHEDULER_STATS_HEADER "Flipper NFC key stats"
+#define MF_CLASSIC_KEY_SCHEDULER_STATS_VERSION (1U)
+
+#define MF_CLASSIC_KEY_SCHEDULER_STATS_MAX (64U)
+// All weights decay by 1/16 per card, then the keys found on it gain this weight
+#define MF_CLASSIC_KEY_SCHEDULER_STATS_WEIGHT (256U)
+#define MF_CLASSIC_KEY_SCHEDULER_STATS_DECAY_SHIFT (4U)
+#define MF_CLASSIC_KEY_SCHEDULER_CARD_KEYS_MAX (MF_CLASSIC_TOTAL_SECTORS_MAX * 2)
+#define MF_CLASSIC_KEY_SCHEDULER_PRIORITY_MAX \
+    (MF_CLASSIC_KEY_SCHEDULER_CARD_KEYS_MAX + MF_CLASSIC_KEY_SCHEDULER_STATS_MAX)
+
+#define MF_CLASSIC_KEY_SET_CAPACITY_MIN (64U)
+// Keys are 48 bits wide, the top bit marks used slots
+#define MF_CLASSIC_KEY_SET_USED (1ULL << 63)
+
+typedef struct {
+    uint64_t* slots;
+    size_t capacity;
+    size_t count;
+} MfClassicKeySet;
+
+typedef struct {
+    uint64_t key;
+    uint32_t count;
+} MfClassicKeyRank;
+
+struct MfClassicKeyScheduler {
+    KeysDict* dict;
+    size_t dict_keys_read;
+
+    // Keys of previously set dictionaries and ranked keys tried with them
+    MfClassicKeySet seen;
+    // Keys given out from the priority list on the current sector
+    MfClassicKeySet priority_set;
+
+    uint64_t priority[MF_CLASSIC_KEY_SCHEDULER_PRIORITY_MAX];
+    size_t priority_count;
+    size_t priority_pos;
+
+    MfClassicKeyRank stats[MF_CLASSIC_KEY_SCHEDULER_STATS_MAX];
+    size_t stats_count;
+};
+
+static void mf_classic_key_set_init(MfClassicKeySet* set, size_t capacity) {
+    set->slots = malloc(capacity * sizeof(uint64_t));
+    set->capacity = capacity;
+    set->count = 0;
+}
+
+static void mf_classic_key_set_deinit(MfClassicKeySet* set) {
+    free(set->slots);
+    set->slots = NULL;
+    set->capacity = 0;
+    set->count = 0;
+}
+
+static void mf_classic_key_set_reset(MfClassicKeySet* set) {
+    memset(set->slots, 0, set->capacity * sizeof(uint64_t));
+    set->count = 0;
+}
+
+static size_t mf_classic_key_set_find_slot(const MfClassicKeySet* set, uint64_t key) {
+    const uint64_t slot_value = key | MF_CLASSIC_KEY_SET_USED;
+    // Fibonacci hashing, capacity is a power of two
+    size_t slot = (key * 0x9E3779B97F4A7C15ULL) >> 32;
+
+    while(true) {
+        slot &= set->capacity - 1;
+        if(set->slots[slot] == 0 || set->slots[slot] == slot_value) break;
+        slot++;
+    }
+
+    return slot;
+}
+
+static bool mf_classic_key_set_contains(const MfClassicKeySet* set, uint64_t key) {
+    if(set->count == 0) return false;
+    return set->slots[mf_classic_key_set_find_slot(set, key)] != 0;
+}
+
+static bool mf_classic_key_set_insert(MfClassicKeySet* set, uint64_t key) {
+    const size_t slot = mf_classic_key_set_find_slot(set, key);
+    if(set->slots[slot]) return false;
+
+    set->slots[slot] = key | MF_CLASSIC_KEY_SET_USED;
+    set->count++;
+
+    return true;
+}
+
+static bool mf_classic_key_set_add(MfClassicKeySet* set, uint64_t key) {
+    // Keep at least a quarter of slots free for short probe sequences
+    if((set->count + 1) * 4 > set->capacity * 3) {
+        MfClassicKeySet grown = {};
+        mf_classic_key_set_init(&grown, set->capacity * 2);
+        for(size_t i = 0; i < set->capacity; i++) {
+            if(set->slots[i]) {
+                mf_classic_key_set_insert(&grown, set->slots[i] & ~MF_CLASSIC_KEY_SET_USED);
+            }
+        }
+        mf_classic_key_set_deinit(set);
+        *set = grown;
+    }
+
+    return mf_classic_key_set_insert(set, key);
+}
+
+static size_t mf_classic_key_rank_add(MfClassicKeyRank* ranks, size_t count, uint64_t key) {
+    size_t i = 0;
+    for(; i < count; i++) {
+        if(ranks[i].key == key) break;
+    }
+
+    if(i == count) {
+        ranks[count].key = key;
+        ranks[count].count = 0;
+        count++;
+    }
+    ranks[i].count++;
+
+    return count;
+}
+
+static void mf_classic_key_rank_sort(MfClassicKeyRank* ranks, size_t count) {
+    // Stable, so keys with equal counts keep their order
+    for(size_t i = 1; i < count; i++) {
+        MfClassicKeyRank rank = ranks[i];
+        size_t j = i;
+        for(; j > 0 && ranks[j - 1].count < rank.count; j--) {
+            ranks[j] = ranks[j - 1];
+        }
+        ranks[j] = rank;
+    }
+}
+
+static size_t
+    mf_classic_key_scheduler_get_card_keys(const MfClassicData* data, MfClassicKeyRank* keys) {
+    size_t count = 0;
+    const uint8_t sectors_total = mf_classic_get_total_sectors_num(data->type);
+
+    for(uint8_t i = 0; i < sectors_total; i++) {
+        const MfClassicSectorTrailer* sec_tr = mf_classic_get_sector_trailer_by_sector(data, i);
+        if(mf_classic_is_key_found(data, i, MfClassicKeyTypeA)) {
+            uint64_t key = nfc_util_bytes2num(sec_tr->key_a.data, sizeof(MfClassicKey));
+            count = mf_classic_key_rank_add(keys, count, key);
+        }
+        if(mf_classic_is_key_found(data, i, MfClassicKeyTypeB)) {
+            uint64_t key = nfc_util_bytes2num(sec_tr->key_b.data, sizeof(MfClassicKey));
+            count = mf_classic_key_rank_add(keys, count, key);
+        }
+    }
+    mf_classic_key_rank_sort(keys, count);
+
+    return count;
+}
+
+// Keys that decayed to zero weight were not found for long, they are not worth a try
+static void mf_classic_key_scheduler_sort_stats(MfClassicKeyScheduler* instance) {
+    mf_classic_key_rank_sort(instance->stats, instance->stats_count);
+    while(instance->stats_count && instance->stats[instance->stats_count - 1].count == 0) {
+        instance->stats_count--;
+    }
+}
+
+MfClassicKeyScheduler* mf_classic_key_scheduler_alloc(void) {
+    MfClassicKeyScheduler* instance = malloc(sizeof(MfClassicKeyScheduler));
+
+    mf_classic_key_set_init(&instance->seen, MF_CLASSIC_KEY_SET_CAPACITY_MIN);
+    mf_classic_key_set_init(&instance->priority_set, MF_CLASSIC_KEY_SET_CAPACITY_MIN);
+
+    return instance;
+}
+
+void mf_classic_key_scheduler_free(MfClassicKeyScheduler* instance) {
+    furi_check(instance);
+
+    mf_classic_key_set_deinit(&instance->priority_set);
+    mf_classic_key_set_deinit(&instance->seen);
+    free(instance);
+}
+
+bool mf_classic_key_scheduler_load_stats(MfClassicKeyScheduler* instance, const char* path) {
+    furi_check(instance);
+    furi_check(path);
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FlipperFormat* ff = flipper_format_buffered_file_alloc(storage);
+    FuriString* temp_str = furi_string_alloc();
+    uint8_t* keys = malloc(MF_CLASSIC_KEY_SCHEDULER_STATS_MAX * sizeof(MfClassicKey));
+    uint32_t* counts = malloc(MF_CLASSIC_KEY_SCHEDULER_STATS_MAX * sizeof(uint32_t));
+
+    bool loaded = false;
+    do {
+        if(!flipper_format_buffered_file_open_existing(ff, path)) break;
+
+        uint32_t version = 0;
+        if(!flipper_format_read_header(ff, temp_str, &version)) break;
+        if(furi_string_cmp_str(temp_str, MF_CLASSIC_KEY_SCHEDULER_STATS_HEADER)) break;
+        if(version != MF_CLASSIC_KEY_SCHEDULER_STATS_VERSION) break;
+
+        uint32_t count = 0;
+        if(!flipper_format_read_uint32(ff, "Key count", &count, 1)) break;
+        if(count > MF_CLASSIC_KEY_SCHEDULER_STATS_MAX) break;
+        if(count) {
+            if(!flipper_format_read_hex(ff, "Keys", keys, count * sizeof(MfClassicKey))) break;
+            if(!flipper_format_read_uint32(ff, "Weights", counts, count)) break;
+        }
+
+        for(size_t i = 0; i < count; i++) {
+            instance->stats[i].key =
+                nfc_util_bytes2num(&keys[i * sizeof(MfClassicKey)], sizeof(MfClassicKey));
+            instance->stats[i].count = counts[i];
+        }
+        instance->stats_count = count;
+        mf_classic_key_scheduler_sort_stats(instance);
+
+        loaded = true;
+    } while(false);
+
+    free(counts);
+    free(keys);
+    furi_string_free(temp_str);
+    flipper_format_free(ff);
+    furi_record_close(RECORD_STORAGE);
+
+    return loaded;
+}
+
+bool mf_classic_key_scheduler_save_stats(const MfClassicKeyScheduler* instance, const char* path) {
+    furi_check(instance);
+    furi_check(path);
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FlipperFormat* ff = flipper_format_buffered_file_alloc(storage);
+    uint8_t* keys = malloc(MF_CLASSIC_KEY_SCHEDULER_STATS_MAX * sizeof(MfClassicKey));
+    uint32_t* counts = malloc(MF_CLASSIC_KEY_SCHEDULER_STATS_MAX * sizeof(uint32_t));
+
+    const uint32_t count = instance->stats_count;
+    for(size_t i = 0; i < count; i++) {
+        nfc_util_num2bytes(
+            instance->stats[i].key, sizeof(MfClassicKey), &keys[i * sizeof(MfClassicKey)]);
+        counts[i] = instance->stats[i].count;
+    }
+
+    bool saved = false;
+    do {
+        if(!flipper_format_buffered_file_open_always(ff, path)) break;
+        if(!flipper_format_write_header_cstr(
+               ff, MF_CLASSIC_KEY_SCHEDULER_STATS_HEADER, MF_CLASSIC_KEY_SCHEDULER_STATS_VERSION))
+            break;
+        if(!flipper_format_write_uint32(ff, "Key count", &count, 1)) break;
+        if(count) {
+            if(!flipper_format_write_hex(ff, "Keys", keys, count * sizeof(MfClassicKey))) break;
+            if(!flipper_format_write_uint32(ff, "Weights", counts, count)) break;
+        }
+        saved = true;
+    } while(false);
+
+    free(counts);
+    free(keys);
+    flipper_format_free(ff);
+    furi_record_close(RECORD_STORAGE);
+
+    return saved;
+}
+
+void mf_classic_key_scheduler_add_card(
+    MfClassicKeyScheduler* instance,
+    const MfClassicData* data) {
+    furi_check(instance);
+    furi_check(data);
+
+    MfClassicKeyRank* card_keys =
+        malloc(MF_CLASSIC_KEY_SCHEDULER_CARD_KEYS_MAX * sizeof(MfClassicKeyRank));
+    const size_t card_key_count = mf_classic_key_scheduler_get_card_keys(data, card_keys);
+
+    // Keys that stop showing up fade out, so new keys can take their slots
+    for(size_t i = 0; i < instance->stats_count; i++) {
+        MfClassicKeyRank* rank = &instance->stats[i];
+        rank->count -= (rank->count + (1U << MF_CLASSIC_KEY_SCHEDULER_STATS_DECAY_SHIFT) - 1) >>
+                       MF_CLASSIC_KEY_SCHEDULER_STATS_DECAY_SHIFT;
+    }
+
+    for(size_t i = 0; i < card_key_count; i++) {
+        size_t j = 0;
+        for(; j < instance->stats_count; j++) {
+            if(instance->stats[j].key == card_keys[i].key) break;
+        }
+
+        if(j < instance->stats_count) {
+            instance->stats[j].count += MF_CLASSIC_KEY_SCHEDULER_STATS_WEIGHT;
+        } else {
+            // Full table: the key with the lowest decayed weight makes room for the new one
+            if(instance->stats_count == MF_CLASSIC_KEY_SCHEDULER_STATS_MAX) {
+                instance->stats_count--;
+            }
+            instance->stats[instance->stats_count].key = card_keys[i].key;
+            instance->stats[instance->stats_count].count = MF_CLASSIC_KEY_SCHEDULER_STATS_WEIGHT;
+            instance->stats_count++;
+        }
+        mf_classic_key_rank_sort(instance->stats, instance->stats_count);
+    }
+    mf_classic_key_scheduler_sort_stats(instance);
+
+    free(card_keys);
+}
+
+void mf_classic_key_scheduler_finish_dict(MfClassicKeyScheduler* instance) {
+    furi_check(instance);
+    furi_check(instance->dict);
+
+    MfClassicKey key = {};
+    keys_dict_rewind(instance->dict);
+    while(keys_dict_get_next_key(instance->dict, key.data, sizeof(MfClassicKey))) {
+        mf_classic_key_set_add(&instance->seen, nfc_util_bytes2num(key.data, sizeof(MfClassicKey)));
+    }
+    // Ranked keys don't change during an attack, so they were tried on every sector too.
+    // Card keys are not: a key found on a later sector was not tried on earlier ones.
+    for(size_t i = 0; i < instance->stats_count; i++) {
+        mf_classic_key_set_add(&instance->seen, instance->stats[i].key);
+    }
+    FURI_LOG_D(TAG, "%zu keys seen", instance->seen.count);
+
+    keys_dict_rewind(instance->dict);
+    instance->dict_keys_read = 0;
+}
+
+void mf_classic_key_scheduler_set_dict(MfClassicKeyScheduler* instance, KeysDict* dict) {
+    furi_check(instance);
+    furi_check(dict);
+
+    instance->dict = dict;
+    keys_dict_rewind(instance->dict);
+    instance->dict_keys_read = 0;
+}
+
+void mf_classic_key_scheduler_start_sector(
+    MfClassicKeyScheduler* instance,
+    const MfClassicData* data) {
+    furi_check(instance);
+    furi_check(data);
+
+    MfClassicKeyRank* card_keys =
+        malloc(MF_CLASSIC_KEY_SCHEDULER_CARD_KEYS_MAX * sizeof(MfClassicKeyRank));
+    const size_t card_key_count = mf_classic_key_scheduler_get_card_keys(data, card_keys);
+
+    mf_classic_key_set_reset(&instance->priority_set);
+    instance->priority_count = 0;
+    instance->priority_pos = 0;
+
+    for(size_t i = 0; i < card_key_count; i++) {
+        if(mf_classic_key_set_contains(&instance->seen, card_keys[i].key)) continue;
+        if(mf_classic_key_set_add(&instance->priority_set, card_keys[i].key)) {
+            instance->priority[instance->priority_count++] = card_keys[i].key;
+        }
+    }
+    for(size_t i = 0; i < instance->stats_count; i++) {
+        if(mf_classic_key_set_contains(&instance->seen, instance->stats[i].key)) continue;
+        if(mf_classic_key_set_add(&instance->priority_set, instance->stats[i].key)) {
+            instance->priority[instance->priority_count++] = instance->stats[i].key;
+        }
+    }
+
+    free(card_keys);
+
+    if(instance->dict) keys_dict_rewind(instance->dict);
+    instance->dict_keys_read = 0;
+}
+
+bool mf_classic_key_scheduler_get_next_key(MfClassicKeyScheduler* instance, MfClassicKey* key) {
+    furi_check(instance);
+    furi_check(key);
+
+    if(instance->priority_pos < instance->priority_count) {
+        nfc_util_num2bytes(
+            instance->priority[instance->priority_pos++], sizeof(MfClassicKey), key->data);
+        return true;
+    }
+
+    bool key_found = false;
+    while(instance->dict && !key_found) {
+        if(!keys_dict_get_next_key(instance->dict, key->data, sizeof(MfClassicKey))) break;
+        instance->dict_keys_read++;
+
+        const uint64_t key_num = nfc_util_bytes2num(key->data, sizeof(MfClassicKey));
+        key_found = !mf_classic_key_set_contains(&instance->priority_set, key_num) &&
+                    !mf_classic_key_set_contains(&instance->seen, key_num);
+    }
+
+    return key_found;
+}
+
+size_t mf_classic_key_scheduler_get_dict_keys_read(const MfClassicKeyScheduler* instance) {
+    furi_check(instance);
+
+    return instance->dict_keys_read;
+}
@@ -0,0 +1,133 @@
+/**
+ * @file mf_classic_key_scheduler.h
+ * @brief Key order for the MfClassic dictionary attack.
+ *
+ * Real cards reuse a few keys across many sectors, and the same keys show up
+ * on many cards. For every sector the scheduler gives out keys in this order:
+ * - keys already found on the card, the most used ones first;
+ * - keys ranked by how often they were found on recent cards, see
+ *   mf_classic_key_scheduler_add_card();
+ * - keys of the current dictionary in file order.
+ *
+ * Every key is given out once per sector: dictionary keys that were already
+ * given out from the lists above are skipped. Keys of a finished dictionary
+ * and ranked keys tried along with it are skipped everywhere, see
+ * mf_classic_key_scheduler_finish_dict().
+ *
+ * The scheduler is not thread safe: key statistics must not be changed or
+ * saved while a poller thread takes keys from it.
+ */
+#pragma once
+
+#include "mf_classic.h"
+
+#include <toolbox/keys_dict.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief MfClassicKeyScheduler opaque type definition.
+ */
+typedef struct MfClassicKeyScheduler MfClassicKeyScheduler;
+
+/**
+ * @brief Allocate an MfClassicKeyScheduler instance.
+ *
+ * @returns pointer to the allocated instance.
+ */
+MfClassicKeyScheduler* mf_classic_key_scheduler_alloc(void);
+
+/**
+ * @brief Delete an MfClassicKeyScheduler instance.
+ *
+ * The dictionary is not freed.
+ *
+ * @param[in,out] instance pointer to the instance to be deleted.
+ */
+void mf_classic_key_scheduler_free(MfClassicKeyScheduler* instance);
+
+/**
+ * @brief Load key statistics from a file.
+ *
+ * @param[in,out] instance pointer to the instance.
+ * @param[in] path pointer to the file path.
+ * @returns true on success, false otherwise.
+ */
+bool mf_classic_key_scheduler_load_stats(MfClassicKeyScheduler* instance, const char* path);
+
+/**
+ * @brief Save key statistics to a file.
+ *
+ * @param[in] instance pointer to the instance.
+ * @param[in] path pointer to the file path.
+ * @returns true on success, false otherwise.
+ */
+bool mf_classic_key_scheduler_save_stats(const MfClassicKeyScheduler* instance, const char* path);
+
+/**
+ * @brief Count the keys found on a card in the key statistics.
+ *
+ * Each key is counted once per card, no matter how many sectors use it.
+ * Weights of all keys decay with every card, so keys that stop showing up
+ * make room for new ones when the table is full.
+ *
+ * @param[in,out] instance pointer to the instance.
+ * @param[in] data pointer to the card data.
+ */
+void mf_classic_key_scheduler_add_card(
+    MfClassicKeyScheduler* instance,
+    const MfClassicData* data);
+
+/**
+ * @brief Remember keys of the current dictionary and ranked keys as tried on every sector.
+ *
+ * Call it only when the dictionary attack went through the whole dictionary,
+ * not when it was skipped, then the keys are not given out with the next one.
+ *
+ * @param[in,out] instance pointer to the instance, a dictionary must be set.
+ */
+void mf_classic_key_scheduler_finish_dict(MfClassicKeyScheduler* instance);
+
+/**
+ * @brief Set the dictionary to take keys from after the ranked ones.
+ *
+ * @param[in,out] instance pointer to the instance.
+ * @param[in] dict pointer to the dictionary, must stay valid while it is set.
+ */
+void mf_classic_key_scheduler_set_dict(MfClassicKeyScheduler* instance, KeysDict* dict);
+
+/**
+ * @brief Start giving out keys for the next sector.
+ *
+ * @param[in,out] instance pointer to the instance.
+ * @param[in] data pointer to the card data with the keys found so far.
+ */
+void mf_classic_key_scheduler_start_sector(
+    MfClassicKeyScheduler* instance,
+    const MfClassicData* data);
+
+/**
+ * @brief Get the next key to try on the current sector.
+ *
+ * @param[in,out] instance pointer to the instance.
+ * @param[out] key pointer to the key.
+ * @returns true if a key was given out, false if there are no keys left.
+ */
+bool mf_classic_key_scheduler_get_next_key(MfClassicKeyScheduler* instance, MfClassicKey* key);
+
+/**
+ * @brief Get the number of dictionary keys read on the current sector.
+ *
+ * Skipped keys are counted too, so the number can be compared to the
+ * dictionary size.
+ *
+ * @param[in] instance pointer to the instance.
+ * @returns number of dictionary keys read.
+ */
+size_t mf_classic_key_scheduler_get_dict_keys_read(const MfClassicKeyScheduler* instance);
+
+#ifdef __cplusplus
+}
+#endif
@@ -8,6 +8,8 @@
 #include <furi.h>
 #include <furi_hal_random.h>
 
+#include <inttypes.h>
+
 #define TAG "MfClassicListener"
 
 #define MF_CLASSIC_MAX_BUFF_SIZE (64)
@@ -26,8 +28,174 @@ static void mf_classic_listener_prepare_emulation(MfClassicListener* instance) {
     instance->total_block_num = mf_classic_get_total_block_num(instance->data->type);
 }
 
+// Longest exchange after auth: read command, block response and its last parity bit
+#define MF_CLASSIC_LISTENER_KEYSTREAM_PREFETCH_BITS \
+    ((2 + ISO14443_CRC_SIZE + MF_CLASSIC_LISTENER_RESPONSE_SIZE) * 8 + 1)
+
+static void mf_classic_listener_keystream_reset(MfClassicListener* instance) {
+    instance->keystream.head = 0;
+    instance->keystream.tail = 0;
+}
+
+static void mf_classic_listener_keystream_fill(MfClassicListener* instance, uint8_t bits) {
+    MfClassicListenerKeystream* keystream = &instance->keystream;
+
+    while((uint8_t)(keystream->tail - keystream->head) < bits) {
+        uint8_t mask = 1U << (keystream->tail % 8);
+        if(crypto1_bit(instance->crypto, 0, 0)) {
+            keystream->bits[keystream->tail / 8] |= mask;
+        } else {
+            keystream->bits[keystream->tail / 8] &= ~mask;
+        }
+        keystream->tail++;
+    }
+}
+
+static uint8_t mf_classic_listener_keystream_peek(MfClassicListener* instance) {
+    MfClassicListenerKeystream* keystream = &instance->keystream;
+
+    mf_classic_listener_keystream_fill(instance, 1);
+    return FURI_BIT(keystream->bits[keystream->head / 8], keystream->head % 8);
+}
+
+static uint8_t mf_classic_listener_keystream_bit(MfClassicListener* instance) {
+    uint8_t bit = mf_classic_listener_keystream_peek(instance);
+    instance->keystream.head++;
+    return bit;
+}
+
+static uint8_t mf_classic_listener_keystream_byte(MfClassicListener* instance) {
+    MfClassicListenerKeystream* keystream = &instance->keystream;
+
+    mf_classic_listener_keystream_fill(instance, 8);
+    uint8_t index = keystream->head / 8;
+    uint8_t offset = keystream->head % 8;
+    uint8_t byte = keystream->bits[index] >> offset;
+    if(offset) {
+        index = (index + 1) % sizeof(keystream->bits);
+        byte |= keystream->bits[index] << (8 - offset);
+    }
+    keystream->head += 8;
+
+    return byte;
+}
+
+// Same as crypto1_decrypt, keystream is taken from the ring
+static void mf_classic_listener_decrypt(
+    MfClassicListener* instance,
+    const BitBuffer* buff,
+    BitBuffer* out) {
+    size_t bits = bit_buffer_get_size(buff);
+    bit_buffer_set_size(out, bits);
+    const uint8_t* encrypted_data = bit_buffer_get_data(buff);
+    if(bits < 8) {
+        uint8_t decrypted_byte = 0;
+        for(size_t i = 0; i < 4; i++) {
+            decrypted_byte |=
+                (mf_classic_listener_keystream_bit(instance) ^ FURI_BIT(encrypted_data[0], i))
+                << i;
+        }
+        bit_buffer_set_byte(out, 0, decrypted_byte);
+    } else {
+        for(size_t i = 0; i < bits / 8; i++) {
+            uint8_t decrypted_byte = mf_classic_listener_keystream_byte(instance) ^
+                                     encrypted_data[i];
+            bit_buffer_set_byte(out, i, decrypted_byte);
+        }
+    }
+}
+
+// Same as crypto1_encrypt without keystream input, result goes to tx_encrypted_buffer
+static void
+    mf_classic_listener_encrypt(MfClassicListener* instance, const uint8_t* data, size_t bits) {
+    BitBuffer* out = instance->tx_encrypted_buffer;
+
+    bit_buffer_set_size(out, bits);
+    if(bits < 8) {
+        uint8_t encrypted_byte = 0;
+        for(size_t i = 0; i < bits; i++) {
+            encrypted_byte |= (mf_classic_listener_keystream_bit(instance) ^ FURI_BIT(data[0], i))
+                              << i;
+        }
+        bit_buffer_set_byte(out, 0, encrypted_byte);
+    } else {
+        for(size_t i = 0; i < bits / 8; i++) {
+            uint8_t encrypted_byte = mf_classic_listener_keystream_byte(instance) ^ data[i];
+            bool parity_bit = mf_classic_listener_keystream_peek(instance) ^
+                              nfc_util_odd_parity8(data[i]);
+            bit_buffer_set_byte_with_parity(out, i, encrypted_byte, parity_bit);
+        }
+    }
+}
+
+static void
+    mf_classic_listener_cache_update_block(MfClassicListener* instance, uint8_t block_num) {
+    MfClassicListenerCache* cache = &instance->cache;
+    MfClassicListenerCacheEntry* entry =
+        &cache->block[block_num - mf_classic_get_first_block_num_of_sector(cache->sector_num)];
+    MfClassicKeyType key_type = cache->key_type;
+    MfClassicBlock access_block = instance->data->block[block_num];
+
+    entry->readable = true;
+    if(mf_classic_is_sector_trailer(block_num)) {
+        MfClassicSectorTrailer* access_sec_tr = (MfClassicSectorTrailer*)&access_block;
+        if(!mf_classic_is_allowed_access(
+               instance->data, block_num, key_type, MfClassicActionKeyARead)) {
+            memset(access_sec_tr->key_a.data, 0, sizeof(MfClassicKey));
+        }
+        if(!mf_classic_is_allowed_access(
+               instance->data, block_num, key_type, MfClassicActionKeyBRead)) {
+            memset(access_sec_tr->key_b.data, 0, sizeof(MfClassicKey));
+        }
+        if(!mf_classic_is_allowed_access(
+               instance->data, block_num, key_type, MfClassicActionACRead)) {
+            memset(access_sec_tr->access_bits.data, 0, sizeof(MfClassicAccessBits));
+        }
+    } else if(!mf_classic_is_allowed_access(
+                  instance->data, block_num, key_type, MfClassicActionDataRead)) {
+        entry->readable = false;
+    }
+
+    bit_buffer_copy_bytes(instance->tx_plain_buffer, access_block.data, sizeof(MfClassicBlock));
+    iso14443_crc_append(Iso14443CrcTypeA, instance->tx_plain_buffer);
+    bit_buffer_write_bytes(instance->tx_plain_buffer, entry->data, sizeof(entry->data));
+}
+
+// Access rights of all blocks depend on the sector trailer, so the whole sector is rebuilt
+static void mf_classic_listener_cache_update(MfClassicListener* instance) {
+    MfClassicListenerCache* cache = &instance->cache;
+    MfClassicKeyType key_type = instance->auth_context.key_type;
+    uint8_t sector_num = mf_classic_get_sector_by_block(instance->auth_context.block_num);
+
+    if(cache->valid && (cache->sector_num == sector_num) && (cache->key_type == key_type)) return;
+
+    cache->sector_num = sector_num;
+    cache->key_type = key_type;
+    uint8_t first_block = mf_classic_get_first_block_num_of_sector(sector_num);
+    uint8_t block_num = mf_classic_get_blocks_num_in_sector(sector_num);
+    for(uint8_t i = 0; i < block_num; i++) {
+        mf_classic_listener_cache_update_block(instance, first_block + i);
+    }
+    cache->valid = true;
+}
+
+// Called after the response is sent, prepares everything the next command needs
+static void mf_classic_listener_prepare_next(MfClassicListener* instance) {
+    if(instance->next_nt_used) {
+        furi_hal_random_fill_buf(instance->next_nt.data, sizeof(MfClassicNt));
+        instance->next_nt_used = false;
+    }
+
+    if(instance->state == MfClassicListenerStateAuthComplete) {
+        mf_classic_listener_cache_update(instance);
+        mf_classic_listener_keystream_fill(
+            instance, MF_CLASSIC_LISTENER_KEYSTREAM_PREFETCH_BITS);
+    }
+}
+
 static void mf_classic_listener_reset_state(MfClassicListener* instance) {
     crypto1_reset(instance->crypto);
+    mf_classic_listener_keystream_reset(instance);
     memset(&instance->auth_context, 0, sizeof(MfClassicAuthContext));
     instance->comm_state = MfClassicListenerCommStatePlain;
     instance->state = MfClassicListenerStateIdle;
@@ -74,19 +242,23 @@ static MfClassicListenerCommand mf_classic_listener_auth_first_part_handler(
         instance->auth_context.key_type = key_type;
         instance->auth_context.block_num = block_num;
 
-        furi_hal_random_fill_buf(instance->auth_context.nt.data, sizeof(MfClassicNt));
+        instance->auth_context.nt = instance->next_nt;
+        instance->next_nt_used = true;
         uint32_t nt_num = nfc_util_bytes2num(instance->auth_context.nt.data, sizeof(MfClassicNt));
 
-        crypto1_init(instance->crypto, key_num);
+        mf_classic_listener_keystream_reset(instance);
         if(instance->comm_state == MfClassicListenerCommStatePlain) {
-            crypto1_word(instance->crypto, nt_num ^ cuid, 0);
             bit_buffer_copy_bytes(
                 instance->tx_encrypted_buffer,
                 instance->auth_context.nt.data,
                 sizeof(MfClassicNt));
             iso14443_3a_listener_tx(instance->iso14443_3a_listener, instance->tx_encrypted_buffer);
+            // Plain nonce does not depend on cipher state, so cipher is set up after it is sent
+            crypto1_init(instance->crypto, key_num);
+            crypto1_word(instance->crypto, nt_num ^ cuid, 0);
             command = MfClassicListenerCommandProcessed;
         } else {
+            crypto1_init(instance->crypto, key_num);
             uint8_t key_stream[4] = {};
             nfc_util_num2bytes(nt_num ^ cuid, sizeof(uint32_t), key_stream);
             bit_buffer_copy_bytes(
@@ -155,17 +327,19 @@ static MfClassicListenerCommand
         uint32_t secret_poller = ar_num ^ crypto1_word(instance->crypto, 0, 0);
         if(secret_poller != prng_successor(nt_num, 64)) {
             FURI_LOG_T(
-                TAG, "Wrong reader key: %08lX != %08lX", secret_poller, prng_successor(nt_num, 64));
+                TAG,
+                "Wrong reader key: %08" PRIX32 " != %08" PRIX32,
+                secret_poller,
+                prng_successor(nt_num, 64));
             command = MfClassicListenerCommandSleep;
             break;
         }
 
         uint32_t at_num = prng_successor(nt_num, 96);
         nfc_util_num2bytes(at_num, sizeof(uint32_t), instance->auth_context.at.data);
-        bit_buffer_copy_bytes(
-            instance->tx_plain_buffer, instance->auth_context.at.data, sizeof(MfClassicAr));
-        crypto1_encrypt(
-            instance->crypto, NULL, instance->tx_plain_buffer, instance->tx_encrypted_buffer);
+        // From here on cipher runs without input and its output is taken from the keystream ring
+        mf_classic_listener_encrypt(
+            instance, instance->auth_context.at.data, sizeof(MfClassicAt) * 8);
         iso14443_3a_listener_tx_with_custom_parity(
             instance->iso14443_3a_listener, instance->tx_encrypted_buffer);
 
@@ -196,32 +370,12 @@ static MfClassicListenerCommand
         uint8_t auth_sector_num = mf_classic_get_sector_by_block(auth_ctx->block_num);
         if(sector_num != auth_sector_num) break;
 
-        MfClassicBlock access_block = instance->data->block[block_num];
-
-        if(mf_classic_is_sector_trailer(block_num)) {
-            MfClassicSectorTrailer* access_sec_tr = (MfClassicSectorTrailer*)&access_block;
-            if(!mf_classic_is_allowed_access(
-                   instance->data, block_num, auth_ctx->key_type, MfClassicActionKeyARead)) {
-                memset(access_sec_tr->key_a.data, 0, sizeof(MfClassicKey));
-            }
-            if(!mf_classic_is_allowed_access(
-                   instance->data, block_num, auth_ctx->key_type, MfClassicActionKeyBRead)) {
-                memset(access_sec_tr->key_b.data, 0, sizeof(MfClassicKey));
-            }
-            if(!mf_classic_is_allowed_access(
-                   instance->data, block_num, auth_ctx->key_type, MfClassicActionACRead)) {
-                memset(access_sec_tr->access_bits.data, 0, sizeof(MfClassicAccessBits));
-            }
-        } else if(!mf_classic_is_allowed_access(
-                      instance->data, block_num, auth_ctx->key_type, MfClassicActionDataRead)) {
-            break;
-        }
+        // Cache is filled for the authenticated sector right after auth
+        uint8_t first_block = mf_classic_get_first_block_num_of_sector(sector_num);
+        MfClassicListenerCacheEntry* entry = &instance->cache.block[block_num - first_block];
+        if(!entry->readable) break;
 
-        bit_buffer_copy_bytes(
-            instance->tx_plain_buffer, access_block.data, sizeof(MfClassicBlock));
-        iso14443_crc_append(Iso14443CrcTypeA, instance->tx_plain_buffer);
-        crypto1_encrypt(
-            instance->crypto, NULL, instance->tx_plain_buffer, instance->tx_encrypted_buffer);
+        mf_classic_listener_encrypt(instance, entry->data, sizeof(entry->data) * 8);
         iso14443_3a_listener_tx_with_custom_parity(
             instance->iso14443_3a_listener, instance->tx_encrypted_buffer);
         command = MfClassicListenerCommandProcessed;
@@ -308,6 +462,7 @@ static MfClassicListenerCommand mf_classic_listener_write_block_second_part_hand
         }
 
         instance->data->block[block_num] = block;
+        instance->cache.valid = false;
         command = MfClassicListenerCommandAck;
     } while(false);
 
@@ -425,6 +580,7 @@ static MfClassicListenerCommand
 
         mf_classic_value_to_block(
             instance->transfer_value, block_num, &instance->data->block[block_num]);
+        instance->cache.valid = false;
         instance->transfer_value = 0;
         instance->transfer_valid = false;
 
@@ -539,8 +695,7 @@ static void mf_classic_listener_send_short_frame(MfClassicListener* instance, ui
     bit_buffer_set_size(instance->tx_plain_buffer, 4);
     bit_buffer_set_byte(instance->tx_plain_buffer, 0, data);
     if(instance->comm_state == MfClassicListenerCommStateEncrypted) {
-        crypto1_encrypt(
-            instance->crypto, NULL, instance->tx_plain_buffer, instance->tx_encrypted_buffer);
+        mf_classic_listener_encrypt(instance, &data, 4);
         tx_buffer = instance->tx_encrypted_buffer;
     }
 
@@ -565,8 +720,8 @@ NfcCommand mf_classic_listener_run(NfcGenericEvent event, void* context) {
         (iso3_event->type == Iso14443_3aListenerEventTypeReceivedStandardFrame)) {
         if(instance->comm_state == MfClassicListenerCommStateEncrypted) {
             if(instance->state == MfClassicListenerStateAuthComplete) {
-                crypto1_decrypt(
-                    instance->crypto, iso3_event->data->buffer, instance->rx_plain_buffer);
+                mf_classic_listener_decrypt(
+                    instance, iso3_event->data->buffer, instance->rx_plain_buffer);
                 rx_buffer_plain = instance->rx_plain_buffer;
                 if(iso14443_crc_check(Iso14443CrcTypeA, rx_buffer_plain)) {
                     iso14443_crc_trim(rx_buffer_plain);
@@ -619,6 +774,8 @@ NfcCommand mf_classic_listener_run(NfcGenericEvent event, void* context) {
             mf_classic_listener_reset_state(instance);
             command = NfcCommandSleep;
         }
+
+        mf_classic_listener_prepare_next(instance);
     } else if(iso3_event->type == Iso14443_3aListenerEventTypeHalted) {
         mf_classic_listener_reset_state(instance);
     }
@@ -637,6 +794,7 @@ MfClassicListener*
     instance->tx_plain_buffer = bit_buffer_alloc(MF_CLASSIC_MAX_BUFF_SIZE);
     instance->tx_encrypted_buffer = bit_buffer_alloc(MF_CLASSIC_MAX_BUFF_SIZE);
     instance->rx_plain_buffer = bit_buffer_alloc(MF_CLASSIC_MAX_BUFF_SIZE);
+    furi_hal_random_fill_buf(instance->next_nt.data, sizeof(MfClassicNt));
 
     instance->mfc_event.data = &instance->mfc_event_data;
     instance->generic_event.protocol = NfcProtocolMfClassic;
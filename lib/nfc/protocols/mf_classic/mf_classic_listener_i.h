@@ -27,6 +27,31 @@ typedef enum {
     MfClassicListenerCommStateEncrypted,
 } MfClassicListenerCommState;
 
+// Keystream ring size is fixed by uint8_t head and tail counters wrapping around
+#define MF_CLASSIC_LISTENER_KEYSTREAM_BITS (256)
+#define MF_CLASSIC_LISTENER_CACHE_BLOCKS (16)
+#define MF_CLASSIC_LISTENER_RESPONSE_SIZE (MF_CLASSIC_BLOCK_SIZE + 2)
+
+/** Cipher output generated ahead of time, valid while cipher runs without input */
+typedef struct {
+    uint8_t bits[MF_CLASSIC_LISTENER_KEYSTREAM_BITS / 8];
+    uint8_t head;
+    uint8_t tail;
+} MfClassicListenerKeystream;
+
+typedef struct {
+    bool readable;
+    uint8_t data[MF_CLASSIC_LISTENER_RESPONSE_SIZE];
+} MfClassicListenerCacheEntry;
+
+/** Read responses of authenticated sector: access filtered block with CRC */
+typedef struct {
+    bool valid;
+    uint8_t sector_num;
+    MfClassicKeyType key_type;
+    MfClassicListenerCacheEntry block[MF_CLASSIC_LISTENER_CACHE_BLOCKS];
+} MfClassicListenerCache;
+
 struct MfClassicListener {
     Iso14443_3aListener* iso14443_3a_listener;
     MfClassicListenerState state;
@@ -39,6 +64,11 @@ struct MfClassicListener {
 
     Crypto1* crypto;
     MfClassicAuthContext auth_context;
+    MfClassicNt next_nt;
+    bool next_nt_used;
+
+    MfClassicListenerKeystream keystream;
+    MfClassicListenerCache cache;
 
     // Write block context
     uint8_t write_block;
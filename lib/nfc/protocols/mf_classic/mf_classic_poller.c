@@ -4,6 +4,8 @@
 
 #include <furi.h>
 
+#include <inttypes.h>
+
 #define TAG "MfClassicPoller"
 
 #define MF_CLASSIC_MAX_BUFF_SIZE (64)
@@ -459,7 +461,7 @@ NfcCommand mf_classic_poller_handler_request_read_sector_blocks(MfClassicPoller*
             uint64_t key = nfc_util_bytes2num(sec_read_ctx->key.data, sizeof(MfClassicKey));
             FURI_LOG_D(
                 TAG,
-                "Auth to block %d with key %c: %06llx",
+                "Auth to block %d with key %c: %06" PRIx64,
                 sec_read_ctx->current_block,
                 sec_read_ctx->key_type == MfClassicKeyTypeA ? 'A' : 'B',
                 key);
@@ -531,7 +533,7 @@ NfcCommand mf_classic_poller_handler_auth_a(MfClassicPoller* instance) {
     } else {
         uint8_t block = mf_classic_get_first_block_num_of_sector(dict_attack_ctx->current_sector);
         uint64_t key = nfc_util_bytes2num(dict_attack_ctx->current_key.data, sizeof(MfClassicKey));
-        FURI_LOG_D(TAG, "Auth to block %d with key A: %06llx", block, key);
+        FURI_LOG_D(TAG, "Auth to block %d with key A: %06" PRIx64, block, key);
 
         MfClassicError error = mf_classic_poller_auth(
             instance, block, &dict_attack_ctx->current_key, MfClassicKeyTypeA, NULL);
@@ -569,7 +571,7 @@ NfcCommand mf_classic_poller_handler_auth_b(MfClassicPoller* instance) {
     } else {
         uint8_t block = mf_classic_get_first_block_num_of_sector(dict_attack_ctx->current_sector);
         uint64_t key = nfc_util_bytes2num(dict_attack_ctx->current_key.data, sizeof(MfClassicKey));
-        FURI_LOG_D(TAG, "Auth to block %d with key B: %06llx", block, key);
+        FURI_LOG_D(TAG, "Auth to block %d with key B: %06" PRIx64, block, key);
 
         MfClassicError error = mf_classic_poller_auth(
             instance, block, &dict_attack_ctx->current_key, MfClassicKeyTypeB, NULL);
@@ -712,7 +714,7 @@ NfcCommand mf_classic_poller_handler_key_reuse_auth_key_a(MfClassicPoller* insta
         uint8_t block =
             mf_classic_get_first_block_num_of_sector(dict_attack_ctx->reuse_key_sector);
         uint64_t key = nfc_util_bytes2num(dict_attack_ctx->current_key.data, sizeof(MfClassicKey));
-        FURI_LOG_D(TAG, "Key attack auth to block %d with key A: %06llx", block, key);
+        FURI_LOG_D(TAG, "Key attack auth to block %d with key A: %06" PRIx64, block, key);
 
         MfClassicError error = mf_classic_poller_auth(
             instance, block, &dict_attack_ctx->current_key, MfClassicKeyTypeA, NULL);
@@ -747,7 +749,7 @@ NfcCommand mf_classic_poller_handler_key_reuse_auth_key_b(MfClassicPoller* insta
         uint8_t block =
             mf_classic_get_first_block_num_of_sector(dict_attack_ctx->reuse_key_sector);
         uint64_t key = nfc_util_bytes2num(dict_attack_ctx->current_key.data, sizeof(MfClassicKey));
-        FURI_LOG_D(TAG, "Key attack auth to block %d with key B: %06llx", block, key);
+        FURI_LOG_D(TAG, "Key attack auth to block %d with key B: %06" PRIx64, block, key);
 
         MfClassicError error = mf_classic_poller_auth(
             instance, block, &dict_attack_ctx->current_key, MfClassicKeyTypeB, NULL);
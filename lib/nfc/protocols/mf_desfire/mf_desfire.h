@@ -23,6 +23,8 @@ extern "C" {
 
 #define MF_DESFIRE_FLAG_HAS_NEXT (0xAF)
 
+#define MF_DESFIRE_ACCESS_FREE (0x0E)
+
 #define MF_DESFIRE_MAX_KEYS (14)
 #define MF_DESFIRE_MAX_FILES (32)
 
@@ -1,4 +1,5 @@
 #include "mf_desfire_i.h"
+#include <inttypes.h>
 
 #define BITS_IN_BYTE (8U)
 
@@ -337,7 +338,7 @@ bool mf_desfire_key_version_load(
     uint32_t index,
     FlipperFormat* ff) {
     FuriString* key = furi_string_alloc_printf(
-        "%s %s %lu %s",
+        "%s %s %" PRIu32 " %s",
         prefix,
         MF_DESFIRE_FFF_KEY_SUB_PREFIX,
         index,
@@ -584,7 +585,7 @@ bool mf_desfire_key_version_save(
     uint32_t index,
     FlipperFormat* ff) {
     FuriString* key = furi_string_alloc_printf(
-        "%s %s %lu %s",
+        "%s %s %" PRIu32 " %s",
         prefix,
         MF_DESFIRE_FFF_KEY_SUB_PREFIX,
         index,
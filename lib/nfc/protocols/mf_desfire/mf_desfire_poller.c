@@ -7,6 +7,10 @@
 #define TAG "MfDesfirePoller"
 
 #define MF_DESFIRE_BUF_SIZE (64U)
+// Until the card is activated: FSC of 64 bytes, as DESFire cards announce
+#define MF_DESFIRE_RX_BUF_SIZE (64U)
+// FSD the ISO14443-4A poller asks for in RATS, cards send no bigger frames
+#define MF_DESFIRE_RX_BUF_SIZE_MAX (256U)
 #define MF_DESFIRE_RESULT_BUF_SIZE (512U)
 
 typedef NfcCommand (*MfDesfirePollerReadHandler)(MfDesfirePoller* instance);
@@ -22,7 +26,7 @@ static MfDesfirePoller* mf_desfire_poller_alloc(Iso14443_4aPoller* iso14443_4a_p
     instance->iso14443_4a_poller = iso14443_4a_poller;
     instance->data = mf_desfire_alloc();
     instance->tx_buffer = bit_buffer_alloc(MF_DESFIRE_BUF_SIZE);
-    instance->rx_buffer = bit_buffer_alloc(MF_DESFIRE_BUF_SIZE);
+    instance->rx_buffer = bit_buffer_alloc(MF_DESFIRE_RX_BUF_SIZE);
     instance->input_buffer = bit_buffer_alloc(MF_DESFIRE_BUF_SIZE);
     instance->result_buffer = bit_buffer_alloc(MF_DESFIRE_RESULT_BUF_SIZE);
 
@@ -46,16 +50,31 @@ static void mf_desfire_poller_free(MfDesfirePoller* instance) {
     free(instance);
 }
 
+// One response frame: DESFire cards answer with frames of their own FSC
+static void mf_desfire_poller_alloc_rx_buffer(MfDesfirePoller* instance) {
+    size_t rx_buffer_size = iso14443_4a_get_frame_size_max(instance->data->iso14443_4a_data);
+    if(rx_buffer_size == 0 || rx_buffer_size > MF_DESFIRE_RX_BUF_SIZE_MAX) {
+        rx_buffer_size = MF_DESFIRE_RX_BUF_SIZE_MAX;
+    }
+
+    if(bit_buffer_get_capacity_bytes(instance->rx_buffer) != rx_buffer_size) {
+        bit_buffer_free(instance->rx_buffer);
+        instance->rx_buffer = bit_buffer_alloc(rx_buffer_size);
+    }
+}
+
 static NfcCommand mf_desfire_poller_handler_idle(MfDesfirePoller* instance) {
     bit_buffer_reset(instance->input_buffer);
     bit_buffer_reset(instance->result_buffer);
     bit_buffer_reset(instance->tx_buffer);
-    bit_buffer_reset(instance->rx_buffer);
 
     iso14443_4a_copy(
         instance->data->iso14443_4a_data,
         iso14443_4a_poller_get_data(instance->iso14443_4a_poller));
 
+    mf_desfire_poller_alloc_rx_buffer(instance);
+    bit_buffer_reset(instance->rx_buffer);
+
     instance->state = MfDesfirePollerStateReadVersion;
     return NfcCommandContinue;
 }
@@ -153,6 +172,7 @@ static NfcCommand mf_desfire_poller_handler_read_applications(MfDesfirePoller* i
 static NfcCommand mf_desfire_poller_handler_read_fail(MfDesfirePoller* instance) {
     FURI_LOG_D(TAG, "Read Failed");
     iso14443_4a_poller_halt(instance->iso14443_4a_poller);
+    instance->mf_desfire_event.type = MfDesfirePollerEventTypeReadFailed;
     instance->mf_desfire_event.data->error = instance->error;
     NfcCommand command = instance->callback(instance->general_event, instance->context);
     instance->state = MfDesfirePollerStateIdle;
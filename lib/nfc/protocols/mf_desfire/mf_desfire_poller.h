@@ -228,6 +228,9 @@ MfDesfireError mf_desfire_poller_read_file_records(
 /**
  * @brief Read data from multiple files on MfDesfire card.
  *
+ * The reads are planned from the file settings first: files that can not be read
+ * without authentication or hold no data are skipped and their data is left empty.
+ *
  * Must ONLY be used inside the callback function.
  *
  * @param[in, out] instance pointer to the instance to be used in the transaction.
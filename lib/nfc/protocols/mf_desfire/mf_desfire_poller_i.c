@@ -40,6 +40,11 @@ MfDesfireError mf_desfire_send_chunks(
             error = mf_desfire_process_error(iso14443_4a_error);
             break;
         }
+        // Every frame starts with a status byte
+        if(bit_buffer_get_size_bytes(instance->rx_buffer) == 0) {
+            error = MfDesfireErrorProtocol;
+            break;
+        }
 
         bit_buffer_reset(instance->tx_buffer);
         bit_buffer_append_byte(instance->tx_buffer, MF_DESFIRE_FLAG_HAS_NEXT);
@@ -58,8 +63,14 @@ MfDesfireError mf_desfire_send_chunks(
                 error = mf_desfire_process_error(iso14443_4a_error);
                 break;
             }
+            if(bit_buffer_get_size_bytes(instance->rx_buffer) == 0) {
+                error = MfDesfireErrorProtocol;
+                break;
+            }
 
-            const size_t rx_size = bit_buffer_get_size_bytes(instance->rx_buffer);
+            // Status byte is not stored
+            const size_t rx_size =
+                bit_buffer_get_size_bytes(instance->rx_buffer) - sizeof(uint8_t);
             const size_t rx_capacity_remaining =
                 bit_buffer_get_capacity_bytes(rx_buffer) - bit_buffer_get_size_bytes(rx_buffer);
 
@@ -377,6 +388,158 @@ MfDesfireError mf_desfire_poller_read_file_records(
     return error;
 }
 
+static bool mf_desfire_poller_is_access_free(MfDesfireFileAccessRights rights, bool value) {
+    const uint8_t read_key = (rights >> 12) & 0x0F;
+    const uint8_t write_key = (rights >> 8) & 0x0F;
+    const uint8_t read_write_key = (rights >> 4) & 0x0F;
+
+    // GetValue is also allowed with write access, reading data and records is not
+    return read_key == MF_DESFIRE_ACCESS_FREE || read_write_key == MF_DESFIRE_ACCESS_FREE ||
+           (value && write_key == MF_DESFIRE_ACCESS_FREE);
+}
+
+static void mf_desfire_poller_plan_file_reads(
+    MfDesfirePollerReadPlan* plan,
+    const SimpleArray* file_ids,
+    const SimpleArray* file_settings) {
+    plan->step_count = 0;
+    plan->skipped_count = 0;
+
+    const uint32_t file_id_count = simple_array_get_count(file_ids);
+
+    for(uint32_t i = 0; i < file_id_count; ++i) {
+        const MfDesfireFileSettings* settings = simple_array_cget(file_settings, i);
+
+        MfDesfirePollerReadStep step = {
+            .id = *(const MfDesfireFileId*)simple_array_cget(file_ids, i),
+            .index = i,
+        };
+
+        if(settings->type == MfDesfireFileTypeStandard ||
+           settings->type == MfDesfireFileTypeBackup) {
+            step.type = MfDesfirePollerReadStepTypeData;
+            step.size = settings->data.size;
+        } else if(settings->type == MfDesfireFileTypeValue) {
+            step.type = MfDesfirePollerReadStepTypeValue;
+            step.size = MF_DESFIRE_VALUE_SIZE;
+        } else if(
+            settings->type == MfDesfireFileTypeLinearRecord ||
+            settings->type == MfDesfireFileTypeCyclicRecord) {
+            step.type = MfDesfirePollerReadStepTypeRecords;
+            step.size = (settings->record.size != 0) ? settings->record.cur : 0;
+            step.record_size = settings->record.size;
+        } else {
+            continue;
+        }
+
+        const bool is_value = (step.type == MfDesfirePollerReadStepTypeValue);
+
+        if(!mf_desfire_poller_is_access_free(settings->access_rights, is_value) ||
+           step.size == 0 || plan->step_count >= COUNT_OF(plan->steps)) {
+            plan->skipped_count++;
+        } else {
+            plan->steps[plan->step_count++] = step;
+        }
+    }
+}
+
+static MfDesfireError mf_desfire_poller_read_file_data_segmented(
+    MfDesfirePoller* instance,
+    MfDesfireFileId id,
+    size_t size,
+    MfDesfireFileData* data) {
+    // The whole answer to each ReadData command must fit into the result buffer
+    const size_t segment_size_max = bit_buffer_get_capacity_bytes(instance->result_buffer);
+
+    if(size <= segment_size_max) {
+        return mf_desfire_poller_read_file_data(instance, id, 0, size, data);
+    }
+
+    simple_array_init(data->data, size);
+    uint8_t* file_data = simple_array_get_data(data->data);
+
+    MfDesfireError error = MfDesfireErrorNone;
+
+    for(size_t offset = 0; offset < size;) {
+        const size_t segment_size = MIN(size - offset, segment_size_max);
+
+        bit_buffer_reset(instance->input_buffer);
+        bit_buffer_append_byte(instance->input_buffer, MF_DESFIRE_CMD_READ_DATA);
+        bit_buffer_append_byte(instance->input_buffer, id);
+        bit_buffer_append_bytes(instance->input_buffer, (const uint8_t*)&offset, 3);
+        bit_buffer_append_bytes(instance->input_buffer, (const uint8_t*)&segment_size, 3);
+
+        error = mf_desfire_send_chunks(instance, instance->input_buffer, instance->result_buffer);
+        if(error != MfDesfireErrorNone) break;
+
+        if(bit_buffer_get_size_bytes(instance->result_buffer) != segment_size) {
+            // Access denied or the file changed under us, keep no partial data
+            simple_array_reset(data->data);
+            break;
+        }
+
+        bit_buffer_write_bytes(instance->result_buffer, &file_data[offset], segment_size);
+        offset += segment_size;
+    }
+
+    return error;
+}
+
+static MfDesfireError mf_desfire_poller_read_file_records_segmented(
+    MfDesfirePoller* instance,
+    MfDesfireFileId id,
+    size_t record_count,
+    size_t record_size,
+    MfDesfireFileData* data) {
+    // Same limit as for ReadData, but segments hold whole records only
+    const size_t segment_record_count_max =
+        bit_buffer_get_capacity_bytes(instance->result_buffer) / record_size;
+
+    if(record_count <= segment_record_count_max) {
+        return mf_desfire_poller_read_file_records(instance, id, 0, record_count, data);
+    }
+
+    if(segment_record_count_max == 0) {
+        // A single record does not fit, keep no data as for files denying access
+        FURI_LOG_W(TAG, "File %u: record size %zu is too big", id, record_size);
+        simple_array_reset(data->data);
+        return MfDesfireErrorNone;
+    }
+
+    simple_array_init(data->data, record_count * record_size);
+    uint8_t* file_data = simple_array_get_data(data->data);
+
+    MfDesfireError error = MfDesfireErrorNone;
+
+    // Record offset counts back from the newest record, records come oldest first
+    for(size_t offset = 0; offset < record_count;) {
+        const size_t segment_record_count = MIN(record_count - offset, segment_record_count_max);
+        const size_t segment_size = segment_record_count * record_size;
+
+        bit_buffer_reset(instance->input_buffer);
+        bit_buffer_append_byte(instance->input_buffer, MF_DESFIRE_CMD_READ_RECORDS);
+        bit_buffer_append_byte(instance->input_buffer, id);
+        bit_buffer_append_bytes(instance->input_buffer, (const uint8_t*)&offset, 3);
+        bit_buffer_append_bytes(instance->input_buffer, (const uint8_t*)&segment_record_count, 3);
+
+        error = mf_desfire_send_chunks(instance, instance->input_buffer, instance->result_buffer);
+        if(error != MfDesfireErrorNone) break;
+
+        if(bit_buffer_get_size_bytes(instance->result_buffer) != segment_size) {
+            // Access denied or records added under us, keep no partial data
+            simple_array_reset(data->data);
+            break;
+        }
+
+        const size_t segment_start = record_count - offset - segment_record_count;
+        bit_buffer_write_bytes(
+            instance->result_buffer, &file_data[segment_start * record_size], segment_size);
+        offset += segment_record_count;
+    }
+
+    return error;
+}
+
 MfDesfireError mf_desfire_poller_read_file_data_multi(
     MfDesfirePoller* instance,
     const SimpleArray* file_ids,
@@ -392,23 +555,23 @@ MfDesfireError mf_desfire_poller_read_file_data_multi(
         simple_array_init(data, file_id_count);
     }
 
-    for(uint32_t i = 0; i < file_id_count; ++i) {
-        const MfDesfireFileId file_id = *(const MfDesfireFileId*)simple_array_cget(file_ids, i);
-        const MfDesfireFileSettings* file_settings_cur = simple_array_cget(file_settings, i);
-        const MfDesfireFileType file_type = file_settings_cur->type;
+    MfDesfirePollerReadPlan* plan = &instance->read_plan;
+    mf_desfire_poller_plan_file_reads(plan, file_ids, file_settings);
 
-        MfDesfireFileData* file_data = simple_array_get(data, i);
+    FURI_LOG_D(TAG, "Planned %zu file reads, %zu skipped", plan->step_count, plan->skipped_count);
 
-        if(file_type == MfDesfireFileTypeStandard || file_type == MfDesfireFileTypeBackup) {
-            error = mf_desfire_poller_read_file_data(
-                instance, file_id, 0, file_settings_cur->data.size, file_data);
-        } else if(file_type == MfDesfireFileTypeValue) {
-            error = mf_desfire_poller_read_file_value(instance, file_id, file_data);
-        } else if(
-            file_type == MfDesfireFileTypeLinearRecord ||
-            file_type == MfDesfireFileTypeCyclicRecord) {
-            error = mf_desfire_poller_read_file_records(
-                instance, file_id, 0, file_settings_cur->data.size, file_data);
+    for(size_t i = 0; i < plan->step_count; ++i) {
+        const MfDesfirePollerReadStep* step = &plan->steps[i];
+        MfDesfireFileData* file_data = simple_array_get(data, step->index);
+
+        if(step->type == MfDesfirePollerReadStepTypeData) {
+            error = mf_desfire_poller_read_file_data_segmented(
+                instance, step->id, step->size, file_data);
+        } else if(step->type == MfDesfirePollerReadStepTypeValue) {
+            error = mf_desfire_poller_read_file_value(instance, step->id, file_data);
+        } else {
+            error = mf_desfire_poller_read_file_records_segmented(
+                instance, step->id, step->size, step->record_size, file_data);
         }
 
         if(error != MfDesfireErrorNone) break;
@@ -22,6 +22,27 @@ typedef enum {
     MfDesfirePollerStateNum,
 } MfDesfirePollerState;
 
+typedef enum {
+    MfDesfirePollerReadStepTypeData,
+    MfDesfirePollerReadStepTypeValue,
+    MfDesfirePollerReadStepTypeRecords,
+} MfDesfirePollerReadStepType;
+
+// One planned file read, files denying free access or holding no data are not planned
+typedef struct {
+    MfDesfirePollerReadStepType type;
+    MfDesfireFileId id;
+    uint8_t index; // Index of the file in application data
+    uint32_t size; // Data size in bytes or record count
+    uint32_t record_size; // Record size in bytes, record files only
+} MfDesfirePollerReadStep;
+
+typedef struct {
+    MfDesfirePollerReadStep steps[MF_DESFIRE_MAX_FILES];
+    size_t step_count;
+    size_t skipped_count;
+} MfDesfirePollerReadPlan;
+
 typedef enum {
     MfDesfirePollerSessionStateIdle,
     MfDesfirePollerSessionStateActive,
@@ -38,6 +59,7 @@ struct MfDesfirePoller {
     BitBuffer* rx_buffer;
     BitBuffer* input_buffer;
     BitBuffer* result_buffer;
+    MfDesfirePollerReadPlan read_plan;
     MfDesfirePollerEventData mf_desfire_event_data;
     MfDesfirePollerEvent mf_desfire_event;
     NfcGenericEvent general_event;
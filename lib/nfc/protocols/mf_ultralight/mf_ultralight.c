@@ -279,13 +279,13 @@ bool mf_ultralight_load(MfUltralightData* data, FlipperFormat* ff, uint32_t vers
         // Read counters and tearing flags
         bool counters_parsed = true;
         for(size_t i = 0; i < 3; i++) {
-            furi_string_printf(temp_str, "%s %d", MF_ULTRALIGHT_COUNTER_KEY, i);
+            furi_string_printf(temp_str, "%s %zu", MF_ULTRALIGHT_COUNTER_KEY, i);
             if(!flipper_format_read_uint32(
                    ff, furi_string_get_cstr(temp_str), &data->counter[i].counter, 1)) {
                 counters_parsed = false;
                 break;
             }
-            furi_string_printf(temp_str, "%s %d", MF_ULTRALIGHT_TEARING_KEY, i);
+            furi_string_printf(temp_str, "%s %zu", MF_ULTRALIGHT_TEARING_KEY, i);
             if(!flipper_format_read_hex(
                    ff, furi_string_get_cstr(temp_str), &data->tearing_flag[i].data, 1)) {
                 counters_parsed = false;
@@ -311,7 +311,7 @@ bool mf_ultralight_load(MfUltralightData* data, FlipperFormat* ff, uint32_t vers
 
         bool pages_parsed = true;
         for(size_t i = 0; i < pages_total; i++) {
-            furi_string_printf(temp_str, "%s %d", MF_ULTRALIGHT_PAGE_KEY, i);
+            furi_string_printf(temp_str, "%s %zu", MF_ULTRALIGHT_PAGE_KEY, i);
             if(!flipper_format_read_hex(
                    ff,
                    furi_string_get_cstr(temp_str),
@@ -371,13 +371,13 @@ bool mf_ultralight_save(const MfUltralightData* data, FlipperFormat* ff) {
         // Write conters and tearing flags data
         bool counters_saved = true;
         for(size_t i = 0; i < 3; i++) {
-            furi_string_printf(temp_str, "%s %d", MF_ULTRALIGHT_COUNTER_KEY, i);
+            furi_string_printf(temp_str, "%s %zu", MF_ULTRALIGHT_COUNTER_KEY, i);
             if(!flipper_format_write_uint32(
                    ff, furi_string_get_cstr(temp_str), &data->counter[i].counter, 1)) {
                 counters_saved = false;
                 break;
             }
-            furi_string_printf(temp_str, "%s %d", MF_ULTRALIGHT_TEARING_KEY, i);
+            furi_string_printf(temp_str, "%s %zu", MF_ULTRALIGHT_TEARING_KEY, i);
             if(!flipper_format_write_hex(
                    ff, furi_string_get_cstr(temp_str), &data->tearing_flag[i].data, 1)) {
                 counters_saved = false;
@@ -393,7 +393,7 @@ bool mf_ultralight_save(const MfUltralightData* data, FlipperFormat* ff) {
         if(!flipper_format_write_uint32(ff, MF_ULTRALIGHT_PAGES_READ_KEY, &pages_read, 1)) break;
         bool pages_saved = true;
         for(size_t i = 0; i < data->pages_total; i++) {
-            furi_string_printf(temp_str, "%s %d", MF_ULTRALIGHT_PAGE_KEY, i);
+            furi_string_printf(temp_str, "%s %zu", MF_ULTRALIGHT_PAGE_KEY, i);
             if(!flipper_format_write_hex(
                    ff,
                    furi_string_get_cstr(temp_str),
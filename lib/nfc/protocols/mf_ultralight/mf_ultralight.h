@@ -30,6 +30,8 @@ extern "C" {
 #define MF_ULTRALIGHT_MAX_CNTR_VAL (0x00FFFFFF)
 #define MF_ULTRALIGHT_MAX_PAGE_NUM (510)
 #define MF_ULTRALIGHT_PAGE_SIZE (4U)
+// FAST_READ response with CRC must fit 256 bytes NFC transfer buffer
+#define MF_ULTRALIGHT_FAST_READ_PAGES_MAX (63U)
 #define MF_ULTRALIGHT_SIGNATURE_SIZE (32)
 #define MF_ULTRALIGHT_COUNTER_SIZE (3)
 #define MF_ULTRALIGHT_COUNTER_NUM (3)
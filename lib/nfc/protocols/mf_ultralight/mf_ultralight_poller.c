@@ -4,6 +4,8 @@
 
 #include <furi.h>
 
+#include <inttypes.h>
+
 #define TAG "MfUltralightPoller"
 
 typedef NfcCommand (*MfUltralightPollerReadHandler)(MfUltralightPoller* instance);
@@ -226,6 +228,8 @@ static NfcCommand mf_ultralight_poller_handler_idle(MfUltralightPoller* instance
     instance->pages_read = 0;
     instance->state = MfUltralightPollerStateRequestMode;
     instance->current_page = 0;
+    instance->fast_read_fallback_end = 0;
+    instance->reauth_required = false;
     return NfcCommandContinue;
 }
 
@@ -419,7 +423,7 @@ static NfcCommand mf_ultralight_poller_handler_auth(MfUltralightPoller* instance
             instance->auth_context.password = instance->mfu_event.data->auth_context.password;
             uint32_t pass = nfc_util_bytes2num(
                 instance->auth_context.password.data, sizeof(MfUltralightAuthPassword));
-            FURI_LOG_D(TAG, "Trying to authenticate with password %08lX", pass);
+            FURI_LOG_D(TAG, "Trying to authenticate with password %08" PRIX32, pass);
             instance->error = mf_ultralight_poller_auth_pwd(instance, &instance->auth_context);
             if(instance->error == MfUltralightErrorNone) {
                 FURI_LOG_D(TAG, "Auth success");
@@ -441,7 +445,44 @@ static NfcCommand mf_ultralight_poller_handler_auth(MfUltralightPoller* instance
     return command;
 }
 
-static NfcCommand mf_ultralight_poller_handler_read_pages(MfUltralightPoller* instance) {
+static void mf_ultralight_poller_read_pages_fast(MfUltralightPoller* instance) {
+    uint16_t start_page = instance->pages_read;
+    uint16_t pages_count =
+        MIN(instance->pages_total - start_page, (uint16_t)MF_ULTRALIGHT_FAST_READ_PAGES_MAX);
+    uint8_t tag = start_page;
+
+    do {
+        if(MF_ULTRALIGHT_IS_NTAG_I2C(instance->data->type)) {
+            uint8_t sector = 0;
+            uint8_t pages_left = 0;
+            if(!mf_ultralight_poller_ntag_i2c_addr_lin_to_tag(
+                   instance, start_page, &sector, &tag, &pages_left)) {
+                FURI_LOG_D(TAG, "Failed to calculate sector and tag from %d page", start_page);
+                instance->error = MfUltralightErrorProtocol;
+                break;
+            }
+            // Fast read can't cross sector or register boundary
+            pages_count = MIN(pages_count, (uint16_t)pages_left);
+            instance->error = mf_ultralight_poller_select_sector(instance, sector);
+            if(instance->error != MfUltralightErrorNone) break;
+        }
+
+        instance->error = mf_ultralight_poller_fast_read_pages(
+            instance, tag, tag + pages_count - 1, &instance->data->page[start_page]);
+    } while(false);
+
+    if(instance->error == MfUltralightErrorNone) {
+        FURI_LOG_D(TAG, "Fast read pages %d-%d success", start_page, start_page + pages_count - 1);
+        instance->pages_read += pages_count;
+        instance->data->pages_read = instance->pages_read;
+    } else {
+        // Next call reads this range with READ, which stops at the first unreadable page
+        FURI_LOG_D(TAG, "Fast read pages %d-%d failed", start_page, start_page + pages_count - 1);
+        instance->fast_read_fallback_end = start_page + pages_count;
+    }
+}
+
+static void mf_ultralight_poller_read_pages_single(MfUltralightPoller* instance) {
     MfUltralightPageReadCommandData data = {};
     uint16_t start_page = instance->pages_read;
     if(MF_ULTRALIGHT_IS_NTAG_I2C(instance->data->type)) {
@@ -463,12 +504,38 @@ static NfcCommand mf_ultralight_poller_handler_read_pages(MfUltralightPoller* in
     if(instance->error == MfUltralightErrorNone) {
         for(size_t i = 0; i < 4; i++) {
             if(start_page + i < instance->pages_total) {
-                FURI_LOG_D(TAG, "Read page %d success", start_page + i);
+                FURI_LOG_D(TAG, "Read page %zu success", start_page + i);
                 instance->data->page[start_page + i] = data.page[i];
                 instance->pages_read++;
                 instance->data->pages_read = instance->pages_read;
             }
         }
+    }
+}
+
+static NfcCommand mf_ultralight_poller_handler_read_pages(MfUltralightPoller* instance) {
+    if(instance->reauth_required) {
+        instance->reauth_required = false;
+        FURI_LOG_D(TAG, "Restoring authentication after reset");
+        instance->error = mf_ultralight_poller_auth_pwd(instance, &instance->auth_context);
+        if(instance->error != MfUltralightErrorNone) {
+            FURI_LOG_D(TAG, "Auth failed");
+        }
+    }
+
+    if(mf_ultralight_support_feature(instance->feature_set, MfUltralightFeatureSupportFastRead) &&
+       (instance->pages_read >= instance->fast_read_fallback_end)) {
+        mf_ultralight_poller_read_pages_fast(instance);
+        if(instance->error != MfUltralightErrorNone) {
+            // NAK puts card to IDLE state, reset field to activate it again
+            instance->reauth_required = instance->auth_context.auth_success;
+            return NfcCommandReset;
+        }
+    } else {
+        mf_ultralight_poller_read_pages_single(instance);
+    }
+
+    if(instance->error == MfUltralightErrorNone) {
         if(instance->pages_read == instance->pages_total) {
             instance->state = MfUltralightPollerStateReadCounters;
         }
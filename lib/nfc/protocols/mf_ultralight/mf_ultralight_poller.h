@@ -110,6 +110,27 @@ MfUltralightError mf_ultralight_poller_read_page(
     uint8_t start_page,
     MfUltralightPageReadCommandData* data);
 
+/**
+ * @brief Read range of pages from card.
+ *
+ * Must ONLY be used inside the callback function.
+ *
+ * Send fast read command and parse response. The response on this command is data of all pages
+ * from start_page to end_page inclusive. Card NAKs the whole command if any page in the range is
+ * not readable. For NTAGI2C tags the range must be within the currently selected sector.
+ *
+ * @param[in, out] instance pointer to the instance to be used in the transaction.
+ * @param[in] start_page first page number to be read.
+ * @param[in] end_page last page number to be read, range is MF_ULTRALIGHT_FAST_READ_PAGES_MAX max.
+ * @param[out] data pointer to the array of MfUltralightPage to be filled with page data.
+ * @return MfUltralightErrorNone on success, an error code on failure.
+ */
+MfUltralightError mf_ultralight_poller_fast_read_pages(
+    MfUltralightPoller* instance,
+    uint8_t start_page,
+    uint8_t end_page,
+    MfUltralightPage* data);
+
 /**
  * @brief Read page from sector.
  *
@@ -86,11 +86,8 @@ MfUltralightError mf_ultralight_poller_authenticate(MfUltralightPoller* instance
     return ret;
 }
 
-MfUltralightError mf_ultralight_poller_read_page_from_sector(
-    MfUltralightPoller* instance,
-    uint8_t sector,
-    uint8_t tag,
-    MfUltralightPageReadCommandData* data) {
+MfUltralightError
+    mf_ultralight_poller_select_sector(MfUltralightPoller* instance, uint8_t sector) {
     MfUltralightError ret = MfUltralightErrorNone;
     Iso14443_3aError error = Iso14443_3aErrorNone;
 
@@ -121,9 +118,21 @@ MfUltralightError mf_ultralight_poller_read_page_from_sector(
             ret = MfUltralightErrorProtocol;
             break;
         }
+    } while(false);
 
+    return ret;
+}
+
+MfUltralightError mf_ultralight_poller_read_page_from_sector(
+    MfUltralightPoller* instance,
+    uint8_t sector,
+    uint8_t tag,
+    MfUltralightPageReadCommandData* data) {
+    MfUltralightError ret = mf_ultralight_poller_select_sector(instance, sector);
+
+    if(ret == MfUltralightErrorNone) {
         ret = mf_ultralight_poller_read_page(instance, tag, data);
-    } while(false);
+    }
 
     return ret;
 }
@@ -158,6 +167,40 @@ MfUltralightError mf_ultralight_poller_read_page(
     return ret;
 }
 
+MfUltralightError mf_ultralight_poller_fast_read_pages(
+    MfUltralightPoller* instance,
+    uint8_t start_page,
+    uint8_t end_page,
+    MfUltralightPage* data) {
+    furi_assert(end_page >= start_page);
+    furi_assert(end_page - start_page + 1U <= MF_ULTRALIGHT_FAST_READ_PAGES_MAX);
+
+    MfUltralightError ret = MfUltralightErrorNone;
+    Iso14443_3aError error = Iso14443_3aErrorNone;
+    const size_t data_size = (end_page - start_page + 1) * MF_ULTRALIGHT_PAGE_SIZE;
+
+    do {
+        uint8_t fast_read_cmd[3] = {MF_ULTRALIGHT_CMD_FAST_READ, start_page, end_page};
+        bit_buffer_copy_bytes(instance->tx_buffer, fast_read_cmd, sizeof(fast_read_cmd));
+        error = iso14443_3a_poller_send_standard_frame(
+            instance->iso14443_3a_poller,
+            instance->tx_buffer,
+            instance->rx_buffer,
+            MF_ULTRALIGHT_POLLER_STANDARD_FWT_FC);
+        if(error != Iso14443_3aErrorNone) {
+            ret = mf_ultralight_process_error(error);
+            break;
+        }
+        if(bit_buffer_get_size_bytes(instance->rx_buffer) != data_size) {
+            ret = MfUltralightErrorProtocol;
+            break;
+        }
+        bit_buffer_write_bytes(instance->rx_buffer, data, data_size);
+    } while(false);
+
+    return ret;
+}
+
 MfUltralightError mf_ultralight_poller_write_page(
     MfUltralightPoller* instance,
     uint8_t page,
@@ -9,7 +9,7 @@ extern "C" {
 #endif
 
 #define MF_ULTRALIGHT_POLLER_STANDARD_FWT_FC (60000)
-#define MF_ULTRALIGHT_MAX_BUFF_SIZE (64)
+#define MF_ULTRALIGHT_MAX_BUFF_SIZE (256)
 
 #define MF_ULTRALIGHT_DEFAULT_PASSWORD (0xffffffffUL)
 
@@ -86,6 +86,8 @@ struct MfUltralightPoller {
     uint8_t tearing_flag_read;
     uint8_t tearing_flag_total;
     uint16_t current_page;
+    uint16_t fast_read_fallback_end;
+    bool reauth_required;
     MfUltralightError error;
 
     NfcGenericEvent general_event;
@@ -97,6 +99,8 @@ struct MfUltralightPoller {
 
 MfUltralightError mf_ultralight_process_error(Iso14443_3aError error);
 
+MfUltralightError mf_ultralight_poller_select_sector(MfUltralightPoller* instance, uint8_t sector);
+
 MfUltralightPoller* mf_ultralight_poller_alloc(Iso14443_3aPoller* iso14443_3a_poller);
 
 void mf_ultralight_poller_free(MfUltralightPoller* instance);
@@ -2,6 +2,8 @@
 
 #include <nfc/helpers/iso14443_crc.h>
 
+#include <inttypes.h>
+
 #define TAG "ST25TBPoller"
 
 static St25tbError st25tb_poller_process_error(NfcError error) {
@@ -240,7 +242,7 @@ St25tbError
             break;
         }
         bit_buffer_write_bytes(instance->rx_buffer, block, ST25TB_BLOCK_SIZE);
-        FURI_LOG_D(TAG, "Read_block(%d) result: %08lX", block_number, *block);
+        FURI_LOG_D(TAG, "Read_block(%d) result: %08" PRIX32, block_number, *block);
     } while(false);
 
     return ret;
@@ -279,13 +281,13 @@ St25tbError
         if(block_check != block) {
             FURI_LOG_E(
                 TAG,
-                "write verification failed: wrote %08lX but read back %08lX",
+                "write verification failed: wrote %08" PRIX32 " but read back %08" PRIX32,
                 block,
                 block_check);
             ret = St25tbErrorWriteFailed;
             break;
         }
-        FURI_LOG_D(TAG, "wrote %08lX to block %d", block, block_number);
+        FURI_LOG_D(TAG, "wrote %08" PRIX32 " to block %d", block, block_number);
     } while(false);
 
     return ret;
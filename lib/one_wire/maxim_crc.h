@@ -1,4 +1,5 @@
 #pragma once
+#include <stddef.h>
 #include <stdint.h>
 
 #ifdef __cplusplus
@@ -6,9 +7,19 @@ extern "C" {
 #endif
 
 #define MAXIM_CRC8_INIT 0
+#define MAXIM_CRC16_INIT 0
 
 uint8_t maxim_crc8(const uint8_t* data, const uint8_t data_size, const uint8_t crc_init);
 
+/**
+ * CRC16 of 1-Wire devices, devices send it inverted
+ * @param [in] data data to check
+ * @param [in] data_size data size
+ * @param [in] crc_init MAXIM_CRC16_INIT or CRC of previous data
+ * @return CRC16 value
+ */
+uint16_t maxim_crc16(const uint8_t* data, size_t data_size, uint16_t crc_init);
+
 #ifdef __cplusplus
 }
 #endif
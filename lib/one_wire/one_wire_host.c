@@ -46,141 +46,212 @@ static const OneWireHostTimings onewire_host_timings_overdrive = {
     .j = 40,
 };
 
+#define ONEWIRE_HOST_CMD_SKIP_ROM 0xCCU
+#define ONEWIRE_HOST_CMD_OVERDRIVE_SKIP_ROM 0x3CU
+#define ONEWIRE_HOST_CMD_SEARCH_ROM 0xF0U
+#define ONEWIRE_HOST_CMD_COND_SEARCH 0xECU
+
+#define BITS_IN_BYTE 8U
+
 struct OneWireHost {
-    const GpioPin* gpio_pin;
-    const OneWireHostTimings* timings;
+    const OneWireHostBus* bus;
+    void* bus_context;
+    bool overdrive;
     unsigned char saved_rom[8]; /** < global search state */
     uint8_t last_discrepancy;
     uint8_t last_family_discrepancy;
     bool last_device_flag;
 };
 
-OneWireHost* onewire_host_alloc(const GpioPin* gpio_pin) {
-    OneWireHost* host = malloc(sizeof(OneWireHost));
-    host->gpio_pin = gpio_pin;
-    onewire_host_reset_search(host);
-    onewire_host_set_overdrive(host, false);
-    return host;
+static void onewire_host_gpio_start(void* context) {
+    const GpioPin* gpio_pin = context;
+    furi_hal_gpio_write(gpio_pin, true);
+    furi_hal_gpio_init(gpio_pin, GpioModeOutputOpenDrain, GpioPullNo, GpioSpeedLow);
 }
 
-void onewire_host_free(OneWireHost* host) {
-    onewire_host_stop(host);
-    free(host);
+static void onewire_host_gpio_stop(void* context) {
+    const GpioPin* gpio_pin = context;
+    furi_hal_gpio_write(gpio_pin, true);
+    furi_hal_gpio_init(gpio_pin, GpioModeAnalog, GpioPullNo, GpioSpeedLow);
 }
 
-bool onewire_host_reset(OneWireHost* host) {
+static bool onewire_host_gpio_reset(void* context, bool overdrive) {
+    const GpioPin* gpio_pin = context;
+    const OneWireHostTimings* timings =
+        overdrive ? &onewire_host_timings_overdrive : &onewire_host_timings_normal;
     uint8_t r;
     uint8_t retries = 125;
 
-    const OneWireHostTimings* timings = host->timings;
-
     // wait until the gpio is high
-    furi_hal_gpio_write(host->gpio_pin, true);
+    furi_hal_gpio_write(gpio_pin, true);
     do {
         if(--retries == 0) return 0;
         furi_delay_us(2);
-    } while(!furi_hal_gpio_read(host->gpio_pin));
+    } while(!furi_hal_gpio_read(gpio_pin));
 
     // pre delay
     furi_delay_us(timings->g);
 
     // drive low
-    furi_hal_gpio_write(host->gpio_pin, false);
+    furi_hal_gpio_write(gpio_pin, false);
     furi_delay_us(timings->h);
 
     // release
-    furi_hal_gpio_write(host->gpio_pin, true);
+    furi_hal_gpio_write(gpio_pin, true);
     furi_delay_us(timings->i);
 
     // read and post delay
-    r = !furi_hal_gpio_read(host->gpio_pin);
+    r = !furi_hal_gpio_read(gpio_pin);
     furi_delay_us(timings->j);
 
     return r;
 }
 
-bool onewire_host_read_bit(OneWireHost* host) {
-    bool result;
+static void onewire_host_gpio_touch(
+    void* context,
+    bool overdrive,
+    const uint8_t* tx,
+    uint8_t* rx,
+    size_t bit_count) {
+    const GpioPin* gpio_pin = context;
+    const OneWireHostTimings* timings =
+        overdrive ? &onewire_host_timings_overdrive : &onewire_host_timings_normal;
+
+    for(size_t i = 0; i < bit_count; i++) {
+        const uint8_t mask = 1U << (i % BITS_IN_BYTE);
+        bool value = tx ? (tx[i / BITS_IN_BYTE] & mask) : true;
+
+        if(value) {
+            // drive low
+            furi_hal_gpio_write(gpio_pin, false);
+            furi_delay_us(timings->a);
+
+            // release
+            furi_hal_gpio_write(gpio_pin, true);
+            furi_delay_us(timings->e);
+
+            // read and post delay, write 1 slot is the same
+            value = furi_hal_gpio_read(gpio_pin);
+            furi_delay_us(timings->f);
+        } else {
+            // drive low
+            furi_hal_gpio_write(gpio_pin, false);
+            furi_delay_us(timings->c);
+
+            // release
+            furi_hal_gpio_write(gpio_pin, true);
+            furi_delay_us(timings->d);
+        }
 
-    const OneWireHostTimings* timings = host->timings;
+        if(rx) {
+            if(value) {
+                rx[i / BITS_IN_BYTE] |= mask;
+            } else {
+                rx[i / BITS_IN_BYTE] &= ~mask;
+            }
+        }
+    }
+}
 
-    // drive low
-    furi_hal_gpio_write(host->gpio_pin, false);
-    furi_delay_us(timings->a);
+static const OneWireHostBus onewire_host_gpio_bus = {
+    .start = onewire_host_gpio_start,
+    .stop = onewire_host_gpio_stop,
+    .reset = onewire_host_gpio_reset,
+    .touch = onewire_host_gpio_touch,
+};
 
-    // release
-    furi_hal_gpio_write(host->gpio_pin, true);
-    furi_delay_us(timings->e);
+OneWireHost* onewire_host_alloc(const GpioPin* gpio_pin) {
+    return onewire_host_alloc_ex(&onewire_host_gpio_bus, (void*)gpio_pin);
+}
 
-    // read and post delay
-    result = furi_hal_gpio_read(host->gpio_pin);
-    furi_delay_us(timings->f);
+OneWireHost* onewire_host_alloc_ex(const OneWireHostBus* bus, void* context) {
+    furi_assert(bus);
+    OneWireHost* host = malloc(sizeof(OneWireHost));
+    host->bus = bus;
+    host->bus_context = context;
+    onewire_host_reset_search(host);
+    onewire_host_set_overdrive(host, false);
+    return host;
+}
 
-    return result;
+void onewire_host_free(OneWireHost* host) {
+    onewire_host_stop(host);
+    free(host);
 }
 
-uint8_t onewire_host_read(OneWireHost* host) {
-    uint8_t result = 0;
+bool onewire_host_reset(OneWireHost* host) {
+    return host->bus->reset(host->bus_context, host->overdrive);
+}
 
-    for(uint8_t bitMask = 0x01; bitMask; bitMask <<= 1) {
-        if(onewire_host_read_bit(host)) {
-            result |= bitMask;
-        }
-    }
+bool onewire_host_read_bit(OneWireHost* host) {
+    uint8_t value = 0;
+    host->bus->touch(host->bus_context, host->overdrive, NULL, &value, 1);
+    return value;
+}
 
+uint8_t onewire_host_read(OneWireHost* host) {
+    uint8_t result = 0;
+    host->bus->touch(host->bus_context, host->overdrive, NULL, &result, BITS_IN_BYTE);
     return result;
 }
 
 void onewire_host_read_bytes(OneWireHost* host, uint8_t* buffer, uint16_t count) {
-    for(uint16_t i = 0; i < count; i++) {
-        buffer[i] = onewire_host_read(host);
-    }
+    host->bus->touch(host->bus_context, host->overdrive, NULL, buffer, count * BITS_IN_BYTE);
 }
 
 void onewire_host_write_bit(OneWireHost* host, bool value) {
-    const OneWireHostTimings* timings = host->timings;
-
-    if(value) {
-        // drive low
-        furi_hal_gpio_write(host->gpio_pin, false);
-        furi_delay_us(timings->a);
+    const uint8_t tx = value;
+    host->bus->touch(host->bus_context, host->overdrive, &tx, NULL, 1);
+}
 
-        // release
-        furi_hal_gpio_write(host->gpio_pin, true);
-        furi_delay_us(timings->b);
-    } else {
-        // drive low
-        furi_hal_gpio_write(host->gpio_pin, false);
-        furi_delay_us(timings->c);
+void onewire_host_write(OneWireHost* host, uint8_t value) {
+    host->bus->touch(host->bus_context, host->overdrive, &value, NULL, BITS_IN_BYTE);
+}
 
-        // release
-        furi_hal_gpio_write(host->gpio_pin, true);
-        furi_delay_us(timings->d);
-    }
+void onewire_host_write_bytes(OneWireHost* host, const uint8_t* buffer, uint16_t count) {
+    host->bus->touch(host->bus_context, host->overdrive, buffer, NULL, count * BITS_IN_BYTE);
 }
 
-void onewire_host_write(OneWireHost* host, uint8_t value) {
-    uint8_t bitMask;
+bool onewire_host_transfer(
+    OneWireHost* host,
+    const uint8_t* tx,
+    size_t tx_size,
+    uint8_t* rx,
+    size_t rx_size) {
+    if(!onewire_host_reset(host)) return false;
 
-    for(bitMask = 0x01; bitMask; bitMask <<= 1) {
-        onewire_host_write_bit(host, (bitMask & value) ? 1 : 0);
+    if(tx_size) {
+        host->bus->touch(host->bus_context, host->overdrive, tx, NULL, tx_size * BITS_IN_BYTE);
+    }
+    if(rx_size) {
+        host->bus->touch(host->bus_context, host->overdrive, NULL, rx, rx_size * BITS_IN_BYTE);
     }
+
+    return true;
 }
 
-void onewire_host_write_bytes(OneWireHost* host, const uint8_t* buffer, uint16_t count) {
-    for(uint16_t i = 0; i < count; ++i) {
-        onewire_host_write(host, buffer[i]);
+bool onewire_host_overdrive_skip_rom(OneWireHost* host) {
+    onewire_host_set_overdrive(host, false);
+    if(!onewire_host_reset(host)) return false;
+    onewire_host_write(host, ONEWIRE_HOST_CMD_OVERDRIVE_SKIP_ROM);
+
+    // device without overdrive does not answer short reset
+    onewire_host_set_overdrive(host, true);
+    if(onewire_host_reset(host)) {
+        onewire_host_write(host, ONEWIRE_HOST_CMD_SKIP_ROM);
+        return true;
     }
+
+    onewire_host_set_overdrive(host, false);
+    return false;
 }
 
 void onewire_host_start(OneWireHost* host) {
-    furi_hal_gpio_write(host->gpio_pin, true);
-    furi_hal_gpio_init(host->gpio_pin, GpioModeOutputOpenDrain, GpioPullNo, GpioSpeedLow);
+    host->bus->start(host->bus_context);
 }
 
 void onewire_host_stop(OneWireHost* host) {
-    furi_hal_gpio_write(host->gpio_pin, true);
-    furi_hal_gpio_init(host->gpio_pin, GpioModeAnalog, GpioPullNo, GpioSpeedLow);
+    host->bus->stop(host->bus_context);
 }
 
 void onewire_host_reset_search(OneWireHost* host) {
@@ -229,10 +300,10 @@ bool onewire_host_search(OneWireHost* host, uint8_t* new_addr, OneWireHostSearch
         // issue the search command
         switch(mode) {
         case OneWireHostSearchModeConditional:
-            onewire_host_write(host, 0xEC);
+            onewire_host_write(host, ONEWIRE_HOST_CMD_COND_SEARCH);
             break;
         case OneWireHostSearchModeNormal:
-            onewire_host_write(host, 0xF0);
+            onewire_host_write(host, ONEWIRE_HOST_CMD_SEARCH_ROM);
             break;
         }
 
@@ -317,5 +388,5 @@ bool onewire_host_search(OneWireHost* host, uint8_t* new_addr, OneWireHostSearch
 }
 
 void onewire_host_set_overdrive(OneWireHost* host, bool set) {
-    host->timings = set ? &onewire_host_timings_overdrive : &onewire_host_timings_normal;
+    host->overdrive = set;
 }
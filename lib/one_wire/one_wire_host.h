@@ -5,6 +5,7 @@
  */
 
 #pragma once
+#include <stddef.h>
 #include <stdint.h>
 #include <stdbool.h>
 #include <furi_hal_gpio.h>
@@ -20,6 +21,22 @@ typedef enum {
 
 typedef struct OneWireHost OneWireHost;
 
+/**
+ * 1-Wire bus driven by the host: GPIO pin or a simulated slave.
+ * Bits go LSB first, writing 1 and reading are the same time slot.
+ */
+typedef struct {
+    void (*start)(void* context); /**< Take the bus */
+    void (*stop)(void* context); /**< Release the bus */
+    /** Send reset pulse, return true if presence was detected */
+    bool (*reset)(void* context, bool overdrive);
+    /**
+     * Run bit_count time slots: write bits of tx, NULL writes ones,
+     * and sample the bus to rx, can be NULL
+     */
+    void (*touch)(void* context, bool overdrive, const uint8_t* tx, uint8_t* rx, size_t bit_count);
+} OneWireHostBus;
+
 /**
  * Allocate OneWireHost instance
  * @param [in] gpio_pin connection pin
@@ -27,6 +44,14 @@ typedef struct OneWireHost OneWireHost;
  */
 OneWireHost* onewire_host_alloc(const GpioPin* gpio_pin);
 
+/**
+ * Allocate OneWireHost instance on a custom bus
+ * @param [in] bus bus implementation, must outlive the host
+ * @param [in] context bus context
+ * @return pointer to OneWireHost instance
+ */
+OneWireHost* onewire_host_alloc_ex(const OneWireHostBus* bus, void* context);
+
 /**
  * Destroy OneWireHost instance, free resources
  * @param [in] host pointer to OneWireHost instance
@@ -84,6 +109,31 @@ void onewire_host_write(OneWireHost* host, uint8_t value);
  */
 void onewire_host_write_bytes(OneWireHost* host, const uint8_t* buffer, uint16_t count);
 
+/**
+ * Reset the bus, write a command and read the answer, each in one bus call
+ * @param [in] host pointer to OneWireHost instance
+ * @param [in] tx ROM command, function command and its parameters
+ * @param [in] tx_size size of the data to write
+ * @param [out] rx received data buffer, can be NULL if rx_size is 0
+ * @param [in] rx_size number of bytes to read
+ * @return true if presence was detected, false otherwise
+ */
+bool onewire_host_transfer(
+    OneWireHost* host,
+    const uint8_t* tx,
+    size_t tx_size,
+    uint8_t* rx,
+    size_t rx_size);
+
+/**
+ * Switch the only device on the bus and the host to overdrive speed.
+ * Device is selected if it answered at overdrive speed, otherwise host is
+ * back at standard speed and the bus must be reset before the next command.
+ * @param [in] host pointer to OneWireHost instance
+ * @return true if device answered at overdrive speed, false otherwise
+ */
+bool onewire_host_overdrive_skip_rom(OneWireHost* host);
+
 /**
  * Start working with the bus
  * @param [in] host pointer to OneWireHost instance
@@ -0,0 +1,252 @@
+#include "iso15693_decoder.h"
+
+#include <furi/furi.h>
+
+#define ISO15693_DECODER_SOF_1_OUT_OF_4 (0x21U)
+#define ISO15693_DECODER_SOF_1_OUT_OF_256 (0x81U)
+#define ISO15693_DECODER_EOF_SINGLE (0x01U)
+#define ISO15693_DECODER_EOF (0x04U)
+
+#define ISO15693_DECODER_SAMPLES_PER_BYTE (8U)
+#define ISO15693_DECODER_1_OUT_OF_4_SYMBOLS_PER_BYTE (4U)
+#define ISO15693_DECODER_1_OUT_OF_4_SYMBOL_BITS (2U)
+#define ISO15693_DECODER_1_OUT_OF_256_SAMPLE_BYTES (64U)
+#define ISO15693_DECODER_SLOTS_PER_SAMPLE_BYTE (4U)
+#define ISO15693_DECODER_NO_PULSE (0x100U)
+
+typedef enum {
+    Iso15693DecoderStateParseSoF,
+    Iso15693DecoderStateParse1OutOf4,
+    Iso15693DecoderStateParse1OutOf256,
+    Iso15693DecoderStateDone,
+    Iso15693DecoderStateFail,
+} Iso15693DecoderState;
+
+struct Iso15693Decoder {
+    Iso15693DecoderState state;
+
+    uint8_t next_byte;
+    // 1 out of 4: symbols in next byte, 1 out of 256: sample bytes in current symbol
+    uint8_t next_byte_part;
+    // 1 out of 256: pulse position in current symbol
+    uint16_t next_value;
+
+    BitBuffer* frame;
+    Iso15693DecoderStats stats;
+};
+
+typedef size_t (*Iso15693DecoderStateHandler)(
+    Iso15693Decoder* instance,
+    const uint8_t* samples,
+    size_t size);
+
+// Pulse is in the second sample of a slot: sample byte with one pulse maps to slot index + 1,
+// anything else maps to 0
+static const uint8_t iso15693_decoder_slot_table[UINT8_MAX + 1] = {
+    [0x02] = 1,
+    [0x08] = 2,
+    [0x20] = 3,
+    [0x80] = 4,
+};
+
+Iso15693Decoder* iso15693_decoder_alloc(size_t max_frame_size) {
+    Iso15693Decoder* instance = malloc(sizeof(Iso15693Decoder));
+    instance->frame = bit_buffer_alloc(max_frame_size);
+
+    iso15693_decoder_reset(instance);
+    iso15693_decoder_reset_stats(instance);
+
+    return instance;
+}
+
+void iso15693_decoder_free(Iso15693Decoder* instance) {
+    furi_assert(instance);
+
+    bit_buffer_free(instance->frame);
+    free(instance);
+}
+
+void iso15693_decoder_reset(Iso15693Decoder* instance) {
+    furi_assert(instance);
+
+    instance->state = Iso15693DecoderStateParseSoF;
+    instance->next_byte = 0;
+    instance->next_byte_part = 0;
+    instance->next_value = ISO15693_DECODER_NO_PULSE;
+    bit_buffer_reset(instance->frame);
+}
+
+static void iso15693_decoder_frame_done(Iso15693Decoder* instance) {
+    instance->state = Iso15693DecoderStateDone;
+    instance->stats.frames++;
+    instance->stats.bytes += bit_buffer_get_size_bytes(instance->frame);
+}
+
+static void iso15693_decoder_symbol_error(Iso15693Decoder* instance) {
+    instance->state = Iso15693DecoderStateFail;
+    instance->stats.symbol_errors++;
+}
+
+static bool iso15693_decoder_append_byte(Iso15693Decoder* instance, uint8_t byte) {
+    if(bit_buffer_get_size_bytes(instance->frame) ==
+       bit_buffer_get_capacity_bytes(instance->frame)) {
+        instance->state = Iso15693DecoderStateFail;
+        instance->stats.overflows++;
+        return false;
+    }
+
+    bit_buffer_append_byte(instance->frame, byte);
+    return true;
+}
+
+static size_t
+    iso15693_decoder_parse_sof(Iso15693Decoder* instance, const uint8_t* samples, size_t size) {
+    UNUSED(size);
+
+    if(samples[0] == ISO15693_DECODER_SOF_1_OUT_OF_4) {
+        instance->state = Iso15693DecoderStateParse1OutOf4;
+    } else if(samples[0] == ISO15693_DECODER_SOF_1_OUT_OF_256) {
+        instance->state = Iso15693DecoderStateParse1OutOf256;
+    } else if(samples[0] == ISO15693_DECODER_EOF_SINGLE) {
+        // EOF without data, sent by reader to switch inventory slots
+        iso15693_decoder_frame_done(instance);
+    } else {
+        instance->state = Iso15693DecoderStateFail;
+        instance->stats.sof_errors++;
+    }
+
+    return 1;
+}
+
+// One sample byte holds one symbol: 8 samples per lookup
+static size_t iso15693_decoder_parse_1_out_of_4(
+    Iso15693Decoder* instance,
+    const uint8_t* samples,
+    size_t size) {
+    size_t i = 0;
+
+    while(i < size) {
+        const uint8_t sample = samples[i++];
+        const uint8_t slot = iso15693_decoder_slot_table[sample];
+
+        if(slot == 0) {
+            if((sample == ISO15693_DECODER_EOF) && (instance->next_byte_part == 0)) {
+                iso15693_decoder_frame_done(instance);
+            } else {
+                iso15693_decoder_symbol_error(instance);
+            }
+            break;
+        }
+
+        const uint8_t shift = instance->next_byte_part * ISO15693_DECODER_1_OUT_OF_4_SYMBOL_BITS;
+        instance->next_byte |= (slot - 1) << shift;
+        instance->next_byte_part++;
+
+        if(instance->next_byte_part == ISO15693_DECODER_1_OUT_OF_4_SYMBOLS_PER_BYTE) {
+            if(!iso15693_decoder_append_byte(instance, instance->next_byte)) break;
+            instance->next_byte = 0;
+            instance->next_byte_part = 0;
+        }
+    }
+
+    return i;
+}
+
+// One symbol spans 64 sample bytes with one pulse, empty ones are skipped 16 samples at once
+static size_t iso15693_decoder_parse_1_out_of_256(
+    Iso15693Decoder* instance,
+    const uint8_t* samples,
+    size_t size) {
+    size_t i = 0;
+
+    while(i < size) {
+        if((instance->next_byte_part < ISO15693_DECODER_1_OUT_OF_256_SAMPLE_BYTES - 2) &&
+           (size - i >= 2)) {
+            uint16_t samples_16;
+            memcpy(&samples_16, &samples[i], sizeof(samples_16));
+            if(samples_16 == 0) {
+                instance->next_byte_part += 2;
+                i += 2;
+                continue;
+            }
+        }
+
+        const uint8_t sample = samples[i++];
+
+        if((instance->next_byte_part == 0) && (sample == ISO15693_DECODER_EOF)) {
+            iso15693_decoder_frame_done(instance);
+            break;
+        }
+
+        if(sample != 0) {
+            const uint8_t slot = iso15693_decoder_slot_table[sample];
+            if((slot == 0) || (instance->next_value != ISO15693_DECODER_NO_PULSE)) {
+                iso15693_decoder_symbol_error(instance);
+                break;
+            }
+            instance->next_value =
+                instance->next_byte_part * ISO15693_DECODER_SLOTS_PER_SAMPLE_BYTE + slot - 1;
+        }
+
+        instance->next_byte_part++;
+
+        if(instance->next_byte_part == ISO15693_DECODER_1_OUT_OF_256_SAMPLE_BYTES) {
+            if(instance->next_value == ISO15693_DECODER_NO_PULSE) {
+                iso15693_decoder_symbol_error(instance);
+                break;
+            }
+            if(!iso15693_decoder_append_byte(instance, instance->next_value)) break;
+            instance->next_value = ISO15693_DECODER_NO_PULSE;
+            instance->next_byte_part = 0;
+        }
+    }
+
+    return i;
+}
+
+static const Iso15693DecoderStateHandler iso15693_decoder_state_handlers[] = {
+    [Iso15693DecoderStateParseSoF] = iso15693_decoder_parse_sof,
+    [Iso15693DecoderStateParse1OutOf4] = iso15693_decoder_parse_1_out_of_4,
+    [Iso15693DecoderStateParse1OutOf256] = iso15693_decoder_parse_1_out_of_256,
+};
+
+Iso15693DecoderStatus
+    iso15693_decoder_feed(Iso15693Decoder* instance, const uint8_t* samples, size_t size) {
+    furi_assert(instance);
+    furi_assert(samples);
+
+    size_t processed = 0;
+    while((processed < size) && (instance->state < Iso15693DecoderStateDone)) {
+        processed += iso15693_decoder_state_handlers[instance->state](
+            instance, &samples[processed], size - processed);
+    }
+    instance->stats.samples += processed * ISO15693_DECODER_SAMPLES_PER_BYTE;
+
+    Iso15693DecoderStatus status = Iso15693DecoderStatusWait;
+    if(instance->state == Iso15693DecoderStateDone) {
+        status = Iso15693DecoderStatusFrame;
+    } else if(instance->state == Iso15693DecoderStateFail) {
+        status = Iso15693DecoderStatusFail;
+    }
+
+    return status;
+}
+
+const BitBuffer* iso15693_decoder_get_frame(const Iso15693Decoder* instance) {
+    furi_assert(instance);
+
+    return instance->frame;
+}
+
+void iso15693_decoder_get_stats(const Iso15693Decoder* instance, Iso15693DecoderStats* stats) {
+    furi_assert(instance);
+    furi_assert(stats);
+
+    *stats = instance->stats;
+}
+
+void iso15693_decoder_reset_stats(Iso15693Decoder* instance) {
+    furi_assert(instance);
+
+    memset(&instance->stats, 0, sizeof(Iso15693DecoderStats));
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <toolbox/bit_buffer.h>
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** ISO15693 reader frame decoder
+ *
+ * Samples come packed 8 per byte, first sample in LSB, as signal reader gives
+ * them at 2 samples per pulse slot. Decoder keeps its state between calls, so
+ * a frame can be fed in pieces of any size, e.g. DMA half-buffers.
+ */
+typedef struct Iso15693Decoder Iso15693Decoder;
+
+typedef enum {
+    Iso15693DecoderStatusWait, /**< frame is not complete, feed more samples */
+    Iso15693DecoderStatusFrame, /**< frame decoded, samples after EOF are ignored */
+    Iso15693DecoderStatusFail, /**< invalid signal, samples are ignored until reset */
+} Iso15693DecoderStatus;
+
+typedef struct {
+    uint32_t samples; /**< samples processed */
+    uint32_t frames; /**< frames decoded, including EOF only frames */
+    uint32_t bytes; /**< bytes decoded */
+    uint32_t sof_errors; /**< frames that didn't start with SOF or EOF */
+    uint32_t symbol_errors; /**< frames dropped on pulse outside of slot or missing pulse */
+    uint32_t overflows; /**< frames longer than the decoder buffer */
+} Iso15693DecoderStats;
+
+Iso15693Decoder* iso15693_decoder_alloc(size_t max_frame_size);
+
+void iso15693_decoder_free(Iso15693Decoder* instance);
+
+/** Drop decoded data and wait for SOF of the next frame, statistics are kept */
+void iso15693_decoder_reset(Iso15693Decoder* instance);
+
+/** Decode samples
+ *
+ * @param      instance  The instance
+ * @param      samples   Packed samples
+ * @param      size      Size of samples in bytes
+ *
+ * @return     decoder status after the samples
+ */
+Iso15693DecoderStatus
+    iso15693_decoder_feed(Iso15693Decoder* instance, const uint8_t* samples, size_t size);
+
+/** Get decoded frame, complete when feed returned Iso15693DecoderStatusFrame */
+const BitBuffer* iso15693_decoder_get_frame(const Iso15693Decoder* instance);
+
+void iso15693_decoder_get_stats(const Iso15693Decoder* instance, Iso15693DecoderStats* stats);
+
+void iso15693_decoder_reset_stats(Iso15693Decoder* instance);
+
+#ifdef __cplusplus
+}
+#endif
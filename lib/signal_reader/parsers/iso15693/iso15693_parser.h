@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../../signal_reader.h"
+#include "iso15693_decoder.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -37,6 +38,8 @@ void iso15693_parser_get_data(
     size_t buff_size,
     size_t* data_bits);
 
+void iso15693_parser_get_stats(Iso15693Parser* instance, Iso15693DecoderStats* stats);
+
 #ifdef __cplusplus
 }
 #endif
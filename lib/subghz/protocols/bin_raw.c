@@ -10,6 +10,7 @@
 #include <lib/flipper_format/flipper_format_i.h>
 
 #include <math.h>
+#include <inttypes.h>
 
 #define TAG "SubGhzProtocolBinRaw"
 
@@ -23,6 +24,9 @@
 #define BIN_RAW_TE_MIN_COUNT 40
 #define BIN_RAW_BUF_MIN_DATA_COUNT 128
 #define BIN_RAW_MAX_MARKUP_COUNT 20
+//durations classified to find TE, the last ones are usually garbage
+#define BIN_RAW_CLASSIFY_COUNT 512
+#define BIN_RAW_CLASSIFY_SKIP_TAIL 100
 
 //#define BIN_RAW_DEBUG
 
@@ -65,6 +69,12 @@ struct BinRAW_Markup {
 };
 typedef struct BinRAW_Markup BinRAW_Markup;
 
+struct BinRAW_Class {
+    float data;
+    uint16_t count;
+};
+typedef struct BinRAW_Class BinRAW_Class;
+
 struct SubGhzProtocolDecoderBinRAW {
     SubGhzProtocolDecoderBase base;
 
@@ -74,6 +84,8 @@ struct SubGhzProtocolDecoderBinRAW {
     uint8_t* data;
     BinRAW_Markup data_markup[BIN_RAW_MAX_MARKUP_COUNT];
     size_t data_raw_ind;
+    BinRAW_Class classes[BIN_RAW_SEARCH_CLASSES];
+    size_t classes_ind; //durations already classified
     uint32_t te;
     float adaptive_threshold_rssi;
 };
@@ -354,6 +366,8 @@ void* subghz_protocol_decoder_bin_raw_alloc(SubGhzEnvironment* environment) {
     instance->base.protocol = &subghz_protocol_bin_raw;
     instance->generic.protocol_name = instance->base.protocol->name;
     instance->data_raw_ind = 0;
+    instance->classes_ind = 0;
+    memset(instance->classes, 0x00, sizeof(instance->classes));
     instance->data_raw = malloc(BIN_RAW_BUF_RAW_SIZE * sizeof(int32_t));
     instance->data = malloc(BIN_RAW_BUF_RAW_SIZE * sizeof(uint8_t));
     memset(instance->data_markup, 0x00, BIN_RAW_MAX_MARKUP_COUNT * sizeof(BinRAW_Markup));
@@ -377,9 +391,36 @@ void subghz_protocol_decoder_bin_raw_reset(void* context) {
 #else
     instance->decoder.parser_step = BinRAWDecoderStepNoParse;
     instance->data_raw_ind = 0;
+    instance->classes_ind = 0;
 #endif
 }
 
+/** 
+ * Sort durations into classes of correlated intervals, up to the given duration
+ * @param instance Pointer to a SubGhzProtocolDecoderBinRAW* instance
+ * @param count Number of durations that must be classified
+ */
+static void
+    subghz_protocol_bin_raw_classify(SubGhzProtocolDecoderBinRAW* instance, size_t count) {
+    BinRAW_Class* classes = instance->classes;
+
+    for(; instance->classes_ind < count; instance->classes_ind++) {
+        float duration = (float)(abs(instance->data_raw[instance->classes_ind]));
+        for(size_t k = 0; k < BIN_RAW_SEARCH_CLASSES; k++) {
+            if(classes[k].count == 0) {
+                classes[k].data = duration;
+                classes[k].count++;
+                break;
+            } else if(DURATION_DIFF(duration, (classes[k].data)) < (classes[k].data / 4)) {
+                //if the test value does not differ by more than 25%
+                classes[k].data += (duration - classes[k].data) * 0.05f; //running average k=0.05
+                classes[k].count++;
+                break;
+            }
+        }
+    }
+}
+
 void subghz_protocol_decoder_bin_raw_feed(void* context, bool level, uint32_t duration) {
     furi_assert(context);
     SubGhzProtocolDecoderBinRAW* instance = context;
@@ -389,53 +430,80 @@ void subghz_protocol_decoder_bin_raw_feed(void* context, bool level, uint32_t du
             instance->decoder.parser_step = BinRAWDecoderStepBufFull;
         } else {
             instance->data_raw[instance->data_raw_ind++] = (level ? duration : -duration);
+            //classify with a lag: durations at the end of the record are not classified,
+            //at most one duration per pulse, so the analysis doesn't do it all at once
+            if(instance->data_raw_ind > BIN_RAW_CLASSIFY_SKIP_TAIL) {
+                subghz_protocol_bin_raw_classify(
+                    instance,
+                    MIN(instance->data_raw_ind - BIN_RAW_CLASSIFY_SKIP_TAIL,
+                        (size_t)BIN_RAW_CLASSIFY_COUNT));
+            }
         }
     }
 }
 
+static uint32_t subghz_protocol_bin_raw_hash(const uint8_t* data, size_t size) {
+    uint32_t hash = 0x811C9DC5UL; //FNV-1a
+    for(size_t i = 0; i < size; i++) {
+        hash = (hash ^ data[i]) * 0x01000193UL;
+    }
+    return hash;
+}
+
+/** 
+ * Compare the first byte_count - 1 bytes of two sequences
+ * @param instance Pointer to a SubGhzProtocolDecoderBinRAW* instance
+ * @param markup_hash Hash of every sequence, over its full bytes except the last one
+ * @param a Index of the first sequence
+ * @param b Index of the second sequence
+ * @param byte_count Length of comparison plus one
+ * @return true If data matches
+ */
+static bool subghz_protocol_bin_raw_markup_match(
+    SubGhzProtocolDecoderBinRAW* instance,
+    const uint32_t* markup_hash,
+    uint16_t a,
+    uint16_t b,
+    uint16_t byte_count) {
+    //hash only covers the compared bytes when both sequences are byte_count long
+    if((subghz_protocol_bin_raw_get_full_byte(instance->data_markup[a].bit_count) ==
+        byte_count) &&
+       (subghz_protocol_bin_raw_get_full_byte(instance->data_markup[b].bit_count) ==
+        byte_count) &&
+       (markup_hash[a] != markup_hash[b])) {
+        return false;
+    }
+    return memcmp(
+               instance->data + instance->data_markup[a].byte_bias,
+               instance->data + instance->data_markup[b].byte_bias,
+               byte_count - 1) == 0;
+}
+
 /** 
  * Analysis of received data
  * @param instance Pointer to a SubGhzProtocolDecoderBinRAW* instance
  */
 static bool
     subghz_protocol_bin_raw_check_remote_controller(SubGhzProtocolDecoderBinRAW* instance) {
-    struct {
-        float data;
-        uint16_t count;
-    } classes[BIN_RAW_SEARCH_CLASSES];
+    BinRAW_Class* classes = instance->classes;
+    uint32_t markup_hash[BIN_RAW_MAX_MARKUP_COUNT];
 
     size_t ind = 0;
 
-    memset(classes, 0x00, sizeof(classes));
-
     uint16_t data_markup_ind = 0;
     memset(instance->data_markup, 0x00, BIN_RAW_MAX_MARKUP_COUNT * sizeof(BinRAW_Markup));
 
-    if(instance->data_raw_ind < 512) {
+    if(instance->data_raw_ind < BIN_RAW_CLASSIFY_COUNT) {
         ind =
             instance->data_raw_ind -
-            100; //there is usually garbage at the end of the record, we exclude it from the classification
+            BIN_RAW_CLASSIFY_SKIP_TAIL; //there is usually garbage at the end of the record, we exclude it from the classification
     } else {
-        ind = 512;
+        ind = BIN_RAW_CLASSIFY_COUNT;
     }
 
-    //sort the durations to find the shortest correlated interval
-    for(size_t i = 0; i < ind; i++) {
-        for(size_t k = 0; k < BIN_RAW_SEARCH_CLASSES; k++) {
-            if(classes[k].count == 0) {
-                classes[k].data = (float)(abs(instance->data_raw[i]));
-                classes[k].count++;
-                break;
-            } else if(
-                DURATION_DIFF((float)(abs(instance->data_raw[i])), (classes[k].data)) <
-                (classes[k].data / 4)) { //if the test value does not differ by more than 25%
-                classes[k].data += ((float)(abs(instance->data_raw[i])) - classes[k].data) *
-                                   0.05f; //running average k=0.05
-                classes[k].count++;
-                break;
-            }
-        }
-    }
+    //sort the durations to find the shortest correlated interval,
+    //feed has done it except for the last BIN_RAW_CLASSIFY_SKIP_TAIL durations at most
+    subghz_protocol_bin_raw_classify(instance, ind);
 
     // if(classes[BIN_RAW_SEARCH_CLASSES - 1].count != 0) {
     //     //filling the classifier, it means that they received an unclean signal
@@ -580,7 +648,7 @@ static bool
         bin_raw_debug("\r\n\t count bit= %zu\r\n\r\n", (BIN_RAW_BUF_DATA_SIZE * 8) - ind);
 
         //reset the classifier and classify the received data
-        memset(classes, 0x00, sizeof(classes));
+        memset(classes, 0x00, sizeof(instance->classes));
 
         bin_raw_debug_tag(TAG, "Sort the found pieces by the number of bits in them\r\n");
         for(size_t i = 0; i < data_markup_ind; i++) {
@@ -639,6 +707,15 @@ static bool
 
         //if(data_temp == 0) data_temp = (int)classes[0].data;
 
+        //sequences are compared by hash first, data only if hashes match
+        for(uint16_t i = 0; i < data_markup_ind; i++) {
+            uint16_t byte_count =
+                subghz_protocol_bin_raw_get_full_byte(instance->data_markup[i].bit_count);
+            markup_hash[i] = subghz_protocol_bin_raw_hash(
+                instance->data + instance->data_markup[i].byte_bias,
+                byte_count ? byte_count - 1 : 0);
+        }
+
         if(data_temp != 0) {
             //check that data in transmission is repeated every packet
             for(uint16_t i = 0; i < data_markup_ind - 1; i++) {
@@ -665,10 +742,8 @@ static bool
 
                     uint16_t byte_count =
                         subghz_protocol_bin_raw_get_full_byte(instance->data_markup[i].bit_count);
-                    if(memcmp(
-                           instance->data + instance->data_markup[i].byte_bias,
-                           instance->data + instance->data_markup[i + 1].byte_bias,
-                           byte_count - 1) == 0) {
+                    if(subghz_protocol_bin_raw_markup_match(
+                           instance, markup_hash, i, i + 1, byte_count)) {
                         bin_raw_debug_tag(
                             TAG, "Match found bin_raw_type=BinRAWTypeGapRecurring\r\n\r\n");
 
@@ -715,14 +790,10 @@ static bool
                        subghz_protocol_bin_raw_get_full_byte(
                            instance->data_markup[y].bit_count)) { //if the length in bytes matches
 
-                        if((memcmp(
-                                instance->data + instance->data_markup[i].byte_bias,
-                                instance->data + instance->data_markup[y].byte_bias,
-                                byte_count - 1) == 0) &&
-                           (memcmp(
-                                instance->data + instance->data_markup[i + 1].byte_bias,
-                                instance->data + instance->data_markup[y + 1].byte_bias,
-                                byte_count - 1) == 0)) {
+                        if(subghz_protocol_bin_raw_markup_match(
+                               instance, markup_hash, i, y, byte_count) &&
+                           subghz_protocol_bin_raw_markup_match(
+                               instance, markup_hash, i + 1, y + 1, byte_count)) {
                             uint8_t index = 0;
 #ifdef BIN_RAW_DEBUG
                             bin_raw_debug_tag(
@@ -889,7 +960,8 @@ void subghz_protocol_decoder_bin_raw_data_input_rssi(
         bin_raw_debug("%ld %ld :", (int32_t)rssi, (int32_t)instance->adaptive_threshold_rssi);
         if(rssi > (instance->adaptive_threshold_rssi + BIN_RAW_DELTA_RSSI)) {
             instance->data_raw_ind = 0;
-            memset(instance->data_raw, 0x00, BIN_RAW_BUF_RAW_SIZE * sizeof(int32_t));
+            instance->classes_ind = 0;
+            memset(instance->classes, 0x00, sizeof(instance->classes));
             memset(instance->data, 0x00, BIN_RAW_BUF_RAW_SIZE * sizeof(uint8_t));
             instance->decoder.parser_step = BinRAWDecoderStepWrite;
             bin_raw_debug_tag(TAG, "RSSI\r\n");
@@ -1144,5 +1216,5 @@ void subghz_protocol_decoder_bin_raw_get_string(void* context, FuriString* outpu
         furi_string_cat_printf(output, "%02X", instance->data[i]);
     }
 
-    furi_string_cat_printf(output, "\r\nTe:%luus\r\n", instance->te);
+    furi_string_cat_printf(output, "\r\nTe:%" PRIu32 "us\r\n", instance->te);
 }
@@ -3,6 +3,8 @@
 #include "registry.h"
 #include "protocols/protocol_items.h"
 
+#include <toolbox/profiler.h>
+
 #include <m-array.h>
 
 typedef struct {
@@ -62,12 +64,16 @@ void subghz_receiver_decode(SubGhzReceiver* instance, bool level, uint32_t durat
     furi_assert(instance);
     furi_assert(instance->slots);
 
+    ProfilerProbeStart probe = profiler_probe_begin();
+
     for
         M_EACH(slot, instance->slots, SubGhzReceiverSlotArray_t) {
             if((slot->base->protocol->flag & instance->filter) != 0) {
                 slot->base->protocol->decoder->feed(slot->base, level, duration);
             }
         }
+
+    profiler_probe_end(ProfilerProbeSubGhzReceiverDecode, probe);
 }
 
 void subghz_receiver_reset(SubGhzReceiver* instance) {
@@ -5,6 +5,8 @@
 #include <furi.h>
 #include <m-list.h>
 #include <lib/subghz/devices/cc1101_configs.h>
+#include <toolbox/crc32_calc.h>
+#include <inttypes.h>
 
 #define TAG "SubGhzSetting"
 
@@ -14,6 +16,15 @@
 #define FREQUENCY_FLAG_DEFAULT (1 << 31)
 #define FREQUENCY_MASK (0xFFFFFFFF ^ FREQUENCY_FLAG_DEFAULT)
 
+/* Compiled setting file next to it, keyed on size and CRC32 of the file */
+#define SUBGHZ_SETTING_CACHE_EXTENSION ".cache"
+#define SUBGHZ_SETTING_CACHE_MAGIC 0x43475353U /* "SSGC" */
+#define SUBGHZ_SETTING_CACHE_VERSION 1
+#define SUBGHZ_SETTING_CACHE_SOURCE_SIZE_MAX (32 * 1024)
+#define SUBGHZ_SETTING_CACHE_SIZE_MAX (32 * 1024)
+
+#define SUBGHZ_SETTING_CACHE_FLAG_STANDARD_FREQUENCIES (1 << 0)
+
 /* Default */
 static const uint32_t subghz_frequency_list[] = {
     /* 300 - 348 */
@@ -177,6 +188,22 @@ typedef struct {
     SubGhzSettingCustomPresetItemArray_t data;
 } SubGhzSettingCustomPresetStruct;
 
+/* Followed by frequencies, hopper frequencies and custom presets added by the file */
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t flags;
+    uint32_t source_size;
+    uint32_t source_crc;
+    uint32_t default_frequency; /**< 0 if file has no default frequency */
+    uint16_t frequency_count;
+    uint16_t hopper_frequency_count;
+    uint16_t preset_count;
+    uint16_t reserved;
+    uint32_t payload_size;
+    uint32_t payload_crc;
+} SubGhzSettingCacheHeader;
+
 struct SubGhzSetting {
     FrequencyList_t frequencies;
     FrequencyList_t hopper_frequencies;
@@ -294,111 +321,372 @@ void subghz_setting_load_default(SubGhzSetting* instance) {
     }
 }
 
-void subghz_setting_load(SubGhzSetting* instance, const char* file_path) {
-    furi_assert(instance);
+static bool subghz_setting_cache_get_key(
+    Storage* storage,
+    const char* file_path,
+    SubGhzSettingCacheHeader* header) {
+    File* file = storage_file_alloc(storage);
+    uint8_t* data = NULL;
+    bool success = false;
 
-    Storage* storage = furi_record_open(RECORD_STORAGE);
+    do {
+        if(!storage_file_open(file, file_path, FSAM_READ, FSOM_OPEN_EXISTING)) break;
+
+        const uint64_t size = storage_file_size(file);
+        if(!size || size > SUBGHZ_SETTING_CACHE_SOURCE_SIZE_MAX) break;
+
+        data = malloc(size);
+        if(storage_file_read(file, data, size) != size) break;
+
+        header->source_size = size;
+        header->source_crc = crc32_calc_buffer(0, data, size);
+        success = true;
+    } while(false);
+
+    free(data);
+    storage_file_close(file);
+    storage_file_free(file);
+    return success;
+}
+
+static bool subghz_setting_cache_apply(
+    SubGhzSetting* instance,
+    const SubGhzSettingCacheHeader* header,
+    const uint8_t* payload) {
+    const uint8_t* end = payload + header->payload_size;
+    uint32_t frequency;
+
+    if(!(header->flags & SUBGHZ_SETTING_CACHE_FLAG_STANDARD_FREQUENCIES)) {
+        FrequencyList_reset(instance->frequencies);
+        FrequencyList_reset(instance->hopper_frequencies);
+    }
+
+    const size_t frequency_count = header->frequency_count + header->hopper_frequency_count;
+    if((size_t)(end - payload) < frequency_count * sizeof(uint32_t)) return false;
+
+    for(size_t i = 0; i < frequency_count; i++) {
+        memcpy(&frequency, payload, sizeof(uint32_t));
+        payload += sizeof(uint32_t);
+        FrequencyList_push_back(
+            i < header->frequency_count ? instance->frequencies : instance->hopper_frequencies,
+            frequency);
+    }
+
+    if(header->default_frequency) {
+        for
+            M_EACH(item, instance->frequencies, FrequencyList_t) {
+                *item &= FREQUENCY_MASK;
+                if(*item == header->default_frequency) {
+                    *item |= FREQUENCY_FLAG_DEFAULT;
+                }
+            }
+    }
+
+    for(size_t i = 0; i < header->preset_count; i++) {
+        uint8_t name_size;
+        uint16_t data_size;
+
+        if(end - payload < (ptrdiff_t)sizeof(uint8_t)) return false;
+        name_size = *payload++;
+        if(end - payload < (ptrdiff_t)(name_size + sizeof(uint16_t))) return false;
+        const char* name = (const char*)payload;
+        payload += name_size;
+        memcpy(&data_size, payload, sizeof(uint16_t));
+        payload += sizeof(uint16_t);
+        if(!data_size || end - payload < (ptrdiff_t)data_size) return false;
+
+        SubGhzSettingCustomPresetItem* item =
+            SubGhzSettingCustomPresetItemArray_push_raw(instance->preset->data);
+        item->custom_preset_name = furi_string_alloc();
+        furi_string_set_strn(item->custom_preset_name, name, name_size);
+        item->custom_preset_data_size = data_size;
+        item->custom_preset_data = malloc(data_size);
+        memcpy(item->custom_preset_data, payload, data_size);
+        payload += data_size;
+    }
+
+    return payload == end;
+}
+
+static bool subghz_setting_cache_load(
+    SubGhzSetting* instance,
+    Storage* storage,
+    const char* cache_path,
+    const SubGhzSettingCacheHeader* key) {
+    File* file = storage_file_alloc(storage);
+    uint8_t* data = NULL;
+    bool success = false;
+
+    do {
+        if(!storage_file_open(file, cache_path, FSAM_READ, FSOM_OPEN_EXISTING)) break;
+
+        const uint64_t size = storage_file_size(file);
+        if(size < sizeof(SubGhzSettingCacheHeader) || size > SUBGHZ_SETTING_CACHE_SIZE_MAX) {
+            break;
+        }
+
+        // whole cache in one read
+        data = malloc(size);
+        if(storage_file_read(file, data, size) != size) break;
+
+        SubGhzSettingCacheHeader header;
+        memcpy(&header, data, sizeof(SubGhzSettingCacheHeader));
+        const uint8_t* payload = data + sizeof(SubGhzSettingCacheHeader);
+
+        if(header.magic != SUBGHZ_SETTING_CACHE_MAGIC ||
+           header.version != SUBGHZ_SETTING_CACHE_VERSION) {
+            FURI_LOG_I(TAG, "Cache version mismatch");
+            break;
+        }
+        if(header.source_size != key->source_size || header.source_crc != key->source_crc) {
+            FURI_LOG_I(TAG, "Cache is outdated");
+            break;
+        }
+        if(header.payload_size != size - sizeof(SubGhzSettingCacheHeader) ||
+           header.payload_crc != crc32_calc_buffer(0, payload, header.payload_size)) {
+            FURI_LOG_E(TAG, "Cache integrity error");
+            break;
+        }
+
+        // settings may be changed by now, caller loads them again
+        if(!subghz_setting_cache_apply(instance, &header, payload)) {
+            FURI_LOG_E(TAG, "Cache payload error");
+            break;
+        }
+
+        success = true;
+    } while(false);
+
+    free(data);
+    storage_file_close(file);
+    storage_file_free(file);
+    return success;
+}
+
+static void subghz_setting_cache_save(
+    SubGhzSetting* instance,
+    Storage* storage,
+    const char* cache_path,
+    SubGhzSettingCacheHeader* header) {
+    const size_t frequency_start =
+        FrequencyList_size(instance->frequencies) - header->frequency_count;
+    const size_t hopper_frequency_start =
+        FrequencyList_size(instance->hopper_frequencies) - header->hopper_frequency_count;
+    const size_t preset_start = SubGhzSettingCustomPresetItemArray_size(instance->preset->data) -
+                                header->preset_count;
+
+    size_t payload_size =
+        (header->frequency_count + header->hopper_frequency_count) * sizeof(uint32_t);
+    for(size_t i = preset_start; i < preset_start + header->preset_count; i++) {
+        SubGhzSettingCustomPresetItem* item =
+            SubGhzSettingCustomPresetItemArray_get(instance->preset->data, i);
+        if(furi_string_size(item->custom_preset_name) > UINT8_MAX ||
+           item->custom_preset_data_size > UINT16_MAX) {
+            FURI_LOG_I(TAG, "Preset can't be cached");
+            return;
+        }
+        payload_size += sizeof(uint8_t) + furi_string_size(item->custom_preset_name) +
+                        sizeof(uint16_t) + item->custom_preset_data_size;
+    }
+
+    const size_t size = sizeof(SubGhzSettingCacheHeader) + payload_size;
+    if(size > SUBGHZ_SETTING_CACHE_SIZE_MAX) return;
+
+    uint8_t* data = malloc(size);
+    uint8_t* payload = data + sizeof(SubGhzSettingCacheHeader);
+
+    for(size_t i = 0; i < header->frequency_count; i++) {
+        const uint32_t frequency =
+            *FrequencyList_get(instance->frequencies, frequency_start + i) & FREQUENCY_MASK;
+        memcpy(payload, &frequency, sizeof(uint32_t));
+        payload += sizeof(uint32_t);
+    }
+    for(size_t i = 0; i < header->hopper_frequency_count; i++) {
+        memcpy(
+            payload,
+            FrequencyList_get(instance->hopper_frequencies, hopper_frequency_start + i),
+            sizeof(uint32_t));
+        payload += sizeof(uint32_t);
+    }
+    for(size_t i = preset_start; i < preset_start + header->preset_count; i++) {
+        SubGhzSettingCustomPresetItem* item =
+            SubGhzSettingCustomPresetItemArray_get(instance->preset->data, i);
+        const uint8_t name_size = furi_string_size(item->custom_preset_name);
+        const uint16_t data_size = item->custom_preset_data_size;
+
+        *payload++ = name_size;
+        memcpy(payload, furi_string_get_cstr(item->custom_preset_name), name_size);
+        payload += name_size;
+        memcpy(payload, &data_size, sizeof(uint16_t));
+        payload += sizeof(uint16_t);
+        memcpy(payload, item->custom_preset_data, data_size);
+        payload += data_size;
+    }
+
+    header->magic = SUBGHZ_SETTING_CACHE_MAGIC;
+    header->version = SUBGHZ_SETTING_CACHE_VERSION;
+    header->payload_size = payload_size;
+    header->payload_crc =
+        crc32_calc_buffer(0, data + sizeof(SubGhzSettingCacheHeader), payload_size);
+    memcpy(data, header, sizeof(SubGhzSettingCacheHeader));
+
+    File* file = storage_file_alloc(storage);
+    bool success = storage_file_open(file, cache_path, FSAM_WRITE, FSOM_CREATE_ALWAYS) &&
+                   storage_file_write(file, data, size) == size;
+    storage_file_close(file);
+    storage_file_free(file);
+    free(data);
+
+    if(success) {
+        FURI_LOG_I(TAG, "Cache saved %s", cache_path);
+    } else {
+        FURI_LOG_E(TAG, "Cache write error %s", cache_path);
+        storage_simply_remove(storage, cache_path);
+    }
+}
+
+/* Parses setting file on top of default settings, header gets what it added */
+static bool subghz_setting_load_file(
+    SubGhzSetting* instance,
+    Storage* storage,
+    const char* file_path,
+    SubGhzSettingCacheHeader* header) {
     FlipperFormat* fff_data_file = flipper_format_file_alloc(storage);
 
     FuriString* temp_str;
     temp_str = furi_string_alloc();
     uint32_t temp_data32;
     bool temp_bool;
+    bool success = false;
 
-    subghz_setting_load_default(instance);
+    do {
+        if(!flipper_format_file_open_existing(fff_data_file, file_path)) {
+            FURI_LOG_I(TAG, "File is not used %s", file_path);
+            break;
+        }
 
-    if(file_path) {
-        do {
-            if(!flipper_format_file_open_existing(fff_data_file, file_path)) {
-                FURI_LOG_I(TAG, "File is not used %s", file_path);
-                break;
-            }
+        if(!flipper_format_read_header(fff_data_file, temp_str, &temp_data32)) {
+            FURI_LOG_E(TAG, "Missing or incorrect header");
+            break;
+        }
 
-            if(!flipper_format_read_header(fff_data_file, temp_str, &temp_data32)) {
-                FURI_LOG_E(TAG, "Missing or incorrect header");
-                break;
-            }
+        if((!strcmp(furi_string_get_cstr(temp_str), SUBGHZ_SETTING_FILE_TYPE)) &&
+           temp_data32 == SUBGHZ_SETTING_FILE_VERSION) {
+        } else {
+            FURI_LOG_E(TAG, "Type or version mismatch");
+            break;
+        }
 
-            if((!strcmp(furi_string_get_cstr(temp_str), SUBGHZ_SETTING_FILE_TYPE)) &&
-               temp_data32 == SUBGHZ_SETTING_FILE_VERSION) {
+        // Standard frequencies (optional)
+        temp_bool = true;
+        flipper_format_read_bool(fff_data_file, "Add_standard_frequencies", &temp_bool, 1);
+        if(!temp_bool) {
+            FURI_LOG_I(TAG, "Removing standard frequencies");
+            FrequencyList_reset(instance->frequencies);
+            FrequencyList_reset(instance->hopper_frequencies);
+        } else {
+            FURI_LOG_I(TAG, "Keeping standard frequencies");
+            header->flags |= SUBGHZ_SETTING_CACHE_FLAG_STANDARD_FREQUENCIES;
+        }
+
+        // Load frequencies
+        if(!flipper_format_rewind(fff_data_file)) {
+            FURI_LOG_E(TAG, "Rewind error");
+            break;
+        }
+        while(flipper_format_read_uint32(
+            fff_data_file, "Frequency", (uint32_t*)&temp_data32, 1)) {
+            //Todo FL-3535: add a frequency support check depending on the selected radio device
+            if(furi_hal_subghz_is_frequency_valid(temp_data32)) {
+                FURI_LOG_I(TAG, "Frequency loaded %" PRIu32, temp_data32);
+                FrequencyList_push_back(instance->frequencies, temp_data32);
+                header->frequency_count++;
             } else {
-                FURI_LOG_E(TAG, "Type or version mismatch");
-                break;
+                FURI_LOG_E(TAG, "Frequency not supported %" PRIu32, temp_data32);
             }
+        }
 
-            // Standard frequencies (optional)
-            temp_bool = true;
-            flipper_format_read_bool(fff_data_file, "Add_standard_frequencies", &temp_bool, 1);
-            if(!temp_bool) {
-                FURI_LOG_I(TAG, "Removing standard frequencies");
-                FrequencyList_reset(instance->frequencies);
-                FrequencyList_reset(instance->hopper_frequencies);
+        // Load hopper frequencies
+        if(!flipper_format_rewind(fff_data_file)) {
+            FURI_LOG_E(TAG, "Rewind error");
+            break;
+        }
+        while(flipper_format_read_uint32(
+            fff_data_file, "Hopper_frequency", (uint32_t*)&temp_data32, 1)) {
+            if(furi_hal_subghz_is_frequency_valid(temp_data32)) {
+                FURI_LOG_I(TAG, "Hopper frequency loaded %" PRIu32, temp_data32);
+                FrequencyList_push_back(instance->hopper_frequencies, temp_data32);
+                header->hopper_frequency_count++;
             } else {
-                FURI_LOG_I(TAG, "Keeping standard frequencies");
+                FURI_LOG_E(TAG, "Hopper frequency not supported %" PRIu32, temp_data32);
             }
+        }
 
-            // Load frequencies
-            if(!flipper_format_rewind(fff_data_file)) {
-                FURI_LOG_E(TAG, "Rewind error");
-                break;
-            }
-            while(flipper_format_read_uint32(
-                fff_data_file, "Frequency", (uint32_t*)&temp_data32, 1)) {
-                //Todo FL-3535: add a frequency support check depending on the selected radio device
-                if(furi_hal_subghz_is_frequency_valid(temp_data32)) {
-                    FURI_LOG_I(TAG, "Frequency loaded %lu", temp_data32);
-                    FrequencyList_push_back(instance->frequencies, temp_data32);
-                } else {
-                    FURI_LOG_E(TAG, "Frequency not supported %lu", temp_data32);
+        // Default frequency (optional)
+        if(!flipper_format_rewind(fff_data_file)) {
+            FURI_LOG_E(TAG, "Rewind error");
+            break;
+        }
+        if(flipper_format_read_uint32(fff_data_file, "Default_frequency", &temp_data32, 1)) {
+            for
+                M_EACH(frequency, instance->frequencies, FrequencyList_t) {
+                    *frequency &= FREQUENCY_MASK;
+                    if(*frequency == temp_data32) {
+                        *frequency |= FREQUENCY_FLAG_DEFAULT;
+                    }
                 }
-            }
+            header->default_frequency = temp_data32;
+        }
 
-            // Load hopper frequencies
-            if(!flipper_format_rewind(fff_data_file)) {
-                FURI_LOG_E(TAG, "Rewind error");
-                break;
-            }
-            while(flipper_format_read_uint32(
-                fff_data_file, "Hopper_frequency", (uint32_t*)&temp_data32, 1)) {
-                if(furi_hal_subghz_is_frequency_valid(temp_data32)) {
-                    FURI_LOG_I(TAG, "Hopper frequency loaded %lu", temp_data32);
-                    FrequencyList_push_back(instance->hopper_frequencies, temp_data32);
-                } else {
-                    FURI_LOG_E(TAG, "Hopper frequency not supported %lu", temp_data32);
-                }
-            }
+        // custom preset (optional)
+        if(!flipper_format_rewind(fff_data_file)) {
+            FURI_LOG_E(TAG, "Rewind error");
+            break;
+        }
+        // preset that failed to load is kept half-filled, such file is not cached
+        success = true;
+        while(flipper_format_read_string(fff_data_file, "Custom_preset_name", temp_str)) {
+            FURI_LOG_I(TAG, "Custom preset loaded %s", furi_string_get_cstr(temp_str));
+            success &= subghz_setting_load_custom_preset(
+                instance, furi_string_get_cstr(temp_str), fff_data_file);
+            header->preset_count++;
+        }
+    } while(false);
 
-            // Default frequency (optional)
-            if(!flipper_format_rewind(fff_data_file)) {
-                FURI_LOG_E(TAG, "Rewind error");
-                break;
-            }
-            if(flipper_format_read_uint32(fff_data_file, "Default_frequency", &temp_data32, 1)) {
-                for
-                    M_EACH(frequency, instance->frequencies, FrequencyList_t) {
-                        *frequency &= FREQUENCY_MASK;
-                        if(*frequency == temp_data32) {
-                            *frequency |= FREQUENCY_FLAG_DEFAULT;
-                        }
-                    }
-            }
+    furi_string_free(temp_str);
+    flipper_format_free(fff_data_file);
 
-            // custom preset (optional)
-            if(!flipper_format_rewind(fff_data_file)) {
-                FURI_LOG_E(TAG, "Rewind error");
-                break;
-            }
-            while(flipper_format_read_string(fff_data_file, "Custom_preset_name", temp_str)) {
-                FURI_LOG_I(TAG, "Custom preset loaded %s", furi_string_get_cstr(temp_str));
-                subghz_setting_load_custom_preset(
-                    instance, furi_string_get_cstr(temp_str), fff_data_file);
+    return success;
+}
+
+void subghz_setting_load(SubGhzSetting* instance, const char* file_path) {
+    furi_assert(instance);
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+
+    subghz_setting_load_default(instance);
+
+    if(file_path) {
+        FuriString* cache_path =
+            furi_string_alloc_printf("%s%s", file_path, SUBGHZ_SETTING_CACHE_EXTENSION);
+
+        const char* cache = furi_string_get_cstr(cache_path);
+        SubGhzSettingCacheHeader header = {0};
+
+        // Cache is valid for the setting file it was made of
+        const bool has_key = subghz_setting_cache_get_key(storage, file_path, &header);
+        if(has_key && subghz_setting_cache_load(instance, storage, cache, &header)) {
+            FURI_LOG_I(TAG, "Loaded from cache %s", cache);
+        } else {
+            subghz_setting_load_default(instance);
+            if(subghz_setting_load_file(instance, storage, file_path, &header) && has_key) {
+                subghz_setting_cache_save(instance, storage, cache, &header);
             }
+        }
 
-        } while(false);
+        furi_string_free(cache_path);
     }
 
-    furi_string_free(temp_str);
-    flipper_format_free(fff_data_file);
     furi_record_close(RECORD_STORAGE);
 
     if(!FrequencyList_size(instance->frequencies) ||
@@ -4,9 +4,14 @@
 
 #define TAG "SubGhzWorker"
 
+typedef enum {
+    SubGhzWorkerFlagStop = (1 << 0),
+} SubGhzWorkerFlag;
+
 struct SubGhzWorker {
     FuriThread* thread;
     FuriStreamBuffer* stream;
+    FuriEventLoop* event_loop;
 
     volatile bool running;
     volatile bool overrun;
@@ -38,43 +43,73 @@ void subghz_worker_rx_callback(bool level, uint32_t duration, void* context) {
     if(sizeof(LevelDuration) != ret) instance->overrun = true;
 }
 
-/** Worker callback thread
+/** Stream buffer In event callback
  * 
+ * @param stream stream buffer with received level durations
  * @param context 
- * @return exit code 
  */
-static int32_t subghz_worker_thread_callback(void* context) {
+static void subghz_worker_stream_callback(FuriStreamBuffer* stream, void* context) {
     SubGhzWorker* instance = context;
 
     LevelDuration level_duration;
-    while(instance->running) {
-        int ret = furi_stream_buffer_receive(
-            instance->stream, &level_duration, sizeof(LevelDuration), 10);
-        if(ret == sizeof(LevelDuration)) {
-            if(level_duration_is_reset(level_duration)) {
-                FURI_LOG_E(TAG, "Overrun buffer");
-                if(instance->overrun_callback) instance->overrun_callback(instance->context);
-            } else {
-                bool level = level_duration_get_level(level_duration);
-                uint32_t duration = level_duration_get_duration(level_duration);
-
-                if((duration < instance->filter_duration) ||
-                   (instance->filter_level_duration.level == level)) {
-                    instance->filter_level_duration.duration += duration;
-
-                } else if(instance->filter_level_duration.level != level) {
-                    if(instance->pair_callback)
-                        instance->pair_callback(
-                            instance->context,
-                            instance->filter_level_duration.level,
-                            instance->filter_level_duration.duration);
-
-                    instance->filter_level_duration.duration = duration;
-                    instance->filter_level_duration.level = level;
-                }
+    while(furi_stream_buffer_receive(stream, &level_duration, sizeof(LevelDuration), 0) ==
+          sizeof(LevelDuration)) {
+        if(level_duration_is_reset(level_duration)) {
+            FURI_LOG_E(TAG, "Overrun buffer");
+            if(instance->overrun_callback) instance->overrun_callback(instance->context);
+        } else {
+            bool level = level_duration_get_level(level_duration);
+            uint32_t duration = level_duration_get_duration(level_duration);
+
+            if((duration < instance->filter_duration) ||
+               (instance->filter_level_duration.level == level)) {
+                instance->filter_level_duration.duration += duration;
+
+            } else if(instance->filter_level_duration.level != level) {
+                if(instance->pair_callback)
+                    instance->pair_callback(
+                        instance->context,
+                        instance->filter_level_duration.level,
+                        instance->filter_level_duration.duration);
+
+                instance->filter_level_duration.duration = duration;
+                instance->filter_level_duration.level = level;
             }
         }
     }
+}
+
+static void subghz_worker_stop_callback(uint32_t flags, void* context) {
+    UNUSED(flags);
+    SubGhzWorker* instance = context;
+    furi_event_loop_stop(instance->event_loop);
+}
+
+/** Worker callback thread
+ * 
+ * @param context 
+ * @return exit code 
+ */
+static int32_t subghz_worker_thread_callback(void* context) {
+    SubGhzWorker* instance = context;
+
+    instance->event_loop = furi_event_loop_alloc();
+    furi_event_loop_stream_buffer_subscribe(
+        instance->event_loop,
+        instance->stream,
+        FuriEventLoopEventIn,
+        subghz_worker_stream_callback,
+        instance);
+    furi_event_loop_thread_flags_subscribe(
+        instance->event_loop, SubGhzWorkerFlagStop, subghz_worker_stop_callback, instance);
+
+    furi_event_loop_run(instance->event_loop);
+
+    furi_event_loop_thread_flags_unsubscribe(instance->event_loop);
+    furi_event_loop_stream_buffer_unsubscribe(
+        instance->event_loop, instance->stream, FuriEventLoopEventIn);
+    furi_event_loop_free(instance->event_loop);
+    instance->event_loop = NULL;
 
     return 0;
 }
@@ -135,6 +170,7 @@ void subghz_worker_stop(SubGhzWorker* instance) {
 
     instance->running = false;
 
+    furi_thread_flags_set(furi_thread_get_id(instance->thread), SubGhzWorkerFlagStop);
     furi_thread_join(instance->thread);
 }
 
@@ -1,11 +1,37 @@
 #include "profiler.h"
+#include <inttypes.h>
 #include <stdlib.h>
 #include <m-dict.h>
 #include <furi.h>
-#include <furi_hal_gpio.h>
+
+#if defined(__arm__)
+#include <furi_hal_cortex.h>
+#include <stm32wbxx.h>
+
+static inline ProfilerTicks profiler_get_ticks(void) {
+    return DWT->CYCCNT;
+}
+
+static inline uint32_t profiler_get_ticks_per_us(void) {
+    return furi_hal_cortex_instructions_per_microsecond();
+}
+#else
+#include <time.h>
+
+static inline ProfilerTicks profiler_get_ticks(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+}
+
+static inline uint32_t profiler_get_ticks_per_us(void) {
+    return 1000;
+}
+#endif
 
 typedef struct {
-    uint32_t start;
+    ProfilerTicks start;
+    bool started;
     uint32_t length;
     uint32_t count;
 } ProfilerRecord;
@@ -31,6 +57,7 @@ void profiler_free(Profiler* profiler) {
 void profiler_prealloc(Profiler* profiler, const char* key) {
     ProfilerRecord record = {
         .start = 0,
+        .started = false,
         .length = 0,
         .count = 0,
     };
@@ -45,16 +72,18 @@ void profiler_start(Profiler* profiler, const char* key) {
         record = ProfilerRecordDict_get(profiler->records, key);
     }
 
-    furi_check(record->start == 0);
-    record->start = DWT->CYCCNT;
+    furi_check(!record->started);
+    record->started = true;
+    record->start = profiler_get_ticks();
 }
 
 void profiler_stop(Profiler* profiler, const char* key) {
     ProfilerRecord* record = ProfilerRecordDict_get(profiler->records, key);
     furi_check(record != NULL);
+    furi_check(record->started);
 
-    record->length += DWT->CYCCNT - record->start;
-    record->start = 0;
+    record->length += (uint32_t)(profiler_get_ticks() - record->start);
+    record->started = false;
     record->count++;
 }
 
@@ -73,7 +102,14 @@ void profiler_dump(Profiler* profiler) {
         double ms = (double)clocks / (double)64000.0;
         double s = (double)clocks / (double)64000000.0;
 
-        printf("\t%s[%lu]: %f s, %f ms, %f us, %lu clk\r\n", itref->key, count, s, ms, us, clocks);
+        printf(
+            "\t%s[%" PRIu32 "]: %f s, %f ms, %f us, %" PRIu32 " clk\r\n",
+            itref->key,
+            count,
+            s,
+            ms,
+            us,
+            clocks);
 
         if(count > 1) {
             us /= (double)count;
@@ -81,7 +117,116 @@ void profiler_dump(Profiler* profiler) {
             s /= (double)count;
             clocks /= count;
 
-            printf("\t%s[1]: %f s, %f ms, %f us, %lu clk\r\n", itref->key, s, ms, us, clocks);
+            printf(
+                "\t%s[1]: %f s, %f ms, %f us, %" PRIu32 " clk\r\n", itref->key, s, ms, us, clocks);
+        }
+    }
+}
+
+/* Static probes */
+
+typedef struct {
+    volatile bool enabled;
+    ProfilerProbeStats stats[ProfilerProbeNum];
+} ProfilerProbes;
+
+static ProfilerProbes profiler_probes = {0};
+
+static const char* const profiler_probe_names[ProfilerProbeNum] = {
+    [ProfilerProbeSubGhzReceiverDecode] = "subghz_receiver_decode",
+    [ProfilerProbeProtocolDictDecodersFeed] = "protocol_dict_decoders_feed",
+    [ProfilerProbeNfcPollerHandler] = "nfc_poller_handler",
+    [ProfilerProbeNfcListenerHandler] = "nfc_listener_handler",
+    [ProfilerProbeGuiRedraw] = "gui_redraw",
+    [ProfilerProbeStorageProcessMessage] = "storage_process_message",
+    [ProfilerProbeNfcListenerResponse] = "nfc_listener_response",
+};
+
+void profiler_probe_enable(bool enable) {
+    if(enable) profiler_probe_reset();
+    profiler_probes.enabled = enable;
+}
+
+bool profiler_probe_is_enabled(void) {
+    return profiler_probes.enabled;
+}
+
+void profiler_probe_reset(void) {
+    FURI_CRITICAL_ENTER();
+    memset(profiler_probes.stats, 0, sizeof(profiler_probes.stats));
+    FURI_CRITICAL_EXIT();
+}
+
+ProfilerProbeStart profiler_probe_begin(void) {
+    if(!profiler_probes.enabled) return (ProfilerProbeStart){0};
+    return (ProfilerProbeStart){.ticks = profiler_get_ticks(), .valid = true};
+}
+
+void profiler_probe_end(ProfilerProbe probe, ProfilerProbeStart begin) {
+    // Begin is not valid when probes were enabled in between
+    if(!profiler_probes.enabled || !begin.valid) return;
+    furi_check(probe < ProfilerProbeNum);
+
+    ProfilerTicks ticks = profiler_get_ticks() - begin.ticks;
+    uint32_t duration = ticks > UINT32_MAX ? UINT32_MAX : (uint32_t)ticks;
+
+    size_t bucket = 0;
+    if(duration >> (PROFILER_PROBE_HISTOGRAM_SHIFT + 1)) {
+        bucket = 31 - __builtin_clz(duration) - PROFILER_PROBE_HISTOGRAM_SHIFT;
+        bucket = MIN(bucket, PROFILER_PROBE_HISTOGRAM_SIZE - 1);
+    }
+
+    FURI_CRITICAL_ENTER();
+    ProfilerProbeStats* stats = &profiler_probes.stats[probe];
+    if(stats->count == 0 || duration < stats->min) stats->min = duration;
+    if(duration > stats->max) stats->max = duration;
+    stats->total += duration;
+    stats->count++;
+    stats->histogram[bucket]++;
+    FURI_CRITICAL_EXIT();
+}
+
+const char* profiler_probe_get_name(ProfilerProbe probe) {
+    furi_check(probe < ProfilerProbeNum);
+    return profiler_probe_names[probe];
+}
+
+void profiler_probe_get_stats(ProfilerProbe probe, ProfilerProbeStats* stats) {
+    furi_check(probe < ProfilerProbeNum);
+    furi_check(stats);
+
+    FURI_CRITICAL_ENTER();
+    *stats = profiler_probes.stats[probe];
+    FURI_CRITICAL_EXIT();
+}
+
+uint32_t profiler_probe_get_ticks_per_us(void) {
+    return profiler_get_ticks_per_us();
+}
+
+void profiler_probe_dump(void) {
+    const uint32_t ticks_per_us = profiler_get_ticks_per_us();
+    ProfilerProbeStats stats;
+
+    printf("Probes %s, times in us\r\n", profiler_probes.enabled ? "enabled" : "disabled");
+    printf("%-28s %-8s %-8s %-8s %-8s\r\n", "Probe", "Count", "Min", "Mean", "Max");
+
+    for(size_t i = 0; i < ProfilerProbeNum; i++) {
+        profiler_probe_get_stats(i, &stats);
+        if(stats.count == 0) continue;
+
+        printf(
+            "%-28s %-8" PRIu32 " %-8" PRIu32 " %-8" PRIu32 " %-8" PRIu32 "\r\n",
+            profiler_probe_names[i],
+            stats.count,
+            stats.min / ticks_per_us,
+            (uint32_t)(stats.total / stats.count / ticks_per_us),
+            stats.max / ticks_per_us);
+
+        printf("  histogram:");
+        for(size_t j = 0; j < PROFILER_PROBE_HISTOGRAM_SIZE; j++) {
+            printf(" %" PRIu32, stats.histogram[j]);
         }
+        printf("\r\n");
     }
 }
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <stdbool.h>
+#include <stdint.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -18,6 +21,101 @@ void profiler_stop(Profiler* profiler, const char* key);
 
 void profiler_dump(Profiler* profiler);
 
+/** Static probes placed in hot paths, storage for them is preallocated */
+typedef enum {
+    ProfilerProbeSubGhzReceiverDecode,
+    ProfilerProbeProtocolDictDecodersFeed,
+    ProfilerProbeNfcPollerHandler,
+    ProfilerProbeNfcListenerHandler,
+    ProfilerProbeGuiRedraw,
+    ProfilerProbeStorageProcessMessage,
+    ProfilerProbeNfcListenerResponse, /**< listener frame reception to response ready for tx */
+
+    ProfilerProbeNum,
+} ProfilerProbe;
+
+/** Histogram bucket 0 counts durations shorter than 2^(SHIFT+1) ticks, bucket N
+ * counts [2^(N+SHIFT), 2^(N+SHIFT+1)), last bucket counts everything longer */
+#define PROFILER_PROBE_HISTOGRAM_SIZE (16U)
+#define PROFILER_PROBE_HISTOGRAM_SHIFT (6U)
+
+typedef struct {
+    uint32_t count; /**< samples taken */
+    uint32_t min; /**< shortest duration, ticks */
+    uint32_t max; /**< longest duration, ticks */
+    uint64_t total; /**< sum of durations, ticks */
+    uint32_t histogram[PROFILER_PROBE_HISTOGRAM_SIZE]; /**< log2 duration histogram */
+} ProfilerProbeStats;
+
+/** Probe timestamp, CPU cycle counter on target, 64-bit nanoseconds on host */
+#if defined(__arm__)
+typedef uint32_t ProfilerTicks;
+#else
+typedef uint64_t ProfilerTicks;
+#endif
+
+/** Probe start, returned by profiler_probe_begin */
+typedef struct {
+    ProfilerTicks ticks; /**< timestamp */
+    bool valid; /**< probes were enabled at begin, false in zero initialized start */
+} ProfilerProbeStart;
+
+/** Enable or disable probes, enabling clears collected samples
+ *
+ * Disabled probes cost one flag check
+ *
+ * @param      enable  true to enable
+ */
+void profiler_probe_enable(bool enable);
+
+/** Check if probes are enabled
+ *
+ * @return     true if enabled
+ */
+bool profiler_probe_is_enabled(void);
+
+/** Clear samples of all probes */
+void profiler_probe_reset(void);
+
+/** Take probe start timestamp, can be used from ISR
+ *
+ * @return     start to pass to profiler_probe_end, not valid if probes are disabled
+ */
+ProfilerProbeStart profiler_probe_begin(void);
+
+/** Account duration since profiler_probe_begin to the probe, can be used from ISR
+ *
+ * Invalid start is ignored. Durations longer than UINT32_MAX ticks are clamped.
+ *
+ * @param      probe  The probe
+ * @param      begin  Value returned by profiler_probe_begin
+ */
+void profiler_probe_end(ProfilerProbe probe, ProfilerProbeStart begin);
+
+/** Get probe name
+ *
+ * @param      probe  The probe
+ *
+ * @return     name of the probed function
+ */
+const char* profiler_probe_get_name(ProfilerProbe probe);
+
+/** Get consistent snapshot of probe samples
+ *
+ * @param      probe  The probe
+ * @param      stats  The stats to fill
+ */
+void profiler_probe_get_stats(ProfilerProbe probe, ProfilerProbeStats* stats);
+
+/** Get probe timestamp resolution: CPU cycles on target, nanoseconds on host
+ *
+ * @return     ticks per microsecond
+ */
+uint32_t profiler_probe_get_ticks_per_us(void);
+
+/** Print all probe samples to stdout */
+void profiler_probe_dump(void);
+
 #ifdef __cplusplus
 }
-#endif
\ No newline at end of file
+#endif
@@ -12,6 +12,14 @@ typedef uint8_t* (*ProtocolGetData)(void* protocol);
 typedef void (*ProtocolDecoderStart)(void* protocol);
 typedef bool (*ProtocolDecoderFeed)(void* protocol, bool level, uint32_t duration);
 
+typedef enum {
+    ProtocolDecoderStateCandidate, /**< Decoder may match the stream, needs every edge */
+    ProtocolDecoderStateLocked, /**< Decoder is in sync with the stream, needs every edge */
+    ProtocolDecoderStateIdle, /**< Edges out of decoder sync window don't change it */
+} ProtocolDecoderState;
+
+typedef ProtocolDecoderState (*ProtocolDecoderGetState)(void* protocol);
+
 typedef bool (*ProtocolEncoderStart)(void* protocol);
 typedef LevelDuration (*ProtocolEncoderYield)(void* protocol);
 
@@ -28,6 +36,17 @@ typedef struct {
     ProtocolEncoderYield yield;
 } ProtocolEncoder;
 
+/**
+ * Optional decoder activity report. Dict does not feed idle decoder with edges
+ * out of [min_duration, max_duration], so decoder must report idle only when
+ * these edges would not change its output. First edge in the window re-arms it.
+ */
+typedef struct {
+    ProtocolDecoderGetState get_state;
+    uint32_t min_duration;
+    uint32_t max_duration;
+} ProtocolDecoderActivity;
+
 typedef struct {
     const size_t data_size;
     const char* name;
@@ -43,4 +62,5 @@ typedef struct {
     ProtocolRenderData render_data;
     ProtocolRenderData render_brief_data;
     ProtocolWriteData write_data;
+    ProtocolDecoderActivity decoder_activity;
 } ProtocolBase;
\ No newline at end of file
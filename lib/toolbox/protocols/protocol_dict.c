@@ -1,10 +1,12 @@
 #include <furi.h>
 #include "protocol_dict.h"
+#include "../profiler.h"
 
 struct ProtocolDict {
     const ProtocolBase** base;
     size_t count;
     void** data;
+    bool* idle;
 };
 
 ProtocolDict* protocol_dict_alloc(const ProtocolBase** protocols, size_t count) {
@@ -12,9 +14,11 @@ ProtocolDict* protocol_dict_alloc(const ProtocolBase** protocols, size_t count)
     dict->base = protocols;
     dict->count = count;
     dict->data = malloc(sizeof(void*) * dict->count);
+    dict->idle = malloc(sizeof(bool) * dict->count);
 
     for(size_t i = 0; i < dict->count; i++) {
         dict->data[i] = dict->base[i]->alloc();
+        dict->idle[i] = false;
     }
 
     return dict;
@@ -25,6 +29,7 @@ void protocol_dict_free(ProtocolDict* dict) {
         dict->base[i]->free(dict->data[i]);
     }
 
+    free(dict->idle);
     free(dict->data);
     free(dict);
 }
@@ -89,23 +94,60 @@ void protocol_dict_decoders_start(ProtocolDict* dict) {
         if(fn) {
             fn(dict->data[i]);
         }
+        dict->idle[i] = false;
     }
 }
 
+void protocol_dict_decoders_start_by_id(ProtocolDict* dict, size_t protocol_index) {
+    furi_assert(protocol_index < dict->count);
+
+    ProtocolDecoderStart fn = dict->base[protocol_index]->decoder.start;
+
+    if(fn) {
+        fn(dict->data[protocol_index]);
+    }
+    dict->idle[protocol_index] = false;
+}
+
 uint32_t protocol_dict_get_features(ProtocolDict* dict, size_t protocol_index) {
     furi_assert(protocol_index < dict->count);
     return dict->base[protocol_index]->features;
 }
 
+// Edge out of sync window is skipped while decoder is idle, decoder stays idle until it's fed
+static bool protocol_dict_decoder_feed(
+    ProtocolDict* dict,
+    size_t protocol_index,
+    bool level,
+    uint32_t duration) {
+    const ProtocolBase* base = dict->base[protocol_index];
+    const ProtocolDecoderActivity* activity = &base->decoder_activity;
+
+    if(activity->get_state &&
+       (duration < activity->min_duration || duration > activity->max_duration)) {
+        if(!dict->idle[protocol_index]) {
+            dict->idle[protocol_index] =
+                activity->get_state(dict->data[protocol_index]) == ProtocolDecoderStateIdle;
+        }
+        if(dict->idle[protocol_index]) return false;
+    } else {
+        // sync edge re-arms idle decoder
+        dict->idle[protocol_index] = false;
+    }
+
+    return base->decoder.feed(dict->data[protocol_index], level, duration);
+}
+
 ProtocolId protocol_dict_decoders_feed(ProtocolDict* dict, bool level, uint32_t duration) {
     bool done = false;
     ProtocolId ready_protocol_id = PROTOCOL_NO;
+    ProfilerProbeStart probe = profiler_probe_begin();
 
     for(size_t i = 0; i < dict->count; i++) {
         ProtocolDecoderFeed fn = dict->base[i]->decoder.feed;
 
         if(fn) {
-            if(fn(dict->data[i], level, duration)) {
+            if(protocol_dict_decoder_feed(dict, i, level, duration)) {
                 if(!done) {
                     ready_protocol_id = i;
                     done = true;
@@ -114,6 +156,7 @@ ProtocolId protocol_dict_decoders_feed(ProtocolDict* dict, bool level, uint32_t
         }
     }
 
+    profiler_probe_end(ProfilerProbeProtocolDictDecodersFeed, probe);
     return ready_protocol_id;
 }
 
@@ -131,7 +174,7 @@ ProtocolId protocol_dict_decoders_feed_by_feature(
             ProtocolDecoderFeed fn = dict->base[i]->decoder.feed;
 
             if(fn) {
-                if(fn(dict->data[i], level, duration)) {
+                if(protocol_dict_decoder_feed(dict, i, level, duration)) {
                     if(!done) {
                         ready_protocol_id = i;
                         done = true;
@@ -155,7 +198,7 @@ ProtocolId protocol_dict_decoders_feed_by_id(
     ProtocolDecoderFeed fn = dict->base[protocol_index]->decoder.feed;
 
     if(fn) {
-        if(fn(dict->data[protocol_index], level, duration)) {
+        if(protocol_dict_decoder_feed(dict, protocol_index, level, duration)) {
             ready_protocol_id = protocol_index;
         }
     }
@@ -163,6 +206,17 @@ ProtocolId protocol_dict_decoders_feed_by_id(
     return ready_protocol_id;
 }
 
+ProtocolDecoderState protocol_dict_decoders_get_state(ProtocolDict* dict, size_t protocol_index) {
+    furi_assert(protocol_index < dict->count);
+    ProtocolDecoderGetState fn = dict->base[protocol_index]->decoder_activity.get_state;
+
+    if(fn) {
+        return fn(dict->data[protocol_index]);
+    } else {
+        return ProtocolDecoderStateCandidate;
+    }
+}
+
 bool protocol_dict_encoder_start(ProtocolDict* dict, size_t protocol_index) {
     furi_assert(protocol_index < dict->count);
     ProtocolEncoderStart fn = dict->base[protocol_index]->encoder.start;
@@ -38,6 +38,8 @@ const char* protocol_dict_get_manufacturer(ProtocolDict* dict, size_t protocol_i
 
 void protocol_dict_decoders_start(ProtocolDict* dict);
 
+void protocol_dict_decoders_start_by_id(ProtocolDict* dict, size_t protocol_index);
+
 uint32_t protocol_dict_get_features(ProtocolDict* dict, size_t protocol_index);
 
 ProtocolId protocol_dict_decoders_feed(ProtocolDict* dict, bool level, uint32_t duration);
@@ -54,6 +56,9 @@ ProtocolId protocol_dict_decoders_feed_by_id(
     bool level,
     uint32_t duration);
 
+/** Decoder state reported by protocol, candidate if protocol doesn't report it */
+ProtocolDecoderState protocol_dict_decoders_get_state(ProtocolDict* dict, size_t protocol_index);
+
 bool protocol_dict_encoder_start(ProtocolDict* dict, size_t protocol_index);
 
 LevelDuration protocol_dict_encoder_yield(ProtocolDict* dict, size_t protocol_index);
@@ -0,0 +1,197 @@
+#!/usr/bin/env python3
+
+import os
+import struct
+import zlib
+
+from flipper.app import App
+
+EMV_RESOURCES_HEADER = "Flipper EMV resources"
+EMV_RESOURCES_VERSION = 1
+EMV_RESOURCES = ["aid", "country_code", "currency_code"]
+
+INDEX_MAGIC = 0x49564D45  # "EMVI"
+INDEX_VERSION = 2
+INDEX_HEADER = struct.Struct("<IBBHIII")
+INDEX_NAME_OFFSET = struct.Struct("<I")
+
+
+class EmvIndexError(Exception):
+    pass
+
+
+def parse_resource(path):
+    entries = {}
+    with open(path, "rb") as f:
+        raw = f.read()
+    lines = raw.decode("utf-8").splitlines()
+
+    if len(lines) < 2:
+        raise EmvIndexError(f"{path}: missing header")
+    if lines[0] != f"Filetype: {EMV_RESOURCES_HEADER}":
+        raise EmvIndexError(f"{path}: unexpected filetype")
+    if lines[1] != f"Version: {EMV_RESOURCES_VERSION}":
+        raise EmvIndexError(f"{path}: unexpected version")
+
+    for line_num, line in enumerate(lines[2:], start=3):
+        if not line or line.startswith("#"):
+            continue
+        key, sep, name = line.partition(": ")
+        if not sep:
+            raise EmvIndexError(f"{path}:{line_num}: missing separator")
+        try:
+            key = bytes.fromhex(key)
+        except ValueError:
+            raise EmvIndexError(f"{path}:{line_num}: key is not hex")
+        name = name.encode("utf-8")
+        if not key or len(key) > 255 or len(name) > 255:
+            raise EmvIndexError(f"{path}:{line_num}: key or name is too long")
+        # Text lookup returns the first match, so later duplicates are unreachable
+        entries.setdefault(key, name)
+
+    return entries, (len(raw), zlib.crc32(raw))
+
+
+def sort_key(key, key_size):
+    return bytes([len(key)]) + key.ljust(key_size, b"\0")
+
+
+def build_index(entries, source_id):
+    key_size = max(map(len, entries), default=1)
+    records = bytearray()
+    names = bytearray()
+    for key in sorted(entries, key=lambda key: sort_key(key, key_size)):
+        records += sort_key(key, key_size)
+        records += INDEX_NAME_OFFSET.pack(len(names))
+        names.append(len(entries[key]))
+        names += entries[key]
+
+    header = INDEX_HEADER.pack(
+        INDEX_MAGIC, INDEX_VERSION, key_size, 0, len(entries), *source_id
+    )
+    return header + records + names
+
+
+def parse_index(data):
+    if len(data) < INDEX_HEADER.size:
+        raise EmvIndexError("index is truncated")
+    (
+        magic,
+        version,
+        key_size,
+        _,
+        record_count,
+        source_size,
+        source_crc,
+    ) = INDEX_HEADER.unpack_from(data)
+    if magic != INDEX_MAGIC or version != INDEX_VERSION or key_size == 0:
+        raise EmvIndexError("unexpected index header")
+
+    record_size = 1 + key_size + INDEX_NAME_OFFSET.size
+    names_offset = INDEX_HEADER.size + record_count * record_size
+    if names_offset > len(data):
+        raise EmvIndexError("index records are truncated")
+
+    records = []
+    for i in range(record_count):
+        offset = INDEX_HEADER.size + i * record_size
+        key_len = data[offset]
+        if key_len > key_size:
+            raise EmvIndexError(f"record {i}: key is too long")
+        key = data[offset + 1 : offset + 1 + key_len]
+        (name_offset,) = INDEX_NAME_OFFSET.unpack_from(data, offset + 1 + key_size)
+        name_offset += names_offset
+        if name_offset >= len(data) or name_offset + 1 + data[name_offset] > len(data):
+            raise EmvIndexError(f"record {i}: name is out of bounds")
+        name = data[name_offset + 1 : name_offset + 1 + data[name_offset]]
+        records.append((data[offset : offset + 1 + key_size], key, name))
+
+    return key_size, (source_size, source_crc), records
+
+
+def find(records, key, key_size):
+    # Same binary search as nfc_emv_index_find
+    needle = sort_key(key, key_size)
+    low, high = 0, len(records)
+    while low < high:
+        mid = (low + high) // 2
+        if records[mid][0] < needle:
+            low = mid + 1
+        elif records[mid][0] > needle:
+            high = mid
+        else:
+            return records[mid][2]
+    return None
+
+
+class Main(App):
+    def init(self):
+        self.subparsers = self.parser.add_subparsers(help="sub-command help")
+
+        self.parser_build = self.subparsers.add_parser(
+            "build", help="Build indexes for EMV resources in directory"
+        )
+        self.parser_build.add_argument("assets_dir", help="NFC assets directory")
+        self.parser_build.set_defaults(func=self.build)
+
+        self.parser_verify = self.subparsers.add_parser(
+            "verify", help="Check indexes against EMV resources in directory"
+        )
+        self.parser_verify.add_argument("assets_dir", help="NFC assets directory")
+        self.parser_verify.set_defaults(func=self.verify)
+
+    def _resources(self):
+        for resource in EMV_RESOURCES:
+            source = os.path.join(self.args.assets_dir, f"{resource}.nfc")
+            index = os.path.join(self.args.assets_dir, f"{resource}.idx")
+            if os.path.isfile(source):
+                yield source, index
+
+    def build(self):
+        # Firmware without NFC has no assets to index
+        if not os.path.isdir(self.args.assets_dir):
+            self.logger.debug(f"{self.args.assets_dir} does not exist, skipping")
+            return 0
+
+        try:
+            for source, index in self._resources():
+                entries, source_id = parse_resource(source)
+                with open(index, "wb") as f:
+                    f.write(build_index(entries, source_id))
+                self.logger.debug(f"{index}: {len(entries)} records")
+        except EmvIndexError as e:
+            self.logger.error(e)
+            return 1
+
+        return 0
+
+    def verify(self):
+        errors = 0
+        for source, index in self._resources():
+            try:
+                entries, source_id = parse_resource(source)
+                with open(index, "rb") as f:
+                    key_size, index_source_id, records = parse_index(f.read())
+
+                if index_source_id != source_id:
+                    raise EmvIndexError("index is outdated")
+                if len(records) != len(entries):
+                    raise EmvIndexError(
+                        f"{len(records)} records, {len(entries)} expected"
+                    )
+                if any(a[0] >= b[0] for a, b in zip(records, records[1:])):
+                    raise EmvIndexError("records are not sorted")
+                for key, name in entries.items():
+                    if find(records, key, key_size) != name:
+                        raise EmvIndexError(f"lookup of {key.hex().upper()} failed")
+
+                self.logger.info(f"{index}: {len(records)} records OK")
+            except (EmvIndexError, OSError) as e:
+                self.logger.error(f"{index}: {e}")
+                errors += 1
+
+        return 1 if errors else 0
+
+
+if __name__ == "__main__":
+    Main()()
@@ -78,12 +78,14 @@ def _resources_dist_action(target, source, env):
 def generate(env, **kw):
     env.SetDefault(
         ASSETS_COMPILER="${FBT_SCRIPT_DIR}/assets.py",
+        EMV_INDEX_COMPILER="${FBT_SCRIPT_DIR}/emv_index.py",
     )
 
     if not env["VERBOSE"]:
         env.SetDefault(
             RESOURCEDISTCOMSTR="\tRESDIST\t${RESOURCES_ROOT}",
             RESMANIFESTCOMSTR="\tMANIFST\t${TARGET}",
+            EMVINDEXCOMSTR="\tEMVIDX\t${TARGET.dir}",
         )
 
     env.Append(
@@ -94,6 +96,17 @@ def generate(env, **kw):
                         _resources_dist_action,
                         "${RESOURCEDISTCOMSTR}",
                     ),
+                    Action(
+                        [
+                            [
+                                "${PYTHON3}",
+                                "${EMV_INDEX_COMPILER}",
+                                "build",
+                                "${TARGET.dir.posix}/nfc/assets",
+                            ]
+                        ],
+                        "${EMVINDEXCOMSTR}",
+                    ),
                     Action(
                         [
                             [
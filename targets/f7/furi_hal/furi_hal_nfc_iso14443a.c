@@ -11,6 +11,10 @@
 // Prevent FDT timer from starting
 #define FURI_HAL_NFC_ISO14443A_LISTENER_FDT_COMP_FC (INT32_MAX)
 
+// Receiver settings of furi_hal_nfc_iso14443a_common_init() are tuned for 106 kbps only,
+// higher bit rates need their own filter, AGC and correlator settings
+#define FURI_HAL_NFC_ISO14443A_POLLER_BIT_RATE_MAX (FuriHalNfcaBitRate106Kbit)
+
 static Iso14443_3aSignal* iso14443_3a_signal = NULL;
 
 static FuriHalNfcError furi_hal_nfc_iso14443a_common_init(FuriHalSpiBusHandle* handle) {
@@ -210,6 +214,34 @@ FuriHalNfcError
     return err;
 }
 
+bool furi_hal_nfc_iso14443a_poller_is_bit_rate_supported(
+    FuriHalNfcaBitRate tx_bit_rate,
+    FuriHalNfcaBitRate rx_bit_rate) {
+    furi_check(tx_bit_rate < FuriHalNfcaBitRateNum);
+    furi_check(rx_bit_rate < FuriHalNfcaBitRateNum);
+
+    return (tx_bit_rate <= FURI_HAL_NFC_ISO14443A_POLLER_BIT_RATE_MAX) &&
+           (rx_bit_rate <= FURI_HAL_NFC_ISO14443A_POLLER_BIT_RATE_MAX);
+}
+
+FuriHalNfcError furi_hal_nfc_iso14443a_poller_set_bit_rate(
+    FuriHalNfcaBitRate tx_bit_rate,
+    FuriHalNfcaBitRate rx_bit_rate) {
+    furi_check(furi_hal_nfc_iso14443a_poller_is_bit_rate_supported(tx_bit_rate, rx_bit_rate));
+
+    FuriHalSpiBusHandle* handle = &furi_hal_spi_bus_handle_nfc;
+
+    // Register codes match enum values: 106, 212, 424, 848 kbps
+    st25r3916_change_reg_bits(
+        handle,
+        ST25R3916_REG_BIT_RATE,
+        ST25R3916_REG_BIT_RATE_txrate_mask | ST25R3916_REG_BIT_RATE_rxrate_mask,
+        (tx_bit_rate << ST25R3916_REG_BIT_RATE_txrate_shift) |
+            (rx_bit_rate << ST25R3916_REG_BIT_RATE_rxrate_shift));
+
+    return FuriHalNfcErrorNone;
+}
+
 FuriHalNfcError furi_hal_nfc_iso14443a_listener_set_col_res_data(
     uint8_t* uid,
     uint8_t uid_len,
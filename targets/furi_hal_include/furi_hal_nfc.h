@@ -416,6 +416,47 @@ FuriHalNfcError
 FuriHalNfcError
     furi_hal_nfc_iso14443a_poller_tx_custom_parity(const uint8_t* tx_data, size_t tx_bits);
 
+/**
+ * @brief Enumeration of ISO14443 (Type A) bit rates.
+ */
+typedef enum {
+    FuriHalNfcaBitRate106Kbit,
+    FuriHalNfcaBitRate212Kbit,
+    FuriHalNfcaBitRate424Kbit,
+    FuriHalNfcaBitRate848Kbit,
+
+    FuriHalNfcaBitRateNum,
+} FuriHalNfcaBitRate;
+
+/**
+ * @brief Check if ISO14443 (Type A) bit rates are supported in poller mode.
+ *
+ * Only bit rates the receiver is tuned for are supported: 106 kbps.
+ * Check before negotiating a bit rate with the card (e.g. with PPS).
+ *
+ * @param[in] tx_bit_rate poller to card bit rate.
+ * @param[in] rx_bit_rate card to poller bit rate.
+ * @returns true if both bit rates can be set, false otherwise.
+ */
+bool furi_hal_nfc_iso14443a_poller_is_bit_rate_supported(
+    FuriHalNfcaBitRate tx_bit_rate,
+    FuriHalNfcaBitRate rx_bit_rate);
+
+/**
+ * @brief Set ISO14443 (Type A) bit rate in poller mode.
+ *
+ * Must be called after the bit rate was negotiated with the card (e.g. with PPS).
+ * Bit rate returns to 106 kbps on the next furi_hal_nfc_reset_mode() call.
+ * Bit rates must be supported, see furi_hal_nfc_iso14443a_poller_is_bit_rate_supported().
+ *
+ * @param[in] tx_bit_rate poller to card bit rate.
+ * @param[in] rx_bit_rate card to poller bit rate.
+ * @returns FuriHalNfcErrorNone on success, any other error code on failure.
+ */
+FuriHalNfcError furi_hal_nfc_iso14443a_poller_set_bit_rate(
+    FuriHalNfcaBitRate tx_bit_rate,
+    FuriHalNfcaBitRate rx_bit_rate);
+
 /**
  * @brief Set ISO14443 (Type A) collision resolution parameters in listener mode.
  *
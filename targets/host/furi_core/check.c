@@ -0,0 +1,48 @@
+#include "furi_host_i.h"
+
+#include <core/check.h>
+#include <core/common_defines.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+const char* __furi_check_message = NULL;
+
+/* Log may be the thing that crashed, so write straight to stderr */
+static void __furi_print_name(void) {
+    FuriHostTask* task = furi_host_task_current_peek();
+    if(task) {
+        fprintf(stderr, "[%s] ", task->name);
+    } else {
+        fprintf(stderr, "[%lu] ", (unsigned long)pthread_self());
+    }
+}
+
+FURI_NORETURN void __furi_crash_implementation() {
+    if(__furi_check_message == NULL) {
+        __furi_check_message = "Fatal Error";
+    } else if(__furi_check_message == (void*)__FURI_ASSERT_MESSAGE_FLAG) {
+        __furi_check_message = "furi_assert failed";
+    } else if(__furi_check_message == (void*)__FURI_CHECK_MESSAGE_FLAG) {
+        __furi_check_message = "furi_check failed";
+    }
+
+    fprintf(stderr, "\r\n\033[0;31m[CRASH]");
+    __furi_print_name();
+    fprintf(stderr, "%s\033[0m\r\n", __furi_check_message);
+
+    // abort leaves core dump and stops debugger, same as halted MCU
+    abort();
+}
+
+FURI_NORETURN void __furi_halt_implementation() {
+    if(__furi_check_message == NULL) {
+        __furi_check_message = "System halt requested.";
+    }
+
+    fprintf(stderr, "\r\n\033[0;31m[HALT]");
+    __furi_print_name();
+    fprintf(stderr, "%s\r\nSystem halted. Bye-bye!\033[0m\r\n", __furi_check_message);
+
+    abort();
+}
@@ -0,0 +1,127 @@
+#include "furi_host_i.h"
+
+#include <core/event_flag.h>
+#include <core/check.h>
+#include <core/memmgr.h>
+#include <core/common_defines.h>
+
+#define FURI_EVENT_FLAG_MAX_BITS_EVENT_GROUPS 24U
+#define FURI_EVENT_FLAG_INVALID_BITS (~((1UL << FURI_EVENT_FLAG_MAX_BITS_EVENT_GROUPS) - 1U))
+
+typedef struct {
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+
+    uint32_t flags;
+} FuriHostEventFlag;
+
+FuriEventFlag* furi_event_flag_alloc() {
+    FuriHostEventFlag* event_flag = malloc(sizeof(FuriHostEventFlag));
+    pthread_mutex_init(&event_flag->mutex, NULL);
+    furi_host_cond_init(&event_flag->cond);
+
+    return event_flag;
+}
+
+void furi_event_flag_free(FuriEventFlag* instance) {
+    furi_assert(instance);
+    FuriHostEventFlag* event_flag = instance;
+
+    pthread_cond_destroy(&event_flag->cond);
+    pthread_mutex_destroy(&event_flag->mutex);
+    free(event_flag);
+}
+
+uint32_t furi_event_flag_set(FuriEventFlag* instance, uint32_t flags) {
+    furi_assert(instance);
+    FuriHostEventFlag* event_flag = instance;
+    furi_assert((flags & FURI_EVENT_FLAG_INVALID_BITS) == 0U);
+
+    pthread_mutex_lock(&event_flag->mutex);
+    event_flag->flags |= flags;
+    uint32_t rflags = event_flag->flags;
+    pthread_cond_broadcast(&event_flag->cond);
+    pthread_mutex_unlock(&event_flag->mutex);
+
+    /* Return event flags after setting */
+    return (rflags);
+}
+
+uint32_t furi_event_flag_clear(FuriEventFlag* instance, uint32_t flags) {
+    furi_assert(instance);
+    FuriHostEventFlag* event_flag = instance;
+    furi_assert((flags & FURI_EVENT_FLAG_INVALID_BITS) == 0U);
+
+    pthread_mutex_lock(&event_flag->mutex);
+    uint32_t rflags = event_flag->flags;
+    event_flag->flags &= ~flags;
+    pthread_mutex_unlock(&event_flag->mutex);
+
+    /* Return event flags before clearing */
+    return (rflags);
+}
+
+uint32_t furi_event_flag_get(FuriEventFlag* instance) {
+    furi_assert(instance);
+    FuriHostEventFlag* event_flag = instance;
+
+    pthread_mutex_lock(&event_flag->mutex);
+    uint32_t rflags = event_flag->flags;
+    pthread_mutex_unlock(&event_flag->mutex);
+
+    /* Return current event flags */
+    return (rflags);
+}
+
+static bool furi_event_flag_is_satisfied(uint32_t current, uint32_t flags, uint32_t options) {
+    if(options & FuriFlagWaitAll) {
+        return (current & flags) == flags;
+    } else {
+        return (current & flags) != 0U;
+    }
+}
+
+uint32_t furi_event_flag_wait(
+    FuriEventFlag* instance,
+    uint32_t flags,
+    uint32_t options,
+    uint32_t timeout) {
+    furi_assert(instance);
+    FuriHostEventFlag* event_flag = instance;
+    furi_assert((flags & FURI_EVENT_FLAG_INVALID_BITS) == 0U);
+
+    struct timespec deadline;
+    if(timeout != FuriWaitForever) furi_host_deadline(&deadline, timeout);
+
+    pthread_mutex_lock(&event_flag->mutex);
+
+    bool satisfied = furi_event_flag_is_satisfied(event_flag->flags, flags, options);
+    while(!satisfied && timeout != 0U) {
+        if(!furi_host_cond_wait(
+               &event_flag->cond,
+               &event_flag->mutex,
+               timeout == FuriWaitForever ? NULL : &deadline)) {
+            break;
+        }
+        satisfied = furi_event_flag_is_satisfied(event_flag->flags, flags, options);
+    }
+
+    uint32_t rflags = event_flag->flags;
+
+    if(satisfied) {
+        if(!(options & FuriFlagNoClear)) {
+            event_flag->flags &= ~flags;
+        }
+    } else {
+        if(timeout > 0U) {
+            rflags = (uint32_t)FuriStatusErrorTimeout;
+        } else {
+            rflags = (uint32_t)FuriStatusErrorResource;
+        }
+    }
+
+    pthread_mutex_unlock(&event_flag->mutex);
+
+    /* Return event flags before clearing */
+    return (rflags);
+}
@@ -0,0 +1,23 @@
+#include <furi.h>
+
+#include <stdio.h>
+#include <unistd.h>
+
+static void furi_host_log_stdout(const uint8_t* data, size_t size, void* context) {
+    UNUSED(context);
+    fwrite(data, 1, size, stdout);
+    fflush(stdout);
+}
+
+void furi_init() {
+    furi_log_init();
+    furi_log_add_handler((FuriLogHandler){.callback = furi_host_log_stdout, .context = NULL});
+    furi_record_init();
+}
+
+void furi_run() {
+    // No scheduler to start: threads are running already, park main thread
+    while(true) {
+        pause();
+    }
+}
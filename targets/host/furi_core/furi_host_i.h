@@ -0,0 +1,108 @@
+/**
+ * @file furi_host_i.h
+ * Furi host port: shared internals
+ */
+#pragma once
+
+#include <core/thread.h>
+
+#include <FreeRTOS.h>
+#include <pthread.h>
+#include <time.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define FURI_HOST_NOTIFY_COUNT (configTASK_NOTIFICATION_ARRAY_ENTRIES)
+
+typedef struct FuriHostTask FuriHostTask;
+
+/** Host side of FuriThreadId: one per pthread that touched furi */
+struct FuriHostTask {
+    pthread_t pthread;
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+
+    // Task notifications, protected by mutex
+    uint32_t notify_value[FURI_HOST_NOTIFY_COUNT];
+    bool notify_pending[FURI_HOST_NOTIFY_COUNT];
+
+    // NULL for threads that were not started with FuriThread
+    FuriThread* thread;
+    char name[16];
+    FuriThreadPriority priority;
+
+    // Task registry, protected by registry mutex
+    FuriHostTask* next;
+};
+
+/** Get host task of the calling pthread, register it if it is not known yet
+ *
+ * @return     The host task, never NULL
+ */
+FuriHostTask* furi_host_task_current(void);
+
+/** Get host task of the calling pthread without registering it
+ *
+ * Safe to use from allocator
+ *
+ * @return     The host task or NULL
+ */
+FuriHostTask* furi_host_task_current_peek(void);
+
+/** Initialize condition variable that uses monotonic clock
+ *
+ * @param      cond  The condition variable
+ */
+void furi_host_cond_init(pthread_cond_t* cond);
+
+/** Convert timeout in ticks to monotonic deadline
+ *
+ * @param[out] deadline  The deadline
+ * @param[in]  ticks     The timeout in ticks, FuriWaitForever is not allowed
+ */
+void furi_host_deadline(struct timespec* deadline, uint32_t ticks);
+
+/** Wait on condition until deadline
+ *
+ * @param      cond      The condition variable, initialized by furi_host_cond_init
+ * @param      mutex     The locked mutex
+ * @param      deadline  The deadline or NULL to wait forever
+ *
+ * @return     false on timeout
+ */
+bool furi_host_cond_wait(
+    pthread_cond_t* cond,
+    pthread_mutex_t* mutex,
+    const struct timespec* deadline);
+
+/** Allocate zeroed heap block with alignment, crash on out of memory
+ *
+ * @param      alignment  The alignment, power of 2, 0 for default
+ * @param      size       The size
+ *
+ * @return     pointer to block, free with vPortFree
+ */
+void* memmgr_heap_host_alloc_aligned(size_t alignment, size_t size);
+
+/** Pause heap trace accounting for the calling thread
+ *
+ * libc allocations that are released by another thread, such as pthread TLS,
+ * must not be accounted to the thread that triggered them
+ *
+ * @param      pause  true to pause, false to resume
+ */
+void memmgr_heap_host_trace_pause(bool pause);
+
+/** Get requested size of heap block
+ *
+ * @param      pv    The block
+ *
+ * @return     requested size
+ */
+size_t memmgr_heap_host_get_size(void* pv);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,178 @@
+#include "furi_host_i.h"
+
+#include <core/kernel.h>
+#include <core/check.h>
+#include <core/common_defines.h>
+
+#include <errno.h>
+#include <sched.h>
+
+static pthread_mutex_t furi_host_kernel_mutex = PTHREAD_RECURSIVE_MUTEX_INITIALIZER_NP;
+static uint32_t furi_host_kernel_lock_depth = 0;
+
+static uint64_t furi_host_get_time_us(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000ULL + (uint64_t)now.tv_nsec / 1000ULL;
+}
+
+static void furi_host_sleep_us(uint64_t microseconds) {
+    struct timespec request = {
+        .tv_sec = microseconds / 1000000ULL,
+        .tv_nsec = (microseconds % 1000000ULL) * 1000ULL,
+    };
+
+    while(clock_nanosleep(CLOCK_MONOTONIC, 0, &request, &request) == EINTR) {
+    }
+}
+
+static uint64_t furi_host_boot_time = 0;
+static pthread_once_t furi_host_boot_time_once = PTHREAD_ONCE_INIT;
+
+static void furi_host_boot_time_init(void) {
+    furi_host_boot_time = furi_host_get_time_us();
+}
+
+static uint64_t furi_host_get_boot_time_us(void) {
+    pthread_once(&furi_host_boot_time_once, furi_host_boot_time_init);
+    return furi_host_boot_time;
+}
+
+void furi_host_cond_init(pthread_cond_t* cond) {
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    furi_check(pthread_cond_init(cond, &attr) == 0);
+    pthread_condattr_destroy(&attr);
+}
+
+void furi_host_deadline(struct timespec* deadline, uint32_t ticks) {
+    furi_assert(ticks != FuriWaitForever);
+
+    clock_gettime(CLOCK_MONOTONIC, deadline);
+    uint64_t nsec = (uint64_t)deadline->tv_nsec + (uint64_t)ticks * 1000000ULL;
+    deadline->tv_sec += nsec / 1000000000ULL;
+    deadline->tv_nsec = nsec % 1000000000ULL;
+}
+
+bool furi_host_cond_wait(
+    pthread_cond_t* cond,
+    pthread_mutex_t* mutex,
+    const struct timespec* deadline) {
+    if(deadline) {
+        return pthread_cond_timedwait(cond, mutex, deadline) != ETIMEDOUT;
+    } else {
+        furi_check(pthread_cond_wait(cond, mutex) == 0);
+        return true;
+    }
+}
+
+/* Critical sections: there are no interrupts on host, so all critical sections
+ * and kernel lock share one recursive mutex */
+
+__FuriCriticalInfo __furi_critical_enter(void) {
+    __FuriCriticalInfo info;
+
+    info.isrm = 0;
+    info.from_isr = false;
+    info.kernel_running = true;
+
+    pthread_mutex_lock(&furi_host_kernel_mutex);
+
+    return info;
+}
+
+void __furi_critical_exit(__FuriCriticalInfo info) {
+    UNUSED(info);
+    pthread_mutex_unlock(&furi_host_kernel_mutex);
+}
+
+bool furi_kernel_is_irq_or_masked() {
+    return false;
+}
+
+bool furi_kernel_is_running() {
+    return true;
+}
+
+int32_t furi_kernel_lock() {
+    pthread_mutex_lock(&furi_host_kernel_mutex);
+    int32_t lock = furi_host_kernel_lock_depth ? 1 : 0;
+    furi_host_kernel_lock_depth++;
+
+    /* Return previous lock state */
+    return (lock);
+}
+
+int32_t furi_kernel_unlock() {
+    int32_t lock = 0;
+
+    if(pthread_mutex_trylock(&furi_host_kernel_mutex) == 0) {
+        if(furi_host_kernel_lock_depth) {
+            lock = 1;
+            furi_host_kernel_lock_depth--;
+            pthread_mutex_unlock(&furi_host_kernel_mutex);
+        }
+        pthread_mutex_unlock(&furi_host_kernel_mutex);
+    }
+
+    /* Return previous lock state */
+    return (lock);
+}
+
+int32_t furi_kernel_restore_lock(int32_t lock) {
+    if(lock == 1) {
+        furi_kernel_lock();
+    } else if(lock == 0) {
+        furi_kernel_unlock();
+    } else {
+        lock = (int32_t)FuriStatusError;
+    }
+
+    /* Return new lock state */
+    return (lock);
+}
+
+uint32_t furi_kernel_get_tick_frequency() {
+    /* Return frequency in hertz */
+    return (configTICK_RATE_HZ_RAW);
+}
+
+void furi_delay_tick(uint32_t ticks) {
+    if(ticks == 0U) {
+        sched_yield();
+    } else {
+        furi_host_sleep_us((uint64_t)ticks * 1000ULL);
+    }
+}
+
+FuriStatus furi_delay_until_tick(uint32_t tick) {
+    uint32_t delay = tick - furi_get_tick();
+
+    /* Check if target tick has not expired */
+    if((delay != 0U) && (0 == (delay >> 31))) {
+        furi_delay_tick(delay);
+        return FuriStatusOk;
+    } else {
+        /* No delay or already expired */
+        return FuriStatusErrorParameter;
+    }
+}
+
+uint32_t furi_get_tick() {
+    // Boot time must be taken first: on the very first call it is initialized here
+    uint64_t boot_time = furi_host_get_boot_time_us();
+    return (uint32_t)((furi_host_get_time_us() - boot_time) / 1000ULL);
+}
+
+uint32_t furi_ms_to_ticks(uint32_t milliseconds) {
+    return milliseconds;
+}
+
+void furi_delay_ms(uint32_t milliseconds) {
+    furi_delay_tick(milliseconds);
+}
+
+void furi_delay_us(uint32_t microseconds) {
+    furi_host_sleep_us(microseconds);
+}
@@ -0,0 +1,123 @@
+/*
+ * Host memmgr: libc allocator entry points are replaced, so that every
+ * allocation made by host program goes through furi heap accounting, same as
+ * newlib wrappers on target.
+ */
+
+#include "furi_host_i.h"
+
+#include <core/memmgr.h>
+#include <core/check.h>
+#include <core/common_defines.h>
+
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+
+extern void* pvPortMalloc(size_t xSize);
+extern void vPortFree(void* pv);
+extern void* pvPortRealloc(void* pv, size_t xSize);
+extern void memmgr_heap_profiler_sample(const void* pc, size_t size);
+extern size_t xPortGetFreeHeapSize(void);
+extern size_t xPortGetTotalHeapSize(void);
+extern size_t xPortGetMinimumEverFreeHeapSize(void);
+
+void* malloc(size_t size) {
+    memmgr_heap_profiler_sample(__builtin_return_address(0), size);
+    return pvPortMalloc(size);
+}
+
+void free(void* ptr) {
+    vPortFree(ptr);
+}
+
+void* realloc(void* ptr, size_t size) {
+    memmgr_heap_profiler_sample(__builtin_return_address(0), size);
+    return pvPortRealloc(ptr, size);
+}
+
+void* calloc(size_t count, size_t size) {
+    size_t total;
+    furi_check(!__builtin_mul_overflow(count, size, &total));
+    memmgr_heap_profiler_sample(__builtin_return_address(0), total);
+    return pvPortMalloc(total);
+}
+
+char* strdup(const char* s) {
+    // arg s marked as non-null, so we need hack to check for NULL
+    furi_check(((uintptr_t)s << 2) != 0);
+
+    size_t siz = strlen(s) + 1;
+    memmgr_heap_profiler_sample(__builtin_return_address(0), siz);
+    char* y = pvPortMalloc(siz);
+    memcpy(y, s, siz);
+
+    return y;
+}
+
+/* Aligned libc entry points, used by libc and libstdc++ internals */
+
+int posix_memalign(void** memptr, size_t alignment, size_t size) {
+    if((alignment % sizeof(void*)) != 0 || (alignment & (alignment - 1)) != 0) {
+        return EINVAL;
+    }
+
+    *memptr = memmgr_heap_host_alloc_aligned(alignment, size);
+    return 0;
+}
+
+void* aligned_alloc(size_t alignment, size_t size) {
+    return memmgr_heap_host_alloc_aligned(alignment, size);
+}
+
+void* memalign(size_t alignment, size_t size) {
+    return memmgr_heap_host_alloc_aligned(alignment, size);
+}
+
+void* valloc(size_t size) {
+    return memmgr_heap_host_alloc_aligned(sysconf(_SC_PAGESIZE), size);
+}
+
+void* pvalloc(size_t size) {
+    size_t page_size = sysconf(_SC_PAGESIZE);
+    return memmgr_heap_host_alloc_aligned(page_size, (size + page_size - 1) & ~(page_size - 1));
+}
+
+size_t malloc_usable_size(void* ptr) {
+    return ptr ? memmgr_heap_host_get_size(ptr) : 0;
+}
+
+/* Furi memmgr API */
+
+size_t memmgr_get_free_heap(void) {
+    return xPortGetFreeHeapSize();
+}
+
+size_t memmgr_get_total_heap(void) {
+    return xPortGetTotalHeapSize();
+}
+
+size_t memmgr_get_minimum_free_heap(void) {
+    return xPortGetMinimumEverFreeHeapSize();
+}
+
+void* memmgr_alloc_from_pool(size_t size) {
+    // No SRAM2 pool on host, same fallback as on target when pool is exhausted
+    return malloc(size);
+}
+
+size_t memmgr_pool_get_free(void) {
+    return 0;
+}
+
+size_t memmgr_pool_get_max_block(void) {
+    return 0;
+}
+
+void* aligned_malloc(size_t size, size_t alignment) {
+    return memmgr_heap_host_alloc_aligned(alignment, size);
+}
+
+void aligned_free(void* p) {
+    free(p);
+}
@@ -0,0 +1,302 @@
+/*
+ * Host replacement for FreeRTOS heap_4 based allocator.
+ *
+ * Blocks are taken from libc allocator, every block is prefixed with header
+ * that carries requested size and owner tag, so thread trace and heap
+ * statistics work the same way as on target.
+ */
+
+#include "furi_host_i.h"
+
+#include <core/memmgr_heap.h>
+#include <core/check.h>
+#include <core/common_defines.h>
+
+#include <stdio.h>
+#include <string.h>
+
+extern void* __libc_calloc(size_t count, size_t size);
+extern void* __libc_memalign(size_t alignment, size_t size);
+extern void __libc_free(void* ptr);
+
+/* Nominal heap size: host has no real limit, but free heap checks in tests
+need something to compare against */
+#define MEMMGR_HEAP_HOST_TOTAL (64UL * 1024UL * 1024UL)
+
+#define MEMMGR_HEAP_TRACE_SLOTS (32U)
+#define MEMMGR_HEAP_TRACE_TAG_SLOT_MASK (0xFFU)
+#define MEMMGR_HEAP_TRACE_TAG_GENERATION_SHIFT (8U)
+
+typedef struct {
+    size_t size;
+    uint32_t tag;
+    uint32_t offset;
+} MemmgrHeapHostHeader;
+
+_Static_assert(sizeof(MemmgrHeapHostHeader) == 16, "Header must keep malloc alignment");
+
+typedef struct {
+    FuriThreadId thread_id;
+    uint32_t tag;
+    size_t bytes;
+    size_t count;
+} MemmgrHeapTraceSlot;
+
+static pthread_mutex_t memmgr_heap_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+static size_t memmgr_heap_allocated = 0;
+static size_t memmgr_heap_allocated_max = 0;
+
+static MemmgrHeapTraceSlot memmgr_heap_trace_slot[MEMMGR_HEAP_TRACE_SLOTS] = {0};
+static uint32_t memmgr_heap_trace_generation = 0;
+static volatile size_t memmgr_heap_trace_active = 0;
+static __thread bool memmgr_heap_trace_paused = false;
+
+/* Find trace slot of the thread, must be called with heap mutex held */
+static MemmgrHeapTraceSlot* memmgr_heap_trace_find(FuriThreadId thread_id) {
+    for(size_t i = 0; i < MEMMGR_HEAP_TRACE_SLOTS; i++) {
+        if(memmgr_heap_trace_slot[i].thread_id == thread_id) {
+            return &memmgr_heap_trace_slot[i];
+        }
+    }
+
+    return NULL;
+}
+
+/* Account block in heap and trace statistics */
+static void memmgr_heap_account_alloc(MemmgrHeapHostHeader* header) {
+    pthread_mutex_lock(&memmgr_heap_mutex);
+
+    memmgr_heap_allocated += header->size;
+    if(memmgr_heap_allocated > memmgr_heap_allocated_max) {
+        memmgr_heap_allocated_max = memmgr_heap_allocated;
+    }
+
+    if(memmgr_heap_trace_active && !memmgr_heap_trace_paused) {
+        // Peek: allocator must not register threads, registration allocates
+        FuriHostTask* task = furi_host_task_current_peek();
+        MemmgrHeapTraceSlot* slot = task ? memmgr_heap_trace_find((FuriThreadId)task) : NULL;
+        if(slot) {
+            header->tag = slot->tag;
+            slot->bytes += header->size;
+            slot->count++;
+        }
+    }
+
+    pthread_mutex_unlock(&memmgr_heap_mutex);
+}
+
+static void memmgr_heap_account_free(MemmgrHeapHostHeader* header) {
+    pthread_mutex_lock(&memmgr_heap_mutex);
+
+    memmgr_heap_allocated -= header->size;
+
+    if(header->tag) {
+        // Same as on target: stale tags of finished threads are ignored
+        MemmgrHeapTraceSlot* slot =
+            &memmgr_heap_trace_slot[(header->tag & MEMMGR_HEAP_TRACE_TAG_SLOT_MASK) - 1];
+        if(slot->tag == header->tag) {
+            slot->bytes -= header->size;
+            slot->count--;
+        }
+    }
+
+    pthread_mutex_unlock(&memmgr_heap_mutex);
+}
+
+static inline MemmgrHeapHostHeader* memmgr_heap_get_header(void* pv) {
+    return (MemmgrHeapHostHeader*)pv - 1;
+}
+
+void* memmgr_heap_host_alloc_aligned(size_t alignment, size_t size) {
+    furi_check(size < MEMMGR_HEAP_HOST_TOTAL);
+
+    uint8_t* raw;
+    size_t offset;
+    if(alignment <= sizeof(MemmgrHeapHostHeader)) {
+        offset = sizeof(MemmgrHeapHostHeader);
+        raw = __libc_calloc(1, offset + size);
+    } else {
+        // Header must fit in front of aligned block, so offset is whole alignment
+        furi_check((alignment & (alignment - 1)) == 0);
+        offset = alignment;
+        raw = __libc_memalign(alignment, offset + size);
+        if(raw) memset(raw, 0, offset + size);
+    }
+    // Same as on target: out of memory is fatal
+    furi_check(raw, "out of memory");
+
+    MemmgrHeapHostHeader* header = (MemmgrHeapHostHeader*)(raw + offset) - 1;
+    header->size = size;
+    header->offset = offset;
+    memmgr_heap_account_alloc(header);
+
+    return raw + offset;
+}
+
+void memmgr_heap_host_trace_pause(bool pause) {
+    memmgr_heap_trace_paused = pause;
+}
+
+size_t memmgr_heap_host_get_size(void* pv) {
+    return memmgr_heap_get_header(pv)->size;
+}
+
+void* pvPortMalloc(size_t xWantedSize) {
+    return memmgr_heap_host_alloc_aligned(0, xWantedSize);
+}
+
+void vPortFree(void* pv) {
+    if(pv == NULL) return;
+
+    MemmgrHeapHostHeader* header = memmgr_heap_get_header(pv);
+    memmgr_heap_account_free(header);
+    __libc_free((uint8_t*)pv - header->offset);
+}
+
+void* pvPortRealloc(void* pv, size_t xWantedSize) {
+    if(pv == NULL) return pvPortMalloc(xWantedSize);
+
+    if(xWantedSize == 0) {
+        vPortFree(pv);
+        return NULL;
+    }
+
+    MemmgrHeapHostHeader* header = memmgr_heap_get_header(pv);
+    void* data = memmgr_heap_host_alloc_aligned(header->offset, xWantedSize);
+    memcpy(data, pv, MIN(header->size, xWantedSize));
+    vPortFree(pv);
+
+    return data;
+}
+
+size_t xPortGetTotalHeapSize(void) {
+    return MEMMGR_HEAP_HOST_TOTAL;
+}
+
+size_t xPortGetFreeHeapSize(void) {
+    pthread_mutex_lock(&memmgr_heap_mutex);
+    size_t allocated = memmgr_heap_allocated;
+    pthread_mutex_unlock(&memmgr_heap_mutex);
+
+    return MEMMGR_HEAP_HOST_TOTAL - MIN(allocated, MEMMGR_HEAP_HOST_TOTAL);
+}
+
+size_t xPortGetMinimumEverFreeHeapSize(void) {
+    pthread_mutex_lock(&memmgr_heap_mutex);
+    size_t allocated_max = memmgr_heap_allocated_max;
+    pthread_mutex_unlock(&memmgr_heap_mutex);
+
+    return MEMMGR_HEAP_HOST_TOTAL - MIN(allocated_max, MEMMGR_HEAP_HOST_TOTAL);
+}
+
+void memmgr_heap_init() {
+}
+
+/* Size classes are target allocator detail, host has none */
+
+size_t memmgr_heap_get_pool_count() {
+    return 0;
+}
+
+void memmgr_heap_get_pool_stats(size_t index, MemmgrHeapPoolStats* stats) {
+    UNUSED(index);
+    UNUSED(stats);
+    furi_crash("No size classes on host");
+}
+
+/* Thread trace */
+
+void memmgr_heap_enable_thread_trace(FuriThreadId thread_id) {
+    furi_check(thread_id);
+
+    pthread_mutex_lock(&memmgr_heap_mutex);
+    {
+        furi_check(memmgr_heap_trace_find(thread_id) == NULL);
+        // Out of slots: thread stays untraced and reports unknown usage
+        MemmgrHeapTraceSlot* slot = memmgr_heap_trace_find(NULL);
+        if(slot) {
+            memmgr_heap_trace_generation++;
+            slot->thread_id = thread_id;
+            slot->tag = (memmgr_heap_trace_generation << MEMMGR_HEAP_TRACE_TAG_GENERATION_SHIFT) |
+                        ((size_t)(slot - memmgr_heap_trace_slot) + 1);
+            slot->bytes = 0;
+            slot->count = 0;
+            memmgr_heap_trace_active++;
+        }
+    }
+    pthread_mutex_unlock(&memmgr_heap_mutex);
+}
+
+void memmgr_heap_disable_thread_trace(FuriThreadId thread_id) {
+    furi_check(thread_id);
+
+    pthread_mutex_lock(&memmgr_heap_mutex);
+    {
+        MemmgrHeapTraceSlot* slot = memmgr_heap_trace_find(thread_id);
+        if(slot) {
+            slot->thread_id = NULL;
+            slot->tag = 0;
+            memmgr_heap_trace_active--;
+        }
+    }
+    pthread_mutex_unlock(&memmgr_heap_mutex);
+}
+
+size_t memmgr_heap_get_thread_memory(FuriThreadId thread_id) {
+    size_t leftovers = MEMMGR_HEAP_UNKNOWN;
+    furi_check(thread_id);
+
+    pthread_mutex_lock(&memmgr_heap_mutex);
+    {
+        MemmgrHeapTraceSlot* slot = memmgr_heap_trace_find(thread_id);
+        if(slot) {
+            leftovers = slot->bytes;
+        }
+    }
+    pthread_mutex_unlock(&memmgr_heap_mutex);
+    return leftovers;
+}
+
+size_t memmgr_heap_get_thread_allocations(FuriThreadId thread_id) {
+    size_t count = MEMMGR_HEAP_UNKNOWN;
+    furi_check(thread_id);
+
+    pthread_mutex_lock(&memmgr_heap_mutex);
+    {
+        MemmgrHeapTraceSlot* slot = memmgr_heap_trace_find(thread_id);
+        if(slot) {
+            count = slot->count;
+        }
+    }
+    pthread_mutex_unlock(&memmgr_heap_mutex);
+    return count;
+}
+
+/* Free block walking is target allocator detail, report nominal values */
+
+size_t memmgr_heap_get_max_free_block() {
+    return xPortGetFreeHeapSize();
+}
+
+void memmgr_heap_printf_free_blocks() {
+    printf("Free block list is not available on host\r\n");
+}
+
+/* Allocation profiler: use perf or valgrind on host, keep API working */
+
+void memmgr_heap_profiler_sample(const void* pc, size_t size) {
+    UNUSED(pc);
+    UNUSED(size);
+}
+
+void memmgr_heap_profiler_start(uint32_t sample_period) {
+    furi_check(sample_period > 0);
+}
+
+void memmgr_heap_profiler_stop() {
+}
+
+void memmgr_heap_printf_profile() {
+    printf("Allocation profiler is not available on host, use perf or valgrind\r\n");
+}
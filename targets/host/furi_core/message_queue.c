@@ -0,0 +1,211 @@
+#include "furi_host_i.h"
+
+#include <core/message_queue.h>
+#include <core/check.h>
+#include <core/memmgr.h>
+#include <core/event_loop_link_i.h>
+
+#include <string.h>
+
+struct FuriMessageQueue {
+    pthread_mutex_t mutex;
+    pthread_cond_t cond_put;
+    pthread_cond_t cond_get;
+
+    uint8_t* buffer;
+    uint32_t msg_count;
+    uint32_t msg_size;
+    uint32_t head;
+    uint32_t count;
+
+    FuriEventLoopLink event_loop_link;
+};
+
+FuriMessageQueue* furi_message_queue_alloc(uint32_t msg_count, uint32_t msg_size) {
+    furi_assert((msg_count > 0U) && (msg_size > 0U));
+
+    FuriMessageQueue* instance = malloc(sizeof(FuriMessageQueue));
+    instance->buffer = malloc((size_t)msg_count * msg_size);
+    instance->msg_count = msg_count;
+    instance->msg_size = msg_size;
+    pthread_mutex_init(&instance->mutex, NULL);
+    furi_host_cond_init(&instance->cond_put);
+    furi_host_cond_init(&instance->cond_get);
+
+    return instance;
+}
+
+void furi_message_queue_free(FuriMessageQueue* instance) {
+    furi_assert(instance);
+
+    furi_event_loop_link_check_unused(&instance->event_loop_link);
+
+    pthread_cond_destroy(&instance->cond_get);
+    pthread_cond_destroy(&instance->cond_put);
+    pthread_mutex_destroy(&instance->mutex);
+    free(instance->buffer);
+    free(instance);
+}
+
+FuriStatus
+    furi_message_queue_put(FuriMessageQueue* instance, const void* msg_ptr, uint32_t timeout) {
+    FuriStatus stat = FuriStatusOk;
+
+    if((instance == NULL) || (msg_ptr == NULL)) {
+        return FuriStatusErrorParameter;
+    }
+
+    struct timespec deadline;
+    if(timeout != FuriWaitForever) furi_host_deadline(&deadline, timeout);
+
+    pthread_mutex_lock(&instance->mutex);
+
+    while(instance->count == instance->msg_count) {
+        if(timeout == 0U) {
+            stat = FuriStatusErrorResource;
+            break;
+        }
+        if(!furi_host_cond_wait(
+               &instance->cond_put,
+               &instance->mutex,
+               timeout == FuriWaitForever ? NULL : &deadline)) {
+            stat = FuriStatusErrorTimeout;
+            break;
+        }
+    }
+
+    if(stat == FuriStatusOk) {
+        uint32_t tail = (instance->head + instance->count) % instance->msg_count;
+        memcpy(&instance->buffer[tail * instance->msg_size], msg_ptr, instance->msg_size);
+        instance->count++;
+        pthread_cond_signal(&instance->cond_get);
+    }
+
+    pthread_mutex_unlock(&instance->mutex);
+
+    if(stat == FuriStatusOk) {
+        furi_event_loop_link_notify(&instance->event_loop_link, FuriEventLoopEventIn);
+    }
+
+    /* Return execution status */
+    return (stat);
+}
+
+FuriStatus furi_message_queue_get(FuriMessageQueue* instance, void* msg_ptr, uint32_t timeout) {
+    FuriStatus stat = FuriStatusOk;
+
+    if((instance == NULL) || (msg_ptr == NULL)) {
+        return FuriStatusErrorParameter;
+    }
+
+    struct timespec deadline;
+    if(timeout != FuriWaitForever) furi_host_deadline(&deadline, timeout);
+
+    pthread_mutex_lock(&instance->mutex);
+
+    while(instance->count == 0U) {
+        if(timeout == 0U) {
+            stat = FuriStatusErrorResource;
+            break;
+        }
+        if(!furi_host_cond_wait(
+               &instance->cond_get,
+               &instance->mutex,
+               timeout == FuriWaitForever ? NULL : &deadline)) {
+            stat = FuriStatusErrorTimeout;
+            break;
+        }
+    }
+
+    if(stat == FuriStatusOk) {
+        uint8_t* head = &instance->buffer[instance->head * instance->msg_size];
+        memcpy(msg_ptr, head, instance->msg_size);
+        instance->head = (instance->head + 1U) % instance->msg_count;
+        instance->count--;
+        pthread_cond_signal(&instance->cond_put);
+    }
+
+    pthread_mutex_unlock(&instance->mutex);
+
+    if(stat == FuriStatusOk) {
+        furi_event_loop_link_notify(&instance->event_loop_link, FuriEventLoopEventOut);
+    }
+
+    /* Return execution status */
+    return (stat);
+}
+
+uint32_t furi_message_queue_get_capacity(FuriMessageQueue* instance) {
+    /* Return maximum number of messages */
+    return instance ? instance->msg_count : 0U;
+}
+
+uint32_t furi_message_queue_get_message_size(FuriMessageQueue* instance) {
+    /* Return maximum message size */
+    return instance ? instance->msg_size : 0U;
+}
+
+uint32_t furi_message_queue_get_count(FuriMessageQueue* instance) {
+    uint32_t count = 0U;
+
+    if(instance) {
+        pthread_mutex_lock(&instance->mutex);
+        count = instance->count;
+        pthread_mutex_unlock(&instance->mutex);
+    }
+
+    /* Return number of queued messages */
+    return (count);
+}
+
+uint32_t furi_message_queue_get_space(FuriMessageQueue* instance) {
+    uint32_t space = 0U;
+
+    if(instance) {
+        pthread_mutex_lock(&instance->mutex);
+        space = instance->msg_count - instance->count;
+        pthread_mutex_unlock(&instance->mutex);
+    }
+
+    /* Return number of available slots */
+    return (space);
+}
+
+FuriStatus furi_message_queue_reset(FuriMessageQueue* instance) {
+    if(instance == NULL) {
+        return FuriStatusErrorParameter;
+    }
+
+    pthread_mutex_lock(&instance->mutex);
+    instance->head = 0U;
+    instance->count = 0U;
+    pthread_cond_broadcast(&instance->cond_put);
+    pthread_mutex_unlock(&instance->mutex);
+
+    furi_event_loop_link_notify(&instance->event_loop_link, FuriEventLoopEventOut);
+
+    /* Return execution status */
+    return FuriStatusOk;
+}
+
+static FuriEventLoopLink* furi_message_queue_event_loop_get_link(void* object) {
+    FuriMessageQueue* instance = object;
+    furi_assert(instance);
+    return &instance->event_loop_link;
+}
+
+static uint32_t furi_message_queue_event_loop_get_level(void* object, FuriEventLoopEvent event) {
+    FuriMessageQueue* instance = object;
+    furi_assert(instance);
+
+    if(event == FuriEventLoopEventIn) {
+        return furi_message_queue_get_count(instance);
+    } else {
+        return furi_message_queue_get_space(instance);
+    }
+}
+
+const FuriEventLoopContract furi_message_queue_event_loop_contract = {
+    .get_link = furi_message_queue_event_loop_get_link,
+    .get_level = furi_message_queue_event_loop_get_level,
+};
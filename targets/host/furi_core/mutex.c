@@ -0,0 +1,118 @@
+#include "furi_host_i.h"
+
+#include <core/mutex.h>
+#include <core/check.h>
+#include <core/memmgr.h>
+#include <core/common_defines.h>
+
+typedef struct {
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+
+    FuriMutexType type;
+    FuriThreadId owner;
+    uint32_t count;
+} FuriHostMutex;
+
+FuriMutex* furi_mutex_alloc(FuriMutexType type) {
+    FuriHostMutex* mutex = NULL;
+
+    if(type == FuriMutexTypeNormal || type == FuriMutexTypeRecursive) {
+        mutex = malloc(sizeof(FuriHostMutex));
+        mutex->type = type;
+        pthread_mutex_init(&mutex->mutex, NULL);
+        furi_host_cond_init(&mutex->cond);
+    } else {
+        furi_crash("Programming error");
+    }
+
+    /* Return mutex ID */
+    return mutex;
+}
+
+void furi_mutex_free(FuriMutex* instance) {
+    furi_assert(instance);
+    FuriHostMutex* mutex = instance;
+
+    pthread_cond_destroy(&mutex->cond);
+    pthread_mutex_destroy(&mutex->mutex);
+    free(mutex);
+}
+
+FuriStatus furi_mutex_acquire(FuriMutex* instance, uint32_t timeout) {
+    FuriHostMutex* mutex = instance;
+    FuriStatus stat = FuriStatusOk;
+
+    if(mutex == NULL) {
+        return FuriStatusErrorParameter;
+    }
+
+    FuriThreadId self = furi_thread_get_current_id();
+
+    struct timespec deadline;
+    if(timeout != FuriWaitForever) furi_host_deadline(&deadline, timeout);
+
+    pthread_mutex_lock(&mutex->mutex);
+
+    // Same as on target: normal mutex taken twice by the same thread blocks
+    while(mutex->owner && (mutex->owner != self || mutex->type != FuriMutexTypeRecursive)) {
+        if(timeout == 0U) {
+            stat = FuriStatusErrorResource;
+            break;
+        }
+        if(!furi_host_cond_wait(
+               &mutex->cond,
+               &mutex->mutex,
+               timeout == FuriWaitForever ? NULL : &deadline)) {
+            stat = FuriStatusErrorTimeout;
+            break;
+        }
+    }
+
+    if(stat == FuriStatusOk) {
+        mutex->owner = self;
+        mutex->count++;
+    }
+
+    pthread_mutex_unlock(&mutex->mutex);
+
+    /* Return execution status */
+    return (stat);
+}
+
+FuriStatus furi_mutex_release(FuriMutex* instance) {
+    FuriHostMutex* mutex = instance;
+    FuriStatus stat = FuriStatusOk;
+
+    if(mutex == NULL) {
+        return FuriStatusErrorParameter;
+    }
+
+    pthread_mutex_lock(&mutex->mutex);
+
+    if(mutex->owner != furi_thread_get_current_id()) {
+        stat = FuriStatusErrorResource;
+    } else if(--mutex->count == 0) {
+        mutex->owner = NULL;
+        pthread_cond_signal(&mutex->cond);
+    }
+
+    pthread_mutex_unlock(&mutex->mutex);
+
+    /* Return execution status */
+    return (stat);
+}
+
+FuriThreadId furi_mutex_get_owner(FuriMutex* instance) {
+    FuriHostMutex* mutex = instance;
+    FuriThreadId owner = NULL;
+
+    if(mutex) {
+        pthread_mutex_lock(&mutex->mutex);
+        owner = mutex->owner;
+        pthread_mutex_unlock(&mutex->mutex);
+    }
+
+    /* Return owner thread ID */
+    return (owner);
+}
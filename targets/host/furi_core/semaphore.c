@@ -0,0 +1,104 @@
+#include "furi_host_i.h"
+
+#include <core/semaphore.h>
+#include <core/check.h>
+#include <core/memmgr.h>
+#include <core/common_defines.h>
+
+typedef struct {
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+
+    uint32_t max_count;
+    uint32_t count;
+} FuriHostSemaphore;
+
+FuriSemaphore* furi_semaphore_alloc(uint32_t max_count, uint32_t initial_count) {
+    furi_assert((max_count > 0U) && (initial_count <= max_count));
+
+    FuriHostSemaphore* semaphore = malloc(sizeof(FuriHostSemaphore));
+    semaphore->max_count = max_count;
+    semaphore->count = initial_count;
+    pthread_mutex_init(&semaphore->mutex, NULL);
+    furi_host_cond_init(&semaphore->cond);
+
+    /* Return semaphore ID */
+    return semaphore;
+}
+
+void furi_semaphore_free(FuriSemaphore* instance) {
+    furi_assert(instance);
+    FuriHostSemaphore* semaphore = instance;
+
+    pthread_cond_destroy(&semaphore->cond);
+    pthread_mutex_destroy(&semaphore->mutex);
+    free(semaphore);
+}
+
+FuriStatus furi_semaphore_acquire(FuriSemaphore* instance, uint32_t timeout) {
+    furi_assert(instance);
+    FuriHostSemaphore* semaphore = instance;
+
+    FuriStatus stat = FuriStatusOk;
+
+    struct timespec deadline;
+    if(timeout != FuriWaitForever) furi_host_deadline(&deadline, timeout);
+
+    pthread_mutex_lock(&semaphore->mutex);
+
+    while(semaphore->count == 0U) {
+        if(timeout == 0U) {
+            stat = FuriStatusErrorResource;
+            break;
+        }
+        if(!furi_host_cond_wait(
+               &semaphore->cond,
+               &semaphore->mutex,
+               timeout == FuriWaitForever ? NULL : &deadline)) {
+            stat = FuriStatusErrorTimeout;
+            break;
+        }
+    }
+
+    if(stat == FuriStatusOk) {
+        semaphore->count--;
+    }
+
+    pthread_mutex_unlock(&semaphore->mutex);
+
+    /* Return execution status */
+    return (stat);
+}
+
+FuriStatus furi_semaphore_release(FuriSemaphore* instance) {
+    furi_assert(instance);
+    FuriHostSemaphore* semaphore = instance;
+
+    FuriStatus stat = FuriStatusOk;
+
+    pthread_mutex_lock(&semaphore->mutex);
+
+    if(semaphore->count == semaphore->max_count) {
+        stat = FuriStatusErrorResource;
+    } else {
+        semaphore->count++;
+        pthread_cond_signal(&semaphore->cond);
+    }
+
+    pthread_mutex_unlock(&semaphore->mutex);
+
+    /* Return execution status */
+    return (stat);
+}
+
+uint32_t furi_semaphore_get_count(FuriSemaphore* instance) {
+    furi_assert(instance);
+    FuriHostSemaphore* semaphore = instance;
+
+    pthread_mutex_lock(&semaphore->mutex);
+    uint32_t count = semaphore->count;
+    pthread_mutex_unlock(&semaphore->mutex);
+
+    /* Return number of tokens */
+    return (count);
+}
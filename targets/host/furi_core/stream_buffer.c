@@ -0,0 +1,217 @@
+#include "furi_host_i.h"
+
+#include <core/base.h>
+#include <core/check.h>
+#include <core/stream_buffer.h>
+#include <core/common_defines.h>
+#include <core/memmgr.h>
+#include <core/event_loop_link_i.h>
+
+#include <string.h>
+
+struct FuriStreamBuffer {
+    pthread_mutex_t mutex;
+    pthread_cond_t cond_send;
+    pthread_cond_t cond_receive;
+
+    uint8_t* buffer;
+    size_t size;
+    size_t trigger_level;
+    size_t head;
+    size_t count;
+
+    FuriEventLoopLink event_loop_link;
+};
+
+FuriStreamBuffer* furi_stream_buffer_alloc(size_t size, size_t trigger_level) {
+    furi_assert(size != 0);
+
+    FuriStreamBuffer* stream_buffer = malloc(sizeof(FuriStreamBuffer));
+    stream_buffer->buffer = malloc(size);
+    stream_buffer->size = size;
+    // Same as FreeRTOS: zero trigger level means one byte
+    stream_buffer->trigger_level = trigger_level ? trigger_level : 1;
+    furi_check(stream_buffer->trigger_level <= size);
+    pthread_mutex_init(&stream_buffer->mutex, NULL);
+    furi_host_cond_init(&stream_buffer->cond_send);
+    furi_host_cond_init(&stream_buffer->cond_receive);
+
+    return stream_buffer;
+};
+
+void furi_stream_buffer_free(FuriStreamBuffer* stream_buffer) {
+    furi_assert(stream_buffer);
+
+    furi_event_loop_link_check_unused(&stream_buffer->event_loop_link);
+
+    pthread_cond_destroy(&stream_buffer->cond_receive);
+    pthread_cond_destroy(&stream_buffer->cond_send);
+    pthread_mutex_destroy(&stream_buffer->mutex);
+    free(stream_buffer->buffer);
+    free(stream_buffer);
+};
+
+bool furi_stream_set_trigger_level(FuriStreamBuffer* stream_buffer, size_t trigger_level) {
+    furi_assert(stream_buffer);
+
+    if(trigger_level == 0) trigger_level = 1;
+    if(trigger_level > stream_buffer->size) return false;
+
+    pthread_mutex_lock(&stream_buffer->mutex);
+    stream_buffer->trigger_level = trigger_level;
+    pthread_cond_broadcast(&stream_buffer->cond_receive);
+    pthread_mutex_unlock(&stream_buffer->mutex);
+
+    return true;
+};
+
+size_t furi_stream_buffer_send(
+    FuriStreamBuffer* stream_buffer,
+    const void* data,
+    size_t length,
+    uint32_t timeout) {
+    furi_assert(stream_buffer);
+
+    struct timespec deadline;
+    if(timeout != FuriWaitForever) furi_host_deadline(&deadline, timeout);
+
+    pthread_mutex_lock(&stream_buffer->mutex);
+
+    // Same as FreeRTOS: wait for space for the whole chunk, then write as much as fits
+    size_t required = MIN(length, stream_buffer->size);
+    while(timeout != 0U && (stream_buffer->size - stream_buffer->count) < required) {
+        if(!furi_host_cond_wait(
+               &stream_buffer->cond_send,
+               &stream_buffer->mutex,
+               timeout == FuriWaitForever ? NULL : &deadline)) {
+            break;
+        }
+    }
+
+    size_t ret = MIN(length, stream_buffer->size - stream_buffer->count);
+    const uint8_t* src = data;
+    for(size_t i = 0; i < ret;) {
+        size_t tail = (stream_buffer->head + stream_buffer->count) % stream_buffer->size;
+        size_t chunk = MIN(ret - i, stream_buffer->size - tail);
+        memcpy(&stream_buffer->buffer[tail], &src[i], chunk);
+        stream_buffer->count += chunk;
+        i += chunk;
+    }
+
+    if(stream_buffer->count >= stream_buffer->trigger_level) {
+        pthread_cond_broadcast(&stream_buffer->cond_receive);
+    }
+
+    pthread_mutex_unlock(&stream_buffer->mutex);
+
+    if(ret > 0) {
+        furi_event_loop_link_notify(&stream_buffer->event_loop_link, FuriEventLoopEventIn);
+    }
+
+    return ret;
+};
+
+size_t furi_stream_buffer_receive(
+    FuriStreamBuffer* stream_buffer,
+    void* data,
+    size_t length,
+    uint32_t timeout) {
+    furi_assert(stream_buffer);
+
+    struct timespec deadline;
+    if(timeout != FuriWaitForever) furi_host_deadline(&deadline, timeout);
+
+    pthread_mutex_lock(&stream_buffer->mutex);
+
+    // Same as FreeRTOS: reader that found buffer empty is woken up on trigger level
+    if(stream_buffer->count == 0) {
+        while(timeout != 0U && stream_buffer->count < stream_buffer->trigger_level) {
+            if(!furi_host_cond_wait(
+                   &stream_buffer->cond_receive,
+                   &stream_buffer->mutex,
+                   timeout == FuriWaitForever ? NULL : &deadline)) {
+                break;
+            }
+        }
+    }
+
+    size_t ret = MIN(length, stream_buffer->count);
+    uint8_t* dst = data;
+    for(size_t i = 0; i < ret;) {
+        size_t chunk = MIN(ret - i, stream_buffer->size - stream_buffer->head);
+        memcpy(&dst[i], &stream_buffer->buffer[stream_buffer->head], chunk);
+        stream_buffer->head = (stream_buffer->head + chunk) % stream_buffer->size;
+        stream_buffer->count -= chunk;
+        i += chunk;
+    }
+
+    if(ret > 0) {
+        pthread_cond_broadcast(&stream_buffer->cond_send);
+    }
+
+    pthread_mutex_unlock(&stream_buffer->mutex);
+
+    if(ret > 0) {
+        furi_event_loop_link_notify(&stream_buffer->event_loop_link, FuriEventLoopEventOut);
+    }
+
+    return ret;
+}
+
+size_t furi_stream_buffer_bytes_available(FuriStreamBuffer* stream_buffer) {
+    furi_assert(stream_buffer);
+
+    pthread_mutex_lock(&stream_buffer->mutex);
+    size_t count = stream_buffer->count;
+    pthread_mutex_unlock(&stream_buffer->mutex);
+
+    return count;
+};
+
+size_t furi_stream_buffer_spaces_available(FuriStreamBuffer* stream_buffer) {
+    return stream_buffer->size - furi_stream_buffer_bytes_available(stream_buffer);
+};
+
+bool furi_stream_buffer_is_full(FuriStreamBuffer* stream_buffer) {
+    return furi_stream_buffer_spaces_available(stream_buffer) == 0;
+};
+
+bool furi_stream_buffer_is_empty(FuriStreamBuffer* stream_buffer) {
+    return furi_stream_buffer_bytes_available(stream_buffer) == 0;
+};
+
+FuriStatus furi_stream_buffer_reset(FuriStreamBuffer* stream_buffer) {
+    furi_assert(stream_buffer);
+
+    pthread_mutex_lock(&stream_buffer->mutex);
+    stream_buffer->head = 0;
+    stream_buffer->count = 0;
+    pthread_cond_broadcast(&stream_buffer->cond_send);
+    pthread_mutex_unlock(&stream_buffer->mutex);
+
+    furi_event_loop_link_notify(&stream_buffer->event_loop_link, FuriEventLoopEventOut);
+
+    return FuriStatusOk;
+}
+
+static FuriEventLoopLink* furi_stream_buffer_event_loop_get_link(void* object) {
+    FuriStreamBuffer* stream_buffer = object;
+    furi_assert(stream_buffer);
+    return &stream_buffer->event_loop_link;
+}
+
+static uint32_t furi_stream_buffer_event_loop_get_level(void* object, FuriEventLoopEvent event) {
+    FuriStreamBuffer* stream_buffer = object;
+    furi_assert(stream_buffer);
+
+    if(event == FuriEventLoopEventIn) {
+        return furi_stream_buffer_bytes_available(stream_buffer);
+    } else {
+        return furi_stream_buffer_spaces_available(stream_buffer);
+    }
+}
+
+const FuriEventLoopContract furi_stream_buffer_event_loop_contract = {
+    .get_link = furi_stream_buffer_event_loop_get_link,
+    .get_level = furi_stream_buffer_event_loop_get_level,
+};
@@ -0,0 +1,735 @@
+#include "furi_host_i.h"
+
+#include <core/thread.h>
+#include <core/kernel.h>
+#include <core/memmgr.h>
+#include <core/memmgr_heap.h>
+#include <core/check.h>
+#include <core/common_defines.h>
+#include <core/string.h>
+#include <core/log.h>
+#include <core/event_loop_link_i.h>
+
+#include <task.h>
+#include <limits.h>
+#include <sched.h>
+#include <string.h>
+
+#define TAG "FuriThread"
+
+#define THREAD_NOTIFY_INDEX 1 // Index 0 is used for stream buffers
+
+/* Host code is 64 bit and libc is not as frugal as newlib, scale stacks up */
+#define FURI_HOST_THREAD_STACK_SCALE (4)
+#define FURI_HOST_THREAD_STACK_MIN (64 * 1024)
+
+typedef struct FuriThreadStdout FuriThreadStdout;
+
+struct FuriThreadStdout {
+    FuriThreadStdoutWriteCallback write_callback;
+    FuriString* buffer;
+};
+
+struct FuriThread {
+    FuriThreadState state;
+    int32_t ret;
+
+    FuriThreadCallback callback;
+    void* context;
+
+    FuriThreadStateCallback state_callback;
+    void* state_context;
+
+    char* name;
+    char* appid;
+
+    FuriThreadPriority priority;
+
+    FuriHostTask* task;
+    size_t heap_size;
+
+    FuriThreadStdout output;
+
+    // Keep all non-alignable byte types in one place,
+    // this ensures that the size of this structure is minimal
+    bool is_service;
+    bool heap_trace_enabled;
+
+    size_t stack_size;
+};
+
+static size_t __furi_thread_stdout_write(FuriThread* thread, const char* data, size_t size);
+static int32_t __furi_thread_stdout_flush(FuriThread* thread);
+
+/* Host task registry */
+
+static pthread_mutex_t furi_host_task_registry_mutex = PTHREAD_MUTEX_INITIALIZER;
+static FuriHostTask* furi_host_task_registry = NULL;
+
+static __thread FuriHostTask* furi_host_task_self = NULL;
+
+static pthread_key_t furi_host_task_key;
+static pthread_once_t furi_host_task_key_once = PTHREAD_ONCE_INIT;
+
+static FuriHostTask* furi_host_task_alloc(FuriThread* thread) {
+    FuriHostTask* task = malloc(sizeof(FuriHostTask));
+    task->thread = thread;
+    task->priority = FuriThreadPriorityNormal;
+    pthread_mutex_init(&task->mutex, NULL);
+    furi_host_cond_init(&task->cond);
+
+    pthread_mutex_lock(&furi_host_task_registry_mutex);
+    task->next = furi_host_task_registry;
+    furi_host_task_registry = task;
+    pthread_mutex_unlock(&furi_host_task_registry_mutex);
+
+    return task;
+}
+
+static void furi_host_task_free(FuriHostTask* task) {
+    pthread_mutex_lock(&furi_host_task_registry_mutex);
+    FuriHostTask** item = &furi_host_task_registry;
+    while(*item != task) {
+        furi_check(*item);
+        item = &(*item)->next;
+    }
+    *item = task->next;
+    pthread_mutex_unlock(&furi_host_task_registry_mutex);
+
+    pthread_cond_destroy(&task->cond);
+    pthread_mutex_destroy(&task->mutex);
+    free(task);
+}
+
+static void furi_host_task_key_destructor(void* context) {
+    // Only tasks of foreign threads are bound to the key, FuriThread tasks are freed on join
+    furi_host_task_self = NULL;
+    furi_host_task_free(context);
+}
+
+static void furi_host_task_key_init(void) {
+    furi_check(pthread_key_create(&furi_host_task_key, furi_host_task_key_destructor) == 0);
+}
+
+FuriHostTask* furi_host_task_current(void) {
+    if(!furi_host_task_self) {
+        // Thread was not started by FuriThread: main thread or library owned thread
+        FuriHostTask* task = furi_host_task_alloc(NULL);
+        task->pthread = pthread_self();
+        pthread_getname_np(task->pthread, task->name, sizeof(task->name));
+
+        pthread_once(&furi_host_task_key_once, furi_host_task_key_init);
+        pthread_setspecific(furi_host_task_key, task);
+
+        furi_host_task_self = task;
+    }
+
+    return furi_host_task_self;
+}
+
+FuriHostTask* furi_host_task_current_peek(void) {
+    return furi_host_task_self;
+}
+
+/* Task notifications */
+
+static FuriHostTask* furi_host_task_get(TaskHandle_t handle) {
+    return handle ? (FuriHostTask*)handle : furi_host_task_current();
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void) {
+    return furi_host_task_current();
+}
+
+BaseType_t xTaskNotifyAndQueryIndexed(
+    TaskHandle_t handle,
+    UBaseType_t index,
+    uint32_t value,
+    eNotifyAction action,
+    uint32_t* previous_value) {
+    furi_check(index < FURI_HOST_NOTIFY_COUNT);
+    FuriHostTask* task = furi_host_task_get(handle);
+    BaseType_t ret = pdPASS;
+
+    pthread_mutex_lock(&task->mutex);
+
+    if(previous_value) *previous_value = task->notify_value[index];
+    bool was_pending = task->notify_pending[index];
+
+    switch(action) {
+    case eSetBits:
+        task->notify_value[index] |= value;
+        break;
+    case eIncrement:
+        task->notify_value[index]++;
+        break;
+    case eSetValueWithOverwrite:
+        task->notify_value[index] = value;
+        break;
+    case eSetValueWithoutOverwrite:
+        if(was_pending) {
+            ret = pdFAIL;
+        } else {
+            task->notify_value[index] = value;
+        }
+        break;
+    case eNoAction:
+    default:
+        break;
+    }
+
+    // Same as FreeRTOS: any notification, even without action, unblocks receiver
+    task->notify_pending[index] = true;
+    pthread_cond_broadcast(&task->cond);
+
+    pthread_mutex_unlock(&task->mutex);
+
+    return ret;
+}
+
+BaseType_t xTaskNotifyWaitIndexed(
+    UBaseType_t index,
+    uint32_t clear_on_entry,
+    uint32_t clear_on_exit,
+    uint32_t* value,
+    TickType_t ticks_to_wait) {
+    furi_check(index < FURI_HOST_NOTIFY_COUNT);
+    FuriHostTask* task = furi_host_task_current();
+    BaseType_t ret = pdFALSE;
+
+    struct timespec deadline;
+    if(ticks_to_wait != portMAX_DELAY) furi_host_deadline(&deadline, ticks_to_wait);
+
+    pthread_mutex_lock(&task->mutex);
+
+    if(!task->notify_pending[index]) {
+        task->notify_value[index] &= ~clear_on_entry;
+
+        if(ticks_to_wait > 0) {
+            while(!task->notify_pending[index]) {
+                if(!furi_host_cond_wait(
+                       &task->cond,
+                       &task->mutex,
+                       ticks_to_wait == portMAX_DELAY ? NULL : &deadline)) {
+                    break;
+                }
+            }
+        }
+    }
+
+    if(value) *value = task->notify_value[index];
+
+    if(task->notify_pending[index]) {
+        task->notify_value[index] &= ~clear_on_exit;
+        task->notify_pending[index] = false;
+        ret = pdTRUE;
+    }
+
+    pthread_mutex_unlock(&task->mutex);
+
+    return ret;
+}
+
+BaseType_t xTaskNotifyStateClearIndexed(TaskHandle_t handle, UBaseType_t index) {
+    furi_check(index < FURI_HOST_NOTIFY_COUNT);
+    FuriHostTask* task = furi_host_task_get(handle);
+
+    pthread_mutex_lock(&task->mutex);
+    BaseType_t ret = task->notify_pending[index] ? pdPASS : pdFAIL;
+    task->notify_pending[index] = false;
+    pthread_mutex_unlock(&task->mutex);
+
+    return ret;
+}
+
+uint32_t ulTaskNotifyValueClearIndexed(TaskHandle_t handle, UBaseType_t index, uint32_t clear) {
+    furi_check(index < FURI_HOST_NOTIFY_COUNT);
+    FuriHostTask* task = furi_host_task_get(handle);
+
+    pthread_mutex_lock(&task->mutex);
+    uint32_t ret = task->notify_value[index];
+    task->notify_value[index] &= ~clear;
+    pthread_mutex_unlock(&task->mutex);
+
+    return ret;
+}
+
+/* FuriThread */
+
+static void furi_thread_set_state(FuriThread* thread, FuriThreadState state) {
+    furi_assert(thread);
+    thread->state = state;
+    if(thread->state_callback) {
+        thread->state_callback(state, thread->state_context);
+    }
+}
+
+static void* furi_thread_body(void* context) {
+    furi_assert(context);
+    FuriThread* thread = context;
+
+    furi_host_task_self = thread->task;
+    pthread_setname_np(pthread_self(), thread->task->name);
+
+    furi_assert(thread->state == FuriThreadStateStarting);
+    furi_thread_set_state(thread, FuriThreadStateRunning);
+
+    FuriThreadId thread_id = thread->task;
+    if(thread->heap_trace_enabled == true) {
+        memmgr_heap_enable_thread_trace(thread_id);
+    }
+
+    thread->ret = thread->callback(thread->context);
+
+    if(thread->heap_trace_enabled == true) {
+        thread->heap_size = memmgr_heap_get_thread_memory(thread_id);
+        furi_log_print_format(
+            thread->heap_size ? FuriLogLevelError : FuriLogLevelInfo,
+            TAG,
+            "%s allocation balance: %zu",
+            thread->name ? thread->name : "Thread",
+            thread->heap_size);
+        memmgr_heap_disable_thread_trace(thread_id);
+    }
+
+    furi_assert(thread->state == FuriThreadStateRunning);
+
+    // flush stdout
+    __furi_thread_stdout_flush(thread);
+
+    furi_thread_set_state(thread, FuriThreadStateStopped);
+
+    return NULL;
+}
+
+FuriThread* furi_thread_alloc() {
+    FuriThread* thread = malloc(sizeof(FuriThread));
+    thread->output.buffer = furi_string_alloc();
+    thread->is_service = false;
+
+    FuriThread* parent = furi_thread_get_current();
+    if(parent && parent->appid) {
+        furi_thread_set_appid(thread, parent->appid);
+    } else {
+        furi_thread_set_appid(thread, "unknown");
+    }
+
+    if(parent) thread->heap_trace_enabled = parent->heap_trace_enabled;
+
+    return thread;
+}
+
+FuriThread* furi_thread_alloc_ex(
+    const char* name,
+    uint32_t stack_size,
+    FuriThreadCallback callback,
+    void* context) {
+    FuriThread* thread = furi_thread_alloc();
+    furi_thread_set_name(thread, name);
+    furi_thread_set_stack_size(thread, stack_size);
+    furi_thread_set_callback(thread, callback);
+    furi_thread_set_context(thread, context);
+    return thread;
+}
+
+void furi_thread_free(FuriThread* thread) {
+    furi_assert(thread);
+
+    // Ensure that use join before free
+    furi_assert(thread->state == FuriThreadStateStopped);
+    furi_assert(thread->task == NULL);
+
+    if(thread->name) free(thread->name);
+    if(thread->appid) free(thread->appid);
+    furi_string_free(thread->output.buffer);
+
+    free(thread);
+}
+
+void furi_thread_set_name(FuriThread* thread, const char* name) {
+    furi_assert(thread);
+    furi_assert(thread->state == FuriThreadStateStopped);
+    if(thread->name) free(thread->name);
+    thread->name = name ? strdup(name) : NULL;
+}
+
+void furi_thread_set_appid(FuriThread* thread, const char* appid) {
+    furi_assert(thread);
+    furi_assert(thread->state == FuriThreadStateStopped);
+    if(thread->appid) free(thread->appid);
+    thread->appid = appid ? strdup(appid) : NULL;
+}
+
+void furi_thread_mark_as_service(FuriThread* thread) {
+    thread->is_service = true;
+}
+
+void furi_thread_set_stack_size(FuriThread* thread, size_t stack_size) {
+    furi_assert(thread);
+    furi_assert(thread->state == FuriThreadStateStopped);
+    furi_assert(stack_size % 4 == 0);
+    thread->stack_size = stack_size;
+}
+
+void furi_thread_set_callback(FuriThread* thread, FuriThreadCallback callback) {
+    furi_assert(thread);
+    furi_assert(thread->state == FuriThreadStateStopped);
+    thread->callback = callback;
+}
+
+void furi_thread_set_context(FuriThread* thread, void* context) {
+    furi_assert(thread);
+    furi_assert(thread->state == FuriThreadStateStopped);
+    thread->context = context;
+}
+
+void furi_thread_set_priority(FuriThread* thread, FuriThreadPriority priority) {
+    furi_assert(thread);
+    furi_assert(thread->state == FuriThreadStateStopped);
+    furi_assert(priority >= FuriThreadPriorityIdle && priority <= FuriThreadPriorityIsr);
+    thread->priority = priority;
+}
+
+void furi_thread_set_current_priority(FuriThreadPriority priority) {
+    // Host scheduler is not controlled, priority is only recorded
+    furi_host_task_current()->priority = priority ? priority : FuriThreadPriorityNormal;
+}
+
+FuriThreadPriority furi_thread_get_current_priority() {
+    return furi_host_task_current()->priority;
+}
+
+void furi_thread_set_state_callback(FuriThread* thread, FuriThreadStateCallback callback) {
+    furi_assert(thread);
+    furi_assert(thread->state == FuriThreadStateStopped);
+    thread->state_callback = callback;
+}
+
+void furi_thread_set_state_context(FuriThread* thread, void* context) {
+    furi_assert(thread);
+    furi_assert(thread->state == FuriThreadStateStopped);
+    thread->state_context = context;
+}
+
+FuriThreadState furi_thread_get_state(FuriThread* thread) {
+    furi_assert(thread);
+    return thread->state;
+}
+
+void furi_thread_start(FuriThread* thread) {
+    furi_assert(thread);
+    furi_assert(thread->callback);
+    furi_assert(thread->state == FuriThreadStateStopped);
+    furi_assert(thread->stack_size > 0);
+
+    furi_thread_set_state(thread, FuriThreadStateStarting);
+
+    thread->task = furi_host_task_alloc(thread);
+    thread->task->priority = thread->priority ? thread->priority : FuriThreadPriorityNormal;
+    // pthread names are limited to 15 characters
+    strncpy(
+        thread->task->name, thread->name ? thread->name : "", sizeof(thread->task->name) - 1);
+
+    size_t stack_size = thread->stack_size * FURI_HOST_THREAD_STACK_SCALE;
+    if(stack_size < FURI_HOST_THREAD_STACK_MIN) stack_size = FURI_HOST_THREAD_STACK_MIN;
+
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+    furi_check(pthread_attr_setstacksize(&attr, stack_size) == 0);
+    // Thread TLS is allocated by libc here, but released on thread exit
+    memmgr_heap_host_trace_pause(true);
+    furi_check(pthread_create(&thread->task->pthread, &attr, furi_thread_body, thread) == 0);
+    memmgr_heap_host_trace_pause(false);
+    pthread_attr_destroy(&attr);
+}
+
+bool furi_thread_join(FuriThread* thread) {
+    furi_assert(thread);
+
+    furi_check(furi_thread_get_current() != thread);
+
+    if(thread->task) {
+        furi_check(pthread_join(thread->task->pthread, NULL) == 0);
+        furi_host_task_free(thread->task);
+        thread->task = NULL;
+    }
+
+    return true;
+}
+
+FuriThreadId furi_thread_get_id(FuriThread* thread) {
+    furi_assert(thread);
+    return thread->task;
+}
+
+void furi_thread_enable_heap_trace(FuriThread* thread) {
+    furi_assert(thread);
+    furi_assert(thread->state == FuriThreadStateStopped);
+    thread->heap_trace_enabled = true;
+}
+
+void furi_thread_disable_heap_trace(FuriThread* thread) {
+    furi_assert(thread);
+    furi_assert(thread->state == FuriThreadStateStopped);
+    thread->heap_trace_enabled = false;
+}
+
+size_t furi_thread_get_heap_size(FuriThread* thread) {
+    furi_assert(thread);
+    furi_assert(thread->heap_trace_enabled == true);
+    return thread->heap_size;
+}
+
+int32_t furi_thread_get_return_code(FuriThread* thread) {
+    furi_assert(thread);
+    furi_assert(thread->state == FuriThreadStateStopped);
+    return thread->ret;
+}
+
+FuriThreadId furi_thread_get_current_id() {
+    return furi_host_task_current();
+}
+
+FuriThread* furi_thread_get_current() {
+    FuriHostTask* task = furi_host_task_current_peek();
+    return task ? task->thread : NULL;
+}
+
+void furi_thread_yield() {
+    sched_yield();
+}
+
+/* Limits */
+#define MAX_BITS_TASK_NOTIFY 31U
+
+#define THREAD_FLAGS_INVALID_BITS (~((1UL << MAX_BITS_TASK_NOTIFY) - 1U))
+
+uint32_t furi_thread_flags_set(FuriThreadId thread_id, uint32_t flags) {
+    TaskHandle_t hTask = (TaskHandle_t)thread_id;
+    uint32_t rflags;
+
+    if((hTask == NULL) || ((flags & THREAD_FLAGS_INVALID_BITS) != 0U)) {
+        rflags = (uint32_t)FuriStatusErrorParameter;
+    } else {
+        rflags = (uint32_t)FuriStatusError;
+
+        (void)xTaskNotifyIndexed(hTask, THREAD_NOTIFY_INDEX, flags, eSetBits);
+        (void)xTaskNotifyAndQueryIndexed(hTask, THREAD_NOTIFY_INDEX, 0, eNoAction, &rflags);
+
+        /* Wake up event loop, if thread is running one */
+        furi_event_loop_thread_flags_notify(thread_id);
+    }
+    /* Return flags after setting */
+    return (rflags);
+}
+
+uint32_t furi_thread_flags_clear(uint32_t flags) {
+    uint32_t rflags;
+
+    if((flags & THREAD_FLAGS_INVALID_BITS) != 0U) {
+        rflags = (uint32_t)FuriStatusErrorParameter;
+    } else {
+        rflags = ulTaskNotifyValueClearIndexed(NULL, THREAD_NOTIFY_INDEX, flags);
+    }
+
+    /* Return flags before clearing */
+    return (rflags);
+}
+
+uint32_t furi_thread_flags_get(void) {
+    uint32_t rflags;
+
+    rflags = ulTaskNotifyValueClearIndexed(NULL, THREAD_NOTIFY_INDEX, 0);
+
+    return (rflags);
+}
+
+uint32_t furi_thread_flags_wait(uint32_t flags, uint32_t options, uint32_t timeout) {
+    uint32_t rflags, nval;
+    uint32_t clear;
+    uint32_t t0, td, tout;
+    BaseType_t rval;
+
+    if((flags & THREAD_FLAGS_INVALID_BITS) != 0U) {
+        rflags = (uint32_t)FuriStatusErrorParameter;
+    } else {
+        if((options & FuriFlagNoClear) == FuriFlagNoClear) {
+            clear = 0U;
+        } else {
+            clear = flags;
+        }
+
+        rflags = 0U;
+        tout = timeout;
+
+        t0 = furi_get_tick();
+        do {
+            rval = xTaskNotifyWaitIndexed(THREAD_NOTIFY_INDEX, 0, clear, &nval, tout);
+
+            if(rval == pdPASS) {
+                rflags &= flags;
+                rflags |= nval;
+
+                if((options & FuriFlagWaitAll) == FuriFlagWaitAll) {
+                    if((flags & rflags) == flags) {
+                        break;
+                    } else {
+                        if(timeout == 0U) {
+                            rflags = (uint32_t)FuriStatusErrorResource;
+                            break;
+                        }
+                    }
+                } else {
+                    if((flags & rflags) != 0) {
+                        break;
+                    } else {
+                        if(timeout == 0U) {
+                            rflags = (uint32_t)FuriStatusErrorResource;
+                            break;
+                        }
+                    }
+                }
+
+                /* Update timeout */
+                if(timeout != FuriWaitForever) {
+                    td = furi_get_tick() - t0;
+
+                    if(td > timeout) {
+                        tout = 0;
+                    } else {
+                        tout = timeout - td;
+                    }
+                }
+            } else {
+                if(timeout == 0) {
+                    rflags = (uint32_t)FuriStatusErrorResource;
+                } else {
+                    rflags = (uint32_t)FuriStatusErrorTimeout;
+                }
+            }
+        } while(rval != pdFAIL);
+    }
+
+    /* Return flags before clearing */
+    return (rflags);
+}
+
+uint32_t furi_thread_enumerate(FuriThreadId* thread_array, uint32_t array_items) {
+    uint32_t count = 0U;
+
+    if((thread_array != NULL) && (array_items != 0U)) {
+        pthread_mutex_lock(&furi_host_task_registry_mutex);
+        for(FuriHostTask* task = furi_host_task_registry; task && count < array_items;
+            task = task->next) {
+            thread_array[count++] = task;
+        }
+        pthread_mutex_unlock(&furi_host_task_registry_mutex);
+    }
+
+    return (count);
+}
+
+const char* furi_thread_get_name(FuriThreadId thread_id) {
+    FuriHostTask* task = thread_id;
+    const char* name = NULL;
+
+    if(task) {
+        name = task->thread ? task->thread->name : task->name;
+    }
+
+    return (name);
+}
+
+const char* furi_thread_get_appid(FuriThreadId thread_id) {
+    FuriHostTask* task = thread_id;
+    const char* appid = "system";
+
+    if(task && task->thread) {
+        appid = task->thread->appid;
+    }
+
+    return (appid);
+}
+
+uint32_t furi_thread_get_stack_space(FuriThreadId thread_id) {
+    // Stack watermark is not tracked on host
+    UNUSED(thread_id);
+    return 0U;
+}
+
+static size_t __furi_thread_stdout_write(FuriThread* thread, const char* data, size_t size) {
+    if(thread->output.write_callback != NULL) {
+        thread->output.write_callback(data, size);
+    } else {
+        furi_log_tx((const uint8_t*)data, size);
+    }
+    return size;
+}
+
+static int32_t __furi_thread_stdout_flush(FuriThread* thread) {
+    FuriString* buffer = thread->output.buffer;
+    size_t size = furi_string_size(buffer);
+    if(size > 0) {
+        __furi_thread_stdout_write(thread, furi_string_get_cstr(buffer), size);
+        furi_string_reset(buffer);
+    }
+    return 0;
+}
+
+void furi_thread_set_stdout_callback(FuriThreadStdoutWriteCallback callback) {
+    FuriThread* thread = furi_thread_get_current();
+    furi_assert(thread);
+    __furi_thread_stdout_flush(thread);
+    thread->output.write_callback = callback;
+}
+
+FuriThreadStdoutWriteCallback furi_thread_get_stdout_callback() {
+    FuriThread* thread = furi_thread_get_current();
+    furi_assert(thread);
+    return thread->output.write_callback;
+}
+
+size_t furi_thread_stdout_write(const char* data, size_t size) {
+    FuriThread* thread = furi_thread_get_current();
+    furi_assert(thread);
+    if(size == 0 || data == NULL) {
+        return __furi_thread_stdout_flush(thread);
+    } else {
+        if(data[size - 1] == '\n') {
+            // if the last character is a newline, we can flush buffer and write data as is, wo buffers
+            __furi_thread_stdout_flush(thread);
+            __furi_thread_stdout_write(thread, data, size);
+        } else {
+            // string_cat doesn't work here because we need to write the exact size data
+            for(size_t i = 0; i < size; i++) {
+                furi_string_push_back(thread->output.buffer, data[i]);
+                if(data[i] == '\n') {
+                    __furi_thread_stdout_flush(thread);
+                }
+            }
+        }
+    }
+
+    return size;
+}
+
+int32_t furi_thread_stdout_flush() {
+    FuriThread* thread = furi_thread_get_current();
+    furi_assert(thread);
+    return __furi_thread_stdout_flush(thread);
+}
+
+void furi_thread_suspend(FuriThreadId thread_id) {
+    UNUSED(thread_id);
+    furi_crash("Thread suspend is not supported on host");
+}
+
+void furi_thread_resume(FuriThreadId thread_id) {
+    UNUSED(thread_id);
+    furi_crash("Thread resume is not supported on host");
+}
+
+bool furi_thread_is_suspended(FuriThreadId thread_id) {
+    UNUSED(thread_id);
+    return false;
+}
@@ -0,0 +1,260 @@
+#include "furi_host_i.h"
+
+#include <core/timer.h>
+#include <core/check.h>
+#include <core/memmgr.h>
+#include <core/kernel.h>
+
+typedef struct FuriHostTimer FuriHostTimer;
+
+struct FuriHostTimer {
+    FuriTimerCallback func;
+    void* context;
+    FuriTimerType type;
+
+    bool active;
+    uint32_t period;
+    uint32_t expire;
+
+    // Active timer list, protected by service mutex
+    FuriHostTimer* next;
+};
+
+typedef struct FuriHostTimerPending FuriHostTimerPending;
+
+struct FuriHostTimerPending {
+    FuriTimerPendigCallback callback;
+    void* context;
+    uint32_t arg;
+    FuriHostTimerPending* next;
+};
+
+/* Timer service: replacement for FreeRTOS timer daemon task */
+
+static pthread_once_t furi_host_timer_once = PTHREAD_ONCE_INIT;
+static pthread_mutex_t furi_host_timer_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t furi_host_timer_cond;
+static pthread_cond_t furi_host_timer_done_cond;
+static pthread_t furi_host_timer_thread;
+
+static FuriHostTimer* furi_host_timer_list = NULL;
+static FuriHostTimer* furi_host_timer_executing = NULL;
+static FuriHostTimerPending* furi_host_timer_pending_head = NULL;
+static FuriHostTimerPending* furi_host_timer_pending_tail = NULL;
+
+static inline bool furi_host_timer_is_expired(uint32_t expire, uint32_t now) {
+    return (int32_t)(expire - now) <= 0;
+}
+
+static void furi_host_timer_list_remove(FuriHostTimer* timer) {
+    FuriHostTimer** item = &furi_host_timer_list;
+    while(*item) {
+        if(*item == timer) {
+            *item = timer->next;
+            break;
+        }
+        item = &(*item)->next;
+    }
+    timer->next = NULL;
+    timer->active = false;
+}
+
+static void furi_host_timer_list_add(FuriHostTimer* timer, uint32_t ticks) {
+    if(timer->active) furi_host_timer_list_remove(timer);
+
+    timer->period = ticks;
+    timer->expire = furi_get_tick() + ticks;
+    timer->active = true;
+    timer->next = furi_host_timer_list;
+    furi_host_timer_list = timer;
+}
+
+static void* furi_host_timer_service(void* context) {
+    UNUSED(context);
+
+    pthread_mutex_lock(&furi_host_timer_mutex);
+
+    while(true) {
+        // Deferred calls first, same as FreeRTOS daemon
+        FuriHostTimerPending* pending = furi_host_timer_pending_head;
+        if(pending) {
+            furi_host_timer_pending_head = pending->next;
+            if(!furi_host_timer_pending_head) furi_host_timer_pending_tail = NULL;
+
+            pthread_mutex_unlock(&furi_host_timer_mutex);
+            pending->callback(pending->context, pending->arg);
+            free(pending);
+            pthread_mutex_lock(&furi_host_timer_mutex);
+            continue;
+        }
+
+        FuriHostTimer* nearest = NULL;
+        uint32_t now = furi_get_tick();
+        for(FuriHostTimer* timer = furi_host_timer_list; timer; timer = timer->next) {
+            if(!nearest || (int32_t)(timer->expire - nearest->expire) < 0) {
+                nearest = timer;
+            }
+        }
+
+        if(!nearest) {
+            pthread_cond_wait(&furi_host_timer_cond, &furi_host_timer_mutex);
+        } else if(!furi_host_timer_is_expired(nearest->expire, now)) {
+            struct timespec deadline;
+            furi_host_deadline(&deadline, nearest->expire - now);
+            furi_host_cond_wait(&furi_host_timer_cond, &furi_host_timer_mutex, &deadline);
+        } else {
+            if(nearest->type == FuriTimerTypePeriodic) {
+                nearest->expire += nearest->period;
+                // Don't try to catch up if we were stalled for more than a period
+                if(furi_host_timer_is_expired(nearest->expire, now)) {
+                    nearest->expire = now + nearest->period;
+                }
+            } else {
+                furi_host_timer_list_remove(nearest);
+            }
+
+            // Timer may be freed from its own callback, don't touch it afterwards
+            FuriTimerCallback func = nearest->func;
+            void* func_context = nearest->context;
+            furi_host_timer_executing = nearest;
+
+            pthread_mutex_unlock(&furi_host_timer_mutex);
+            func(func_context);
+            pthread_mutex_lock(&furi_host_timer_mutex);
+
+            furi_host_timer_executing = NULL;
+            pthread_cond_broadcast(&furi_host_timer_done_cond);
+        }
+    }
+
+    return NULL;
+}
+
+static void furi_host_timer_service_start(void) {
+    furi_host_cond_init(&furi_host_timer_cond);
+    furi_host_cond_init(&furi_host_timer_done_cond);
+
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+    pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+    furi_check(
+        pthread_create(&furi_host_timer_thread, &attr, furi_host_timer_service, NULL) == 0);
+    pthread_attr_destroy(&attr);
+    pthread_setname_np(furi_host_timer_thread, "TimerSvc");
+}
+
+static inline void furi_host_timer_service_lock(void) {
+    pthread_once(&furi_host_timer_once, furi_host_timer_service_start);
+    pthread_mutex_lock(&furi_host_timer_mutex);
+}
+
+static inline void furi_host_timer_service_unlock(bool wake) {
+    if(wake) pthread_cond_signal(&furi_host_timer_cond);
+    pthread_mutex_unlock(&furi_host_timer_mutex);
+}
+
+/* Public API */
+
+FuriTimer* furi_timer_alloc(FuriTimerCallback func, FuriTimerType type, void* context) {
+    furi_assert(func != NULL);
+
+    FuriHostTimer* timer = malloc(sizeof(FuriHostTimer));
+    timer->func = func;
+    timer->context = context;
+    timer->type = type;
+
+    /* Return timer ID */
+    return timer;
+}
+
+void furi_timer_free(FuriTimer* instance) {
+    furi_assert(instance);
+    FuriHostTimer* timer = instance;
+
+    furi_host_timer_service_lock();
+    furi_host_timer_list_remove(timer);
+    // Same as on target: wait for callback completion unless freed from the callback
+    if(!pthread_equal(pthread_self(), furi_host_timer_thread)) {
+        while(furi_host_timer_executing == timer) {
+            pthread_cond_wait(&furi_host_timer_done_cond, &furi_host_timer_mutex);
+        }
+    }
+    furi_host_timer_service_unlock(true);
+
+    free(timer);
+}
+
+FuriStatus furi_timer_start(FuriTimer* instance, uint32_t ticks) {
+    furi_assert(instance);
+    furi_assert(ticks < portMAX_DELAY);
+    FuriHostTimer* timer = instance;
+
+    furi_host_timer_service_lock();
+    furi_host_timer_list_add(timer, ticks);
+    furi_host_timer_service_unlock(true);
+
+    /* Return execution status */
+    return FuriStatusOk;
+}
+
+FuriStatus furi_timer_restart(FuriTimer* instance, uint32_t ticks) {
+    return furi_timer_start(instance, ticks);
+}
+
+FuriStatus furi_timer_stop(FuriTimer* instance) {
+    furi_assert(instance);
+    FuriHostTimer* timer = instance;
+
+    furi_host_timer_service_lock();
+    furi_host_timer_list_remove(timer);
+    furi_host_timer_service_unlock(true);
+
+    return FuriStatusOk;
+}
+
+uint32_t furi_timer_is_running(FuriTimer* instance) {
+    furi_assert(instance);
+    FuriHostTimer* timer = instance;
+
+    furi_host_timer_service_lock();
+    bool active = timer->active;
+    furi_host_timer_service_unlock(false);
+
+    /* Return 0: not running, 1: running */
+    return (uint32_t)active;
+}
+
+uint32_t furi_timer_get_expire_time(FuriTimer* instance) {
+    furi_assert(instance);
+    FuriHostTimer* timer = instance;
+
+    furi_host_timer_service_lock();
+    uint32_t expire = timer->expire;
+    furi_host_timer_service_unlock(false);
+
+    return expire;
+}
+
+void furi_timer_pending_callback(FuriTimerPendigCallback callback, void* context, uint32_t arg) {
+    furi_assert(callback);
+
+    FuriHostTimerPending* pending = malloc(sizeof(FuriHostTimerPending));
+    pending->callback = callback;
+    pending->context = context;
+    pending->arg = arg;
+
+    furi_host_timer_service_lock();
+    if(furi_host_timer_pending_tail) {
+        furi_host_timer_pending_tail->next = pending;
+    } else {
+        furi_host_timer_pending_head = pending;
+    }
+    furi_host_timer_pending_tail = pending;
+    furi_host_timer_service_unlock(true);
+}
+
+void furi_timer_set_thread_priority(FuriTimerThreadPriority priority) {
+    // Host scheduler is not priority based, accept and ignore
+    furi_check(
+        priority == FuriTimerThreadPriorityNormal || priority == FuriTimerThreadPriorityElevated);
+}
@@ -0,0 +1,19 @@
+/**
+ * @file furi_hal.h
+ * Furi HAL API: host subset
+ *
+ * Only the parts of HAL that furi core and hardware independent libraries
+ * depend on. Add shims here when host build of a library needs more.
+ */
+
+#pragma once
+
+// Device HAL headers bring in furi core, furi sources rely on it
+#include <furi.h>
+
+#include <furi_hal_cortex.h>
+#include <furi_hal_gpio.h>
+#include <furi_hal_random.h>
+#include <furi_hal_rtc.h>
+#include <furi_hal_subghz.h>
+#include <furi_hal_version.h>
@@ -0,0 +1,40 @@
+#include <furi_hal_cortex.h>
+#include <furi.h>
+
+#include <time.h>
+
+// Core clock of the device
+#define FURI_HAL_CORTEX_INSTRUCTIONS_PER_MICROSECOND (64U)
+
+static uint32_t furi_hal_cortex_get_cycles(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    const uint64_t ns = (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+    return (uint32_t)(ns * FURI_HAL_CORTEX_INSTRUCTIONS_PER_MICROSECOND / 1000U);
+}
+
+void furi_hal_cortex_delay_us(uint32_t microseconds) {
+    furi_hal_cortex_timer_wait(furi_hal_cortex_timer_get(microseconds));
+}
+
+uint32_t furi_hal_cortex_instructions_per_microsecond(void) {
+    return FURI_HAL_CORTEX_INSTRUCTIONS_PER_MICROSECOND;
+}
+
+FuriHalCortexTimer furi_hal_cortex_timer_get(uint32_t timeout_us) {
+    furi_check(timeout_us < (UINT32_MAX / FURI_HAL_CORTEX_INSTRUCTIONS_PER_MICROSECOND));
+
+    FuriHalCortexTimer cortex_timer = {0};
+    cortex_timer.start = furi_hal_cortex_get_cycles();
+    cortex_timer.value = FURI_HAL_CORTEX_INSTRUCTIONS_PER_MICROSECOND * timeout_us;
+    return cortex_timer;
+}
+
+bool furi_hal_cortex_timer_is_expired(FuriHalCortexTimer cortex_timer) {
+    return !((furi_hal_cortex_get_cycles() - cortex_timer.start) < cortex_timer.value);
+}
+
+void furi_hal_cortex_timer_wait(FuriHalCortexTimer cortex_timer) {
+    while(!furi_hal_cortex_timer_is_expired(cortex_timer))
+        ;
+}
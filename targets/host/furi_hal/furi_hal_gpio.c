@@ -0,0 +1,54 @@
+#include <furi_hal_gpio.h>
+#include <furi.h>
+
+/* Mode, pull and speed have no meaning for memory backed pins */
+
+void furi_hal_gpio_init_simple(const GpioPin* gpio, const GpioMode mode) {
+    furi_hal_gpio_init(gpio, mode, GpioPullNo, GpioSpeedLow);
+}
+
+void furi_hal_gpio_init(
+    const GpioPin* gpio,
+    const GpioMode mode,
+    const GpioPull pull,
+    const GpioSpeed speed) {
+    furi_hal_gpio_init_ex(gpio, mode, pull, speed, GpioAltFnUnused);
+}
+
+void furi_hal_gpio_init_ex(
+    const GpioPin* gpio,
+    const GpioMode mode,
+    const GpioPull pull,
+    const GpioSpeed speed,
+    const GpioAltFn alt_fn) {
+    furi_check(gpio);
+    furi_check(gpio->port);
+    UNUSED(mode);
+    UNUSED(speed);
+    UNUSED(alt_fn);
+
+    // Floating input reads as pulled level, same as good enough hardware
+    if(pull == GpioPullUp) {
+        gpio->port->IDR |= gpio->pin;
+    } else if(pull == GpioPullDown) {
+        gpio->port->IDR &= ~(uint32_t)gpio->pin;
+    }
+}
+
+void furi_hal_gpio_add_int_callback(const GpioPin* gpio, GpioExtiCallback cb, void* ctx) {
+    furi_check(gpio);
+    furi_check(cb);
+    UNUSED(ctx);
+}
+
+void furi_hal_gpio_enable_int_callback(const GpioPin* gpio) {
+    furi_check(gpio);
+}
+
+void furi_hal_gpio_disable_int_callback(const GpioPin* gpio) {
+    furi_check(gpio);
+}
+
+void furi_hal_gpio_remove_int_callback(const GpioPin* gpio) {
+    furi_check(gpio);
+}
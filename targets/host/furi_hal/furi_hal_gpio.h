@@ -0,0 +1,173 @@
+/**
+ * @file furi_hal_gpio.h
+ * GPIO HAL API: host shim
+ *
+ * Pins are backed by plain memory: written state is looped back to input
+ * register, tests can drive IDR directly to simulate external signal.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define GPIO_NUMBER (16U)
+
+/** Host GPIO port registers */
+typedef struct {
+    volatile uint32_t IDR;
+    volatile uint32_t ODR;
+} GPIO_TypeDef;
+
+/** Gpio interrupt type */
+typedef void (*GpioExtiCallback)(void* ctx);
+
+/** Gpio modes */
+typedef enum {
+    GpioModeInput,
+    GpioModeOutputPushPull,
+    GpioModeOutputOpenDrain,
+    GpioModeAltFunctionPushPull,
+    GpioModeAltFunctionOpenDrain,
+    GpioModeAnalog,
+    GpioModeInterruptRise,
+    GpioModeInterruptFall,
+    GpioModeInterruptRiseFall,
+    GpioModeEventRise,
+    GpioModeEventFall,
+    GpioModeEventRiseFall,
+} GpioMode;
+
+/** Gpio pull modes */
+typedef enum {
+    GpioPullNo,
+    GpioPullUp,
+    GpioPullDown,
+} GpioPull;
+
+/** Gpio speed modes */
+typedef enum {
+    GpioSpeedLow,
+    GpioSpeedMedium,
+    GpioSpeedHigh,
+    GpioSpeedVeryHigh,
+} GpioSpeed;
+
+/** Gpio alternate functions, there are none on host */
+typedef enum {
+    GpioAltFnUnused = 16, /*!< just dummy value */
+} GpioAltFn;
+
+/** Gpio structure */
+typedef struct {
+    GPIO_TypeDef* port;
+    uint16_t pin;
+} GpioPin;
+
+/** GPIO initialization function, simple version
+ * @param gpio  GpioPin
+ * @param mode  GpioMode
+ */
+void furi_hal_gpio_init_simple(const GpioPin* gpio, const GpioMode mode);
+
+/** GPIO initialization function, normal version
+ * @param gpio  GpioPin
+ * @param mode  GpioMode
+ * @param pull  GpioPull
+ * @param speed GpioSpeed
+ */
+void furi_hal_gpio_init(
+    const GpioPin* gpio,
+    const GpioMode mode,
+    const GpioPull pull,
+    const GpioSpeed speed);
+
+/** GPIO initialization function, extended version
+ * @param gpio  GpioPin
+ * @param mode  GpioMode
+ * @param pull  GpioPull
+ * @param speed GpioSpeed
+ * @param alt_fn GpioAltFn
+ */
+void furi_hal_gpio_init_ex(
+    const GpioPin* gpio,
+    const GpioMode mode,
+    const GpioPull pull,
+    const GpioSpeed speed,
+    const GpioAltFn alt_fn);
+
+/** Add and enable interrupt, never triggered on host
+ * @param gpio GpioPin
+ * @param cb   GpioExtiCallback
+ * @param ctx  context for callback
+ */
+void furi_hal_gpio_add_int_callback(const GpioPin* gpio, GpioExtiCallback cb, void* ctx);
+
+/** Enable interrupt
+ * @param gpio GpioPin
+ */
+void furi_hal_gpio_enable_int_callback(const GpioPin* gpio);
+
+/** Disable interrupt
+ * @param gpio GpioPin
+ */
+void furi_hal_gpio_disable_int_callback(const GpioPin* gpio);
+
+/** Remove interrupt
+ * @param gpio GpioPin
+ */
+void furi_hal_gpio_remove_int_callback(const GpioPin* gpio);
+
+/**
+ * GPIO write pin
+ * @param gpio  GpioPin
+ * @param state true / false
+ */
+static inline void furi_hal_gpio_write(const GpioPin* gpio, const bool state) {
+    if(state == true) {
+        gpio->port->ODR |= gpio->pin;
+        gpio->port->IDR |= gpio->pin;
+    } else {
+        gpio->port->ODR &= ~(uint32_t)gpio->pin;
+        gpio->port->IDR &= ~(uint32_t)gpio->pin;
+    }
+}
+
+/**
+ * GPIO write pin
+ * @param port GPIO port
+ * @param pin pin mask
+ * @param state true / false
+ */
+static inline void
+    furi_hal_gpio_write_port_pin(GPIO_TypeDef* port, uint16_t pin, const bool state) {
+    const GpioPin gpio = {.port = port, .pin = pin};
+    furi_hal_gpio_write(&gpio, state);
+}
+
+/**
+ * GPIO read pin
+ * @param gpio GpioPin
+ * @return true / false
+ */
+static inline bool furi_hal_gpio_read(const GpioPin* gpio) {
+    return (gpio->port->IDR & gpio->pin) != 0x00U;
+}
+
+/**
+ * GPIO read pin
+ * @param port GPIO port
+ * @param pin pin mask
+ * @return true / false
+ */
+static inline bool furi_hal_gpio_read_port_pin(GPIO_TypeDef* port, uint16_t pin) {
+    return (port->IDR & pin) != 0x00U;
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,21 @@
+#include <furi_hal_random.h>
+#include <furi.h>
+
+#include <sys/random.h>
+
+void furi_hal_random_init(void) {
+}
+
+uint32_t furi_hal_random_get(void) {
+    uint32_t random_val = 0;
+    furi_hal_random_fill_buf((uint8_t*)&random_val, sizeof(random_val));
+    return random_val;
+}
+
+void furi_hal_random_fill_buf(uint8_t* buf, uint32_t len) {
+    for(uint32_t i = 0; i < len;) {
+        const ssize_t ret = getrandom(&buf[i], len - i, 0);
+        furi_check(ret > 0);
+        i += ret;
+    }
+}
@@ -0,0 +1,158 @@
+#include <furi_hal_rtc.h>
+#include <furi.h>
+
+#include <time.h>
+
+#define FURI_HAL_RTC_SECONDS_PER_MINUTE 60
+#define FURI_HAL_RTC_SECONDS_PER_HOUR (FURI_HAL_RTC_SECONDS_PER_MINUTE * 60)
+#define FURI_HAL_RTC_SECONDS_PER_DAY (FURI_HAL_RTC_SECONDS_PER_HOUR * 24)
+#define FURI_HAL_RTC_MONTHS_COUNT 12
+#define FURI_HAL_RTC_EPOCH_START_YEAR 1970
+
+static const uint8_t furi_hal_rtc_days_per_month[2][FURI_HAL_RTC_MONTHS_COUNT] = {
+    {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31},
+    {31, 29, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31}};
+
+static const uint16_t furi_hal_rtc_days_per_year[] = {365, 366};
+
+/* Settings live in memory only, defaults match a freshly formatted device */
+static FuriHalRtcLocaleUnits furi_hal_rtc_locale_units = FuriHalRtcLocaleUnitsMetric;
+static FuriHalRtcLocaleTimeFormat furi_hal_rtc_locale_timeformat = FuriHalRtcLocaleTimeFormat24h;
+static FuriHalRtcLocaleDateFormat furi_hal_rtc_locale_dateformat = FuriHalRtcLocaleDateFormatDMY;
+
+void furi_hal_rtc_set_locale_units(FuriHalRtcLocaleUnits value) {
+    furi_hal_rtc_locale_units = value;
+}
+
+FuriHalRtcLocaleUnits furi_hal_rtc_get_locale_units(void) {
+    return furi_hal_rtc_locale_units;
+}
+
+void furi_hal_rtc_set_locale_timeformat(FuriHalRtcLocaleTimeFormat value) {
+    furi_hal_rtc_locale_timeformat = value;
+}
+
+FuriHalRtcLocaleTimeFormat furi_hal_rtc_get_locale_timeformat(void) {
+    return furi_hal_rtc_locale_timeformat;
+}
+
+void furi_hal_rtc_set_locale_dateformat(FuriHalRtcLocaleDateFormat value) {
+    furi_hal_rtc_locale_dateformat = value;
+}
+
+FuriHalRtcLocaleDateFormat furi_hal_rtc_get_locale_dateformat(void) {
+    return furi_hal_rtc_locale_dateformat;
+}
+
+void furi_hal_rtc_get_datetime(FuriHalRtcDateTime* datetime) {
+    furi_check(datetime);
+
+    time_t now = time(NULL);
+    struct tm tm;
+    gmtime_r(&now, &tm);
+
+    datetime->year = tm.tm_year + 1900;
+    datetime->month = tm.tm_mon + 1;
+    datetime->day = tm.tm_mday;
+    datetime->weekday = (tm.tm_wday == 0) ? 7 : tm.tm_wday;
+    datetime->hour = tm.tm_hour;
+    datetime->minute = tm.tm_min;
+    datetime->second = tm.tm_sec;
+}
+
+bool furi_hal_rtc_validate_datetime(FuriHalRtcDateTime* datetime) {
+    bool invalid = false;
+
+    invalid |= (datetime->second > 59);
+    invalid |= (datetime->minute > 59);
+    invalid |= (datetime->hour > 23);
+
+    invalid |= (datetime->year < 2000);
+    invalid |= (datetime->year > 2099);
+
+    invalid |= (datetime->month == 0);
+    invalid |= (datetime->month > 12);
+
+    invalid |= (datetime->day == 0);
+    invalid |= (datetime->day > 31);
+
+    invalid |= (datetime->weekday == 0);
+    invalid |= (datetime->weekday > 7);
+
+    return !invalid;
+}
+
+uint32_t furi_hal_rtc_get_timestamp(void) {
+    FuriHalRtcDateTime datetime = {0};
+    furi_hal_rtc_get_datetime(&datetime);
+    return furi_hal_rtc_datetime_to_timestamp(&datetime);
+}
+
+uint32_t furi_hal_rtc_datetime_to_timestamp(FuriHalRtcDateTime* datetime) {
+    uint32_t timestamp = 0;
+    uint8_t years = 0;
+    uint8_t leap_years = 0;
+
+    for(uint16_t y = FURI_HAL_RTC_EPOCH_START_YEAR; y < datetime->year; y++) {
+        if(furi_hal_rtc_is_leap_year(y)) {
+            leap_years++;
+        } else {
+            years++;
+        }
+    }
+
+    timestamp +=
+        ((years * furi_hal_rtc_days_per_year[0]) + (leap_years * furi_hal_rtc_days_per_year[1])) *
+        FURI_HAL_RTC_SECONDS_PER_DAY;
+
+    bool leap_year = furi_hal_rtc_is_leap_year(datetime->year);
+
+    for(uint8_t m = 1; m < datetime->month; m++) {
+        timestamp += furi_hal_rtc_get_days_per_month(leap_year, m) * FURI_HAL_RTC_SECONDS_PER_DAY;
+    }
+
+    timestamp += (datetime->day - 1) * FURI_HAL_RTC_SECONDS_PER_DAY;
+    timestamp += datetime->hour * FURI_HAL_RTC_SECONDS_PER_HOUR;
+    timestamp += datetime->minute * FURI_HAL_RTC_SECONDS_PER_MINUTE;
+    timestamp += datetime->second;
+
+    return timestamp;
+}
+
+void furi_hal_rtc_timestamp_to_datetime(uint32_t timestamp, FuriHalRtcDateTime* datetime) {
+    uint32_t days = timestamp / FURI_HAL_RTC_SECONDS_PER_DAY;
+    uint32_t seconds_in_day = timestamp % FURI_HAL_RTC_SECONDS_PER_DAY;
+
+    datetime->year = FURI_HAL_RTC_EPOCH_START_YEAR;
+
+    while(days >= furi_hal_rtc_get_days_per_year(datetime->year)) {
+        days -= furi_hal_rtc_get_days_per_year(datetime->year);
+        (datetime->year)++;
+    }
+
+    datetime->month = 1;
+    while(days >= furi_hal_rtc_get_days_per_month(
+                      furi_hal_rtc_is_leap_year(datetime->year), datetime->month)) {
+        days -= furi_hal_rtc_get_days_per_month(
+            furi_hal_rtc_is_leap_year(datetime->year), datetime->month);
+        (datetime->month)++;
+    }
+
+    datetime->day = days + 1;
+    datetime->hour = seconds_in_day / FURI_HAL_RTC_SECONDS_PER_HOUR;
+    datetime->minute =
+        (seconds_in_day % FURI_HAL_RTC_SECONDS_PER_HOUR) / FURI_HAL_RTC_SECONDS_PER_MINUTE;
+    datetime->second = seconds_in_day % FURI_HAL_RTC_SECONDS_PER_MINUTE;
+}
+
+uint16_t furi_hal_rtc_get_days_per_year(uint16_t year) {
+    return furi_hal_rtc_days_per_year[furi_hal_rtc_is_leap_year(year) ? 1 : 0];
+}
+
+bool furi_hal_rtc_is_leap_year(uint16_t year) {
+    return (((year) % 4 == 0) && ((year) % 100 != 0)) || ((year) % 400 == 0);
+}
+
+uint8_t furi_hal_rtc_get_days_per_month(bool leap_year, uint8_t month) {
+    return furi_hal_rtc_days_per_month[leap_year ? 1 : 0][month - 1];
+}
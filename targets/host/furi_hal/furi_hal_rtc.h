@@ -0,0 +1,81 @@
+/**
+ * @file furi_hal_rtc.h
+ * Furi Hal RTC API: host subset
+ *
+ * Date and time come from the host clock in UTC. Locale settings are kept in
+ * memory and start with the firmware defaults, so formatted output does not
+ * depend on the machine it runs on.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    // Time
+    uint8_t hour; /**< Hour in 24H format: 0-23 */
+    uint8_t minute; /**< Minute: 0-59 */
+    uint8_t second; /**< Second: 0-59 */
+    // Date
+    uint8_t day; /**< Current day: 1-31 */
+    uint8_t month; /**< Current month: 1-12 */
+    uint16_t year; /**< Current year: 2000-2099 */
+    uint8_t weekday; /**< Current weekday: 1-7 */
+} FuriHalRtcDateTime;
+
+typedef enum {
+    FuriHalRtcLocaleUnitsMetric = 0x0, /**< Metric measurement units */
+    FuriHalRtcLocaleUnitsImperial = 0x1, /**< Imperial measurement units */
+} FuriHalRtcLocaleUnits;
+
+typedef enum {
+    FuriHalRtcLocaleTimeFormat24h = 0x0, /**< 24-hour format */
+    FuriHalRtcLocaleTimeFormat12h = 0x1, /**< 12-hour format */
+} FuriHalRtcLocaleTimeFormat;
+
+typedef enum {
+    FuriHalRtcLocaleDateFormatDMY = 0x0, /**< Day/Month/Year */
+    FuriHalRtcLocaleDateFormatMDY = 0x1, /**< Month/Day/Year */
+    FuriHalRtcLocaleDateFormatYMD = 0x2, /**< Year/Month/Day */
+} FuriHalRtcLocaleDateFormat;
+
+void furi_hal_rtc_set_locale_units(FuriHalRtcLocaleUnits value);
+
+FuriHalRtcLocaleUnits furi_hal_rtc_get_locale_units(void);
+
+void furi_hal_rtc_set_locale_timeformat(FuriHalRtcLocaleTimeFormat value);
+
+FuriHalRtcLocaleTimeFormat furi_hal_rtc_get_locale_timeformat(void);
+
+void furi_hal_rtc_set_locale_dateformat(FuriHalRtcLocaleDateFormat value);
+
+FuriHalRtcLocaleDateFormat furi_hal_rtc_get_locale_dateformat(void);
+
+/** Get host date time in UTC
+ *
+ * @param      datetime  The datetime
+ */
+void furi_hal_rtc_get_datetime(FuriHalRtcDateTime* datetime);
+
+bool furi_hal_rtc_validate_datetime(FuriHalRtcDateTime* datetime);
+
+uint32_t furi_hal_rtc_get_timestamp(void);
+
+uint32_t furi_hal_rtc_datetime_to_timestamp(FuriHalRtcDateTime* datetime);
+
+void furi_hal_rtc_timestamp_to_datetime(uint32_t timestamp, FuriHalRtcDateTime* datetime);
+
+uint16_t furi_hal_rtc_get_days_per_year(uint16_t year);
+
+bool furi_hal_rtc_is_leap_year(uint16_t year);
+
+uint8_t furi_hal_rtc_get_days_per_month(bool leap_year, uint8_t month);
+
+#ifdef __cplusplus
+}
+#endif
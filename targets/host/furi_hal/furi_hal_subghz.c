@@ -0,0 +1,12 @@
+#include <furi_hal_subghz.h>
+
+/* Same bands as targets/f7/furi_hal/furi_hal_subghz.c */
+bool furi_hal_subghz_is_frequency_valid(uint32_t value) {
+    if(!(value >= 299999755 && value <= 348000335) &&
+       !(value >= 386999938 && value <= 464000000) &&
+       !(value >= 778999847 && value <= 928000000)) {
+        return false;
+    }
+
+    return true;
+}
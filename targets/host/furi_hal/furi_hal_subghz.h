@@ -0,0 +1,28 @@
+/**
+ * @file furi_hal_subghz.h
+ * SubGhz HAL API: host subset
+ *
+ * No radio, only frequency range checks of CC1101 that settings and protocol
+ * code depend on.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Check if frequency is in valid range
+ *
+ * @param      value  frequency in Hz
+ *
+ * @return     true if frequency is valid, otherwise false
+ */
+bool furi_hal_subghz_is_frequency_valid(uint32_t value);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,5 @@
+#include <furi_hal_version.h>
+
+FuriHalVersionRegion furi_hal_version_get_hw_region(void) {
+    return FuriHalVersionRegionUnknown;
+}
@@ -0,0 +1,31 @@
+/**
+ * @file furi_hal_version.h
+ * Version HAL API: host subset
+ *
+ * Host has no OTP, hardware region is the one of a device without region.
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Device Regions */
+typedef enum {
+    FuriHalVersionRegionUnknown = 0x00,
+    FuriHalVersionRegionEuRu = 0x01,
+    FuriHalVersionRegionUsCaAu = 0x02,
+    FuriHalVersionRegionJp = 0x03,
+    FuriHalVersionRegionWorld = 0x04,
+} FuriHalVersionRegion;
+
+/** Get hardware region
+ *
+ * @return     Hardware Region
+ */
+FuriHalVersionRegion furi_hal_version_get_hw_region(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,28 @@
+/**
+ * @file FreeRTOS.h
+ * Host replacement for FreeRTOS base definitions
+ *
+ * There is no FreeRTOS on host. This header and task.h expose the small
+ * subset of the kernel API that target independent furi core code uses
+ * directly (task notifications), implemented by the host thread port.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+typedef uint32_t TickType_t;
+
+#define pdFALSE ((BaseType_t)0)
+#define pdTRUE ((BaseType_t)1)
+#define pdPASS (pdTRUE)
+#define pdFAIL (pdFALSE)
+
+#define portMAX_DELAY ((TickType_t)0xffffffffUL)
+#define portYIELD_FROM_ISR(x) ((void)(x))
+
+#define configTICK_RATE_HZ_RAW 1000
+#define configTICK_RATE_HZ ((TickType_t)configTICK_RATE_HZ_RAW)
+#define configTASK_NOTIFICATION_ARRAY_ENTRIES 3
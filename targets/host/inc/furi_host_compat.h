@@ -0,0 +1,26 @@
+/**
+ * @file furi_host_compat.h
+ * Newlib definitions that firmware headers rely on, missing in host libc
+ *
+ * Must be force included into every host translation unit: -include furi_host_compat.h
+ */
+#pragma once
+
+#ifndef _ATTRIBUTE
+#define _ATTRIBUTE(attrs) __attribute__(attrs)
+#endif
+
+#include <string.h>
+
+#if defined(__GLIBC__) && !__GLIBC_PREREQ(2, 38)
+/* strlcpy came to glibc in 2.38, newlib always had it */
+static inline size_t strlcpy(char* dst, const char* src, size_t size) {
+    const size_t src_len = strlen(src);
+    if(size) {
+        const size_t copy_len = src_len < size - 1 ? src_len : size - 1;
+        memcpy(dst, src, copy_len);
+        dst[copy_len] = '\0';
+    }
+    return src_len;
+}
+#endif
@@ -0,0 +1,9 @@
+#pragma once
+
+/* newlib names of byte swap helpers, glibc has them in <byteswap.h> as bswap_N */
+
+#include <endian.h>
+
+#define __bswap16(_x) __builtin_bswap16(_x)
+#define __bswap32(_x) __builtin_bswap32(_x)
+#define __bswap64(_x) __builtin_bswap64(_x)
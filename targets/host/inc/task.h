@@ -0,0 +1,54 @@
+/**
+ * @file task.h
+ * Host replacement for FreeRTOS task notifications
+ *
+ * Semantics follow FreeRTOS: every thread has an array of notification
+ * values with pending state, see FreeRTOS documentation for details.
+ */
+#pragma once
+
+#include "FreeRTOS.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef void* TaskHandle_t;
+
+typedef enum {
+    eNoAction = 0,
+    eSetBits,
+    eIncrement,
+    eSetValueWithOverwrite,
+    eSetValueWithoutOverwrite,
+} eNotifyAction;
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void);
+
+BaseType_t xTaskNotifyAndQueryIndexed(
+    TaskHandle_t task,
+    UBaseType_t index,
+    uint32_t value,
+    eNotifyAction action,
+    uint32_t* previous_value);
+
+BaseType_t xTaskNotifyWaitIndexed(
+    UBaseType_t index,
+    uint32_t clear_on_entry,
+    uint32_t clear_on_exit,
+    uint32_t* value,
+    TickType_t ticks_to_wait);
+
+BaseType_t xTaskNotifyStateClearIndexed(TaskHandle_t task, UBaseType_t index);
+
+uint32_t ulTaskNotifyValueClearIndexed(TaskHandle_t task, UBaseType_t index, uint32_t clear);
+
+#define xTaskNotifyIndexed(task, index, value, action) \
+    xTaskNotifyAndQueryIndexed((task), (index), (value), (action), NULL)
+
+#define xTaskNotifyIndexedFromISR(task, index, value, action, yield) \
+    ((void)(yield), xTaskNotifyIndexed((task), (index), (value), (action)))
+
+#ifdef __cplusplus
+}
+#endif
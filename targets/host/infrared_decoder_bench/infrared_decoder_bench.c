@@ -0,0 +1,358 @@
+#include <furi.h>
+#include <flipper_format/flipper_format.h>
+#include <infrared/encoder_decoder/infrared.h>
+#include <infrared/encoder_decoder/nec/infrared_protocol_nec.h>
+#include <infrared/encoder_decoder/samsung/infrared_protocol_samsung.h>
+#include <infrared/encoder_decoder/rc5/infrared_protocol_rc5.h>
+#include <infrared/encoder_decoder/rc6/infrared_protocol_rc6.h>
+#include <infrared/encoder_decoder/sirc/infrared_protocol_sirc.h>
+#include <infrared/encoder_decoder/kaseikyo/infrared_protocol_kaseikyo.h>
+#include <infrared/encoder_decoder/rca/infrared_protocol_rca.h>
+#include <storage/storage.h>
+#include <storage_host.h>
+
+#include <errno.h>
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define TAG "InfraredDecoderBench"
+
+#define INFRARED_DECODER_BENCH_ROUNDS (100U)
+#define INFRARED_DECODER_BENCH_SIGNAL_PREFIX "decoder_input"
+
+typedef struct {
+    InfraredAlloc alloc;
+    InfraredDecode decode;
+    InfraredDecoderReset reset;
+    InfraredFree free;
+    InfraredDecoderCheckReady check_ready;
+} InfraredDecoderBenchDecoder;
+
+/* Every decoder gets every edge, as infrared_decode() did before the active set */
+static const InfraredDecoderBenchDecoder infrared_decoder_bench_decoders[] = {
+    {infrared_decoder_nec_alloc,
+     infrared_decoder_nec_decode,
+     infrared_decoder_nec_reset,
+     infrared_decoder_nec_free,
+     infrared_decoder_nec_check_ready},
+    {infrared_decoder_samsung32_alloc,
+     infrared_decoder_samsung32_decode,
+     infrared_decoder_samsung32_reset,
+     infrared_decoder_samsung32_free,
+     infrared_decoder_samsung32_check_ready},
+    {infrared_decoder_rc5_alloc,
+     infrared_decoder_rc5_decode,
+     infrared_decoder_rc5_reset,
+     infrared_decoder_rc5_free,
+     infrared_decoder_rc5_check_ready},
+    {infrared_decoder_rc6_alloc,
+     infrared_decoder_rc6_decode,
+     infrared_decoder_rc6_reset,
+     infrared_decoder_rc6_free,
+     infrared_decoder_rc6_check_ready},
+    {infrared_decoder_sirc_alloc,
+     infrared_decoder_sirc_decode,
+     infrared_decoder_sirc_reset,
+     infrared_decoder_sirc_free,
+     infrared_decoder_sirc_check_ready},
+    {infrared_decoder_kaseikyo_alloc,
+     infrared_decoder_kaseikyo_decode,
+     infrared_decoder_kaseikyo_reset,
+     infrared_decoder_kaseikyo_free,
+     infrared_decoder_kaseikyo_check_ready},
+    {infrared_decoder_rca_alloc,
+     infrared_decoder_rca_decode,
+     infrared_decoder_rca_reset,
+     infrared_decoder_rca_free,
+     infrared_decoder_rca_check_ready},
+};
+
+#define INFRARED_DECODER_BENCH_DECODERS_COUNT COUNT_OF(infrared_decoder_bench_decoders)
+
+typedef struct {
+    void* ctx[INFRARED_DECODER_BENCH_DECODERS_COUNT];
+} InfraredDecoderBenchAll;
+
+typedef struct {
+    uint32_t* timings;
+    size_t count;
+} InfraredDecoderBenchSignal;
+
+typedef struct {
+    uint64_t edges;
+    uint64_t all_ns;
+    uint64_t active_ns;
+    uint32_t messages;
+} InfraredDecoderBenchStats;
+
+static uint64_t infrared_decoder_bench_time_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static const InfraredMessage* infrared_decoder_bench_all_decode(
+    InfraredDecoderBenchAll* all,
+    bool level,
+    uint32_t duration) {
+    const InfraredMessage* result = NULL;
+    for(size_t i = 0; i < INFRARED_DECODER_BENCH_DECODERS_COUNT; i++) {
+        const InfraredMessage* message =
+            infrared_decoder_bench_decoders[i].decode(all->ctx[i], level, duration);
+        if(!result && message) result = message;
+    }
+    return result;
+}
+
+static const InfraredMessage*
+    infrared_decoder_bench_all_check_ready(InfraredDecoderBenchAll* all) {
+    const InfraredMessage* result = NULL;
+    for(size_t i = 0; i < INFRARED_DECODER_BENCH_DECODERS_COUNT; i++) {
+        const InfraredMessage* message =
+            infrared_decoder_bench_decoders[i].check_ready(all->ctx[i]);
+        if(!result && message) result = message;
+    }
+    return result;
+}
+
+static void infrared_decoder_bench_all_reset(InfraredDecoderBenchAll* all) {
+    for(size_t i = 0; i < INFRARED_DECODER_BENCH_DECODERS_COUNT; i++) {
+        infrared_decoder_bench_decoders[i].reset(all->ctx[i]);
+    }
+}
+
+static void
+    infrared_decoder_bench_print_message(FuriString* output, const InfraredMessage* message) {
+    if(!output || !message) return;
+    furi_string_cat_printf(
+        output,
+        "%s A:0x%08lX C:0x%08lX%s\n",
+        infrared_get_protocol_name(message->protocol),
+        (unsigned long)message->address,
+        (unsigned long)message->command,
+        message->repeat ? " R" : "");
+}
+
+/* Same sequence as infrared worker: check by timeout before the edge that ends it */
+static uint64_t infrared_decoder_bench_replay(
+    InfraredDecoderHandler* handler,
+    InfraredDecoderBenchAll* all,
+    const InfraredDecoderBenchSignal* signal,
+    FuriString* output) {
+    const InfraredMessage* message = NULL;
+    bool level = false;
+
+    uint64_t start = infrared_decoder_bench_time_ns();
+    if(handler) {
+        infrared_reset_decoder(handler);
+    } else {
+        infrared_decoder_bench_all_reset(all);
+    }
+
+    for(size_t i = 0; i < signal->count; i++) {
+        if(signal->timings[i] > INFRARED_RAW_RX_TIMING_DELAY_US) {
+            message = handler ? infrared_check_decoder_ready(handler) :
+                                infrared_decoder_bench_all_check_ready(all);
+            infrared_decoder_bench_print_message(output, message);
+        }
+        message = handler ? infrared_decode(handler, level, signal->timings[i]) :
+                            infrared_decoder_bench_all_decode(all, level, signal->timings[i]);
+        infrared_decoder_bench_print_message(output, message);
+        level = !level;
+    }
+
+    message = handler ? infrared_check_decoder_ready(handler) :
+                        infrared_decoder_bench_all_check_ready(all);
+    infrared_decoder_bench_print_message(output, message);
+
+    return infrared_decoder_bench_time_ns() - start;
+}
+
+static bool infrared_decoder_bench_load(
+    const char* path,
+    InfraredDecoderBenchSignal** signals,
+    size_t* signals_count) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FlipperFormat* flipper_format = flipper_format_file_alloc(storage);
+    FuriString* storage_path = furi_string_alloc_printf(STORAGE_EXT_PATH_PREFIX "%s", path);
+    FuriString* temp_str = furi_string_alloc();
+    bool success = false;
+
+    *signals = NULL;
+    *signals_count = 0;
+
+    do {
+        uint32_t version = 0;
+        if(!flipper_format_file_open_existing(flipper_format, furi_string_get_cstr(storage_path)))
+            break;
+        if(!flipper_format_read_header(flipper_format, temp_str, &version)) break;
+
+        while(flipper_format_read_string(flipper_format, "name", temp_str)) {
+            if(!furi_string_start_with_str(temp_str, INFRARED_DECODER_BENCH_SIGNAL_PREFIX)) {
+                continue;
+            }
+            if(!flipper_format_read_string(flipper_format, "type", temp_str)) break;
+            if(furi_string_cmp_str(temp_str, "raw")) continue;
+
+            uint32_t count = 0;
+            if(!flipper_format_get_value_count(flipper_format, "data", &count) || !count) break;
+
+            uint32_t* timings = malloc(count * sizeof(uint32_t));
+            if(!flipper_format_read_uint32(flipper_format, "data", timings, count)) {
+                free(timings);
+                break;
+            }
+
+            *signals =
+                realloc(*signals, (*signals_count + 1) * sizeof(InfraredDecoderBenchSignal));
+            (*signals)[*signals_count].timings = timings;
+            (*signals)[*signals_count].count = count;
+            (*signals_count)++;
+        }
+        success = (*signals_count > 0);
+    } while(false);
+
+    furi_string_free(temp_str);
+    furi_string_free(storage_path);
+    flipper_format_free(flipper_format);
+    furi_record_close(RECORD_STORAGE);
+    return success;
+}
+
+static bool infrared_decoder_bench_run(
+    InfraredDecoderHandler* handler,
+    InfraredDecoderBenchAll* all,
+    InfraredDecoderBenchStats* stats,
+    const char* path,
+    uint32_t rounds) {
+    InfraredDecoderBenchSignal* signals = NULL;
+    size_t signals_count = 0;
+    if(!infrared_decoder_bench_load(path, &signals, &signals_count)) return false;
+
+    FuriString* all_output = furi_string_alloc();
+    FuriString* active_output = furi_string_alloc();
+    bool success = true;
+
+    for(size_t i = 0; i < signals_count; i++) {
+        furi_string_reset(all_output);
+        furi_string_reset(active_output);
+        infrared_decoder_bench_replay(NULL, all, &signals[i], all_output);
+        infrared_decoder_bench_replay(handler, NULL, &signals[i], active_output);
+
+        if(!furi_string_equal(all_output, active_output)) {
+            printf(
+                "FAIL %s: signal %zu decodes differ\nall decoders:\n%sactive set:\n%s",
+                path,
+                i,
+                furi_string_get_cstr(all_output),
+                furi_string_get_cstr(active_output));
+            success = false;
+        }
+        for(const char* line = furi_string_get_cstr(all_output); *line; line++) {
+            if(*line == '\n') stats->messages++;
+        }
+
+        // Alternate runs so that both dispatchers see the same cache state
+        for(uint32_t round = 0; round < rounds; round++) {
+            stats->all_ns += infrared_decoder_bench_replay(NULL, all, &signals[i], NULL);
+            stats->active_ns += infrared_decoder_bench_replay(handler, NULL, &signals[i], NULL);
+        }
+        stats->edges += (uint64_t)signals[i].count * rounds;
+        free(signals[i].timings);
+    }
+
+    free(signals);
+    furi_string_free(active_output);
+    furi_string_free(all_output);
+    return success;
+}
+
+static double infrared_decoder_bench_rate(uint64_t edges, uint64_t ns) {
+    return ns ? edges * 1000000000.0 / ns : 0.0;
+}
+
+static void infrared_decoder_bench_usage(const char* name) {
+    printf("Usage: %s [-r rounds] file.irtest...\n", name);
+}
+
+int main(int argc, char** argv) {
+    uint32_t rounds = INFRARED_DECODER_BENCH_ROUNDS;
+
+    int option;
+    while((option = getopt(argc, argv, "r:h")) != -1) {
+        switch(option) {
+        case 'r':
+            rounds = strtoul(optarg, NULL, 10);
+            break;
+        default:
+            infrared_decoder_bench_usage(argv[0]);
+            return 2;
+        }
+    }
+
+    if(optind == argc || !rounds) {
+        infrared_decoder_bench_usage(argv[0]);
+        return 2;
+    }
+
+    furi_init();
+    // Storage root is the file system root, host paths are opened under /ext
+    storage_host_record_create("/");
+
+    InfraredDecoderHandler* handler = infrared_alloc_decoder();
+    InfraredDecoderBenchAll all;
+    for(size_t i = 0; i < INFRARED_DECODER_BENCH_DECODERS_COUNT; i++) {
+        all.ctx[i] = infrared_decoder_bench_decoders[i].alloc();
+    }
+
+    InfraredDecoderBenchStats total = {0};
+    size_t failures = 0;
+
+    for(int i = optind; i < argc; i++) {
+        char* path = realpath(argv[i], NULL);
+        if(!path) {
+            printf("FAIL %s: %s\n", argv[i], strerror(errno));
+            failures++;
+            continue;
+        }
+
+        InfraredDecoderBenchStats stats = {0};
+        if(!infrared_decoder_bench_run(handler, &all, &stats, path, rounds)) {
+            printf("FAIL %s: can't load signals or decodes differ\n", argv[i]);
+            failures++;
+        } else {
+            printf(
+                "%s: %lu decodes, %.0f edges/s all decoders, %.0f edges/s active set\n",
+                argv[i],
+                (unsigned long)stats.messages,
+                infrared_decoder_bench_rate(stats.edges, stats.all_ns),
+                infrared_decoder_bench_rate(stats.edges, stats.active_ns));
+        }
+
+        total.edges += stats.edges;
+        total.all_ns += stats.all_ns;
+        total.active_ns += stats.active_ns;
+        total.messages += stats.messages;
+        free(path);
+    }
+
+    double all_rate = infrared_decoder_bench_rate(total.edges, total.all_ns);
+    double active_rate = infrared_decoder_bench_rate(total.edges, total.active_ns);
+    printf("Decodes: %lu\n", (unsigned long)total.messages);
+    printf("all decoders %12.0f edges/s\n", all_rate);
+    printf(
+        "active set   %12.0f edges/s, x%.2f\n",
+        active_rate,
+        all_rate ? active_rate / all_rate : 0.0);
+
+    for(size_t i = 0; i < INFRARED_DECODER_BENCH_DECODERS_COUNT; i++) {
+        infrared_decoder_bench_decoders[i].free(all.ctx[i]);
+    }
+    infrared_free_decoder(handler);
+
+    if(failures) printf("%zu failures\n", failures);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,286 @@
+#include <furi.h>
+#include <flipper_format/flipper_format_i.h>
+#include <storage/storage.h>
+#include <storage_host.h>
+
+#include <infrared_remote.h>
+#include <infrared_signal.h>
+#include <infrared_transmit.h>
+
+#include <errno.h>
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define TAG "InfraredRemoteBench"
+
+#define INFRARED_REMOTE_BENCH_ROUNDS (10U)
+#define INFRARED_REMOTE_BENCH_REMOTE_HEADER "Filetype: IR signals file"
+#define INFRARED_REMOTE_BENCH_LIBRARY_HEADER "Filetype: IR library file"
+#define INFRARED_REMOTE_BENCH_TEMP_PATH "/tmp/infrared_remote_benchXXXXXX"
+
+typedef struct {
+    uint64_t count;
+    uint64_t total_ns;
+    uint64_t max_ns;
+} InfraredRemoteBenchTime;
+
+typedef struct {
+    InfraredRemoteBenchTime load;
+    InfraredRemoteBenchTime indexed;
+    InfraredRemoteBenchTime scan;
+    size_t signals;
+} InfraredRemoteBenchStats;
+
+// Signals are only loaded, never sent
+void infrared_send(const InfraredMessage* message, int times) {
+    UNUSED(message);
+    UNUSED(times);
+}
+
+void infrared_send_raw_ext(
+    const uint32_t timings[],
+    uint32_t timings_cnt,
+    bool start_from_mark,
+    uint32_t frequency,
+    float duty_cycle) {
+    UNUSED(timings);
+    UNUSED(timings_cnt);
+    UNUSED(start_from_mark);
+    UNUSED(frequency);
+    UNUSED(duty_cycle);
+}
+
+static uint64_t infrared_remote_bench_time_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static void infrared_remote_bench_time_add(InfraredRemoteBenchTime* time, uint64_t start) {
+    uint64_t elapsed = infrared_remote_bench_time_ns() - start;
+    time->count++;
+    time->total_ns += elapsed;
+    time->max_ns = MAX(time->max_ns, elapsed);
+}
+
+static void infrared_remote_bench_time_merge(
+    InfraredRemoteBenchTime* total,
+    InfraredRemoteBenchTime* time) {
+    total->count += time->count;
+    total->total_ns += time->total_ns;
+    total->max_ns = MAX(total->max_ns, time->max_ns);
+}
+
+static void infrared_remote_bench_time_print(const char* name, InfraredRemoteBenchTime* time) {
+    printf(
+        "%-8s %9llu calls, avg %9.3f us, max %9.3f us\n",
+        name,
+        (unsigned long long)time->count,
+        time->count ? time->total_ns / 1000.0 / time->count : 0.0,
+        time->max_ns / 1000.0);
+}
+
+// Library files differ from remotes only by the file type, load a copy with remote header
+static bool infrared_remote_bench_copy(const char* path, char* copy_path) {
+    FILE* in = fopen(path, "rb");
+    if(!in) return false;
+
+    int fd = mkstemp(copy_path);
+    FILE* out = (fd >= 0) ? fdopen(fd, "wb") : NULL;
+    bool success = false;
+
+    if(out) {
+        char line[256];
+        if(fgets(line, sizeof(line), in)) {
+            if(strncmp(
+                   line,
+                   INFRARED_REMOTE_BENCH_LIBRARY_HEADER,
+                   strlen(INFRARED_REMOTE_BENCH_LIBRARY_HEADER)) == 0) {
+                fprintf(out, "%s\n", INFRARED_REMOTE_BENCH_REMOTE_HEADER);
+            } else {
+                fputs(line, out);
+            }
+
+            size_t size;
+            while((size = fread(line, 1, sizeof(line), in)) > 0) {
+                fwrite(line, 1, size, out);
+            }
+            success = !ferror(in);
+        }
+        success = (fclose(out) == 0) && success;
+    } else if(fd >= 0) {
+        close(fd);
+    }
+
+    fclose(in);
+    return success;
+}
+
+// Serialize signal to compare what both ways of loading return
+static void infrared_remote_bench_serialize(
+    FlipperFormat* ff,
+    const InfraredSignal* signal,
+    const char* name,
+    FuriString* output) {
+    Stream* stream = flipper_format_get_raw_stream(ff);
+    stream_clean(stream);
+    infrared_signal_save(signal, ff, name);
+    stream_rewind(stream);
+
+    furi_string_reset(output);
+    char buffer[64];
+    size_t size = 0;
+    while((size = stream_read(stream, (uint8_t*)buffer, sizeof(buffer))) > 0) {
+        furi_string_cat_printf(output, "%.*s", (int)size, buffer);
+    }
+}
+
+// Legacy way: open the file and read signals one by one until the index
+static bool infrared_remote_bench_scan_signal(
+    const char* path,
+    InfraredSignal* signal,
+    size_t index,
+    InfraredRemoteBenchTime* time) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FlipperFormat* ff = flipper_format_buffered_file_alloc(storage);
+
+    uint64_t start = infrared_remote_bench_time_ns();
+    bool success = flipper_format_buffered_file_open_existing(ff, path) &&
+                   infrared_signal_search_by_index_and_read(signal, ff, index);
+    infrared_remote_bench_time_add(time, start);
+
+    flipper_format_free(ff);
+    furi_record_close(RECORD_STORAGE);
+    return success;
+}
+
+static bool infrared_remote_bench_run(
+    InfraredRemoteBenchStats* stats,
+    const char* path,
+    uint32_t rounds) {
+    InfraredRemote* remote = infrared_remote_alloc();
+    InfraredSignal* indexed = infrared_signal_alloc();
+    InfraredSignal* scanned = infrared_signal_alloc();
+    FlipperFormat* ff = flipper_format_string_alloc();
+    FuriString* indexed_str = furi_string_alloc();
+    FuriString* scanned_str = furi_string_alloc();
+    bool success = true;
+
+    for(uint32_t round = 0; round < rounds; round++) {
+        uint64_t start = infrared_remote_bench_time_ns();
+        success = infrared_remote_load(remote, path);
+        infrared_remote_bench_time_add(&stats->load, start);
+        if(!success) break;
+    }
+
+    stats->signals = success ? infrared_remote_get_signal_count(remote) : 0;
+
+    for(size_t i = 0; success && i < stats->signals; i++) {
+        const char* name = infrared_remote_get_signal_name(remote, i);
+
+        for(uint32_t round = 0; round < rounds; round++) {
+            uint64_t start = infrared_remote_bench_time_ns();
+            success = infrared_remote_load_signal(remote, indexed, i);
+            infrared_remote_bench_time_add(&stats->indexed, start);
+            if(!success) break;
+
+            success = infrared_remote_bench_scan_signal(path, scanned, i, &stats->scan);
+            if(!success) break;
+        }
+        if(!success) {
+            printf("FAIL %s: can't load signal %zu '%s'\n", path, i, name);
+            break;
+        }
+
+        infrared_remote_bench_serialize(ff, indexed, name, indexed_str);
+        infrared_remote_bench_serialize(ff, scanned, name, scanned_str);
+        if(!furi_string_equal(indexed_str, scanned_str)) {
+            printf("FAIL %s: signal %zu '%s' differs\n", path, i, name);
+            success = false;
+        }
+    }
+
+    furi_string_free(scanned_str);
+    furi_string_free(indexed_str);
+    flipper_format_free(ff);
+    infrared_signal_free(scanned);
+    infrared_signal_free(indexed);
+    infrared_remote_free(remote);
+    return success;
+}
+
+static void infrared_remote_bench_usage(const char* name) {
+    printf("Usage: %s [-r rounds] file.ir...\n", name);
+}
+
+int main(int argc, char** argv) {
+    uint32_t rounds = INFRARED_REMOTE_BENCH_ROUNDS;
+
+    int option;
+    while((option = getopt(argc, argv, "r:h")) != -1) {
+        switch(option) {
+        case 'r':
+            rounds = strtoul(optarg, NULL, 10);
+            break;
+        default:
+            infrared_remote_bench_usage(argv[0]);
+            return 2;
+        }
+    }
+
+    if(optind == argc || !rounds) {
+        infrared_remote_bench_usage(argv[0]);
+        return 2;
+    }
+
+    furi_init();
+    // Storage root is the file system root, host paths are opened under /ext
+    storage_host_record_create("/");
+
+    InfraredRemoteBenchStats total = {0};
+    size_t failures = 0;
+
+    for(int i = optind; i < argc; i++) {
+        char copy_path[] = INFRARED_REMOTE_BENCH_TEMP_PATH;
+        if(!infrared_remote_bench_copy(argv[i], copy_path)) {
+            printf("FAIL %s: %s\n", argv[i], strerror(errno));
+            failures++;
+            continue;
+        }
+
+        FuriString* storage_path =
+            furi_string_alloc_printf(STORAGE_EXT_PATH_PREFIX "%s", copy_path);
+        InfraredRemoteBenchStats stats = {0};
+        if(!infrared_remote_bench_run(&stats, furi_string_get_cstr(storage_path), rounds)) {
+            printf("FAIL %s: can't load remote or signals differ\n", argv[i]);
+            failures++;
+        } else {
+            printf(
+                "%s: %zu signals, load %.3f us, signal avg %.3f us indexed, %.3f us scan\n",
+                argv[i],
+                stats.signals,
+                stats.load.total_ns / 1000.0 / stats.load.count,
+                stats.indexed.count ? stats.indexed.total_ns / 1000.0 / stats.indexed.count : 0.0,
+                stats.scan.count ? stats.scan.total_ns / 1000.0 / stats.scan.count : 0.0);
+        }
+
+        total.signals += stats.signals;
+        infrared_remote_bench_time_merge(&total.load, &stats.load);
+        infrared_remote_bench_time_merge(&total.indexed, &stats.indexed);
+        infrared_remote_bench_time_merge(&total.scan, &stats.scan);
+        furi_string_free(storage_path);
+        unlink(copy_path);
+    }
+
+    printf("Signals: %zu\n", total.signals);
+    infrared_remote_bench_time_print("load", &total.load);
+    infrared_remote_bench_time_print("indexed", &total.indexed);
+    infrared_remote_bench_time_print("scan", &total.scan);
+
+    if(failures) printf("%zu failures\n", failures);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,235 @@
+#include <furi.h>
+#include <signal_reader/parsers/iso15693/iso15693_decoder.h>
+
+#include <getopt.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define ISO15693_DECODER_BENCH_ROUNDS (100U)
+#define ISO15693_DECODER_BENCH_FRAMES (64U)
+#define ISO15693_DECODER_BENCH_FRAME_SIZE_MAX (64U)
+/* iso15693_parser.c feeds a half of its 2 byte signal reader buffer per call */
+#define ISO15693_DECODER_BENCH_CHUNK_SIZE (1U)
+/* One sample per 603 cycles at 64 MHz, 2 per pulse slot, as iso15693_parser.c sets */
+#define ISO15693_DECODER_BENCH_SAMPLE_RATE (64000000U / 603U)
+#define ISO15693_DECODER_BENCH_1_OUT_OF_256_SYMBOL_SIZE (64U)
+#define ISO15693_DECODER_BENCH_SAMPLES_SIZE_MAX \
+    (ISO15693_DECODER_BENCH_FRAME_SIZE_MAX * ISO15693_DECODER_BENCH_1_OUT_OF_256_SYMBOL_SIZE + 2)
+
+typedef enum {
+    Iso15693DecoderBenchCoding1OutOf4,
+    Iso15693DecoderBenchCoding1OutOf256,
+    Iso15693DecoderBenchCodingCount,
+} Iso15693DecoderBenchCoding;
+
+typedef struct {
+    uint8_t data[ISO15693_DECODER_BENCH_FRAME_SIZE_MAX];
+    size_t data_size;
+    uint8_t* samples;
+    size_t samples_size;
+} Iso15693DecoderBenchFrame;
+
+typedef struct {
+    uint64_t samples;
+    uint64_t bytes;
+    uint64_t total_ns;
+} Iso15693DecoderBenchStats;
+
+static const char* iso15693_decoder_bench_coding_names[Iso15693DecoderBenchCodingCount] = {
+    [Iso15693DecoderBenchCoding1OutOf4] = "1 out of 4",
+    [Iso15693DecoderBenchCoding1OutOf256] = "1 out of 256",
+};
+
+static uint32_t iso15693_decoder_bench_seed = 0x15693EEDU;
+
+static uint32_t iso15693_decoder_bench_random(void) {
+    // xorshift32
+    iso15693_decoder_bench_seed ^= iso15693_decoder_bench_seed << 13;
+    iso15693_decoder_bench_seed ^= iso15693_decoder_bench_seed >> 17;
+    iso15693_decoder_bench_seed ^= iso15693_decoder_bench_seed << 5;
+    return iso15693_decoder_bench_seed;
+}
+
+static uint64_t iso15693_decoder_bench_time_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/* Same encoding as the unit test: one sample byte per 1 out of 4 symbol, SOF and EOF bytes */
+static size_t iso15693_decoder_bench_encode(
+    Iso15693DecoderBenchCoding coding,
+    const uint8_t* data,
+    size_t data_size,
+    uint8_t* samples) {
+    size_t size = 0;
+
+    if(coding == Iso15693DecoderBenchCoding1OutOf4) {
+        samples[size++] = 0x21;
+        for(size_t i = 0; i < data_size; i++) {
+            for(size_t j = 0; j < 4; j++) {
+                const uint8_t slot = (data[i] >> (j * 2)) & 0x03;
+                samples[size++] = 1 << (slot * 2 + 1);
+            }
+        }
+    } else {
+        samples[size++] = 0x81;
+        for(size_t i = 0; i < data_size; i++) {
+            memset(&samples[size], 0, ISO15693_DECODER_BENCH_1_OUT_OF_256_SYMBOL_SIZE);
+            samples[size + data[i] / 4] = 1 << ((data[i] % 4) * 2 + 1);
+            size += ISO15693_DECODER_BENCH_1_OUT_OF_256_SYMBOL_SIZE;
+        }
+    }
+    samples[size++] = 0x04;
+
+    return size;
+}
+
+static Iso15693DecoderStatus iso15693_decoder_bench_feed(
+    Iso15693Decoder* decoder,
+    const Iso15693DecoderBenchFrame* frame,
+    size_t chunk_size) {
+    Iso15693DecoderStatus status = Iso15693DecoderStatusWait;
+
+    iso15693_decoder_reset(decoder);
+    for(size_t i = 0; (i < frame->samples_size) && (status == Iso15693DecoderStatusWait);
+        i += chunk_size) {
+        status = iso15693_decoder_feed(
+            decoder, &frame->samples[i], MIN(chunk_size, frame->samples_size - i));
+    }
+
+    return status;
+}
+
+static bool iso15693_decoder_bench_check(
+    Iso15693Decoder* decoder,
+    const Iso15693DecoderBenchFrame* frame,
+    size_t chunk_size) {
+    if(iso15693_decoder_bench_feed(decoder, frame, chunk_size) != Iso15693DecoderStatusFrame) {
+        return false;
+    }
+
+    const BitBuffer* decoded = iso15693_decoder_get_frame(decoder);
+    return (bit_buffer_get_size_bytes(decoded) == frame->data_size) &&
+           (memcmp(bit_buffer_get_data(decoded), frame->data, frame->data_size) == 0);
+}
+
+static void iso15693_decoder_bench_print(
+    const char* name,
+    const Iso15693DecoderBenchStats* stats,
+    size_t frames) {
+    double samples = stats->samples ? stats->samples : 1;
+    double rate = stats->total_ns ? samples * 1e9 / stats->total_ns : 0;
+
+    printf(
+        "%s: %zu frames, %llu bytes, %llu samples, %.2f ns/sample, %.1f Msamples/s, "
+        "%.2f%% of signal time\n",
+        name,
+        frames,
+        (unsigned long long)stats->bytes,
+        (unsigned long long)stats->samples,
+        stats->total_ns / samples,
+        rate / 1e6,
+        rate ? ISO15693_DECODER_BENCH_SAMPLE_RATE * 100.0 / rate : 0);
+}
+
+static void iso15693_decoder_bench_usage(const char* name) {
+    printf("Usage: %s [-r rounds] [-n frames] [-c chunk_size]\n", name);
+}
+
+int main(int argc, char** argv) {
+    uint32_t rounds = ISO15693_DECODER_BENCH_ROUNDS;
+    size_t frame_count = ISO15693_DECODER_BENCH_FRAMES;
+    size_t chunk_size = ISO15693_DECODER_BENCH_CHUNK_SIZE;
+
+    int option;
+    while((option = getopt(argc, argv, "r:n:c:h")) != -1) {
+        switch(option) {
+        case 'r':
+            rounds = strtoul(optarg, NULL, 10);
+            break;
+        case 'n':
+            frame_count = strtoul(optarg, NULL, 10);
+            break;
+        case 'c':
+            chunk_size = strtoul(optarg, NULL, 10);
+            break;
+        default:
+            iso15693_decoder_bench_usage(argv[0]);
+            return 2;
+        }
+    }
+
+    if(optind != argc || !rounds || !frame_count || !chunk_size) {
+        iso15693_decoder_bench_usage(argv[0]);
+        return 2;
+    }
+
+    furi_init();
+
+    Iso15693Decoder* decoder = iso15693_decoder_alloc(ISO15693_DECODER_BENCH_FRAME_SIZE_MAX);
+    Iso15693DecoderBenchFrame* frames = malloc(frame_count * sizeof(Iso15693DecoderBenchFrame));
+    size_t failures = 0;
+
+    for(size_t coding = 0; coding < Iso15693DecoderBenchCodingCount; coding++) {
+        Iso15693DecoderBenchStats stats = {};
+
+        // Frames of every size up to the decoder buffer, random data
+        for(size_t i = 0; i < frame_count; i++) {
+            Iso15693DecoderBenchFrame* frame = &frames[i];
+            frame->data_size = 1 + i % ISO15693_DECODER_BENCH_FRAME_SIZE_MAX;
+            for(size_t j = 0; j < frame->data_size; j++) {
+                frame->data[j] = iso15693_decoder_bench_random();
+            }
+            frame->samples = malloc(ISO15693_DECODER_BENCH_SAMPLES_SIZE_MAX);
+            frame->samples_size = iso15693_decoder_bench_encode(
+                coding, frame->data, frame->data_size, frame->samples);
+
+            if(!iso15693_decoder_bench_check(decoder, frame, chunk_size)) {
+                printf(
+                    "FAIL %s: frame %zu of %zu bytes decoded wrong\n",
+                    iso15693_decoder_bench_coding_names[coding],
+                    i,
+                    frame->data_size);
+                failures++;
+            }
+            stats.samples += frame->samples_size * 8;
+            stats.bytes += frame->data_size;
+        }
+
+        const uint64_t start = iso15693_decoder_bench_time_ns();
+        for(uint32_t round = 0; round < rounds; round++) {
+            for(size_t i = 0; i < frame_count; i++) {
+                iso15693_decoder_bench_feed(decoder, &frames[i], chunk_size);
+            }
+        }
+        stats.total_ns = (iso15693_decoder_bench_time_ns() - start) / rounds;
+
+        iso15693_decoder_bench_print(
+            iso15693_decoder_bench_coding_names[coding], &stats, frame_count);
+
+        for(size_t i = 0; i < frame_count; i++) {
+            free(frames[i].samples);
+        }
+    }
+
+    Iso15693DecoderStats decoder_stats;
+    iso15693_decoder_get_stats(decoder, &decoder_stats);
+    if(decoder_stats.sof_errors || decoder_stats.symbol_errors || decoder_stats.overflows) {
+        printf(
+            "FAIL decoder errors: %" PRIu32 " SOF, %" PRIu32 " symbol, %" PRIu32 " overflow\n",
+            decoder_stats.sof_errors,
+            decoder_stats.symbol_errors,
+            decoder_stats.overflows);
+        failures++;
+    }
+
+    free(frames);
+    iso15693_decoder_free(decoder);
+
+    if(failures) printf("%zu failures\n", failures);
+    return failures ? 1 : 0;
+}
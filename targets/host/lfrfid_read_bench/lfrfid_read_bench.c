@@ -0,0 +1,373 @@
+#include <furi.h>
+#include <storage/storage.h>
+#include <storage_host.h>
+#include <toolbox/protocols/protocol_dict.h>
+#include <lfrfid/protocols/lfrfid_protocols.h>
+#include <lfrfid/lfrfid_read_decoder.h>
+#include <lfrfid/tools/varint_pair.h>
+
+#include <errno.h>
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TAG "LfRfidReadBench"
+
+/* Same as lfrfid worker and raw file */
+#define LFRFID_READ_BENCH_STABILIZE_TIME_US (450U * 1000U)
+#define LFRFID_READ_BENCH_SWITCH_TIME_US (2000U * 1000U)
+#define LFRFID_READ_BENCH_DROP_TIME_US (50U * 1000U)
+#define LFRFID_READ_BENCH_RAW_MAGIC 0x4C464952
+#define LFRFID_READ_BENCH_RAW_VERSION 1
+
+#define LFRFID_READ_BENCH_LIMIT_MS (20000U)
+#define LFRFID_READ_BENCH_ASK_EXTENSION ".ask.raw"
+#define LFRFID_READ_BENCH_PSK_EXTENSION ".psk.raw"
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    float frequency;
+    float duty_cycle;
+    uint32_t max_buffer_size;
+} LFRFIDReadBenchRawHeader;
+
+typedef struct {
+    uint32_t* pulse;
+    uint32_t* duration;
+    size_t count;
+    size_t position;
+} LFRFIDReadBenchCapture;
+
+typedef enum {
+    LFRFIDReadBenchModeAlternate,
+    LFRFIDReadBenchModeConcurrent,
+    LFRFIDReadBenchModeCount,
+} LFRFIDReadBenchMode;
+
+typedef struct {
+    ProtocolId protocol;
+    uint8_t data[32];
+    uint64_t time_us;
+    uint8_t confidence[LFRFIDReadDecoderFamilyCount];
+} LFRFIDReadBenchResult;
+
+typedef struct {
+    size_t reads[LFRFIDReadBenchModeCount];
+    uint64_t time_us[LFRFIDReadBenchModeCount];
+} LFRFIDReadBenchStats;
+
+static const char* lfrfid_read_bench_mode_names[LFRFIDReadBenchModeCount] = {
+    [LFRFIDReadBenchModeAlternate] = "alternate",
+    [LFRFIDReadBenchModeConcurrent] = "concurrent",
+};
+
+/* Raw files are written on device with 32 bit size_t, parse them without lfrfid_raw_file */
+static bool lfrfid_read_bench_capture_load(LFRFIDReadBenchCapture* capture, const char* path) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* file = storage_file_alloc(storage);
+    FuriString* storage_path = furi_string_alloc_printf(STORAGE_EXT_PATH_PREFIX "%s", path);
+    bool success = false;
+    uint8_t* buffer = NULL;
+
+    memset(capture, 0, sizeof(LFRFIDReadBenchCapture));
+
+    do {
+        const char* file_path = furi_string_get_cstr(storage_path);
+        if(!storage_file_open(file, file_path, FSAM_READ, FSOM_OPEN_EXISTING)) break;
+
+        LFRFIDReadBenchRawHeader header;
+        if(storage_file_read(file, &header, sizeof(header)) != sizeof(header)) break;
+        if(header.magic != LFRFID_READ_BENCH_RAW_MAGIC ||
+           header.version != LFRFID_READ_BENCH_RAW_VERSION) {
+            break;
+        }
+
+        buffer = malloc(header.max_buffer_size);
+        size_t capacity = 0;
+
+        success = true;
+        while(success && !storage_file_eof(file)) {
+            uint32_t size = 0;
+            if(storage_file_read(file, &size, sizeof(size)) != sizeof(size)) break;
+            if(size > header.max_buffer_size ||
+               storage_file_read(file, buffer, size) != size) {
+                success = false;
+                break;
+            }
+
+            size_t index = 0;
+            while(index < size) {
+                uint32_t pulse, duration;
+                size_t pair_size;
+                if(!varint_pair_unpack(
+                       &buffer[index], size - index, &pulse, &duration, &pair_size)) {
+                    success = false;
+                    break;
+                }
+                index += pair_size;
+
+                if(capture->count == capacity) {
+                    capacity = MAX(capacity * 2, 1024U);
+                    capture->pulse = realloc(capture->pulse, capacity * sizeof(uint32_t));
+                    capture->duration = realloc(capture->duration, capacity * sizeof(uint32_t));
+                }
+                capture->pulse[capture->count] = pulse;
+                capture->duration[capture->count] = duration;
+                capture->count++;
+            }
+        }
+    } while(false);
+
+    free(buffer);
+    storage_file_free(file);
+    furi_string_free(storage_path);
+    furi_record_close(RECORD_STORAGE);
+    return success;
+}
+
+static void lfrfid_read_bench_capture_free(LFRFIDReadBenchCapture* capture) {
+    free(capture->pulse);
+    free(capture->duration);
+}
+
+/* One read window of lfrfid worker, capture replays in a loop from where the last window ended */
+static bool lfrfid_read_bench_window(
+    ProtocolDict* dict,
+    LFRFIDReadBenchCapture* capture,
+    LFRFIDFeature features,
+    LFRFIDReadBenchResult* result) {
+    LFRFIDReadDecoder* decoder = lfrfid_read_decoder_alloc(dict, features);
+    bool settled = false;
+
+    // switch timer starts when detector is stable
+    result->time_us += LFRFID_READ_BENCH_STABILIZE_TIME_US;
+    uint64_t last_decode_us = result->time_us;
+
+    if(!capture->count) {
+        // tag is silent on this carrier
+        result->time_us += LFRFID_READ_BENCH_SWITCH_TIME_US;
+    }
+
+    while(capture->count && result->time_us - last_decode_us <= LFRFID_READ_BENCH_SWITCH_TIME_US) {
+        uint32_t pulse = capture->pulse[capture->position];
+        uint32_t duration = capture->duration[capture->position];
+        capture->position = (capture->position + 1) % capture->count;
+        result->time_us += duration;
+
+        ProtocolId protocol;
+        LFRFIDReadDecoderEvent event =
+            lfrfid_read_decoder_feed(decoder, pulse, duration, &protocol);
+        if(event == LFRFIDReadDecoderEventDecoded) {
+            last_decode_us = result->time_us;
+        } else if(event == LFRFIDReadDecoderEventSettled) {
+            result->protocol = protocol;
+            size_t size = MIN(protocol_dict_get_data_size(dict, protocol), sizeof(result->data));
+            protocol_dict_get_data(dict, protocol, result->data, size);
+            for(size_t i = 0; i < LFRFIDReadDecoderFamilyCount; i++) {
+                result->confidence[i] = lfrfid_read_decoder_get_confidence(decoder, i);
+            }
+            settled = true;
+            break;
+        }
+    }
+
+    lfrfid_read_decoder_free(decoder);
+    return settled;
+}
+
+/* Same schedule as lfrfid worker auto read: ASK carrier first, switch after a quiet window */
+static void lfrfid_read_bench_replay(
+    ProtocolDict* dict,
+    LFRFIDReadBenchCapture* captures,
+    LFRFIDReadBenchMode mode,
+    uint32_t limit_ms,
+    LFRFIDReadBenchResult* result) {
+    memset(result, 0, sizeof(LFRFIDReadBenchResult));
+    result->protocol = PROTOCOL_NO;
+
+    for(size_t i = 0; i < LFRFIDReadDecoderFamilyCount; i++) {
+        captures[i].position = 0;
+    }
+
+    LFRFIDReadDecoderFamily carrier = LFRFIDReadDecoderFamilyASK;
+    while(result->time_us < (uint64_t)limit_ms * 1000U) {
+        LFRFIDFeature features;
+        if(mode == LFRFIDReadBenchModeConcurrent) {
+            features = LFRFIDFeatureASK | LFRFIDFeaturePSK;
+        } else {
+            features = (carrier == LFRFIDReadDecoderFamilyASK) ? LFRFIDFeatureASK :
+                                                                 LFRFIDFeaturePSK;
+        }
+
+        if(lfrfid_read_bench_window(dict, &captures[carrier], features, result)) break;
+
+        carrier = (carrier == LFRFIDReadDecoderFamilyASK) ? LFRFIDReadDecoderFamilyPSK :
+                                                            LFRFIDReadDecoderFamilyASK;
+        result->time_us += LFRFID_READ_BENCH_DROP_TIME_US;
+    }
+}
+
+static void lfrfid_read_bench_print_result(
+    ProtocolDict* dict,
+    LFRFIDReadBenchMode mode,
+    const LFRFIDReadBenchResult* result) {
+    printf("  %-10s ", lfrfid_read_bench_mode_names[mode]);
+    if(result->protocol == PROTOCOL_NO) {
+        printf("no read\n");
+        return;
+    }
+
+    printf(
+        "%8.1f ms %s [",
+        result->time_us / 1000.0,
+        protocol_dict_get_name(dict, result->protocol));
+    size_t size = MIN(protocol_dict_get_data_size(dict, result->protocol), sizeof(result->data));
+    for(size_t i = 0; i < size; i++) {
+        printf(i ? " %02X" : "%02X", result->data[i]);
+    }
+    printf(
+        "], ASK %u%%, PSK %u%%\n",
+        result->confidence[LFRFIDReadDecoderFamilyASK],
+        result->confidence[LFRFIDReadDecoderFamilyPSK]);
+}
+
+static bool lfrfid_read_bench_run(
+    ProtocolDict* dict,
+    LFRFIDReadBenchStats* stats,
+    const char* base,
+    uint32_t limit_ms) {
+    static const char* extensions[LFRFIDReadDecoderFamilyCount] = {
+        [LFRFIDReadDecoderFamilyASK] = LFRFID_READ_BENCH_ASK_EXTENSION,
+        [LFRFIDReadDecoderFamilyPSK] = LFRFID_READ_BENCH_PSK_EXTENSION,
+    };
+
+    LFRFIDReadBenchCapture captures[LFRFIDReadDecoderFamilyCount];
+    FuriString* path = furi_string_alloc();
+    size_t loaded = 0;
+
+    // missing capture means tag is silent on that carrier
+    for(size_t i = 0; i < LFRFIDReadDecoderFamilyCount; i++) {
+        furi_string_printf(path, "%s%s", base, extensions[i]);
+        if(lfrfid_read_bench_capture_load(&captures[i], furi_string_get_cstr(path))) {
+            loaded++;
+        } else if(captures[i].count) {
+            printf("FAIL %s: broken capture\n", furi_string_get_cstr(path));
+            lfrfid_read_bench_capture_free(&captures[i]);
+            memset(&captures[i], 0, sizeof(LFRFIDReadBenchCapture));
+        }
+    }
+    furi_string_free(path);
+
+    bool success = (loaded > 0);
+    if(success) {
+        printf("%s:\n", base);
+
+        LFRFIDReadBenchResult results[LFRFIDReadBenchModeCount];
+        for(size_t mode = 0; mode < LFRFIDReadBenchModeCount; mode++) {
+            lfrfid_read_bench_replay(dict, captures, mode, limit_ms, &results[mode]);
+            lfrfid_read_bench_print_result(dict, mode, &results[mode]);
+
+            if(results[mode].protocol != PROTOCOL_NO) {
+                stats->reads[mode]++;
+                stats->time_us[mode] += results[mode].time_us;
+            }
+        }
+
+        // concurrent decoding must not read a different tag
+        LFRFIDReadBenchResult* alternate = &results[LFRFIDReadBenchModeAlternate];
+        LFRFIDReadBenchResult* concurrent = &results[LFRFIDReadBenchModeConcurrent];
+        if(alternate->protocol != PROTOCOL_NO && concurrent->protocol != PROTOCOL_NO &&
+           (alternate->protocol != concurrent->protocol ||
+            memcmp(alternate->data, concurrent->data, sizeof(alternate->data)) != 0)) {
+            printf("FAIL %s: reads differ\n", base);
+            success = false;
+        }
+    } else {
+        printf("FAIL %s: no %s or %s capture\n", base, extensions[0], extensions[1]);
+    }
+
+    for(size_t i = 0; i < LFRFIDReadDecoderFamilyCount; i++) {
+        lfrfid_read_bench_capture_free(&captures[i]);
+    }
+    return success;
+}
+
+static void lfrfid_read_bench_usage(const char* name) {
+    printf("Usage: %s [-l limit_ms] capture...\n", name);
+}
+
+int main(int argc, char** argv) {
+    uint32_t limit_ms = LFRFID_READ_BENCH_LIMIT_MS;
+
+    int option;
+    while((option = getopt(argc, argv, "l:h")) != -1) {
+        switch(option) {
+        case 'l':
+            limit_ms = strtoul(optarg, NULL, 10);
+            break;
+        default:
+            lfrfid_read_bench_usage(argv[0]);
+            return 2;
+        }
+    }
+
+    if(optind == argc || !limit_ms) {
+        lfrfid_read_bench_usage(argv[0]);
+        return 2;
+    }
+
+    furi_init();
+    // Storage root is the file system root, host paths are opened under /ext
+    storage_host_record_create("/");
+
+    ProtocolDict* dict = protocol_dict_alloc(lfrfid_protocols, LFRFIDProtocolMax);
+    LFRFIDReadBenchStats total = {0};
+    size_t failures = 0;
+
+    for(int i = optind; i < argc; i++) {
+        // capture is passed with or without extension
+        FuriString* base = furi_string_alloc_set(argv[i]);
+        if(furi_string_end_with_str(base, LFRFID_READ_BENCH_ASK_EXTENSION) ||
+           furi_string_end_with_str(base, LFRFID_READ_BENCH_PSK_EXTENSION)) {
+            furi_string_left(
+                base, furi_string_size(base) - strlen(LFRFID_READ_BENCH_ASK_EXTENSION));
+        }
+
+        char* path = NULL;
+        const char* extensions[] = {
+            LFRFID_READ_BENCH_ASK_EXTENSION, LFRFID_READ_BENCH_PSK_EXTENSION};
+        for(size_t j = 0; !path && j < COUNT_OF(extensions); j++) {
+            FuriString* file = furi_string_alloc_printf(
+                "%s%s", furi_string_get_cstr(base), extensions[j]);
+            path = realpath(furi_string_get_cstr(file), NULL);
+            if(path) path[strlen(path) - strlen(extensions[j])] = '\0';
+            furi_string_free(file);
+        }
+        furi_string_free(base);
+
+        if(!path) {
+            printf("FAIL %s: %s\n", argv[i], strerror(errno));
+            failures++;
+            continue;
+        }
+
+        if(!lfrfid_read_bench_run(dict, &total, path, limit_ms)) failures++;
+        free(path);
+    }
+
+    printf("Captures: %d\n", argc - optind);
+    for(size_t mode = 0; mode < LFRFIDReadBenchModeCount; mode++) {
+        printf(
+            "%-10s %4zu reads, average time to first read %8.1f ms\n",
+            lfrfid_read_bench_mode_names[mode],
+            total.reads[mode],
+            total.reads[mode] ? total.time_us[mode] / 1000.0 / total.reads[mode] : 0.0);
+    }
+
+    protocol_dict_free(dict);
+
+    if(failures) printf("%zu failures\n", failures);
+    return failures ? 1 : 0;
+}
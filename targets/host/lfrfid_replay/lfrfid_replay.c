@@ -0,0 +1,345 @@
+#include <furi.h>
+#include <storage/storage.h>
+#include <storage_host.h>
+#include <toolbox/protocols/protocol_dict.h>
+#include <lfrfid/lfrfid_raw_replay.h>
+#include <lfrfid/protocols/lfrfid_protocols.h>
+
+#include <errno.h>
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define TAG "LfRfidReplay"
+
+#define LFRFID_REPLAY_ROUNDS (10U)
+/* Auto read runs ASK decoders on 125 kHz carrier and PSK decoders on 62.5 kHz */
+#define LFRFID_REPLAY_ASK_FREQUENCY_MIN (100000.0f)
+
+typedef enum {
+    LFRFIDReplayFeaturesCarrier,
+    LFRFIDReplayFeaturesASK,
+    LFRFIDReplayFeaturesPSK,
+    LFRFIDReplayFeaturesAll,
+    LFRFIDReplayFeaturesCount,
+} LFRFIDReplayFeatures;
+
+typedef struct {
+    ProtocolDict* dict;
+    LFRFIDReadDecoder* decoder;
+    FILE* output;
+    uint8_t* data;
+    size_t decodes;
+    bool decoded;
+    uint32_t first_decode_time;
+    size_t first_decode_index;
+    bool settled;
+    uint32_t first_settle_time;
+    size_t first_settle_index;
+} LFRFIDReplayContext;
+
+static const char* lfrfid_replay_features_names[LFRFIDReplayFeaturesCount] = {
+    [LFRFIDReplayFeaturesCarrier] = "carrier",
+    [LFRFIDReplayFeaturesASK] = "ask",
+    [LFRFIDReplayFeaturesPSK] = "psk",
+    [LFRFIDReplayFeaturesAll] = "all",
+};
+
+static const char* lfrfid_replay_event_names[] = {
+    [LFRFIDReadDecoderEventNone] = "none",
+    [LFRFIDReadDecoderEventDecoded] = "decoded",
+    [LFRFIDReadDecoderEventSettled] = "settled",
+};
+
+static uint64_t lfrfid_replay_time_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static void lfrfid_replay_print_string(FILE* output, const char* string) {
+    fputc('"', output);
+    for(const char* c = string; *c; c++) {
+        if(*c == '"' || *c == '\\') {
+            fprintf(output, "\\%c", *c);
+        } else if((unsigned char)*c < 0x20) {
+            fprintf(output, "\\u%04x", (unsigned char)*c);
+        } else {
+            fputc(*c, output);
+        }
+    }
+    fputc('"', output);
+}
+
+static void lfrfid_replay_print_rate(FILE* output, uint64_t edges, uint64_t total_ns) {
+    fprintf(
+        output,
+        "\"edges\": %llu, \"ns_per_edge\": %.3f, \"edges_per_second\": %.0f",
+        (unsigned long long)edges,
+        edges ? (double)total_ns / edges : 0.0,
+        total_ns ? edges * 1e9 / total_ns : 0.0);
+}
+
+static void lfrfid_replay_print_latency(
+    FILE* output,
+    const char* name,
+    bool valid,
+    uint32_t time,
+    size_t index) {
+    if(valid) {
+        fprintf(
+            output,
+            "\"%s\": {\"time_us\": %lu, \"pair\": %zu}",
+            name,
+            (unsigned long)time,
+            index);
+    } else {
+        fprintf(output, "\"%s\": null", name);
+    }
+}
+
+static void lfrfid_replay_decode_callback(const LFRFIDRawReplayDecode* decode, void* context) {
+    LFRFIDReplayContext* ctx = context;
+
+    if(!ctx->decoded) {
+        ctx->decoded = true;
+        ctx->first_decode_time = decode->time;
+        ctx->first_decode_index = decode->index;
+    }
+    if(!ctx->settled && decode->event == LFRFIDReadDecoderEventSettled) {
+        ctx->settled = true;
+        ctx->first_settle_time = decode->time;
+        ctx->first_settle_index = decode->index;
+    }
+
+    size_t data_size = protocol_dict_get_data_size(ctx->dict, decode->protocol);
+    lfrfid_read_decoder_get_data(ctx->decoder, ctx->data, data_size);
+
+    fprintf(
+        ctx->output,
+        "%s\n        {\"pair\": %zu, \"time_us\": %lu, \"event\": \"%s\", \"protocol\": ",
+        ctx->decodes ? "," : "",
+        decode->index,
+        (unsigned long)decode->time,
+        lfrfid_replay_event_names[decode->event]);
+    lfrfid_replay_print_string(ctx->output, protocol_dict_get_name(ctx->dict, decode->protocol));
+    fprintf(ctx->output, ", \"data\": \"");
+    for(size_t i = 0; i < data_size; i++) {
+        fprintf(ctx->output, "%02X", ctx->data[i]);
+    }
+    fprintf(ctx->output, "\"}");
+
+    ctx->decodes++;
+}
+
+// Same protocol alone, restarted on decode as read decoder does
+static uint64_t lfrfid_replay_time_protocol(
+    ProtocolDict* dict,
+    LFRFIDRawReplay* replay,
+    ProtocolId protocol,
+    uint32_t rounds,
+    size_t* decodes) {
+    size_t count = lfrfid_raw_replay_get_count(replay);
+    uint64_t start = lfrfid_replay_time_ns();
+    *decodes = 0;
+
+    for(uint32_t round = 0; round < rounds; round++) {
+        protocol_dict_decoders_start_by_id(dict, protocol);
+        for(size_t i = 0; i < count; i++) {
+            uint32_t pulse;
+            uint32_t duration;
+            lfrfid_raw_replay_get_pair(replay, i, &pulse, &duration);
+
+            ProtocolId decoded = protocol_dict_decoders_feed_by_id(dict, protocol, true, pulse);
+            if(decoded == PROTOCOL_NO) {
+                decoded =
+                    protocol_dict_decoders_feed_by_id(dict, protocol, false, duration - pulse);
+            }
+            if(decoded != PROTOCOL_NO) {
+                if(round == 0) (*decodes)++;
+                protocol_dict_decoders_start_by_id(dict, protocol);
+            }
+        }
+    }
+
+    return lfrfid_replay_time_ns() - start;
+}
+
+static bool lfrfid_replay_run(
+    FILE* output,
+    ProtocolDict* dict,
+    const char* path,
+    LFRFIDReplayFeatures features_mode,
+    uint32_t rounds,
+    bool first) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    LFRFIDRawReplay* replay = lfrfid_raw_replay_alloc();
+    FuriString* storage_path = furi_string_alloc_printf(STORAGE_EXT_PATH_PREFIX "%s", path);
+    bool success = lfrfid_raw_replay_load(replay, storage, furi_string_get_cstr(storage_path));
+    furi_string_free(storage_path);
+    furi_record_close(RECORD_STORAGE);
+
+    fprintf(output, "%s\n    {\n      \"file\": ", first ? "" : ",");
+    lfrfid_replay_print_string(output, path);
+
+    if(!success) {
+        fprintf(stderr, "FAIL %s: can't load capture\n", path);
+        fprintf(output, ",\n      \"error\": \"can't load capture\"\n    }");
+        lfrfid_raw_replay_free(replay);
+        return false;
+    }
+
+    float frequency = lfrfid_raw_replay_get_frequency(replay);
+    LFRFIDFeature features = LFRFIDFeatureASK | LFRFIDFeaturePSK;
+    if(features_mode == LFRFIDReplayFeaturesASK ||
+       (features_mode == LFRFIDReplayFeaturesCarrier &&
+        frequency >= LFRFID_REPLAY_ASK_FREQUENCY_MIN)) {
+        features = LFRFIDFeatureASK;
+    } else if(features_mode != LFRFIDReplayFeaturesAll) {
+        features = LFRFIDFeaturePSK;
+    }
+
+    size_t count = lfrfid_raw_replay_get_count(replay);
+    uint64_t edges = (uint64_t)count * 2;
+
+    fprintf(
+        output,
+        ",\n      \"frequency\": %.0f, \"duty_cycle\": %.3f, \"features\": \"%s\",\n"
+        "      \"raw_pairs\": %zu, \"pairs\": %zu, \"time_us\": %lu,\n"
+        "      \"decodes\": [",
+        (double)frequency,
+        (double)lfrfid_raw_replay_get_duty_cycle(replay),
+        features == LFRFIDFeatureASK ? "ask" :
+        features == LFRFIDFeaturePSK ? "psk" :
+                                       "ask+psk",
+        lfrfid_raw_replay_get_raw_count(replay),
+        count,
+        (unsigned long)lfrfid_raw_replay_get_time(replay));
+
+    LFRFIDReadDecoder* decoder = lfrfid_read_decoder_alloc(dict, features);
+    LFRFIDReplayContext ctx = {
+        .dict = dict,
+        .decoder = decoder,
+        .output = output,
+        .data = malloc(protocol_dict_get_max_data_size(dict)),
+    };
+
+    size_t settled = lfrfid_raw_replay_run(replay, decoder, lfrfid_replay_decode_callback, &ctx);
+    fprintf(
+        output,
+        "%s],\n      \"settled\": %zu,\n      ",
+        ctx.decodes ? "\n      " : "",
+        settled);
+    lfrfid_replay_print_latency(
+        output, "first_decode", ctx.decoded, ctx.first_decode_time, ctx.first_decode_index);
+    fprintf(output, ",\n      ");
+    lfrfid_replay_print_latency(
+        output, "first_settle", ctx.settled, ctx.first_settle_time, ctx.first_settle_index);
+
+    uint64_t start = lfrfid_replay_time_ns();
+    for(uint32_t round = 0; round < rounds; round++) {
+        lfrfid_raw_replay_run(replay, decoder, NULL, NULL);
+    }
+    uint64_t total_ns = lfrfid_replay_time_ns() - start;
+
+    fprintf(output, ",\n      \"decoder\": {");
+    lfrfid_replay_print_rate(output, edges * rounds, total_ns);
+    fprintf(output, "},\n      \"protocols\": [");
+
+    bool first_protocol = true;
+    for(size_t id = 0; id < LFRFIDProtocolMax; id++) {
+        if(!(protocol_dict_get_features(dict, id) & features)) continue;
+
+        size_t decodes = 0;
+        total_ns = lfrfid_replay_time_protocol(dict, replay, id, rounds, &decodes);
+
+        fprintf(output, "%s\n        {\"protocol\": ", first_protocol ? "" : ",");
+        lfrfid_replay_print_string(output, protocol_dict_get_name(dict, id));
+        fprintf(output, ", \"decodes\": %zu, ", decodes);
+        lfrfid_replay_print_rate(output, edges * rounds, total_ns);
+        fprintf(output, "}");
+        first_protocol = false;
+    }
+    fprintf(output, "\n      ]\n    }");
+
+    free(ctx.data);
+    lfrfid_read_decoder_free(decoder);
+    lfrfid_raw_replay_free(replay);
+    return true;
+}
+
+static void lfrfid_replay_usage(const char* name) {
+    printf(
+        "Usage: %s [-f carrier|ask|psk|all] [-r rounds] [-o output.json] capture.raw...\n",
+        name);
+}
+
+int main(int argc, char** argv) {
+    LFRFIDReplayFeatures features = LFRFIDReplayFeaturesCarrier;
+    uint32_t rounds = LFRFID_REPLAY_ROUNDS;
+    const char* output_path = NULL;
+
+    int option;
+    while((option = getopt(argc, argv, "f:r:o:h")) != -1) {
+        switch(option) {
+        case 'f':
+            features = LFRFIDReplayFeaturesCount;
+            for(size_t i = 0; i < LFRFIDReplayFeaturesCount; i++) {
+                if(strcmp(optarg, lfrfid_replay_features_names[i]) == 0) features = i;
+            }
+            if(features == LFRFIDReplayFeaturesCount) {
+                lfrfid_replay_usage(argv[0]);
+                return 2;
+            }
+            break;
+        case 'r':
+            rounds = strtoul(optarg, NULL, 10);
+            break;
+        case 'o':
+            output_path = optarg;
+            break;
+        default:
+            lfrfid_replay_usage(argv[0]);
+            return 2;
+        }
+    }
+
+    if(optind == argc || !rounds) {
+        lfrfid_replay_usage(argv[0]);
+        return 2;
+    }
+
+    FILE* output = stdout;
+    if(output_path) {
+        output = fopen(output_path, "w");
+        if(!output) {
+            fprintf(stderr, "FAIL %s: %s\n", output_path, strerror(errno));
+            return 1;
+        }
+    }
+
+    furi_init();
+    // Storage root is the file system root, host paths are opened under /ext
+    storage_host_record_create("/");
+
+    ProtocolDict* dict = protocol_dict_alloc(lfrfid_protocols, LFRFIDProtocolMax);
+    size_t failures = 0;
+
+    fprintf(output, "{\n  \"rounds\": %lu,\n  \"captures\": [", (unsigned long)rounds);
+    for(int i = optind; i < argc; i++) {
+        char* path = realpath(argv[i], NULL);
+        bool first = (i == optind);
+        if(!lfrfid_replay_run(output, dict, path ? path : argv[i], features, rounds, first)) {
+            failures++;
+        }
+        free(path);
+    }
+    fprintf(output, "\n  ],\n  \"failures\": %zu\n}\n", failures);
+
+    protocol_dict_free(dict);
+    if(output != stdout) fclose(output);
+
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,199 @@
+#include <furi.h>
+#include <nfc/nfc.h>
+#include <nfc/nfc_device.h>
+#include <nfc/nfc_listener.h>
+#include <nfc/helpers/nfc_data_generator.h>
+#include <nfc/protocols/mf_classic/mf_classic_poller_sync.h>
+#include <toolbox/profiler.h>
+
+#include <getopt.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MF_CLASSIC_LISTENER_BENCH_ROUNDS (10U)
+// Generous: mock transport runs on threads, real readers expect responses within ~100us
+#define MF_CLASSIC_LISTENER_BENCH_LATENCY_MAX_US (1000U)
+#define MF_CLASSIC_LISTENER_BENCH_VALUE_BLOCK (2U)
+#define MF_CLASSIC_LISTENER_BENCH_VALUE (228)
+
+typedef enum {
+    MfClassicListenerBenchPhaseAuthRead,
+    MfClassicListenerBenchPhaseWrite,
+    MfClassicListenerBenchPhaseReadAfterWrite,
+    MfClassicListenerBenchPhaseValue,
+    MfClassicListenerBenchPhaseCount,
+} MfClassicListenerBenchPhase;
+
+typedef struct {
+    uint64_t count;
+    uint64_t total;
+    uint32_t max;
+} MfClassicListenerBenchStats;
+
+static const char* mf_classic_listener_bench_phase_names[MfClassicListenerBenchPhaseCount] = {
+    [MfClassicListenerBenchPhaseAuthRead] = "Auth and read",
+    [MfClassicListenerBenchPhaseWrite] = "Write",
+    [MfClassicListenerBenchPhaseReadAfterWrite] = "Read after write",
+    [MfClassicListenerBenchPhaseValue] = "Value",
+};
+
+static const MfClassicKey mf_classic_listener_bench_key = {
+    .data = {0xff, 0xff, 0xff, 0xff, 0xff, 0xff},
+};
+
+// Accounts listener responses of the phase and starts the next one
+static void mf_classic_listener_bench_update(MfClassicListenerBenchStats* stats) {
+    ProfilerProbeStats probe = {};
+    profiler_probe_get_stats(ProfilerProbeNfcListenerResponse, &probe);
+    profiler_probe_reset();
+
+    stats->count += probe.count;
+    stats->total += probe.total;
+    stats->max = MAX(stats->max, probe.max);
+}
+
+static bool mf_classic_listener_bench_run_phase(
+    Nfc* poller,
+    const MfClassicData* mfc_data,
+    MfClassicListenerBenchPhase phase) {
+    MfClassicKey key = mf_classic_listener_bench_key;
+    MfClassicBlock block = {};
+    MfClassicBlock block_write = {};
+    MfClassicError error = MfClassicErrorNone;
+    const uint8_t value_block = MF_CLASSIC_LISTENER_BENCH_VALUE_BLOCK;
+    mf_classic_value_to_block(MF_CLASSIC_LISTENER_BENCH_VALUE, value_block, &block_write);
+
+    if(phase == MfClassicListenerBenchPhaseAuthRead) {
+        // Sector trailer read goes through the same cache, key A must stay hidden
+        for(uint8_t i = 0; i < 4; i++) {
+            error = mf_classic_poller_sync_read_block(poller, i, &key, MfClassicKeyTypeA, &block);
+            if(error != MfClassicErrorNone) return false;
+            MfClassicBlock expected = mfc_data->block[i];
+            if(mf_classic_is_sector_trailer(i)) {
+                memset(expected.data, 0, sizeof(MfClassicKey));
+            }
+            // Value block is rewritten by the write phase of previous rounds
+            if((i != value_block) && memcmp(&expected, &block, sizeof(MfClassicBlock))) {
+                return false;
+            }
+        }
+    } else if(phase == MfClassicListenerBenchPhaseWrite) {
+        error = mf_classic_poller_sync_write_block(
+            poller, value_block, &key, MfClassicKeyTypeA, &block_write);
+        if(error != MfClassicErrorNone) return false;
+    } else if(phase == MfClassicListenerBenchPhaseReadAfterWrite) {
+        // Cached response of written block must be refreshed
+        error = mf_classic_poller_sync_read_block(
+            poller, value_block, &key, MfClassicKeyTypeA, &block);
+        if(error != MfClassicErrorNone) return false;
+        if(memcmp(&block_write, &block, sizeof(MfClassicBlock))) return false;
+    } else {
+        int32_t new_value = 0;
+        error = mf_classic_poller_sync_change_value(
+            poller, value_block, &key, MfClassicKeyTypeA, 1, &new_value);
+        if(error != MfClassicErrorNone) return false;
+        if(new_value != MF_CLASSIC_LISTENER_BENCH_VALUE + 1) return false;
+    }
+
+    return true;
+}
+
+static void mf_classic_listener_bench_print(
+    const char* name,
+    const MfClassicListenerBenchStats* stats,
+    uint32_t ticks_per_us) {
+    printf(
+        "%s: %llu responses, average %.1f us, worst %" PRIu32 " us\n",
+        name,
+        (unsigned long long)stats->count,
+        stats->count ? (double)stats->total / stats->count / ticks_per_us : 0,
+        stats->max / ticks_per_us);
+}
+
+static void mf_classic_listener_bench_usage(const char* name) {
+    printf("Usage: %s [-r rounds] [-m max_us]\n", name);
+}
+
+int main(int argc, char** argv) {
+    uint32_t rounds = MF_CLASSIC_LISTENER_BENCH_ROUNDS;
+    uint32_t latency_max_us = MF_CLASSIC_LISTENER_BENCH_LATENCY_MAX_US;
+
+    int option;
+    while((option = getopt(argc, argv, "r:m:h")) != -1) {
+        switch(option) {
+        case 'r':
+            rounds = strtoul(optarg, NULL, 10);
+            break;
+        case 'm':
+            latency_max_us = strtoul(optarg, NULL, 10);
+            break;
+        default:
+            mf_classic_listener_bench_usage(argv[0]);
+            return 2;
+        }
+    }
+
+    if(optind != argc || !rounds || !latency_max_us) {
+        mf_classic_listener_bench_usage(argv[0]);
+        return 2;
+    }
+
+    furi_init();
+    // Mock transport logs every frame
+    furi_log_set_level(FuriLogLevelError);
+
+    Nfc* poller = nfc_alloc();
+    Nfc* listener = nfc_alloc();
+
+    NfcDevice* nfc_device = nfc_device_alloc();
+    nfc_data_generator_fill_data(NfcDataGeneratorTypeMfClassic4k_7b, nfc_device);
+    NfcListener* mfc_listener = nfc_listener_alloc(
+        listener, NfcProtocolMfClassic, nfc_device_get_data(nfc_device, NfcProtocolMfClassic));
+    nfc_listener_start(mfc_listener, NULL, NULL);
+
+    const MfClassicData* mfc_data = nfc_listener_get_data(mfc_listener, NfcProtocolMfClassic);
+    MfClassicListenerBenchStats stats[MfClassicListenerBenchPhaseCount] = {};
+    size_t failures = 0;
+
+    profiler_probe_enable(true);
+
+    for(uint32_t round = 0; round < rounds; round++) {
+        for(size_t phase = 0; phase < MfClassicListenerBenchPhaseCount; phase++) {
+            if(!mf_classic_listener_bench_run_phase(poller, mfc_data, phase)) {
+                printf(
+                    "FAIL %s: round %" PRIu32 " wrong or no response\n",
+                    mf_classic_listener_bench_phase_names[phase],
+                    round);
+                failures++;
+            }
+            mf_classic_listener_bench_update(&stats[phase]);
+        }
+    }
+
+    profiler_probe_enable(false);
+
+    nfc_listener_stop(mfc_listener);
+    nfc_listener_free(mfc_listener);
+
+    const uint32_t ticks_per_us = profiler_probe_get_ticks_per_us();
+    for(size_t phase = 0; phase < MfClassicListenerBenchPhaseCount; phase++) {
+        const char* name = mf_classic_listener_bench_phase_names[phase];
+        mf_classic_listener_bench_print(name, &stats[phase], ticks_per_us);
+        if(!stats[phase].count) {
+            printf("FAIL %s: no listener responses\n", name);
+            failures++;
+        } else if(stats[phase].max / ticks_per_us >= latency_max_us) {
+            printf("FAIL %s: worst response not under %" PRIu32 " us\n", name, latency_max_us);
+            failures++;
+        }
+    }
+
+    nfc_device_free(nfc_device);
+    nfc_free(listener);
+    nfc_free(poller);
+
+    if(failures) printf("%zu failures\n", failures);
+    return failures ? 1 : 0;
+}
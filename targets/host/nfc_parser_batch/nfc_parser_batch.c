@@ -0,0 +1,509 @@
+#include "nfc_parser_plugins.h"
+
+#include <furi.h>
+#include <storage/storage.h>
+#include <storage_host.h>
+
+#include <dirent.h>
+#include <errno.h>
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/stat.h>
+
+#define TAG "NfcParserBatch"
+
+#define NFC_PARSER_BATCH_WORKER_STACK_SIZE (8 * 1024)
+#define NFC_PARSER_BATCH_JOBS_MAX (64U)
+#define NFC_PARSER_BATCH_DIFF_LINES_MAX (20U)
+#define NFC_PARSER_BATCH_EXTENSION ".nfc"
+#define NFC_PARSER_BATCH_GOLDEN_EXTENSION ".txt"
+#define NFC_PARSER_BATCH_PLUGIN_NONE "none"
+
+typedef enum {
+    NfcParserBatchResultLoadFailed,
+    NfcParserBatchResultParsed,
+    NfcParserBatchResultNotParsed,
+} NfcParserBatchResult;
+
+typedef struct {
+    char* path; // Relative to dump directory
+    NfcParserBatchResult result;
+    int plugin; // Index of plugin that parsed the dump, -1 if none
+    FuriString* output;
+    uint64_t load_ns;
+} NfcParserBatchDump;
+
+typedef struct {
+    uint32_t calls;
+    uint32_t parsed;
+    uint64_t total_ns;
+    uint64_t max_ns;
+} NfcParserBatchPluginStats;
+
+typedef struct {
+    NfcParserBatchDump* dumps;
+    size_t dump_count;
+    size_t dump_capacity;
+    size_t next_dump;
+    FuriMutex* mutex;
+} NfcParserBatch;
+
+typedef struct {
+    NfcParserBatch* batch;
+    NfcParserBatchPluginStats* stats;
+} NfcParserBatchWorker;
+
+static uint64_t nfc_parser_batch_time_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static void nfc_parser_batch_add_dump(NfcParserBatch* batch, const char* path) {
+    if(batch->dump_count == batch->dump_capacity) {
+        batch->dump_capacity = batch->dump_capacity ? batch->dump_capacity * 2 : 64;
+        batch->dumps = realloc(batch->dumps, batch->dump_capacity * sizeof(NfcParserBatchDump));
+    }
+
+    NfcParserBatchDump* dump = &batch->dumps[batch->dump_count++];
+    dump->path = strdup(path);
+    dump->result = NfcParserBatchResultLoadFailed;
+    dump->plugin = -1;
+    dump->output = furi_string_alloc();
+    dump->load_ns = 0;
+}
+
+static bool nfc_parser_batch_has_extension(const char* name, const char* extension) {
+    size_t name_len = strlen(name);
+    size_t extension_len = strlen(extension);
+    return (name_len > extension_len) &&
+           (strcmp(name + name_len - extension_len, extension) == 0);
+}
+
+/* Collect dump paths relative to root, recursively */
+static bool nfc_parser_batch_scan(NfcParserBatch* batch, const char* root, const char* subdir) {
+    FuriString* dir_path = furi_string_alloc_printf("%s%s", root, subdir);
+    DIR* dir = opendir(furi_string_get_cstr(dir_path));
+    furi_string_free(dir_path);
+    if(!dir) return false;
+
+    bool success = true;
+    FuriString* path = furi_string_alloc();
+    struct dirent* entry;
+    while((entry = readdir(dir)) != NULL) {
+        if(entry->d_name[0] == '.') continue;
+
+        furi_string_printf(path, "%s/%s", subdir, entry->d_name);
+        FuriString* host_path = furi_string_alloc_printf("%s%s", root, furi_string_get_cstr(path));
+        struct stat st;
+        bool is_stat_ok = (stat(furi_string_get_cstr(host_path), &st) == 0);
+        furi_string_free(host_path);
+        if(!is_stat_ok) continue;
+
+        if(S_ISDIR(st.st_mode)) {
+            success &= nfc_parser_batch_scan(batch, root, furi_string_get_cstr(path));
+        } else if(nfc_parser_batch_has_extension(entry->d_name, NFC_PARSER_BATCH_EXTENSION)) {
+            // Skip leading slash
+            nfc_parser_batch_add_dump(batch, furi_string_get_cstr(path) + 1);
+        }
+    }
+
+    furi_string_free(path);
+    closedir(dir);
+
+    return success;
+}
+
+static int nfc_parser_batch_dump_cmp(const void* a, const void* b) {
+    const NfcParserBatchDump* dump_a = a;
+    const NfcParserBatchDump* dump_b = b;
+    return strcmp(dump_a->path, dump_b->path);
+}
+
+static NfcParserBatchDump* nfc_parser_batch_get_next_dump(NfcParserBatch* batch) {
+    NfcParserBatchDump* dump = NULL;
+
+    furi_check(furi_mutex_acquire(batch->mutex, FuriWaitForever) == FuriStatusOk);
+    if(batch->next_dump < batch->dump_count) {
+        dump = &batch->dumps[batch->next_dump++];
+    }
+    furi_check(furi_mutex_release(batch->mutex) == FuriStatusOk);
+
+    return dump;
+}
+
+/* Same order and rules as nfc_supported_cards_parse: first plugin that parses wins */
+static void nfc_parser_batch_parse(
+    NfcParserBatchDump* dump,
+    const NfcDevice* device,
+    NfcParserBatchPluginStats* stats) {
+    NfcProtocol protocol = nfc_device_get_protocol(device);
+
+    for(size_t i = 0; i < nfc_parser_plugins_get_count(); i++) {
+        NfcParserPlugin parser = nfc_parser_plugins_get(i);
+        if(parser.plugin->protocol != protocol) continue;
+        if(parser.plugin->parse == NULL) continue;
+
+        // Output is not reset between plugins, same as in firmware
+        uint64_t start = nfc_parser_batch_time_ns();
+        bool parsed = parser.plugin->parse(device, dump->output);
+        uint64_t duration = nfc_parser_batch_time_ns() - start;
+
+        stats[i].calls++;
+        stats[i].total_ns += duration;
+        stats[i].max_ns = MAX(stats[i].max_ns, duration);
+
+        if(parsed) {
+            stats[i].parsed++;
+            dump->plugin = i;
+            break;
+        }
+    }
+
+    dump->result = (dump->plugin >= 0) ? NfcParserBatchResultParsed :
+                                         NfcParserBatchResultNotParsed;
+}
+
+static int32_t nfc_parser_batch_worker(void* context) {
+    NfcParserBatchWorker* worker = context;
+    NfcDevice* device = nfc_device_alloc();
+    FuriString* path = furi_string_alloc();
+
+    NfcParserBatchDump* dump;
+    while((dump = nfc_parser_batch_get_next_dump(worker->batch)) != NULL) {
+        furi_string_printf(path, "%s/%s", STORAGE_EXT_PATH_PREFIX, dump->path);
+
+        uint64_t start = nfc_parser_batch_time_ns();
+        bool loaded = nfc_device_load(device, furi_string_get_cstr(path));
+        dump->load_ns = nfc_parser_batch_time_ns() - start;
+
+        if(loaded) {
+            nfc_parser_batch_parse(dump, device, worker->stats);
+        }
+
+        nfc_device_clear(device);
+    }
+
+    furi_string_free(path);
+    nfc_device_free(device);
+
+    return 0;
+}
+
+static void
+    nfc_parser_batch_run(NfcParserBatch* batch, NfcParserBatchPluginStats* stats, size_t jobs) {
+    const size_t plugin_count = nfc_parser_plugins_get_count();
+    FuriThread* threads[NFC_PARSER_BATCH_JOBS_MAX];
+    NfcParserBatchWorker workers[NFC_PARSER_BATCH_JOBS_MAX];
+
+    for(size_t i = 0; i < jobs; i++) {
+        workers[i].batch = batch;
+        workers[i].stats = calloc(plugin_count, sizeof(NfcParserBatchPluginStats));
+        threads[i] = furi_thread_alloc_ex(
+            TAG, NFC_PARSER_BATCH_WORKER_STACK_SIZE, nfc_parser_batch_worker, &workers[i]);
+        furi_thread_start(threads[i]);
+    }
+
+    for(size_t i = 0; i < jobs; i++) {
+        furi_thread_join(threads[i]);
+        furi_thread_free(threads[i]);
+
+        for(size_t j = 0; j < plugin_count; j++) {
+            stats[j].calls += workers[i].stats[j].calls;
+            stats[j].parsed += workers[i].stats[j].parsed;
+            stats[j].total_ns += workers[i].stats[j].total_ns;
+            stats[j].max_ns = MAX(stats[j].max_ns, workers[i].stats[j].max_ns);
+        }
+        free(workers[i].stats);
+    }
+}
+
+/* Golden file holds name of plugin that parsed the dump and its output */
+static void nfc_parser_batch_format_result(const NfcParserBatchDump* dump, FuriString* result) {
+    const char* plugin_name = NFC_PARSER_BATCH_PLUGIN_NONE;
+    if(dump->plugin >= 0) plugin_name = nfc_parser_plugins_get(dump->plugin).name;
+
+    furi_string_printf(result, "Plugin: %s\n", plugin_name);
+    if(dump->plugin >= 0) {
+        furi_string_cat(result, dump->output);
+        if(!furi_string_end_with(result, "\n")) furi_string_push_back(result, '\n');
+    }
+}
+
+static bool nfc_parser_batch_read_file(const char* path, FuriString* content) {
+    FILE* file = fopen(path, "rb");
+    if(!file) return false;
+
+    furi_string_reset(content);
+    char buffer[256];
+    size_t bytes_read;
+    while((bytes_read = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        for(size_t i = 0; i < bytes_read; i++) {
+            furi_string_push_back(content, buffer[i]);
+        }
+    }
+
+    bool success = !ferror(file);
+    fclose(file);
+    return success;
+}
+
+static bool nfc_parser_batch_mkdir_for(const char* path) {
+    char* dir = strdup(path);
+    bool success = true;
+
+    for(char* p = dir + 1; *p && success; p++) {
+        if(*p != '/') continue;
+        *p = '\0';
+        success = (mkdir(dir, 0755) == 0) || (errno == EEXIST);
+        *p = '/';
+    }
+
+    free(dir);
+    return success;
+}
+
+static bool nfc_parser_batch_write_file(const char* path, const FuriString* content) {
+    if(!nfc_parser_batch_mkdir_for(path)) return false;
+
+    FILE* file = fopen(path, "wb");
+    if(!file) return false;
+
+    size_t size = furi_string_size(content);
+    bool success = (fwrite(furi_string_get_cstr(content), 1, size, file) == size);
+    success &= (fclose(file) == 0);
+    return success;
+}
+
+/* Get line starting at offset, returns false past the end of text */
+static bool nfc_parser_batch_get_line(const FuriString* text, size_t* offset, FuriString* line) {
+    size_t size = furi_string_size(text);
+    if(*offset >= size) return false;
+
+    size_t end = furi_string_search_char(text, '\n', *offset);
+    if(end == FURI_STRING_FAILURE) end = size;
+
+    furi_string_set_n(line, text, *offset, end - *offset);
+    *offset = end + 1;
+    return true;
+}
+
+/* Line by line diff, enough to see what changed in plugin output */
+static void nfc_parser_batch_print_diff(const FuriString* expected, const FuriString* actual) {
+    FuriString* expected_line = furi_string_alloc();
+    FuriString* actual_line = furi_string_alloc();
+    size_t expected_offset = 0;
+    size_t actual_offset = 0;
+    size_t line_num = 0;
+    size_t printed = 0;
+
+    while(true) {
+        bool has_expected = nfc_parser_batch_get_line(expected, &expected_offset, expected_line);
+        bool has_actual = nfc_parser_batch_get_line(actual, &actual_offset, actual_line);
+        if(!has_expected && !has_actual) break;
+
+        line_num++;
+        if(has_expected && has_actual && furi_string_equal(expected_line, actual_line)) continue;
+
+        if(printed++ == NFC_PARSER_BATCH_DIFF_LINES_MAX) {
+            printf("    ...\n");
+            break;
+        }
+
+        if(has_expected) {
+            printf("    %zu: -%s\n", line_num, furi_string_get_cstr(expected_line));
+        }
+        if(has_actual) {
+            printf("    %zu: +%s\n", line_num, furi_string_get_cstr(actual_line));
+        }
+    }
+
+    furi_string_free(expected_line);
+    furi_string_free(actual_line);
+}
+
+/* Compare results with golden files or write them, returns number of mismatches */
+static size_t
+    nfc_parser_batch_check_golden(NfcParserBatch* batch, const char* golden_dir, bool update) {
+    size_t mismatches = 0;
+    FuriString* golden_path = furi_string_alloc();
+    FuriString* expected = furi_string_alloc();
+    FuriString* actual = furi_string_alloc();
+
+    for(size_t i = 0; i < batch->dump_count; i++) {
+        const NfcParserBatchDump* dump = &batch->dumps[i];
+        if(dump->result == NfcParserBatchResultLoadFailed) continue;
+
+        furi_string_printf(
+            golden_path, "%s/%s%s", golden_dir, dump->path, NFC_PARSER_BATCH_GOLDEN_EXTENSION);
+        nfc_parser_batch_format_result(dump, actual);
+
+        if(update) {
+            if(!nfc_parser_batch_write_file(furi_string_get_cstr(golden_path), actual)) {
+                printf("FAIL %s: can't write %s\n", dump->path, furi_string_get_cstr(golden_path));
+                mismatches++;
+            }
+        } else if(!nfc_parser_batch_read_file(furi_string_get_cstr(golden_path), expected)) {
+            printf("FAIL %s: no golden file %s\n", dump->path, furi_string_get_cstr(golden_path));
+            mismatches++;
+        } else if(!furi_string_equal(expected, actual)) {
+            printf("FAIL %s: output differs from golden file\n", dump->path);
+            nfc_parser_batch_print_diff(expected, actual);
+            mismatches++;
+        }
+    }
+
+    furi_string_free(golden_path);
+    furi_string_free(expected);
+    furi_string_free(actual);
+
+    return mismatches;
+}
+
+static void nfc_parser_batch_print_report(
+    const NfcParserBatch* batch,
+    const NfcParserBatchPluginStats* stats,
+    uint64_t wall_ns) {
+    size_t load_failed = 0;
+    size_t parsed = 0;
+    uint64_t load_ns = 0;
+
+    for(size_t i = 0; i < batch->dump_count; i++) {
+        const NfcParserBatchDump* dump = &batch->dumps[i];
+        load_ns += dump->load_ns;
+
+        const char* plugin_name = NFC_PARSER_BATCH_PLUGIN_NONE;
+        if(dump->result == NfcParserBatchResultLoadFailed) {
+            load_failed++;
+            plugin_name = "load failed";
+        } else if(dump->result == NfcParserBatchResultParsed) {
+            parsed++;
+            plugin_name = nfc_parser_plugins_get(dump->plugin).name;
+        }
+        printf("%-48s %s\n", dump->path, plugin_name);
+    }
+
+    printf(
+        "\n%-20s %8s %8s %12s %12s %12s %s\n",
+        "plugin",
+        "calls",
+        "parsed",
+        "total us",
+        "avg us",
+        "max us",
+        "verify");
+    for(size_t i = 0; i < nfc_parser_plugins_get_count(); i++) {
+        NfcParserPlugin parser = nfc_parser_plugins_get(i);
+        const NfcParserBatchPluginStats* plugin_stats = &stats[i];
+        uint64_t avg_ns = plugin_stats->calls ? plugin_stats->total_ns / plugin_stats->calls : 0;
+
+        // verify() needs a card, there is none on host
+        printf(
+            "%-20s %8lu %8lu %12.1f %12.1f %12.1f %s\n",
+            parser.name,
+            (unsigned long)plugin_stats->calls,
+            (unsigned long)plugin_stats->parsed,
+            plugin_stats->total_ns / 1000.0,
+            avg_ns / 1000.0,
+            plugin_stats->max_ns / 1000.0,
+            parser.plugin->verify ? "not run" : "-");
+    }
+
+    printf(
+        "\n%zu dumps: %zu parsed, %zu not parsed, %zu failed to load\n",
+        batch->dump_count,
+        parsed,
+        batch->dump_count - parsed - load_failed,
+        load_failed);
+    printf("load %.1f ms total, wall time %.1f ms\n", load_ns / 1000000.0, wall_ns / 1000000.0);
+}
+
+static void nfc_parser_batch_usage(const char* name) {
+    printf("Usage: %s [-j jobs] [-g golden_dir [-u]] dump_dir\n", name);
+    printf("  -j jobs        worker threads, 1 to %u, default 1\n", NFC_PARSER_BATCH_JOBS_MAX);
+    printf("  -g golden_dir  compare output with golden_dir/<dump>.txt\n");
+    printf("  -u             write golden files instead of comparing\n");
+}
+
+int main(int argc, char** argv) {
+    size_t jobs = 1;
+    const char* golden_dir = NULL;
+    bool update = false;
+
+    int option;
+    while((option = getopt(argc, argv, "j:g:uh")) != -1) {
+        switch(option) {
+        case 'j':
+            jobs = strtoul(optarg, NULL, 10);
+            break;
+        case 'g':
+            golden_dir = optarg;
+            break;
+        case 'u':
+            update = true;
+            break;
+        default:
+            nfc_parser_batch_usage(argv[0]);
+            return 2;
+        }
+    }
+
+    if(optind + 1 != argc || jobs == 0 || jobs > NFC_PARSER_BATCH_JOBS_MAX ||
+       (update && !golden_dir)) {
+        nfc_parser_batch_usage(argv[0]);
+        return 2;
+    }
+
+    char* dump_dir = realpath(argv[optind], NULL);
+    if(!dump_dir) {
+        printf("Can't open %s: %s\n", argv[optind], strerror(errno));
+        return 2;
+    }
+
+    furi_init();
+    storage_host_record_create(dump_dir);
+
+    NfcParserBatch batch = {0};
+    batch.mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+    if(!nfc_parser_batch_scan(&batch, dump_dir, "")) {
+        printf("Can't scan %s\n", dump_dir);
+    }
+
+    // Report and golden checks don't depend on scheduling
+    qsort(batch.dumps, batch.dump_count, sizeof(NfcParserBatchDump), nfc_parser_batch_dump_cmp);
+
+    NfcParserBatchPluginStats* stats =
+        calloc(nfc_parser_plugins_get_count(), sizeof(NfcParserBatchPluginStats));
+
+    uint64_t start = nfc_parser_batch_time_ns();
+    nfc_parser_batch_run(&batch, stats, MIN(jobs, MAX(batch.dump_count, 1U)));
+    uint64_t wall_ns = nfc_parser_batch_time_ns() - start;
+
+    nfc_parser_batch_print_report(&batch, stats, wall_ns);
+
+    size_t failures = 0;
+    for(size_t i = 0; i < batch.dump_count; i++) {
+        if(batch.dumps[i].result == NfcParserBatchResultLoadFailed) {
+            printf("FAIL %s: can't load\n", batch.dumps[i].path);
+            failures++;
+        }
+    }
+
+    if(golden_dir) {
+        failures += nfc_parser_batch_check_golden(&batch, golden_dir, update);
+    }
+
+    for(size_t i = 0; i < batch.dump_count; i++) {
+        free(batch.dumps[i].path);
+        furi_string_free(batch.dumps[i].output);
+    }
+    free(batch.dumps);
+    free(stats);
+    furi_mutex_free(batch.mutex);
+    free(dump_dir);
+
+    return failures ? 1 : 0;
+}
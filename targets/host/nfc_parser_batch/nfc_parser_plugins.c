@@ -0,0 +1,74 @@
+#include "nfc_parser_plugins.h"
+
+#include <flipper_application/flipper_application.h>
+#include <nfc/protocols/mf_classic/mf_classic_poller_sync.h>
+
+#include <string.h>
+
+/* nfc_parser_plugin_list.h is generated by CMake from applications/main/nfc/application.fam */
+#define NFC_PARSER_PLUGIN(appid, entry_point) const FlipperAppPluginDescriptor* entry_point(void);
+#include <nfc_parser_plugin_list.h>
+#undef NFC_PARSER_PLUGIN
+
+typedef struct {
+    const char* name;
+    FlipperApplicationPluginEntryPoint entry_point;
+} NfcParserPluginEntry;
+
+static const NfcParserPluginEntry nfc_parser_plugin_entries[] = {
+#define NFC_PARSER_PLUGIN(appid, entry_point) {#appid, entry_point},
+#include <nfc_parser_plugin_list.h>
+#undef NFC_PARSER_PLUGIN
+};
+
+size_t nfc_parser_plugins_get_count(void) {
+    return COUNT_OF(nfc_parser_plugin_entries);
+}
+
+NfcParserPlugin nfc_parser_plugins_get(size_t index) {
+    furi_check(index < COUNT_OF(nfc_parser_plugin_entries));
+
+    const NfcParserPluginEntry* entry = &nfc_parser_plugin_entries[index];
+    const FlipperAppPluginDescriptor* descriptor = entry->entry_point();
+
+    furi_check(descriptor);
+    furi_check(strcmp(descriptor->appid, NFC_SUPPORTED_CARD_PLUGIN_APP_ID) == 0);
+    furi_check(descriptor->ep_api_version == NFC_SUPPORTED_CARD_PLUGIN_API_VERSION);
+
+    NfcParserPlugin plugin = {
+        .name = entry->name,
+        .plugin = descriptor->entry_point,
+    };
+
+    return plugin;
+}
+
+/* There is no card on host: verify() and read() of plugins link against these and fail */
+
+MfClassicError mf_classic_poller_sync_auth(
+    Nfc* nfc,
+    uint8_t block_num,
+    MfClassicKey* key,
+    MfClassicKeyType key_type,
+    MfClassicAuthContext* data) {
+    UNUSED(nfc);
+    UNUSED(block_num);
+    UNUSED(key);
+    UNUSED(key_type);
+    UNUSED(data);
+    return MfClassicErrorNotPresent;
+}
+
+MfClassicError mf_classic_poller_sync_detect_type(Nfc* nfc, MfClassicType* type) {
+    UNUSED(nfc);
+    UNUSED(type);
+    return MfClassicErrorNotPresent;
+}
+
+MfClassicError
+    mf_classic_poller_sync_read(Nfc* nfc, const MfClassicDeviceKeys* keys, MfClassicData* data) {
+    UNUSED(nfc);
+    UNUSED(keys);
+    UNUSED(data);
+    return MfClassicErrorNotPresent;
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <applications/main/nfc/plugins/supported_cards/nfc_supported_card_plugin.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Supported card plugin linked into host program */
+typedef struct {
+    const char* name; /**< plugin appid */
+    const NfcSupportedCardsPlugin* plugin;
+} NfcParserPlugin;
+
+/** Get number of linked plugins
+ *
+ * @return     plugin count
+ */
+size_t nfc_parser_plugins_get_count(void);
+
+/** Get linked plugin
+ *
+ * Plugins come in the order of nfc application manifest. Descriptor checks
+ * are the same as in nfc_supported_cards.c, plugin with mismatched appid or
+ * API version crashes the program.
+ *
+ * @param      index  plugin index, less than plugin count
+ *
+ * @return     plugin
+ */
+NfcParserPlugin nfc_parser_plugins_get(size_t index);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,369 @@
+#include <furi.h>
+#include <one_wire/maxim_crc.h>
+#include <one_wire/one_wire_host.h>
+#include <one_wire/one_wire_slave.h>
+#include <ibutton/protocols/dallas/dallas_common.h>
+
+#include "one_wire_sim.h"
+
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define ONE_WIRE_BENCH_ROUNDS (100U)
+#define ONE_WIRE_BENCH_SEARCH_DEVICES (12U)
+#define ONE_WIRE_BENCH_CRC_SIZE (64U * 1024U)
+/* maxim_crc8 size is 8 bit */
+#define ONE_WIRE_BENCH_CRC8_CHUNK (255U)
+#define ONE_WIRE_BENCH_MEMORY_MAX (8192U)
+
+typedef struct {
+    const char* name;
+    uint8_t family_code;
+    size_t memory_size;
+    bool device_overdrive; /**< Simulated device supports overdrive */
+    bool read_overdrive; /**< Key read tries overdrive, as its protocol does */
+} OneWireBenchKey;
+
+static const OneWireBenchKey one_wire_bench_keys[] = {
+    {.name = "DS1990", .family_code = 0x01, .memory_size = 0},
+    {.name = "DS1992", .family_code = 0x08, .memory_size = 128},
+    {.name = "DS1996",
+     .family_code = 0x0C,
+     .memory_size = 8192,
+     .device_overdrive = true,
+     .read_overdrive = true},
+    {.name = "DS1996 no overdrive",
+     .family_code = 0x0C,
+     .memory_size = 8192,
+     .device_overdrive = false,
+     .read_overdrive = true},
+};
+
+static uint32_t one_wire_bench_seed = 0x1D0C5EEDU;
+
+static uint32_t one_wire_bench_random(void) {
+    // xorshift32
+    one_wire_bench_seed ^= one_wire_bench_seed << 13;
+    one_wire_bench_seed ^= one_wire_bench_seed >> 17;
+    one_wire_bench_seed ^= one_wire_bench_seed << 5;
+    return one_wire_bench_seed;
+}
+
+static void one_wire_bench_fill(uint8_t* data, size_t data_size) {
+    for(size_t i = 0; i < data_size; i++) {
+        data[i] = one_wire_bench_random();
+    }
+}
+
+static void one_wire_bench_make_rom(uint8_t* rom, uint8_t family_code) {
+    rom[0] = family_code;
+    one_wire_bench_fill(&rom[1], ONE_WIRE_SIM_ROM_SIZE - 2);
+    rom[ONE_WIRE_SIM_ROM_SIZE - 1] = maxim_crc8(rom, ONE_WIRE_SIM_ROM_SIZE - 1, MAXIM_CRC8_INIT);
+}
+
+static uint64_t one_wire_bench_time_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/* Bitwise CRCs, as maxim_crc8 was before the tables */
+static uint8_t one_wire_bench_crc8(const uint8_t* data, size_t data_size, uint8_t crc) {
+    while(data_size--) {
+        uint8_t inbyte = *data++;
+        for(uint8_t i = 8; i; i--) {
+            uint8_t mix = (crc ^ inbyte) & 0x01;
+            crc >>= 1;
+            if(mix) crc ^= 0x8C;
+            inbyte >>= 1;
+        }
+    }
+    return crc;
+}
+
+static uint16_t one_wire_bench_crc16(const uint8_t* data, size_t data_size, uint16_t crc) {
+    while(data_size--) {
+        crc ^= *data++;
+        for(uint8_t i = 8; i; i--) {
+            crc = (crc & 0x01) ? (crc >> 1) ^ 0xA001 : crc >> 1;
+        }
+    }
+    return crc;
+}
+
+static uint8_t one_wire_bench_crc8_table(const uint8_t* data, size_t data_size, uint8_t crc) {
+    for(size_t i = 0; i < data_size; i += ONE_WIRE_BENCH_CRC8_CHUNK) {
+        crc = maxim_crc8(data + i, MIN(data_size - i, ONE_WIRE_BENCH_CRC8_CHUNK), crc);
+    }
+    return crc;
+}
+
+static bool one_wire_bench_crc(uint32_t rounds) {
+    uint8_t* data = malloc(ONE_WIRE_BENCH_CRC_SIZE);
+    one_wire_bench_fill(data, ONE_WIRE_BENCH_CRC_SIZE);
+    bool success = true;
+
+    // every length and start of a short buffer, then a long one
+    for(size_t offset = 0; offset < 64 && success; offset++) {
+        for(size_t size = 0; size < 64; size++) {
+            if(maxim_crc8(data + offset, size, MAXIM_CRC8_INIT) !=
+                   one_wire_bench_crc8(data + offset, size, MAXIM_CRC8_INIT) ||
+               maxim_crc16(data + offset, size, MAXIM_CRC16_INIT) !=
+                   one_wire_bench_crc16(data + offset, size, MAXIM_CRC16_INIT)) {
+                printf("FAIL crc: offset %zu size %zu differs from bitwise\n", offset, size);
+                success = false;
+                break;
+            }
+        }
+    }
+
+    uint64_t time_ns[4] = {0};
+    uint32_t sink = 0;
+    for(uint32_t i = 0; i < rounds && success; i++) {
+        uint64_t start = one_wire_bench_time_ns();
+        sink += one_wire_bench_crc8_table(data, ONE_WIRE_BENCH_CRC_SIZE, MAXIM_CRC8_INIT);
+        time_ns[0] += one_wire_bench_time_ns() - start;
+
+        start = one_wire_bench_time_ns();
+        sink += one_wire_bench_crc8(data, ONE_WIRE_BENCH_CRC_SIZE, MAXIM_CRC8_INIT);
+        time_ns[1] += one_wire_bench_time_ns() - start;
+
+        start = one_wire_bench_time_ns();
+        sink += maxim_crc16(data, ONE_WIRE_BENCH_CRC_SIZE, MAXIM_CRC16_INIT);
+        time_ns[2] += one_wire_bench_time_ns() - start;
+
+        start = one_wire_bench_time_ns();
+        sink += one_wire_bench_crc16(data, ONE_WIRE_BENCH_CRC_SIZE, MAXIM_CRC16_INIT);
+        time_ns[3] += one_wire_bench_time_ns() - start;
+    }
+
+    if(success) {
+        const double bytes = (double)ONE_WIRE_BENCH_CRC_SIZE * rounds;
+        printf(
+            "crc8: table %.2f ns/byte, bitwise %.2f ns/byte\n"
+            "crc16: table %.2f ns/byte, bitwise %.2f ns/byte (%08x)\n",
+            time_ns[0] / bytes,
+            time_ns[1] / bytes,
+            time_ns[2] / bytes,
+            time_ns[3] / bytes,
+            (unsigned)sink);
+    }
+
+    free(data);
+    return success;
+}
+
+static bool one_wire_bench_key(OneWireSim* sim, const OneWireBenchKey* key, uint32_t rounds) {
+    static uint8_t memory[ONE_WIRE_BENCH_MEMORY_MAX];
+    static uint8_t buffer[ONE_WIRE_BENCH_MEMORY_MAX];
+    uint8_t rom[ONE_WIRE_SIM_ROM_SIZE];
+
+    one_wire_bench_make_rom(rom, key->family_code);
+    one_wire_bench_fill(memory, key->memory_size);
+
+    one_wire_sim_clear(sim);
+    one_wire_sim_add_device(sim, rom, memory, key->memory_size, key->device_overdrive);
+    one_wire_sim_reset_stats(sim);
+
+    OneWireHost* host = onewire_host_alloc_ex(&one_wire_sim_bus, sim);
+    onewire_host_start(host);
+
+    bool success = true;
+    uint64_t time_ns = 0;
+
+    for(uint32_t i = 0; i < rounds; i++) {
+        DallasCommonRomData rom_data;
+        memset(&rom_data, 0, sizeof(rom_data));
+        memset(buffer, 0, key->memory_size);
+
+        const uint64_t start = one_wire_bench_time_ns();
+        const bool read = dallas_common_read_key(
+            host, &rom_data, buffer, key->memory_size, key->read_overdrive);
+        time_ns += one_wire_bench_time_ns() - start;
+
+        if(!read) {
+            printf("FAIL %s: read failed\n", key->name);
+            success = false;
+        } else if(memcmp(rom_data.bytes, rom, ONE_WIRE_SIM_ROM_SIZE) != 0) {
+            printf("FAIL %s: ROM differs\n", key->name);
+            success = false;
+        } else if(memcmp(buffer, memory, key->memory_size) != 0) {
+            printf("FAIL %s: memory differs\n", key->name);
+            success = false;
+        }
+
+        if(!success) break;
+    }
+
+    onewire_host_stop(host);
+    onewire_host_free(host);
+
+    if(success) {
+        const OneWireSimStats* stats = one_wire_sim_get_stats(sim);
+        printf(
+            "%s: %zu bytes, bus %.3f ms, %.1f resets, %.1f slots, %.1f bus calls, "
+            "host %.1f us per read\n",
+            key->name,
+            key->memory_size,
+            stats->time_ns / 1e6 / rounds,
+            (double)stats->resets / rounds,
+            (double)stats->slots / rounds,
+            (double)stats->touches / rounds,
+            time_ns / 1e3 / rounds);
+    }
+
+    return success;
+}
+
+static bool one_wire_bench_search(OneWireSim* sim, uint32_t rounds) {
+    uint8_t roms[ONE_WIRE_BENCH_SEARCH_DEVICES][ONE_WIRE_SIM_ROM_SIZE];
+
+    one_wire_sim_clear(sim);
+    for(size_t i = 0; i < ONE_WIRE_BENCH_SEARCH_DEVICES; i++) {
+        // same family on half of devices, so search goes deep into the serial
+        one_wire_bench_make_rom(roms[i], i % 2 ? 0x01 : one_wire_bench_random());
+        one_wire_sim_add_device(sim, roms[i], NULL, 0, false);
+    }
+    one_wire_sim_reset_stats(sim);
+
+    OneWireHost* host = onewire_host_alloc_ex(&one_wire_sim_bus, sim);
+    onewire_host_start(host);
+
+    bool success = true;
+    for(uint32_t i = 0; i < rounds && success; i++) {
+        bool found[ONE_WIRE_BENCH_SEARCH_DEVICES] = {false};
+        size_t found_count = 0;
+        uint8_t address[ONE_WIRE_SIM_ROM_SIZE];
+
+        onewire_host_reset_search(host);
+        while(onewire_host_search(host, address, OneWireHostSearchModeNormal)) {
+            size_t index = 0;
+            while(index < ONE_WIRE_BENCH_SEARCH_DEVICES &&
+                  memcmp(roms[index], address, ONE_WIRE_SIM_ROM_SIZE) != 0) {
+                index++;
+            }
+
+            if(index == ONE_WIRE_BENCH_SEARCH_DEVICES || found[index]) {
+                printf("FAIL search: unknown or repeated ROM\n");
+                success = false;
+                break;
+            }
+
+            found[index] = true;
+            found_count++;
+        }
+
+        if(success && found_count != ONE_WIRE_BENCH_SEARCH_DEVICES) {
+            printf(
+                "FAIL search: found %zu of %u devices\n",
+                found_count,
+                ONE_WIRE_BENCH_SEARCH_DEVICES);
+            success = false;
+        }
+    }
+
+    onewire_host_stop(host);
+    onewire_host_free(host);
+
+    if(success) {
+        const OneWireSimStats* stats = one_wire_sim_get_stats(sim);
+        printf(
+            "search: %u devices, bus %.3f ms, %.1f bus calls per device\n",
+            ONE_WIRE_BENCH_SEARCH_DEVICES,
+            stats->time_ns / 1e6 / rounds,
+            (double)stats->touches / rounds / ONE_WIRE_BENCH_SEARCH_DEVICES);
+    }
+
+    return success;
+}
+
+/* Keys are only read here, they are never saved, loaded or emulated */
+bool flipper_format_read_hex(
+    FlipperFormat* flipper_format,
+    const char* key,
+    uint8_t* data,
+    const uint16_t data_size) {
+    UNUSED(flipper_format);
+    UNUSED(key);
+    UNUSED(data);
+    UNUSED(data_size);
+    return false;
+}
+
+bool flipper_format_write_hex(
+    FlipperFormat* flipper_format,
+    const char* key,
+    const uint8_t* data,
+    const uint16_t data_size) {
+    UNUSED(flipper_format);
+    UNUSED(key);
+    UNUSED(data);
+    UNUSED(data_size);
+    return false;
+}
+
+bool onewire_slave_receive_bit(OneWireSlave* bus) {
+    UNUSED(bus);
+    return false;
+}
+
+bool onewire_slave_send_bit(OneWireSlave* bus, bool value) {
+    UNUSED(bus);
+    UNUSED(value);
+    return false;
+}
+
+bool onewire_slave_send(OneWireSlave* bus, const uint8_t* data, size_t data_size) {
+    UNUSED(bus);
+    UNUSED(data);
+    UNUSED(data_size);
+    return false;
+}
+
+bool onewire_slave_receive(OneWireSlave* bus, uint8_t* data, size_t data_size) {
+    UNUSED(bus);
+    UNUSED(data);
+    UNUSED(data_size);
+    return false;
+}
+
+static void one_wire_bench_usage(const char* name) {
+    printf("Usage: %s [-r rounds]\n", name);
+}
+
+int main(int argc, char** argv) {
+    uint32_t rounds = ONE_WIRE_BENCH_ROUNDS;
+
+    int option;
+    while((option = getopt(argc, argv, "r:h")) != -1) {
+        switch(option) {
+        case 'r':
+            rounds = strtoul(optarg, NULL, 10);
+            break;
+        default:
+            one_wire_bench_usage(argv[0]);
+            return 2;
+        }
+    }
+
+    if(optind != argc || rounds == 0) {
+        one_wire_bench_usage(argv[0]);
+        return 2;
+    }
+
+    furi_init();
+
+    bool success = one_wire_bench_crc(rounds);
+
+    OneWireSim* sim = one_wire_sim_alloc();
+    for(size_t i = 0; i < COUNT_OF(one_wire_bench_keys); i++) {
+        success &= one_wire_bench_key(sim, &one_wire_bench_keys[i], rounds);
+    }
+    success &= one_wire_bench_search(sim, rounds);
+    one_wire_sim_free(sim);
+
+    return success ? 0 : 1;
+}
@@ -0,0 +1,299 @@
+#include "one_wire_sim.h"
+
+#include <furi.h>
+
+#define ONE_WIRE_SIM_DEVICES_MAX 16U
+
+#define ONE_WIRE_SIM_CMD_READ_ROM 0x33U
+#define ONE_WIRE_SIM_CMD_MATCH_ROM 0x55U
+#define ONE_WIRE_SIM_CMD_SKIP_ROM 0xCCU
+#define ONE_WIRE_SIM_CMD_SEARCH_ROM 0xF0U
+#define ONE_WIRE_SIM_CMD_OVERDRIVE_SKIP_ROM 0x3CU
+#define ONE_WIRE_SIM_CMD_OVERDRIVE_MATCH_ROM 0x69U
+#define ONE_WIRE_SIM_CMD_READ_MEM 0xF0U
+
+#define BITS_IN_BYTE 8U
+#define ONE_WIRE_SIM_ROM_BITS (ONE_WIRE_SIM_ROM_SIZE * BITS_IN_BYTE)
+
+/* Time of reset, read or write 1 slot and write 0 slot as one_wire_host.c does them, us */
+typedef struct {
+    uint32_t reset;
+    uint32_t slot_1;
+    uint32_t slot_0;
+} OneWireSimTimings;
+
+static const OneWireSimTimings one_wire_sim_timings[] = {
+    {.reset = 0 + 480 + 70 + 410, .slot_1 = 9 + 9 + 55, .slot_0 = 64 + 14},
+    {.reset = 3 + 70 + 9 + 40, .slot_1 = 1 + 1 + 7, .slot_0 = 8 + 3},
+};
+
+typedef enum {
+    OneWireSimStateIdle, /**< Waits for reset */
+    OneWireSimStateRomCommand,
+    OneWireSimStateReadRom,
+    OneWireSimStateMatchRom,
+    OneWireSimStateSearch,
+    OneWireSimStateFunctionCommand,
+    OneWireSimStateAddress,
+    OneWireSimStateReadMemory,
+} OneWireSimState;
+
+typedef struct {
+    uint8_t rom[ONE_WIRE_SIM_ROM_SIZE];
+    uint8_t* memory;
+    size_t memory_size;
+    bool overdrive_capable;
+    bool overdrive;
+
+    OneWireSimState state;
+    uint32_t shift;
+    size_t bit;
+    uint8_t search_step; /**< Sends bit, sends complement, receives direction */
+    size_t address;
+} OneWireSimDevice;
+
+struct OneWireSim {
+    OneWireSimDevice devices[ONE_WIRE_SIM_DEVICES_MAX];
+    size_t count;
+    OneWireSimStats stats;
+};
+
+OneWireSim* one_wire_sim_alloc(void) {
+    OneWireSim* sim = malloc(sizeof(OneWireSim));
+    sim->count = 0;
+    one_wire_sim_reset_stats(sim);
+    return sim;
+}
+
+void one_wire_sim_free(OneWireSim* sim) {
+    one_wire_sim_clear(sim);
+    free(sim);
+}
+
+void one_wire_sim_add_device(
+    OneWireSim* sim,
+    const uint8_t* rom,
+    const uint8_t* memory,
+    size_t memory_size,
+    bool overdrive) {
+    furi_check(sim->count < ONE_WIRE_SIM_DEVICES_MAX);
+
+    OneWireSimDevice* device = &sim->devices[sim->count++];
+    memcpy(device->rom, rom, ONE_WIRE_SIM_ROM_SIZE);
+    device->memory = memory_size ? malloc(memory_size) : NULL;
+    if(memory_size) memcpy(device->memory, memory, memory_size);
+    device->memory_size = memory_size;
+    device->overdrive_capable = overdrive;
+    device->overdrive = false;
+    device->state = OneWireSimStateIdle;
+}
+
+void one_wire_sim_clear(OneWireSim* sim) {
+    for(size_t i = 0; i < sim->count; i++) {
+        free(sim->devices[i].memory);
+    }
+    sim->count = 0;
+}
+
+const OneWireSimStats* one_wire_sim_get_stats(OneWireSim* sim) {
+    return &sim->stats;
+}
+
+void one_wire_sim_reset_stats(OneWireSim* sim) {
+    memset(&sim->stats, 0, sizeof(OneWireSimStats));
+}
+
+static bool one_wire_sim_get_bit(const uint8_t* data, size_t bit) {
+    return (data[bit / BITS_IN_BYTE] >> (bit % BITS_IN_BYTE)) & 1U;
+}
+
+static void one_wire_sim_set_state(OneWireSimDevice* device, OneWireSimState state) {
+    device->state = state;
+    device->shift = 0;
+    device->bit = 0;
+    device->search_step = 0;
+}
+
+static bool one_wire_sim_device_output(OneWireSimDevice* device) {
+    switch(device->state) {
+    case OneWireSimStateReadRom:
+        return one_wire_sim_get_bit(device->rom, device->bit);
+    case OneWireSimStateSearch:
+        if(device->search_step == 2) return true;
+        return one_wire_sim_get_bit(device->rom, device->bit) ^ (device->search_step == 1);
+    case OneWireSimStateReadMemory:
+        if(device->address >= device->memory_size) return true;
+        return one_wire_sim_get_bit(
+            device->memory, device->address * BITS_IN_BYTE + device->bit);
+    default:
+        return true;
+    }
+}
+
+static void one_wire_sim_device_rom_command(OneWireSimDevice* device, uint8_t command) {
+    switch(command) {
+    case ONE_WIRE_SIM_CMD_READ_ROM:
+        one_wire_sim_set_state(device, OneWireSimStateReadRom);
+        break;
+    case ONE_WIRE_SIM_CMD_SKIP_ROM:
+        one_wire_sim_set_state(device, OneWireSimStateFunctionCommand);
+        break;
+    case ONE_WIRE_SIM_CMD_MATCH_ROM:
+        one_wire_sim_set_state(device, OneWireSimStateMatchRom);
+        break;
+    case ONE_WIRE_SIM_CMD_SEARCH_ROM:
+        one_wire_sim_set_state(device, OneWireSimStateSearch);
+        break;
+    case ONE_WIRE_SIM_CMD_OVERDRIVE_SKIP_ROM:
+    case ONE_WIRE_SIM_CMD_OVERDRIVE_MATCH_ROM:
+        if(device->overdrive_capable) {
+            device->overdrive = true;
+            one_wire_sim_set_state(
+                device,
+                command == ONE_WIRE_SIM_CMD_OVERDRIVE_SKIP_ROM ? OneWireSimStateFunctionCommand :
+                                                                  OneWireSimStateMatchRom);
+        } else {
+            one_wire_sim_set_state(device, OneWireSimStateIdle);
+        }
+        break;
+    default:
+        one_wire_sim_set_state(device, OneWireSimStateIdle);
+        break;
+    }
+}
+
+static void one_wire_sim_device_input(OneWireSimDevice* device, bool value) {
+    switch(device->state) {
+    case OneWireSimStateRomCommand:
+    case OneWireSimStateFunctionCommand:
+    case OneWireSimStateAddress:
+        device->shift |= (uint32_t)value << device->bit++;
+        if(device->state == OneWireSimStateRomCommand && device->bit == BITS_IN_BYTE) {
+            one_wire_sim_device_rom_command(device, device->shift);
+        } else if(device->state == OneWireSimStateFunctionCommand && device->bit == BITS_IN_BYTE) {
+            one_wire_sim_set_state(
+                device,
+                device->shift == ONE_WIRE_SIM_CMD_READ_MEM ? OneWireSimStateAddress :
+                                                             OneWireSimStateIdle);
+        } else if(device->state == OneWireSimStateAddress && device->bit == 2 * BITS_IN_BYTE) {
+            device->address = device->shift;
+            one_wire_sim_set_state(device, OneWireSimStateReadMemory);
+        }
+        break;
+
+    case OneWireSimStateReadRom:
+        if(++device->bit == ONE_WIRE_SIM_ROM_BITS) {
+            one_wire_sim_set_state(device, OneWireSimStateFunctionCommand);
+        }
+        break;
+
+    case OneWireSimStateMatchRom:
+    case OneWireSimStateSearch:
+        if(device->state == OneWireSimStateSearch && device->search_step < 2) {
+            device->search_step++;
+            break;
+        }
+        // device that lost the bit waits for reset
+        if(value != one_wire_sim_get_bit(device->rom, device->bit)) {
+            one_wire_sim_set_state(device, OneWireSimStateIdle);
+        } else if(++device->bit == ONE_WIRE_SIM_ROM_BITS) {
+            one_wire_sim_set_state(device, OneWireSimStateFunctionCommand);
+        } else {
+            device->search_step = 0;
+        }
+        break;
+
+    case OneWireSimStateReadMemory:
+        if(++device->bit == BITS_IN_BYTE) {
+            device->bit = 0;
+            device->address++;
+        }
+        break;
+
+    default:
+        break;
+    }
+}
+
+static void one_wire_sim_start(void* context) {
+    UNUSED(context);
+}
+
+static void one_wire_sim_stop(void* context) {
+    UNUSED(context);
+}
+
+static bool one_wire_sim_reset(void* context, bool overdrive) {
+    OneWireSim* sim = context;
+    bool presence = false;
+
+    for(size_t i = 0; i < sim->count; i++) {
+        OneWireSimDevice* device = &sim->devices[i];
+        // standard reset brings every device back to standard speed,
+        // short one is only seen by devices at overdrive speed
+        if(!overdrive) device->overdrive = false;
+
+        if(device->overdrive == overdrive) {
+            one_wire_sim_set_state(device, OneWireSimStateRomCommand);
+            presence = true;
+        } else {
+            one_wire_sim_set_state(device, OneWireSimStateIdle);
+        }
+    }
+
+    sim->stats.resets++;
+    sim->stats.time_ns += one_wire_sim_timings[overdrive].reset * 1000ULL;
+    return presence;
+}
+
+static void one_wire_sim_touch(
+    void* context,
+    bool overdrive,
+    const uint8_t* tx,
+    uint8_t* rx,
+    size_t bit_count) {
+    OneWireSim* sim = context;
+
+    for(size_t i = 0; i < bit_count; i++) {
+        const bool host_value = tx ? one_wire_sim_get_bit(tx, i) : true;
+        bool value = host_value;
+
+        // devices at other speed don't see the slot and lose sync
+        for(size_t j = 0; j < sim->count; j++) {
+            OneWireSimDevice* device = &sim->devices[j];
+            if(device->state == OneWireSimStateIdle) continue;
+            if(device->overdrive != overdrive) {
+                one_wire_sim_set_state(device, OneWireSimStateIdle);
+                continue;
+            }
+            value &= one_wire_sim_device_output(device);
+        }
+
+        for(size_t j = 0; j < sim->count; j++) {
+            one_wire_sim_device_input(&sim->devices[j], value);
+        }
+
+        if(rx) {
+            const uint8_t mask = 1U << (i % BITS_IN_BYTE);
+            if(value) {
+                rx[i / BITS_IN_BYTE] |= mask;
+            } else {
+                rx[i / BITS_IN_BYTE] &= ~mask;
+            }
+        }
+
+        sim->stats.time_ns += (host_value ? one_wire_sim_timings[overdrive].slot_1 :
+                                            one_wire_sim_timings[overdrive].slot_0) *
+                              1000ULL;
+    }
+
+    sim->stats.slots += bit_count;
+    sim->stats.touches++;
+}
+
+const OneWireHostBus one_wire_sim_bus = {
+    .start = one_wire_sim_start,
+    .stop = one_wire_sim_stop,
+    .reset = one_wire_sim_reset,
+    .touch = one_wire_sim_touch,
+};
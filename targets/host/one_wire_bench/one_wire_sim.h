@@ -0,0 +1,58 @@
+/**
+ * @file one_wire_sim.h
+ *
+ * Simulated 1-Wire bus with memory devices, OneWireHostBus implementation
+ * for host tests. Devices answer ROM commands, search, overdrive and Read
+ * Memory with 16 bit address; bus time is counted with AN126 timings.
+ */
+
+#pragma once
+#include <one_wire/one_wire_host.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ONE_WIRE_SIM_ROM_SIZE 8U
+
+typedef struct OneWireSim OneWireSim;
+
+typedef struct {
+    uint64_t resets;
+    uint64_t slots;
+    uint64_t touches; /**< Bus calls that ran time slots */
+    uint64_t time_ns; /**< Simulated bus time */
+} OneWireSimStats;
+
+/** OneWireHostBus of the simulated bus, context is OneWireSim */
+extern const OneWireHostBus one_wire_sim_bus;
+
+OneWireSim* one_wire_sim_alloc(void);
+
+void one_wire_sim_free(OneWireSim* sim);
+
+/**
+ * Connect device to the bus
+ * @param [in] sim pointer to OneWireSim instance
+ * @param [in] rom ROM of the device, CRC is not checked
+ * @param [in] memory memory of the device, copied, can be NULL if memory_size is 0
+ * @param [in] memory_size memory size
+ * @param [in] overdrive device supports overdrive speed
+ */
+void one_wire_sim_add_device(
+    OneWireSim* sim,
+    const uint8_t* rom,
+    const uint8_t* memory,
+    size_t memory_size,
+    bool overdrive);
+
+/** Disconnect all devices */
+void one_wire_sim_clear(OneWireSim* sim);
+
+const OneWireSimStats* one_wire_sim_get_stats(OneWireSim* sim);
+
+void one_wire_sim_reset_stats(OneWireSim* sim);
+
+#ifdef __cplusplus
+}
+#endif
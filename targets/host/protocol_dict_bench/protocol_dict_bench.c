@@ -0,0 +1,441 @@
+#include <furi.h>
+#include <storage/storage.h>
+#include <storage_host.h>
+#include <toolbox/protocols/protocol_dict.h>
+#include <lfrfid/protocols/lfrfid_protocols.h>
+#include <lfrfid/tools/varint_pair.h>
+
+#include <errno.h>
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define TAG "ProtocolDictBench"
+
+/* Same as raw file */
+#define PROTOCOL_DICT_BENCH_RAW_MAGIC 0x4C464952
+#define PROTOCOL_DICT_BENCH_RAW_VERSION 1
+
+#define PROTOCOL_DICT_BENCH_ROUNDS (10U)
+#define PROTOCOL_DICT_BENCH_PROTOCOLS_MAX (32U)
+
+_Static_assert(LFRFIDProtocolMax <= PROTOCOL_DICT_BENCH_PROTOCOLS_MAX, "too many protocols");
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    float frequency;
+    float duty_cycle;
+    uint32_t max_buffer_size;
+} ProtocolDictBenchRawHeader;
+
+typedef struct {
+    bool* level;
+    uint32_t* duration;
+    size_t count;
+} ProtocolDictBenchCapture;
+
+typedef enum {
+    ProtocolDictBenchModeAll,
+    ProtocolDictBenchModeActive,
+    ProtocolDictBenchModeCount,
+} ProtocolDictBenchMode;
+
+typedef struct {
+    uint64_t edges;
+    uint64_t decodes;
+    uint64_t feeds[PROTOCOL_DICT_BENCH_PROTOCOLS_MAX];
+    uint64_t states[PROTOCOL_DICT_BENCH_PROTOCOLS_MAX];
+    uint64_t total_ns;
+} ProtocolDictBenchStats;
+
+static const char* protocol_dict_bench_mode_names[ProtocolDictBenchModeCount] = {
+    [ProtocolDictBenchModeAll] = "all",
+    [ProtocolDictBenchModeActive] = "active",
+};
+
+/* Protocol copies that count decoder calls, mode without activity report feeds every decoder */
+static ProtocolBase protocol_dict_bench_base[ProtocolDictBenchModeCount][LFRFIDProtocolMax];
+static const ProtocolBase* protocol_dict_bench_protocols[ProtocolDictBenchModeCount]
+                                                       [LFRFIDProtocolMax];
+static ProtocolDictBenchStats* protocol_dict_bench_stats = NULL;
+
+#define PROTOCOL_DICT_BENCH_PROBE(n)                                                         \
+    static bool protocol_dict_bench_feed_##n(void* protocol, bool level, uint32_t duration) { \
+        protocol_dict_bench_stats->feeds[n]++;                                               \
+        return lfrfid_protocols[n]->decoder.feed(protocol, level, duration);                 \
+    }                                                                                        \
+    static ProtocolDecoderState protocol_dict_bench_get_state_##n(void* protocol) {          \
+        protocol_dict_bench_stats->states[n]++;                                              \
+        return lfrfid_protocols[n]->decoder_activity.get_state(protocol);                    \
+    }
+
+PROTOCOL_DICT_BENCH_PROBE(0)
+PROTOCOL_DICT_BENCH_PROBE(1)
+PROTOCOL_DICT_BENCH_PROBE(2)
+PROTOCOL_DICT_BENCH_PROBE(3)
+PROTOCOL_DICT_BENCH_PROBE(4)
+PROTOCOL_DICT_BENCH_PROBE(5)
+PROTOCOL_DICT_BENCH_PROBE(6)
+PROTOCOL_DICT_BENCH_PROBE(7)
+PROTOCOL_DICT_BENCH_PROBE(8)
+PROTOCOL_DICT_BENCH_PROBE(9)
+PROTOCOL_DICT_BENCH_PROBE(10)
+PROTOCOL_DICT_BENCH_PROBE(11)
+PROTOCOL_DICT_BENCH_PROBE(12)
+PROTOCOL_DICT_BENCH_PROBE(13)
+PROTOCOL_DICT_BENCH_PROBE(14)
+PROTOCOL_DICT_BENCH_PROBE(15)
+PROTOCOL_DICT_BENCH_PROBE(16)
+PROTOCOL_DICT_BENCH_PROBE(17)
+PROTOCOL_DICT_BENCH_PROBE(18)
+PROTOCOL_DICT_BENCH_PROBE(19)
+PROTOCOL_DICT_BENCH_PROBE(20)
+PROTOCOL_DICT_BENCH_PROBE(21)
+PROTOCOL_DICT_BENCH_PROBE(22)
+PROTOCOL_DICT_BENCH_PROBE(23)
+PROTOCOL_DICT_BENCH_PROBE(24)
+PROTOCOL_DICT_BENCH_PROBE(25)
+PROTOCOL_DICT_BENCH_PROBE(26)
+PROTOCOL_DICT_BENCH_PROBE(27)
+PROTOCOL_DICT_BENCH_PROBE(28)
+PROTOCOL_DICT_BENCH_PROBE(29)
+PROTOCOL_DICT_BENCH_PROBE(30)
+PROTOCOL_DICT_BENCH_PROBE(31)
+
+#define PROTOCOL_DICT_BENCH_PROBE_ENTRY(n) \
+    {protocol_dict_bench_feed_##n, protocol_dict_bench_get_state_##n}
+
+static const struct {
+    ProtocolDecoderFeed feed;
+    ProtocolDecoderGetState get_state;
+} protocol_dict_bench_probes[PROTOCOL_DICT_BENCH_PROTOCOLS_MAX] = {
+    PROTOCOL_DICT_BENCH_PROBE_ENTRY(0),  PROTOCOL_DICT_BENCH_PROBE_ENTRY(1),
+    PROTOCOL_DICT_BENCH_PROBE_ENTRY(2),  PROTOCOL_DICT_BENCH_PROBE_ENTRY(3),
+    PROTOCOL_DICT_BENCH_PROBE_ENTRY(4),  PROTOCOL_DICT_BENCH_PROBE_ENTRY(5),
+    PROTOCOL_DICT_BENCH_PROBE_ENTRY(6),  PROTOCOL_DICT_BENCH_PROBE_ENTRY(7),
+    PROTOCOL_DICT_BENCH_PROBE_ENTRY(8),  PROTOCOL_DICT_BENCH_PROBE_ENTRY(9),
+    PROTOCOL_DICT_BENCH_PROBE_ENTRY(10), PROTOCOL_DICT_BENCH_PROBE_ENTRY(11),
+    PROTOCOL_DICT_BENCH_PROBE_ENTRY(12), PROTOCOL_DICT_BENCH_PROBE_ENTRY(13),
+    PROTOCOL_DICT_BENCH_PROBE_ENTRY(14), PROTOCOL_DICT_BENCH_PROBE_ENTRY(15),
+    PROTOCOL_DICT_BENCH_PROBE_ENTRY(16), PROTOCOL_DICT_BENCH_PROBE_ENTRY(17),
+    PROTOCOL_DICT_BENCH_PROBE_ENTRY(18), PROTOCOL_DICT_BENCH_PROBE_ENTRY(19),
+    PROTOCOL_DICT_BENCH_PROBE_ENTRY(20), PROTOCOL_DICT_BENCH_PROBE_ENTRY(21),
+    PROTOCOL_DICT_BENCH_PROBE_ENTRY(22), PROTOCOL_DICT_BENCH_PROBE_ENTRY(23),
+    PROTOCOL_DICT_BENCH_PROBE_ENTRY(24), PROTOCOL_DICT_BENCH_PROBE_ENTRY(25),
+    PROTOCOL_DICT_BENCH_PROBE_ENTRY(26), PROTOCOL_DICT_BENCH_PROBE_ENTRY(27),
+    PROTOCOL_DICT_BENCH_PROBE_ENTRY(28), PROTOCOL_DICT_BENCH_PROBE_ENTRY(29),
+    PROTOCOL_DICT_BENCH_PROBE_ENTRY(30), PROTOCOL_DICT_BENCH_PROBE_ENTRY(31),
+};
+
+static void protocol_dict_bench_protocols_init(void) {
+    for(size_t mode = 0; mode < ProtocolDictBenchModeCount; mode++) {
+        for(size_t i = 0; i < LFRFIDProtocolMax; i++) {
+            ProtocolBase* base = &protocol_dict_bench_base[mode][i];
+            // ProtocolBase has const fields, copy it as is
+            memcpy(base, lfrfid_protocols[i], sizeof(ProtocolBase));
+
+            base->decoder.feed = protocol_dict_bench_probes[i].feed;
+            if(mode == ProtocolDictBenchModeAll || !base->decoder_activity.get_state) {
+                memset(&base->decoder_activity, 0, sizeof(ProtocolDecoderActivity));
+            } else {
+                base->decoder_activity.get_state = protocol_dict_bench_probes[i].get_state;
+            }
+            protocol_dict_bench_protocols[mode][i] = base;
+        }
+    }
+}
+
+static uint64_t protocol_dict_bench_time_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/* Raw files are written on device with 32 bit size_t, parse them without lfrfid_raw_file */
+static bool protocol_dict_bench_capture_load(ProtocolDictBenchCapture* capture, const char* path) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* file = storage_file_alloc(storage);
+    FuriString* storage_path = furi_string_alloc_printf(STORAGE_EXT_PATH_PREFIX "%s", path);
+    bool success = false;
+    uint8_t* buffer = NULL;
+
+    memset(capture, 0, sizeof(ProtocolDictBenchCapture));
+
+    do {
+        const char* file_path = furi_string_get_cstr(storage_path);
+        if(!storage_file_open(file, file_path, FSAM_READ, FSOM_OPEN_EXISTING)) break;
+
+        ProtocolDictBenchRawHeader header;
+        if(storage_file_read(file, &header, sizeof(header)) != sizeof(header)) break;
+        if(header.magic != PROTOCOL_DICT_BENCH_RAW_MAGIC ||
+           header.version != PROTOCOL_DICT_BENCH_RAW_VERSION) {
+            break;
+        }
+
+        buffer = malloc(header.max_buffer_size);
+        size_t capacity = 0;
+
+        success = true;
+        while(success && !storage_file_eof(file)) {
+            uint32_t size = 0;
+            if(storage_file_read(file, &size, sizeof(size)) != sizeof(size)) break;
+            if(size > header.max_buffer_size ||
+               storage_file_read(file, buffer, size) != size) {
+                success = false;
+                break;
+            }
+
+            size_t index = 0;
+            while(index < size) {
+                uint32_t pulse, duration;
+                size_t pair_size;
+                if(!varint_pair_unpack(
+                       &buffer[index], size - index, &pulse, &duration, &pair_size) ||
+                   pulse > duration) {
+                    success = false;
+                    break;
+                }
+                index += pair_size;
+
+                // every pair is a high and a low edge, as lfrfid cli feeds them
+                if(capture->count + 2 > capacity) {
+                    capacity = MAX(capacity * 2, 1024U);
+                    capture->level = realloc(capture->level, capacity * sizeof(bool));
+                    capture->duration = realloc(capture->duration, capacity * sizeof(uint32_t));
+                }
+                capture->level[capture->count] = true;
+                capture->duration[capture->count] = pulse;
+                capture->level[capture->count + 1] = false;
+                capture->duration[capture->count + 1] = duration - pulse;
+                capture->count += 2;
+            }
+        }
+    } while(false);
+
+    free(buffer);
+    storage_file_free(file);
+    furi_string_free(storage_path);
+    furi_record_close(RECORD_STORAGE);
+    return success;
+}
+
+static void protocol_dict_bench_capture_free(ProtocolDictBenchCapture* capture) {
+    free(capture->level);
+    free(capture->duration);
+}
+
+/* Both dispatch modes get the same edges and must decode the same data on the same edge */
+static bool protocol_dict_bench_check(
+    ProtocolDictBenchCapture* capture,
+    ProtocolDictBenchStats* stats,
+    const char* path) {
+    ProtocolDict* dict[ProtocolDictBenchModeCount];
+    uint8_t* data[ProtocolDictBenchModeCount];
+    size_t data_size = 0;
+
+    for(size_t mode = 0; mode < ProtocolDictBenchModeCount; mode++) {
+        dict[mode] = protocol_dict_alloc(protocol_dict_bench_protocols[mode], LFRFIDProtocolMax);
+        data_size = protocol_dict_get_max_data_size(dict[mode]);
+        data[mode] = malloc(data_size);
+
+        // some decoders keep bits they don't decode, start from the same data
+        memset(data[mode], 0, data_size);
+        for(size_t i = 0; i < LFRFIDProtocolMax; i++) {
+            protocol_dict_set_data(dict[mode], i, data[mode], data_size);
+        }
+        protocol_dict_decoders_start(dict[mode]);
+    }
+
+    bool success = true;
+    for(size_t i = 0; success && i < capture->count; i++) {
+        ProtocolId protocol[ProtocolDictBenchModeCount];
+        for(size_t mode = 0; mode < ProtocolDictBenchModeCount; mode++) {
+            protocol_dict_bench_stats = &stats[mode];
+            protocol[mode] =
+                protocol_dict_decoders_feed(dict[mode], capture->level[i], capture->duration[i]);
+            stats[mode].edges++;
+
+            if(protocol[mode] != PROTOCOL_NO) {
+                stats[mode].decodes++;
+                protocol_dict_get_data(dict[mode], protocol[mode], data[mode], data_size);
+            }
+        }
+
+        if(protocol[ProtocolDictBenchModeAll] != protocol[ProtocolDictBenchModeActive]) {
+            printf(
+                "FAIL %s: edge %zu decoded as %ld by all, %ld by active\n",
+                path,
+                i,
+                (long)protocol[ProtocolDictBenchModeAll],
+                (long)protocol[ProtocolDictBenchModeActive]);
+            success = false;
+        } else if(
+            protocol[ProtocolDictBenchModeAll] != PROTOCOL_NO &&
+            memcmp(
+                data[ProtocolDictBenchModeAll],
+                data[ProtocolDictBenchModeActive],
+                protocol_dict_get_data_size(dict[0], protocol[ProtocolDictBenchModeAll])) != 0) {
+            printf("FAIL %s: edge %zu decoded data differs\n", path, i);
+            success = false;
+        }
+    }
+
+    for(size_t mode = 0; mode < ProtocolDictBenchModeCount; mode++) {
+        free(data[mode]);
+        protocol_dict_free(dict[mode]);
+    }
+    return success;
+}
+
+static void protocol_dict_bench_time(
+    ProtocolDictBenchCapture* capture,
+    ProtocolDictBenchStats* stats,
+    uint32_t rounds) {
+    // counters of timing rounds are dropped
+    static ProtocolDictBenchStats scratch;
+    protocol_dict_bench_stats = &scratch;
+
+    for(size_t mode = 0; mode < ProtocolDictBenchModeCount; mode++) {
+        ProtocolDict* dict =
+            protocol_dict_alloc(protocol_dict_bench_protocols[mode], LFRFIDProtocolMax);
+        protocol_dict_decoders_start(dict);
+
+        uint64_t start = protocol_dict_bench_time_ns();
+        for(uint32_t round = 0; round < rounds; round++) {
+            for(size_t i = 0; i < capture->count; i++) {
+                protocol_dict_decoders_feed(dict, capture->level[i], capture->duration[i]);
+            }
+        }
+        stats[mode].total_ns += (protocol_dict_bench_time_ns() - start) / rounds;
+
+        protocol_dict_free(dict);
+    }
+}
+
+static uint64_t protocol_dict_bench_sum(const uint64_t* counters) {
+    uint64_t sum = 0;
+    for(size_t i = 0; i < LFRFIDProtocolMax; i++) {
+        sum += counters[i];
+    }
+    return sum;
+}
+
+static void protocol_dict_bench_print(const char* name, const ProtocolDictBenchStats* stats) {
+    printf("%s:", name);
+    for(size_t mode = 0; mode < ProtocolDictBenchModeCount; mode++) {
+        const ProtocolDictBenchStats* mode_stats = &stats[mode];
+        double edges = mode_stats->edges ? mode_stats->edges : 1;
+        printf(
+            " %s %.2f feeds/edge %.2f states/edge %.1f ns/edge%s",
+            protocol_dict_bench_mode_names[mode],
+            protocol_dict_bench_sum(mode_stats->feeds) / edges,
+            protocol_dict_bench_sum(mode_stats->states) / edges,
+            mode_stats->total_ns / edges,
+            (mode + 1 < ProtocolDictBenchModeCount) ? "," : "");
+    }
+    printf(
+        ", %llu edges, %llu decodes\n",
+        (unsigned long long)stats[0].edges,
+        (unsigned long long)stats[0].decodes);
+}
+
+static void protocol_dict_bench_print_protocols(const ProtocolDictBenchStats* stats) {
+    const ProtocolDictBenchStats* active = &stats[ProtocolDictBenchModeActive];
+    double edges = active->edges ? active->edges : 1;
+
+    for(size_t i = 0; i < LFRFIDProtocolMax; i++) {
+        printf(
+            "  %-16s fed on %5.1f%% of edges\n",
+            lfrfid_protocols[i]->name,
+            active->feeds[i] * 100.0 / edges);
+    }
+}
+
+static void
+    protocol_dict_bench_merge(ProtocolDictBenchStats* total, ProtocolDictBenchStats* stats) {
+    for(size_t mode = 0; mode < ProtocolDictBenchModeCount; mode++) {
+        total[mode].edges += stats[mode].edges;
+        total[mode].decodes += stats[mode].decodes;
+        total[mode].total_ns += stats[mode].total_ns;
+        for(size_t i = 0; i < LFRFIDProtocolMax; i++) {
+            total[mode].feeds[i] += stats[mode].feeds[i];
+            total[mode].states[i] += stats[mode].states[i];
+        }
+    }
+}
+
+static void protocol_dict_bench_usage(const char* name) {
+    printf("Usage: %s [-r rounds] [-v] capture.raw...\n", name);
+}
+
+int main(int argc, char** argv) {
+    uint32_t rounds = PROTOCOL_DICT_BENCH_ROUNDS;
+    bool verbose = false;
+
+    int option;
+    while((option = getopt(argc, argv, "r:vh")) != -1) {
+        switch(option) {
+        case 'r':
+            rounds = strtoul(optarg, NULL, 10);
+            break;
+        case 'v':
+            verbose = true;
+            break;
+        default:
+            protocol_dict_bench_usage(argv[0]);
+            return 2;
+        }
+    }
+
+    if(optind == argc || !rounds) {
+        protocol_dict_bench_usage(argv[0]);
+        return 2;
+    }
+
+    furi_init();
+    // Storage root is the file system root, host paths are opened under /ext
+    storage_host_record_create("/");
+    protocol_dict_bench_protocols_init();
+
+    ProtocolDictBenchStats total[ProtocolDictBenchModeCount];
+    memset(total, 0, sizeof(total));
+    size_t failures = 0;
+
+    for(int i = optind; i < argc; i++) {
+        char* path = realpath(argv[i], NULL);
+        ProtocolDictBenchCapture capture;
+
+        if(!path) {
+            printf("FAIL %s: %s\n", argv[i], strerror(errno));
+            failures++;
+            continue;
+        }
+
+        if(!protocol_dict_bench_capture_load(&capture, path)) {
+            printf("FAIL %s: broken capture\n", argv[i]);
+            failures++;
+        } else {
+            ProtocolDictBenchStats stats[ProtocolDictBenchModeCount];
+            memset(stats, 0, sizeof(stats));
+
+            if(!protocol_dict_bench_check(&capture, stats, argv[i])) failures++;
+            protocol_dict_bench_time(&capture, stats, rounds);
+
+            protocol_dict_bench_print(argv[i], stats);
+            if(verbose) protocol_dict_bench_print_protocols(stats);
+            protocol_dict_bench_merge(total, stats);
+        }
+
+        protocol_dict_bench_capture_free(&capture);
+        free(path);
+    }
+
+    protocol_dict_bench_print("Total", total);
+    if(verbose) protocol_dict_bench_print_protocols(total);
+
+    if(failures) printf("%zu failures\n", failures);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,466 @@
+#include "storage_host.h"
+
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <strings.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/statvfs.h>
+
+#define TAG "StorageHost"
+
+typedef struct {
+    char* root;
+} HostData;
+
+typedef struct {
+    int fd;
+    bool writable;
+} HostFile;
+
+typedef struct {
+    DIR* dir;
+} HostDir;
+
+static FS_Error storage_host_parse_error(int error) {
+    FS_Error result;
+    switch(error) {
+    case 0:
+        result = FSE_OK;
+        break;
+    case ENOENT:
+    case ENOTDIR:
+        result = FSE_NOT_EXIST;
+        break;
+    case EEXIST:
+        result = FSE_EXIST;
+        break;
+    case ENAMETOOLONG:
+        result = FSE_INVALID_NAME;
+        break;
+    case EINVAL:
+    case EBADF:
+        result = FSE_INVALID_PARAMETER;
+        break;
+    case EACCES:
+    case EPERM:
+    case EISDIR:
+    case ENOTEMPTY:
+    case EROFS:
+        result = FSE_DENIED;
+        break;
+    default:
+        result = FSE_INTERNAL;
+        break;
+    }
+
+    return result;
+}
+
+/* Append path component matching name without case, like FatFs does */
+static void storage_host_path_append(FuriString* host_path, const char* name, size_t name_len) {
+    const size_t dir_len = furi_string_size(host_path);
+    furi_string_cat_printf(host_path, "/%.*s", (int)name_len, name);
+
+    struct stat st;
+    if(stat(furi_string_get_cstr(host_path), &st) == 0) return;
+
+    furi_string_left(host_path, dir_len);
+    DIR* dir = opendir(furi_string_get_cstr(host_path));
+    const char* match = NULL;
+    struct dirent* entry;
+    while(dir && (entry = readdir(dir)) != NULL) {
+        if(strlen(entry->d_name) == name_len &&
+           strncasecmp(entry->d_name, name, name_len) == 0) {
+            match = entry->d_name;
+            break;
+        }
+    }
+
+    // Missing entry keeps its name, so it is created as requested
+    furi_string_cat_printf(host_path, "/%.*s", (int)name_len, match ? match : name);
+    if(dir) closedir(dir);
+}
+
+static FuriString* storage_host_path(StorageData* storage, const char* path) {
+    HostData* host_data = storage->data;
+    FuriString* host_path = furi_string_alloc_set(host_data->root);
+
+    while(*path) {
+        const size_t name_len = strcspn(path, "/");
+        if(name_len) storage_host_path_append(host_path, path, name_len);
+        path += name_len;
+        if(*path == '/') path++;
+    }
+
+    return host_path;
+}
+
+/* Store errno of the last call in file, returns success flag */
+static bool storage_host_file_result(File* file, bool success) {
+    file->internal_error_id = success ? 0 : errno;
+    file->error_id = storage_host_parse_error(file->internal_error_id);
+    return (file->error_id == FSE_OK);
+}
+
+/******************* File Functions *******************/
+
+static bool storage_host_file_open(
+    void* ctx,
+    File* file,
+    const char* path,
+    FS_AccessMode access_mode,
+    FS_OpenMode open_mode) {
+    StorageData* storage = ctx;
+    int flags = 0;
+
+    if((access_mode & FSAM_READ_WRITE) == FSAM_READ_WRITE) {
+        flags |= O_RDWR;
+    } else if(access_mode & FSAM_WRITE) {
+        flags |= O_WRONLY;
+    } else {
+        flags |= O_RDONLY;
+    }
+
+    // Same semantics as FatFs FA_* flags
+    if(open_mode & (FSOM_OPEN_ALWAYS | FSOM_OPEN_APPEND)) flags |= O_CREAT;
+    if(open_mode & FSOM_CREATE_NEW) flags |= O_CREAT | O_EXCL;
+    if(open_mode & FSOM_CREATE_ALWAYS) flags |= O_CREAT | O_TRUNC;
+
+    HostFile* file_data = malloc(sizeof(HostFile));
+    file_data->writable = (access_mode & FSAM_WRITE);
+    storage_set_storage_file_data(file, file_data, storage);
+
+    FuriString* host_path = storage_host_path(storage, path);
+    file_data->fd = open(furi_string_get_cstr(host_path), flags, 0644);
+    furi_string_free(host_path);
+
+    bool success = (file_data->fd >= 0);
+    if(success) {
+        struct stat st;
+        if(fstat(file_data->fd, &st) != 0) {
+            success = false;
+        } else if(S_ISDIR(st.st_mode)) {
+            errno = EISDIR;
+            success = false;
+        } else if(open_mode & FSOM_OPEN_APPEND) {
+            success = lseek(file_data->fd, 0, SEEK_END) >= 0;
+        }
+    }
+
+    return storage_host_file_result(file, success);
+}
+
+static bool storage_host_file_close(void* ctx, File* file) {
+    StorageData* storage = ctx;
+    HostFile* file_data = storage_get_storage_file_data(file, storage);
+    bool success = true;
+    if(file_data->fd >= 0) success = (close(file_data->fd) == 0);
+    storage_host_file_result(file, success);
+    free(file_data);
+    storage_set_storage_file_data(file, NULL, storage);
+    return (file->error_id == FSE_OK);
+}
+
+static uint16_t
+    storage_host_file_read(void* ctx, File* file, void* buff, uint16_t const bytes_to_read) {
+    StorageData* storage = ctx;
+    HostFile* file_data = storage_get_storage_file_data(file, storage);
+    ssize_t bytes_read = read(file_data->fd, buff, bytes_to_read);
+    storage_host_file_result(file, bytes_read >= 0);
+    return bytes_read > 0 ? bytes_read : 0;
+}
+
+static uint16_t storage_host_file_write(
+    void* ctx,
+    File* file,
+    const void* buff,
+    uint16_t const bytes_to_write) {
+    StorageData* storage = ctx;
+    HostFile* file_data = storage_get_storage_file_data(file, storage);
+    ssize_t bytes_written = write(file_data->fd, buff, bytes_to_write);
+    storage_host_file_result(file, bytes_written >= 0);
+    return bytes_written > 0 ? bytes_written : 0;
+}
+
+static bool
+    storage_host_file_seek(void* ctx, File* file, const uint32_t offset, const bool from_start) {
+    StorageData* storage = ctx;
+    HostFile* file_data = storage_get_storage_file_data(file, storage);
+
+    off_t position = offset;
+    if(!from_start) position += lseek(file_data->fd, 0, SEEK_CUR);
+
+    // Same as FatFs: read only file can't be expanded by seek
+    if(!file_data->writable) {
+        struct stat st;
+        if(fstat(file_data->fd, &st) == 0 && position > st.st_size) position = st.st_size;
+    }
+
+    return storage_host_file_result(file, lseek(file_data->fd, position, SEEK_SET) >= 0);
+}
+
+static uint64_t storage_host_file_tell(void* ctx, File* file) {
+    StorageData* storage = ctx;
+    HostFile* file_data = storage_get_storage_file_data(file, storage);
+
+    off_t position = lseek(file_data->fd, 0, SEEK_CUR);
+    storage_host_file_result(file, position >= 0);
+    return position > 0 ? (uint64_t)position : 0;
+}
+
+static bool storage_host_file_truncate(void* ctx, File* file) {
+    StorageData* storage = ctx;
+    HostFile* file_data = storage_get_storage_file_data(file, storage);
+
+    off_t position = lseek(file_data->fd, 0, SEEK_CUR);
+    return storage_host_file_result(
+        file, position >= 0 && ftruncate(file_data->fd, position) == 0);
+}
+
+static bool storage_host_file_sync(void* ctx, File* file) {
+    StorageData* storage = ctx;
+    HostFile* file_data = storage_get_storage_file_data(file, storage);
+
+    return storage_host_file_result(file, fsync(file_data->fd) == 0);
+}
+
+static uint64_t storage_host_file_size(void* ctx, File* file) {
+    StorageData* storage = ctx;
+    HostFile* file_data = storage_get_storage_file_data(file, storage);
+
+    struct stat st;
+    bool success = (fstat(file_data->fd, &st) == 0);
+    storage_host_file_result(file, success);
+    return success ? (uint64_t)st.st_size : 0;
+}
+
+static bool storage_host_file_eof(void* ctx, File* file) {
+    StorageData* storage = ctx;
+    HostFile* file_data = storage_get_storage_file_data(file, storage);
+
+    struct stat st;
+    off_t position = lseek(file_data->fd, 0, SEEK_CUR);
+    bool eof = (fstat(file_data->fd, &st) == 0) && (position >= st.st_size);
+    file->internal_error_id = 0;
+    file->error_id = FSE_OK;
+    return eof;
+}
+
+/******************* Dir Functions *******************/
+
+static bool storage_host_dir_open(void* ctx, File* file, const char* path) {
+    StorageData* storage = ctx;
+
+    HostDir* file_data = malloc(sizeof(HostDir));
+    storage_set_storage_file_data(file, file_data, storage);
+
+    FuriString* host_path = storage_host_path(storage, path);
+    file_data->dir = opendir(furi_string_get_cstr(host_path));
+    furi_string_free(host_path);
+
+    return storage_host_file_result(file, file_data->dir != NULL);
+}
+
+static bool storage_host_dir_close(void* ctx, File* file) {
+    StorageData* storage = ctx;
+    HostDir* file_data = storage_get_storage_file_data(file, storage);
+
+    bool success = true;
+    if(file_data->dir) success = (closedir(file_data->dir) == 0);
+    storage_host_file_result(file, success);
+    free(file_data);
+    return (file->error_id == FSE_OK);
+}
+
+static bool storage_host_dir_read(
+    void* ctx,
+    File* file,
+    FileInfo* fileinfo,
+    char* name,
+    const uint16_t name_length) {
+    StorageData* storage = ctx;
+    HostDir* file_data = storage_get_storage_file_data(file, storage);
+
+    struct dirent* entry;
+    do {
+        errno = 0;
+        entry = readdir(file_data->dir);
+        // FatFs doesn't report dot entries
+    } while(entry && (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0));
+
+    if(!entry) {
+        storage_host_file_result(file, errno == 0);
+        if(file->error_id == FSE_OK) file->error_id = FSE_NOT_EXIST;
+        return false;
+    }
+
+    struct stat st;
+    bool success = (fstatat(dirfd(file_data->dir), entry->d_name, &st, 0) == 0);
+    storage_host_file_result(file, success);
+
+    if(fileinfo != NULL) {
+        fileinfo->size = success ? (uint64_t)st.st_size : 0;
+        fileinfo->flags = 0;
+
+        if(success && S_ISDIR(st.st_mode)) fileinfo->flags |= FSF_DIRECTORY;
+    }
+
+    if(name != NULL) {
+        snprintf(name, name_length, "%s", entry->d_name);
+    }
+
+    return (file->error_id == FSE_OK);
+}
+
+static bool storage_host_dir_rewind(void* ctx, File* file) {
+    StorageData* storage = ctx;
+    HostDir* file_data = storage_get_storage_file_data(file, storage);
+
+    rewinddir(file_data->dir);
+    return storage_host_file_result(file, true);
+}
+
+/******************* Common FS Functions *******************/
+
+static FS_Error storage_host_common_stat(void* ctx, const char* path, FileInfo* fileinfo) {
+    StorageData* storage = ctx;
+
+    FuriString* host_path = storage_host_path(storage, path);
+    struct stat st;
+    bool success = (stat(furi_string_get_cstr(host_path), &st) == 0);
+    furi_string_free(host_path);
+
+    if(fileinfo != NULL) {
+        fileinfo->size = success ? (uint64_t)st.st_size : 0;
+        fileinfo->flags = 0;
+
+        if(success && S_ISDIR(st.st_mode)) fileinfo->flags |= FSF_DIRECTORY;
+    }
+
+    return storage_host_parse_error(success ? 0 : errno);
+}
+
+static FS_Error storage_host_common_remove(void* ctx, const char* path) {
+    StorageData* storage = ctx;
+
+    FuriString* host_path = storage_host_path(storage, path);
+    const char* host_path_cstr = furi_string_get_cstr(host_path);
+    struct stat st;
+    bool success = (stat(host_path_cstr, &st) == 0);
+    if(success) {
+        success = S_ISDIR(st.st_mode) ? (rmdir(host_path_cstr) == 0) :
+                                        (unlink(host_path_cstr) == 0);
+    }
+    furi_string_free(host_path);
+
+    return storage_host_parse_error(success ? 0 : errno);
+}
+
+static FS_Error storage_host_common_mkdir(void* ctx, const char* path) {
+    StorageData* storage = ctx;
+
+    FuriString* host_path = storage_host_path(storage, path);
+    bool success = (mkdir(furi_string_get_cstr(host_path), 0755) == 0);
+    furi_string_free(host_path);
+
+    return storage_host_parse_error(success ? 0 : errno);
+}
+
+static FS_Error storage_host_common_fs_info(
+    void* ctx,
+    const char* fs_path,
+    uint64_t* total_space,
+    uint64_t* free_space) {
+    UNUSED(fs_path);
+    StorageData* storage = ctx;
+    HostData* host_data = storage->data;
+
+    struct statvfs st;
+    bool success = (statvfs(host_data->root, &st) == 0);
+    if(success) {
+        if(total_space != NULL) {
+            *total_space = (uint64_t)st.f_blocks * (uint64_t)st.f_frsize;
+        }
+
+        if(free_space != NULL) {
+            *free_space = (uint64_t)st.f_bavail * (uint64_t)st.f_frsize;
+        }
+    }
+
+    return storage_host_parse_error(success ? 0 : errno);
+}
+
+static bool storage_host_common_equivalent_path(const char* path1, const char* path2) {
+    // Paths are resolved without case, same as FatFs
+    return strcasecmp(path1, path2) == 0;
+}
+
+/******************* Host Only Functions *******************/
+
+FS_Error storage_host_rename(StorageData* storage, const char* old_path, const char* new_path) {
+    FuriString* host_old_path = storage_host_path(storage, old_path);
+    FuriString* host_new_path = storage_host_path(storage, new_path);
+    bool success =
+        (rename(furi_string_get_cstr(host_old_path), furi_string_get_cstr(host_new_path)) == 0);
+    furi_string_free(host_new_path);
+    furi_string_free(host_old_path);
+
+    return storage_host_parse_error(success ? 0 : errno);
+}
+
+/******************* Init Storage *******************/
+static const FS_Api fs_api = {
+    .file =
+        {
+            .open = storage_host_file_open,
+            .close = storage_host_file_close,
+            .read = storage_host_file_read,
+            .write = storage_host_file_write,
+            .seek = storage_host_file_seek,
+            .tell = storage_host_file_tell,
+            .truncate = storage_host_file_truncate,
+            .size = storage_host_file_size,
+            .sync = storage_host_file_sync,
+            .eof = storage_host_file_eof,
+        },
+    .dir =
+        {
+            .open = storage_host_dir_open,
+            .close = storage_host_dir_close,
+            .read = storage_host_dir_read,
+            .rewind = storage_host_dir_rewind,
+        },
+    .common =
+        {
+            .stat = storage_host_common_stat,
+            .mkdir = storage_host_common_mkdir,
+            .remove = storage_host_common_remove,
+            .fs_info = storage_host_common_fs_info,
+            .equivalent_path = storage_host_common_equivalent_path,
+        },
+};
+
+void storage_host_init(StorageData* storage, const char* root) {
+    furi_check(root);
+
+    struct stat st;
+    furi_check(stat(root, &st) == 0 && S_ISDIR(st.st_mode), "Storage root is not a directory");
+
+    HostData* host_data = malloc(sizeof(HostData));
+    host_data->root = strdup(root);
+
+    // Paths come with leading slash
+    size_t root_len = strlen(host_data->root);
+    if(root_len > 1 && host_data->root[root_len - 1] == '/') host_data->root[root_len - 1] = 0;
+
+    storage->data = host_data;
+    storage->api.tick = NULL;
+    storage->fs_api = &fs_api;
+    storage->status = StorageStatusOK;
+
+    FURI_LOG_I(TAG, "Mounted %s", host_data->root);
+}
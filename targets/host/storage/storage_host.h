@@ -0,0 +1,43 @@
+#pragma once
+#include <furi.h>
+#include <storage/storage_glue.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Init storage backed by host directory
+ *
+ * Storage paths are resolved relative to root, pass tmpfs directory to get
+ * RAM backed storage. Names are matched without case, same as FatFs.
+ *
+ * @param      storage  The storage data
+ * @param      root     Host directory, must exist
+ */
+void storage_host_init(StorageData* storage, const char* root);
+
+/** Rename file or directory
+ *
+ * FS_Api has no rename, storage_common_rename on host uses this instead of
+ * copy and remove. Existing file at new_path is replaced.
+ *
+ * @param      storage   The storage data
+ * @param      old_path  The old path, without VFS prefix
+ * @param      new_path  The new path, without VFS prefix
+ *
+ * @return     FSE_OK on success
+ */
+FS_Error storage_host_rename(StorageData* storage, const char* old_path, const char* new_path);
+
+/** Create storage record backed by host directory
+ *
+ * Storage client API is served without storage service thread, every VFS
+ * prefix points to root. Directory functions are not implemented.
+ *
+ * @param      root     Host directory, must exist
+ */
+void storage_host_record_create(const char* root);
+
+#ifdef __cplusplus
+}
+#endif
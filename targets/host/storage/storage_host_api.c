@@ -0,0 +1,371 @@
+#include "storage_host.h"
+
+#include <storage/storage.h>
+#include <string.h>
+
+#define TAG "StorageHostApi"
+
+#define STORAGE_HOST_PATH_PREFIX_LEN 4u
+
+/* Storage client API without storage service thread: calls go straight to the
+ * host FS_Api under one mutex, all VFS prefixes point to the same directory. */
+struct Storage {
+    FuriMutex* mutex;
+    StorageData data;
+};
+
+static const char* storage_host_api_strip_prefix(const char* path) {
+    if(strncmp(path, STORAGE_EXT_PATH_PREFIX, STORAGE_HOST_PATH_PREFIX_LEN) == 0 ||
+       strncmp(path, STORAGE_INT_PATH_PREFIX, STORAGE_HOST_PATH_PREFIX_LEN) == 0 ||
+       strncmp(path, STORAGE_ANY_PATH_PREFIX, STORAGE_HOST_PATH_PREFIX_LEN) == 0) {
+        path += STORAGE_HOST_PATH_PREFIX_LEN;
+        if(*path == '\0' || *path == '/') return path;
+    }
+
+    return NULL;
+}
+
+static void storage_host_api_lock(Storage* storage) {
+    furi_check(furi_mutex_acquire(storage->mutex, FuriWaitForever) == FuriStatusOk);
+}
+
+static void storage_host_api_unlock(Storage* storage) {
+    furi_check(furi_mutex_release(storage->mutex) == FuriStatusOk);
+}
+
+void storage_host_record_create(const char* root) {
+    Storage* storage = malloc(sizeof(Storage));
+    storage->mutex = furi_mutex_alloc(FuriMutexTypeRecursive);
+    storage_data_init(&storage->data);
+    storage_host_init(&storage->data, root);
+
+    furi_record_create(RECORD_STORAGE, storage);
+}
+
+/****************** FILE ******************/
+
+File* storage_file_alloc(Storage* storage) {
+    furi_check(storage);
+
+    File* file = malloc(sizeof(File));
+    file->type = FileTypeClosed;
+    file->storage = storage;
+
+    return file;
+}
+
+void storage_file_free(File* file) {
+    furi_check(file);
+
+    if(storage_file_is_open(file)) {
+        furi_check(!storage_file_is_dir(file));
+        storage_file_close(file);
+    }
+
+    free(file);
+}
+
+bool storage_file_is_open(File* file) {
+    furi_check(file);
+    return (file->type != FileTypeClosed);
+}
+
+bool storage_file_is_dir(File* file) {
+    furi_check(file);
+    return (file->type == FileTypeOpenDir);
+}
+
+bool storage_file_open(
+    File* file,
+    const char* path,
+    FS_AccessMode access_mode,
+    FS_OpenMode open_mode) {
+    furi_check(file);
+    furi_check(!storage_file_is_open(file));
+    Storage* storage = file->storage;
+    StorageData* data = &storage->data;
+
+    const char* path_no_vfs = storage_host_api_strip_prefix(path);
+    if(!path_no_vfs) {
+        file->error_id = FSE_INVALID_NAME;
+        return false;
+    }
+
+    storage_host_api_lock(storage);
+    FuriString* full_path = furi_string_alloc_set(path);
+    bool success = false;
+    if(storage_path_already_open(full_path, data)) {
+        file->error_id = FSE_ALREADY_OPEN;
+    } else {
+        file->type = FileTypeOpenFile;
+        storage_push_storage_file(file, full_path, data);
+        success = data->fs_api->file.open(data, file, path_no_vfs, access_mode, open_mode);
+    }
+    furi_string_free(full_path);
+    storage_host_api_unlock(storage);
+
+    // Failed file keeps its slot like in storage service, close releases it
+    return success;
+}
+
+bool storage_file_close(File* file) {
+    furi_check(file);
+    Storage* storage = file->storage;
+    StorageData* data = &storage->data;
+    bool success = false;
+
+    storage_host_api_lock(storage);
+    if(storage_has_file(file, data)) {
+        success = data->fs_api->file.close(data, file);
+        storage_pop_storage_file(file, data);
+    } else {
+        file->error_id = FSE_INVALID_PARAMETER;
+    }
+    storage_host_api_unlock(storage);
+
+    file->type = FileTypeClosed;
+    return success;
+}
+
+static size_t
+    storage_file_read_underlying(File* file, void* buff, uint16_t bytes_to_read) {
+    Storage* storage = file->storage;
+    StorageData* data = &storage->data;
+    size_t bytes_read = 0;
+
+    storage_host_api_lock(storage);
+    if(storage_has_file(file, data)) {
+        bytes_read = data->fs_api->file.read(data, file, buff, bytes_to_read);
+    } else {
+        file->error_id = FSE_INVALID_PARAMETER;
+    }
+    storage_host_api_unlock(storage);
+
+    return bytes_read;
+}
+
+static size_t
+    storage_file_write_underlying(File* file, const void* buff, uint16_t bytes_to_write) {
+    Storage* storage = file->storage;
+    StorageData* data = &storage->data;
+    size_t bytes_written = 0;
+
+    storage_host_api_lock(storage);
+    if(storage_has_file(file, data)) {
+        bytes_written = data->fs_api->file.write(data, file, buff, bytes_to_write);
+    } else {
+        file->error_id = FSE_INVALID_PARAMETER;
+    }
+    storage_host_api_unlock(storage);
+
+    return bytes_written;
+}
+
+size_t storage_file_read(File* file, void* buff, size_t to_read) {
+    furi_check(file);
+    size_t total = 0;
+
+    const size_t max_chunk = UINT16_MAX;
+    do {
+        const size_t chunk = MIN((to_read - total), max_chunk);
+        size_t read = storage_file_read_underlying(file, buff + total, chunk);
+        total += read;
+
+        if(storage_file_get_error(file) != FSE_OK || read != chunk) {
+            break;
+        }
+    } while(total != to_read);
+
+    return total;
+}
+
+size_t storage_file_write(File* file, const void* buff, size_t to_write) {
+    furi_check(file);
+    size_t total = 0;
+
+    const size_t max_chunk = UINT16_MAX;
+    do {
+        const size_t chunk = MIN((to_write - total), max_chunk);
+        size_t written = storage_file_write_underlying(file, buff + total, chunk);
+        total += written;
+
+        if(storage_file_get_error(file) != FSE_OK || written != chunk) {
+            break;
+        }
+    } while(total != to_write);
+
+    return total;
+}
+
+/* Runs FS_Api file call with storage locked, sets invalid parameter if file is not open */
+#define STORAGE_HOST_FILE_CALL(_file, _ret, _call)            \
+    do {                                                      \
+        furi_check(_file);                                    \
+        Storage* storage = (_file)->storage;                  \
+        StorageData* data = &storage->data;                   \
+        storage_host_api_lock(storage);                       \
+        if(storage_has_file(_file, data)) {                   \
+            _ret = data->fs_api->file._call;                  \
+        } else {                                              \
+            (_file)->error_id = FSE_INVALID_PARAMETER;        \
+        }                                                     \
+        storage_host_api_unlock(storage);                     \
+    } while(0)
+
+bool storage_file_seek(File* file, uint32_t offset, bool from_start) {
+    bool success = false;
+    STORAGE_HOST_FILE_CALL(file, success, seek(data, file, offset, from_start));
+    return success;
+}
+
+uint64_t storage_file_tell(File* file) {
+    uint64_t position = 0;
+    STORAGE_HOST_FILE_CALL(file, position, tell(data, file));
+    return position;
+}
+
+bool storage_file_truncate(File* file) {
+    bool success = false;
+    STORAGE_HOST_FILE_CALL(file, success, truncate(data, file));
+    return success;
+}
+
+uint64_t storage_file_size(File* file) {
+    uint64_t size = 0;
+    STORAGE_HOST_FILE_CALL(file, size, size(data, file));
+    return size;
+}
+
+bool storage_file_sync(File* file) {
+    bool success = false;
+    STORAGE_HOST_FILE_CALL(file, success, sync(data, file));
+    return success;
+}
+
+bool storage_file_eof(File* file) {
+    bool eof = true;
+    STORAGE_HOST_FILE_CALL(file, eof, eof(data, file));
+    return eof;
+}
+
+bool storage_file_exists(Storage* storage, const char* path) {
+    FileInfo fileinfo;
+    FS_Error error = storage_common_stat(storage, path, &fileinfo);
+    return (error == FSE_OK && !file_info_is_dir(&fileinfo));
+}
+
+/****************** COMMON ******************/
+
+FS_Error storage_common_stat(Storage* storage, const char* path, FileInfo* fileinfo) {
+    furi_check(storage);
+    const char* path_no_vfs = storage_host_api_strip_prefix(path);
+    if(!path_no_vfs) return FSE_INVALID_NAME;
+
+    storage_host_api_lock(storage);
+    FS_Error error = storage->data.fs_api->common.stat(&storage->data, path_no_vfs, fileinfo);
+    storage_host_api_unlock(storage);
+
+    return error;
+}
+
+FS_Error storage_common_remove(Storage* storage, const char* path) {
+    furi_check(storage);
+    const char* path_no_vfs = storage_host_api_strip_prefix(path);
+    if(!path_no_vfs) return FSE_INVALID_NAME;
+
+    storage_host_api_lock(storage);
+    FuriString* full_path = furi_string_alloc_set(path);
+    FS_Error error = FSE_ALREADY_OPEN;
+    if(!storage_path_already_open(full_path, &storage->data)) {
+        error = storage->data.fs_api->common.remove(&storage->data, path_no_vfs);
+    }
+    furi_string_free(full_path);
+    storage_host_api_unlock(storage);
+
+    return error;
+}
+
+FS_Error storage_common_mkdir(Storage* storage, const char* path) {
+    furi_check(storage);
+    const char* path_no_vfs = storage_host_api_strip_prefix(path);
+    if(!path_no_vfs) return FSE_INVALID_NAME;
+
+    storage_host_api_lock(storage);
+    FS_Error error = storage->data.fs_api->common.mkdir(&storage->data, path_no_vfs);
+    storage_host_api_unlock(storage);
+
+    return error;
+}
+
+FS_Error storage_common_rename(Storage* storage, const char* old_path, const char* new_path) {
+    furi_check(storage);
+    const char* old_path_no_vfs = storage_host_api_strip_prefix(old_path);
+    const char* new_path_no_vfs = storage_host_api_strip_prefix(new_path);
+    if(!old_path_no_vfs || !new_path_no_vfs) return FSE_INVALID_NAME;
+
+    storage_host_api_lock(storage);
+    FS_Error error = storage_host_rename(&storage->data, old_path_no_vfs, new_path_no_vfs);
+    storage_host_api_unlock(storage);
+
+    return error;
+}
+
+bool storage_common_exists(Storage* storage, const char* path) {
+    return storage_common_stat(storage, path, NULL) == FSE_OK;
+}
+
+bool storage_simply_remove(Storage* storage, const char* path) {
+    FS_Error result = storage_common_remove(storage, path);
+    return result == FSE_OK || result == FSE_NOT_EXIST;
+}
+
+bool storage_simply_mkdir(Storage* storage, const char* path) {
+    FS_Error result = storage_common_mkdir(storage, path);
+    return result == FSE_OK || result == FSE_EXIST;
+}
+
+void storage_get_next_filename(
+    Storage* storage,
+    const char* dirname,
+    const char* filename,
+    const char* fileextension,
+    FuriString* nextfilename,
+    uint8_t max_len) {
+    FuriString* temp_str;
+    uint16_t num = 0;
+
+    temp_str = furi_string_alloc_printf("%s/%s%s", dirname, filename, fileextension);
+
+    while(storage_common_stat(storage, furi_string_get_cstr(temp_str), NULL) == FSE_OK) {
+        num++;
+        furi_string_printf(temp_str, "%s/%s%d%s", dirname, filename, num, fileextension);
+    }
+    if(num && (max_len > strlen(filename))) {
+        furi_string_printf(nextfilename, "%s%d", filename, num);
+    } else {
+        furi_string_printf(nextfilename, "%s", filename);
+    }
+
+    furi_string_free(temp_str);
+}
+
+/****************** ERROR ******************/
+
+const char* storage_error_get_desc(FS_Error error_id) {
+    return filesystem_api_error_get_desc(error_id);
+}
+
+FS_Error storage_file_get_error(File* file) {
+    furi_check(file);
+    return file->error_id;
+}
+
+int32_t storage_file_get_internal_error(File* file) {
+    furi_check(file);
+    return file->internal_error_id;
+}
+
+const char* storage_file_get_error_desc(File* file) {
+    furi_check(file);
+    return filesystem_api_error_get_desc(file->error_id);
+}
@@ -0,0 +1,293 @@
+#include <furi.h>
+#include <flipper_format/flipper_format.h>
+#include <flipper_format/flipper_format_i.h>
+#include <lib/subghz/protocols/base.h>
+#include <lib/subghz/protocols/bin_raw.h>
+#include <lib/subghz/protocols/public_api.h>
+#include <storage/storage.h>
+#include <storage_host.h>
+
+#include <errno.h>
+#include <getopt.h>
+#include <libgen.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define TAG "SubGhzBinRawBench"
+
+#define SUBGHZ_BIN_RAW_BENCH_SILENCE_US (50000U)
+#define SUBGHZ_BIN_RAW_BENCH_RSSI_SIGNAL (-50.0f)
+#define SUBGHZ_BIN_RAW_BENCH_RSSI_NOISE (-100.0f)
+#define SUBGHZ_BIN_RAW_BENCH_GOLDEN_EXTENSION ".txt"
+
+typedef struct {
+    uint64_t count;
+    uint64_t total_ns;
+    uint64_t max_ns;
+} SubGhzBinRawBenchTime;
+
+typedef struct {
+    SubGhzBinRawBenchTime feed;
+    SubGhzBinRawBenchTime analysis;
+    uint32_t decodes;
+} SubGhzBinRawBenchStats;
+
+typedef struct {
+    void* decoder;
+    FlipperFormat* decode;
+    FuriString* output;
+    SubGhzRadioPreset preset;
+    uint32_t decodes;
+} SubGhzBinRawBench;
+
+static uint64_t subghz_bin_raw_bench_time_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static void subghz_bin_raw_bench_time_add(SubGhzBinRawBenchTime* time, uint64_t start) {
+    uint64_t elapsed = subghz_bin_raw_bench_time_ns() - start;
+    time->count++;
+    time->total_ns += elapsed;
+    time->max_ns = MAX(time->max_ns, elapsed);
+}
+
+static void subghz_bin_raw_bench_time_print(const char* name, SubGhzBinRawBenchTime* time) {
+    printf(
+        "%-9s %9llu calls, avg %9.3f us, max %9.3f us\n",
+        name,
+        (unsigned long long)time->count,
+        time->count ? time->total_ns / 1000.0 / time->count : 0.0,
+        time->max_ns / 1000.0);
+}
+
+static void
+    subghz_bin_raw_bench_rx_callback(SubGhzProtocolDecoderBase* decoder_base, void* context) {
+    SubGhzBinRawBench* bench = context;
+
+    subghz_protocol_decoder_base_serialize(decoder_base, bench->decode, &bench->preset);
+    Stream* stream = flipper_format_get_raw_stream(bench->decode);
+    stream_rewind(stream);
+
+    furi_string_cat_printf(bench->output, "Decode: %lu\n", (unsigned long)bench->decodes++);
+    char buffer[64];
+    size_t size = 0;
+    while((size = stream_read(stream, (uint8_t*)buffer, sizeof(buffer))) > 0) {
+        furi_string_cat_printf(bench->output, "%.*s", (int)size, buffer);
+    }
+}
+
+// Signal is gone: decoder analyses what it has collected
+static void
+    subghz_bin_raw_bench_end_signal(SubGhzBinRawBench* bench, SubGhzBinRawBenchStats* stats) {
+    uint64_t start = subghz_bin_raw_bench_time_ns();
+    subghz_protocol_decoder_bin_raw_data_input_rssi(
+        bench->decoder, SUBGHZ_BIN_RAW_BENCH_RSSI_NOISE);
+    subghz_bin_raw_bench_time_add(&stats->analysis, start);
+}
+
+static void subghz_bin_raw_bench_start_signal(SubGhzBinRawBench* bench) {
+    subghz_protocol_decoder_bin_raw_data_input_rssi(
+        bench->decoder, SUBGHZ_BIN_RAW_BENCH_RSSI_SIGNAL);
+}
+
+// Signal is assumed present until a silence, RAW files have no RSSI
+static bool subghz_bin_raw_bench_run(
+    SubGhzBinRawBench* bench,
+    SubGhzBinRawBenchStats* stats,
+    const char* path,
+    uint32_t silence_us) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FlipperFormat* flipper_format = flipper_format_file_alloc(storage);
+    FuriString* storage_path = furi_string_alloc_printf(STORAGE_EXT_PATH_PREFIX "%s", path);
+    FuriString* temp_str = furi_string_alloc();
+    int32_t* durations = NULL;
+    bool success = false;
+
+    subghz_protocol_decoder_bin_raw_reset(bench->decoder);
+    subghz_protocol_decoder_bin_raw_data_input_rssi(
+        bench->decoder, SUBGHZ_BIN_RAW_BENCH_RSSI_NOISE);
+    subghz_bin_raw_bench_start_signal(bench);
+    furi_string_reset(bench->output);
+    bench->decodes = 0;
+
+    do {
+        uint32_t version = 0;
+        if(!flipper_format_file_open_existing(flipper_format, furi_string_get_cstr(storage_path)))
+            break;
+        if(!flipper_format_read_header(flipper_format, temp_str, &version)) break;
+        if(furi_string_cmp_str(temp_str, SUBGHZ_RAW_FILE_TYPE)) break;
+
+        uint32_t count = 0;
+        while(flipper_format_get_value_count(flipper_format, "RAW_Data", &count)) {
+            durations = realloc(durations, count * sizeof(int32_t));
+            if(!flipper_format_read_int32(flipper_format, "RAW_Data", durations, count)) break;
+
+            for(uint32_t i = 0; i < count; i++) {
+                uint32_t duration = abs(durations[i]);
+                uint64_t start = subghz_bin_raw_bench_time_ns();
+                subghz_protocol_decoder_bin_raw_feed(bench->decoder, durations[i] > 0, duration);
+                subghz_bin_raw_bench_time_add(&stats->feed, start);
+
+                if(duration >= silence_us) {
+                    subghz_bin_raw_bench_end_signal(bench, stats);
+                    subghz_bin_raw_bench_start_signal(bench);
+                }
+            }
+        }
+        subghz_bin_raw_bench_end_signal(bench, stats);
+        success = true;
+    } while(false);
+
+    stats->decodes += bench->decodes;
+    free(durations);
+    furi_string_free(temp_str);
+    furi_string_free(storage_path);
+    flipper_format_free(flipper_format);
+    furi_record_close(RECORD_STORAGE);
+    return success;
+}
+
+static bool subghz_bin_raw_bench_check_golden(
+    SubGhzBinRawBench* bench,
+    const char* path,
+    const char* golden_dir,
+    bool update) {
+    char* name = strdup(path);
+    FuriString* golden_path = furi_string_alloc_printf(
+        "%s/%s%s", golden_dir, basename(name), SUBGHZ_BIN_RAW_BENCH_GOLDEN_EXTENSION);
+    bool success = false;
+
+    if(update) {
+        FILE* file = fopen(furi_string_get_cstr(golden_path), "w");
+        if(file) {
+            fputs(furi_string_get_cstr(bench->output), file);
+            success = (fclose(file) == 0);
+        }
+        if(!success) printf("FAIL %s: can't write golden file\n", path);
+    } else {
+        FuriString* golden = furi_string_alloc();
+        FILE* file = fopen(furi_string_get_cstr(golden_path), "r");
+        if(file) {
+            char buffer[256];
+            size_t size = 0;
+            while((size = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+                furi_string_cat_printf(golden, "%.*s", (int)size, buffer);
+            }
+            fclose(file);
+            success = furi_string_equal(golden, bench->output);
+            if(!success) printf("FAIL %s: output differs from golden file\n", path);
+        } else {
+            printf("FAIL %s: no golden file\n", path);
+        }
+        furi_string_free(golden);
+    }
+
+    furi_string_free(golden_path);
+    free(name);
+    return success;
+}
+
+static void subghz_bin_raw_bench_usage(const char* name) {
+    printf("Usage: %s [-s silence_us] [-g golden_dir [-u]] file.sub...\n", name);
+}
+
+int main(int argc, char** argv) {
+    uint32_t silence_us = SUBGHZ_BIN_RAW_BENCH_SILENCE_US;
+    const char* golden_dir = NULL;
+    bool update = false;
+
+    int option;
+    while((option = getopt(argc, argv, "s:g:uh")) != -1) {
+        switch(option) {
+        case 's':
+            silence_us = strtoul(optarg, NULL, 10);
+            break;
+        case 'g':
+            golden_dir = optarg;
+            break;
+        case 'u':
+            update = true;
+            break;
+        default:
+            subghz_bin_raw_bench_usage(argv[0]);
+            return 2;
+        }
+    }
+
+    if(optind == argc || (update && !golden_dir)) {
+        subghz_bin_raw_bench_usage(argv[0]);
+        return 2;
+    }
+
+    furi_init();
+    // Storage root is the file system root, host paths are opened under /ext
+    storage_host_record_create("/");
+
+    SubGhzBinRawBench bench = {
+        .decoder = subghz_protocol_decoder_bin_raw_alloc(NULL),
+        .decode = flipper_format_string_alloc(),
+        .output = furi_string_alloc(),
+        .preset =
+            {
+                .name = furi_string_alloc_set("FuriHalSubGhzPresetOok650Async"),
+                .frequency = 433920000,
+            },
+    };
+    subghz_protocol_decoder_base_set_decoder_callback(
+        bench.decoder, subghz_bin_raw_bench_rx_callback, &bench);
+
+    SubGhzBinRawBenchStats total = {0};
+    size_t failures = 0;
+
+    for(int i = optind; i < argc; i++) {
+        char* path = realpath(argv[i], NULL);
+        if(!path) {
+            printf("FAIL %s: %s\n", argv[i], strerror(errno));
+            failures++;
+            continue;
+        }
+
+        SubGhzBinRawBenchStats stats = {0};
+        if(!subghz_bin_raw_bench_run(&bench, &stats, path, silence_us)) {
+            printf("FAIL %s: can't load RAW file\n", argv[i]);
+            failures++;
+        } else {
+            printf(
+                "%s: %lu pulses, %lu decodes, max feed %.3f us, max analysis %.3f us\n",
+                argv[i],
+                (unsigned long)stats.feed.count,
+                (unsigned long)stats.decodes,
+                stats.feed.max_ns / 1000.0,
+                stats.analysis.max_ns / 1000.0);
+            if(golden_dir &&
+               !subghz_bin_raw_bench_check_golden(&bench, argv[i], golden_dir, update)) {
+                failures++;
+            }
+        }
+
+        total.decodes += stats.decodes;
+        total.feed.count += stats.feed.count;
+        total.feed.total_ns += stats.feed.total_ns;
+        total.feed.max_ns = MAX(total.feed.max_ns, stats.feed.max_ns);
+        total.analysis.count += stats.analysis.count;
+        total.analysis.total_ns += stats.analysis.total_ns;
+        total.analysis.max_ns = MAX(total.analysis.max_ns, stats.analysis.max_ns);
+        free(path);
+    }
+
+    printf("Decodes: %lu\n", (unsigned long)total.decodes);
+    subghz_bin_raw_bench_time_print("feed", &total.feed);
+    subghz_bin_raw_bench_time_print("analysis", &total.analysis);
+
+    furi_string_free(bench.preset.name);
+    furi_string_free(bench.output);
+    flipper_format_free(bench.decode);
+    subghz_protocol_decoder_bin_raw_free(bench.decoder);
+
+    if(failures) printf("%zu failures\n", failures);
+    return failures ? 1 : 0;
+}
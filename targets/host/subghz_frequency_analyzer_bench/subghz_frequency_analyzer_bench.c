@@ -0,0 +1,363 @@
+#include <subghz_frequency_analyzer_sweep.h>
+
+#include <furi.h>
+
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define TAG "SubGhzFrequencyAnalyzerBench"
+
+#define SUBGHZ_FREQUENCY_ANALYZER_BENCH_TRIALS (1000U)
+#define SUBGHZ_FREQUENCY_ANALYZER_BENCH_REPEAT (50U)
+#define SUBGHZ_FREQUENCY_ANALYZER_BENCH_SEED (0x12345678UL)
+// Worker sleeps between passes
+#define SUBGHZ_FREQUENCY_ANALYZER_BENCH_PASS_DELAY_US (10000U)
+// CC1101 idle, set frequency, calibration and Rx start
+#define SUBGHZ_FREQUENCY_ANALYZER_BENCH_TUNE_US (700U)
+#define SUBGHZ_FREQUENCY_ANALYZER_BENCH_TUNE_JITTER_US (200U)
+#define SUBGHZ_FREQUENCY_ANALYZER_BENCH_RSSI_US (50U)
+#define SUBGHZ_FREQUENCY_ANALYZER_BENCH_NOISE (-100.0f)
+#define SUBGHZ_FREQUENCY_ANALYZER_BENCH_SIGNAL_US (3000000U)
+#define SUBGHZ_FREQUENCY_ANALYZER_BENCH_GAP_US (2000000U)
+// Bit period of remotes, carrier is on for 30 to 70% of it
+#define SUBGHZ_FREQUENCY_ANALYZER_BENCH_OOK_PERIOD_MIN_US (400U)
+#define SUBGHZ_FREQUENCY_ANALYZER_BENCH_OOK_PERIOD_MAX_US (2000U)
+#define SUBGHZ_FREQUENCY_ANALYZER_BENCH_OFFSET (200000U)
+// 433.42, 433.92 and 434.42 MHz
+#define SUBGHZ_FREQUENCY_ANALYZER_BENCH_FAVORITE (9U)
+#define SUBGHZ_FREQUENCY_ANALYZER_BENCH_FAVORITES (3U)
+
+// Default frequency list of subghz_setting
+static const uint32_t subghz_frequency_analyzer_bench_frequencies[] = {
+    300000000, 303875000, 304250000, 310000000, 315000000, 318000000,
+    390000000, 418000000, 433075000, 433420000, 433920000, 434420000,
+    434775000, 438900000, 868350000, 915000000, 925000000,
+};
+
+#define SUBGHZ_FREQUENCY_ANALYZER_BENCH_FREQUENCY_COUNT \
+    COUNT_OF(subghz_frequency_analyzer_bench_frequencies)
+
+// Half of Rx filter bandwidth
+static const uint32_t subghz_frequency_analyzer_bench_half_width[] = {
+    [SubGhzFrequencyAnalyzerFilterWide] = 325000,
+    [SubGhzFrequencyAnalyzerFilterMedium] = 101562,
+    [SubGhzFrequencyAnalyzerFilterNarrow] = 29017,
+};
+
+typedef struct {
+    uint32_t frequency;
+    float rssi;
+    uint64_t start_us;
+    uint64_t end_us;
+    uint32_t period_us; /**< OOK period */
+    uint32_t on_us; /**< Carrier on time of every OOK period */
+} SubGhzFrequencyAnalyzerBenchSignal;
+
+typedef struct {
+    uint64_t now_us;
+    uint32_t random;
+    uint32_t frequency;
+    SubGhzFrequencyAnalyzerFilter filter;
+    SubGhzFrequencyAnalyzerBenchSignal signal;
+} SubGhzFrequencyAnalyzerBenchRadio;
+
+typedef struct {
+    uint32_t detected;
+    uint32_t missed;
+    uint64_t passes;
+    uint64_t pass_total_us;
+    uint64_t latency_total_us;
+    uint64_t latency_max_us;
+    uint64_t error_total;
+    uint32_t error_max;
+} SubGhzFrequencyAnalyzerBenchStats;
+
+typedef void (*SubGhzFrequencyAnalyzerBenchRun)(void* context, FrequencyRSSI* result);
+
+static uint32_t subghz_frequency_analyzer_bench_random(uint32_t* state) {
+    // xorshift32, same sequence on every run
+    *state ^= *state << 13;
+    *state ^= *state >> 17;
+    *state ^= *state << 5;
+    return *state;
+}
+
+static void subghz_frequency_analyzer_bench_set_filter(
+    void* context,
+    SubGhzFrequencyAnalyzerFilter filter) {
+    SubGhzFrequencyAnalyzerBenchRadio* radio = context;
+    radio->filter = filter;
+}
+
+static uint32_t subghz_frequency_analyzer_bench_tune(void* context, uint32_t frequency) {
+    SubGhzFrequencyAnalyzerBenchRadio* radio = context;
+    // Calibration time varies, so samples don't lock to OOK period
+    radio->now_us += SUBGHZ_FREQUENCY_ANALYZER_BENCH_TUNE_US +
+                     subghz_frequency_analyzer_bench_random(&radio->random) %
+                         SUBGHZ_FREQUENCY_ANALYZER_BENCH_TUNE_JITTER_US;
+    // Synthesizer resolution of CC1101 with 26 MHz crystal
+    uint64_t word = ((uint64_t)frequency << 16) / 26000000;
+    radio->frequency = (word * 26000000) >> 16;
+    return radio->frequency;
+}
+
+static bool subghz_frequency_analyzer_bench_is_frequency_valid(void* context, uint32_t frequency) {
+    UNUSED(context);
+    // Same bands as furi_hal_subghz_is_frequency_valid
+    return (frequency >= 299999755 && frequency <= 348000335) ||
+           (frequency >= 386999938 && frequency <= 464000000) ||
+           (frequency >= 778999847 && frequency <= 928000000);
+}
+
+static float subghz_frequency_analyzer_bench_get_rssi(void* context) {
+    SubGhzFrequencyAnalyzerBenchRadio* radio = context;
+    SubGhzFrequencyAnalyzerBenchSignal* signal = &radio->signal;
+    radio->now_us += SUBGHZ_FREQUENCY_ANALYZER_BENCH_RSSI_US;
+
+    float rssi = SUBGHZ_FREQUENCY_ANALYZER_BENCH_NOISE +
+                 (subghz_frequency_analyzer_bench_random(&radio->random) % 400) / 100.0f;
+
+    if(radio->now_us >= signal->start_us && radio->now_us < signal->end_us &&
+       ((radio->now_us - signal->start_us) % signal->period_us) < signal->on_us) {
+        // 6 dB down at filter edge, 20 dB per filter width outside
+        uint32_t half_width = subghz_frequency_analyzer_bench_half_width[radio->filter];
+        uint32_t offset = radio->frequency > signal->frequency ?
+                              radio->frequency - signal->frequency :
+                              signal->frequency - radio->frequency;
+        float level = signal->rssi - 6.0f * MIN(offset, half_width) / half_width;
+        if(offset > half_width) {
+            level -= 20.0f * (offset - half_width) / (2.0f * half_width);
+        }
+        if(level > rssi) rssi = level;
+    }
+
+    return rssi;
+}
+
+static void subghz_frequency_analyzer_bench_delay_ms(void* context, uint32_t ms) {
+    SubGhzFrequencyAnalyzerBenchRadio* radio = context;
+    radio->now_us += ms * 1000ULL;
+}
+
+static const SubGhzFrequencyAnalyzerRadio subghz_frequency_analyzer_bench_radio = {
+    .set_filter = subghz_frequency_analyzer_bench_set_filter,
+    .tune = subghz_frequency_analyzer_bench_tune,
+    .is_frequency_valid = subghz_frequency_analyzer_bench_is_frequency_valid,
+    .get_rssi = subghz_frequency_analyzer_bench_get_rssi,
+    .delay_ms = subghz_frequency_analyzer_bench_delay_ms,
+};
+
+static void subghz_frequency_analyzer_bench_sweep_run(void* context, FrequencyRSSI* result) {
+    subghz_frequency_analyzer_sweep_run(context, result);
+}
+
+// Fixed schedule of the worker before the sweep: every frequency, then +-300 kHz by 20 kHz
+static void subghz_frequency_analyzer_bench_legacy_run(void* context, FrequencyRSSI* result) {
+    const SubGhzFrequencyAnalyzerRadio* radio = &subghz_frequency_analyzer_bench_radio;
+    result->rssi_coarse = -127.0f;
+    result->rssi_fine = -127.0f;
+
+    radio->set_filter(context, SubGhzFrequencyAnalyzerFilterWide);
+    for(size_t i = 0; i < SUBGHZ_FREQUENCY_ANALYZER_BENCH_FREQUENCY_COUNT; i++) {
+        uint32_t frequency = radio->tune(context, subghz_frequency_analyzer_bench_frequencies[i]);
+        radio->delay_ms(context, 2);
+        float rssi = radio->get_rssi(context);
+        if(result->rssi_coarse < rssi) {
+            result->rssi_coarse = rssi;
+            result->frequency_coarse = frequency;
+        }
+    }
+
+    if(result->rssi_coarse > SUBGHZ_FREQUENCY_ANALYZER_THRESHOLD) {
+        radio->set_filter(context, SubGhzFrequencyAnalyzerFilterNarrow);
+        for(uint32_t i = result->frequency_coarse - 300000; i < result->frequency_coarse + 300000;
+            i += 20000) {
+            if(!radio->is_frequency_valid(context, i)) continue;
+            uint32_t frequency = radio->tune(context, i);
+            radio->delay_ms(context, 2);
+            float rssi = radio->get_rssi(context);
+            if(result->rssi_fine < rssi) {
+                result->rssi_fine = rssi;
+                result->frequency_fine = frequency;
+            }
+        }
+    }
+}
+
+static void subghz_frequency_analyzer_bench_trial(
+    SubGhzFrequencyAnalyzerBenchRadio* radio,
+    SubGhzFrequencyAnalyzerBenchRun run,
+    void* context,
+    SubGhzFrequencyAnalyzerBenchStats* stats) {
+    SubGhzFrequencyAnalyzerBenchSignal* signal = &radio->signal;
+    FrequencyRSSI result;
+    bool detected = false;
+
+    while(radio->now_us < signal->end_us) {
+        radio->now_us += SUBGHZ_FREQUENCY_ANALYZER_BENCH_PASS_DELAY_US;
+        uint64_t start = radio->now_us;
+        run(context, &result);
+        stats->passes++;
+        stats->pass_total_us += radio->now_us - start;
+
+        // Worker reports coarse result too, but the analyzer locks on the fine one
+        if(detected || radio->now_us < signal->start_us ||
+           result.rssi_fine <= SUBGHZ_FREQUENCY_ANALYZER_THRESHOLD) {
+            continue;
+        }
+
+        detected = true;
+        uint64_t latency = radio->now_us - signal->start_us;
+        uint32_t error = result.frequency_fine > signal->frequency ?
+                             result.frequency_fine - signal->frequency :
+                             signal->frequency - result.frequency_fine;
+        stats->detected++;
+        stats->latency_total_us += latency;
+        stats->latency_max_us = MAX(stats->latency_max_us, latency);
+        stats->error_total += error;
+        stats->error_max = MAX(stats->error_max, error);
+    }
+
+    if(!detected) stats->missed++;
+}
+
+static void subghz_frequency_analyzer_bench_print(
+    const char* name,
+    SubGhzFrequencyAnalyzerBenchStats* stats) {
+    printf(
+        "%-7s detected %5lu, missed %4lu, latency avg %7.1f ms, max %7.1f ms, "
+        "error avg %6.1f kHz, max %6.1f kHz, pass avg %6.1f ms\n",
+        name,
+        (unsigned long)stats->detected,
+        (unsigned long)stats->missed,
+        stats->detected ? stats->latency_total_us / 1000.0 / stats->detected : 0.0,
+        stats->latency_max_us / 1000.0,
+        stats->detected ? stats->error_total / 1000.0 / stats->detected : 0.0,
+        stats->error_max / 1000.0,
+        stats->passes ? stats->pass_total_us / 1000.0 / stats->passes : 0.0);
+}
+
+// Signals of every trial are the same for both schedules, only the radio noise differs
+static void subghz_frequency_analyzer_bench_signal(
+    SubGhzFrequencyAnalyzerBenchSignal* signal,
+    uint32_t* random,
+    uint32_t repeat) {
+    uint32_t index = 0;
+    if(subghz_frequency_analyzer_bench_random(random) % 100 < repeat) {
+        index = SUBGHZ_FREQUENCY_ANALYZER_BENCH_FAVORITE +
+                subghz_frequency_analyzer_bench_random(random) %
+                    SUBGHZ_FREQUENCY_ANALYZER_BENCH_FAVORITES;
+    } else {
+        index = subghz_frequency_analyzer_bench_random(random) %
+                SUBGHZ_FREQUENCY_ANALYZER_BENCH_FREQUENCY_COUNT;
+    }
+
+    // Transmitters are off the channel, but never out of the band
+    do {
+        uint32_t offset = subghz_frequency_analyzer_bench_random(random) %
+                          (2 * SUBGHZ_FREQUENCY_ANALYZER_BENCH_OFFSET);
+        signal->frequency = subghz_frequency_analyzer_bench_frequencies[index] + offset -
+                            SUBGHZ_FREQUENCY_ANALYZER_BENCH_OFFSET;
+    } while(!subghz_frequency_analyzer_bench_is_frequency_valid(NULL, signal->frequency));
+    signal->rssi = -88.0f + subghz_frequency_analyzer_bench_random(random) % 40;
+    signal->period_us = SUBGHZ_FREQUENCY_ANALYZER_BENCH_OOK_PERIOD_MIN_US +
+                        subghz_frequency_analyzer_bench_random(random) %
+                            (SUBGHZ_FREQUENCY_ANALYZER_BENCH_OOK_PERIOD_MAX_US -
+                             SUBGHZ_FREQUENCY_ANALYZER_BENCH_OOK_PERIOD_MIN_US);
+    signal->on_us = signal->period_us * 3 / 10 +
+                    subghz_frequency_analyzer_bench_random(random) % (signal->period_us * 4 / 10);
+    signal->start_us = subghz_frequency_analyzer_bench_random(random) %
+                       SUBGHZ_FREQUENCY_ANALYZER_BENCH_GAP_US;
+    signal->end_us = signal->start_us + SUBGHZ_FREQUENCY_ANALYZER_BENCH_SIGNAL_US;
+}
+
+static void subghz_frequency_analyzer_bench_usage(const char* name) {
+    printf("Usage: %s [-n trials] [-r repeat_percent] [-s seed]\n", name);
+}
+
+int main(int argc, char** argv) {
+    uint32_t trials = SUBGHZ_FREQUENCY_ANALYZER_BENCH_TRIALS;
+    uint32_t repeat = SUBGHZ_FREQUENCY_ANALYZER_BENCH_REPEAT;
+    uint32_t seed = SUBGHZ_FREQUENCY_ANALYZER_BENCH_SEED;
+
+    int option;
+    while((option = getopt(argc, argv, "n:r:s:h")) != -1) {
+        switch(option) {
+        case 'n':
+            trials = strtoul(optarg, NULL, 10);
+            break;
+        case 'r':
+            repeat = strtoul(optarg, NULL, 10);
+            break;
+        case 's':
+            seed = strtoul(optarg, NULL, 0);
+            break;
+        default:
+            subghz_frequency_analyzer_bench_usage(argv[0]);
+            return 2;
+        }
+    }
+
+    if(optind != argc || repeat > 100 || seed == 0) {
+        subghz_frequency_analyzer_bench_usage(argv[0]);
+        return 2;
+    }
+
+    furi_init();
+
+    SubGhzFrequencyAnalyzerBenchRadio sweep_radio = {.random = seed};
+    SubGhzFrequencyAnalyzerBenchRadio legacy_radio = {.random = seed ^ 0x5A5A5A5A};
+    SubGhzFrequencyAnalyzerSweep* sweep = subghz_frequency_analyzer_sweep_alloc(
+        &subghz_frequency_analyzer_bench_radio,
+        &sweep_radio,
+        subghz_frequency_analyzer_bench_frequencies,
+        SUBGHZ_FREQUENCY_ANALYZER_BENCH_FREQUENCY_COUNT);
+
+    SubGhzFrequencyAnalyzerBenchStats sweep_stats = {0};
+    SubGhzFrequencyAnalyzerBenchStats legacy_stats = {0};
+    uint32_t random = seed;
+
+    for(uint32_t i = 0; i < trials; i++) {
+        SubGhzFrequencyAnalyzerBenchSignal signal;
+        subghz_frequency_analyzer_bench_signal(&signal, &random, repeat);
+
+        // Each schedule runs on its own clock, signal starts relative to it
+        sweep_radio.signal = signal;
+        sweep_radio.signal.start_us += sweep_radio.now_us;
+        sweep_radio.signal.end_us += sweep_radio.now_us;
+        subghz_frequency_analyzer_bench_trial(
+            &sweep_radio, subghz_frequency_analyzer_bench_sweep_run, sweep, &sweep_stats);
+
+        legacy_radio.signal = signal;
+        legacy_radio.signal.start_us += legacy_radio.now_us;
+        legacy_radio.signal.end_us += legacy_radio.now_us;
+        subghz_frequency_analyzer_bench_trial(
+            &legacy_radio,
+            subghz_frequency_analyzer_bench_legacy_run,
+            &legacy_radio,
+            &legacy_stats);
+    }
+
+    printf(
+        "Trials: %lu, %lu%% on favorite frequencies, seed 0x%08lX\n",
+        (unsigned long)trials,
+        (unsigned long)repeat,
+        (unsigned long)seed);
+    subghz_frequency_analyzer_bench_print("sweep", &sweep_stats);
+    subghz_frequency_analyzer_bench_print("legacy", &legacy_stats);
+
+    SubGhzFrequencyAnalyzerSweepStats hot[SUBGHZ_FREQUENCY_ANALYZER_BENCH_FAVORITES];
+    size_t hot_count = subghz_frequency_analyzer_sweep_get_hot(sweep, hot, COUNT_OF(hot));
+    for(size_t i = 0; i < hot_count; i++) {
+        printf(
+            "Hot:    %lu Hz, %u hits, max %.1f dBm\n",
+            (unsigned long)hot[i].frequency,
+            hot[i].hits,
+            (double)hot[i].rssi_max);
+    }
+
+    subghz_frequency_analyzer_sweep_free(sweep);
+
+    return 0;
+}
@@ -0,0 +1,277 @@
+#include <subghz_history.h>
+
+#include <furi.h>
+#include <lib/subghz/protocols/base.h>
+#include <storage/storage.h>
+#include <storage_host.h>
+
+#include <errno.h>
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define TAG "SubGhzHistoryBench"
+
+#define SUBGHZ_HISTORY_BENCH_DECODES (10000U)
+#define SUBGHZ_HISTORY_BENCH_KEYS (400U)
+#define SUBGHZ_HISTORY_BENCH_FREQUENCY (433920000UL)
+#define SUBGHZ_HISTORY_BENCH_BIT_COUNT (64U)
+
+typedef struct {
+    SubGhzProtocolDecoderBase base;
+    uint64_t key;
+    uint32_t te;
+    uint8_t hash;
+} SubGhzHistoryBenchDecoder;
+
+typedef struct {
+    uint64_t count;
+    uint64_t total_ns;
+    uint64_t max_ns;
+} SubGhzHistoryBenchTime;
+
+static SubGhzProtocolStatus subghz_history_bench_serialize(
+    void* context,
+    FlipperFormat* flipper_format,
+    SubGhzRadioPreset* preset) {
+    SubGhzHistoryBenchDecoder* decoder = context;
+    uint8_t key_data[sizeof(uint64_t)];
+    for(size_t i = 0; i < sizeof(uint64_t); i++) {
+        key_data[i] = decoder->key >> ((sizeof(uint64_t) - 1 - i) * 8);
+    }
+    uint32_t bit_count = SUBGHZ_HISTORY_BENCH_BIT_COUNT;
+
+    // Same layout as subghz_block_generic_serialize
+    SubGhzProtocolStatus status = SubGhzProtocolStatusError;
+    do {
+        if(!flipper_format_write_header_cstr(
+               flipper_format, SUBGHZ_KEY_FILE_TYPE, SUBGHZ_KEY_FILE_VERSION))
+            break;
+        if(!flipper_format_write_uint32(flipper_format, "Frequency", &preset->frequency, 1))
+            break;
+        if(!flipper_format_write_string(flipper_format, "Preset", preset->name)) break;
+        if(!flipper_format_write_string_cstr(
+               flipper_format, "Protocol", decoder->base.protocol->name))
+            break;
+        if(!flipper_format_write_uint32(flipper_format, "Bit", &bit_count, 1)) break;
+        if(!flipper_format_write_hex(flipper_format, "Key", key_data, sizeof(key_data))) break;
+        if(!flipper_format_write_uint32(flipper_format, "TE", &decoder->te, 1)) break;
+        status = SubGhzProtocolStatusOk;
+    } while(false);
+
+    return status;
+}
+
+static uint8_t subghz_history_bench_get_hash_data(void* context) {
+    SubGhzHistoryBenchDecoder* decoder = context;
+    return decoder->hash;
+}
+
+static const SubGhzProtocolDecoder subghz_history_bench_decoder = {
+    .get_hash_data = subghz_history_bench_get_hash_data,
+    .serialize = subghz_history_bench_serialize,
+};
+
+static const SubGhzProtocol subghz_history_bench_protocol = {
+    .name = "Bench",
+    .type = SubGhzProtocolTypeStatic,
+    .flag = SubGhzProtocolFlag_Decodable,
+    .decoder = &subghz_history_bench_decoder,
+};
+
+static uint64_t subghz_history_bench_time_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static void subghz_history_bench_time_add(SubGhzHistoryBenchTime* time, uint64_t start) {
+    uint64_t elapsed = subghz_history_bench_time_ns() - start;
+    time->count++;
+    time->total_ns += elapsed;
+    time->max_ns = MAX(time->max_ns, elapsed);
+}
+
+static void subghz_history_bench_time_print(const char* name, SubGhzHistoryBenchTime* time) {
+    printf(
+        "%-8s %8llu calls, avg %8.2f us, max %8.2f us\n",
+        name,
+        (unsigned long long)time->count,
+        time->count ? time->total_ns / 1000.0 / time->count : 0.0,
+        time->max_ns / 1000.0);
+}
+
+static uint64_t subghz_history_bench_key(uint32_t index) {
+    // Spread key bits, menu text of every key differs
+    return ((uint64_t)index * 0x9E3779B97F4A7C15ULL) | 1;
+}
+
+static uint32_t subghz_history_bench_random(uint32_t* state) {
+    // xorshift32, same sequence on every run
+    *state ^= *state << 13;
+    *state ^= *state >> 17;
+    *state ^= *state << 5;
+    return *state;
+}
+
+static size_t subghz_history_bench_check(
+    SubGhzHistory* history,
+    const uint32_t* key_hits,
+    uint32_t key_count,
+    SubGhzHistoryBenchTime* recall) {
+    size_t failures = 0;
+    uint16_t item_count = subghz_history_get_item(history);
+    uint64_t hits = 0;
+
+    for(uint16_t i = 0; i < item_count; i++) {
+        uint64_t start = subghz_history_bench_time_ns();
+        FlipperFormat* flipper_format = subghz_history_get_raw_data(history, i);
+        subghz_history_bench_time_add(recall, start);
+
+        uint8_t key_data[sizeof(uint64_t)] = {0};
+        if(!flipper_format ||
+           !flipper_format_read_hex(flipper_format, "Key", key_data, sizeof(key_data))) {
+            printf("FAIL item %u: can't read key\n", i);
+            failures++;
+            continue;
+        }
+
+        uint64_t key = 0;
+        for(size_t j = 0; j < sizeof(uint64_t); j++) {
+            key = (key << 8) | key_data[j];
+        }
+
+        // Items are added in order of first reception, find which key it is
+        uint32_t index = 0;
+        while(index < key_count && subghz_history_bench_key(index) != key) index++;
+        if(index == key_count) {
+            printf("FAIL item %u: unknown key %016llX\n", i, (unsigned long long)key);
+            failures++;
+        } else if(
+            subghz_history_get_hits(history, i) !=
+            MIN(key_hits[index], (uint32_t)UINT16_MAX)) {
+            printf(
+                "FAIL item %u: %u hits, expected %lu\n",
+                i,
+                subghz_history_get_hits(history, i),
+                (unsigned long)key_hits[index]);
+            failures++;
+        }
+        if(subghz_history_get_frequency(history, i) != SUBGHZ_HISTORY_BENCH_FREQUENCY) {
+            printf("FAIL item %u: wrong frequency\n", i);
+            failures++;
+        }
+        hits += subghz_history_get_hits(history, i);
+    }
+
+    printf("Items:   %u, hits %llu\n", item_count, (unsigned long long)hits);
+    return failures;
+}
+
+static void subghz_history_bench_usage(const char* name) {
+    printf("Usage: %s [-n decodes] [-k keys] storage_dir\n", name);
+}
+
+int main(int argc, char** argv) {
+    uint32_t decode_count = SUBGHZ_HISTORY_BENCH_DECODES;
+    uint32_t key_count = SUBGHZ_HISTORY_BENCH_KEYS;
+
+    int option;
+    while((option = getopt(argc, argv, "n:k:h")) != -1) {
+        switch(option) {
+        case 'n':
+            decode_count = strtoul(optarg, NULL, 10);
+            break;
+        case 'k':
+            key_count = strtoul(optarg, NULL, 10);
+            break;
+        default:
+            subghz_history_bench_usage(argv[0]);
+            return 2;
+        }
+    }
+
+    if(optind + 1 != argc || key_count == 0) {
+        subghz_history_bench_usage(argv[0]);
+        return 2;
+    }
+
+    char* storage_dir = realpath(argv[optind], NULL);
+    if(!storage_dir) {
+        printf("Can't open %s: %s\n", argv[optind], strerror(errno));
+        return 2;
+    }
+
+    furi_init();
+    storage_host_record_create(storage_dir);
+
+    size_t heap_before = memmgr_get_free_heap();
+    SubGhzHistory* history = subghz_history_alloc();
+
+    SubGhzRadioPreset preset = {
+        .name = furi_string_alloc_set("AM650"),
+        .frequency = SUBGHZ_HISTORY_BENCH_FREQUENCY,
+    };
+    SubGhzHistoryBenchDecoder decoder = {
+        .base.protocol = &subghz_history_bench_protocol,
+    };
+
+    uint32_t* key_hits = calloc(key_count, sizeof(uint32_t));
+    uint32_t random = 0x12345678;
+    uint32_t added = 0;
+    SubGhzHistoryBenchTime queue_time = {0};
+    SubGhzHistoryBenchTime store_time = {0};
+
+    for(uint32_t i = 0; i < decode_count; i++) {
+        uint32_t index = subghz_history_bench_random(&random) % key_count;
+        decoder.key = subghz_history_bench_key(index);
+        decoder.te = 300 + subghz_history_bench_random(&random) % 100;
+        // Every decode is a separate button press, not a repeat within one transmission
+        decoder.hash++;
+
+        // Queueing is what the rx callback pays, storing runs on the app thread
+        uint16_t item_count = subghz_history_get_item(history);
+        uint64_t start = subghz_history_bench_time_ns();
+        bool is_queued = subghz_history_add_to_history(history, &decoder, &preset);
+        subghz_history_bench_time_add(&queue_time, start);
+        start = subghz_history_bench_time_ns();
+        subghz_history_process_queue(history);
+        subghz_history_bench_time_add(&store_time, start);
+
+        // Keys that didn't fit are not counted by history either
+        if(!is_queued) {
+            printf("Decode %lu not queued\n", (unsigned long)i);
+        } else if(subghz_history_get_item(history) != item_count) {
+            added++;
+            key_hits[index] = 1;
+        } else if(key_hits[index]) {
+            key_hits[index]++;
+        }
+    }
+
+    size_t heap_used = heap_before - memmgr_get_free_heap();
+
+    SubGhzHistoryBenchTime recall_time = {0};
+    size_t failures = subghz_history_bench_check(history, key_hits, key_count, &recall_time);
+
+    FuriString* space_left = furi_string_alloc();
+    subghz_history_get_text_space_left(history, space_left);
+
+    printf("Decodes: %lu, keys %lu\n", (unsigned long)decode_count, (unsigned long)key_count);
+    printf("Added:   %lu, %s\n", (unsigned long)added, furi_string_get_cstr(space_left));
+    printf("Heap:    %zu bytes, %zu per item\n", heap_used, heap_used / MAX(added, 1U));
+    subghz_history_bench_time_print("queue", &queue_time);
+    subghz_history_bench_time_print("store", &store_time);
+    subghz_history_bench_time_print("recall", &recall_time);
+
+    furi_string_free(space_left);
+    free(key_hits);
+    furi_string_free(preset.name);
+    subghz_history_free(history);
+    free(storage_dir);
+
+    if(failures) printf("%zu failures\n", failures);
+    return failures ? 1 : 0;
+}
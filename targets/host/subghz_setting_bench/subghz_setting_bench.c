@@ -0,0 +1,231 @@
+#include <furi.h>
+#include <storage/storage.h>
+#include <storage_host.h>
+#include <lib/subghz/subghz_setting.h>
+
+#include <errno.h>
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define SUBGHZ_SETTING_BENCH_ROUNDS (100U)
+#define SUBGHZ_SETTING_BENCH_TEMP_PATH "/tmp/subghz_setting_benchXXXXXX"
+#define SUBGHZ_SETTING_BENCH_FILE_NAME "setting_user"
+/* Same as SUBGHZ_SETTING_CACHE_EXTENSION */
+#define SUBGHZ_SETTING_BENCH_CACHE_EXTENSION ".cache"
+
+typedef struct {
+    uint64_t count;
+    uint64_t total_ns;
+    uint64_t max_ns;
+} SubGhzSettingBenchTime;
+
+static uint64_t subghz_setting_bench_time_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static void subghz_setting_bench_time_add(SubGhzSettingBenchTime* time, uint64_t start) {
+    const uint64_t duration = subghz_setting_bench_time_ns() - start;
+    time->count++;
+    time->total_ns += duration;
+    time->max_ns = MAX(time->max_ns, duration);
+}
+
+static double subghz_setting_bench_time_avg_us(const SubGhzSettingBenchTime* time) {
+    return time->count ? time->total_ns / 1000.0 / time->count : 0.0;
+}
+
+// Everything the app gets from settings, to compare text and cache loads
+static void subghz_setting_bench_serialize(SubGhzSetting* setting, FuriString* output) {
+    furi_string_printf(
+        output,
+        "default %lu (%lu)\nfrequencies",
+        (unsigned long)subghz_setting_get_default_frequency(setting),
+        (unsigned long)subghz_setting_get_frequency_default_index(setting));
+    for(size_t i = 0; i < subghz_setting_get_frequency_count(setting); i++) {
+        furi_string_cat_printf(
+            output, " %lu", (unsigned long)subghz_setting_get_frequency(setting, i));
+    }
+
+    furi_string_cat_printf(output, "\nhopper");
+    for(size_t i = 0; i < subghz_setting_get_hopper_frequency_count(setting); i++) {
+        furi_string_cat_printf(
+            output, " %lu", (unsigned long)subghz_setting_get_hopper_frequency(setting, i));
+    }
+
+    for(size_t i = 0; i < subghz_setting_get_preset_count(setting); i++) {
+        const uint8_t* data = subghz_setting_get_preset_data(setting, i);
+        furi_string_cat_printf(output, "\npreset %s:", subghz_setting_get_preset_name(setting, i));
+        for(size_t j = 0; j < subghz_setting_get_preset_data_size(setting, i); j++) {
+            furi_string_cat_printf(output, " %02X", data[j]);
+        }
+    }
+}
+
+static bool subghz_setting_bench_copy(const char* path, const char* copy_path) {
+    FILE* in = fopen(path, "rb");
+    if(!in) return false;
+
+    FILE* out = fopen(copy_path, "wb");
+    bool success = false;
+
+    if(out) {
+        char buffer[256];
+        size_t size;
+        while((size = fread(buffer, 1, sizeof(buffer), in)) > 0) {
+            fwrite(buffer, 1, size, out);
+        }
+        success = !ferror(in);
+        success = (fclose(out) == 0) && success;
+    }
+
+    fclose(in);
+    return success;
+}
+
+static void subghz_setting_bench_load(
+    const char* path,
+    FuriString* output,
+    SubGhzSettingBenchTime* time) {
+    const uint64_t start = subghz_setting_bench_time_ns();
+    SubGhzSetting* setting = subghz_setting_alloc();
+    subghz_setting_load(setting, path);
+    subghz_setting_bench_time_add(time, start);
+
+    subghz_setting_bench_serialize(setting, output);
+    subghz_setting_free(setting);
+}
+
+static bool subghz_setting_bench_run(
+    const char* name,
+    const char* host_cache_path,
+    uint32_t rounds,
+    SubGhzSettingBenchTime* text,
+    SubGhzSettingBenchTime* cache) {
+    const char* path = STORAGE_EXT_PATH_PREFIX "/" SUBGHZ_SETTING_BENCH_FILE_NAME;
+    FuriString* expected = furi_string_alloc();
+    FuriString* output = furi_string_alloc();
+    bool success = true;
+
+    for(uint32_t i = 0; i < rounds && success; i++) {
+        // start of the app after setting file was changed
+        unlink(host_cache_path);
+        subghz_setting_bench_load(path, i ? output : expected, text);
+        if(i && !furi_string_equal(expected, output)) {
+            printf("FAIL %s: text loads differ\n", name);
+            success = false;
+        }
+    }
+
+    if(success && access(host_cache_path, F_OK) != 0) {
+        printf("FAIL %s: cache is not written\n", name);
+        success = false;
+    }
+
+    for(uint32_t i = 0; i < rounds && success; i++) {
+        subghz_setting_bench_load(path, output, cache);
+        if(!furi_string_equal(expected, output)) {
+            printf("FAIL %s: cache load differs from text\n", name);
+            success = false;
+        }
+    }
+
+    furi_string_free(output);
+    furi_string_free(expected);
+    return success;
+}
+
+static void subghz_setting_bench_usage(const char* name) {
+    printf("Usage: %s [-r rounds] setting_user...\n", name);
+}
+
+int main(int argc, char** argv) {
+    uint32_t rounds = SUBGHZ_SETTING_BENCH_ROUNDS;
+
+    int option;
+    while((option = getopt(argc, argv, "r:h")) != -1) {
+        switch(option) {
+        case 'r':
+            rounds = strtoul(optarg, NULL, 10);
+            break;
+        default:
+            subghz_setting_bench_usage(argv[0]);
+            return 2;
+        }
+    }
+
+    if(optind == argc || !rounds) {
+        subghz_setting_bench_usage(argv[0]);
+        return 2;
+    }
+
+    // Setting file is copied to an empty storage, cache is written next to it
+    char root[] = SUBGHZ_SETTING_BENCH_TEMP_PATH;
+    if(!mkdtemp(root)) {
+        printf("Can't create %s: %s\n", root, strerror(errno));
+        return 2;
+    }
+
+    furi_init();
+    storage_host_record_create(root);
+
+    FuriString* host_path =
+        furi_string_alloc_printf("%s/%s", root, SUBGHZ_SETTING_BENCH_FILE_NAME);
+    FuriString* host_cache_path = furi_string_alloc_printf(
+        "%s%s", furi_string_get_cstr(host_path), SUBGHZ_SETTING_BENCH_CACHE_EXTENSION);
+
+    SubGhzSettingBenchTime text_total = {0};
+    SubGhzSettingBenchTime cache_total = {0};
+    size_t failures = 0;
+
+    for(int i = optind; i < argc; i++) {
+        if(!subghz_setting_bench_copy(argv[i], furi_string_get_cstr(host_path))) {
+            printf("FAIL %s: %s\n", argv[i], strerror(errno));
+            failures++;
+            continue;
+        }
+
+        SubGhzSettingBenchTime text = {0};
+        SubGhzSettingBenchTime cache = {0};
+        if(!subghz_setting_bench_run(
+               argv[i], furi_string_get_cstr(host_cache_path), rounds, &text, &cache)) {
+            failures++;
+        } else {
+            printf(
+                "%s: text %.3f us, cache %.3f us, %.1fx\n",
+                argv[i],
+                subghz_setting_bench_time_avg_us(&text),
+                subghz_setting_bench_time_avg_us(&cache),
+                subghz_setting_bench_time_avg_us(&text) /
+                    subghz_setting_bench_time_avg_us(&cache));
+        }
+
+        text_total.count += text.count;
+        text_total.total_ns += text.total_ns;
+        text_total.max_ns = MAX(text_total.max_ns, text.max_ns);
+        cache_total.count += cache.count;
+        cache_total.total_ns += cache.total_ns;
+        cache_total.max_ns = MAX(cache_total.max_ns, cache.max_ns);
+        unlink(furi_string_get_cstr(host_cache_path));
+        unlink(furi_string_get_cstr(host_path));
+    }
+
+    printf(
+        "text  avg %9.3f us, max %9.3f us\ncache avg %9.3f us, max %9.3f us\n",
+        subghz_setting_bench_time_avg_us(&text_total),
+        text_total.max_ns / 1000.0,
+        subghz_setting_bench_time_avg_us(&cache_total),
+        cache_total.max_ns / 1000.0);
+
+    furi_string_free(host_cache_path);
+    furi_string_free(host_path);
+    rmdir(root);
+
+    if(failures) printf("%zu failures\n", failures);
+    return failures ? 1 : 0;
+}
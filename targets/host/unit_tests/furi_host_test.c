@@ -0,0 +1,54 @@
+#include <furi.h>
+#include "minunit.h"
+
+/* Parts of applications/debug/unit_tests/furi/furi_test.c that run on host,
+ * memory manager tests need device heap and stay on device */
+
+void test_furi_create_open();
+void test_furi_pubsub();
+void test_furi_event_loop();
+void test_furi_event_loop_timer_free();
+
+MU_TEST(mu_test_furi_create_open) {
+    test_furi_create_open();
+}
+
+MU_TEST(mu_test_furi_pubsub) {
+    test_furi_pubsub();
+}
+
+MU_TEST(mu_test_furi_event_loop) {
+    test_furi_event_loop();
+}
+
+MU_TEST(mu_test_furi_event_loop_timer_free) {
+    test_furi_event_loop_timer_free();
+}
+
+MU_TEST_SUITE(furi_record_suite) {
+    MU_RUN_TEST(mu_test_furi_create_open);
+}
+
+MU_TEST_SUITE(furi_pubsub_suite) {
+    MU_RUN_TEST(mu_test_furi_pubsub);
+}
+
+MU_TEST_SUITE(furi_event_loop_suite) {
+    MU_RUN_TEST(mu_test_furi_event_loop);
+    MU_RUN_TEST(mu_test_furi_event_loop_timer_free);
+}
+
+int run_minunit_test_furi_record() {
+    MU_RUN_SUITE(furi_record_suite);
+    return MU_EXIT_CODE;
+}
+
+int run_minunit_test_furi_pubsub() {
+    MU_RUN_SUITE(furi_pubsub_suite);
+    return MU_EXIT_CODE;
+}
+
+int run_minunit_test_furi_event_loop() {
+    MU_RUN_SUITE(furi_event_loop_suite);
+    return MU_EXIT_CODE;
+}
@@ -0,0 +1,114 @@
+#include <furi.h>
+#include <storage_host.h>
+#include "minunit_vars.h"
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+int run_minunit_test_furi_string();
+int run_minunit_test_flipper_format_string();
+int run_minunit_test_infrared();
+int run_minunit_test_protocol_dict();
+int run_minunit_test_lfrfid_protocols();
+int run_minunit_test_one_wire();
+int run_minunit_test_bit_lib();
+int run_minunit_test_float_tools();
+int run_minunit_test_profiler();
+int run_minunit_test_furi_record();
+int run_minunit_test_furi_pubsub();
+int run_minunit_test_furi_event_loop();
+int run_minunit_test_nfc();
+
+typedef int (*UnitTestEntry)();
+
+typedef struct {
+    const char* name;
+    const UnitTestEntry entry;
+} UnitTest;
+
+/* Suites of applications/debug/unit_tests/test_index.c that need no hardware */
+static const UnitTest unit_tests[] = {
+    {.name = "furi_string", .entry = run_minunit_test_furi_string},
+    {.name = "flipper_format_string", .entry = run_minunit_test_flipper_format_string},
+    {.name = "infrared", .entry = run_minunit_test_infrared},
+    {.name = "protocol_dict", .entry = run_minunit_test_protocol_dict},
+    {.name = "lfrfid", .entry = run_minunit_test_lfrfid_protocols},
+    {.name = "one_wire", .entry = run_minunit_test_one_wire},
+    {.name = "bit_lib", .entry = run_minunit_test_bit_lib},
+    {.name = "float_tools", .entry = run_minunit_test_float_tools},
+    {.name = "profiler", .entry = run_minunit_test_profiler},
+    {.name = "furi_record", .entry = run_minunit_test_furi_record},
+    {.name = "furi_pubsub", .entry = run_minunit_test_furi_pubsub},
+    {.name = "furi_event_loop", .entry = run_minunit_test_furi_event_loop},
+    {.name = "nfc", .entry = run_minunit_test_nfc},
+};
+
+void minunit_print_progress() {
+    // Output goes to CI logs, not to a terminal
+}
+
+void minunit_print_fail(const char* str) {
+    printf(_FURI_LOG_CLR_E "%s\r\n" _FURI_LOG_CLR_RESET, str);
+}
+
+void minunit_printf_warning(const char* format, ...) {
+    FuriString* str = furi_string_alloc();
+    va_list args;
+    va_start(args, format);
+    furi_string_vprintf(str, format, args);
+    va_end(args);
+    printf(_FURI_LOG_CLR_W "%s\r\n" _FURI_LOG_CLR_RESET, furi_string_get_cstr(str));
+    furi_string_free(str);
+}
+
+static const UnitTest* unit_tests_find(const char* name) {
+    for(size_t i = 0; i < COUNT_OF(unit_tests); i++) {
+        if(strcmp(unit_tests[i].name, name) == 0) return &unit_tests[i];
+    }
+    return NULL;
+}
+
+static void unit_tests_usage(const char* name) {
+    printf("Usage: %s storage_root [suite...]\nSuites:", name);
+    for(size_t i = 0; i < COUNT_OF(unit_tests); i++) {
+        printf(" %s", unit_tests[i].name);
+    }
+    printf("\n");
+}
+
+int main(int argc, char** argv) {
+    if(argc < 2) {
+        unit_tests_usage(argv[0]);
+        return 2;
+    }
+
+    for(int i = 2; i < argc; i++) {
+        if(!unit_tests_find(argv[i])) {
+            printf("Unknown suite %s\n", argv[i]);
+            unit_tests_usage(argv[0]);
+            return 2;
+        }
+    }
+
+    furi_init();
+    storage_host_record_create(argv[1]);
+
+    uint32_t cycle_counter = furi_get_tick();
+
+    if(argc == 2) {
+        for(size_t i = 0; i < COUNT_OF(unit_tests); i++) {
+            unit_tests[i].entry();
+        }
+    } else {
+        for(int i = 2; i < argc; i++) {
+            unit_tests_find(argv[i])->entry();
+        }
+    }
+
+    printf("\r\nFailed tests: %d\r\n", minunit_fail);
+    printf("Consumed: %" PRIu32 " ms\r\n", furi_get_tick() - cycle_counter);
+    printf("Status: %s\r\n", minunit_fail ? "FAILED" : "PASSED");
+
+    return minunit_fail ? 1 : 0;
+}